@@ -11,17 +11,42 @@
 #include <stdio.h>
 #include <algorithm>
 
+#include "./vpx_config.h"
 #include "test/bench.h"
 #include "vpx_ports/vpx_timer.h"
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+#include "vpx_ports/x86.h"
+#endif
+
+namespace {
+
+template <typename T>
+T Median(const T *values) {
+  T sorted[VPX_BENCH_ROBUST_ITER];
+  std::copy(values, values + VPX_BENCH_ROBUST_ITER, sorted);
+  std::nth_element(sorted, sorted + (VPX_BENCH_ROBUST_ITER >> 1),
+                   sorted + VPX_BENCH_ROBUST_ITER);
+  return sorted[VPX_BENCH_ROBUST_ITER >> 1];
+}
+
+}  // namespace
 
 void AbstractBench::RunNTimes(int n) {
   for (int r = 0; r < VPX_BENCH_ROBUST_ITER; r++) {
     vpx_usec_timer timer;
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+    const uint64_t start_tsc = x86_readtsc64();
+#endif
     vpx_usec_timer_start(&timer);
     for (int j = 0; j < n; ++j) {
       Run();
     }
     vpx_usec_timer_mark(&timer);
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+    cycles_[r] = static_cast<int64_t>(x86_readtsc64() - start_tsc);
+#else
+    cycles_[r] = 0;
+#endif
     times_[r] = static_cast<int>(vpx_usec_timer_elapsed(&timer));
   }
 }
@@ -36,3 +61,7 @@ void AbstractBench::PrintMedian(const char *title) {
   printf("[%10s] %s %.1f ms ( ±%.1f ms )\n", "BENCH ", title, med / 1000.0,
          sad / (VPX_BENCH_ROBUST_ITER * 1000.0));
 }
+
+int AbstractBench::GetMedianTime() const { return Median(times_); }
+
+int64_t AbstractBench::GetMedianCycles() const { return Median(cycles_); }
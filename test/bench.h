@@ -11,6 +11,8 @@
 #ifndef VPX_TEST_BENCH_H_
 #define VPX_TEST_BENCH_H_
 
+#include "vpx/vpx_integer.h"
+
 // Number of iterations used to compute median run time.
 #define VPX_BENCH_ROBUST_ITER 15
 
@@ -18,6 +20,11 @@ class AbstractBench {
  public:
   void RunNTimes(int n);
   void PrintMedian(const char *title);
+  // Median run time of the last RunNTimes() call, in microseconds.
+  int GetMedianTime() const;
+  // Median timestamp counter delta of the last RunNTimes() call, or 0 where
+  // no cycle counter is available.
+  int64_t GetMedianCycles() const;
 
  protected:
   // Implement this method and put the code to benchmark in it.
@@ -25,6 +32,7 @@ class AbstractBench {
 
  private:
   int times_[VPX_BENCH_ROBUST_ITER];
+  int64_t cycles_[VPX_BENCH_ROBUST_ITER];
 };
 
 #endif  // VPX_TEST_BENCH_H_
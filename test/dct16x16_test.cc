@@ -280,6 +280,20 @@ void iht16x16_12(const tran_low_t *in, uint8_t *out, int stride, int tx_type) {
   vp9_highbd_iht16x16_256_add_c(in, CAST_TO_SHORTPTR(out), stride, tx_type, 12);
 }
 
+#if HAVE_AVX2
+void iht16x16_10_avx2(const tran_low_t *in, uint8_t *out, int stride,
+                      int tx_type) {
+  vp9_highbd_iht16x16_256_add_avx2(in, CAST_TO_SHORTPTR(out), stride, tx_type,
+                                   10);
+}
+
+void iht16x16_12_avx2(const tran_low_t *in, uint8_t *out, int stride,
+                      int tx_type) {
+  vp9_highbd_iht16x16_256_add_avx2(in, CAST_TO_SHORTPTR(out), stride, tx_type,
+                                   12);
+}
+#endif  // HAVE_AVX2
+
 #if HAVE_SSE2
 void idct16x16_10_add_10_c(const tran_low_t *in, uint8_t *out, int stride) {
   vpx_highbd_idct16x16_10_add_c(in, CAST_TO_SHORTPTR(out), stride, 10);
@@ -847,6 +861,49 @@ INSTANTIATE_TEST_SUITE_P(
                                  3167, VPX_BITS_12)));
 #endif  // HAVE_SSE2 && CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 
+#if HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Trans16x16HT,
+    ::testing::Values(
+        make_tuple(&vp9_highbd_fht16x16_avx2, &iht16x16_10_avx2, 0,
+                   VPX_BITS_10),
+        make_tuple(&vp9_highbd_fht16x16_avx2, &iht16x16_10_avx2, 1,
+                   VPX_BITS_10),
+        make_tuple(&vp9_highbd_fht16x16_avx2, &iht16x16_10_avx2, 2,
+                   VPX_BITS_10),
+        make_tuple(&vp9_highbd_fht16x16_avx2, &iht16x16_10_avx2, 3,
+                   VPX_BITS_10),
+        make_tuple(&vp9_highbd_fht16x16_avx2, &iht16x16_12_avx2, 0,
+                   VPX_BITS_12),
+        make_tuple(&vp9_highbd_fht16x16_avx2, &iht16x16_12_avx2, 1,
+                   VPX_BITS_12),
+        make_tuple(&vp9_highbd_fht16x16_avx2, &iht16x16_12_avx2, 2,
+                   VPX_BITS_12),
+        make_tuple(&vp9_highbd_fht16x16_avx2, &iht16x16_12_avx2, 3,
+                   VPX_BITS_12),
+        make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_avx2, 0,
+                   VPX_BITS_8),
+        make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_avx2, 1,
+                   VPX_BITS_8),
+        make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_avx2, 2,
+                   VPX_BITS_8),
+        make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_avx2, 3,
+                   VPX_BITS_8)));
+#else
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Trans16x16HT,
+    ::testing::Values(make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_avx2,
+                                 0, VPX_BITS_8),
+                      make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_avx2,
+                                 1, VPX_BITS_8),
+                      make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_avx2,
+                                 2, VPX_BITS_8),
+                      make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_avx2,
+                                 3, VPX_BITS_8)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+#endif  // HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+
 #if HAVE_MSA && !CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 INSTANTIATE_TEST_SUITE_P(
     MSA, Trans16x16DCT,
@@ -526,17 +526,34 @@ INSTANTIATE_TEST_SUITE_P(SSSE3, TransDCT,
                                                       0, VPX_BITS_8)));
 #endif  // HAVE_SSSE3 && !CONFIG_VP9_HIGHBITDEPTH && VPX_ARCH_X86_64
 
-#if HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH
-static const FuncInfo dct_avx2_func_info = {
-  &fdct_wrapper<vpx_fdct32x32_avx2>, &idct_wrapper<vpx_idct32x32_1024_add_sse2>,
-  32, 1
+#if HAVE_AVX2
+static const FuncInfo dct_avx2_func_info[] = {
+#if CONFIG_VP9_HIGHBITDEPTH
+  { &fdct_wrapper<vpx_highbd_fdct4x4_avx2>,
+    &highbd_idct_wrapper<vpx_highbd_idct4x4_16_add_sse2>, 4, 2 },
+  { &fdct_wrapper<vpx_highbd_fdct8x8_avx2>,
+    &highbd_idct_wrapper<vpx_highbd_idct8x8_64_add_sse2>, 8, 2 },
+  { &fdct_wrapper<vpx_highbd_fdct16x16_avx2>,
+    &highbd_idct_wrapper<vpx_highbd_idct16x16_256_add_sse2>, 16, 2 },
+#else
+  // TODO(johannkoenig): high bit depth fdct32x32.
+  { &fdct_wrapper<vpx_fdct32x32_avx2>,
+    &idct_wrapper<vpx_idct32x32_1024_add_sse2>, 32, 1 },
+#endif
+  { &fdct_wrapper<vpx_fdct8x8_avx2>, &idct_wrapper<vpx_idct8x8_64_add_sse2>, 8,
+    1 },
+  { &fdct_wrapper<vpx_fdct16x16_avx2>,
+    &idct_wrapper<vpx_idct16x16_256_add_sse2>, 16, 1 }
 };
 
-// TODO(johannkoenig): high bit depth fdct32x32.
-INSTANTIATE_TEST_SUITE_P(AVX2, TransDCT,
-                         ::testing::Values(make_tuple(0, &dct_avx2_func_info, 0,
-                                                      VPX_BITS_8)));
-#endif  // HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, TransDCT,
+    ::testing::Combine(
+        ::testing::Range(0, static_cast<int>(sizeof(dct_avx2_func_info) /
+                                             sizeof(dct_avx2_func_info[0]))),
+        ::testing::Values(dct_avx2_func_info), ::testing::Values(0),
+        ::testing::Values(VPX_BITS_8, VPX_BITS_10, VPX_BITS_12)));
+#endif  // HAVE_AVX2
 
 #if HAVE_NEON
 static const FuncInfo dct_neon_func_info[4] = {
@@ -8,10 +8,14 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <cstring>
+#include <vector>
+
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vpx_config.h"
 #include "test/ivf_video_source.h"
+#include "test/md5_helper.h"
 #include "vpx/vp8dx.h"
 #include "vpx/vpx_decoder.h"
 
@@ -193,8 +197,187 @@ TEST(DecodeAPI, Vp9PeekStreamInfoTruncated) {
     TestPeekInfo(profile1_data, data_sz, 11);
   }
 }
+
+TEST(DecodeAPI, Vp9StageTimings) {
+  const vpx_codec_iface_t *const codec = &vpx_codec_vp9_dx_algo;
+  for (int row_mt = 0; row_mt <= 1; ++row_mt) {
+    libvpx_test::IVFVideoSource video("vp90-2-09-subpixel-00.ivf");
+    video.Init();
+    video.Begin();
+    ASSERT_TRUE(!HasFailure());
+
+    vpx_codec_dec_cfg_t cfg = { 2, 0, 0 };
+    vpx_codec_ctx_t dec;
+    ASSERT_EQ(VPX_CODEC_OK, vpx_codec_dec_init(&dec, codec, &cfg, 0));
+    ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&dec, VP9D_SET_ROW_MT, row_mt));
+
+    vpx_dec_stage_timings_t timings;
+    ASSERT_EQ(
+        VPX_CODEC_INVALID_PARAM,
+        vpx_codec_control(&dec, VP9D_GET_STAGE_TIMINGS,
+                          static_cast<vpx_dec_stage_timings_t *>(nullptr)));
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_decode(&dec, video.cxdata(),
+                               static_cast<uint32_t>(video.frame_size()),
+                               nullptr, 0));
+    memset(&timings, 0xff, sizeof(timings));
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&dec, VP9D_GET_STAGE_TIMINGS, &timings));
+    EXPECT_EQ(0, timings.decode_wall_time);
+
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&dec, VP9D_SET_STAGE_TIMINGS, 1));
+    int64_t stage_time[VP9D_STAGE_COUNT] = { 0 };
+    for (video.Next(); video.cxdata() != nullptr; video.Next()) {
+      ASSERT_EQ(VPX_CODEC_OK,
+                vpx_codec_decode(&dec, video.cxdata(),
+                                 static_cast<uint32_t>(video.frame_size()),
+                                 nullptr, 0));
+      ASSERT_EQ(VPX_CODEC_OK,
+                vpx_codec_control(&dec, VP9D_GET_STAGE_TIMINGS, &timings));
+      EXPECT_GT(timings.decode_wall_time, 0);
+      for (int stage = 0; stage < VP9D_STAGE_COUNT; ++stage) {
+        EXPECT_GE(timings.stage_time[stage], 0);
+        stage_time[stage] += timings.stage_time[stage];
+      }
+      // At most one tile, row or loop filter worker runs on its own thread.
+      ASSERT_LE(timings.num_worker_threads, 1);
+      for (int i = 0; i < timings.num_worker_threads; ++i) {
+        EXPECT_GE(timings.worker_busy_time[i], 0);
+        EXPECT_EQ(timings.decode_wall_time - timings.worker_busy_time[i],
+                  timings.worker_idle_time[i]);
+      }
+    }
+    // Parsing and reconstruction are only timed apart by the row based
+    // decoder. The serial decoder waits for no other frame.
+    if (row_mt) {
+      EXPECT_GT(stage_time[VP9D_STAGE_PARSE], 0);
+      EXPECT_GT(stage_time[VP9D_STAGE_RECON], 0);
+      EXPECT_EQ(0, stage_time[VP9D_STAGE_TILES]);
+    } else {
+      EXPECT_GT(stage_time[VP9D_STAGE_TILES], 0);
+      EXPECT_EQ(0, stage_time[VP9D_STAGE_PARSE]);
+      EXPECT_EQ(0, stage_time[VP9D_STAGE_RECON]);
+    }
+    EXPECT_EQ(0, stage_time[VP9D_STAGE_FRAME_WAIT]);
+
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&dec, VP9D_SET_STAGE_TIMINGS, 0));
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&dec, VP9D_GET_STAGE_TIMINGS, &timings));
+    EXPECT_EQ(0, timings.decode_wall_time);
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+  }
+}
 #endif  // CONFIG_VP9_DECODER
 
+TEST(DecodeAPI, DecodeBatchInvalidParams) {
+  uint8_t buf[1] = { 0 };
+  vpx_codec_dec_batch_item_t item = vpx_codec_dec_batch_item_t();
+
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_decode_batch(nullptr, 0, nullptr, nullptr, nullptr));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_decode_batch(nullptr, 1, nullptr, nullptr, nullptr));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_decode_batch(&item, -1, nullptr, nullptr, nullptr));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_decode_batch(&item, 1, nullptr, nullptr, nullptr));
+
+#if CONFIG_VP8_DECODER
+  vpx_codec_ctx_t dec;
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&dec, &vpx_codec_vp8_dx_algo, nullptr, 0));
+  item.ctx = &dec;
+  item.data = buf;
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_decode_batch(&item, 1, nullptr, nullptr, nullptr));
+  item.data_sz = NELEMENTS(buf);
+  EXPECT_EQ(VPX_CODEC_UNSUP_BITSTREAM,
+            vpx_codec_decode_batch(&item, 1, nullptr, nullptr, nullptr));
+  EXPECT_EQ(VPX_CODEC_UNSUP_BITSTREAM, item.res);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+#endif
+}
+
+#if CONFIG_VP8_DECODER
+const int kNumBatchStreams = 5;
+
+struct BatchFrames {
+  vpx_codec_ctx_t dec[kNumBatchStreams];
+  libvpx_test::MD5 md5[kNumBatchStreams];
+};
+
+void AddBatchFrame(void *cb_priv, const vpx_codec_dec_batch_item_t *item,
+                   const vpx_image_t *img) {
+  BatchFrames *const frames = static_cast<BatchFrames *>(cb_priv);
+  frames->md5[item->ctx - frames->dec].Add(img);
+}
+
+// Decodes copies of a stream with one instance each, two frames per instance
+// and per batch, and checks that they match a serial decode.
+TEST(DecodeAPI, DecodeBatch) {
+  const char filename[] = "vp80-00-comprehensive-001.ivf";
+  libvpx_test::IVFVideoSource video(filename);
+  video.Init();
+  std::vector<std::vector<uint8_t> > buffers;
+  for (video.Begin(); video.cxdata() != nullptr; video.Next()) {
+    buffers.push_back(std::vector<uint8_t>(
+        video.cxdata(), video.cxdata() + video.frame_size()));
+  }
+  ASSERT_TRUE(!HasFailure());
+  ASSERT_GT(buffers.size(), 2u);
+
+  vpx_codec_ctx_t dec;
+  libvpx_test::MD5 expected_md5;
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&dec, &vpx_codec_vp8_dx_algo, nullptr, 0));
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_decode(&dec, &buffers[i][0],
+                               static_cast<unsigned int>(buffers[i].size()),
+                               nullptr, 0));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_image_t *img;
+    while ((img = vpx_codec_get_frame(&dec, &iter)) != nullptr) {
+      expected_md5.Add(img);
+    }
+  }
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+
+  // Without multi-threading the pool is NULL and the batch is decoded on the
+  // calling thread.
+  vpx_codec_thread_pool_t *const pool = vpx_codec_thread_pool_create(3);
+  BatchFrames frames;
+  for (int s = 0; s < kNumBatchStreams; ++s) {
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_dec_init(&frames.dec[s],
+                                               &vpx_codec_vp8_dx_algo,
+                                               nullptr, 0));
+  }
+  for (size_t i = 0; i < buffers.size(); i += 2) {
+    vpx_codec_dec_batch_item_t items[2 * kNumBatchStreams];
+    int num_items = 0;
+    for (size_t j = i; j < i + 2 && j < buffers.size(); ++j) {
+      for (int s = 0; s < kNumBatchStreams; ++s) {
+        vpx_codec_dec_batch_item_t *const item = &items[num_items++];
+        item->ctx = &frames.dec[s];
+        item->data = &buffers[j][0];
+        item->data_sz = static_cast<unsigned int>(buffers[j].size());
+        item->user_priv = nullptr;
+      }
+    }
+    ASSERT_EQ(VPX_CODEC_OK, vpx_codec_decode_batch(items, num_items, pool,
+                                                   AddBatchFrame, &frames));
+    for (int k = 0; k < num_items; ++k) EXPECT_EQ(VPX_CODEC_OK, items[k].res);
+  }
+  for (int s = 0; s < kNumBatchStreams; ++s) {
+    EXPECT_STREQ(expected_md5.Get(), frames.md5[s].Get()) << "stream " << s;
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&frames.dec[s]));
+  }
+  vpx_codec_thread_pool_destroy(pool);
+}
+#endif  // CONFIG_VP8_DECODER
+
 TEST(DecodeAPI, HighBitDepthCapability) {
 // VP8 should not claim VP9 HBD as a capability.
 #if CONFIG_VP8_DECODER
@@ -10,10 +10,12 @@
 
 #include <climits>
 #include <cstring>
+#include <vector>
 
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vpx_config.h"
+#include "test/acm_random.h"
 #include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
 
@@ -192,8 +194,8 @@ TEST(EncodeAPI, MultiResEncode) {
       cfg[i].ts_target_bitrate[1] = 0;
     }
 
-    // VP9 should report incapable, VP8 invalid for all configurations.
-    EXPECT_EQ(IsVP9(iface) ? VPX_CODEC_INCAPABLE : VPX_CODEC_INVALID_PARAM,
+    // Both codecs should report invalid for all configurations.
+    EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
               vpx_codec_enc_init_multi(&enc[0], iface, &cfg[0], 2, 0, &dsf[0]));
 
     for (int i = 0; i < 2; i++) {
@@ -310,4 +312,190 @@ TEST(EncodeAPI, SetRoi) {
   }
 }
 
+// Encodes 'num_frames' frames of synthetic content supplied in 'fmt' and
+// returns the compressed data.
+std::vector<uint8_t> EncodeSyntheticFrames(const vpx_codec_iface_t *iface,
+                                           vpx_img_fmt_t fmt, int num_frames) {
+  const int width = 174;
+  const int height = 94;
+  std::vector<uint8_t> data;
+  vpx_codec_enc_cfg_t cfg;
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_enc_config_default(iface, &cfg, 0));
+  cfg.g_w = width;
+  cfg.g_h = height;
+  cfg.g_lag_in_frames = 0;
+  vpx_codec_ctx_t enc;
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_enc_init(&enc, iface, &cfg, 0));
+  vpx_image_t img;
+  EXPECT_EQ(&img, vpx_img_alloc(&img, fmt, width, height, 1));
+
+  libvpx_test::ACMRandom rnd(libvpx_test::ACMRandom::DeterministicSeed());
+  for (int frame = 0; frame < num_frames; ++frame) {
+    for (int r = 0; r < height; ++r) {
+      for (int c = 0; c < width; ++c) {
+        img.planes[VPX_PLANE_Y][r * img.stride[VPX_PLANE_Y] + c] =
+            static_cast<uint8_t>(r + c + 3 * frame + (rnd.Rand8() & 15));
+      }
+    }
+    for (int r = 0; r < (height + 1) / 2; ++r) {
+      for (int c = 0; c < (width + 1) / 2; ++c) {
+        const uint8_t u = static_cast<uint8_t>(2 * r + frame);
+        const uint8_t v = static_cast<uint8_t>(255 - c - (rnd.Rand8() & 7));
+        if (fmt == VPX_IMG_FMT_NV12) {
+          img.planes[VPX_PLANE_U][r * img.stride[VPX_PLANE_U] + 2 * c] = u;
+          img.planes[VPX_PLANE_U][r * img.stride[VPX_PLANE_U] + 2 * c + 1] = v;
+        } else {
+          img.planes[VPX_PLANE_U][r * img.stride[VPX_PLANE_U] + c] = u;
+          img.planes[VPX_PLANE_V][r * img.stride[VPX_PLANE_V] + c] = v;
+        }
+      }
+    }
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_encode(&enc, &img, frame, 1, 0, VPX_DL_REALTIME));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf =
+          static_cast<const uint8_t *>(pkt->data.frame.buf);
+      data.insert(data.end(), buf, buf + pkt->data.frame.sz);
+    }
+  }
+  vpx_img_free(&img);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+  return data;
+}
+
+// The interleaved chroma of NV12 input is split while the frame is copied
+// into the lookahead; the result must match planar input.
+TEST(EncodeAPI, Nv12MatchesI420) {
+  static const vpx_codec_iface_t *kCodecs[] = {
+#if CONFIG_VP8_ENCODER
+    &vpx_codec_vp8_cx_algo,
+#endif
+#if CONFIG_VP9_ENCODER
+    &vpx_codec_vp9_cx_algo,
+#endif
+  };
+
+  for (int i = 0; i < NELEMENTS(kCodecs); ++i) {
+    SCOPED_TRACE(vpx_codec_iface_name(kCodecs[i]));
+    const std::vector<uint8_t> i420 =
+        EncodeSyntheticFrames(kCodecs[i], VPX_IMG_FMT_I420, 5);
+    const std::vector<uint8_t> nv12 =
+        EncodeSyntheticFrames(kCodecs[i], VPX_IMG_FMT_NV12, 5);
+    EXPECT_FALSE(i420.empty());
+    EXPECT_TRUE(i420 == nv12);
+  }
+}
+
+#if CONFIG_VP9_ENCODER
+TEST(EncodeAPI, Vp9StageTimings) {
+  const int width = 640;
+  const int height = 480;
+  vpx_codec_iface_t *const iface = vpx_codec_vp9_cx();
+  vpx_codec_enc_cfg_t cfg;
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_enc_config_default(iface, &cfg, 0));
+  cfg.g_w = width;
+  cfg.g_h = height;
+  cfg.g_lag_in_frames = 0;
+  cfg.g_threads = 4;
+  vpx_codec_ctx_t enc;
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_enc_init(&enc, iface, &cfg, 0));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP8E_SET_CPUUSED, 6));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP9E_SET_TILE_COLUMNS, 1));
+  vpx_image_t img;
+  ASSERT_EQ(&img, vpx_img_alloc(&img, VPX_IMG_FMT_I420, width, height, 1));
+  libvpx_test::ACMRandom rnd(libvpx_test::ACMRandom::DeterministicSeed());
+  for (int i = 0; i < width * height * 3 / 2; ++i) {
+    img.img_data[i] = rnd.Rand8();
+  }
+
+  vpx_stage_timings_t timings;
+  ASSERT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_control(&enc, VP9E_GET_STAGE_TIMINGS,
+                              static_cast<vpx_stage_timings_t *>(nullptr)));
+  memset(&timings, 0xff, sizeof(timings));
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&enc, VP9E_GET_STAGE_TIMINGS, &timings));
+  EXPECT_EQ(0, timings.encode_wall_time);
+
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP9E_SET_STAGE_TIMINGS, 1));
+  for (int frame = 0; frame < 3; ++frame) {
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_encode(&enc, &img, frame, 1, 0, VPX_DL_REALTIME));
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&enc, VP9E_GET_STAGE_TIMINGS, &timings));
+    int64_t total_wall_time = 0;
+    for (int stage = 0; stage < VP9E_STAGE_COUNT; ++stage) {
+      EXPECT_GE(timings.wall_time[stage], 0);
+      EXPECT_GE(timings.cpu_time[stage], 0);
+      EXPECT_GE(timings.idle_time[stage], 0);
+      total_wall_time += timings.wall_time[stage];
+    }
+    // Each stage is rounded to the microsecond on its own.
+    EXPECT_LE(total_wall_time, timings.encode_wall_time + VP9E_STAGE_COUNT);
+    EXPECT_GT(timings.wall_time[VP9E_STAGE_ENCODE_FRAME], 0);
+    EXPECT_GT(timings.cpu_time[VP9E_STAGE_ENCODE_FRAME], 0);
+    EXPECT_EQ(0, timings.wall_time[VP9E_STAGE_FIRST_PASS]);
+    EXPECT_EQ(0, timings.wall_time[VP9E_STAGE_TEMPORAL_FILTER]);
+    EXPECT_EQ(0, timings.wall_time[VP9E_STAGE_TPL]);
+    EXPECT_GT(timings.num_worker_threads, 0);
+  }
+
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP9E_SET_STAGE_TIMINGS, 0));
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_encode(&enc, &img, 3, 1, 0, VPX_DL_REALTIME));
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&enc, VP9E_GET_STAGE_TIMINGS, &timings));
+  EXPECT_EQ(0, timings.encode_wall_time);
+  EXPECT_EQ(0, timings.wall_time[VP9E_STAGE_ENCODE_FRAME]);
+
+  vpx_img_free(&img);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+}
+
+// Lossless 4:4:4 noise compresses to more than the raw luma size. With fewer
+// threads than tile columns each worker packs several columns, which must all
+// fit in its tile buffer.
+TEST(EncodeAPI, Vp9LosslessI444TileColumnsPerWorker) {
+  const int width = 1024;
+  const int height = 64;
+  vpx_codec_iface_t *const iface = vpx_codec_vp9_cx();
+  vpx_codec_enc_cfg_t cfg;
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_enc_config_default(iface, &cfg, 0));
+  cfg.g_w = width;
+  cfg.g_h = height;
+  cfg.g_profile = 1;
+  cfg.g_lag_in_frames = 0;
+  cfg.g_threads = 2;
+  vpx_codec_ctx_t enc;
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_enc_init(&enc, iface, &cfg, 0));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP8E_SET_CPUUSED, 7));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP9E_SET_LOSSLESS, 1));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP9E_SET_TILE_COLUMNS, 2));
+  vpx_image_t img;
+  ASSERT_EQ(&img, vpx_img_alloc(&img, VPX_IMG_FMT_I444, width, height, 1));
+  libvpx_test::ACMRandom rnd(libvpx_test::ACMRandom::DeterministicSeed());
+
+  for (int frame = 0; frame < 2; ++frame) {
+    for (int i = 0; i < width * height * 3; ++i) {
+      img.img_data[i] = rnd.Rand8();
+    }
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_encode(&enc, &img, frame, 1, 0, VPX_DL_REALTIME));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_codec_cx_pkt_t *pkt;
+    size_t frame_size = 0;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind == VPX_CODEC_CX_FRAME_PKT) frame_size += pkt->data.frame.sz;
+    }
+    EXPECT_GT(frame_size, static_cast<size_t>(width * height));
+  }
+
+  vpx_img_free(&img);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+}
+#endif  // CONFIG_VP9_ENCODER
+
 }  // namespace
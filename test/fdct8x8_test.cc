@@ -748,6 +748,16 @@ INSTANTIATE_TEST_SUITE_P(SSSE3, FwdTrans8x8DCT,
                                                       0, VPX_BITS_8)));
 #endif
 
+#if HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, FwdTrans8x8HT,
+    ::testing::Values(
+        make_tuple(&vp9_fht8x8_avx2, &vp9_iht8x8_64_add_avx2, 0, VPX_BITS_8),
+        make_tuple(&vp9_fht8x8_avx2, &vp9_iht8x8_64_add_avx2, 1, VPX_BITS_8),
+        make_tuple(&vp9_fht8x8_avx2, &vp9_iht8x8_64_add_avx2, 2, VPX_BITS_8),
+        make_tuple(&vp9_fht8x8_avx2, &vp9_iht8x8_64_add_avx2, 3, VPX_BITS_8)));
+#endif  // HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+
 #if HAVE_MSA && !CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 INSTANTIATE_TEST_SUITE_P(MSA, FwdTrans8x8DCT,
                          ::testing::Values(make_tuple(&vpx_fdct8x8_msa,
@@ -1011,6 +1011,47 @@ const SadMxNParam avx2_tests[] = {
   SadMxNParam(32, 64, &vpx_sad32x64_avx2),
   SadMxNParam(32, 32, &vpx_sad32x32_avx2),
   SadMxNParam(32, 16, &vpx_sad32x16_avx2),
+#if CONFIG_VP9_HIGHBITDEPTH
+  SadMxNParam(64, 64, &vpx_highbd_sad64x64_avx2, 8),
+  SadMxNParam(64, 32, &vpx_highbd_sad64x32_avx2, 8),
+  SadMxNParam(32, 64, &vpx_highbd_sad32x64_avx2, 8),
+  SadMxNParam(32, 32, &vpx_highbd_sad32x32_avx2, 8),
+  SadMxNParam(32, 16, &vpx_highbd_sad32x16_avx2, 8),
+  SadMxNParam(16, 32, &vpx_highbd_sad16x32_avx2, 8),
+  SadMxNParam(16, 16, &vpx_highbd_sad16x16_avx2, 8),
+  SadMxNParam(16, 8, &vpx_highbd_sad16x8_avx2, 8),
+  SadMxNParam(8, 16, &vpx_highbd_sad8x16_avx2, 8),
+  SadMxNParam(8, 8, &vpx_highbd_sad8x8_avx2, 8),
+  SadMxNParam(8, 4, &vpx_highbd_sad8x4_avx2, 8),
+  SadMxNParam(4, 8, &vpx_highbd_sad4x8_avx2, 8),
+  SadMxNParam(4, 4, &vpx_highbd_sad4x4_avx2, 8),
+  SadMxNParam(64, 64, &vpx_highbd_sad64x64_avx2, 10),
+  SadMxNParam(64, 32, &vpx_highbd_sad64x32_avx2, 10),
+  SadMxNParam(32, 64, &vpx_highbd_sad32x64_avx2, 10),
+  SadMxNParam(32, 32, &vpx_highbd_sad32x32_avx2, 10),
+  SadMxNParam(32, 16, &vpx_highbd_sad32x16_avx2, 10),
+  SadMxNParam(16, 32, &vpx_highbd_sad16x32_avx2, 10),
+  SadMxNParam(16, 16, &vpx_highbd_sad16x16_avx2, 10),
+  SadMxNParam(16, 8, &vpx_highbd_sad16x8_avx2, 10),
+  SadMxNParam(8, 16, &vpx_highbd_sad8x16_avx2, 10),
+  SadMxNParam(8, 8, &vpx_highbd_sad8x8_avx2, 10),
+  SadMxNParam(8, 4, &vpx_highbd_sad8x4_avx2, 10),
+  SadMxNParam(4, 8, &vpx_highbd_sad4x8_avx2, 10),
+  SadMxNParam(4, 4, &vpx_highbd_sad4x4_avx2, 10),
+  SadMxNParam(64, 64, &vpx_highbd_sad64x64_avx2, 12),
+  SadMxNParam(64, 32, &vpx_highbd_sad64x32_avx2, 12),
+  SadMxNParam(32, 64, &vpx_highbd_sad32x64_avx2, 12),
+  SadMxNParam(32, 32, &vpx_highbd_sad32x32_avx2, 12),
+  SadMxNParam(32, 16, &vpx_highbd_sad32x16_avx2, 12),
+  SadMxNParam(16, 32, &vpx_highbd_sad16x32_avx2, 12),
+  SadMxNParam(16, 16, &vpx_highbd_sad16x16_avx2, 12),
+  SadMxNParam(16, 8, &vpx_highbd_sad16x8_avx2, 12),
+  SadMxNParam(8, 16, &vpx_highbd_sad8x16_avx2, 12),
+  SadMxNParam(8, 8, &vpx_highbd_sad8x8_avx2, 12),
+  SadMxNParam(8, 4, &vpx_highbd_sad8x4_avx2, 12),
+  SadMxNParam(4, 8, &vpx_highbd_sad4x8_avx2, 12),
+  SadMxNParam(4, 4, &vpx_highbd_sad4x4_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADTest, ::testing::ValuesIn(avx2_tests));
 
@@ -1020,18 +1061,104 @@ const SadMxNAvgParam avg_avx2_tests[] = {
   SadMxNAvgParam(32, 64, &vpx_sad32x64_avg_avx2),
   SadMxNAvgParam(32, 32, &vpx_sad32x32_avg_avx2),
   SadMxNAvgParam(32, 16, &vpx_sad32x16_avg_avx2),
+#if CONFIG_VP9_HIGHBITDEPTH
+  SadMxNAvgParam(64, 64, &vpx_highbd_sad64x64_avg_avx2, 8),
+  SadMxNAvgParam(64, 32, &vpx_highbd_sad64x32_avg_avx2, 8),
+  SadMxNAvgParam(32, 64, &vpx_highbd_sad32x64_avg_avx2, 8),
+  SadMxNAvgParam(32, 32, &vpx_highbd_sad32x32_avg_avx2, 8),
+  SadMxNAvgParam(32, 16, &vpx_highbd_sad32x16_avg_avx2, 8),
+  SadMxNAvgParam(16, 32, &vpx_highbd_sad16x32_avg_avx2, 8),
+  SadMxNAvgParam(16, 16, &vpx_highbd_sad16x16_avg_avx2, 8),
+  SadMxNAvgParam(16, 8, &vpx_highbd_sad16x8_avg_avx2, 8),
+  SadMxNAvgParam(8, 16, &vpx_highbd_sad8x16_avg_avx2, 8),
+  SadMxNAvgParam(8, 8, &vpx_highbd_sad8x8_avg_avx2, 8),
+  SadMxNAvgParam(8, 4, &vpx_highbd_sad8x4_avg_avx2, 8),
+  SadMxNAvgParam(4, 8, &vpx_highbd_sad4x8_avg_avx2, 8),
+  SadMxNAvgParam(4, 4, &vpx_highbd_sad4x4_avg_avx2, 8),
+  SadMxNAvgParam(64, 64, &vpx_highbd_sad64x64_avg_avx2, 10),
+  SadMxNAvgParam(64, 32, &vpx_highbd_sad64x32_avg_avx2, 10),
+  SadMxNAvgParam(32, 64, &vpx_highbd_sad32x64_avg_avx2, 10),
+  SadMxNAvgParam(32, 32, &vpx_highbd_sad32x32_avg_avx2, 10),
+  SadMxNAvgParam(32, 16, &vpx_highbd_sad32x16_avg_avx2, 10),
+  SadMxNAvgParam(16, 32, &vpx_highbd_sad16x32_avg_avx2, 10),
+  SadMxNAvgParam(16, 16, &vpx_highbd_sad16x16_avg_avx2, 10),
+  SadMxNAvgParam(16, 8, &vpx_highbd_sad16x8_avg_avx2, 10),
+  SadMxNAvgParam(8, 16, &vpx_highbd_sad8x16_avg_avx2, 10),
+  SadMxNAvgParam(8, 8, &vpx_highbd_sad8x8_avg_avx2, 10),
+  SadMxNAvgParam(8, 4, &vpx_highbd_sad8x4_avg_avx2, 10),
+  SadMxNAvgParam(4, 8, &vpx_highbd_sad4x8_avg_avx2, 10),
+  SadMxNAvgParam(4, 4, &vpx_highbd_sad4x4_avg_avx2, 10),
+  SadMxNAvgParam(64, 64, &vpx_highbd_sad64x64_avg_avx2, 12),
+  SadMxNAvgParam(64, 32, &vpx_highbd_sad64x32_avg_avx2, 12),
+  SadMxNAvgParam(32, 64, &vpx_highbd_sad32x64_avg_avx2, 12),
+  SadMxNAvgParam(32, 32, &vpx_highbd_sad32x32_avg_avx2, 12),
+  SadMxNAvgParam(32, 16, &vpx_highbd_sad32x16_avg_avx2, 12),
+  SadMxNAvgParam(16, 32, &vpx_highbd_sad16x32_avg_avx2, 12),
+  SadMxNAvgParam(16, 16, &vpx_highbd_sad16x16_avg_avx2, 12),
+  SadMxNAvgParam(16, 8, &vpx_highbd_sad16x8_avg_avx2, 12),
+  SadMxNAvgParam(8, 16, &vpx_highbd_sad8x16_avg_avx2, 12),
+  SadMxNAvgParam(8, 8, &vpx_highbd_sad8x8_avg_avx2, 12),
+  SadMxNAvgParam(8, 4, &vpx_highbd_sad8x4_avg_avx2, 12),
+  SadMxNAvgParam(4, 8, &vpx_highbd_sad4x8_avg_avx2, 12),
+  SadMxNAvgParam(4, 4, &vpx_highbd_sad4x4_avg_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADavgTest, ::testing::ValuesIn(avg_avx2_tests));
 
 const SadMxNx4Param x4d_avx2_tests[] = {
   SadMxNx4Param(64, 64, &vpx_sad64x64x4d_avx2),
   SadMxNx4Param(32, 32, &vpx_sad32x32x4d_avx2),
+  SadMxNx4Param(16, 16, &vpx_sad16x16x4d_avx2),
+  SadMxNx4Param(16, 8, &vpx_sad16x8x4d_avx2),
+#if CONFIG_VP9_HIGHBITDEPTH
+  SadMxNx4Param(64, 64, &vpx_highbd_sad64x64x4d_avx2, 8),
+  SadMxNx4Param(64, 32, &vpx_highbd_sad64x32x4d_avx2, 8),
+  SadMxNx4Param(32, 64, &vpx_highbd_sad32x64x4d_avx2, 8),
+  SadMxNx4Param(32, 32, &vpx_highbd_sad32x32x4d_avx2, 8),
+  SadMxNx4Param(32, 16, &vpx_highbd_sad32x16x4d_avx2, 8),
+  SadMxNx4Param(16, 32, &vpx_highbd_sad16x32x4d_avx2, 8),
+  SadMxNx4Param(16, 16, &vpx_highbd_sad16x16x4d_avx2, 8),
+  SadMxNx4Param(16, 8, &vpx_highbd_sad16x8x4d_avx2, 8),
+  SadMxNx4Param(8, 16, &vpx_highbd_sad8x16x4d_avx2, 8),
+  SadMxNx4Param(8, 8, &vpx_highbd_sad8x8x4d_avx2, 8),
+  SadMxNx4Param(8, 4, &vpx_highbd_sad8x4x4d_avx2, 8),
+  SadMxNx4Param(4, 8, &vpx_highbd_sad4x8x4d_avx2, 8),
+  SadMxNx4Param(4, 4, &vpx_highbd_sad4x4x4d_avx2, 8),
+  SadMxNx4Param(64, 64, &vpx_highbd_sad64x64x4d_avx2, 10),
+  SadMxNx4Param(64, 32, &vpx_highbd_sad64x32x4d_avx2, 10),
+  SadMxNx4Param(32, 64, &vpx_highbd_sad32x64x4d_avx2, 10),
+  SadMxNx4Param(32, 32, &vpx_highbd_sad32x32x4d_avx2, 10),
+  SadMxNx4Param(32, 16, &vpx_highbd_sad32x16x4d_avx2, 10),
+  SadMxNx4Param(16, 32, &vpx_highbd_sad16x32x4d_avx2, 10),
+  SadMxNx4Param(16, 16, &vpx_highbd_sad16x16x4d_avx2, 10),
+  SadMxNx4Param(16, 8, &vpx_highbd_sad16x8x4d_avx2, 10),
+  SadMxNx4Param(8, 16, &vpx_highbd_sad8x16x4d_avx2, 10),
+  SadMxNx4Param(8, 8, &vpx_highbd_sad8x8x4d_avx2, 10),
+  SadMxNx4Param(8, 4, &vpx_highbd_sad8x4x4d_avx2, 10),
+  SadMxNx4Param(4, 8, &vpx_highbd_sad4x8x4d_avx2, 10),
+  SadMxNx4Param(4, 4, &vpx_highbd_sad4x4x4d_avx2, 10),
+  SadMxNx4Param(64, 64, &vpx_highbd_sad64x64x4d_avx2, 12),
+  SadMxNx4Param(64, 32, &vpx_highbd_sad64x32x4d_avx2, 12),
+  SadMxNx4Param(32, 64, &vpx_highbd_sad32x64x4d_avx2, 12),
+  SadMxNx4Param(32, 32, &vpx_highbd_sad32x32x4d_avx2, 12),
+  SadMxNx4Param(32, 16, &vpx_highbd_sad32x16x4d_avx2, 12),
+  SadMxNx4Param(16, 32, &vpx_highbd_sad16x32x4d_avx2, 12),
+  SadMxNx4Param(16, 16, &vpx_highbd_sad16x16x4d_avx2, 12),
+  SadMxNx4Param(16, 8, &vpx_highbd_sad16x8x4d_avx2, 12),
+  SadMxNx4Param(8, 16, &vpx_highbd_sad8x16x4d_avx2, 12),
+  SadMxNx4Param(8, 8, &vpx_highbd_sad8x8x4d_avx2, 12),
+  SadMxNx4Param(8, 4, &vpx_highbd_sad8x4x4d_avx2, 12),
+  SadMxNx4Param(4, 8, &vpx_highbd_sad4x8x4d_avx2, 12),
+  SadMxNx4Param(4, 4, &vpx_highbd_sad4x4x4d_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADx4Test, ::testing::ValuesIn(x4d_avx2_tests));
 
 const SadMxNx8Param x8_avx2_tests[] = {
   // SadMxNx8Param(64, 64, &vpx_sad64x64x8_c),
   SadMxNx8Param(32, 32, &vpx_sad32x32x8_avx2),
+  SadMxNx8Param(16, 16, &vpx_sad16x16x8_avx2),
+  SadMxNx8Param(16, 8, &vpx_sad16x8x8_avx2),
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADx8Test, ::testing::ValuesIn(x8_avx2_tests));
 #endif  // HAVE_AVX2
@@ -59,6 +59,8 @@ LIBVPX_TEST_SRCS-$(CONFIG_VP9_ENCODER) += svc_test.h
 LIBVPX_TEST_SRCS-$(CONFIG_VP9_ENCODER) += svc_end_to_end_test.cc
 LIBVPX_TEST_SRCS-$(CONFIG_VP9_ENCODER) += timestamp_test.cc
 LIBVPX_TEST_SRCS-$(CONFIG_VP9_ENCODER) += vp9_ext_ratectrl_test.cc
+LIBVPX_TEST_SRCS-$(CONFIG_VP9_ENCODER) += vp9_source_release_test.cc
+LIBVPX_TEST_SRCS-$(CONFIG_VP9_ENCODER) += vp9_multi_res_test.cc
 
 LIBVPX_TEST_SRCS-yes                   += decode_test_driver.cc
 LIBVPX_TEST_SRCS-yes                   += decode_test_driver.h
@@ -101,6 +103,11 @@ ifeq ($(CONFIG_ENCODE_PERF_TESTS)$(CONFIG_VP9_ENCODER), yesyes)
 LIBVPX_TEST_SRCS-yes += encode_perf_test.cc
 endif
 
+# Encode / decode throughput sweep over both codecs.
+ifeq ($(CONFIG_ENCODE_PERF_TESTS)$(CONFIG_ENCODERS), yesyes)
+LIBVPX_TEST_SRCS-yes += throughput_perf_test.cc
+endif
+
 ## Multi-codec blackbox tests.
 ifeq ($(findstring yes,$(CONFIG_VP8_DECODER)$(CONFIG_VP9_DECODER)), yes)
 LIBVPX_TEST_SRCS-yes += invalid_file_test.cc
@@ -135,6 +142,8 @@ LIBVPX_TEST_SRCS-$(CONFIG_VP8_ENCODER) += vp8_fdct4x4_test.cc
 
 LIBVPX_TEST_SRCS-yes                   += idct_test.cc
 LIBVPX_TEST_SRCS-yes                   += predict_test.cc
+LIBVPX_TEST_SRCS-yes                   += vp8_dequant_idct_test.cc
+LIBVPX_TEST_SRCS-yes                   += vp8_loopfilter_test.cc
 LIBVPX_TEST_SRCS-yes                   += vpx_scale_test.cc
 LIBVPX_TEST_SRCS-yes                   += vpx_scale_test.h
 
@@ -205,6 +214,7 @@ endif # VP9
 
 ## Multi-codec / unconditional whitebox tests.
 
+LIBVPX_TEST_SRCS-yes += vpx_mem_pool_test.cc
 LIBVPX_TEST_SRCS-$(CONFIG_ENCODERS) += sad_test.cc
 ifneq (, $(filter yes, $(HAVE_NEON) $(HAVE_SSE2) $(HAVE_MSA)))
 LIBVPX_TEST_SRCS-$(CONFIG_ENCODERS) += sum_squares_test.cc
@@ -213,6 +223,9 @@ endif
 TEST_INTRA_PRED_SPEED_SRCS-yes := test_intra_pred_speed.cc
 TEST_INTRA_PRED_SPEED_SRCS-yes += ../md5_utils.h ../md5_utils.c
 
+TEST_RTCD_SPEED_SRCS-yes := test_rtcd_speed.cc
+TEST_RTCD_SPEED_SRCS-yes += bench.h bench.cc
+
 RC_INTERFACE_TEST_SRCS-yes := test_rc_interface.cc
 RC_INTERFACE_TEST_SRCS-$(CONFIG_VP9_ENCODER) += vp9_ratectrl_rtc_test.cc
 RC_INTERFACE_TEST_SRCS-$(CONFIG_VP8_ENCODER) += vp8_ratectrl_rtc_test.cc
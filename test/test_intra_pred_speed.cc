@@ -233,25 +233,34 @@ INTRA_PRED_TEST(SSE2, TestIntraPred32, vpx_dc_predictor_32x32_sse2,
 
 #if HAVE_SSSE3
 INTRA_PRED_TEST(SSSE3, TestIntraPred4, nullptr, nullptr, nullptr, nullptr,
-                nullptr, nullptr, nullptr, nullptr, nullptr,
-                vpx_d153_predictor_4x4_ssse3, nullptr,
-                vpx_d63_predictor_4x4_ssse3, nullptr)
+                nullptr, nullptr, nullptr, vpx_d135_predictor_4x4_ssse3,
+                vpx_d117_predictor_4x4_ssse3, vpx_d153_predictor_4x4_ssse3,
+                nullptr, vpx_d63_predictor_4x4_ssse3, nullptr)
 INTRA_PRED_TEST(SSSE3, TestIntraPred8, nullptr, nullptr, nullptr, nullptr,
-                nullptr, nullptr, nullptr, nullptr, nullptr,
-                vpx_d153_predictor_8x8_ssse3, vpx_d207_predictor_8x8_ssse3,
-                vpx_d63_predictor_8x8_ssse3, nullptr)
-INTRA_PRED_TEST(SSSE3, TestIntraPred16, nullptr, nullptr, nullptr, nullptr,
-                nullptr, nullptr, vpx_d45_predictor_16x16_ssse3, nullptr,
-                nullptr, vpx_d153_predictor_16x16_ssse3,
-                vpx_d207_predictor_16x16_ssse3, vpx_d63_predictor_16x16_ssse3,
+                nullptr, nullptr, nullptr, vpx_d135_predictor_8x8_ssse3,
+                vpx_d117_predictor_8x8_ssse3, vpx_d153_predictor_8x8_ssse3,
+                vpx_d207_predictor_8x8_ssse3, vpx_d63_predictor_8x8_ssse3,
                 nullptr)
+INTRA_PRED_TEST(SSSE3, TestIntraPred16, nullptr, nullptr, nullptr, nullptr,
+                nullptr, nullptr, vpx_d45_predictor_16x16_ssse3,
+                vpx_d135_predictor_16x16_ssse3, vpx_d117_predictor_16x16_ssse3,
+                vpx_d153_predictor_16x16_ssse3, vpx_d207_predictor_16x16_ssse3,
+                vpx_d63_predictor_16x16_ssse3, nullptr)
 INTRA_PRED_TEST(SSSE3, TestIntraPred32, nullptr, nullptr, nullptr, nullptr,
-                nullptr, nullptr, vpx_d45_predictor_32x32_ssse3, nullptr,
-                nullptr, vpx_d153_predictor_32x32_ssse3,
-                vpx_d207_predictor_32x32_ssse3, vpx_d63_predictor_32x32_ssse3,
-                nullptr)
+                nullptr, nullptr, vpx_d45_predictor_32x32_ssse3,
+                vpx_d135_predictor_32x32_ssse3, vpx_d117_predictor_32x32_ssse3,
+                vpx_d153_predictor_32x32_ssse3, vpx_d207_predictor_32x32_ssse3,
+                vpx_d63_predictor_32x32_ssse3, nullptr)
 #endif  // HAVE_SSSE3
 
+#if HAVE_AVX2
+INTRA_PRED_TEST(AVX2, TestIntraPred32, nullptr, nullptr, nullptr, nullptr,
+                nullptr, nullptr, vpx_d45_predictor_32x32_avx2,
+                vpx_d135_predictor_32x32_avx2, vpx_d117_predictor_32x32_avx2,
+                vpx_d153_predictor_32x32_avx2, vpx_d207_predictor_32x32_avx2,
+                vpx_d63_predictor_32x32_avx2, nullptr)
+#endif  // HAVE_AVX2
+
 #if HAVE_DSPR2
 INTRA_PRED_TEST(DSPR2, TestIntraPred4, vpx_dc_predictor_4x4_dspr2, nullptr,
                 nullptr, nullptr, nullptr, vpx_h_predictor_4x4_dspr2, nullptr,
@@ -0,0 +1,1502 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+//  Time the C and SIMD specializations of the RTCD kernels.
+//
+//  Each test runs one specialization of one kernel at one block size and
+//  reports the median time per pixel (and timestamp counter cycles per pixel
+//  on x86). The results are also recorded as test properties, so running with
+//  --gtest_output=json:<file> produces machine-readable output with one entry
+//  per function, isa and block size.
+
+#include <stdio.h>
+#include <ostream>
+#include <string>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#if CONFIG_VP8
+#include "./vp8_rtcd.h"
+#endif
+#if CONFIG_VP9
+#include "./vp9_rtcd.h"
+#endif
+#include "test/acm_random.h"
+#include "test/bench.h"
+#include "test/clear_system_state.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/bitops.h"
+#include "vpx_ports/mem.h"
+#if CONFIG_VP8
+#include "vp8/common/loopfilter.h"
+#endif
+#if CONFIG_VP9
+#include "vp9/common/vp9_enums.h"
+#include "vp9/common/vp9_filter.h"
+#include "vp9/common/vp9_scan.h"
+#endif
+
+namespace {
+
+using libvpx_test::ACMRandom;
+
+// Pixels processed by each timed repetition. Smaller blocks are run more
+// often so that every block size is timed over a similar interval.
+const int kPixelsPerRun = 1 << 20;
+const int kMaxBlockSize = 64;
+const int kBorder = 16;
+const int kStride = kMaxBlockSize + 2 * kBorder;
+const int kBufferSize = kStride * kStride;
+const int kMaxCoeffs = kMaxBlockSize * kMaxBlockSize;
+
+// Loop filter thresholds, loaded 16 bytes at a time by the SIMD versions.
+DECLARE_ALIGNED(16, const uint8_t, kBlimit[16]) = {
+  60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60
+};
+DECLARE_ALIGNED(16, const uint8_t, kLimit[16]) = {
+  10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10
+};
+DECLARE_ALIGNED(16, const uint8_t, kThresh[16]) = { 4, 4, 4, 4, 4, 4, 4, 4,
+                                                    4, 4, 4, 4, 4, 4, 4, 4 };
+
+template <typename FuncType>
+struct RtcdFunc {
+  RtcdFunc(const char *n, const char *i, FuncType f, int w, int h)
+      : name(n), isa(i), func(f), width(w), height(h) {}
+
+  const char *name;
+  const char *isa;
+  FuncType func;
+  int width;
+  int height;
+};
+
+template <typename FuncType>
+std::ostream &operator<<(std::ostream &os, const RtcdFunc<FuncType> &p) {
+  return os << p.name << "_" << p.isa << " " << p.width << "x" << p.height;
+}
+
+// Builds the parameter for the |isa| specialization of |fn|, e.g.
+// RTCD_FUNC(FdctParam, vpx_fdct8x8, sse2, 8, 8).
+#define RTCD_FUNC(type, fn, isa, w, h) type(#fn, #isa, fn##_##isa, w, h)
+
+// Expands to one parameter per square block size for kernels that take the
+// block dimensions as arguments. |fn| is only pasted or stringized, as in
+// RTCD_FUNC(), so that it is not replaced by its RTCD macro.
+#define RTCD_FUNC_SIZES(type, fn, isa)                                  \
+  type(#fn, #isa, fn##_##isa, 4, 4), type(#fn, #isa, fn##_##isa, 8, 8), \
+      type(#fn, #isa, fn##_##isa, 16, 16),                              \
+      type(#fn, #isa, fn##_##isa, 32, 32),                              \
+      type(#fn, #isa, fn##_##isa, 64, 64)
+
+template <typename FuncType>
+class RtcdSpeedTest : public AbstractBench,
+                      public ::testing::TestWithParam<RtcdFunc<FuncType> > {
+ public:
+  RtcdSpeedTest() : params_(this->GetParam()) {}
+
+ protected:
+  void SetUp() override {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    src_buf_ = reinterpret_cast<uint8_t *>(vpx_memalign(32, kBufferSize));
+    ref_buf_ = reinterpret_cast<uint8_t *>(vpx_memalign(32, kBufferSize));
+    dst_buf_ = reinterpret_cast<uint8_t *>(vpx_memalign(32, kBufferSize));
+    input_ = reinterpret_cast<int16_t *>(
+        vpx_memalign(32, kMaxCoeffs * sizeof(*input_)));
+
+    coeff_ = reinterpret_cast<tran_low_t *>(
+        vpx_memalign(32, kMaxCoeffs * sizeof(*coeff_)));
+
+    dqcoeff_ = reinterpret_cast<tran_low_t *>(
+        vpx_memalign(32, kMaxCoeffs * sizeof(*dqcoeff_)));
+
+    out_ = reinterpret_cast<tran_low_t *>(
+        vpx_memalign(32, kMaxCoeffs * sizeof(*out_)));
+
+    ASSERT_NE(src_buf_, nullptr);
+    ASSERT_NE(ref_buf_, nullptr);
+    ASSERT_NE(dst_buf_, nullptr);
+    ASSERT_NE(input_, nullptr);
+    ASSERT_NE(coeff_, nullptr);
+    ASSERT_NE(dqcoeff_, nullptr);
+    ASSERT_NE(out_, nullptr);
+
+    for (int i = 0; i < kBufferSize; ++i) {
+      src_buf_[i] = rnd.Rand8();
+      ref_buf_[i] = rnd.Rand8();
+      dst_buf_[i] = rnd.Rand8();
+    }
+    // Residuals span the full 8-bit difference range. Coefficients are kept
+    // small enough that the quantizers leave a realistic mix of zero and
+    // non-zero values, and the inverse transforms do not overflow.
+    for (int i = 0; i < kMaxCoeffs; ++i) {
+      input_[i] = rnd.Rand8() - rnd.Rand8();
+      coeff_[i] = rnd.Rand8() - 128;
+      dqcoeff_[i] = (rnd.Rand8() >> 2) - 32;
+    }
+    sink_ = 0;
+  }
+
+  void TearDown() override {
+    vpx_free(src_buf_);
+    vpx_free(ref_buf_);
+    vpx_free(dst_buf_);
+    vpx_free(input_);
+    vpx_free(coeff_);
+    vpx_free(dqcoeff_);
+    vpx_free(out_);
+    libvpx_test::ClearSystemState();
+  }
+
+  uint8_t *src() const { return src_buf_ + kBorder * kStride + kBorder; }
+  uint8_t *ref() const { return ref_buf_ + kBorder * kStride + kBorder; }
+  uint8_t *dst() const { return dst_buf_ + kBorder * kStride + kBorder; }
+
+  void RunSpeedTest() {
+    const int pixels = params_.width * params_.height;
+    const int runs = VPXMAX(kPixelsPerRun / pixels, 1);
+    RunNTimes(runs);
+    libvpx_test::ClearSystemState();
+
+    const double total_pixels = static_cast<double>(runs) * pixels;
+    const double ns_per_pixel = GetMedianTime() * 1000.0 / total_pixels;
+    const double cycles_per_pixel = GetMedianCycles() / total_pixels;
+    char value[32];
+    printf("[ RTCD     ] %-30s %-7s %2dx%-2d %9.3f ns/pixel", params_.name,
+           params_.isa, params_.width, params_.height, ns_per_pixel);
+    if (cycles_per_pixel > 0) printf(" %9.3f cycles/pixel", cycles_per_pixel);
+    printf("\n");
+
+    ::testing::Test::RecordProperty("function", params_.name);
+    ::testing::Test::RecordProperty("isa", params_.isa);
+    ::testing::Test::RecordProperty("width", params_.width);
+    ::testing::Test::RecordProperty("height", params_.height);
+    snprintf(value, sizeof(value), "%.4f", ns_per_pixel);
+    ::testing::Test::RecordProperty("ns_per_pixel", value);
+    if (cycles_per_pixel > 0) {
+      snprintf(value, sizeof(value), "%.4f", cycles_per_pixel);
+      ::testing::Test::RecordProperty("cycles_per_pixel", value);
+    }
+  }
+
+  const RtcdFunc<FuncType> params_;
+  uint8_t *src_buf_;
+  uint8_t *ref_buf_;
+  uint8_t *dst_buf_;
+  int16_t *input_;
+  tran_low_t *coeff_;
+  tran_low_t *dqcoeff_;
+  tran_low_t *out_;
+  // Accumulates kernel results so that the calls cannot be optimized away.
+  volatile int64_t sink_;
+};
+
+// -----------------------------------------------------------------------------
+// vpx_dsp
+
+#if CONFIG_ENCODERS
+typedef unsigned int (*SadFunc)(const uint8_t *src_ptr, int src_stride,
+                                const uint8_t *ref_ptr, int ref_stride);
+typedef RtcdFunc<SadFunc> SadParam;
+#define SAD_FUNC(w, h, isa) \
+  SadParam("vpx_sad" #w "x" #h, #isa, vpx_sad##w##x##h##_##isa, w, h)
+
+class SadSpeedTest : public RtcdSpeedTest<SadFunc> {
+ protected:
+  void Run() override {
+    sink_ = sink_ + params_.func(src(), kStride, ref(), kStride);
+  }
+};
+
+TEST_P(SadSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, SadSpeedTest,
+    ::testing::Values(SAD_FUNC(64, 64, c), SAD_FUNC(64, 32, c),
+                      SAD_FUNC(32, 64, c), SAD_FUNC(32, 32, c),
+                      SAD_FUNC(32, 16, c), SAD_FUNC(16, 32, c),
+                      SAD_FUNC(16, 16, c), SAD_FUNC(16, 8, c),
+                      SAD_FUNC(8, 16, c), SAD_FUNC(8, 8, c), SAD_FUNC(8, 4, c),
+                      SAD_FUNC(4, 8, c), SAD_FUNC(4, 4, c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, SadSpeedTest,
+    ::testing::Values(SAD_FUNC(64, 64, sse2), SAD_FUNC(64, 32, sse2),
+                      SAD_FUNC(32, 64, sse2), SAD_FUNC(32, 32, sse2),
+                      SAD_FUNC(32, 16, sse2), SAD_FUNC(16, 32, sse2),
+                      SAD_FUNC(16, 16, sse2), SAD_FUNC(16, 8, sse2),
+                      SAD_FUNC(8, 16, sse2), SAD_FUNC(8, 8, sse2),
+                      SAD_FUNC(8, 4, sse2), SAD_FUNC(4, 8, sse2),
+                      SAD_FUNC(4, 4, sse2)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, SadSpeedTest,
+    ::testing::Values(SAD_FUNC(64, 64, avx2), SAD_FUNC(64, 32, avx2),
+                      SAD_FUNC(32, 64, avx2), SAD_FUNC(32, 32, avx2),
+                      SAD_FUNC(32, 16, avx2)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, SadSpeedTest,
+    ::testing::Values(SAD_FUNC(64, 64, neon), SAD_FUNC(64, 32, neon),
+                      SAD_FUNC(32, 64, neon), SAD_FUNC(32, 32, neon),
+                      SAD_FUNC(32, 16, neon), SAD_FUNC(16, 32, neon),
+                      SAD_FUNC(16, 16, neon), SAD_FUNC(16, 8, neon),
+                      SAD_FUNC(8, 16, neon), SAD_FUNC(8, 8, neon),
+                      SAD_FUNC(8, 4, neon), SAD_FUNC(4, 8, neon),
+                      SAD_FUNC(4, 4, neon)));
+
+#endif  // HAVE_NEON
+
+typedef unsigned int (*SadAvgFunc)(const uint8_t *src_ptr, int src_stride,
+                                   const uint8_t *ref_ptr, int ref_stride,
+                                   const uint8_t *second_pred);
+typedef RtcdFunc<SadAvgFunc> SadAvgParam;
+#define SAD_AVG_FUNC(w, h, isa)                                               \
+  SadAvgParam("vpx_sad" #w "x" #h "_avg", #isa, vpx_sad##w##x##h##_avg_##isa, \
+              w, h)
+
+class SadAvgSpeedTest : public RtcdSpeedTest<SadAvgFunc> {
+ protected:
+  void Run() override {
+    sink_ = sink_ + params_.func(src(), kStride, ref(), kStride, dst());
+  }
+};
+
+TEST_P(SadAvgSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, SadAvgSpeedTest,
+    ::testing::Values(SAD_AVG_FUNC(64, 64, c), SAD_AVG_FUNC(64, 32, c),
+                      SAD_AVG_FUNC(32, 64, c), SAD_AVG_FUNC(32, 32, c),
+                      SAD_AVG_FUNC(32, 16, c), SAD_AVG_FUNC(16, 32, c),
+                      SAD_AVG_FUNC(16, 16, c), SAD_AVG_FUNC(16, 8, c),
+                      SAD_AVG_FUNC(8, 16, c), SAD_AVG_FUNC(8, 8, c),
+                      SAD_AVG_FUNC(8, 4, c), SAD_AVG_FUNC(4, 8, c),
+                      SAD_AVG_FUNC(4, 4, c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, SadAvgSpeedTest,
+    ::testing::Values(SAD_AVG_FUNC(64, 64, sse2), SAD_AVG_FUNC(64, 32, sse2),
+                      SAD_AVG_FUNC(32, 64, sse2), SAD_AVG_FUNC(32, 32, sse2),
+                      SAD_AVG_FUNC(32, 16, sse2), SAD_AVG_FUNC(16, 32, sse2),
+                      SAD_AVG_FUNC(16, 16, sse2), SAD_AVG_FUNC(16, 8, sse2),
+                      SAD_AVG_FUNC(8, 16, sse2), SAD_AVG_FUNC(8, 8, sse2),
+                      SAD_AVG_FUNC(8, 4, sse2), SAD_AVG_FUNC(4, 8, sse2),
+                      SAD_AVG_FUNC(4, 4, sse2)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, SadAvgSpeedTest,
+    ::testing::Values(SAD_AVG_FUNC(64, 64, avx2), SAD_AVG_FUNC(64, 32, avx2),
+                      SAD_AVG_FUNC(32, 64, avx2), SAD_AVG_FUNC(32, 32, avx2),
+                      SAD_AVG_FUNC(32, 16, avx2)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, SadAvgSpeedTest,
+    ::testing::Values(SAD_AVG_FUNC(64, 64, neon), SAD_AVG_FUNC(64, 32, neon),
+                      SAD_AVG_FUNC(32, 64, neon), SAD_AVG_FUNC(32, 32, neon),
+                      SAD_AVG_FUNC(32, 16, neon), SAD_AVG_FUNC(16, 32, neon),
+                      SAD_AVG_FUNC(16, 16, neon), SAD_AVG_FUNC(16, 8, neon),
+                      SAD_AVG_FUNC(8, 16, neon), SAD_AVG_FUNC(8, 8, neon),
+                      SAD_AVG_FUNC(8, 4, neon), SAD_AVG_FUNC(4, 8, neon),
+                      SAD_AVG_FUNC(4, 4, neon)));
+
+#endif  // HAVE_NEON
+
+typedef void (*Sad4dFunc)(const uint8_t *src_ptr, int src_stride,
+                          const uint8_t *const ref_array[], int ref_stride,
+                          uint32_t *sad_array);
+typedef RtcdFunc<Sad4dFunc> Sad4dParam;
+#define SAD4D_FUNC(w, h, isa) \
+  Sad4dParam("vpx_sad" #w "x" #h "x4d", #isa, vpx_sad##w##x##h##x4d_##isa, w, h)
+
+class Sad4dSpeedTest : public RtcdSpeedTest<Sad4dFunc> {
+ protected:
+  void SetUp() override {
+    RtcdSpeedTest<Sad4dFunc>::SetUp();
+    refs_[0] = ref();
+    refs_[1] = ref() + 1;
+    refs_[2] = ref() + kStride;
+    refs_[3] = ref() + kStride + 1;
+  }
+
+  // Each call searches four candidates, so the reported time is per source
+  // pixel for all four.
+  void Run() override {
+    uint32_t sads[4];
+    params_.func(src(), kStride, refs_, kStride, sads);
+    sink_ = sink_ + sads[0] + sads[1] + sads[2] + sads[3];
+  }
+
+  const uint8_t *refs_[4];
+};
+
+TEST_P(Sad4dSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Sad4dSpeedTest,
+    ::testing::Values(SAD4D_FUNC(64, 64, c), SAD4D_FUNC(64, 32, c),
+                      SAD4D_FUNC(32, 64, c), SAD4D_FUNC(32, 32, c),
+                      SAD4D_FUNC(32, 16, c), SAD4D_FUNC(16, 32, c),
+                      SAD4D_FUNC(16, 16, c), SAD4D_FUNC(16, 8, c),
+                      SAD4D_FUNC(8, 16, c), SAD4D_FUNC(8, 8, c),
+                      SAD4D_FUNC(8, 4, c), SAD4D_FUNC(4, 8, c),
+                      SAD4D_FUNC(4, 4, c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Sad4dSpeedTest,
+    ::testing::Values(SAD4D_FUNC(64, 64, sse2), SAD4D_FUNC(64, 32, sse2),
+                      SAD4D_FUNC(32, 64, sse2), SAD4D_FUNC(32, 32, sse2),
+                      SAD4D_FUNC(32, 16, sse2), SAD4D_FUNC(16, 32, sse2),
+                      SAD4D_FUNC(16, 16, sse2), SAD4D_FUNC(16, 8, sse2),
+                      SAD4D_FUNC(8, 16, sse2), SAD4D_FUNC(8, 8, sse2),
+                      SAD4D_FUNC(8, 4, sse2), SAD4D_FUNC(4, 8, sse2),
+                      SAD4D_FUNC(4, 4, sse2)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Sad4dSpeedTest,
+    ::testing::Values(SAD4D_FUNC(64, 64, avx2), SAD4D_FUNC(32, 32, avx2),
+                      SAD4D_FUNC(16, 16, avx2), SAD4D_FUNC(16, 8, avx2)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_AVX512
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, Sad4dSpeedTest,
+    ::testing::Values(SAD4D_FUNC(64, 64, avx512)));
+
+#endif  // HAVE_AVX512
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Sad4dSpeedTest,
+    ::testing::Values(SAD4D_FUNC(64, 64, neon), SAD4D_FUNC(64, 32, neon),
+                      SAD4D_FUNC(32, 64, neon), SAD4D_FUNC(32, 32, neon),
+                      SAD4D_FUNC(32, 16, neon), SAD4D_FUNC(16, 32, neon),
+                      SAD4D_FUNC(16, 16, neon), SAD4D_FUNC(16, 8, neon),
+                      SAD4D_FUNC(8, 16, neon), SAD4D_FUNC(8, 8, neon),
+                      SAD4D_FUNC(8, 4, neon), SAD4D_FUNC(4, 8, neon),
+                      SAD4D_FUNC(4, 4, neon)));
+
+#endif  // HAVE_NEON
+
+typedef void (*SubtractFunc)(int rows, int cols, int16_t *diff_ptr,
+                             ptrdiff_t diff_stride, const uint8_t *src_ptr,
+                             ptrdiff_t src_stride, const uint8_t *pred_ptr,
+                             ptrdiff_t pred_stride);
+typedef RtcdFunc<SubtractFunc> SubtractParam;
+
+class SubtractSpeedTest : public RtcdSpeedTest<SubtractFunc> {
+ protected:
+  void Run() override {
+    params_.func(params_.height, params_.width, input_, kMaxBlockSize, src(),
+                 kStride, ref(), kStride);
+  }
+};
+
+TEST_P(SubtractSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, SubtractSpeedTest,
+    ::testing::Values(RTCD_FUNC_SIZES(SubtractParam, vpx_subtract_block, c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, SubtractSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC_SIZES(SubtractParam, vpx_subtract_block, sse2)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, SubtractSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC_SIZES(SubtractParam, vpx_subtract_block, neon)));
+
+#endif  // HAVE_NEON
+
+#endif  // CONFIG_ENCODERS
+
+#if CONFIG_ENCODERS || CONFIG_POSTPROC || CONFIG_VP9_POSTPROC
+typedef unsigned int (*VarianceFunc)(const uint8_t *src_ptr, int src_stride,
+                                     const uint8_t *ref_ptr, int ref_stride,
+                                     unsigned int *sse);
+typedef RtcdFunc<VarianceFunc> VarianceParam;
+#define VARIANCE_FUNC(w, h, isa)                                               \
+  VarianceParam("vpx_variance" #w "x" #h, #isa, vpx_variance##w##x##h##_##isa, \
+                w, h)
+
+class VarianceSpeedTest : public RtcdSpeedTest<VarianceFunc> {
+ protected:
+  void Run() override {
+    unsigned int sse;
+    sink_ = sink_ + params_.func(src(), kStride, ref(), kStride, &sse) + sse;
+  }
+};
+
+TEST_P(VarianceSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, VarianceSpeedTest,
+    ::testing::Values(VARIANCE_FUNC(64, 64, c), VARIANCE_FUNC(64, 32, c),
+                      VARIANCE_FUNC(32, 64, c), VARIANCE_FUNC(32, 32, c),
+                      VARIANCE_FUNC(32, 16, c), VARIANCE_FUNC(16, 32, c),
+                      VARIANCE_FUNC(16, 16, c), VARIANCE_FUNC(16, 8, c),
+                      VARIANCE_FUNC(8, 16, c), VARIANCE_FUNC(8, 8, c),
+                      VARIANCE_FUNC(8, 4, c), VARIANCE_FUNC(4, 8, c),
+                      VARIANCE_FUNC(4, 4, c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, VarianceSpeedTest,
+    ::testing::Values(VARIANCE_FUNC(64, 64, sse2), VARIANCE_FUNC(64, 32, sse2),
+                      VARIANCE_FUNC(32, 64, sse2), VARIANCE_FUNC(32, 32, sse2),
+                      VARIANCE_FUNC(32, 16, sse2), VARIANCE_FUNC(16, 32, sse2),
+                      VARIANCE_FUNC(16, 16, sse2), VARIANCE_FUNC(16, 8, sse2),
+                      VARIANCE_FUNC(8, 16, sse2), VARIANCE_FUNC(8, 8, sse2),
+                      VARIANCE_FUNC(8, 4, sse2), VARIANCE_FUNC(4, 8, sse2),
+                      VARIANCE_FUNC(4, 4, sse2)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, VarianceSpeedTest,
+    ::testing::Values(VARIANCE_FUNC(64, 64, avx2), VARIANCE_FUNC(64, 32, avx2),
+                      VARIANCE_FUNC(32, 64, avx2), VARIANCE_FUNC(32, 32, avx2),
+                      VARIANCE_FUNC(32, 16, avx2), VARIANCE_FUNC(16, 32, avx2),
+                      VARIANCE_FUNC(16, 16, avx2), VARIANCE_FUNC(16, 8, avx2)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, VarianceSpeedTest,
+    ::testing::Values(VARIANCE_FUNC(64, 64, neon), VARIANCE_FUNC(64, 32, neon),
+                      VARIANCE_FUNC(32, 64, neon), VARIANCE_FUNC(32, 32, neon),
+                      VARIANCE_FUNC(32, 16, neon), VARIANCE_FUNC(16, 32, neon),
+                      VARIANCE_FUNC(16, 16, neon), VARIANCE_FUNC(16, 8, neon),
+                      VARIANCE_FUNC(8, 16, neon), VARIANCE_FUNC(8, 8, neon),
+                      VARIANCE_FUNC(8, 4, neon), VARIANCE_FUNC(4, 8, neon),
+                      VARIANCE_FUNC(4, 4, neon)));
+
+#endif  // HAVE_NEON
+
+typedef uint32_t (*SubpelVarianceFunc)(const uint8_t *src_ptr, int src_stride,
+                                       int x_offset, int y_offset,
+                                       const uint8_t *ref_ptr, int ref_stride,
+                                       uint32_t *sse);
+typedef RtcdFunc<SubpelVarianceFunc> SubpelVarianceParam;
+#define SUBPEL_VARIANCE_FUNC(w, h, isa)                         \
+  SubpelVarianceParam("vpx_sub_pixel_variance" #w "x" #h, #isa, \
+                      vpx_sub_pixel_variance##w##x##h##_##isa, w, h)
+
+class SubpelVarianceSpeedTest : public RtcdSpeedTest<SubpelVarianceFunc> {
+ protected:
+  // Both offsets are fractional so that the two-pass path is timed.
+  void Run() override {
+    uint32_t sse;
+    sink_ = sink_ + params_.func(src(), kStride, 3, 5, ref(), kStride, &sse) +
+            sse;
+  }
+};
+
+TEST_P(SubpelVarianceSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, SubpelVarianceSpeedTest,
+    ::testing::Values(SUBPEL_VARIANCE_FUNC(64, 64, c),
+                      SUBPEL_VARIANCE_FUNC(64, 32, c),
+                      SUBPEL_VARIANCE_FUNC(32, 64, c),
+                      SUBPEL_VARIANCE_FUNC(32, 32, c),
+                      SUBPEL_VARIANCE_FUNC(32, 16, c),
+                      SUBPEL_VARIANCE_FUNC(16, 32, c),
+                      SUBPEL_VARIANCE_FUNC(16, 16, c),
+                      SUBPEL_VARIANCE_FUNC(16, 8, c),
+                      SUBPEL_VARIANCE_FUNC(8, 16, c),
+                      SUBPEL_VARIANCE_FUNC(8, 8, c),
+                      SUBPEL_VARIANCE_FUNC(8, 4, c),
+                      SUBPEL_VARIANCE_FUNC(4, 8, c),
+                      SUBPEL_VARIANCE_FUNC(4, 4, c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, SubpelVarianceSpeedTest,
+    ::testing::Values(SUBPEL_VARIANCE_FUNC(64, 64, sse2),
+                      SUBPEL_VARIANCE_FUNC(64, 32, sse2),
+                      SUBPEL_VARIANCE_FUNC(32, 64, sse2),
+                      SUBPEL_VARIANCE_FUNC(32, 32, sse2),
+                      SUBPEL_VARIANCE_FUNC(32, 16, sse2),
+                      SUBPEL_VARIANCE_FUNC(16, 32, sse2),
+                      SUBPEL_VARIANCE_FUNC(16, 16, sse2),
+                      SUBPEL_VARIANCE_FUNC(16, 8, sse2),
+                      SUBPEL_VARIANCE_FUNC(8, 16, sse2),
+                      SUBPEL_VARIANCE_FUNC(8, 8, sse2),
+                      SUBPEL_VARIANCE_FUNC(8, 4, sse2),
+                      SUBPEL_VARIANCE_FUNC(4, 8, sse2),
+                      SUBPEL_VARIANCE_FUNC(4, 4, sse2)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_SUITE_P(
+    SSSE3, SubpelVarianceSpeedTest,
+    ::testing::Values(SUBPEL_VARIANCE_FUNC(64, 64, ssse3),
+                      SUBPEL_VARIANCE_FUNC(64, 32, ssse3),
+                      SUBPEL_VARIANCE_FUNC(32, 64, ssse3),
+                      SUBPEL_VARIANCE_FUNC(32, 32, ssse3),
+                      SUBPEL_VARIANCE_FUNC(32, 16, ssse3),
+                      SUBPEL_VARIANCE_FUNC(16, 32, ssse3),
+                      SUBPEL_VARIANCE_FUNC(16, 16, ssse3),
+                      SUBPEL_VARIANCE_FUNC(16, 8, ssse3),
+                      SUBPEL_VARIANCE_FUNC(8, 16, ssse3),
+                      SUBPEL_VARIANCE_FUNC(8, 8, ssse3),
+                      SUBPEL_VARIANCE_FUNC(8, 4, ssse3),
+                      SUBPEL_VARIANCE_FUNC(4, 8, ssse3),
+                      SUBPEL_VARIANCE_FUNC(4, 4, ssse3)));
+
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, SubpelVarianceSpeedTest,
+    ::testing::Values(SUBPEL_VARIANCE_FUNC(64, 64, avx2),
+                      SUBPEL_VARIANCE_FUNC(32, 32, avx2)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, SubpelVarianceSpeedTest,
+    ::testing::Values(SUBPEL_VARIANCE_FUNC(64, 64, neon),
+                      SUBPEL_VARIANCE_FUNC(64, 32, neon),
+                      SUBPEL_VARIANCE_FUNC(32, 64, neon),
+                      SUBPEL_VARIANCE_FUNC(32, 32, neon),
+                      SUBPEL_VARIANCE_FUNC(32, 16, neon),
+                      SUBPEL_VARIANCE_FUNC(16, 32, neon),
+                      SUBPEL_VARIANCE_FUNC(16, 16, neon),
+                      SUBPEL_VARIANCE_FUNC(16, 8, neon),
+                      SUBPEL_VARIANCE_FUNC(8, 16, neon),
+                      SUBPEL_VARIANCE_FUNC(8, 8, neon),
+                      SUBPEL_VARIANCE_FUNC(8, 4, neon),
+                      SUBPEL_VARIANCE_FUNC(4, 8, neon),
+                      SUBPEL_VARIANCE_FUNC(4, 4, neon)));
+
+#endif  // HAVE_NEON
+
+#endif  // CONFIG_ENCODERS || CONFIG_POSTPROC || CONFIG_VP9_POSTPROC
+
+#if CONFIG_VP9
+typedef void (*ConvolveFunc)(const uint8_t *src, ptrdiff_t src_stride,
+                             uint8_t *dst, ptrdiff_t dst_stride,
+                             const InterpKernel *filter, int x0_q4,
+                             int x_step_q4, int y0_q4, int y_step_q4, int w,
+                             int h);
+typedef RtcdFunc<ConvolveFunc> ConvolveParam;
+
+class ConvolveSpeedTest : public RtcdSpeedTest<ConvolveFunc> {
+ protected:
+  // Half-pel phase in both directions with unscaled steps.
+  void Run() override {
+    params_.func(src(), kStride, dst(), kStride, vp9_filter_kernels[EIGHTTAP],
+                 8, 16, 8, 16, params_.width, params_.height);
+  }
+};
+
+TEST_P(ConvolveSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, ConvolveSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve_copy, c),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve_avg, c),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8, c),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_horiz, c),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_vert, c),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg, c),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_horiz, c),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_vert, c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, ConvolveSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve_copy, sse2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve_avg, sse2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8, sse2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_horiz, sse2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_vert, sse2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg, sse2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_horiz, sse2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_vert, sse2)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_SUITE_P(
+    SSSE3, ConvolveSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8, ssse3),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_horiz, ssse3),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_vert, ssse3),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg, ssse3),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_horiz, ssse3),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_vert, ssse3)));
+
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, ConvolveSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8, avx2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_horiz, avx2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_vert, avx2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg, avx2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_horiz, avx2),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_vert, avx2)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, ConvolveSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve_copy, neon),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve_avg, neon),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8, neon),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_horiz, neon),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_vert, neon),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg, neon),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_horiz, neon),
+        RTCD_FUNC_SIZES(ConvolveParam, vpx_convolve8_avg_vert, neon)));
+
+#endif  // HAVE_NEON
+
+typedef void (*LoopFilterFunc)(uint8_t *s, int pitch, const uint8_t *blimit,
+                               const uint8_t *limit, const uint8_t *thresh);
+typedef RtcdFunc<LoopFilterFunc> LoopFilterParam;
+
+// The block size of a loop filter is the length of the edge it filters.
+class LoopFilterSpeedTest : public RtcdSpeedTest<LoopFilterFunc> {
+ protected:
+  void SetUp() override {
+    RtcdSpeedTest<LoopFilterFunc>::SetUp();
+    // Low amplitude noise keeps every edge below the filter thresholds, so
+    // the filters are applied rather than skipped.
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    for (int i = 0; i < kBufferSize; ++i) dst_buf_[i] = 128 + rnd(7) - 3;
+  }
+
+  void Run() override {
+    params_.func(dst() + kMaxBlockSize / 2 * (kStride + 1), kStride, kBlimit,
+                 kLimit, kThresh);
+  }
+};
+
+TEST_P(LoopFilterSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, LoopFilterSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_4, c, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_8, c, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_16, c, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_16_dual, c, 16, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_4, c, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_8, c, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_16, c, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_16_dual, c, 1, 16)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, LoopFilterSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_4, sse2, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_8, sse2, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_16, sse2, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_16_dual, sse2, 16, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_4, sse2, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_8, sse2, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_16, sse2, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_16_dual, sse2, 1, 16)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, LoopFilterSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_16, avx2, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_16_dual, avx2, 16, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_16_dual, avx2, 1, 16)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, LoopFilterSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_4, neon, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_8, neon, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_16, neon, 8, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_horizontal_16_dual, neon, 16, 1),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_4, neon, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_8, neon, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_16, neon, 1, 8),
+        RTCD_FUNC(LoopFilterParam, vpx_lpf_vertical_16_dual, neon, 1, 16)));
+
+#endif  // HAVE_NEON
+
+typedef void (*IdctFunc)(const tran_low_t *input, uint8_t *dest, int stride);
+typedef RtcdFunc<IdctFunc> IdctParam;
+
+class IdctSpeedTest : public RtcdSpeedTest<IdctFunc> {
+ protected:
+  void Run() override { params_.func(dqcoeff_, dst(), kStride); }
+};
+
+TEST_P(IdctSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, IdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(IdctParam, vpx_idct4x4_16_add, c, 4, 4),
+                      RTCD_FUNC(IdctParam, vpx_idct8x8_64_add, c, 8, 8),
+                      RTCD_FUNC(IdctParam, vpx_idct16x16_256_add, c, 16, 16),
+                      RTCD_FUNC(IdctParam, vpx_idct32x32_1024_add, c, 32, 32)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, IdctSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(IdctParam, vpx_idct4x4_16_add, sse2, 4, 4),
+        RTCD_FUNC(IdctParam, vpx_idct8x8_64_add, sse2, 8, 8),
+        RTCD_FUNC(IdctParam, vpx_idct16x16_256_add, sse2, 16, 16),
+        RTCD_FUNC(IdctParam, vpx_idct32x32_1024_add, sse2, 32, 32)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, IdctSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(IdctParam, vpx_idct16x16_256_add, avx2, 16, 16),
+        RTCD_FUNC(IdctParam, vpx_idct32x32_1024_add, avx2, 32, 32)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, IdctSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(IdctParam, vpx_idct4x4_16_add, neon, 4, 4),
+        RTCD_FUNC(IdctParam, vpx_idct8x8_64_add, neon, 8, 8),
+        RTCD_FUNC(IdctParam, vpx_idct16x16_256_add, neon, 16, 16),
+        RTCD_FUNC(IdctParam, vpx_idct32x32_1024_add, neon, 32, 32)));
+
+#endif  // HAVE_NEON
+
+typedef void (*IhtFunc)(const tran_low_t *input, uint8_t *dest, int stride,
+                        int tx_type);
+typedef RtcdFunc<IhtFunc> IhtParam;
+
+class Vp9IhtSpeedTest : public RtcdSpeedTest<IhtFunc> {
+ protected:
+  void Run() override { params_.func(dqcoeff_, dst(), kStride, ADST_ADST); }
+};
+
+TEST_P(Vp9IhtSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Vp9IhtSpeedTest,
+    ::testing::Values(RTCD_FUNC(IhtParam, vp9_iht4x4_16_add, c, 4, 4),
+                      RTCD_FUNC(IhtParam, vp9_iht8x8_64_add, c, 8, 8),
+                      RTCD_FUNC(IhtParam, vp9_iht16x16_256_add, c, 16, 16)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp9IhtSpeedTest,
+    ::testing::Values(RTCD_FUNC(IhtParam, vp9_iht4x4_16_add, sse2, 4, 4),
+                      RTCD_FUNC(IhtParam, vp9_iht8x8_64_add, sse2, 8, 8),
+                      RTCD_FUNC(IhtParam, vp9_iht16x16_256_add, sse2, 16, 16)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Vp9IhtSpeedTest,
+    ::testing::Values(RTCD_FUNC(IhtParam, vp9_iht8x8_64_add, avx2, 8, 8),
+                      RTCD_FUNC(IhtParam, vp9_iht16x16_256_add, avx2, 16, 16)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Vp9IhtSpeedTest,
+    ::testing::Values(RTCD_FUNC(IhtParam, vp9_iht4x4_16_add, neon, 4, 4),
+                      RTCD_FUNC(IhtParam, vp9_iht8x8_64_add, neon, 8, 8),
+                      RTCD_FUNC(IhtParam, vp9_iht16x16_256_add, neon, 16, 16)));
+
+#endif  // HAVE_NEON
+
+#endif  // CONFIG_VP9
+
+#if CONFIG_VP9_ENCODER
+typedef void (*FdctFunc)(const int16_t *input, tran_low_t *output, int stride);
+typedef RtcdFunc<FdctFunc> FdctParam;
+
+class FdctSpeedTest : public RtcdSpeedTest<FdctFunc> {
+ protected:
+  void Run() override { params_.func(input_, out_, kMaxBlockSize); }
+};
+
+TEST_P(FdctSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, FdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(FdctParam, vpx_fdct4x4, c, 4, 4),
+                      RTCD_FUNC(FdctParam, vpx_fdct8x8, c, 8, 8),
+                      RTCD_FUNC(FdctParam, vpx_fdct16x16, c, 16, 16),
+                      RTCD_FUNC(FdctParam, vpx_fdct32x32, c, 32, 32),
+                      RTCD_FUNC(FdctParam, vpx_fdct32x32_rd, c, 32, 32),
+                      RTCD_FUNC(FdctParam, vp9_fwht4x4, c, 4, 4)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, FdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(FdctParam, vpx_fdct4x4, sse2, 4, 4),
+                      RTCD_FUNC(FdctParam, vpx_fdct8x8, sse2, 8, 8),
+                      RTCD_FUNC(FdctParam, vpx_fdct16x16, sse2, 16, 16),
+                      RTCD_FUNC(FdctParam, vpx_fdct32x32, sse2, 32, 32),
+                      RTCD_FUNC(FdctParam, vpx_fdct32x32_rd, sse2, 32, 32),
+                      RTCD_FUNC(FdctParam, vp9_fwht4x4, sse2, 4, 4)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, FdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(FdctParam, vpx_fdct8x8, avx2, 8, 8),
+                      RTCD_FUNC(FdctParam, vpx_fdct16x16, avx2, 16, 16),
+                      RTCD_FUNC(FdctParam, vpx_fdct32x32, avx2, 32, 32),
+                      RTCD_FUNC(FdctParam, vpx_fdct32x32_rd, avx2, 32, 32)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, FdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(FdctParam, vpx_fdct4x4, neon, 4, 4),
+                      RTCD_FUNC(FdctParam, vpx_fdct8x8, neon, 8, 8),
+                      RTCD_FUNC(FdctParam, vpx_fdct16x16, neon, 16, 16),
+                      RTCD_FUNC(FdctParam, vpx_fdct32x32, neon, 32, 32),
+                      RTCD_FUNC(FdctParam, vpx_fdct32x32_rd, neon, 32, 32)));
+
+#endif  // HAVE_NEON
+
+typedef void (*HadamardFunc)(const int16_t *src_diff, ptrdiff_t src_stride,
+                             tran_low_t *coeff);
+typedef RtcdFunc<HadamardFunc> HadamardParam;
+
+class HadamardSpeedTest : public RtcdSpeedTest<HadamardFunc> {
+ protected:
+  void Run() override { params_.func(input_, kMaxBlockSize, out_); }
+};
+
+TEST_P(HadamardSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, HadamardSpeedTest,
+    ::testing::Values(RTCD_FUNC(HadamardParam, vpx_hadamard_8x8, c, 8, 8),
+                      RTCD_FUNC(HadamardParam, vpx_hadamard_16x16, c, 16, 16),
+                      RTCD_FUNC(HadamardParam, vpx_hadamard_32x32, c, 32, 32)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, HadamardSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(HadamardParam, vpx_hadamard_8x8, sse2, 8, 8),
+        RTCD_FUNC(HadamardParam, vpx_hadamard_16x16, sse2, 16, 16),
+        RTCD_FUNC(HadamardParam, vpx_hadamard_32x32, sse2, 32, 32)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_SUITE_P(
+    SSSE3, HadamardSpeedTest,
+    ::testing::Values(RTCD_FUNC(HadamardParam, vpx_hadamard_8x8, ssse3, 8, 8)));
+
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, HadamardSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(HadamardParam, vpx_hadamard_16x16, avx2, 16, 16),
+        RTCD_FUNC(HadamardParam, vpx_hadamard_32x32, avx2, 32, 32)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, HadamardSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(HadamardParam, vpx_hadamard_8x8, neon, 8, 8),
+        RTCD_FUNC(HadamardParam, vpx_hadamard_16x16, neon, 16, 16)));
+
+#endif  // HAVE_NEON
+
+// Quantizer tables for a q of 32 (dc) and 40 (ac), laid out as in the
+// encoder: the dc entry followed by seven copies of the ac entry.
+DECLARE_ALIGNED(16, const int16_t, kZbin[8]) = { 21, 26, 26, 26,
+                                                 26, 26, 26, 26 };
+DECLARE_ALIGNED(16, const int16_t, kRound[8]) = { 12, 15, 15, 15,
+                                                  15, 15, 15, 15 };
+DECLARE_ALIGNED(16, const int16_t, kQuant[8]) = { 1,      -13107, -13107,
+                                                  -13107, -13107, -13107,
+                                                  -13107, -13107 };
+DECLARE_ALIGNED(16, const int16_t, kQuantShift[8]) = { 2048, 2048, 2048, 2048,
+                                                       2048, 2048, 2048, 2048 };
+DECLARE_ALIGNED(16, const int16_t, kRoundFp[8]) = { 16, 20, 20, 20,
+                                                    20, 20, 20, 20 };
+DECLARE_ALIGNED(16, const int16_t, kQuantFp[8]) = { 2048, 1638, 1638, 1638,
+                                                    1638, 1638, 1638, 1638 };
+DECLARE_ALIGNED(16, const int16_t, kDequant[8]) = { 32, 40, 40, 40,
+                                                    40, 40, 40, 40 };
+
+template <typename FuncType>
+class QuantizeSpeedTestBase : public RtcdSpeedTest<FuncType> {
+ protected:
+  void SetUp() override {
+    RtcdSpeedTest<FuncType>::SetUp();
+    const int tx_size = get_msb(this->params_.width) - 2;
+    scan_order_ = &vp9_default_scan_orders[tx_size];
+  }
+
+  const scan_order *scan_order_;
+  uint16_t eob_;
+};
+
+typedef void (*QuantizeFunc)(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                             int skip_block, const int16_t *zbin_ptr,
+                             const int16_t *round_ptr, const int16_t *quant_ptr,
+                             const int16_t *quant_shift_ptr,
+                             tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                             const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                             const int16_t *scan, const int16_t *iscan);
+typedef RtcdFunc<QuantizeFunc> QuantizeParam;
+
+class QuantizeSpeedTest : public QuantizeSpeedTestBase<QuantizeFunc> {
+ protected:
+  void Run() override {
+    params_.func(coeff_, params_.width * params_.height, 0, kZbin, kRound,
+                 kQuant, kQuantShift, out_, dqcoeff_, kDequant, &eob_,
+                 scan_order_->scan, scan_order_->iscan);
+  }
+};
+
+TEST_P(QuantizeSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, QuantizeSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, c, 4, 4),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, c, 8, 8),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, c, 16, 16),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b_32x32, c, 32, 32)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, QuantizeSpeedTest,
+    ::testing::Values(RTCD_FUNC(QuantizeParam, vpx_quantize_b, sse2, 4, 4),
+                      RTCD_FUNC(QuantizeParam, vpx_quantize_b, sse2, 8, 8),
+                      RTCD_FUNC(QuantizeParam, vpx_quantize_b, sse2, 16, 16)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_SUITE_P(
+    SSSE3, QuantizeSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, ssse3, 4, 4),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, ssse3, 8, 8),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, ssse3, 16, 16),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b_32x32, ssse3, 32, 32)));
+
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX
+INSTANTIATE_TEST_SUITE_P(
+    AVX, QuantizeSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, avx, 4, 4),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, avx, 8, 8),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, avx, 16, 16),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b_32x32, avx, 32, 32)));
+
+#endif  // HAVE_AVX
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, QuantizeSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, neon, 4, 4),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, neon, 8, 8),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b, neon, 16, 16),
+        RTCD_FUNC(QuantizeParam, vpx_quantize_b_32x32, neon, 32, 32)));
+
+#endif  // HAVE_NEON
+
+typedef void (*QuantizeFpFunc)(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *round_ptr,
+                               const int16_t *quant_ptr, tran_low_t *qcoeff_ptr,
+                               tran_low_t *dqcoeff_ptr,
+                               const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                               const int16_t *scan, const int16_t *iscan);
+typedef RtcdFunc<QuantizeFpFunc> QuantizeFpParam;
+
+class QuantizeFpSpeedTest : public QuantizeSpeedTestBase<QuantizeFpFunc> {
+ protected:
+  void Run() override {
+    params_.func(coeff_, params_.width * params_.height, 0, kRoundFp, kQuantFp,
+                 out_, dqcoeff_, kDequant, &eob_, scan_order_->scan,
+                 scan_order_->iscan);
+  }
+};
+
+TEST_P(QuantizeFpSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, QuantizeFpSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, c, 4, 4),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, c, 8, 8),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, c, 16, 16),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp_32x32, c, 32, 32)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, QuantizeFpSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, sse2, 4, 4),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, sse2, 8, 8),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, sse2, 16, 16)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_SUITE_P(
+    SSSE3, QuantizeFpSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, ssse3, 4, 4),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, ssse3, 8, 8),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, ssse3, 16, 16),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp_32x32, ssse3, 32, 32)));
+
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, QuantizeFpSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, avx2, 4, 4),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, avx2, 8, 8),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, avx2, 16, 16),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp_32x32, avx2, 32, 32)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, QuantizeFpSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, neon, 4, 4),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, neon, 8, 8),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp, neon, 16, 16),
+        RTCD_FUNC(QuantizeFpParam, vp9_quantize_fp_32x32, neon, 32, 32)));
+
+#endif  // HAVE_NEON
+
+typedef void (*FhtFunc)(const int16_t *input, tran_low_t *output, int stride,
+                        int tx_type);
+typedef RtcdFunc<FhtFunc> FhtParam;
+
+class Vp9FhtSpeedTest : public RtcdSpeedTest<FhtFunc> {
+ protected:
+  void Run() override { params_.func(input_, out_, kMaxBlockSize, ADST_ADST); }
+};
+
+TEST_P(Vp9FhtSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Vp9FhtSpeedTest,
+    ::testing::Values(RTCD_FUNC(FhtParam, vp9_fht4x4, c, 4, 4),
+                      RTCD_FUNC(FhtParam, vp9_fht8x8, c, 8, 8),
+                      RTCD_FUNC(FhtParam, vp9_fht16x16, c, 16, 16)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp9FhtSpeedTest,
+    ::testing::Values(RTCD_FUNC(FhtParam, vp9_fht4x4, sse2, 4, 4),
+                      RTCD_FUNC(FhtParam, vp9_fht8x8, sse2, 8, 8),
+                      RTCD_FUNC(FhtParam, vp9_fht16x16, sse2, 16, 16)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Vp9FhtSpeedTest,
+    ::testing::Values(RTCD_FUNC(FhtParam, vp9_fht8x8, avx2, 8, 8),
+                      RTCD_FUNC(FhtParam, vp9_fht16x16, avx2, 16, 16)));
+
+#endif  // HAVE_AVX2
+
+typedef int64_t (*BlockErrorFunc)(const tran_low_t *coeff,
+                                  const tran_low_t *dqcoeff,
+                                  intptr_t block_size, int64_t *ssz);
+typedef RtcdFunc<BlockErrorFunc> BlockErrorParam;
+
+class Vp9BlockErrorSpeedTest : public RtcdSpeedTest<BlockErrorFunc> {
+ protected:
+  void Run() override {
+    int64_t ssz;
+    sink_ = sink_ +
+            params_.func(coeff_, dqcoeff_, params_.width * params_.height,
+                         &ssz) +
+            ssz;
+  }
+};
+
+TEST_P(Vp9BlockErrorSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Vp9BlockErrorSpeedTest,
+    ::testing::Values(RTCD_FUNC(BlockErrorParam, vp9_block_error, c, 4, 4),
+                      RTCD_FUNC(BlockErrorParam, vp9_block_error, c, 8, 8),
+                      RTCD_FUNC(BlockErrorParam, vp9_block_error, c, 16, 16),
+                      RTCD_FUNC(BlockErrorParam, vp9_block_error, c, 32, 32)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp9BlockErrorSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(BlockErrorParam, vp9_block_error, sse2, 4, 4),
+        RTCD_FUNC(BlockErrorParam, vp9_block_error, sse2, 8, 8),
+        RTCD_FUNC(BlockErrorParam, vp9_block_error, sse2, 16, 16),
+        RTCD_FUNC(BlockErrorParam, vp9_block_error, sse2, 32, 32)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Vp9BlockErrorSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(BlockErrorParam, vp9_block_error, avx2, 4, 4),
+        RTCD_FUNC(BlockErrorParam, vp9_block_error, avx2, 8, 8),
+        RTCD_FUNC(BlockErrorParam, vp9_block_error, avx2, 16, 16),
+        RTCD_FUNC(BlockErrorParam, vp9_block_error, avx2, 32, 32)));
+
+#endif  // HAVE_AVX2
+
+#endif  // CONFIG_VP9_ENCODER
+
+// -----------------------------------------------------------------------------
+// vp8
+
+#if CONFIG_VP8
+typedef void (*Vp8PredictFunc)(unsigned char *src_ptr, int src_pixels_per_line,
+                               int xoffset, int yoffset, unsigned char *dst_ptr,
+                               int dst_pitch);
+typedef RtcdFunc<Vp8PredictFunc> Vp8PredictParam;
+
+class Vp8PredictSpeedTest : public RtcdSpeedTest<Vp8PredictFunc> {
+ protected:
+  // Both offsets are fractional so that the two-pass path is timed.
+  void Run() override { params_.func(src(), kStride, 3, 5, dst(), kStride); }
+};
+
+TEST_P(Vp8PredictSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Vp8PredictSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict16x16, c, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x8, c, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x4, c, 8, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict4x4, c, 4, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict16x16, c, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x8, c, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x4, c, 8, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict4x4, c, 4, 4)));
+
+#if HAVE_MMX
+INSTANTIATE_TEST_SUITE_P(
+    MMX, Vp8PredictSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict4x4, mmx, 4, 4)));
+
+#endif  // HAVE_MMX
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp8PredictSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict16x16, sse2, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x8, sse2, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x4, sse2, 8, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict16x16, sse2, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x8, sse2, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x4, sse2, 8, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict4x4, sse2, 4, 4)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_SUITE_P(
+    SSSE3, Vp8PredictSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict16x16, ssse3, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x8, ssse3, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x4, ssse3, 8, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict4x4, ssse3, 4, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict16x16, ssse3, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x8, ssse3, 8, 8)));
+
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Vp8PredictSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict16x16, avx2, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x8, avx2, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x4, avx2, 8, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict16x16, avx2, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x8, avx2, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x4, avx2, 8, 4)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Vp8PredictSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict16x16, neon, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x8, neon, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict8x4, neon, 8, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_sixtap_predict4x4, neon, 4, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict16x16, neon, 16, 16),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x8, neon, 8, 8),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict8x4, neon, 8, 4),
+        RTCD_FUNC(Vp8PredictParam, vp8_bilinear_predict4x4, neon, 4, 4)));
+
+#endif  // HAVE_NEON
+
+typedef void (*Vp8IdctFunc)(short *input, unsigned char *pred_ptr,
+                            int pred_stride, unsigned char *dst_ptr,
+                            int dst_stride);
+typedef RtcdFunc<Vp8IdctFunc> Vp8IdctParam;
+
+class Vp8IdctSpeedTest : public RtcdSpeedTest<Vp8IdctFunc> {
+ protected:
+  void Run() override {
+    params_.func(input_, ref(), kStride, dst(), kStride);
+  }
+};
+
+TEST_P(Vp8IdctSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Vp8IdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(Vp8IdctParam, vp8_short_idct4x4llm, c, 4, 4)));
+
+#if HAVE_MMX
+INSTANTIATE_TEST_SUITE_P(
+    MMX, Vp8IdctSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8IdctParam, vp8_short_idct4x4llm, mmx, 4, 4)));
+
+#endif  // HAVE_MMX
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Vp8IdctSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8IdctParam, vp8_short_idct4x4llm, neon, 4, 4)));
+
+#endif  // HAVE_NEON
+
+typedef void (*Vp8DequantIdctFunc)(short *input, short *dq,
+                                   unsigned char *dest, int stride);
+typedef RtcdFunc<Vp8DequantIdctFunc> Vp8DequantIdctParam;
+
+class Vp8DequantIdctSpeedTest : public RtcdSpeedTest<Vp8DequantIdctFunc> {
+ protected:
+  // The dequantization factors follow the 4x4 block of coefficients. The
+  // coefficients are cleared by the first call; the cost of the transform
+  // does not depend on them.
+  void Run() override {
+    params_.func(input_, input_ + 16, dst(), kStride);
+  }
+};
+
+TEST_P(Vp8DequantIdctSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Vp8DequantIdctSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8DequantIdctParam, vp8_dequant_idct_add, c, 4, 4)));
+
+#if HAVE_MMX
+INSTANTIATE_TEST_SUITE_P(
+    MMX, Vp8DequantIdctSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8DequantIdctParam, vp8_dequant_idct_add, mmx, 4, 4)));
+
+#endif  // HAVE_MMX
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Vp8DequantIdctSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8DequantIdctParam, vp8_dequant_idct_add, neon, 4, 4)));
+
+#endif  // HAVE_NEON
+
+typedef void (*Vp8LoopFilterFunc)(unsigned char *y_ptr, unsigned char *u_ptr,
+                                  unsigned char *v_ptr, int y_stride,
+                                  int uv_stride, loop_filter_info *lfi);
+typedef RtcdFunc<Vp8LoopFilterFunc> Vp8LoopFilterParam;
+
+// Filters the edges of one macroblock, normalized to its 16x16 luma pixels.
+class Vp8LoopFilterSpeedTest : public RtcdSpeedTest<Vp8LoopFilterFunc> {
+ protected:
+  void SetUp() override {
+    RtcdSpeedTest<Vp8LoopFilterFunc>::SetUp();
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    for (int i = 0; i < kBufferSize; ++i) dst_buf_[i] = 128 + rnd(7) - 3;
+    lfi_.mblim = kBlimit;
+    lfi_.blim = kBlimit;
+    lfi_.lim = kLimit;
+    lfi_.hev_thr = kThresh;
+  }
+
+  void Run() override {
+    params_.func(dst(), dst() + 32, dst() + 48, kStride, kStride, &lfi_);
+  }
+
+  loop_filter_info lfi_;
+};
+
+TEST_P(Vp8LoopFilterSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Vp8LoopFilterSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_mbh, c, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_mbv, c, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_bh, c, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_bv, c, 16, 16)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp8LoopFilterSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_mbh, sse2, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_mbv, sse2, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_bh, sse2, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_bv, sse2, 16, 16)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Vp8LoopFilterSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_mbh, avx2, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_mbv, avx2, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_bh, avx2, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_bv, avx2, 16, 16)));
+
+#endif  // HAVE_AVX2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Vp8LoopFilterSpeedTest,
+    ::testing::Values(
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_mbh, neon, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_mbv, neon, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_bh, neon, 16, 16),
+        RTCD_FUNC(Vp8LoopFilterParam, vp8_loop_filter_bv, neon, 16, 16)));
+
+#endif  // HAVE_NEON
+
+#if CONFIG_VP8_ENCODER
+typedef void (*Vp8FdctFunc)(short *input, short *output, int pitch);
+typedef RtcdFunc<Vp8FdctFunc> Vp8FdctParam;
+
+class Vp8FdctSpeedTest : public RtcdSpeedTest<Vp8FdctFunc> {
+ protected:
+  // The pitch is in bytes.
+  void Run() override {
+    params_.func(input_, input_ + kMaxBlockSize * 8,
+                 kMaxBlockSize * sizeof(*input_));
+  }
+};
+
+TEST_P(Vp8FdctSpeedTest, Speed) { RunSpeedTest(); }
+
+INSTANTIATE_TEST_SUITE_P(
+    C, Vp8FdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(Vp8FdctParam, vp8_short_fdct4x4, c, 4, 4),
+                      RTCD_FUNC(Vp8FdctParam, vp8_short_fdct8x4, c, 8, 4)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp8FdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(Vp8FdctParam, vp8_short_fdct4x4, sse2, 4, 4),
+                      RTCD_FUNC(Vp8FdctParam, vp8_short_fdct8x4, sse2, 8, 4)));
+
+#endif  // HAVE_SSE2
+
+#if HAVE_NEON
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Vp8FdctSpeedTest,
+    ::testing::Values(RTCD_FUNC(Vp8FdctParam, vp8_short_fdct4x4, neon, 4, 4),
+                      RTCD_FUNC(Vp8FdctParam, vp8_short_fdct8x4, neon, 8, 4)));
+
+#endif  // HAVE_NEON
+
+#endif  // CONFIG_VP8_ENCODER
+#endif  // CONFIG_VP8
+}  // namespace
+
+#include "test/test_libvpx.cc"
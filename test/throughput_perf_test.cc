@@ -0,0 +1,466 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./vpx_config.h"
+#include "./vpx_version.h"
+#include "test/acm_random.h"
+#include "test/codec_factory.h"
+#include "test/decode_test_driver.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+#include "test/video_source.h"
+#include "vpx_ports/vpx_timer.h"
+
+/*
+ ThroughputPerfTest encodes a fixed set of synthetic and test-vector inputs
+ across rate control modes, speeds and threading configurations, then decodes
+ each stream with the same number of threads. Every run prints one JSON object
+ in the format of the other perf tests and records the same values as test
+ properties, so --gtest_output=json:<file> collects the whole sweep. Runs are
+ reproducible: the inputs, frame counts and encoder settings are fixed, and
+ the synthetic content is generated from a fixed seed.
+
+ Only the encode and decode calls are timed; reading or generating the source
+ frames is not. Like the other perf tests, no correctness checks are done.
+ */
+
+namespace {
+
+const double kUsecsInSec = 1000000.0;
+const int kFramerate = 30;
+// Target bits per pixel for the bitrate driven modes.
+const double kTargetBitsPerPixel = 0.08;
+const int kCqLevel = 32;
+
+struct ThroughputInput {
+  // A file name from the test data, or nullptr for synthetic content.
+  const char *file_name;
+  unsigned int width;
+  unsigned int height;
+  unsigned int frames;
+};
+
+const ThroughputInput kThroughputInputs[] = {
+  { nullptr, 640, 360, 30 },
+  { nullptr, 1280, 720, 30 },
+  { nullptr, 1920, 1080, 30 },
+  { "hantro_collage_w352h288.yuv", 352, 288, 30 },
+  { "niklas_1280_720_30.yuv", 1280, 720, 30 },
+};
+
+struct ThroughputPreset {
+  const char *name;
+  libvpx_test::TestMode mode;
+  vpx_rc_mode end_usage;
+  int speed;
+};
+
+const ThroughputPreset kThroughputPresets[] = {
+  { "rt_cbr", libvpx_test::kRealTime, VPX_CBR, 5 },
+  { "rt_cbr", libvpx_test::kRealTime, VPX_CBR, 7 },
+  { "rt_cbr", libvpx_test::kRealTime, VPX_CBR, 9 },
+  { "good_vbr", libvpx_test::kOnePassGood, VPX_VBR, 1 },
+  { "good_vbr", libvpx_test::kOnePassGood, VPX_VBR, 3 },
+  { "good_vbr", libvpx_test::kOnePassGood, VPX_VBR, 5 },
+  { "good_q", libvpx_test::kOnePassGood, VPX_Q, 3 },
+};
+
+struct ThroughputThreading {
+  unsigned int threads;
+  // log2 of the VP9 tile columns, or of the VP8 token partitions.
+  int log2_tiles;
+  int row_mt;
+};
+
+const ThroughputThreading kVP8Threading[] = {
+  { 1, 0, 0 },
+  { 2, 1, 0 },
+  { 4, 2, 0 },
+  { 8, 3, 0 },
+};
+
+const ThroughputThreading kVP9Threading[] = {
+  { 1, 0, 0 }, { 2, 1, 0 }, { 4, 2, 0 }, { 8, 3, 0 },
+  { 1, 0, 1 }, { 2, 1, 1 }, { 4, 2, 1 }, { 8, 3, 1 },
+};
+
+std::ostream &operator<<(std::ostream &os, const ThroughputInput &input) {
+  return os << (input.file_name ? input.file_name : "synthetic") << " "
+            << input.width << "x" << input.height;
+}
+
+std::ostream &operator<<(std::ostream &os, const ThroughputPreset &preset) {
+  return os << preset.name << " speed " << preset.speed;
+}
+
+std::ostream &operator<<(std::ostream &os, const ThroughputThreading &t) {
+  return os << t.threads << " threads, log2 tiles " << t.log2_tiles
+            << ", row_mt " << t.row_mt;
+}
+
+// Deterministic synthetic content: a diagonally panning texture over a
+// gradient, blocks moving at different velocities and a little noise, so that
+// motion search and both intra and inter coding have work to do.
+class SyntheticVideoSource : public libvpx_test::DummyVideoSource {
+ public:
+  SyntheticVideoSource(unsigned int width, unsigned int height,
+                       unsigned int frames)
+      : rnd_(libvpx_test::ACMRandom::DeterministicSeed()) {
+    SetSize(width, height);
+    set_limit(frames);
+  }
+
+ protected:
+  virtual void Begin() {
+    frame_ = 0;
+    rnd_.Reset(libvpx_test::ACMRandom::DeterministicSeed());
+    FillFrame();
+  }
+
+  virtual void FillFrame() {
+    if (img_ == nullptr) return;
+    const int t = static_cast<int>(frame_);
+    const int w = static_cast<int>(img_->d_w);
+    const int h = static_cast<int>(img_->d_h);
+    uint8_t *const y_plane = img_->planes[VPX_PLANE_Y];
+    const int y_stride = img_->stride[VPX_PLANE_Y];
+    for (int r = 0; r < h; ++r) {
+      for (int c = 0; c < w; ++c) {
+        const int texture = ((c + 2 * t) ^ (r + t)) & 0x1f;
+        const int gradient = (c + r) * 160 / (w + h);
+        y_plane[r * y_stride + c] =
+            static_cast<uint8_t>(48 + gradient + texture + rnd_(4));
+      }
+    }
+    for (int i = 0; i < 4; ++i) {
+      const int size = 64;
+      const int x = ((i + 1) * w / 5 + t * (3 - i) * 2) % (w - size);
+      const int y = ((i + 1) * h / 5 + t * (i - 1)) % (h - size);
+      const int x0 = x < 0 ? x + w - size : x;
+      const int y0 = y < 0 ? y + h - size : y;
+      for (int r = 0; r < size; ++r) {
+        for (int c = 0; c < size; ++c) {
+          const int checker = ((r >> 3) ^ (c >> 3)) & 1;
+          y_plane[(y0 + r) * y_stride + x0 + c] =
+              static_cast<uint8_t>(checker ? 200 - 20 * i : 40 + 20 * i);
+        }
+      }
+    }
+    const int uv_w = (w + 1) >> 1;
+    const int uv_h = (h + 1) >> 1;
+    for (int plane = VPX_PLANE_U; plane <= VPX_PLANE_V; ++plane) {
+      uint8_t *const buf = img_->planes[plane];
+      const int stride = img_->stride[plane];
+      for (int r = 0; r < uv_h; ++r) {
+        for (int c = 0; c < uv_w; ++c) {
+          const int pos = plane == VPX_PLANE_U ? c + t : r + t;
+          buf[r * stride + c] = static_cast<uint8_t>(96 + (pos & 0x3f));
+        }
+      }
+    }
+  }
+
+ private:
+  libvpx_test::ACMRandom rnd_;
+};
+
+// Resets the peak resident set size of the process, so that the next
+// PeakRssKb() covers only what follows. Returns false where this is not
+// supported.
+bool ResetPeakRss() {
+#if defined(__linux__)
+  FILE *const file = fopen("/proc/self/clear_refs", "w");
+  if (file == nullptr) return false;
+  const bool ok = fputs("5", file) >= 0;
+  return fclose(file) == 0 && ok;
+#else
+  return false;
+#endif
+}
+
+// Returns the peak resident set size of the process in KiB, or -1 where it is
+// not available.
+int64_t PeakRssKb() {
+#if defined(__linux__)
+  FILE *const file = fopen("/proc/self/status", "r");
+  if (file != nullptr) {
+    char line[128];
+    long long peak = -1;  // NOLINT
+    while (fgets(line, sizeof(line), file) != nullptr) {
+      if (sscanf(line, "VmHWM: %lld kB", &peak) == 1) break;
+    }
+    fclose(file);
+    if (peak >= 0) return peak;
+  }
+#endif
+#if !defined(_WIN32)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return -1;
+}
+
+// Wall and process CPU time of a sequence of timed sections.
+class StageTimer {
+ public:
+  StageTimer() : wall_usec_(0), cpu_usec_(0), cpu_start_(0) {}
+
+  void Start() {
+    cpu_start_ = vpx_process_cpu_time_usec();
+    vpx_usec_timer_start(&timer_);
+  }
+
+  void Stop() {
+    vpx_usec_timer_mark(&timer_);
+    wall_usec_ += vpx_usec_timer_elapsed(&timer_);
+    cpu_usec_ += vpx_process_cpu_time_usec() - cpu_start_;
+  }
+
+  double wall_secs() const { return wall_usec_ / kUsecsInSec; }
+  double cpu_secs() const { return cpu_usec_ / kUsecsInSec; }
+
+ private:
+  vpx_usec_timer timer_;
+  int64_t wall_usec_;
+  int64_t cpu_usec_;
+  int64_t cpu_start_;
+};
+
+class ThroughputPerfTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith3Params<
+          ThroughputInput, ThroughputPreset, ThroughputThreading> {
+ protected:
+  ThroughputPerfTest()
+      : EncoderTest(GET_PARAM(0)), input_(GET_PARAM(1)),
+        preset_(GET_PARAM(2)), threading_(GET_PARAM(3)), psnr_sum_(0.0),
+        psnr_count_(0), bytes_(0) {}
+
+  virtual ~ThroughputPerfTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(preset_.mode);
+
+    const vpx_rational timebase = { 1, kFramerate };
+    cfg_.g_timebase = timebase;
+    cfg_.g_w = input_.width;
+    cfg_.g_h = input_.height;
+    cfg_.g_threads = threading_.threads;
+    cfg_.g_lag_in_frames = preset_.mode == libvpx_test::kRealTime ? 0 : 25;
+    cfg_.g_error_resilient = 0;
+    cfg_.rc_end_usage = preset_.end_usage;
+    cfg_.rc_target_bitrate = static_cast<unsigned int>(
+        input_.width * input_.height * kFramerate * kTargetBitsPerPixel /
+        1000);
+    cfg_.rc_min_quantizer = preset_.end_usage == VPX_Q ? kCqLevel : 2;
+    cfg_.rc_max_quantizer = preset_.end_usage == VPX_Q ? kCqLevel : 56;
+    cfg_.rc_dropframe_thresh = 0;
+    cfg_.rc_resize_allowed = 0;
+    cfg_.rc_buf_sz = 1000;
+    cfg_.rc_buf_initial_sz = 500;
+    cfg_.rc_buf_optimal_sz = 600;
+    init_flags_ = VPX_CODEC_USE_PSNR;
+  }
+
+  bool IsVP9() const {
+#if CONFIG_VP9
+    return GET_PARAM(0) == &libvpx_test::kVP9;
+#else
+    return false;
+#endif
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, preset_.speed);
+      if (preset_.end_usage == VPX_Q) {
+        encoder->Control(VP8E_SET_CQ_LEVEL, kCqLevel);
+      }
+      if (IsVP9()) {
+        encoder->Control(VP9E_SET_TILE_COLUMNS, threading_.log2_tiles);
+        encoder->Control(VP9E_SET_ROW_MT, threading_.row_mt);
+      } else {
+        encoder->Control(VP8E_SET_TOKEN_PARTITIONS, threading_.log2_tiles);
+      }
+    }
+    encode_timer_.Start();
+  }
+
+  virtual void PostEncodeFrameHook(::libvpx_test::Encoder * /*encoder*/) {
+    encode_timer_.Stop();
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    const uint8_t *const buf = static_cast<const uint8_t *>(pkt->data.frame.buf);
+    frames_.push_back(std::vector<uint8_t>(buf, buf + pkt->data.frame.sz));
+    bytes_ += pkt->data.frame.sz;
+  }
+
+  virtual void PSNRPktHook(const vpx_codec_cx_pkt_t *pkt) {
+    psnr_sum_ += pkt->data.psnr.psnr[0];
+    ++psnr_count_;
+  }
+
+  // The streams are decoded and timed separately, after the encode.
+  virtual bool DoDecode() const { return false; }
+
+  // Decodes the stored frames. Returns false if the decoder is not
+  // available in this configuration.
+  bool DecodeFrames() {
+    vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+    cfg.threads = threading_.threads;
+    cfg.w = input_.width;
+    cfg.h = input_.height;
+    std::unique_ptr<libvpx_test::Decoder> decoder(
+        GET_PARAM(0)->CreateDecoder(cfg, 0));
+    if (decoder == nullptr) return false;
+#if CONFIG_VP9_DECODER
+    if (IsVP9()) decoder->Control(VP9D_SET_ROW_MT, threading_.row_mt);
+#endif
+    for (size_t i = 0; i < frames_.size(); ++i) {
+      decode_timer_.Start();
+      const vpx_codec_err_t res =
+          decoder->DecodeFrame(frames_[i].data(), frames_[i].size());
+      libvpx_test::DxDataIterator dec_iter = decoder->GetDxData();
+      while (dec_iter.Next() != nullptr) {
+      }
+      decode_timer_.Stop();
+      EXPECT_EQ(VPX_CODEC_OK, res) << decoder->DecodeError();
+      if (res != VPX_CODEC_OK) break;
+    }
+    return true;
+  }
+
+  void RecordResult(const char *key, double value) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%f", value);
+    RecordProperty(key, buf);
+  }
+
+  const ThroughputInput input_;
+  const ThroughputPreset preset_;
+  const ThroughputThreading threading_;
+  StageTimer encode_timer_;
+  StageTimer decode_timer_;
+  std::vector<std::vector<uint8_t> > frames_;
+  double psnr_sum_;
+  int psnr_count_;
+  size_t bytes_;
+};
+
+TEST_P(ThroughputPerfTest, PerfTest) {
+  std::unique_ptr<libvpx_test::VideoSource> video;
+  if (input_.file_name != nullptr) {
+    video.reset(new libvpx_test::I420VideoSource(
+        input_.file_name, input_.width, input_.height, kFramerate, 1, 0,
+        input_.frames));
+  } else {
+    video.reset(new SyntheticVideoSource(input_.width, input_.height,
+                                         input_.frames));
+  }
+
+  const bool encode_rss_reset = ResetPeakRss();
+  ASSERT_NO_FATAL_FAILURE(RunLoop(video.get()));
+  const int64_t encode_peak_rss = encode_rss_reset ? PeakRssKb() : -1;
+
+  const bool decode_rss_reset = ResetPeakRss();
+  const bool decoded = DecodeFrames();
+  const int64_t decode_peak_rss =
+      decoded && decode_rss_reset ? PeakRssKb() : -1;
+
+  const unsigned int frames = input_.frames;
+  const double encode_fps = frames / encode_timer_.wall_secs();
+  const double decode_fps =
+      decoded ? frames_.size() / decode_timer_.wall_secs() : 0.0;
+  const double bitrate_kbps = bytes_ * 8.0 * kFramerate / frames / 1000.0;
+  const double avg_psnr = psnr_count_ > 0 ? psnr_sum_ / psnr_count_ : 0.0;
+  const char *const codec = IsVP9() ? "vp9" : "vp8";
+  const char *const video_name =
+      input_.file_name != nullptr ? input_.file_name : "synthetic";
+
+  printf("{\n");
+  printf("\t\"type\" : \"throughput_perf_test\",\n");
+  printf("\t\"version\" : \"%s\",\n", VERSION_STRING_NOSP);
+  printf("\t\"codec\" : \"%s\",\n", codec);
+  printf("\t\"videoName\" : \"%s\",\n", video_name);
+  printf("\t\"width\" : %u,\n", input_.width);
+  printf("\t\"height\" : %u,\n", input_.height);
+  printf("\t\"totalFrames\" : %u,\n", frames);
+  printf("\t\"preset\" : \"%s\",\n", preset_.name);
+  printf("\t\"speed\" : %d,\n", preset_.speed);
+  printf("\t\"threads\" : %u,\n", threading_.threads);
+  printf("\t\"log2Tiles\" : %d,\n", threading_.log2_tiles);
+  printf("\t\"rowMt\" : %d,\n", threading_.row_mt);
+  printf("\t\"encodeTimeSecs\" : %f,\n", encode_timer_.wall_secs());
+  printf("\t\"encodeCpuSecs\" : %f,\n", encode_timer_.cpu_secs());
+  printf("\t\"encodeFramesPerSecond\" : %f,\n", encode_fps);
+  printf("\t\"encodePeakRssKb\" : %lld,\n",
+         static_cast<long long>(encode_peak_rss));  // NOLINT
+  printf("\t\"bitrateKbps\" : %f,\n", bitrate_kbps);
+  printf("\t\"avgPsnr\" : %f,\n", avg_psnr);
+  printf("\t\"decodeTimeSecs\" : %f,\n", decode_timer_.wall_secs());
+  printf("\t\"decodeCpuSecs\" : %f,\n", decode_timer_.cpu_secs());
+  printf("\t\"decodeFramesPerSecond\" : %f,\n", decode_fps);
+  printf("\t\"decodePeakRssKb\" : %lld\n",
+         static_cast<long long>(decode_peak_rss));  // NOLINT
+  printf("}\n");
+
+  RecordProperty("codec", codec);
+  RecordProperty("videoName", video_name);
+  RecordProperty("width", input_.width);
+  RecordProperty("height", input_.height);
+  RecordProperty("totalFrames", frames);
+  RecordProperty("preset", preset_.name);
+  RecordProperty("speed", preset_.speed);
+  RecordProperty("threads", threading_.threads);
+  RecordProperty("log2Tiles", threading_.log2_tiles);
+  RecordProperty("rowMt", threading_.row_mt);
+  RecordResult("encodeTimeSecs", encode_timer_.wall_secs());
+  RecordResult("encodeCpuSecs", encode_timer_.cpu_secs());
+  RecordResult("encodeFramesPerSecond", encode_fps);
+  RecordProperty("encodePeakRssKb", static_cast<int>(encode_peak_rss));
+  RecordResult("bitrateKbps", bitrate_kbps);
+  RecordResult("avgPsnr", avg_psnr);
+  RecordResult("decodeTimeSecs", decode_timer_.wall_secs());
+  RecordResult("decodeCpuSecs", decode_timer_.cpu_secs());
+  RecordResult("decodeFramesPerSecond", decode_fps);
+  RecordProperty("decodePeakRssKb", static_cast<int>(decode_peak_rss));
+}
+
+VP8_INSTANTIATE_TEST_SUITE(ThroughputPerfTest,
+                           ::testing::ValuesIn(kThroughputInputs),
+                           ::testing::ValuesIn(kThroughputPresets),
+                           ::testing::ValuesIn(kVP8Threading));
+
+VP9_INSTANTIATE_TEST_SUITE(ThroughputPerfTest,
+                           ::testing::ValuesIn(kThroughputInputs),
+                           ::testing::ValuesIn(kThroughputPresets),
+                           ::testing::ValuesIn(kVP9Threading));
+}  // namespace
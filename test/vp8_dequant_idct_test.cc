@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstring>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "./vp8_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "vp8/common/entropy.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+typedef void (*DequantIdctAddYBlockFunc)(short *q, short *dq,
+                                         unsigned char *dst, int stride,
+                                         char *eobs);
+typedef void (*DequantIdctAddUvBlockFunc)(short *q, short *dq,
+                                          unsigned char *dst_u,
+                                          unsigned char *dst_v, int stride,
+                                          char *eobs);
+
+const int kStride = 32;
+const int kNumIterations = 2000;
+
+// Fills the coefficients of each 4x4 block up to a random end of block in
+// zigzag order, as the detokenizer leaves them. Blocks with an eob of 0 or 1
+// only carry a DC. The dequantized values stay within the range of the
+// forward transform so that no implementation has to saturate.
+void FillBlocks(ACMRandom *rnd, short *q, short *dq, char *eobs,
+                int num_blocks) {
+  for (int i = 0; i < 16; ++i) dq[i] = 4 + rnd->RandRange(154);
+  memset(q, 0, sizeof(*q) * 16 * num_blocks);
+  for (int b = 0; b < num_blocks; ++b) {
+    // Favor the DC only paths, which are taken per group of blocks.
+    const int eob = (rnd->Rand8() & 1) ? rnd->RandRange(2) : rnd->RandRange(17);
+    eobs[b] = static_cast<char>(eob);
+    for (int i = 0; i < eob; ++i) {
+      const int pos = vp8_default_zig_zag1d[i];
+      const int max_coeff = 2048 / dq[pos];
+      q[b * 16 + pos] =
+          static_cast<short>(rnd->RandRange(2 * max_coeff + 1) - max_coeff);
+    }
+  }
+}
+
+void FillPixels(ACMRandom *rnd, uint8_t *buf, int size) {
+  for (int i = 0; i < size; ++i) buf[i] = rnd->Rand8();
+}
+
+class Vp8DequantIdctAddYBlockTest
+    : public ::testing::TestWithParam<DequantIdctAddYBlockFunc> {
+ public:
+  virtual ~Vp8DequantIdctAddYBlockTest() {}
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Vp8DequantIdctAddYBlockTest);
+
+TEST_P(Vp8DequantIdctAddYBlockTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, short, q[16 * 16]);
+  DECLARE_ALIGNED(16, short, ref_q[16 * 16]);
+  DECLARE_ALIGNED(16, short, dq[16]);
+  DECLARE_ALIGNED(16, uint8_t, dst[kStride * 16]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst[kStride * 16]);
+  char eobs[16];
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    FillBlocks(&rnd, q, dq, eobs, 16);
+    FillPixels(&rnd, dst, sizeof(dst));
+    memcpy(ref_q, q, sizeof(q));
+    memcpy(ref_dst, dst, sizeof(dst));
+
+    vp8_dequant_idct_add_y_block_c(ref_q, dq, ref_dst, kStride, eobs);
+    ASM_REGISTER_STATE_CHECK(GetParam()(q, dq, dst, kStride, eobs));
+
+    for (int j = 0; j < kStride * 16; ++j) {
+      ASSERT_EQ(ref_dst[j], dst[j]) << "iteration " << i << " pixel " << j;
+    }
+    // The coefficients are cleared for the next macroblock.
+    for (int j = 0; j < 16 * 16; ++j) {
+      ASSERT_EQ(0, q[j]) << "iteration " << i << " coefficient " << j;
+    }
+  }
+}
+
+class Vp8DequantIdctAddUvBlockTest
+    : public ::testing::TestWithParam<DequantIdctAddUvBlockFunc> {
+ public:
+  virtual ~Vp8DequantIdctAddUvBlockTest() {}
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Vp8DequantIdctAddUvBlockTest);
+
+TEST_P(Vp8DequantIdctAddUvBlockTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, short, q[8 * 16]);
+  DECLARE_ALIGNED(16, short, ref_q[8 * 16]);
+  DECLARE_ALIGNED(16, short, dq[16]);
+  DECLARE_ALIGNED(16, uint8_t, dst_u[kStride * 8]);
+  DECLARE_ALIGNED(16, uint8_t, dst_v[kStride * 8]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst_u[kStride * 8]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst_v[kStride * 8]);
+  char eobs[8];
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    FillBlocks(&rnd, q, dq, eobs, 8);
+    FillPixels(&rnd, dst_u, sizeof(dst_u));
+    FillPixels(&rnd, dst_v, sizeof(dst_v));
+    memcpy(ref_q, q, sizeof(q));
+    memcpy(ref_dst_u, dst_u, sizeof(dst_u));
+    memcpy(ref_dst_v, dst_v, sizeof(dst_v));
+
+    vp8_dequant_idct_add_uv_block_c(ref_q, dq, ref_dst_u, ref_dst_v, kStride,
+                                    eobs);
+    ASM_REGISTER_STATE_CHECK(GetParam()(q, dq, dst_u, dst_v, kStride, eobs));
+
+    for (int j = 0; j < kStride * 8; ++j) {
+      ASSERT_EQ(ref_dst_u[j], dst_u[j]) << "iteration " << i << " pixel " << j;
+      ASSERT_EQ(ref_dst_v[j], dst_v[j]) << "iteration " << i << " pixel " << j;
+    }
+    for (int j = 0; j < 8 * 16; ++j) {
+      ASSERT_EQ(0, q[j]) << "iteration " << i << " coefficient " << j;
+    }
+  }
+}
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp8DequantIdctAddYBlockTest,
+    ::testing::Values(&vp8_dequant_idct_add_y_block_sse2));
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp8DequantIdctAddUvBlockTest,
+    ::testing::Values(&vp8_dequant_idct_add_uv_block_sse2));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Vp8DequantIdctAddYBlockTest,
+    ::testing::Values(&vp8_dequant_idct_add_y_block_avx2));
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Vp8DequantIdctAddUvBlockTest,
+    ::testing::Values(&vp8_dequant_idct_add_uv_block_avx2));
+#endif  // HAVE_AVX2
+}  // namespace
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstring>
+#include <tuple>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "./vp8_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vp8/common/loopfilter.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+// Filters the edges of one macroblock: the luma and both chroma planes.
+typedef void (*MbLoopFilterFunc)(unsigned char *y_ptr, unsigned char *u_ptr,
+                                 unsigned char *v_ptr, int y_stride,
+                                 int uv_stride, loop_filter_info *lfi);
+typedef std::tuple<MbLoopFilterFunc, MbLoopFilterFunc> MbLoopFilterParam;
+
+// The macroblock sits in the middle of each plane so that the filters can
+// read and write 4 pixels on the other side of its top and left edges. The
+// offsets keep the macroblock aligned as it is in a frame buffer.
+const int kYStride = 32;
+const int kYSize = kYStride * 24;
+const int kYOffset = 4 * kYStride + 16;
+const int kUvStride = 16;
+const int kUvSize = kUvStride * 16;
+const int kUvOffset = 4 * kUvStride + 8;
+const int kNumIterations = 2000;
+
+// Fills a plane with a random walk whose steps stay around the filter limits,
+// so that each edge is sometimes filtered and sometimes left alone.
+void FillPlane(ACMRandom *rnd, uint8_t *buf, int stride, int rows, int step) {
+  for (int r = 0; r < rows; ++r) {
+    for (int c = 0; c < stride; ++c) {
+      int val;
+      if (r == 0 && c == 0) {
+        val = rnd->Rand8();
+      } else if (r == 0) {
+        val = buf[c - 1];
+      } else if (c == 0) {
+        val = buf[(r - 1) * stride];
+      } else {
+        val = (buf[(r - 1) * stride + c] + buf[r * stride + c - 1] + 1) >> 1;
+      }
+      val += rnd->RandRange(2 * step + 1) - step;
+      buf[r * stride + c] = static_cast<uint8_t>(clamp(val, 0, 255));
+    }
+  }
+}
+
+class Vp8MbLoopFilterTest : public ::testing::TestWithParam<MbLoopFilterParam> {
+ public:
+  virtual ~Vp8MbLoopFilterTest() {}
+  virtual void SetUp() {
+    loopfilter_op_ = GET_PARAM(0);
+    ref_loopfilter_op_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  MbLoopFilterFunc loopfilter_op_;
+  MbLoopFilterFunc ref_loopfilter_op_;
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Vp8MbLoopFilterTest);
+
+TEST_P(Vp8MbLoopFilterTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, mblim[SIMD_WIDTH]);
+  DECLARE_ALIGNED(16, uint8_t, blim[SIMD_WIDTH]);
+  DECLARE_ALIGNED(16, uint8_t, lim[SIMD_WIDTH]);
+  DECLARE_ALIGNED(16, uint8_t, hev_thr[SIMD_WIDTH]);
+  DECLARE_ALIGNED(16, uint8_t, y[kYSize]);
+  DECLARE_ALIGNED(16, uint8_t, u[kUvSize]);
+  DECLARE_ALIGNED(16, uint8_t, v[kUvSize]);
+  DECLARE_ALIGNED(16, uint8_t, ref_y[kYSize]);
+  DECLARE_ALIGNED(16, uint8_t, ref_u[kUvSize]);
+  DECLARE_ALIGNED(16, uint8_t, ref_v[kUvSize]);
+  loop_filter_info lfi;
+  lfi.mblim = mblim;
+  lfi.blim = blim;
+  lfi.lim = lim;
+  lfi.hev_thr = hev_thr;
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    // Derive the limits as vp8_loop_filter_update_sharpness() does.
+    const int filter_level = 1 + rnd.RandRange(MAX_LOOP_FILTER);
+    const int sharpness = rnd.RandRange(8);
+    int inside_limit = filter_level >> ((sharpness > 0) + (sharpness > 4));
+    if (sharpness > 0 && inside_limit > 9 - sharpness) {
+      inside_limit = 9 - sharpness;
+    }
+    if (inside_limit < 1) inside_limit = 1;
+    memset(lim, inside_limit, SIMD_WIDTH);
+    memset(blim, 2 * filter_level + inside_limit, SIMD_WIDTH);
+    memset(mblim, 2 * (filter_level + 2) + inside_limit, SIMD_WIDTH);
+    memset(hev_thr, rnd.RandRange(4), SIMD_WIDTH);
+
+    const int step = 1 + rnd.RandRange(2 * inside_limit + 1);
+    FillPlane(&rnd, y, kYStride, kYSize / kYStride, step);
+    FillPlane(&rnd, u, kUvStride, kUvSize / kUvStride, step);
+    FillPlane(&rnd, v, kUvStride, kUvSize / kUvStride, step);
+    memcpy(ref_y, y, sizeof(y));
+    memcpy(ref_u, u, sizeof(u));
+    memcpy(ref_v, v, sizeof(v));
+
+    ref_loopfilter_op_(ref_y + kYOffset, ref_u + kUvOffset, ref_v + kUvOffset,
+                       kYStride, kUvStride, &lfi);
+    ASM_REGISTER_STATE_CHECK(loopfilter_op_(y + kYOffset, u + kUvOffset,
+                                            v + kUvOffset, kYStride,
+                                            kUvStride, &lfi));
+
+    for (int j = 0; j < kYSize; ++j) {
+      ASSERT_EQ(ref_y[j], y[j]) << "iteration " << i << " y pixel " << j;
+    }
+    for (int j = 0; j < kUvSize; ++j) {
+      ASSERT_EQ(ref_u[j], u[j]) << "iteration " << i << " u pixel " << j;
+      ASSERT_EQ(ref_v[j], v[j]) << "iteration " << i << " v pixel " << j;
+    }
+  }
+}
+
+using std::make_tuple;
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Vp8MbLoopFilterTest,
+    ::testing::Values(
+        make_tuple(&vp8_loop_filter_mbv_sse2, &vp8_loop_filter_mbv_c),
+        make_tuple(&vp8_loop_filter_bv_sse2, &vp8_loop_filter_bv_c),
+        make_tuple(&vp8_loop_filter_mbh_sse2, &vp8_loop_filter_mbh_c),
+        make_tuple(&vp8_loop_filter_bh_sse2, &vp8_loop_filter_bh_c)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Vp8MbLoopFilterTest,
+    ::testing::Values(
+        make_tuple(&vp8_loop_filter_mbv_avx2, &vp8_loop_filter_mbv_c),
+        make_tuple(&vp8_loop_filter_bv_avx2, &vp8_loop_filter_bv_c),
+        make_tuple(&vp8_loop_filter_mbh_avx2, &vp8_loop_filter_mbh_c),
+        make_tuple(&vp8_loop_filter_bh_avx2, &vp8_loop_filter_bh_c)));
+#endif  // HAVE_AVX2
+}  // namespace
@@ -13,8 +13,10 @@
 #include "third_party/googletest/src/include/gtest/gtest.h"
 #include "test/codec_factory.h"
 #include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
 #include "test/md5_helper.h"
 #include "test/util.h"
+#include "test/video_source.h"
 #include "test/y4m_video_source.h"
 #include "vp9/encoder/vp9_firstpass.h"
 
@@ -425,4 +427,123 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Range(0, 3),    // tile_columns
         ::testing::Range(2, 5)));  // threads
 
+// With row_mt and more than one thread the TPL model of each ARF group is
+// built by all the workers. Like the rest of the row_mt encode, the result
+// must not depend on how many workers there are.
+class VPxEncoderTplThreadTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  VPxEncoderTplThreadTest()
+      : EncoderTest(GET_PARAM(0)), set_cpu_used_(GET_PARAM(1)) {}
+  virtual ~VPxEncoderTplThreadTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+    cfg_.g_lag_in_frames = 25;
+    cfg_.rc_end_usage = VPX_VBR;
+    cfg_.rc_target_bitrate = 1000;
+  }
+
+  virtual void BeginPassHook(unsigned int /*pass*/) { md5_.clear(); }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, set_cpu_used_);
+      encoder->Control(VP9E_SET_ROW_MT, 1);
+      encoder->Control(VP9E_SET_TPL, 1);
+      encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+    }
+  }
+
+  // Hashes every packet, including the hidden alt-ref frames, since the test
+  // driver only decodes one frame per input frame.
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    ::libvpx_test::MD5 md5_res;
+    md5_res.Add(static_cast<const uint8_t *>(pkt->data.frame.buf),
+                pkt->data.frame.sz);
+    md5_.push_back(md5_res.Get());
+  }
+
+  int set_cpu_used_;
+  std::vector<std::string> md5_;
+};
+
+TEST_P(VPxEncoderTplThreadTest, TplModelIsThreadCountInvariant) {
+  ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, 30);
+
+  // A single thread takes the non row_mt paths, so compare against two.
+  cfg_.g_threads = 2;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  const std::vector<std::string> two_thr_md5 = md5_;
+  ASSERT_FALSE(two_thr_md5.empty());
+
+  for (int threads = 3; threads <= 4; ++threads) {
+    cfg_.g_threads = threads;
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+    EXPECT_EQ(two_thr_md5, md5_) << "threads: " << threads;
+  }
+}
+
+VP9_INSTANTIATE_TEST_SUITE(VPxEncoderTplThreadTest,
+                           ::testing::Values(1, 4));  // cpu_used
+
+#if CONFIG_MULTITHREAD
+// Encodes with more workers than there are threads in an application owned
+// pool. The test driver checks the decoded frames against the encoder's
+// reconstruction.
+class VPxEncoderThreadPoolTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  VPxEncoderThreadPoolTest()
+      : EncoderTest(GET_PARAM(0)), row_mt_(GET_PARAM(1)), pool_(nullptr) {}
+  virtual ~VPxEncoderThreadPoolTest() { vpx_codec_thread_pool_destroy(pool_); }
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+    cfg_.g_threads = 4;
+    cfg_.g_lag_in_frames = 8;
+    cfg_.rc_target_bitrate = 1000;
+    pool_ = vpx_codec_thread_pool_create(2);
+    ASSERT_NE(pool_, nullptr);
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP9E_SET_THREAD_POOL, pool_);
+      encoder->Control(VP9E_SET_TILE_COLUMNS, 2);
+      encoder->Control(VP9E_SET_ROW_MT, row_mt_);
+      encoder->Control(VP8E_SET_CPUUSED, 4);
+      encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+      encoder->Control(VP8E_SET_ARNR_MAXFRAMES, 7);
+    }
+  }
+
+  int row_mt_;
+  vpx_codec_thread_pool_t *pool_;
+};
+
+TEST_P(VPxEncoderThreadPoolTest, EncodeOnSharedPool) {
+  ::libvpx_test::RandomVideoSource video;
+  video.SetSize(640, 480);
+  video.set_limit(10);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+}
+
+TEST(VPxCodecThreadPoolTest, CreateInvalid) {
+  EXPECT_EQ(vpx_codec_thread_pool_create(0), nullptr);
+  EXPECT_EQ(vpx_codec_thread_pool_create(-1), nullptr);
+  vpx_codec_thread_pool_destroy(nullptr);
+}
+
+VP9_INSTANTIATE_TEST_SUITE(VPxEncoderThreadPoolTest,
+                           ::testing::Values(0, 1));  // row_mt
+#endif  // CONFIG_MULTITHREAD
+
 }  // namespace
@@ -228,9 +228,42 @@ INSTANTIATE_TEST_SUITE_P(
                       IntraPredParam(&vpx_d207_predictor_16x16_ssse3,
                                      &vpx_d207_predictor_16x16_c, 16, 8),
                       IntraPredParam(&vpx_d207_predictor_32x32_ssse3,
-                                     &vpx_d207_predictor_32x32_c, 32, 8)));
+                                     &vpx_d207_predictor_32x32_c, 32, 8),
+                      IntraPredParam(&vpx_d117_predictor_4x4_ssse3,
+                                     &vpx_d117_predictor_4x4_c, 4, 8),
+                      IntraPredParam(&vpx_d117_predictor_8x8_ssse3,
+                                     &vpx_d117_predictor_8x8_c, 8, 8),
+                      IntraPredParam(&vpx_d117_predictor_16x16_ssse3,
+                                     &vpx_d117_predictor_16x16_c, 16, 8),
+                      IntraPredParam(&vpx_d117_predictor_32x32_ssse3,
+                                     &vpx_d117_predictor_32x32_c, 32, 8),
+                      IntraPredParam(&vpx_d135_predictor_4x4_ssse3,
+                                     &vpx_d135_predictor_4x4_c, 4, 8),
+                      IntraPredParam(&vpx_d135_predictor_8x8_ssse3,
+                                     &vpx_d135_predictor_8x8_c, 8, 8),
+                      IntraPredParam(&vpx_d135_predictor_16x16_ssse3,
+                                     &vpx_d135_predictor_16x16_c, 16, 8),
+                      IntraPredParam(&vpx_d135_predictor_32x32_ssse3,
+                                     &vpx_d135_predictor_32x32_c, 32, 8)));
 #endif  // HAVE_SSSE3
 
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, VP9IntraPredTest,
+    ::testing::Values(IntraPredParam(&vpx_d45_predictor_32x32_avx2,
+                                     &vpx_d45_predictor_32x32_c, 32, 8),
+                      IntraPredParam(&vpx_d63_predictor_32x32_avx2,
+                                     &vpx_d63_predictor_32x32_c, 32, 8),
+                      IntraPredParam(&vpx_d117_predictor_32x32_avx2,
+                                     &vpx_d117_predictor_32x32_c, 32, 8),
+                      IntraPredParam(&vpx_d135_predictor_32x32_avx2,
+                                     &vpx_d135_predictor_32x32_c, 32, 8),
+                      IntraPredParam(&vpx_d153_predictor_32x32_avx2,
+                                     &vpx_d153_predictor_32x32_c, 32, 8),
+                      IntraPredParam(&vpx_d207_predictor_32x32_avx2,
+                                     &vpx_d207_predictor_32x32_c, 32, 8)));
+#endif  // HAVE_AVX2
+
 #if HAVE_NEON
 INSTANTIATE_TEST_SUITE_P(
     NEON, VP9IntraPredTest,
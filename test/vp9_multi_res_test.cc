@@ -0,0 +1,236 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/acm_random.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+const int kNumResolutions = 3;
+const int kWidth = 320;
+const int kHeight = 192;
+const int kNumFrames = 20;
+// Reference buffer slot of the golden frame in a single layer VP9 stream.
+const int kGoldenSlot = 1;
+
+class MultiResTest : public ::testing::Test {
+ protected:
+  MultiResTest() : initialized_(false) {
+    memset(imgs_, 0, sizeof(imgs_));
+    memset(ctx_, 0, sizeof(ctx_));
+  }
+
+  virtual void SetUp() {
+    for (int i = 0; i < kNumResolutions; ++i) {
+      ASSERT_EQ(VPX_CODEC_OK,
+                vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg_[i], 0));
+      cfg_[i].g_w = kWidth >> i;
+      cfg_[i].g_h = kHeight >> i;
+      cfg_[i].g_lag_in_frames = 0;
+      cfg_[i].g_error_resilient = 0;
+      cfg_[i].rc_end_usage = VPX_CBR;
+      cfg_[i].rc_target_bitrate = 600 >> (2 * i);
+      cfg_[i].kf_max_dist = 1000;
+      dsf_[i].num = 2;
+      dsf_[i].den = 1;
+      ASSERT_TRUE(vpx_img_alloc(&imgs_[i], VPX_IMG_FMT_I420, kWidth >> i,
+                                kHeight >> i, 32) != NULL);
+    }
+    dsf_[kNumResolutions - 1].num = 1;
+  }
+
+  virtual void TearDown() {
+    if (initialized_) {
+      for (int i = 0; i < kNumResolutions; ++i) {
+        EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&ctx_[i]));
+      }
+    }
+    for (int i = 0; i < kNumResolutions; ++i) vpx_img_free(&imgs_[i]);
+  }
+
+  void Init() {
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_init_multi(ctx_, vpx_codec_vp9_cx(), cfg_,
+                                       kNumResolutions, 0, dsf_));
+    initialized_ = true;
+    for (int i = 0; i < kNumResolutions; ++i) {
+      ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&ctx_[i], VP8E_SET_CPUUSED, 7));
+    }
+  }
+
+  // Draws a box moving over a noisy gradient at the highest resolution and
+  // box filters it down to the lower ones, as an application would.
+  void FillFrame(int frame) {
+    libvpx_test::ACMRandom rnd(frame);
+    vpx_image_t *const img = &imgs_[0];
+    for (int plane = 0; plane < 3; ++plane) {
+      const int w = plane ? kWidth / 2 : kWidth;
+      const int h = plane ? kHeight / 2 : kHeight;
+      const int box_x = (plane ? 20 : 40) + 3 * frame;
+      const int box_y = (plane ? 10 : 20) + frame;
+      const int box_size = plane ? 24 : 48;
+      for (int r = 0; r < h; ++r) {
+        for (int c = 0; c < w; ++c) {
+          const bool in_box = r >= box_y && r < box_y + box_size &&
+                              c >= box_x && c < box_x + box_size;
+          img->planes[plane][r * img->stride[plane] + c] =
+              in_box ? 200 : static_cast<uint8_t>(r + c + (rnd.Rand8() & 3));
+        }
+      }
+    }
+    for (int i = 1; i < kNumResolutions; ++i) {
+      const vpx_image_t *const src = &imgs_[i - 1];
+      vpx_image_t *const dst = &imgs_[i];
+      for (int plane = 0; plane < 3; ++plane) {
+        const int w = (plane ? kWidth / 2 : kWidth) >> i;
+        const int h = (plane ? kHeight / 2 : kHeight) >> i;
+        const int ss = src->stride[plane];
+        for (int r = 0; r < h; ++r) {
+          for (int c = 0; c < w; ++c) {
+            const uint8_t *const s = src->planes[plane] + 2 * r * ss + 2 * c;
+            dst->planes[plane][r * dst->stride[plane] + c] =
+                static_cast<uint8_t>((s[0] + s[1] + s[ss] + s[ss + 1] + 2) >>
+                                     2);
+          }
+        }
+      }
+    }
+  }
+
+  // Encodes kNumFrames frames and records the key frames and golden frame
+  // updates of each resolution. The streams are decoded to check their
+  // dimensions.
+  void EncodeFrames(int forced_key_frame) {
+    vpx_codec_ctx_t dec[kNumResolutions];
+    for (int i = 0; i < kNumResolutions; ++i) {
+      ASSERT_EQ(VPX_CODEC_OK,
+                vpx_codec_dec_init(&dec[i], vpx_codec_vp9_dx(), NULL, 0));
+      key_frames_[i].clear();
+      golden_frames_[i].clear();
+    }
+    for (int frame = 0; frame < kNumFrames; ++frame) {
+      const vpx_enc_frame_flags_t flags =
+          frame == forced_key_frame ? VPX_EFLAG_FORCE_KF : 0;
+      FillFrame(frame);
+      ASSERT_EQ(VPX_CODEC_OK, vpx_codec_encode(ctx_, imgs_, frame, 1, flags,
+                                               VPX_DL_REALTIME));
+      for (int i = 0; i < kNumResolutions; ++i) {
+        vpx_codec_iter_t iter = NULL;
+        const vpx_codec_cx_pkt_t *pkt;
+        int num_frames = 0;
+        while ((pkt = vpx_codec_get_cx_data(&ctx_[i], &iter)) != NULL) {
+          if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+          ++num_frames;
+          if (pkt->data.frame.flags & VPX_FRAME_IS_KEY) {
+            key_frames_[i].push_back(frame);
+          }
+          ASSERT_EQ(VPX_CODEC_OK,
+                    vpx_codec_decode(
+                        &dec[i], static_cast<uint8_t *>(pkt->data.frame.buf),
+                        static_cast<unsigned int>(pkt->data.frame.sz), NULL,
+                        0));
+          vpx_codec_iter_t dec_iter = NULL;
+          const vpx_image_t *const out =
+              vpx_codec_get_frame(&dec[i], &dec_iter);
+          ASSERT_TRUE(out != NULL);
+          EXPECT_EQ(cfg_[i].g_w, out->d_w);
+          EXPECT_EQ(cfg_[i].g_h, out->d_h);
+          int ref_updates = 0;
+          ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&dec[i],
+                                                    VP8D_GET_LAST_REF_UPDATES,
+                                                    &ref_updates));
+          if (ref_updates & (1 << kGoldenSlot)) {
+            golden_frames_[i].push_back(frame);
+          }
+        }
+        EXPECT_EQ(1, num_frames) << "resolution " << i << " frame " << frame;
+      }
+    }
+    for (int i = 0; i < kNumResolutions; ++i) {
+      EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec[i]));
+    }
+  }
+
+  vpx_codec_ctx_t ctx_[kNumResolutions];
+  vpx_codec_enc_cfg_t cfg_[kNumResolutions];
+  vpx_rational_t dsf_[kNumResolutions];
+  vpx_image_t imgs_[kNumResolutions];
+  std::vector<int> key_frames_[kNumResolutions];
+  std::vector<int> golden_frames_[kNumResolutions];
+  bool initialized_;
+};
+
+TEST_F(MultiResTest, EncodesAllResolutions) {
+  Init();
+  EncodeFrames(-1);
+  for (int i = 0; i < kNumResolutions; ++i) {
+    ASSERT_EQ(1u, key_frames_[i].size());
+    EXPECT_EQ(0, key_frames_[i][0]);
+  }
+}
+
+TEST_F(MultiResTest, ForcedKeyFrame) {
+  Init();
+  EncodeFrames(kNumFrames / 2);
+  const int expected[] = { 0, kNumFrames / 2 };
+  for (int i = 0; i < kNumResolutions; ++i) {
+    EXPECT_EQ(std::vector<int>(expected, expected + 2), key_frames_[i]);
+  }
+}
+
+// The higher resolutions follow the key frames of the lowest one, whatever
+// their own key frame distance.
+TEST_F(MultiResTest, KeyFramesFollowLowestResolution) {
+  cfg_[kNumResolutions - 1].kf_max_dist = 7;
+  Init();
+  EncodeFrames(-1);
+  const int expected[] = { 0, 7, 14 };
+  for (int i = 0; i < kNumResolutions; ++i) {
+    EXPECT_EQ(std::vector<int>(expected, expected + 3), key_frames_[i]);
+  }
+}
+
+// The higher resolutions also follow the golden frame updates of the lowest
+// one, whatever their own golden frame interval.
+TEST_F(MultiResTest, GoldenFramesFollowLowestResolution) {
+  Init();
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&ctx_[kNumResolutions - 1],
+                                            VP9E_SET_MIN_GF_INTERVAL, 5));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&ctx_[kNumResolutions - 1],
+                                            VP9E_SET_MAX_GF_INTERVAL, 5));
+  EncodeFrames(-1);
+  const int expected[] = { 0, 5, 10, 15 };
+  for (int i = 0; i < kNumResolutions; ++i) {
+    EXPECT_EQ(std::vector<int>(expected, expected + 4), golden_frames_[i])
+        << "resolution " << i;
+  }
+}
+
+TEST_F(MultiResTest, RejectsLookahead) {
+  cfg_[1].g_lag_in_frames = 10;
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_enc_init_multi(ctx_, vpx_codec_vp9_cx(), cfg_,
+                                     kNumResolutions, 0, dsf_));
+
+  cfg_[1].g_lag_in_frames = 0;
+  Init();
+  vpx_codec_enc_cfg_t cfg = cfg_[0];
+  cfg.g_lag_in_frames = 10;
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM, vpx_codec_enc_config_set(&ctx_[0], &cfg));
+}
+
+}  // namespace
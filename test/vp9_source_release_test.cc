@@ -0,0 +1,247 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/acm_random.h"
+#include "test/md5_helper.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vpx_encoder.h"
+#include "vpx_mem/vpx_mem.h"
+
+namespace {
+
+const int kWidth = 160;
+const int kHeight = 96;
+const int kNumFrames = 12;
+const int kBorder = VP9E_SOURCE_BORDER_IN_PIXELS;
+// The stride of the encoder's internal frames for kWidth.
+const int kYStride = (kWidth + 2 * kBorder + 31) & ~31;
+
+struct SourceFrame {
+  vpx_image_t img;
+  uint8_t *buf;
+};
+
+class SourceReleaseTest : public ::testing::TestWithParam<int> {
+ protected:
+  SourceReleaseTest() : outstanding_(0) {
+    memset(released_, 0, sizeof(released_));
+  }
+
+  virtual void SetUp() {
+    libvpx_test::ACMRandom rnd(libvpx_test::ACMRandom::DeterministicSeed());
+    for (int i = 0; i < kNumFrames; ++i) {
+      AllocFrame(kYStride, &frames_[i]);
+      vpx_image_t *const img = &frames_[i].img;
+      img->user_priv = &frames_[i];
+      // A gradient that moves a little every frame, plus some noise.
+      for (int plane = 0; plane < 3; ++plane) {
+        const int w = plane ? kWidth / 2 : kWidth;
+        const int h = plane ? kHeight / 2 : kHeight;
+        for (int r = 0; r < h; ++r) {
+          for (int c = 0; c < w; ++c) {
+            img->planes[plane][r * img->stride[plane] + c] =
+                static_cast<uint8_t>((r + c + 2 * i) * (plane + 1) +
+                                     (rnd.Rand8() & 7));
+          }
+        }
+      }
+    }
+  }
+
+  virtual void TearDown() {
+    for (int i = 0; i < kNumFrames; ++i) vpx_free(frames_[i].buf);
+  }
+
+  // Lays out an I420 image with a kBorder border around each plane.
+  static void AllocFrame(int y_stride, SourceFrame *frame) {
+    const int uv_stride = y_stride / 2;
+    const size_t y_size =
+        static_cast<size_t>(y_stride) * (kHeight + 2 * kBorder);
+    const size_t uv_size =
+        static_cast<size_t>(uv_stride) * (kHeight / 2 + kBorder);
+    frame->buf = static_cast<uint8_t *>(vpx_memalign(32, y_size + 2 * uv_size));
+    ASSERT_TRUE(frame->buf != NULL);
+    memset(frame->buf, 0, y_size + 2 * uv_size);
+    vpx_image_t *const img = &frame->img;
+    memset(img, 0, sizeof(*img));
+    img->fmt = VPX_IMG_FMT_I420;
+    img->w = img->d_w = img->r_w = kWidth;
+    img->h = img->d_h = img->r_h = kHeight;
+    img->x_chroma_shift = img->y_chroma_shift = 1;
+    img->bps = 12;
+    img->stride[VPX_PLANE_Y] = y_stride;
+    img->stride[VPX_PLANE_U] = img->stride[VPX_PLANE_V] = uv_stride;
+    img->planes[VPX_PLANE_Y] = frame->buf + y_stride * kBorder + kBorder;
+    img->planes[VPX_PLANE_U] =
+        frame->buf + y_size + uv_stride * (kBorder / 2) + kBorder / 2;
+    img->planes[VPX_PLANE_V] = img->planes[VPX_PLANE_U] + uv_size;
+  }
+
+  // Lays out 'src' as NV12 with the same luma plane and border. The
+  // interleaved chroma plane has no border.
+  static void MakeNv12(const SourceFrame &src, SourceFrame *frame) {
+    const vpx_image_t *const src_img = &src.img;
+    const size_t y_size =
+        static_cast<size_t>(kYStride) * (kHeight + 2 * kBorder);
+    const size_t uv_size = static_cast<size_t>(kYStride) * (kHeight / 2);
+    frame->buf = static_cast<uint8_t *>(vpx_memalign(32, y_size + uv_size));
+    ASSERT_TRUE(frame->buf != NULL);
+    memset(frame->buf, 0, y_size + uv_size);
+    vpx_image_t *const img = &frame->img;
+    *img = *src_img;
+    img->fmt = VPX_IMG_FMT_NV12;
+    img->stride[VPX_PLANE_U] = img->stride[VPX_PLANE_V] = kYStride;
+    img->planes[VPX_PLANE_Y] = frame->buf + kYStride * kBorder + kBorder;
+    img->planes[VPX_PLANE_U] = frame->buf + y_size;
+    img->planes[VPX_PLANE_V] = img->planes[VPX_PLANE_U] + 1;
+    for (int r = 0; r < kHeight; ++r) {
+      memcpy(img->planes[VPX_PLANE_Y] + r * kYStride,
+             src_img->planes[VPX_PLANE_Y] + r * src_img->stride[VPX_PLANE_Y],
+             kWidth);
+    }
+    for (int r = 0; r < kHeight / 2; ++r) {
+      for (int c = 0; c < kWidth / 2; ++c) {
+        uint8_t *const uv = img->planes[VPX_PLANE_U] + r * kYStride + 2 * c;
+        uv[0] = src_img->planes[VPX_PLANE_U][r * src_img->stride[VPX_PLANE_U] +
+                                             c];
+        uv[1] = src_img->planes[VPX_PLANE_V][r * src_img->stride[VPX_PLANE_V] +
+                                             c];
+      }
+    }
+  }
+
+  static void ReleaseSource(void *user_priv, void *img_priv) {
+    SourceReleaseTest *const test = static_cast<SourceReleaseTest *>(user_priv);
+    const int index = static_cast<int>(static_cast<SourceFrame *>(img_priv) -
+                                       test->frames_);
+    ASSERT_GE(index, 0);
+    ASSERT_LT(index, kNumFrames);
+    ++test->released_[index];
+    --test->outstanding_;
+  }
+
+  void InitEncoder(vpx_codec_ctx_t *enc) {
+    vpx_codec_enc_cfg_t cfg;
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg, 0));
+    cfg.g_w = kWidth;
+    cfg.g_h = kHeight;
+    cfg.g_lag_in_frames = GetParam();
+    cfg.rc_target_bitrate = 200;
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_init(enc, vpx_codec_vp9_cx(), &cfg, 0));
+    ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(enc, VP8E_SET_CPUUSED, 4));
+  }
+
+  void SetReleaseCallback(vpx_codec_ctx_t *enc) {
+    vpx_source_release_cb_t cb = { ReleaseSource, this };
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(enc, VP9E_SET_SOURCE_RELEASE_CB, &cb));
+  }
+
+  static void GetPackets(vpx_codec_ctx_t *enc, libvpx_test::MD5 *md5,
+                         bool *got_data) {
+    vpx_codec_iter_t iter = NULL;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(enc, &iter)) != NULL) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      md5->Add(static_cast<const uint8_t *>(pkt->data.frame.buf),
+               pkt->data.frame.sz);
+      *got_data = true;
+    }
+  }
+
+  // Encodes all frames and returns the MD5 of the compressed data. With
+  // 'by_ref' the images are handed over through the release callback.
+  std::string Encode(bool by_ref) {
+    vpx_codec_ctx_t enc;
+    libvpx_test::MD5 md5;
+    bool got_data = false;
+    InitEncoder(&enc);
+    if (by_ref) SetReleaseCallback(&enc);
+    for (int i = 0; i < kNumFrames; ++i) {
+      if (by_ref) ++outstanding_;
+      EXPECT_EQ(VPX_CODEC_OK, vpx_codec_encode(&enc, &frames_[i].img, i, 1, 0,
+                                               VPX_DL_GOOD_QUALITY));
+      GetPackets(&enc, &md5, &got_data);
+    }
+    // With a lookahead the encoder holds on to the sources it has not coded.
+    if (by_ref && GetParam() > 0) {
+      EXPECT_GT(outstanding_, 0);
+    }
+    do {
+      got_data = false;
+      EXPECT_EQ(VPX_CODEC_OK,
+                vpx_codec_encode(&enc, NULL, 0, 1, 0, VPX_DL_GOOD_QUALITY));
+      GetPackets(&enc, &md5, &got_data);
+    } while (got_data);
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+    return md5.Get();
+  }
+
+  SourceFrame frames_[kNumFrames];
+  int released_[kNumFrames];
+  int outstanding_;
+};
+
+TEST_P(SourceReleaseTest, ReferencedSourceMatchesCopy) {
+  const std::string copied = Encode(false);
+  const std::string referenced = Encode(true);
+  EXPECT_EQ(copied, referenced);
+  EXPECT_EQ(0, outstanding_);
+  for (int i = 0; i < kNumFrames; ++i) EXPECT_EQ(1, released_[i]) << i;
+}
+
+// NV12 luma is referenced and its chroma split as the frame is queued, which
+// codes the same as planar input.
+TEST_P(SourceReleaseTest, ReferencedNv12MatchesI420) {
+  const std::string copied = Encode(false);
+  SourceFrame nv12[kNumFrames];
+  for (int i = 0; i < kNumFrames; ++i) {
+    ASSERT_NO_FATAL_FAILURE(MakeNv12(frames_[i], &nv12[i]));
+  }
+  for (int i = 0; i < kNumFrames; ++i) {
+    vpx_free(frames_[i].buf);
+    frames_[i] = nv12[i];
+  }
+  const std::string referenced = Encode(true);
+  EXPECT_EQ(copied, referenced);
+  EXPECT_EQ(0, outstanding_);
+  for (int i = 0; i < kNumFrames; ++i) EXPECT_EQ(1, released_[i]) << i;
+}
+
+TEST_P(SourceReleaseTest, OtherLayoutsAreCopied) {
+  SourceFrame frame;
+  ASSERT_NO_FATAL_FAILURE(AllocFrame(kYStride + 32, &frame));
+  frame.img.user_priv = &frames_[0];
+  vpx_codec_ctx_t enc;
+  InitEncoder(&enc);
+  SetReleaseCallback(&enc);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_encode(&enc, &frame.img, 0, 1, 0,
+                                           VPX_DL_GOOD_QUALITY));
+  EXPECT_EQ(1, released_[0]);
+  vpx_free(frame.buf);
+
+  // The callback may not be changed once frames have been queued.
+  vpx_source_release_cb_t cb = { NULL, NULL };
+  EXPECT_NE(VPX_CODEC_OK,
+            vpx_codec_control(&enc, VP9E_SET_SOURCE_RELEASE_CB, &cb));
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+  EXPECT_EQ(1, released_[0]);
+}
+
+INSTANTIATE_TEST_SUITE_P(VP9, SourceReleaseTest, ::testing::Values(0, 10));
+
+}  // namespace
@@ -19,6 +19,7 @@
 #include "test/webm_video_source.h"
 #endif
 #include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
 
 namespace {
 
@@ -145,6 +146,96 @@ TEST(VPxWorkerThreadTest, TestInterfaceAPI) {
   }
 }
 
+#if CONFIG_MULTITHREAD
+class VPxThreadPoolTest : public ::testing::TestWithParam<int> {
+ protected:
+  static const int kNumWorkers = 64;
+
+  virtual ~VPxThreadPoolTest() {}
+  virtual void SetUp() {
+    pool_ = vpx_thread_pool_create(GetParam());
+    ASSERT_NE(pool_, nullptr);
+    EXPECT_EQ(GetParam(), vpx_thread_pool_get_num_threads(pool_));
+    for (int n = 0; n < kNumWorkers; ++n) {
+      vpx_get_worker_interface()->init(&workers_[n]);
+      vpx_thread_pool_attach_worker(pool_, &workers_[n]);
+      return_value_[n] = 1;  // return successfully from the hook
+      workers_[n].hook = ThreadHook;
+      workers_[n].data1 = &hook_data_[n];
+      workers_[n].data2 = &return_value_[n];
+    }
+  }
+
+  virtual void TearDown() {
+    for (int n = 0; n < kNumWorkers; ++n) {
+      vpx_get_worker_interface()->end(&workers_[n]);
+    }
+    vpx_thread_pool_destroy(pool_);
+  }
+
+  VPxThreadPool *pool_;
+  VPxWorker workers_[kNumWorkers];
+  int hook_data_[kNumWorkers];
+  int return_value_[kNumWorkers];
+};
+
+TEST_P(VPxThreadPoolTest, HookSuccess) {
+  for (int i = 0; i < 2; ++i) {
+    for (int n = 0; n < kNumWorkers; ++n) {
+      EXPECT_NE(vpx_get_worker_interface()->reset(&workers_[n]), 0);
+      hook_data_[n] = 0;
+    }
+    for (int n = 0; n < kNumWorkers; ++n) {
+      vpx_get_worker_interface()->launch(&workers_[n]);
+    }
+    for (int n = 0; n < kNumWorkers; ++n) {
+      EXPECT_NE(vpx_get_worker_interface()->sync(&workers_[n]), 0);
+      EXPECT_FALSE(workers_[n].had_error);
+      EXPECT_EQ(5, hook_data_[n]);
+    }
+  }
+}
+
+TEST_P(VPxThreadPoolTest, HookFailure) {
+  for (int n = 0; n < kNumWorkers; ++n) {
+    EXPECT_NE(vpx_get_worker_interface()->reset(&workers_[n]), 0);
+    return_value_[n] = n & 1;  // fail every other hook
+  }
+  for (int n = 0; n < kNumWorkers; ++n) {
+    vpx_get_worker_interface()->launch(&workers_[n]);
+  }
+  for (int n = 0; n < kNumWorkers; ++n) {
+    EXPECT_EQ(n & 1, vpx_get_worker_interface()->sync(&workers_[n]));
+  }
+
+  // Ensure _reset() clears the error and _launch() can be called again.
+  for (int n = 0; n < kNumWorkers; ++n) {
+    return_value_[n] = 1;
+    EXPECT_NE(vpx_get_worker_interface()->reset(&workers_[n]), 0);
+    EXPECT_FALSE(workers_[n].had_error);
+    vpx_get_worker_interface()->launch(&workers_[n]);
+  }
+  for (int n = 0; n < kNumWorkers; ++n) {
+    EXPECT_NE(vpx_get_worker_interface()->sync(&workers_[n]), 0);
+  }
+}
+
+TEST_P(VPxThreadPoolTest, EndWithoutSync) {
+  for (int n = 0; n < kNumWorkers; ++n) {
+    EXPECT_NE(vpx_get_worker_interface()->reset(&workers_[n]), 0);
+    hook_data_[n] = 0;
+  }
+  for (int n = 0; n < kNumWorkers; ++n) {
+    vpx_get_worker_interface()->launch(&workers_[n]);
+  }
+  // TearDown() ends the workers in launch order, which exercises end()
+  // while later jobs are still queued.
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, VPxThreadPoolTest,
+                         ::testing::Values(0, 1, 4));
+#endif  // CONFIG_MULTITHREAD
+
 // -----------------------------------------------------------------------------
 // Multi-threaded decode tests
 #if CONFIG_WEBM_IO
@@ -154,13 +245,18 @@ struct FileList {
 };
 
 // Decodes |filename| with |num_threads|. Returns the md5 of the decoded frames.
-string DecodeFile(const string &filename, int num_threads) {
+// |pipeline| only applies to the frame parallel decoder.
+string DecodeFile(const string &filename, int num_threads,
+                  bool frame_parallel = false, bool pipeline = false) {
   libvpx_test::WebMVideoSource video(filename);
   video.Init();
 
   vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
   cfg.threads = num_threads;
-  libvpx_test::VP9Decoder decoder(cfg, 0);
+  const vpx_codec_flags_t flags =
+      frame_parallel ? VPX_CODEC_USE_FRAME_THREADING : 0;
+  libvpx_test::VP9Decoder decoder(cfg, flags);
+  if (pipeline) decoder.Control(VP9D_SET_PIPELINE_DECODE, 1);
 
   libvpx_test::MD5 md5;
   for (video.Begin(); video.cxdata(); video.Next()) {
@@ -179,6 +275,16 @@ string DecodeFile(const string &filename, int num_threads) {
       md5.Add(img);
     }
   }
+
+  // The frame parallel decoder outputs the frames in flight on flush.
+  if (frame_parallel) {
+    EXPECT_EQ(VPX_CODEC_OK, decoder.DecodeFrame(nullptr, 0));
+    libvpx_test::DxDataIterator dec_iter = decoder.GetDxData();
+    const vpx_image_t *img = nullptr;
+    while ((img = dec_iter.Next())) {
+      md5.Add(img);
+    }
+  }
   return string(md5.Get());
 }
 
@@ -188,6 +294,10 @@ void DecodeFiles(const FileList files[]) {
     for (int t = 1; t <= 8; ++t) {
       EXPECT_EQ(iter->expected_md5, DecodeFile(iter->name, t))
           << "threads = " << t;
+      EXPECT_EQ(iter->expected_md5, DecodeFile(iter->name, t, true))
+          << "frame parallel threads = " << t;
+      EXPECT_EQ(iter->expected_md5, DecodeFile(iter->name, t, true, true))
+          << "pipelined frame parallel threads = " << t;
     }
   }
 }
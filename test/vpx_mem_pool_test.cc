@@ -0,0 +1,218 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./vpx_config.h"
+#include "test/acm_random.h"
+#if CONFIG_VP9_ENCODER
+#include "vpx/vp8cx.h"
+#include "vpx/vpx_encoder.h"
+#endif
+#include "vpx/vpx_codec.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_util/vpx_thread.h"
+
+namespace {
+
+class VpxMemPoolTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    pool_ = vpx_codec_mem_pool_create();
+    ASSERT_TRUE(pool_ != NULL);
+    vpx_codec_mem_allocator_t allocator;
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_mem_pool_get_allocator(pool_, &allocator));
+    ASSERT_EQ(VPX_CODEC_OK, vpx_codec_set_mem_allocator(&allocator));
+  }
+
+  virtual void TearDown() {
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_set_mem_allocator(NULL));
+    vpx_codec_mem_pool_destroy(pool_);
+  }
+
+  vpx_codec_mem_pool_stats_t GetStats() {
+    vpx_codec_mem_pool_stats_t stats;
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_mem_pool_get_stats(pool_, &stats));
+    return stats;
+  }
+
+  vpx_codec_mem_pool_t *pool_;
+};
+
+TEST_F(VpxMemPoolTest, ReusesFreedBlocks) {
+  void *const a = vpx_memalign(32, 1000);
+  ASSERT_TRUE(a != NULL);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a) % 32);
+  vpx_codec_mem_pool_stats_t stats = GetStats();
+  EXPECT_EQ(1u, stats.num_heap_allocs);
+  EXPECT_GE(stats.bytes_in_use, 1000u);
+  EXPECT_EQ(stats.bytes_in_use, stats.bytes_held);
+  vpx_free(a);
+  stats = GetStats();
+  EXPECT_EQ(0u, stats.bytes_in_use);
+  EXPECT_GT(stats.bytes_held, 0u);
+
+  // A slightly different size falls in the same class and reuses the block.
+  void *const b = vpx_calloc(1, 990);
+  ASSERT_TRUE(b != NULL);
+  stats = GetStats();
+  EXPECT_EQ(2u, stats.num_allocs);
+  EXPECT_EQ(1u, stats.num_heap_allocs);
+  for (int i = 0; i < 990; ++i) {
+    ASSERT_EQ(0, static_cast<const uint8_t *>(b)[i]);
+  }
+  vpx_free(b);
+}
+
+TEST_F(VpxMemPoolTest, TracksPeakAndTrims) {
+  libvpx_test::ACMRandom rnd(libvpx_test::ACMRandom::DeterministicSeed());
+  void *blocks[64];
+  size_t requested = 0;
+  for (int i = 0; i < 64; ++i) {
+    const size_t size = 1 + rnd.Rand16();
+    requested += size;
+    blocks[i] = vpx_malloc(size);
+    ASSERT_TRUE(blocks[i] != NULL);
+    memset(blocks[i], i, size);
+  }
+  vpx_codec_mem_pool_stats_t stats = GetStats();
+  EXPECT_GE(stats.bytes_in_use, requested);
+  // Size classes waste at most a quarter plus the bookkeeping.
+  EXPECT_LE(stats.bytes_in_use, requested * 5 / 4 + 64 * 256);
+  const size_t peak = stats.bytes_in_use;
+  for (int i = 0; i < 64; ++i) vpx_free(blocks[i]);
+
+  stats = GetStats();
+  EXPECT_EQ(0u, stats.bytes_in_use);
+  EXPECT_EQ(peak, stats.peak_bytes_in_use);
+  EXPECT_EQ(peak, stats.peak_bytes_held);
+  EXPECT_EQ(peak, stats.bytes_held);
+  vpx_codec_mem_pool_trim(pool_);
+  stats = GetStats();
+  EXPECT_EQ(0u, stats.bytes_held);
+  EXPECT_EQ(peak, stats.peak_bytes_held);
+}
+
+TEST_F(VpxMemPoolTest, BlocksOutliveAllocatorSwitch) {
+  void *const pooled = vpx_malloc(100);
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_set_mem_allocator(NULL));
+  void *const system = vpx_malloc(100);
+  ASSERT_TRUE(pooled != NULL);
+  ASSERT_TRUE(system != NULL);
+  EXPECT_EQ(1u, GetStats().num_allocs);
+  // Each block goes back to the allocator that produced it.
+  vpx_free(pooled);
+  vpx_free(system);
+  EXPECT_EQ(0u, GetStats().bytes_in_use);
+}
+
+TEST_F(VpxMemPoolTest, RejectsIncompleteAllocator) {
+  vpx_codec_mem_allocator_t allocator;
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_mem_pool_get_allocator(pool_, &allocator));
+  allocator.release = NULL;
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM, vpx_codec_set_mem_allocator(&allocator));
+  // The pool stays registered.
+  void *const block = vpx_malloc(100);
+  ASSERT_TRUE(block != NULL);
+  EXPECT_EQ(1u, GetStats().num_allocs);
+  vpx_free(block);
+}
+
+#if CONFIG_MULTITHREAD
+int AllocLoop(void *data, void * /*unused*/) {
+  int *const failures = static_cast<int *>(data);
+  for (int i = 0; i < 10000; ++i) {
+    void *const block = vpx_malloc(64 + i % 1000);
+    if (block == NULL) ++*failures;
+    vpx_free(block);
+  }
+  return 1;
+}
+
+TEST_F(VpxMemPoolTest, SwitchWhileAllocating) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  VPxWorker workers[4];
+  int failures[4] = { 0 };
+  for (int i = 0; i < 4; ++i) {
+    winterface->init(&workers[i]);
+    ASSERT_NE(0, winterface->reset(&workers[i]));
+    workers[i].hook = AllocLoop;
+    workers[i].data1 = &failures[i];
+    winterface->launch(&workers[i]);
+  }
+  vpx_codec_mem_allocator_t allocator;
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_mem_pool_get_allocator(pool_, &allocator));
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_set_mem_allocator((i & 1) ? &allocator : NULL));
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NE(0, winterface->sync(&workers[i]));
+    winterface->end(&workers[i]);
+    EXPECT_EQ(0, failures[i]);
+  }
+  // Every pooled block went back to the pool rather than to free().
+  EXPECT_EQ(0u, GetStats().bytes_in_use);
+}
+#endif  // CONFIG_MULTITHREAD
+
+#if CONFIG_VP9_ENCODER
+void EncodeFrames(int num_frames) {
+  const int kWidth = 160;
+  const int kHeight = 96;
+  vpx_codec_enc_cfg_t cfg;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg, 0));
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 0;
+  vpx_codec_ctx_t enc;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&enc, vpx_codec_vp9_cx(), &cfg, 0));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP8E_SET_CPUUSED, 8));
+  vpx_image_t img;
+  ASSERT_TRUE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 1) !=
+              NULL);
+
+  libvpx_test::ACMRandom rnd(libvpx_test::ACMRandom::DeterministicSeed());
+  for (int frame = 0; frame < num_frames; ++frame) {
+    for (int i = 0; i < kWidth * kHeight * 3 / 2; ++i) {
+      img.img_data[i] = rnd.Rand8();
+    }
+    ASSERT_EQ(VPX_CODEC_OK, vpx_codec_encode(&enc, &img, frame, 1, 0,
+                                             VPX_DL_GOOD_QUALITY));
+    vpx_codec_iter_t iter = NULL;
+    while (vpx_codec_get_cx_data(&enc, &iter) != NULL) {
+    }
+  }
+  vpx_img_free(&img);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+}
+
+TEST_F(VpxMemPoolTest, Vp9EncoderReusesBlocks) {
+  ASSERT_NO_FATAL_FAILURE(EncodeFrames(10));
+  const vpx_codec_mem_pool_stats_t first = GetStats();
+  EXPECT_EQ(0u, first.bytes_in_use);
+  EXPECT_GT(first.num_heap_allocs, 0u);
+
+  // A second encoder is served entirely from the blocks the first released.
+  ASSERT_NO_FATAL_FAILURE(EncodeFrames(10));
+  const vpx_codec_mem_pool_stats_t second = GetStats();
+  EXPECT_EQ(0u, second.bytes_in_use);
+  EXPECT_GT(second.num_allocs, first.num_allocs);
+  EXPECT_EQ(first.num_heap_allocs, second.num_heap_allocs);
+  EXPECT_EQ(first.peak_bytes_held, second.peak_bytes_held);
+}
+#endif  // CONFIG_VP9_ENCODER
+
+}  // namespace
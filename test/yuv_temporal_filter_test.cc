@@ -297,6 +297,7 @@ class YUVTemporalFilterTest
 
     rnd_.Reset(ACMRandom::DeterministicSeed());
     saturate_test_ = 0;
+    pre_padding_ = 0;
     num_repeats_ = 10;
 
     ASSERT_TRUE(bd_ == 8 || bd_ == 10 || bd_ == 12);
@@ -314,6 +315,7 @@ class YUVTemporalFilterTest
   YUVTemporalFilterFunc filter_func_;
   ACMRandom rnd_;
   int saturate_test_;
+  int pre_padding_;
   int num_repeats_;
   int use_highbd_;
   int bd_;
@@ -328,21 +330,23 @@ void YUVTemporalFilterTest::CompareTestWithParam(int width, int height,
   const int uv_width = width >> ss_x, uv_height = height >> ss_y;
 
   Buffer<PixelType> y_src = Buffer<PixelType>(width, height, 0);
-  Buffer<PixelType> y_pre = Buffer<PixelType>(width, height, 0);
+  Buffer<PixelType> y_pre = Buffer<PixelType>(width, height, pre_padding_);
   Buffer<uint16_t> y_count_ref = Buffer<uint16_t>(width, height, 0);
   Buffer<uint32_t> y_accum_ref = Buffer<uint32_t>(width, height, 0);
   Buffer<uint16_t> y_count_tst = Buffer<uint16_t>(width, height, 0);
   Buffer<uint32_t> y_accum_tst = Buffer<uint32_t>(width, height, 0);
 
   Buffer<PixelType> u_src = Buffer<PixelType>(uv_width, uv_height, 0);
-  Buffer<PixelType> u_pre = Buffer<PixelType>(uv_width, uv_height, 0);
+  Buffer<PixelType> u_pre =
+      Buffer<PixelType>(uv_width, uv_height, pre_padding_);
   Buffer<uint16_t> u_count_ref = Buffer<uint16_t>(uv_width, uv_height, 0);
   Buffer<uint32_t> u_accum_ref = Buffer<uint32_t>(uv_width, uv_height, 0);
   Buffer<uint16_t> u_count_tst = Buffer<uint16_t>(uv_width, uv_height, 0);
   Buffer<uint32_t> u_accum_tst = Buffer<uint32_t>(uv_width, uv_height, 0);
 
   Buffer<PixelType> v_src = Buffer<PixelType>(uv_width, uv_height, 0);
-  Buffer<PixelType> v_pre = Buffer<PixelType>(uv_width, uv_height, 0);
+  Buffer<PixelType> v_pre =
+      Buffer<PixelType>(uv_width, uv_height, pre_padding_);
   Buffer<uint16_t> v_count_ref = Buffer<uint16_t>(uv_width, uv_height, 0);
   Buffer<uint32_t> v_accum_ref = Buffer<uint32_t>(uv_width, uv_height, 0);
   Buffer<uint16_t> v_count_tst = Buffer<uint16_t>(uv_width, uv_height, 0);
@@ -539,6 +543,31 @@ TEST_P(YUVTemporalFilterTest, Use32x32) {
   }
 }
 
+// The filter reads the predictor straight from the frame when it needs no
+// interpolation, so the predictor stride differs from the block width.
+TEST_P(YUVTemporalFilterTest, PredictorStride) {
+  const int width = 32, height = 32;
+  const int use_32x32 = 1;
+  pre_padding_ = 16;
+
+  for (int ss_x = 0; ss_x <= 1; ss_x++) {
+    for (int ss_y = 0; ss_y <= 1; ss_y++) {
+      for (int filter_weight = 0; filter_weight <= 2; filter_weight++) {
+        if (use_highbd_) {
+          const int adjusted_strength = 6 + 2 * (bd_ - 8);
+          CompareTestWithParam<uint16_t>(width, height, ss_x, ss_y,
+                                         adjusted_strength, use_32x32,
+                                         &filter_weight);
+        } else {
+          CompareTestWithParam<uint8_t>(width, height, ss_x, ss_y, 6,
+                                        use_32x32, &filter_weight);
+        }
+        ASSERT_FALSE(HasFailure());
+      }
+    }
+  }
+}
+
 TEST_P(YUVTemporalFilterTest, Use16x16) {
   const int width = 32, height = 32;
   const int use_32x32 = 0;
@@ -694,6 +723,18 @@ INSTANTIATE_TEST_SUITE_P(
         TemporalFilterWithBd(&wrap_vp9_highbd_apply_temporal_filter_sse4_1_12,
                              12)));
 #endif  // HAVE_SSE4_1
+#if HAVE_AVX2
+WRAP_HIGHBD_FUNC(vp9_highbd_apply_temporal_filter_avx2, 10);
+WRAP_HIGHBD_FUNC(vp9_highbd_apply_temporal_filter_avx2, 12);
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, YUVTemporalFilterTest,
+    ::testing::Values(
+        TemporalFilterWithBd(&wrap_vp9_highbd_apply_temporal_filter_avx2_10,
+                             10),
+        TemporalFilterWithBd(&wrap_vp9_highbd_apply_temporal_filter_avx2_12,
+                             12)));
+#endif  // HAVE_AVX2
 #else
 INSTANTIATE_TEST_SUITE_P(
     C, YUVTemporalFilterTest,
@@ -704,5 +745,11 @@ INSTANTIATE_TEST_SUITE_P(SSE4_1, YUVTemporalFilterTest,
                          ::testing::Values(TemporalFilterWithBd(
                              &vp9_apply_temporal_filter_sse4_1, 8)));
 #endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(AVX2, YUVTemporalFilterTest,
+                         ::testing::Values(TemporalFilterWithBd(
+                             &vp9_apply_temporal_filter_avx2, 8)));
+#endif  // HAVE_AVX2
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 }  // namespace
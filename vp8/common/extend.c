@@ -11,40 +11,52 @@
 #include "extend.h"
 #include "vpx_mem/vpx_mem.h"
 
-static void copy_and_extend_plane(
-    unsigned char *s,      /* source */
-    int sp,                /* source pitch */
-    unsigned char *d,      /* destination */
-    int dp,                /* destination pitch */
-    int h,                 /* height */
-    int w,                 /* width */
-    int et,                /* extend top border */
-    int el,                /* extend left border */
-    int eb,                /* extend bottom border */
-    int er,                /* extend right border */
-    int interleave_step) { /* step between pixels of the current plane */
-  int i, j;
+/* Copies the top and bottom lines of the extended plane into each line of the
+ * respective borders.
+ */
+static void extend_plane_top_bottom(unsigned char *d, int dp, int h, int w,
+                                    int et, int el, int eb, int er) {
+  int i;
+  unsigned char *src_ptr1 = d - el;
+  unsigned char *src_ptr2 = d + dp * (h - 1) - el;
+  unsigned char *dest_ptr1 = d + dp * (-et) - el;
+  unsigned char *dest_ptr2 = d + dp * (h)-el;
+  int linesize = el + er + w;
+
+  for (i = 0; i < et; ++i) {
+    memcpy(dest_ptr1, src_ptr1, linesize);
+    dest_ptr1 += dp;
+  }
+
+  for (i = 0; i < eb; ++i) {
+    memcpy(dest_ptr2, src_ptr2, linesize);
+    dest_ptr2 += dp;
+  }
+}
+
+static void copy_and_extend_plane(unsigned char *s, /* source */
+                                  int sp,           /* source pitch */
+                                  unsigned char *d, /* destination */
+                                  int dp,           /* destination pitch */
+                                  int h,            /* height */
+                                  int w,            /* width */
+                                  int et,           /* extend top border */
+                                  int el,           /* extend left border */
+                                  int eb,           /* extend bottom border */
+                                  int er) {         /* extend right border */
+  int i;
   unsigned char *src_ptr1, *src_ptr2;
   unsigned char *dest_ptr1, *dest_ptr2;
-  int linesize;
-
-  if (interleave_step < 1) interleave_step = 1;
 
   /* copy the left and right most columns out */
   src_ptr1 = s;
-  src_ptr2 = s + (w - 1) * interleave_step;
+  src_ptr2 = s + w - 1;
   dest_ptr1 = d - el;
   dest_ptr2 = d + w;
 
   for (i = 0; i < h; ++i) {
     memset(dest_ptr1, src_ptr1[0], el);
-    if (interleave_step == 1) {
-      memcpy(dest_ptr1 + el, src_ptr1, w);
-    } else {
-      for (j = 0; j < w; j++) {
-        dest_ptr1[el + j] = src_ptr1[interleave_step * j];
-      }
-    }
+    memcpy(dest_ptr1 + el, src_ptr1, w);
     memset(dest_ptr2, src_ptr2[0], er);
     src_ptr1 += sp;
     src_ptr2 += sp;
@@ -52,24 +64,37 @@ static void copy_and_extend_plane(
     dest_ptr2 += dp;
   }
 
-  /* Now copy the top and bottom lines into each line of the respective
-   * borders
-   */
-  src_ptr1 = d - el;
-  src_ptr2 = d + dp * (h - 1) - el;
-  dest_ptr1 = d + dp * (-et) - el;
-  dest_ptr2 = d + dp * (h)-el;
-  linesize = el + er + w;
+  extend_plane_top_bottom(d, dp, h, w, et, el, eb, er);
+}
 
-  for (i = 0; i < et; ++i) {
-    memcpy(dest_ptr1, src_ptr1, linesize);
-    dest_ptr1 += dp;
-  }
+/* Splits the interleaved chroma of NV12 into the u and v planes and extends
+ * both, reading each source line once.
+ */
+static void copy_and_extend_interleaved_uv(unsigned char *s, int sp,
+                                           unsigned char *du,
+                                           unsigned char *dv, int dp, int h,
+                                           int w, int et, int el, int eb,
+                                           int er) {
+  int i, j;
+  unsigned char *u = du;
+  unsigned char *v = dv;
 
-  for (i = 0; i < eb; ++i) {
-    memcpy(dest_ptr2, src_ptr2, linesize);
-    dest_ptr2 += dp;
+  for (i = 0; i < h; ++i) {
+    for (j = 0; j < w; ++j) {
+      u[j] = s[2 * j];
+      v[j] = s[2 * j + 1];
+    }
+    memset(u - el, u[0], el);
+    memset(v - el, v[0], el);
+    memset(u + w, u[w - 1], er);
+    memset(v + w, v[w - 1], er);
+    s += sp;
+    u += dp;
+    v += dp;
   }
+
+  extend_plane_top_bottom(du, dp, h, w, et, el, eb, er);
+  extend_plane_top_bottom(dv, dp, h, w, et, el, eb, er);
 }
 
 void vp8_copy_and_extend_frame(YV12_BUFFER_CONFIG *src,
@@ -80,24 +105,32 @@ void vp8_copy_and_extend_frame(YV12_BUFFER_CONFIG *src,
   int er = dst->border + dst->y_width - src->y_width;
 
   // detect nv12 colorspace
-  int chroma_step = src->v_buffer - src->u_buffer == 1 ? 2 : 1;
+  int is_nv12 = src->v_buffer - src->u_buffer == 1;
 
   copy_and_extend_plane(src->y_buffer, src->y_stride, dst->y_buffer,
                         dst->y_stride, src->y_height, src->y_width, et, el, eb,
-                        er, 1);
+                        er);
 
   et = dst->border >> 1;
   el = dst->border >> 1;
   eb = (dst->border >> 1) + dst->uv_height - src->uv_height;
   er = (dst->border >> 1) + dst->uv_width - src->uv_width;
 
+  if (is_nv12) {
+    copy_and_extend_interleaved_uv(src->u_buffer, src->uv_stride,
+                                   dst->u_buffer, dst->v_buffer, dst->uv_stride,
+                                   src->uv_height, src->uv_width, et, el, eb,
+                                   er);
+    return;
+  }
+
   copy_and_extend_plane(src->u_buffer, src->uv_stride, dst->u_buffer,
                         dst->uv_stride, src->uv_height, src->uv_width, et, el,
-                        eb, er, chroma_step);
+                        eb, er);
 
   copy_and_extend_plane(src->v_buffer, src->uv_stride, dst->v_buffer,
                         dst->uv_stride, src->uv_height, src->uv_width, et, el,
-                        eb, er, chroma_step);
+                        eb, er);
 }
 
 void vp8_copy_and_extend_frame_with_rect(YV12_BUFFER_CONFIG *src,
@@ -109,10 +142,12 @@ void vp8_copy_and_extend_frame_with_rect(YV12_BUFFER_CONFIG *src,
   int er = dst->border + dst->y_width - src->y_width;
   int src_y_offset = srcy * src->y_stride + srcx;
   int dst_y_offset = srcy * dst->y_stride + srcx;
-  int src_uv_offset = ((srcy * src->uv_stride) >> 1) + (srcx >> 1);
-  int dst_uv_offset = ((srcy * dst->uv_stride) >> 1) + (srcx >> 1);
   // detect nv12 colorspace
-  int chroma_step = src->v_buffer - src->u_buffer == 1 ? 2 : 1;
+  int is_nv12 = src->v_buffer - src->u_buffer == 1;
+  /* The chroma samples of NV12 are twice as far apart in the source. */
+  int src_uv_offset =
+      ((srcy * src->uv_stride) >> 1) + (srcx >> 1) * (is_nv12 ? 2 : 1);
+  int dst_uv_offset = ((srcy * dst->uv_stride) >> 1) + (srcx >> 1);
 
   /* If the side is not touching the bounder then don't extend. */
   if (srcy) et = 0;
@@ -122,7 +157,7 @@ void vp8_copy_and_extend_frame_with_rect(YV12_BUFFER_CONFIG *src,
 
   copy_and_extend_plane(src->y_buffer + src_y_offset, src->y_stride,
                         dst->y_buffer + dst_y_offset, dst->y_stride, srch, srcw,
-                        et, el, eb, er, 1);
+                        et, el, eb, er);
 
   et = (et + 1) >> 1;
   el = (el + 1) >> 1;
@@ -131,13 +166,21 @@ void vp8_copy_and_extend_frame_with_rect(YV12_BUFFER_CONFIG *src,
   srch = (srch + 1) >> 1;
   srcw = (srcw + 1) >> 1;
 
+  if (is_nv12) {
+    copy_and_extend_interleaved_uv(
+        src->u_buffer + src_uv_offset, src->uv_stride,
+        dst->u_buffer + dst_uv_offset, dst->v_buffer + dst_uv_offset,
+        dst->uv_stride, srch, srcw, et, el, eb, er);
+    return;
+  }
+
   copy_and_extend_plane(src->u_buffer + src_uv_offset, src->uv_stride,
                         dst->u_buffer + dst_uv_offset, dst->uv_stride, srch,
-                        srcw, et, el, eb, er, chroma_step);
+                        srcw, et, el, eb, er);
 
   copy_and_extend_plane(src->v_buffer + src_uv_offset, src->uv_stride,
                         dst->v_buffer + dst_uv_offset, dst->uv_stride, srch,
-                        srcw, et, el, eb, er, chroma_step);
+                        srcw, et, el, eb, er);
 }
 
 /* note the extension is only for the last row, for intra prediction purpose */
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+
+#include "vp8/common/threading.h"
+#include "vpx_mem/vpx_mem.h"
+
+#if CONFIG_OS_SUPPORT && CONFIG_MULTITHREAD
+
+int vp8_row_scheduler_alloc(VP8RowScheduler *rows, int max_lanes) {
+  int i;
+
+  rows->lane_row = (vpx_atomic_int *)vpx_malloc(sizeof(*rows->lane_row) *
+                                                max_lanes);
+  if (rows->lane_row == NULL) return -1;
+  if (pthread_mutex_init(&rows->mutex, NULL)) {
+    vpx_free(rows->lane_row);
+    rows->lane_row = NULL;
+    return -1;
+  }
+  for (i = 0; i < max_lanes; ++i) vpx_atomic_init(&rows->lane_row[i], 0);
+  vpx_atomic_init(&rows->aborted, 0);
+  rows->max_lanes = max_lanes;
+  rows->num_lanes = 1;
+  rows->next_row = 0;
+  rows->num_rows = 0;
+  return 0;
+}
+
+void vp8_row_scheduler_free(VP8RowScheduler *rows) {
+  if (rows->lane_row == NULL) return;
+  pthread_mutex_destroy(&rows->mutex);
+  vpx_free(rows->lane_row);
+  rows->lane_row = NULL;
+}
+
+void vp8_row_scheduler_start(VP8RowScheduler *rows, int num_rows,
+                             int num_lanes) {
+  int i;
+
+  assert(num_lanes > 0 && num_lanes <= rows->max_lanes);
+  rows->next_row = 0;
+  rows->num_rows = num_rows;
+  rows->num_lanes = num_lanes;
+  for (i = 0; i < num_lanes; ++i) {
+    vpx_atomic_store_release(&rows->lane_row[i], i);
+  }
+  vpx_atomic_store_release(&rows->aborted, 0);
+}
+
+int vp8_row_scheduler_claim(VP8RowScheduler *rows, int row_limit) {
+  int mb_row = -1;
+
+  pthread_mutex_lock(&rows->mutex);
+  if (rows->next_row < rows->num_rows && rows->next_row < row_limit) {
+    mb_row = rows->next_row++;
+  }
+  pthread_mutex_unlock(&rows->mutex);
+  return mb_row;
+}
+
+int vp8_row_scheduler_wait_lane(VP8RowScheduler *rows, int mb_row) {
+  const int lane = mb_row % rows->num_lanes;
+
+  vp8_atomic_spin_wait(mb_row, &rows->lane_row[lane], 0);
+  return lane;
+}
+
+void vp8_row_scheduler_release_lane(VP8RowScheduler *rows, int mb_row) {
+  vpx_atomic_store_release(&rows->lane_row[mb_row % rows->num_lanes],
+                           mb_row + rows->num_lanes);
+}
+
+void vp8_row_scheduler_abort(VP8RowScheduler *rows,
+                             vpx_atomic_int *current_mb_col, int last_col) {
+  pthread_mutex_lock(&rows->mutex);
+  for (; rows->next_row < rows->num_rows; ++rows->next_row) {
+    vpx_atomic_store_release(&current_mb_col[rows->next_row], last_col);
+  }
+  vpx_atomic_store_release(&rows->aborted, 1);
+  pthread_mutex_unlock(&rows->mutex);
+}
+
+#endif /* CONFIG_OS_SUPPORT && CONFIG_MULTITHREAD */
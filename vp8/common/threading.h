@@ -173,18 +173,12 @@ static inline int sem_destroy(sem_t *sem) {
 #define sem_destroy(sem) semaphore_destroy(mach_task_self(), *sem)
 #else
 #include <unistd.h>
-#include <sched.h>
 #endif /* __APPLE__ */
+#include <sched.h>
 /* Not Windows. Assume pthreads */
 
-/* thread_sleep implementation: yield unless Linux/Unix. */
-#if defined(__unix__) || defined(__APPLE__)
-#define thread_sleep(nms)
-/* {struct timespec ts;ts.tv_sec=0;
-    ts.tv_nsec = 1000*nms;nanosleep(&ts, NULL);} */
-#else
-#define thread_sleep(nms) sched_yield();
-#endif /* __unix__ || __APPLE__ */
+/* thread_sleep implementation: yield the processor. */
+#define thread_sleep(nms) sched_yield()
 
 #endif
 
@@ -197,15 +191,66 @@ static inline int sem_destroy(sem_t *sem) {
 #include "vpx_util/vpx_thread.h"
 #include "vpx_util/vpx_atomics.h"
 
+/* Number of pause hints a waiting thread issues before it yields the
+ * processor. Spinning keeps the wake-up latency low while the thread it waits
+ * on is running; yielding bounds the time it can steal from that thread when
+ * there are more threads than cores. */
+#define VP8_SPIN_WAIT_LIMIT 1024
+
 static INLINE void vp8_atomic_spin_wait(
     int mb_col, const vpx_atomic_int *last_row_current_mb_col,
     const int nsync) {
+  int spins = 0;
   while (mb_col > (vpx_atomic_load_acquire(last_row_current_mb_col) - nsync)) {
     x86_pause_hint();
-    thread_sleep(0);
+    if (++spins == VP8_SPIN_WAIT_LIMIT) {
+      thread_sleep(0);
+      spins = 0;
+    }
   }
 }
 
+/* Hands out the macroblock rows of a frame to jobs queued on a shared thread
+ * pool. Rows are claimed in order and row r is coded with the state of lane
+ * r % num_lanes, one row of a lane at a time, so the output is the same as
+ * with one dedicated thread per lane. A job only waits on rows claimed before
+ * its own, whose owners are running, so a pool with fewer threads than jobs
+ * cannot deadlock.
+ */
+typedef struct VP8RowScheduler {
+  pthread_mutex_t mutex;
+  int next_row;
+  int num_rows;
+  int num_lanes;
+  int max_lanes;
+  vpx_atomic_int *lane_row; /* the next row each lane may code */
+  vpx_atomic_int aborted;
+} VP8RowScheduler;
+
+/* Returns 0 on success. */
+int vp8_row_scheduler_alloc(VP8RowScheduler *rows, int max_lanes);
+void vp8_row_scheduler_free(VP8RowScheduler *rows);
+
+void vp8_row_scheduler_start(VP8RowScheduler *rows, int num_rows,
+                             int num_lanes);
+
+/* Returns the next row if it is below 'row_limit', -1 otherwise. */
+int vp8_row_scheduler_claim(VP8RowScheduler *rows, int row_limit);
+
+/* Waits until the lane of 'mb_row' is done with its previous row and returns
+ * the lane. */
+int vp8_row_scheduler_wait_lane(VP8RowScheduler *rows, int mb_row);
+void vp8_row_scheduler_release_lane(VP8RowScheduler *rows, int mb_row);
+
+/* Stops handing out rows and marks the unclaimed ones as done in
+ * 'current_mb_col', so that no job waits on them. */
+void vp8_row_scheduler_abort(VP8RowScheduler *rows,
+                             vpx_atomic_int *current_mb_col, int last_col);
+
+static INLINE int vp8_row_scheduler_aborted(VP8RowScheduler *rows) {
+  return vpx_atomic_load_acquire(&rows->aborted);
+}
+
 #endif /* CONFIG_OS_SUPPORT && CONFIG_MULTITHREAD */
 
 #ifdef __cplusplus
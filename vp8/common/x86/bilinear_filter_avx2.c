@@ -0,0 +1,190 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./vp8_rtcd.h"
+#include "./vpx_config.h"
+#include "vp8/common/filter.h"
+#include "vpx_ports/mem.h"
+
+/* Both passes filter two rows at once, one in each 128-bit lane, and keep
+ * the intermediate rows as bytes: the taps are positive and sum to 128 so
+ * the first pass never leaves the 0-255 range. A pass with a zero offset is
+ * the identity and is skipped.
+ */
+
+DECLARE_ALIGNED(32, static const uint8_t, filt_pairs[32]) = {
+  0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
+  0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8
+};
+
+static INLINE __m256i load_taps(int offset) {
+  const short *const f = vp8_bilinear_filters[offset];
+  assert(offset > 0);
+  return _mm256_set1_epi16((short)((f[1] << 8) | f[0]));
+}
+
+/* Returns (a * k[0] + b * k[1] + 64) >> 7 for the interleaved pixels ab. */
+static INLINE __m256i filter(const __m256i ab, const __m256i k) {
+  return _mm256_mulhrs_epi16(_mm256_maddubs_epi16(ab, k),
+                             _mm256_set1_epi16(1 << (15 - VP8_FILTER_SHIFT)));
+}
+
+static INLINE __m256i load_2x16(const uint8_t *a, const uint8_t *b) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)a)),
+      _mm_loadu_si128((const __m128i *)b), 1);
+}
+
+static INLINE __m256i load_2x8(const uint8_t *a, const uint8_t *b) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *)a)),
+      _mm_loadl_epi64((const __m128i *)b), 1);
+}
+
+static void horizontal_16xN(const uint8_t *src, int src_stride, uint8_t *dst,
+                            int dst_stride, int height, int xoffset) {
+  const __m256i k = load_taps(xoffset);
+  int h;
+
+  for (h = 0; h < height; h += 2) {
+    /* An odd last row is filtered in both lanes. */
+    const int next = h + 1 < height ? src_stride : 0;
+    const __m256i a = load_2x16(src, src + next);
+    const __m256i b = load_2x16(src + 1, src + next + 1);
+    const __m256i lo = filter(_mm256_unpacklo_epi8(a, b), k);
+    const __m256i hi = filter(_mm256_unpackhi_epi8(a, b), k);
+    const __m256i d = _mm256_packus_epi16(lo, hi);
+
+    _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(d));
+    if (next) {
+      _mm_storeu_si128((__m128i *)(dst + dst_stride),
+                       _mm256_extracti128_si256(d, 1));
+    }
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
+
+static void vertical_16xN(const uint8_t *src, int src_stride, uint8_t *dst,
+                          int dst_stride, int height, int yoffset) {
+  const __m256i k = load_taps(yoffset);
+  int h;
+
+  for (h = 0; h < height; h += 2) {
+    const __m256i a = load_2x16(src, src + src_stride);
+    const __m256i b = load_2x16(src + src_stride, src + 2 * src_stride);
+    const __m256i lo = filter(_mm256_unpacklo_epi8(a, b), k);
+    const __m256i hi = filter(_mm256_unpackhi_epi8(a, b), k);
+    const __m256i d = _mm256_packus_epi16(lo, hi);
+
+    _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(d));
+    _mm_storeu_si128((__m128i *)(dst + dst_stride),
+                     _mm256_extracti128_si256(d, 1));
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
+
+static void horizontal_8xN(const uint8_t *src, int src_stride, uint8_t *dst,
+                           int dst_stride, int height, int xoffset) {
+  const __m256i k = load_taps(xoffset);
+  const __m256i pairs = _mm256_load_si256((const __m256i *)filt_pairs);
+  int h;
+
+  for (h = 0; h < height; h += 2) {
+    const int next = h + 1 < height ? src_stride : 0;
+    const __m256i a = load_2x16(src, src + next);
+    const __m256i s = filter(_mm256_shuffle_epi8(a, pairs), k);
+    const __m256i d = _mm256_packus_epi16(s, s);
+
+    _mm_storel_epi64((__m128i *)dst, _mm256_castsi256_si128(d));
+    if (next) {
+      _mm_storel_epi64((__m128i *)(dst + dst_stride),
+                       _mm256_extracti128_si256(d, 1));
+    }
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
+
+static void vertical_8xN(const uint8_t *src, int src_stride, uint8_t *dst,
+                         int dst_stride, int height, int yoffset) {
+  const __m256i k = load_taps(yoffset);
+  int h;
+
+  for (h = 0; h < height; h += 2) {
+    const __m256i a = load_2x8(src, src + src_stride);
+    const __m256i b = load_2x8(src + src_stride, src + 2 * src_stride);
+    const __m256i s = filter(_mm256_unpacklo_epi8(a, b), k);
+    const __m256i d = _mm256_packus_epi16(s, s);
+
+    _mm_storel_epi64((__m128i *)dst, _mm256_castsi256_si128(d));
+    _mm_storel_epi64((__m128i *)(dst + dst_stride),
+                     _mm256_extracti128_si256(d, 1));
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
+
+void vp8_bilinear_predict16x16_avx2(uint8_t *src_ptr, int src_pixels_per_line,
+                                    int xoffset, int yoffset, uint8_t *dst_ptr,
+                                    int dst_pitch) {
+  DECLARE_ALIGNED(32, uint8_t, FData[16 * 17]);
+
+  assert((xoffset | yoffset) != 0);
+
+  if (!yoffset) {
+    horizontal_16xN(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch, 16,
+                    xoffset);
+  } else if (!xoffset) {
+    vertical_16xN(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch, 16,
+                  yoffset);
+  } else {
+    horizontal_16xN(src_ptr, src_pixels_per_line, FData, 16, 17, xoffset);
+    vertical_16xN(FData, 16, dst_ptr, dst_pitch, 16, yoffset);
+  }
+}
+
+static void bilinear_predict8xN(uint8_t *src_ptr, int src_pixels_per_line,
+                                int xoffset, int yoffset, uint8_t *dst_ptr,
+                                int dst_pitch, int height) {
+  DECLARE_ALIGNED(32, uint8_t, FData[8 * 9]);
+
+  assert((xoffset | yoffset) != 0);
+
+  if (!yoffset) {
+    horizontal_8xN(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch, height,
+                   xoffset);
+  } else if (!xoffset) {
+    vertical_8xN(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch, height,
+                 yoffset);
+  } else {
+    horizontal_8xN(src_ptr, src_pixels_per_line, FData, 8, height + 1,
+                   xoffset);
+    vertical_8xN(FData, 8, dst_ptr, dst_pitch, height, yoffset);
+  }
+}
+
+void vp8_bilinear_predict8x8_avx2(uint8_t *src_ptr, int src_pixels_per_line,
+                                  int xoffset, int yoffset, uint8_t *dst_ptr,
+                                  int dst_pitch) {
+  bilinear_predict8xN(src_ptr, src_pixels_per_line, xoffset, yoffset, dst_ptr,
+                      dst_pitch, 8);
+}
+
+void vp8_bilinear_predict8x4_avx2(uint8_t *src_ptr, int src_pixels_per_line,
+                                  int xoffset, int yoffset, uint8_t *dst_ptr,
+                                  int dst_pitch) {
+  bilinear_predict8xN(src_ptr, src_pixels_per_line, xoffset, yoffset, dst_ptr,
+                      dst_pitch, 4);
+}
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vp8_rtcd.h"
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/mem_sse2.h"
+#include "vpx_ports/mem.h"
+
+/* Four 4x4 blocks side by side are transformed at once. Each vector holds
+ * one row (or column) of all four blocks, block j in 64-bit slot j, so that
+ * the rows of the result are the 16 pixel rows of the destination: blocks 0
+ * and 1 are added to dst_lo and blocks 2 and 3 to dst_hi.
+ */
+
+/* x * sqrt(2) * sin(pi/8) and x * sqrt(2) * cos(pi/8), see idctllm.c */
+static INLINE __m256i mul_sin(const __m256i x) {
+  return _mm256_add_epi16(x, _mm256_mulhi_epi16(x, _mm256_set1_epi16(-30068)));
+}
+
+static INLINE __m256i mul_cos(const __m256i x) {
+  return _mm256_add_epi16(x, _mm256_mulhi_epi16(x, _mm256_set1_epi16(20091)));
+}
+
+static INLINE void idct4(__m256i *x) {
+  const __m256i a1 = _mm256_add_epi16(x[0], x[2]);
+  const __m256i b1 = _mm256_sub_epi16(x[0], x[2]);
+  const __m256i c1 = _mm256_sub_epi16(mul_sin(x[1]), mul_cos(x[3]));
+  const __m256i d1 = _mm256_add_epi16(mul_cos(x[1]), mul_sin(x[3]));
+
+  x[0] = _mm256_add_epi16(a1, d1);
+  x[1] = _mm256_add_epi16(b1, c1);
+  x[2] = _mm256_sub_epi16(b1, c1);
+  x[3] = _mm256_sub_epi16(a1, d1);
+}
+
+/* Transposes each of the four 4x4 blocks. */
+static INLINE void transpose_4x4x4(__m256i *x) {
+  const __m256i a0 = _mm256_unpacklo_epi16(x[0], x[1]);
+  const __m256i a1 = _mm256_unpackhi_epi16(x[0], x[1]);
+  const __m256i a2 = _mm256_unpacklo_epi16(x[2], x[3]);
+  const __m256i a3 = _mm256_unpackhi_epi16(x[2], x[3]);
+  const __m256i b0 = _mm256_unpacklo_epi32(a0, a2);
+  const __m256i b1 = _mm256_unpackhi_epi32(a0, a2);
+  const __m256i b2 = _mm256_unpacklo_epi32(a1, a3);
+  const __m256i b3 = _mm256_unpackhi_epi32(a1, a3);
+
+  x[0] = _mm256_unpacklo_epi64(b0, b2);
+  x[1] = _mm256_unpackhi_epi64(b0, b2);
+  x[2] = _mm256_unpacklo_epi64(b1, b3);
+  x[3] = _mm256_unpackhi_epi64(b1, b3);
+}
+
+static INLINE void add_residual_row(const __m256i r, unsigned char *dst_lo,
+                                    unsigned char *dst_hi) {
+  const __m128i pred =
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)dst_lo),
+                         _mm_loadl_epi64((const __m128i *)dst_hi));
+  const __m256i sum = _mm256_add_epi16(_mm256_cvtepu8_epi16(pred), r);
+  const __m128i d = _mm256_castsi256_si128(
+      _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08));
+  _mm_storel_epi64((__m128i *)dst_lo, d);
+  _mm_storeh_epi64((__m128i *)dst_hi, d);
+}
+
+static void dequant_idct_add_4x(short *q_lo, short *q_hi, const short *dq,
+                                unsigned char *dst_lo, unsigned char *dst_hi,
+                                int stride) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i b0 = _mm256_loadu_si256((const __m256i *)q_lo);
+  const __m256i b1 = _mm256_loadu_si256((const __m256i *)(q_lo + 16));
+  const __m256i b2 = _mm256_loadu_si256((const __m256i *)q_hi);
+  const __m256i b3 = _mm256_loadu_si256((const __m256i *)(q_hi + 16));
+  const __m256i r02_lo = _mm256_unpacklo_epi64(b0, b1);
+  const __m256i r13_lo = _mm256_unpackhi_epi64(b0, b1);
+  const __m256i r02_hi = _mm256_unpacklo_epi64(b2, b3);
+  const __m256i r13_hi = _mm256_unpackhi_epi64(b2, b3);
+  __m256i x[4];
+  int i;
+
+  x[0] = _mm256_permute2x128_si256(r02_lo, r02_hi, 0x20);
+  x[1] = _mm256_permute2x128_si256(r13_lo, r13_hi, 0x20);
+  x[2] = _mm256_permute2x128_si256(r02_lo, r02_hi, 0x31);
+  x[3] = _mm256_permute2x128_si256(r13_lo, r13_hi, 0x31);
+
+  for (i = 0; i < 4; ++i) {
+    const __m256i d =
+        _mm256_broadcastq_epi64(_mm_loadl_epi64((const __m128i *)(dq + 4 * i)));
+    x[i] = _mm256_mullo_epi16(x[i], d);
+  }
+
+  _mm256_storeu_si256((__m256i *)q_lo, zero);
+  _mm256_storeu_si256((__m256i *)(q_lo + 16), zero);
+  _mm256_storeu_si256((__m256i *)q_hi, zero);
+  _mm256_storeu_si256((__m256i *)(q_hi + 16), zero);
+
+  idct4(x);
+  transpose_4x4x4(x);
+  idct4(x);
+  transpose_4x4x4(x);
+
+  for (i = 0; i < 4; ++i) {
+    /* (x + 4) >> 3 */
+    const __m256i r = _mm256_mulhrs_epi16(x[i], _mm256_set1_epi16(1 << 12));
+    add_residual_row(r, dst_lo + i * stride, dst_hi + i * stride);
+  }
+}
+
+static void dc_only_idct_add_4x(short *q_lo, short *q_hi, const short *dq,
+                                unsigned char *dst_lo, unsigned char *dst_hi,
+                                int stride) {
+  const short dc0 = (short)(q_lo[0] * dq[0]);
+  const short dc1 = (short)(q_lo[16] * dq[0]);
+  const short dc2 = (short)(q_hi[0] * dq[0]);
+  const short dc3 = (short)(q_hi[16] * dq[0]);
+  const short a0 = (dc0 + 4) >> 3;
+  const short a1 = (dc1 + 4) >> 3;
+  const short a2 = (dc2 + 4) >> 3;
+  const short a3 = (dc3 + 4) >> 3;
+  const __m256i r = _mm256_setr_epi16(a0, a0, a0, a0, a1, a1, a1, a1, a2, a2,
+                                      a2, a2, a3, a3, a3, a3);
+  int i;
+
+  storeu_uint32(q_lo, 0);
+  storeu_uint32(q_lo + 16, 0);
+  storeu_uint32(q_hi, 0);
+  storeu_uint32(q_hi + 16, 0);
+
+  for (i = 0; i < 4; ++i) {
+    add_residual_row(r, dst_lo + i * stride, dst_hi + i * stride);
+  }
+}
+
+static INLINE void dequant_idct_add_row(short *q_lo, short *q_hi,
+                                        const short *dq, unsigned char *dst_lo,
+                                        unsigned char *dst_hi, int stride,
+                                        const uint32_t eob) {
+  if (eob & 0xfefefefe) {
+    dequant_idct_add_4x(q_lo, q_hi, dq, dst_lo, dst_hi, stride);
+  } else if (eob) {
+    dc_only_idct_add_4x(q_lo, q_hi, dq, dst_lo, dst_hi, stride);
+  }
+}
+
+void vp8_dequant_idct_add_y_block_avx2(short *q, short *dq, unsigned char *dst,
+                                       int stride, char *eobs) {
+  int i;
+
+  for (i = 0; i < 4; ++i) {
+    dequant_idct_add_row(q, q + 32, dq, dst, dst + 8, stride,
+                         loadu_uint32(eobs));
+    q += 64;
+    dst += stride * 4;
+    eobs += 4;
+  }
+}
+
+void vp8_dequant_idct_add_uv_block_avx2(short *q, short *dq,
+                                        unsigned char *dst_u,
+                                        unsigned char *dst_v, int stride,
+                                        char *eobs) {
+  int i;
+
+  /* The U and V blocks of each row of blocks are transformed together. */
+  for (i = 0; i < 2; ++i) {
+    const uint32_t eob =
+        (loadu_uint32(eobs) & 0xffff) | (loadu_uint32(eobs + 2) & 0xffff0000);
+    dequant_idct_add_row(q, q + 64, dq, dst_u, dst_v, stride, eob);
+    q += 32;
+    dst_u += stride * 4;
+    dst_v += stride * 4;
+    eobs += 2;
+  }
+}
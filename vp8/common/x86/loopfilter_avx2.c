@@ -0,0 +1,425 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vp8_rtcd.h"
+#include "./vpx_config.h"
+#include "vp8/common/loopfilter.h"
+#include "vpx_dsp/x86/mem_sse2.h"
+#include "vpx_ports/mem.h"
+
+/* The luma edge is filtered in the low 128-bit lane and the chroma edges in
+ * the high lane: for horizontal edges each lane holds one row of 16 pixels
+ * (Y, or U followed by V) and for vertical edges each lane holds one column
+ * of 16 pixels (Y rows 0-15, or U rows 0-7 followed by V rows 0-7). When
+ * there is no chroma the luma pixels are loaded into both lanes and only the
+ * low lane is stored.
+ */
+
+static INLINE __m256i load_2x8(const uint8_t *lo, const uint8_t *hi) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *)lo)),
+      _mm_loadl_epi64((const __m128i *)hi), 1);
+}
+
+static INLINE __m256i load_y_uv_row(const uint8_t *y, const uint8_t *u,
+                                    const uint8_t *v) {
+  const __m128i uv = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)u),
+                                        _mm_loadl_epi64((const __m128i *)v));
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)y)), uv, 1);
+}
+
+static INLINE void store_y_uv_row(uint8_t *y, uint8_t *u, uint8_t *v,
+                                  const __m256i x, const int store_uv) {
+  _mm_storeu_si128((__m128i *)y, _mm256_castsi256_si128(x));
+  if (store_uv) {
+    const __m128i uv = _mm256_extracti128_si256(x, 1);
+    _mm_storel_epi64((__m128i *)u, uv);
+    _mm_storeh_epi64((__m128i *)v, uv);
+  }
+}
+
+static INLINE __m256i abs_diff(const __m256i a, const __m256i b) {
+  return _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+}
+
+/* Computes the filter and high edge variance masks for the pixels
+ * s[0..7] = p3, p2, p1, p0, q0, q1, q2, q3.
+ */
+static INLINE void filter_mask(const __m256i *s, const __m256i blimit,
+                               const __m256i limit, const __m256i thresh,
+                               __m256i *mask, __m256i *hev) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i abs_p1p0 = abs_diff(s[2], s[3]);
+  const __m256i abs_q1q0 = abs_diff(s[5], s[4]);
+  const __m256i abs_p0q0 = abs_diff(s[3], s[4]);
+  const __m256i abs_p1q1 = abs_diff(s[2], s[5]);
+  __m256i edge, max;
+
+  /* abs(p0 - q0) * 2 + abs(p1 - q1) / 2 > blimit */
+  edge = _mm256_adds_epu8(
+      _mm256_adds_epu8(abs_p0q0, abs_p0q0),
+      _mm256_srli_epi16(_mm256_and_si256(abs_p1q1, _mm256_set1_epi8(-2)), 1));
+  edge = _mm256_subs_epu8(edge, blimit);
+
+  max = _mm256_max_epu8(abs_p1p0, abs_q1q0);
+  *hev = _mm256_cmpeq_epi8(_mm256_subs_epu8(max, thresh), zero);
+  *hev = _mm256_xor_si256(*hev, _mm256_set1_epi8(-1));
+
+  max = _mm256_max_epu8(max, abs_diff(s[0], s[1]));
+  max = _mm256_max_epu8(max, abs_diff(s[1], s[2]));
+  max = _mm256_max_epu8(max, abs_diff(s[6], s[5]));
+  max = _mm256_max_epu8(max, abs_diff(s[7], s[6]));
+  max = _mm256_max_epu8(_mm256_subs_epu8(max, limit), edge);
+  *mask = _mm256_cmpeq_epi8(max, zero);
+}
+
+/* Arithmetic right shift of signed bytes. */
+static INLINE __m256i srai_epi8(const __m256i x, const int bits) {
+  const __m256i lo = _mm256_unpacklo_epi8(_mm256_setzero_si256(), x);
+  const __m256i hi = _mm256_unpackhi_epi8(_mm256_setzero_si256(), x);
+  return _mm256_packs_epi16(_mm256_srai_epi16(lo, 8 + bits),
+                            _mm256_srai_epi16(hi, 8 + bits));
+}
+
+/* Returns (filter * tap + 63) >> 7 with signed byte saturation. */
+static INLINE __m256i mbfilter_tap(const __m256i filter, const int tap) {
+  const __m256i k = _mm256_set1_epi16((short)((63 << 8) | tap));
+  const __m256i one = _mm256_set1_epi8(1);
+  const __m256i lo = _mm256_maddubs_epi16(k, _mm256_unpacklo_epi8(filter, one));
+  const __m256i hi = _mm256_maddubs_epi16(k, _mm256_unpackhi_epi8(filter, one));
+  return _mm256_packs_epi16(_mm256_srai_epi16(lo, 7), _mm256_srai_epi16(hi, 7));
+}
+
+/* Filters p1, p0, q0 and q1 (s[2..5]) in place. */
+static INLINE void loop_filter(__m256i *s, const __m256i mask,
+                               const __m256i hev) {
+  const __m256i t80 = _mm256_set1_epi8((char)0x80);
+  const __m256i ps1 = _mm256_xor_si256(s[2], t80);
+  const __m256i ps0 = _mm256_xor_si256(s[3], t80);
+  const __m256i qs0 = _mm256_xor_si256(s[4], t80);
+  const __m256i qs1 = _mm256_xor_si256(s[5], t80);
+  const __m256i qs0_ps0 = _mm256_subs_epi8(qs0, ps0);
+  __m256i filter, filter1, filter2;
+
+  filter = _mm256_and_si256(_mm256_subs_epi8(ps1, qs1), hev);
+  filter = _mm256_adds_epi8(filter, qs0_ps0);
+  filter = _mm256_adds_epi8(filter, qs0_ps0);
+  filter = _mm256_adds_epi8(filter, qs0_ps0);
+  filter = _mm256_and_si256(filter, mask);
+
+  filter1 = srai_epi8(_mm256_adds_epi8(filter, _mm256_set1_epi8(4)), 3);
+  filter2 = srai_epi8(_mm256_adds_epi8(filter, _mm256_set1_epi8(3)), 3);
+  s[4] = _mm256_xor_si256(_mm256_subs_epi8(qs0, filter1), t80);
+  s[3] = _mm256_xor_si256(_mm256_adds_epi8(ps0, filter2), t80);
+
+  /* outer tap adjustments */
+  filter = srai_epi8(_mm256_add_epi8(filter1, _mm256_set1_epi8(1)), 1);
+  filter = _mm256_andnot_si256(hev, filter);
+  s[5] = _mm256_xor_si256(_mm256_subs_epi8(qs1, filter), t80);
+  s[2] = _mm256_xor_si256(_mm256_adds_epi8(ps1, filter), t80);
+}
+
+/* Filters p2 to q2 (s[1..6]) in place. */
+static INLINE void mbloop_filter(__m256i *s, const __m256i mask,
+                                 const __m256i hev) {
+  const __m256i t80 = _mm256_set1_epi8((char)0x80);
+  const __m256i ps2 = _mm256_xor_si256(s[1], t80);
+  const __m256i ps1 = _mm256_xor_si256(s[2], t80);
+  const __m256i qs1 = _mm256_xor_si256(s[5], t80);
+  const __m256i qs2 = _mm256_xor_si256(s[6], t80);
+  __m256i ps0 = _mm256_xor_si256(s[3], t80);
+  __m256i qs0 = _mm256_xor_si256(s[4], t80);
+  const __m256i qs0_ps0 = _mm256_subs_epi8(qs0, ps0);
+  __m256i filter, filter1, filter2, u;
+
+  filter = _mm256_subs_epi8(ps1, qs1);
+  filter = _mm256_adds_epi8(filter, qs0_ps0);
+  filter = _mm256_adds_epi8(filter, qs0_ps0);
+  filter = _mm256_adds_epi8(filter, qs0_ps0);
+  filter = _mm256_and_si256(filter, mask);
+
+  filter2 = _mm256_and_si256(filter, hev);
+  filter1 = srai_epi8(_mm256_adds_epi8(filter2, _mm256_set1_epi8(4)), 3);
+  filter2 = srai_epi8(_mm256_adds_epi8(filter2, _mm256_set1_epi8(3)), 3);
+  qs0 = _mm256_subs_epi8(qs0, filter1);
+  ps0 = _mm256_adds_epi8(ps0, filter2);
+
+  /* only apply wider filter if not high edge variance */
+  filter = _mm256_andnot_si256(hev, filter);
+
+  u = mbfilter_tap(filter, 27);
+  s[4] = _mm256_xor_si256(_mm256_subs_epi8(qs0, u), t80);
+  s[3] = _mm256_xor_si256(_mm256_adds_epi8(ps0, u), t80);
+
+  u = mbfilter_tap(filter, 18);
+  s[5] = _mm256_xor_si256(_mm256_subs_epi8(qs1, u), t80);
+  s[2] = _mm256_xor_si256(_mm256_adds_epi8(ps1, u), t80);
+
+  u = mbfilter_tap(filter, 9);
+  s[6] = _mm256_xor_si256(_mm256_subs_epi8(qs2, u), t80);
+  s[1] = _mm256_xor_si256(_mm256_adds_epi8(ps2, u), t80);
+}
+
+/* Transposes the 16x8 blocks held in the low 8 bytes of each lane of
+ * in[0..15] into 8 columns of 16 bytes per lane.
+ */
+static INLINE void transpose_16x8(const __m256i *in, __m256i *out) {
+  __m256i a[8], b[8], c[8];
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    a[i] = _mm256_unpacklo_epi8(in[2 * i], in[2 * i + 1]);
+  }
+  for (i = 0; i < 4; ++i) {
+    b[2 * i] = _mm256_unpacklo_epi16(a[2 * i], a[2 * i + 1]);
+    b[2 * i + 1] = _mm256_unpackhi_epi16(a[2 * i], a[2 * i + 1]);
+  }
+  for (i = 0; i < 2; ++i) {
+    c[4 * i + 0] = _mm256_unpacklo_epi32(b[4 * i + 0], b[4 * i + 2]);
+    c[4 * i + 1] = _mm256_unpackhi_epi32(b[4 * i + 0], b[4 * i + 2]);
+    c[4 * i + 2] = _mm256_unpacklo_epi32(b[4 * i + 1], b[4 * i + 3]);
+    c[4 * i + 3] = _mm256_unpackhi_epi32(b[4 * i + 1], b[4 * i + 3]);
+  }
+  for (i = 0; i < 4; ++i) {
+    out[2 * i] = _mm256_unpacklo_epi64(c[i], c[4 + i]);
+    out[2 * i + 1] = _mm256_unpackhi_epi64(c[i], c[4 + i]);
+  }
+}
+
+/* Inverse of transpose_16x8(): out[i] holds rows 2 * i and 2 * i + 1 in the
+ * low and high 8 bytes of each lane.
+ */
+static INLINE void transpose_8x16(const __m256i *in, __m256i *out) {
+  __m256i a[8], b[8];
+  int i;
+
+  for (i = 0; i < 4; ++i) {
+    a[2 * i] = _mm256_unpacklo_epi8(in[2 * i], in[2 * i + 1]);
+    a[2 * i + 1] = _mm256_unpackhi_epi8(in[2 * i], in[2 * i + 1]);
+  }
+  for (i = 0; i < 2; ++i) {
+    b[4 * i + 0] = _mm256_unpacklo_epi16(a[i], a[2 + i]);
+    b[4 * i + 1] = _mm256_unpackhi_epi16(a[i], a[2 + i]);
+    b[4 * i + 2] = _mm256_unpacklo_epi16(a[4 + i], a[6 + i]);
+    b[4 * i + 3] = _mm256_unpackhi_epi16(a[4 + i], a[6 + i]);
+  }
+  for (i = 0; i < 4; ++i) {
+    const int j = 4 * (i >> 1) + (i & 1);
+    out[2 * i] = _mm256_unpacklo_epi32(b[j], b[j + 2]);
+    out[2 * i + 1] = _mm256_unpackhi_epi32(b[j], b[j + 2]);
+  }
+}
+
+/* Transposes the 16x16 block held in each lane of in[0..15]. */
+static INLINE void transpose_16x16(const __m256i *in, __m256i *out) {
+  __m256i a[16], b[16];
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    a[2 * i] = _mm256_unpacklo_epi8(in[2 * i], in[2 * i + 1]);
+    a[2 * i + 1] = _mm256_unpackhi_epi8(in[2 * i], in[2 * i + 1]);
+  }
+  for (i = 0; i < 4; ++i) {
+    b[4 * i + 0] = _mm256_unpacklo_epi16(a[4 * i + 0], a[4 * i + 2]);
+    b[4 * i + 1] = _mm256_unpackhi_epi16(a[4 * i + 0], a[4 * i + 2]);
+    b[4 * i + 2] = _mm256_unpacklo_epi16(a[4 * i + 1], a[4 * i + 3]);
+    b[4 * i + 3] = _mm256_unpackhi_epi16(a[4 * i + 1], a[4 * i + 3]);
+  }
+  for (i = 0; i < 8; ++i) {
+    const int j = 8 * (i >> 2) + (i & 3);
+    a[2 * i] = _mm256_unpacklo_epi32(b[j], b[j + 4]);
+    a[2 * i + 1] = _mm256_unpackhi_epi32(b[j], b[j + 4]);
+  }
+  for (i = 0; i < 8; ++i) {
+    out[2 * i] = _mm256_unpacklo_epi64(a[i], a[8 + i]);
+    out[2 * i + 1] = _mm256_unpackhi_epi64(a[i], a[8 + i]);
+  }
+}
+
+/* Horizontal MB filtering */
+void vp8_loop_filter_mbh_avx2(unsigned char *y_ptr, unsigned char *u_ptr,
+                              unsigned char *v_ptr, int y_stride, int uv_stride,
+                              loop_filter_info *lfi) {
+  const int filter_uv = u_ptr != NULL;
+  __m256i s[8], mask, hev;
+  int i;
+
+  if (!filter_uv) {
+    u_ptr = v_ptr = y_ptr;
+    uv_stride = y_stride;
+  }
+
+  for (i = 0; i < 8; ++i) {
+    const int uv_offset = (i - 4) * uv_stride;
+    s[i] = load_y_uv_row(y_ptr + (i - 4) * y_stride, u_ptr + uv_offset,
+                         v_ptr + uv_offset);
+  }
+
+  filter_mask(s, _mm256_set1_epi8(lfi->mblim[0]), _mm256_set1_epi8(lfi->lim[0]),
+              _mm256_set1_epi8(lfi->hev_thr[0]), &mask, &hev);
+  mbloop_filter(s, mask, hev);
+
+  for (i = 1; i < 7; ++i) {
+    const int uv_offset = (i - 4) * uv_stride;
+    store_y_uv_row(y_ptr + (i - 4) * y_stride, u_ptr + uv_offset,
+                   v_ptr + uv_offset, s[i], filter_uv);
+  }
+}
+
+/* Horizontal B Filtering */
+void vp8_loop_filter_bh_avx2(unsigned char *y_ptr, unsigned char *u_ptr,
+                             unsigned char *v_ptr, int y_stride, int uv_stride,
+                             loop_filter_info *lfi) {
+  const int filter_uv = u_ptr != NULL;
+  const __m256i blimit = _mm256_set1_epi8(lfi->blim[0]);
+  const __m256i limit = _mm256_set1_epi8(lfi->lim[0]);
+  const __m256i thresh = _mm256_set1_epi8(lfi->hev_thr[0]);
+  __m256i s[8], mask, hev;
+  int i, edge;
+
+  if (!filter_uv) {
+    u_ptr = v_ptr = y_ptr;
+    uv_stride = y_stride;
+  }
+
+  /* The first luma edge is filtered together with the chroma edge. */
+  for (i = 0; i < 8; ++i) {
+    s[i] = load_y_uv_row(y_ptr + i * y_stride, u_ptr + i * uv_stride,
+                         v_ptr + i * uv_stride);
+  }
+  filter_mask(s, blimit, limit, thresh, &mask, &hev);
+  loop_filter(s, mask, hev);
+  for (i = 2; i < 6; ++i) {
+    store_y_uv_row(y_ptr + i * y_stride, u_ptr + i * uv_stride,
+                   v_ptr + i * uv_stride, s[i], filter_uv);
+  }
+
+  for (edge = 8; edge < 16; edge += 4) {
+    unsigned char *const y = y_ptr + (edge - 4) * y_stride;
+
+    for (i = 0; i < 8; ++i) {
+      s[i] = _mm256_broadcastsi128_si256(
+          _mm_loadu_si128((const __m128i *)(y + i * y_stride)));
+    }
+    filter_mask(s, blimit, limit, thresh, &mask, &hev);
+    loop_filter(s, mask, hev);
+    for (i = 2; i < 6; ++i) {
+      _mm_storeu_si128((__m128i *)(y + i * y_stride),
+                       _mm256_castsi256_si128(s[i]));
+    }
+  }
+}
+
+/* Vertical MB Filtering */
+void vp8_loop_filter_mbv_avx2(unsigned char *y_ptr, unsigned char *u_ptr,
+                              unsigned char *v_ptr, int y_stride, int uv_stride,
+                              loop_filter_info *lfi) {
+  const int filter_uv = u_ptr != NULL;
+  __m256i rows[16], s[8], mask, hev;
+  int i;
+
+  if (!filter_uv) {
+    u_ptr = v_ptr = y_ptr;
+    uv_stride = y_stride;
+  }
+
+  for (i = 0; i < 8; ++i) {
+    rows[i] = load_2x8(y_ptr + i * y_stride - 4, u_ptr + i * uv_stride - 4);
+    rows[8 + i] =
+        load_2x8(y_ptr + (8 + i) * y_stride - 4, v_ptr + i * uv_stride - 4);
+  }
+  transpose_16x8(rows, s);
+
+  filter_mask(s, _mm256_set1_epi8(lfi->mblim[0]), _mm256_set1_epi8(lfi->lim[0]),
+              _mm256_set1_epi8(lfi->hev_thr[0]), &mask, &hev);
+  mbloop_filter(s, mask, hev);
+
+  transpose_8x16(s, rows);
+  for (i = 0; i < 8; ++i) {
+    const __m128i y = _mm256_castsi256_si128(rows[i]);
+    _mm_storel_epi64((__m128i *)(y_ptr + 2 * i * y_stride - 4), y);
+    _mm_storeh_epi64((__m128i *)(y_ptr + (2 * i + 1) * y_stride - 4), y);
+  }
+  if (filter_uv) {
+    for (i = 0; i < 8; ++i) {
+      const __m128i uv = _mm256_extracti128_si256(rows[i], 1);
+      unsigned char *const dst = i < 4 ? u_ptr + 2 * i * uv_stride
+                                       : v_ptr + (2 * i - 8) * uv_stride;
+      _mm_storel_epi64((__m128i *)(dst - 4), uv);
+      _mm_storeh_epi64((__m128i *)(dst + uv_stride - 4), uv);
+    }
+  }
+}
+
+/* Vertical B Filtering */
+void vp8_loop_filter_bv_avx2(unsigned char *y_ptr, unsigned char *u_ptr,
+                             unsigned char *v_ptr, int y_stride, int uv_stride,
+                             loop_filter_info *lfi) {
+  const int filter_uv = u_ptr != NULL;
+  const __m256i blimit = _mm256_set1_epi8(lfi->blim[0]);
+  const __m256i limit = _mm256_set1_epi8(lfi->lim[0]);
+  const __m256i thresh = _mm256_set1_epi8(lfi->hev_thr[0]);
+  __m256i rows[16], cols[16], mask, hev, uv_p1, uv_p0;
+  int i;
+
+  if (!filter_uv) {
+    u_ptr = v_ptr = y_ptr;
+    uv_stride = y_stride;
+  }
+
+  /* Only the low 8 bytes of each chroma row are needed. */
+  for (i = 0; i < 8; ++i) {
+    rows[i] = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128((const __m128i *)(y_ptr + i * y_stride))),
+        _mm_loadl_epi64((const __m128i *)(u_ptr + i * uv_stride)), 1);
+    rows[8 + i] = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128((const __m128i *)(y_ptr + (8 + i) * y_stride))),
+        _mm_loadl_epi64((const __m128i *)(v_ptr + i * uv_stride)), 1);
+  }
+  transpose_16x16(rows, cols);
+
+  /* Column 4 of luma and chroma. */
+  filter_mask(cols, blimit, limit, thresh, &mask, &hev);
+  loop_filter(cols, mask, hev);
+  uv_p1 = cols[6];
+  uv_p0 = cols[7];
+
+  /* Columns 8 and 12 of luma. The second pass also touches columns 6 and 7
+   * of the chroma lane, which are restored afterwards.
+   */
+  filter_mask(cols + 4, blimit, limit, thresh, &mask, &hev);
+  loop_filter(cols + 4, mask, hev);
+  cols[6] = _mm256_blend_epi32(cols[6], uv_p1, 0xf0);
+  cols[7] = _mm256_blend_epi32(cols[7], uv_p0, 0xf0);
+
+  filter_mask(cols + 8, blimit, limit, thresh, &mask, &hev);
+  loop_filter(cols + 8, mask, hev);
+
+  transpose_16x16(cols, rows);
+  for (i = 0; i < 8; ++i) {
+    _mm_storeu_si128((__m128i *)(y_ptr + i * y_stride),
+                     _mm256_castsi256_si128(rows[i]));
+    _mm_storeu_si128((__m128i *)(y_ptr + (8 + i) * y_stride),
+                     _mm256_castsi256_si128(rows[8 + i]));
+  }
+  if (filter_uv) {
+    for (i = 0; i < 8; ++i) {
+      _mm_storel_epi64((__m128i *)(u_ptr + i * uv_stride),
+                       _mm256_extracti128_si256(rows[i], 1));
+      _mm_storel_epi64((__m128i *)(v_ptr + i * uv_stride),
+                       _mm256_extracti128_si256(rows[8 + i], 1));
+    }
+  }
+}
@@ -0,0 +1,268 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vp8_rtcd.h"
+#include "./vpx_config.h"
+#include "vp8/common/filter.h"
+#include "vpx_ports/mem.h"
+
+/* The six taps are applied as three pairs, (0, 3), (1, 4) and (2, 5), with
+ * _mm256_maddubs_epi16(). Taps 1 and 4 are never positive and the other taps
+ * never negative, so adding the (1, 4) product to one of the others first
+ * cannot overflow, and saturating the final sum matches the clamp to 255 in
+ * the C code. Two rows are filtered at once, one in each 128-bit lane.
+ */
+
+/* Pairs pixel i with pixel i + 3 for the 8 outputs of a 16 byte load
+ * starting 2 pixels to the left of the first output.
+ */
+DECLARE_ALIGNED(32, static const uint8_t, filt_pairs[3][32]) = {
+  { 0, 3, 1, 4, 2, 5, 3, 6, 4, 7, 5, 8, 6, 9, 7, 10,
+    0, 3, 1, 4, 2, 5, 3, 6, 4, 7, 5, 8, 6, 9, 7, 10 },
+  { 1, 4, 2, 5, 3, 6, 4, 7, 5, 8, 6, 9, 7, 10, 8, 11,
+    1, 4, 2, 5, 3, 6, 4, 7, 5, 8, 6, 9, 7, 10, 8, 11 },
+  { 2, 5, 3, 6, 4, 7, 5, 8, 6, 9, 7, 10, 8, 11, 9, 12,
+    2, 5, 3, 6, 4, 7, 5, 8, 6, 9, 7, 10, 8, 11, 9, 12 }
+};
+
+static INLINE void load_taps(int offset, __m256i *k) {
+  const short *const f = vp8_sub_pel_filters[offset];
+  int i;
+
+  for (i = 0; i < 3; ++i) {
+    k[i] = _mm256_set1_epi16((short)((f[i + 3] * 256) | (f[i] & 0xff)));
+  }
+}
+
+static INLINE __m256i load_2x16(const uint8_t *a, const uint8_t *b) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)a)),
+      _mm_loadu_si128((const __m128i *)b), 1);
+}
+
+static INLINE __m256i load_2x8(const uint8_t *a, const uint8_t *b) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *)a)),
+      _mm_loadl_epi64((const __m128i *)b), 1);
+}
+
+static INLINE void store_2x16(uint8_t *a, uint8_t *b, const __m256i x) {
+  _mm_storeu_si128((__m128i *)a, _mm256_castsi256_si128(x));
+  _mm_storeu_si128((__m128i *)b, _mm256_extracti128_si256(x, 1));
+}
+
+static INLINE void store_2x8(uint8_t *a, uint8_t *b, const __m256i x) {
+  _mm_storel_epi64((__m128i *)a, _mm256_castsi256_si128(x));
+  _mm_storel_epi64((__m128i *)b, _mm256_extracti128_si256(x, 1));
+}
+
+/* Returns (s03 * k[0] + s14 * k[1] + s25 * k[2] + 64) >> 7. */
+static INLINE __m256i filter_sum(const __m256i s03, const __m256i s14,
+                                 const __m256i s25, const __m256i *k) {
+  const __m256i sum = _mm256_add_epi16(_mm256_maddubs_epi16(s14, k[1]),
+                                       _mm256_maddubs_epi16(s25, k[2]));
+  return _mm256_mulhrs_epi16(
+      _mm256_adds_epi16(sum, _mm256_maddubs_epi16(s03, k[0])),
+      _mm256_set1_epi16(1 << (15 - VP8_FILTER_SHIFT)));
+}
+
+/* Filters the 8 pixels of each lane of s, loaded from 2 pixels to the left. */
+static INLINE __m256i filter_h8(const __m256i s, const __m256i *k) {
+  return filter_sum(
+      _mm256_shuffle_epi8(s, _mm256_load_si256((const __m256i *)filt_pairs[0])),
+      _mm256_shuffle_epi8(s, _mm256_load_si256((const __m256i *)filt_pairs[1])),
+      _mm256_shuffle_epi8(s, _mm256_load_si256((const __m256i *)filt_pairs[2])),
+      k);
+}
+
+static void filter_block1d16_h6(const uint8_t *src, int src_stride,
+                                uint8_t *dst, int dst_stride, int height,
+                                int xoffset) {
+  __m256i k[3];
+  int h;
+
+  load_taps(xoffset, k);
+
+  for (h = 0; h < height; h += 2) {
+    /* An odd last row is filtered in both lanes. */
+    const int next = h + 1 < height ? src_stride : 0;
+    const __m256i lo = filter_h8(load_2x16(src - 2, src + next - 2), k);
+    const __m256i hi = filter_h8(load_2x16(src + 6, src + next + 6), k);
+    const __m256i d = _mm256_packus_epi16(lo, hi);
+
+    _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(d));
+    if (next) {
+      _mm_storeu_si128((__m128i *)(dst + dst_stride),
+                       _mm256_extracti128_si256(d, 1));
+    }
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
+
+static void filter_block1d8_h6(const uint8_t *src, int src_stride, uint8_t *dst,
+                               int dst_stride, int height, int xoffset) {
+  __m256i k[3];
+  int h;
+
+  load_taps(xoffset, k);
+
+  for (h = 0; h < height; h += 2) {
+    const int next = h + 1 < height ? src_stride : 0;
+    const __m256i s = filter_h8(load_2x16(src - 2, src + next - 2), k);
+    const __m256i d = _mm256_packus_epi16(s, s);
+
+    _mm_storel_epi64((__m128i *)dst, _mm256_castsi256_si128(d));
+    if (next) {
+      _mm_storel_epi64((__m128i *)(dst + dst_stride),
+                       _mm256_extracti128_si256(d, 1));
+    }
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
+
+/* src points 2 rows above the first output row. r[i] holds rows i and i + 1
+ * relative to the pair of output rows being filtered.
+ */
+static void filter_block1d16_v6(const uint8_t *src, int src_stride,
+                                uint8_t *dst, int dst_stride, int height,
+                                int yoffset) {
+  __m256i k[3], r[6];
+  int h, i;
+
+  load_taps(yoffset, k);
+
+  for (i = 0; i < 4; ++i) {
+    r[i] = load_2x16(src + i * src_stride, src + (i + 1) * src_stride);
+  }
+  src += 4 * src_stride;
+
+  for (h = 0; h < height; h += 2) {
+    __m256i lo, hi;
+
+    r[4] = load_2x16(src, src + src_stride);
+    r[5] = load_2x16(src + src_stride, src + 2 * src_stride);
+
+    lo = filter_sum(_mm256_unpacklo_epi8(r[0], r[3]),
+                    _mm256_unpacklo_epi8(r[1], r[4]),
+                    _mm256_unpacklo_epi8(r[2], r[5]), k);
+    hi = filter_sum(_mm256_unpackhi_epi8(r[0], r[3]),
+                    _mm256_unpackhi_epi8(r[1], r[4]),
+                    _mm256_unpackhi_epi8(r[2], r[5]), k);
+    store_2x16(dst, dst + dst_stride, _mm256_packus_epi16(lo, hi));
+
+    for (i = 0; i < 4; ++i) r[i] = r[i + 2];
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
+
+static void filter_block1d8_v6(const uint8_t *src, int src_stride, uint8_t *dst,
+                               int dst_stride, int height, int yoffset) {
+  __m256i k[3], r[6];
+  int h, i;
+
+  load_taps(yoffset, k);
+
+  for (i = 0; i < 4; ++i) {
+    r[i] = load_2x8(src + i * src_stride, src + (i + 1) * src_stride);
+  }
+  src += 4 * src_stride;
+
+  for (h = 0; h < height; h += 2) {
+    __m256i s;
+
+    r[4] = load_2x8(src, src + src_stride);
+    r[5] = load_2x8(src + src_stride, src + 2 * src_stride);
+
+    s = filter_sum(_mm256_unpacklo_epi8(r[0], r[3]),
+                   _mm256_unpacklo_epi8(r[1], r[4]),
+                   _mm256_unpacklo_epi8(r[2], r[5]), k);
+    store_2x8(dst, dst + dst_stride, _mm256_packus_epi16(s, s));
+
+    for (i = 0; i < 4; ++i) r[i] = r[i + 2];
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
+
+void vp8_sixtap_predict16x16_avx2(unsigned char *src_ptr,
+                                  int src_pixels_per_line, int xoffset,
+                                  int yoffset, unsigned char *dst_ptr,
+                                  int dst_pitch) {
+  DECLARE_ALIGNED(32, unsigned char, FData2[16 * 21]);
+
+  if (xoffset) {
+    if (yoffset) {
+      filter_block1d16_h6(src_ptr - (2 * src_pixels_per_line),
+                          src_pixels_per_line, FData2, 16, 21, xoffset);
+      filter_block1d16_v6(FData2, 16, dst_ptr, dst_pitch, 16, yoffset);
+    } else {
+      /* First-pass only */
+      filter_block1d16_h6(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch, 16,
+                          xoffset);
+    }
+  } else {
+    if (yoffset) {
+      /* Second-pass only */
+      filter_block1d16_v6(src_ptr - (2 * src_pixels_per_line),
+                          src_pixels_per_line, dst_ptr, dst_pitch, 16, yoffset);
+    } else {
+      vp8_copy_mem16x16(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch);
+    }
+  }
+}
+
+static void sixtap_predict8xh(unsigned char *src_ptr, int src_pixels_per_line,
+                              int xoffset, int yoffset, unsigned char *dst_ptr,
+                              int dst_pitch, int height) {
+  DECLARE_ALIGNED(32, unsigned char, FData2[8 * 13]);
+
+  if (xoffset) {
+    if (yoffset) {
+      filter_block1d8_h6(src_ptr - (2 * src_pixels_per_line),
+                         src_pixels_per_line, FData2, 8, height + 5, xoffset);
+      filter_block1d8_v6(FData2, 8, dst_ptr, dst_pitch, height, yoffset);
+    } else {
+      /* First-pass only */
+      filter_block1d8_h6(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch,
+                         height, xoffset);
+    }
+  } else {
+    /* Second-pass only */
+    filter_block1d8_v6(src_ptr - (2 * src_pixels_per_line), src_pixels_per_line,
+                       dst_ptr, dst_pitch, height, yoffset);
+  }
+}
+
+void vp8_sixtap_predict8x8_avx2(unsigned char *src_ptr, int src_pixels_per_line,
+                                int xoffset, int yoffset,
+                                unsigned char *dst_ptr, int dst_pitch) {
+  if (xoffset | yoffset) {
+    sixtap_predict8xh(src_ptr, src_pixels_per_line, xoffset, yoffset, dst_ptr,
+                      dst_pitch, 8);
+  } else {
+    vp8_copy_mem8x8(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch);
+  }
+}
+
+void vp8_sixtap_predict8x4_avx2(unsigned char *src_ptr, int src_pixels_per_line,
+                                int xoffset, int yoffset,
+                                unsigned char *dst_ptr, int dst_pitch) {
+  if (xoffset | yoffset) {
+    sixtap_predict8xh(src_ptr, src_pixels_per_line, xoffset, yoffset, dst_ptr,
+                      dst_pitch, 4);
+  } else {
+    vp8_copy_mem8x4(src_ptr, src_pixels_per_line, dst_ptr, dst_pitch);
+  }
+}
@@ -804,13 +804,24 @@ static void setup_token_decoder(VP8D_COMP *pbi,
   }
 
 #if CONFIG_MULTITHREAD
-  /* Clamp number of decoder threads */
-  if (pbi->decoding_thread_count > num_token_partitions - 1) {
-    pbi->decoding_thread_count = num_token_partitions - 1;
-  }
-  if ((int)pbi->decoding_thread_count > pbi->common.mb_rows - 1) {
-    assert(pbi->common.mb_rows > 0);
-    pbi->decoding_thread_count = pbi->common.mb_rows - 1;
+  /* Clamp number of decoder threads. With a single token partition the main
+   * thread decodes the tokens ahead and the decoding threads share the rows,
+   * unless error concealment needs the tokens and the reconstruction of each
+   * macroblock to be interleaved. */
+  pbi->decoding_thread_count = pbi->allocated_decoding_thread_count;
+  pbi->mt_tokens_ahead = (num_token_partitions == 1 && !pbi->ec_active);
+  if (pbi->mt_tokens_ahead) {
+    if ((int)pbi->decoding_thread_count > pbi->common.mb_rows) {
+      pbi->decoding_thread_count = pbi->common.mb_rows;
+    }
+  } else {
+    if (pbi->decoding_thread_count > num_token_partitions - 1) {
+      pbi->decoding_thread_count = num_token_partitions - 1;
+    }
+    if ((int)pbi->decoding_thread_count > pbi->common.mb_rows - 1) {
+      assert(pbi->common.mb_rows > 0);
+      pbi->decoding_thread_count = pbi->common.mb_rows - 1;
+    }
   }
 #endif
 }
@@ -1216,7 +1227,7 @@ int vp8_decode_frame(VP8D_COMP *pbi) {
 
 #if CONFIG_MULTITHREAD
   if (vpx_atomic_load_acquire(&pbi->b_multithreaded_rd) &&
-      pc->multi_token_partition != ONE_PARTITION) {
+      pbi->decoding_thread_count > 0) {
     unsigned int thread;
     if (vp8mt_decode_mb_rows(pbi, xd)) {
       vp8_decoder_remove_threads(pbi);
@@ -1224,6 +1235,7 @@ int vp8_decode_frame(VP8D_COMP *pbi) {
       vpx_internal_error(&pbi->common.error, VPX_CODEC_CORRUPT_FRAME, NULL);
     }
     vp8_yv12_extend_frame_borders(yv12_fb_new);
+    corrupt_tokens |= xd->corrupted;
     for (thread = 0; thread < pbi->decoding_thread_count; ++thread) {
       corrupt_tokens |= pbi->mb_row_di[thread].mbd.corrupted;
     }
@@ -35,6 +35,12 @@ typedef struct {
   MACROBLOCKD mbd;
 } MB_ROW_DEC;
 
+/* Tokens of one macroblock, decoded ahead of its reconstruction. */
+typedef struct {
+  DECLARE_ALIGNED(16, short, qcoeff[400]);
+  char eobs[25];
+} MB_TOKENS;
+
 typedef struct {
   int enabled;
   unsigned int count;
@@ -81,6 +87,16 @@ typedef struct VP8D_COMP {
   /* Each row remembers its already decoded column. */
   vpx_atomic_int *mt_current_mb_col;
 
+  /* Set for frames with a single token partition. The main thread then
+   * decodes the tokens ahead of the decoding threads, which reconstruct and
+   * loop filter the macroblock rows. */
+  int mt_tokens_ahead;
+  /* Number of macroblocks of the frame whose tokens have been decoded. */
+  vpx_atomic_int mt_token_mb_count;
+  /* Ring buffer holding the tokens of mt_token_rows macroblock rows. */
+  MB_TOKENS *mt_tokens;
+  int mt_token_rows;
+
   unsigned char **mt_yabove_row; /* mb_rows x width */
   unsigned char **mt_uabove_row;
   unsigned char **mt_vabove_row;
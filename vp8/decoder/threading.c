@@ -77,10 +77,45 @@ static void setup_decoding_thread_data(VP8D_COMP *pbi, MACROBLOCKD *xd,
     mbd->fullpixel_mask = 0xffffffff;
 
     if (pc->full_pixel) mbd->fullpixel_mask = 0xfffffff8;
+
+    mbd->corrupted = 0;
   }
 
   for (i = 0; i < pc->mb_rows; ++i)
     vpx_atomic_store_release(&pbi->mt_current_mb_col[i], -1);
+
+  vpx_atomic_store_release(&pbi->mt_token_mb_count, 0);
+}
+
+/* Moves the tokens of the macroblock out of xd, leaving its coefficients
+ * zeroed for the next macroblock.
+ */
+static void mt_store_mb_tokens(MACROBLOCKD *xd, MB_TOKENS *tokens) {
+  int i;
+
+  memcpy(tokens->eobs, xd->eobs, sizeof(tokens->eobs));
+  for (i = 0; i < 25; ++i) {
+    if (xd->eobs[i]) {
+      memcpy(tokens->qcoeff + 16 * i, xd->qcoeff + 16 * i,
+             16 * sizeof(xd->qcoeff[0]));
+      memset(xd->qcoeff + 16 * i, 0, 16 * sizeof(xd->qcoeff[0]));
+    }
+  }
+}
+
+/* Loads the tokens of the macroblock into xd, whose coefficients were left
+ * zeroed by the reconstruction of the previous macroblock.
+ */
+static void mt_load_mb_tokens(MACROBLOCKD *xd, const MB_TOKENS *tokens) {
+  int i;
+
+  memcpy(xd->eobs, tokens->eobs, sizeof(xd->eobs));
+  for (i = 0; i < 25; ++i) {
+    if (tokens->eobs[i]) {
+      memcpy(xd->qcoeff + 16 * i, tokens->qcoeff + 16 * i,
+             16 * sizeof(xd->qcoeff[0]));
+    }
+  }
 }
 
 static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
@@ -93,14 +128,17 @@ static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
   (void)mb_idx;
 #endif
 
-  if (xd->mode_info_context->mbmi.mb_skip_coeff) {
-    vp8_reset_mb_tokens_context(xd);
-  } else if (!vp8dx_bool_error(xd->current_bc)) {
-    int eobtotal;
-    eobtotal = vp8_decode_mb_tokens(pbi, xd);
+  /* The tokens were loaded into xd if they were decoded ahead. */
+  if (!pbi->mt_tokens_ahead) {
+    if (xd->mode_info_context->mbmi.mb_skip_coeff) {
+      vp8_reset_mb_tokens_context(xd);
+    } else if (!vp8dx_bool_error(xd->current_bc)) {
+      int eobtotal;
+      eobtotal = vp8_decode_mb_tokens(pbi, xd);
 
-    /* Special case:  Force the loopfilter to skip when eobtotal is zero */
-    xd->mode_info_context->mbmi.mb_skip_coeff = (eobtotal == 0);
+      /* Special case:  Force the loopfilter to skip when eobtotal is zero */
+      xd->mode_info_context->mbmi.mb_skip_coeff = (eobtotal == 0);
+    }
   }
 
   mode = xd->mode_info_context->mbmi.mode;
@@ -257,6 +295,9 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
       VPX_ATOMIC_INIT(pc->mb_cols + nsync);
   int num_part = 1 << pbi->common.multi_token_partition;
   int last_mb_row = start_mb_row;
+  /* The main thread reconstructs rows too unless it decodes tokens ahead. */
+  const int row_step =
+      (int)pbi->decoding_thread_count + (pbi->mt_tokens_ahead ? 0 : 1);
 
   YV12_BUFFER_CONFIG *yv12_fb_new = pbi->dec_fb_ref[INTRA_FRAME];
   YV12_BUFFER_CONFIG *yv12_fb_lst = pbi->dec_fb_ref[LAST_FRAME];
@@ -290,8 +331,7 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
   xd->mode_info_context = pc->mi + pc->mode_info_stride * start_mb_row;
   xd->mode_info_stride = pc->mode_info_stride;
 
-  for (mb_row = start_mb_row; mb_row < pc->mb_rows;
-       mb_row += (pbi->decoding_thread_count + 1)) {
+  for (mb_row = start_mb_row; mb_row < pc->mb_rows; mb_row += row_step) {
     int recon_yoffset, recon_uvoffset;
     int mb_col;
     int filter_level;
@@ -373,12 +413,11 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
       xd->mb_to_right_edge = ((pc->mb_cols - 1 - mb_col) * 16) << 3;
 
 #if CONFIG_ERROR_CONCEALMENT
-      {
+      if (pbi->ec_active) {
         int corrupt_residual =
             (!pbi->independent_partitions && pbi->frame_corrupt_residual) ||
             vp8dx_bool_error(xd->current_bc);
-        if (pbi->ec_active &&
-            (xd->mode_info_context->mbmi.ref_frame == INTRA_FRAME) &&
+        if ((xd->mode_info_context->mbmi.ref_frame == INTRA_FRAME) &&
             corrupt_residual) {
           /* We have an intra block with corrupt
            * coefficients, better to conceal with an inter
@@ -406,8 +445,7 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
       if (xd->corrupted) {
         // Move current decoding marcoblock to the end of row for all rows
         // assigned to this thread, such that other threads won't be waiting.
-        for (; mb_row < pc->mb_rows;
-             mb_row += (pbi->decoding_thread_count + 1)) {
+        for (; mb_row < pc->mb_rows; mb_row += row_step) {
           current_mb_col = &pbi->mt_current_mb_col[mb_row];
           vpx_atomic_store_release(current_mb_col, pc->mb_cols + nsync);
         }
@@ -426,12 +464,22 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
         xd->pre.u_buffer = 0;
         xd->pre.v_buffer = 0;
       }
+
+      if (pbi->mt_tokens_ahead) {
+        const int mb_idx = mb_row * pc->mb_cols + mb_col;
+        vp8_atomic_spin_wait(mb_idx, &pbi->mt_token_mb_count, 1);
+        mt_load_mb_tokens(
+            xd, &pbi->mt_tokens[(mb_row % pbi->mt_token_rows) * pc->mb_cols +
+                                mb_col]);
+      }
       mt_decode_macroblock(pbi, xd, 0);
 
       xd->left_available = 1;
 
       /* check if the boolean decoder has suffered an error */
-      xd->corrupted |= vp8dx_bool_error(xd->current_bc);
+      if (!pbi->mt_tokens_ahead) {
+        xd->corrupted |= vp8dx_bool_error(xd->current_bc);
+      }
 
       xd->recon_above[0] += 16;
       xd->recon_above[1] += 8;
@@ -570,14 +618,69 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
     xd->up_available = 1;
 
     /* since we have multithread */
-    xd->mode_info_context += xd->mode_info_stride * pbi->decoding_thread_count;
+    xd->mode_info_context += xd->mode_info_stride * (row_step - 1);
   }
 
   /* signal end of decoding of current thread for current frame */
-  if (last_mb_row + (int)pbi->decoding_thread_count + 1 >= pc->mb_rows)
+  if (last_mb_row + row_step >= pc->mb_rows)
     sem_post(&pbi->h_event_end_decoding);
 }
 
+/* Decodes the tokens of the frame in raster order, ahead of the decoding
+ * threads. The tokens of a row are stored into the ring buffer once the row
+ * they replace has been reconstructed.
+ */
+static void mt_decode_mb_tokens(VP8D_COMP *pbi, MACROBLOCKD *xd) {
+  VP8_COMMON *const pc = &pbi->common;
+  const int nsync = pbi->sync_range;
+  int mb_row, mb_col;
+  int mb_idx = 0;
+
+  xd->mode_info_context = pc->mi;
+  xd->current_bc = &pbi->mbc[0];
+
+  for (mb_row = 0; mb_row < pc->mb_rows; ++mb_row) {
+    MB_TOKENS *tokens =
+        &pbi->mt_tokens[(mb_row % pbi->mt_token_rows) * pc->mb_cols];
+
+    if (mb_row >= pbi->mt_token_rows) {
+      vp8_atomic_spin_wait(
+          pc->mb_cols, &pbi->mt_current_mb_col[mb_row - pbi->mt_token_rows],
+          nsync);
+    }
+
+    /* reset contexts */
+    xd->above_context = pc->above_context;
+    memset(xd->left_context, 0, sizeof(ENTROPY_CONTEXT_PLANES));
+
+    for (mb_col = 0; mb_col < pc->mb_cols; ++mb_col) {
+      MB_MODE_INFO *const mbmi = &xd->mode_info_context->mbmi;
+
+      if (mbmi->mb_skip_coeff) {
+        vp8_reset_mb_tokens_context(xd);
+        memset(xd->eobs, 0, 25);
+      } else if (!vp8dx_bool_error(xd->current_bc)) {
+        /* Special case:  Force the loopfilter to skip when eobtotal is zero */
+        mbmi->mb_skip_coeff = (vp8_decode_mb_tokens(pbi, xd) == 0);
+      } else {
+        memset(xd->eobs, 0, 25);
+      }
+
+      mt_store_mb_tokens(xd, &tokens[mb_col]);
+
+      /* check if the boolean decoder has suffered an error */
+      xd->corrupted |= vp8dx_bool_error(xd->current_bc);
+
+      vpx_atomic_store_release(&pbi->mt_token_mb_count, ++mb_idx);
+
+      ++xd->mode_info_context; /* next mb */
+      ++xd->above_context;
+    }
+
+    ++xd->mode_info_context; /* skip prediction column */
+  }
+}
+
 static THREAD_FUNCTION thread_decoding_proc(void *p_data) {
   int ithread = ((DECODETHREAD_DATA *)p_data)->ithread;
   VP8D_COMP *pbi = (VP8D_COMP *)(((DECODETHREAD_DATA *)p_data)->ptr1);
@@ -600,7 +703,8 @@ static THREAD_FUNCTION thread_decoding_proc(void *p_data) {
           continue;
         }
         xd->error_info.setjmp = 1;
-        mt_decode_mb_rows(pbi, xd, ithread + 1);
+        mt_decode_mb_rows(pbi, xd,
+                          pbi->mt_tokens_ahead ? ithread : ithread + 1);
       }
     }
   }
@@ -673,6 +777,9 @@ void vp8mt_de_alloc_temp_buffers(VP8D_COMP *pbi, int mb_rows) {
   vpx_free(pbi->mt_current_mb_col);
   pbi->mt_current_mb_col = NULL;
 
+  vpx_free(pbi->mt_tokens);
+  pbi->mt_tokens = NULL;
+
   /* Free above_row buffers. */
   if (pbi->mt_yabove_row) {
     for (i = 0; i < mb_rows; ++i) {
@@ -759,6 +866,11 @@ void vp8mt_alloc_temp_buffers(VP8D_COMP *pbi, int width, int prev_mb_rows) {
     for (i = 0; i < pc->mb_rows; ++i)
       vpx_atomic_init(&pbi->mt_current_mb_col[i], 0);
 
+    /* Allocate the tokens decoded ahead, enough for two rows per thread. */
+    pbi->mt_token_rows = 2 * (pbi->allocated_decoding_thread_count + 1);
+    if (pbi->mt_token_rows > pc->mb_rows) pbi->mt_token_rows = pc->mb_rows;
+    CALLOC_ARRAY_ALIGNED(pbi->mt_tokens, pbi->mt_token_rows * pc->mb_cols, 16);
+
     /* Allocate memory for above_row buffers. */
     CALLOC_ARRAY(pbi->mt_yabove_row, pc->mb_rows);
     for (i = 0; i < pc->mb_rows; ++i) {
@@ -887,6 +999,9 @@ int vp8mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd) {
   if (setjmp(xd->error_info.jmp)) {
     xd->error_info.setjmp = 0;
     xd->corrupted = 1;
+    // Release the threads waiting for tokens that will not be decoded.
+    vpx_atomic_store_release(&pbi->mt_token_mb_count,
+                             pc->mb_rows * pc->mb_cols);
     // Wait for other threads to finish. This prevents other threads decoding
     // the current frame while the main thread starts decoding the next frame,
     // which causes a data race.
@@ -896,9 +1011,14 @@ int vp8mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd) {
   }
 
   xd->error_info.setjmp = 1;
-  mt_decode_mb_rows(pbi, xd, 0);
+  if (pbi->mt_tokens_ahead) {
+    mt_decode_mb_tokens(pbi, xd);
+  } else {
+    mt_decode_mb_rows(pbi, xd, 0);
+    sem_wait(&pbi->h_event_end_decoding);
+  }
 
-  for (i = 0; i < pbi->decoding_thread_count + 1; ++i)
+  for (i = 0; i < pbi->decoding_thread_count; ++i)
     sem_wait(&pbi->h_event_end_decoding); /* add back for each frame */
 
   return 0;
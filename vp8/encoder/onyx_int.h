@@ -541,6 +541,17 @@ typedef struct VP8_COMP {
   sem_t *h_event_end_encoding;
   sem_t h_event_start_lpf;
   sem_t h_event_end_lpf;
+
+  /* Set when the threads run on an application owned thread pool. The
+   * encoding and loop filter jobs then replace the threads and events
+   * above. */
+  struct VPxThreadPool *thread_pool;
+  VPxWorker *h_encoding_worker;
+  VPxWorker h_filter_worker;
+  VP8RowScheduler mt_rows;
+  /* Totals of the rows coded with the main thread's macroblock state. */
+  int *mt_segment_counts;
+  int *mt_totalrate;
 #endif
 
   TOKENLIST *tplist;
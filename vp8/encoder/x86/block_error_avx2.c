@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h> /* AVX2 */
+
+#include "./vp8_rtcd.h"
+#include "vp8/encoder/block.h"
+
+/* Each register holds the 16 coefficients of one block. */
+
+/* Returns the sum of squared differences of one block, as 32 bit partial
+ * sums. */
+static INLINE __m256i block_sse(const short *coeff, const short *dqcoeff,
+                                const __m256i mask) {
+  const __m256i c = _mm256_loadu_si256((const __m256i *)coeff);
+  const __m256i d = _mm256_loadu_si256((const __m256i *)dqcoeff);
+  const __m256i diff = _mm256_and_si256(_mm256_sub_epi16(c, d), mask);
+  return _mm256_madd_epi16(diff, diff);
+}
+
+static INLINE int hsum_epi32(const __m256i x) {
+  const __m128i a = _mm_add_epi32(_mm256_castsi256_si128(x),
+                                  _mm256_extracti128_si256(x, 1));
+  const __m128i b = _mm_add_epi32(a, _mm_srli_si128(a, 8));
+  return _mm_cvtsi128_si32(_mm_add_epi32(b, _mm_srli_si128(b, 4)));
+}
+
+/* coeff and dqcoeff of the n blocks starting at coeff and dqcoeff are
+ * contiguous. */
+static INLINE int blocks_error(const short *coeff, const short *dqcoeff,
+                               int n, const __m256i mask) {
+  __m256i sum = _mm256_setzero_si256();
+  int i;
+
+  for (i = 0; i < n; ++i) {
+    sum = _mm256_add_epi32(sum, block_sse(coeff, dqcoeff, mask));
+    coeff += 16;
+    dqcoeff += 16;
+  }
+
+  return hsum_epi32(sum);
+}
+
+int vp8_block_error_avx2(short *coeff, short *dqcoeff) {
+  return hsum_epi32(block_sse(coeff, dqcoeff, _mm256_set1_epi16(-1)));
+}
+
+int vp8_mbblock_error_avx2(MACROBLOCK *mb, int dc) {
+  /* Skip the first coefficient of each block when dc is set. */
+  const __m256i mask = _mm256_setr_epi16(dc ? 0 : -1, -1, -1, -1, -1, -1, -1,
+                                         -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  return blocks_error(mb->block[0].coeff, mb->e_mbd.block[0].dqcoeff, 16,
+                      mask);
+}
+
+int vp8_mbuverror_avx2(MACROBLOCK *mb) {
+  return blocks_error(&mb->coeff[256], &mb->e_mbd.dqcoeff[256], 8,
+                      _mm256_set1_epi16(-1));
+}
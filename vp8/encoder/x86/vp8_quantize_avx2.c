@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h> /* AVX2 */
+
+#include "./vp8_rtcd.h"
+#include "vp8/encoder/block.h"
+#include "vpx_ports/bitops.h"
+#include "vpx_ports/mem.h"
+
+/* All 16 coefficients of the block fit in one register. */
+
+DECLARE_ALIGNED(16, static const uint8_t,
+                zig_zag_mask[16]) = { 0, 1,  4,  8,  5, 2,  3,  6,
+                                      9, 12, 13, 10, 7, 11, 14, 15 };
+
+/* Returns a mask with bit i set if the 16 bit lane of cmp at position i of
+ * the zig zag scan is set. */
+static INLINE int zig_zag_movemask(const __m256i cmp) {
+  const __m256i packed =
+      _mm256_permute4x64_epi64(_mm256_packs_epi16(cmp, cmp), 0x08);
+  const __m128i scan =
+      _mm_shuffle_epi8(_mm256_castsi256_si128(packed),
+                       _mm_load_si128((const __m128i *)zig_zag_mask));
+  return _mm_movemask_epi8(scan);
+}
+
+void vp8_fast_quantize_b_avx2(BLOCK *b, BLOCKD *d) {
+  const __m256i z = _mm256_loadu_si256((const __m256i *)b->coeff);
+  const __m256i round = _mm256_loadu_si256((const __m256i *)b->round);
+  const __m256i quant_fast =
+      _mm256_loadu_si256((const __m256i *)b->quant_fast);
+  const __m256i dequant = _mm256_loadu_si256((const __m256i *)d->dequant);
+  const __m256i sz = _mm256_srai_epi16(z, 15);
+  __m256i x, y;
+  int mask;
+
+  /* y = ((abs(z) + round) * quant) >> 16 */
+  x = _mm256_add_epi16(_mm256_abs_epi16(z), round);
+  y = _mm256_mulhi_epi16(x, quant_fast);
+
+  mask = zig_zag_movemask(_mm256_cmpgt_epi16(y, _mm256_setzero_si256()));
+
+  /* qcoeff = (y ^ sz) - sz. Unlike _mm256_sign_epi16() this keeps y when z
+   * is 0, as the C code does. */
+  x = _mm256_sub_epi16(_mm256_xor_si256(y, sz), sz);
+  _mm256_storeu_si256((__m256i *)d->qcoeff, x);
+  _mm256_storeu_si256((__m256i *)d->dqcoeff, _mm256_mullo_epi16(x, dequant));
+
+  *d->eob = mask ? (char)(get_msb(mask) + 1) : 0;
+}
+
+void vp8_regular_quantize_b_avx2(BLOCK *b, BLOCKD *d) {
+  const short *const zbin_boost = b->zrun_zbin_boost;
+  const __m256i z = _mm256_loadu_si256((const __m256i *)b->coeff);
+  const __m256i zbin = _mm256_loadu_si256((const __m256i *)b->zbin);
+  const __m256i round = _mm256_loadu_si256((const __m256i *)b->round);
+  const __m256i quant = _mm256_loadu_si256((const __m256i *)b->quant);
+  const __m256i quant_shift =
+      _mm256_loadu_si256((const __m256i *)b->quant_shift);
+  const __m256i dequant = _mm256_loadu_si256((const __m256i *)d->dequant);
+  const __m256i lane_bits =
+      _mm256_setr_epi16(1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6,
+                        1 << 7, 1 << 8, 1 << 9, 1 << 10, 1 << 11, 1 << 12,
+                        1 << 13, 1 << 14, (short)(1 << 15));
+  DECLARE_ALIGNED(32, short, x_minus_zbin[16]);
+  __m256i x, x_zbin, y, reject, keep;
+  int candidates, keep_mask = 0, last = -1;
+
+  /* x = abs(z) */
+  x = _mm256_abs_epi16(z);
+
+  /* In C x is compared to zbin where zbin = zbin[] + boost + extra. Rebalance
+   * the equation because boost is the only value which can change:
+   * x - (zbin[] + extra) >= boost */
+  x_zbin = _mm256_sub_epi16(
+      x, _mm256_add_epi16(zbin, _mm256_set1_epi16(b->zbin_extra)));
+
+  /* y = ((((x + round) * quant) >> 16) + x + round) * quant_shift >> 16 */
+  x = _mm256_add_epi16(x, round);
+  y = _mm256_add_epi16(_mm256_mulhi_epi16(x, quant), x);
+  y = _mm256_sign_epi16(_mm256_mulhi_epi16(y, quant_shift), z);
+
+  /* The zero run boost is smallest at the start of a run (see
+   * vp8cx_init_de_quantizer()), so coefficients below the first boost or
+   * quantized to 0 are never kept whatever the run length. Only the others
+   * need the serial zero run check. */
+  reject = _mm256_or_si256(
+      _mm256_cmpgt_epi16(_mm256_set1_epi16(zbin_boost[0]), x_zbin),
+      _mm256_cmpeq_epi16(y, _mm256_setzero_si256()));
+  candidates = ~zig_zag_movemask(reject) & 0xffff;
+
+  if (candidates) {
+    _mm256_store_si256((__m256i *)x_minus_zbin, x_zbin);
+
+    do {
+      const int i = get_msb(candidates & -candidates);
+      const int rc = zig_zag_mask[i];
+      if (x_minus_zbin[rc] >= zbin_boost[i - last - 1]) {
+        keep_mask |= 1 << rc;
+        last = i;
+      }
+      candidates &= candidates - 1;
+    } while (candidates);
+  }
+
+  /* qcoeff = y for the kept coefficients, in raster order in keep_mask. */
+  keep = _mm256_and_si256(_mm256_set1_epi16((short)keep_mask), lane_bits);
+  y = _mm256_and_si256(y, _mm256_cmpeq_epi16(keep, lane_bits));
+
+  _mm256_storeu_si256((__m256i *)d->qcoeff, y);
+  _mm256_storeu_si256((__m256i *)d->dqcoeff, _mm256_mullo_epi16(y, dequant));
+
+  *d->eob = (char)(last + 1);
+}
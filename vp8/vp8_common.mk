@@ -52,6 +52,7 @@ VP8_COMMON_SRCS-yes += common/setupintrarecon.h
 VP8_COMMON_SRCS-yes += common/swapyv12buffer.h
 VP8_COMMON_SRCS-yes += common/systemdependent.h
 VP8_COMMON_SRCS-yes += common/threading.h
+VP8_COMMON_SRCS-$(CONFIG_MULTITHREAD) += common/threading.c
 VP8_COMMON_SRCS-yes += common/treecoder.h
 VP8_COMMON_SRCS-yes += common/vp8_loopfilter.c
 VP8_COMMON_SRCS-yes += common/loopfilter_filters.c
@@ -87,6 +88,10 @@ VP8_COMMON_SRCS-$(HAVE_SSE2) += common/x86/subpixel_sse2.asm
 VP8_COMMON_SRCS-$(HAVE_SSE2) += common/x86/loopfilter_sse2.asm
 VP8_COMMON_SRCS-$(HAVE_SSE2) += common/x86/iwalsh_sse2.asm
 VP8_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/subpixel_ssse3.asm
+VP8_COMMON_SRCS-$(HAVE_AVX2) += common/x86/bilinear_filter_avx2.c
+VP8_COMMON_SRCS-$(HAVE_AVX2) += common/x86/idct_blk_avx2.c
+VP8_COMMON_SRCS-$(HAVE_AVX2) += common/x86/loopfilter_avx2.c
+VP8_COMMON_SRCS-$(HAVE_AVX2) += common/x86/subpixel_avx2.c
 
 ifeq ($(CONFIG_POSTPROC),yes)
 VP8_COMMON_SRCS-$(HAVE_SSE2) += common/x86/mfqe_sse2.asm
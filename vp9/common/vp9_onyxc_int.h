@@ -13,6 +13,7 @@
 
 #include "./vpx_config.h"
 #include "vpx/internal/vpx_codec_internal.h"
+#include "vpx_util/vpx_atomics.h"
 #include "vpx_util/vpx_thread.h"
 #include "./vp9_rtcd.h"
 #include "vp9/common/vp9_alloccommon.h"
@@ -81,6 +82,14 @@ typedef struct {
                            // frame.
   vpx_codec_frame_buffer_t raw_frame_buffer;
   YV12_BUFFER_CONFIG buf;
+
+  // Only used in frame parallel decode: luma rows of the frame that are fully
+  // reconstructed and the frame worker that is decoding the frame.
+  vpx_atomic_int row;
+  // Luma rows whose mode info is parsed, only tracked by the pipelined
+  // decoder, which parses the whole frame before reconstructing it.
+  vpx_atomic_int parsed_row;
+  VPxWorker *frame_worker_owner;
 } RefCntBuffer;
 
 typedef struct BufferPool {
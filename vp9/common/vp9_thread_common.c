@@ -93,7 +93,6 @@ static INLINE void thread_loop_filter_rows(
     int y_only, VP9LfSync *const lf_sync) {
   const int num_planes = y_only ? 1 : MAX_MB_PLANE;
   const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
-  const int num_active_workers = lf_sync->num_active_workers;
   int mi_row, mi_col;
   enum lf_path path;
   if (y_only)
@@ -105,10 +104,7 @@ static INLINE void thread_loop_filter_rows(
   else
     path = LF_PATH_SLOW;
 
-  assert(num_active_workers > 0);
-
-  for (mi_row = start; mi_row < stop;
-       mi_row += num_active_workers * MI_BLOCK_SIZE) {
+  for (mi_row = start; mi_row < stop; mi_row += MI_BLOCK_SIZE) {
     MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
     LOOP_FILTER_MASK *lfm = get_lfm(&cm->lf, mi_row, 0);
 
@@ -144,13 +140,34 @@ static INLINE void thread_loop_filter_rows(
   }
 }
 
+// Returns the next superblock row to filter, or 'stop' once all rows have
+// been handed out. Rows are claimed in order, so the row above is always
+// owned by a worker that is already running. Workers sharing a thread pool
+// with fewer threads than workers therefore cannot deadlock.
+static INLINE int get_next_mi_row(VP9LfSync *const lf_sync, int stop) {
+  int mi_row;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(lf_sync->lf_mutex);
+#endif
+  mi_row = VPXMIN(lf_sync->next_mi_row, stop);
+  lf_sync->next_mi_row = mi_row + MI_BLOCK_SIZE;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(lf_sync->lf_mutex);
+#endif
+  return mi_row;
+}
+
 // Row-based multi-threaded loopfilter hook
 static int loop_filter_row_worker(void *arg1, void *arg2) {
   VP9LfSync *const lf_sync = (VP9LfSync *)arg1;
   LFWorkerData *const lf_data = (LFWorkerData *)arg2;
-  thread_loop_filter_rows(lf_data->frame_buffer, lf_data->cm, lf_data->planes,
-                          lf_data->start, lf_data->stop, lf_data->y_only,
-                          lf_sync);
+  int mi_row;
+  for (mi_row = get_next_mi_row(lf_sync, lf_data->stop); mi_row < lf_data->stop;
+       mi_row = get_next_mi_row(lf_sync, lf_data->stop)) {
+    thread_loop_filter_rows(lf_data->frame_buffer, lf_data->cm,
+                            lf_data->planes, mi_row, mi_row + MI_BLOCK_SIZE,
+                            lf_data->y_only, lf_sync);
+  }
   return 1;
 }
 
@@ -176,6 +193,7 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, VP9_COMMON *cm,
     vp9_loop_filter_alloc(lf_sync, cm, sb_rows, cm->width, num_workers);
   }
   lf_sync->num_active_workers = num_workers;
+  lf_sync->next_mi_row = start;
 
   // Initialize cur_sb_col to -1 for all SB rows.
   memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * sb_rows);
@@ -198,7 +216,7 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, VP9_COMMON *cm,
 
     // Loopfilter data
     vp9_loop_filter_data_reset(lf_data, frame, cm, planes);
-    lf_data->start = start + i * MI_BLOCK_SIZE;
+    lf_data->start = start;
     lf_data->stop = stop;
     lf_data->y_only = y_only;
 
@@ -0,0 +1,224 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_enums.h"
+#include "vpx_dsp/x86/inv_txfm_avx2.h"
+
+// Each 1-D pass transposes the block and then transforms all of its columns
+// at once. The 8x8 transforms hold two coefficient rows per register and the
+// 16x16 transforms one.
+static INLINE void idct8(__m256i *const in) {
+  transpose_16bit_8x8_avx2(in, in);
+  idct8_avx2(in);
+}
+
+static INLINE void iadst8(__m256i *const in) {
+  transpose_16bit_8x8_avx2(in, in);
+  iadst8_avx2(in);
+}
+
+// Loads rows a and b into the low and high halves. If the source is 32 bits
+// then pack down with saturation.
+static INLINE __m256i load_input_data8x2(const tran_low_t *a,
+                                         const tran_low_t *b) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  const __m256i in0 = _mm256_loadu_si256((const __m256i *)a);
+  const __m256i in1 = _mm256_loadu_si256((const __m256i *)b);
+  // a0 a1 a2 a3  b0 b1 b2 b3  a4 a5 a6 a7  b4 b5 b6 b7
+  const __m256i t = _mm256_packs_epi32(in0, in1);
+  return _mm256_permute4x64_epi64(t, 0xd8);
+#else
+  const __m128i in0 = _mm_loadu_si128((const __m128i *)a);
+  const __m128i in1 = _mm_loadu_si128((const __m128i *)b);
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(in0), in1, 1);
+#endif
+}
+
+// Adds in = [row i | row i + 4] to the 8-pixel rows at dest and
+// dest + 4 * stride.
+static INLINE void write_buffer_8x2(uint8_t *const dest, const int stride,
+                                    const __m256i in) {
+  const __m256i final_rounding = _mm256_set1_epi16(1 << 4);
+  const __m128i d0 = _mm_loadl_epi64((const __m128i *)dest);
+  const __m128i d1 = _mm_loadl_epi64((const __m128i *)(dest + 4 * stride));
+  __m256i d = _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(d0, d1));
+  __m256i out = _mm256_adds_epi16(in, final_rounding);
+  out = _mm256_srai_epi16(out, 5);
+  d = _mm256_add_epi16(d, out);
+  d = _mm256_packus_epi16(d, d);
+  _mm_storel_epi64((__m128i *)dest, _mm256_castsi256_si128(d));
+  _mm_storel_epi64((__m128i *)(dest + 4 * stride),
+                   _mm256_extracti128_si256(d, 1));
+}
+
+void vp9_iht8x8_64_add_avx2(const tran_low_t *input, uint8_t *dest, int stride,
+                            int tx_type) {
+  __m256i in[4];
+  int i;
+
+  for (i = 0; i < 4; ++i) {
+    in[i] = load_input_data8x2(input + i * 8, input + (i + 4) * 8);
+  }
+
+  switch (tx_type) {
+    case DCT_DCT:
+      idct8(in);
+      idct8(in);
+      break;
+    case ADST_DCT:
+      idct8(in);
+      iadst8(in);
+      break;
+    case DCT_ADST:
+      iadst8(in);
+      idct8(in);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      iadst8(in);
+      iadst8(in);
+      break;
+  }
+
+  for (i = 0; i < 4; ++i) {
+    write_buffer_8x2(dest + i * stride, stride, in[i]);
+  }
+}
+
+static INLINE void idct16(__m256i *const in) {
+  transpose_16bit_16x16_avx2(in, in);
+  idct16_avx2(in);
+}
+
+static INLINE void iadst16(__m256i *const in) {
+  transpose_16bit_16x16_avx2(in, in);
+  iadst16_avx2(in);
+}
+
+// Runs the first 1-D pass of the 16x16 transform given by |tx_type| over the
+// rows of the block, and the second over its columns.
+static void iht16x16(__m256i *const in, const int tx_type) {
+  switch (tx_type) {
+    case DCT_DCT:
+      idct16(in);
+      idct16(in);
+      break;
+    case ADST_DCT:
+      idct16(in);
+      iadst16(in);
+      break;
+    case DCT_ADST:
+      iadst16(in);
+      idct16(in);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      iadst16(in);
+      iadst16(in);
+      break;
+  }
+}
+
+void vp9_iht16x16_256_add_avx2(const tran_low_t *input, uint8_t *dest,
+                               int stride, int tx_type) {
+  __m256i in[16];
+  int i;
+
+  for (i = 0; i < 16; ++i) {
+    in[i] = load_input_data16_avx2(input + i * 16);
+  }
+
+  iht16x16(in, tx_type);
+
+  for (i = 0; i < 16; ++i) {
+    write_buffer_16x1_avx2(dest + i * stride, in[i]);
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// Adds the 16 residuals in |in| to the pixels at dest and clamps the sums to
+// [0, (1 << bd) - 1].
+static INLINE void highbd_recon_and_store_16(uint16_t *const dest,
+                                             const __m256i in, const int bd) {
+  const __m256i max = _mm256_set1_epi16((1 << bd) - 1);
+  __m256i d = _mm256_loadu_si256((const __m256i *)dest);
+  d = _mm256_adds_epi16(d, in);
+  d = _mm256_max_epi16(d, _mm256_setzero_si256());
+  d = _mm256_min_epi16(d, max);
+  _mm256_storeu_si256((__m256i *)dest, d);
+}
+
+// One 1-D pass of the 32-bit transform. The 16x16 block is held as
+// in[2 * i + j] = row i, columns 8 * j to 8 * j + 7, and each half is
+// transposed and then transformed as eight columns.
+static void highbd_iht16_pass(__m256i *const in /*in[32]*/, const int adst) {
+  __m256i t[32], col[16];
+  int i, j;
+
+  transpose_32bit_16x16_avx2(in, t);
+  for (j = 0; j < 2; ++j) {
+    for (i = 0; i < 16; ++i) col[i] = t[2 * i + j];
+    if (adst) {
+      highbd_iadst16_avx2(col);
+    } else {
+      highbd_idct16_avx2(col);
+    }
+    for (i = 0; i < 16; ++i) in[2 * i + j] = col[i];
+  }
+}
+
+void vp9_highbd_iht16x16_256_add_avx2(const tran_low_t *input, uint16_t *dest,
+                                      int stride, int tx_type, int bd) {
+  int i;
+
+  if (bd == 8) {
+    // The coefficients of 8-bit streams fit the 16-bit transforms, as in
+    // vp9_highbd_iht16x16_256_add_sse4_1().
+    const __m256i final_rounding = _mm256_set1_epi16(1 << 5);
+    __m256i in[16];
+
+    for (i = 0; i < 16; ++i) {
+      in[i] = load_input_data16_avx2(input + i * 16);
+    }
+
+    iht16x16(in, tx_type);
+
+    for (i = 0; i < 16; ++i) {
+      const __m256i out =
+          _mm256_srai_epi16(_mm256_adds_epi16(in[i], final_rounding), 6);
+      highbd_recon_and_store_16(dest + i * stride, out, bd);
+    }
+  } else {
+    const __m256i final_rounding = _mm256_set1_epi32(1 << 5);
+    __m256i in[32];
+
+    for (i = 0; i < 32; ++i) {
+      in[i] = _mm256_loadu_si256((const __m256i *)(input + 8 * i));
+    }
+
+    highbd_iht16_pass(in, tx_type == DCT_ADST || tx_type == ADST_ADST);
+    highbd_iht16_pass(in, tx_type == ADST_DCT || tx_type == ADST_ADST);
+
+    for (i = 0; i < 16; ++i) {
+      const __m256i lo =
+          _mm256_srai_epi32(_mm256_add_epi32(in[2 * i], final_rounding), 6);
+      const __m256i hi = _mm256_srai_epi32(
+          _mm256_add_epi32(in[2 * i + 1], final_rounding), 6);
+      // packs works within 128-bit lanes, so restore the column order.
+      const __m256i out =
+          _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xd8);
+      highbd_recon_and_store_16(dest + i * stride, out, bd);
+    }
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -9,6 +9,7 @@
  */
 
 #include <assert.h>
+#include <limits.h>
 #include <stdlib.h>  // qsort()
 
 #include "./vp9_rtcd.h"
@@ -23,6 +24,7 @@
 #include "vpx_ports/mem_ops.h"
 #include "vpx_scale/vpx_scale.h"
 #include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
 #if CONFIG_BITSTREAM_DEBUG || CONFIG_MISMATCH_DEBUG
 #include "vpx_util/vpx_debug_util.h"
 #endif  // CONFIG_BITSTREAM_DEBUG || CONFIG_MISMATCH_DEBUG
@@ -45,6 +47,7 @@
 #include "vp9/decoder/vp9_decodemv.h"
 #include "vp9/decoder/vp9_decoder.h"
 #include "vp9/decoder/vp9_dsubexp.h"
+#include "vp9/decoder/vp9_dthread.h"
 #include "vp9/decoder/vp9_job_queue.h"
 
 #define MAX_VP9_HEADER_SIZE 80
@@ -578,7 +581,7 @@ static void dec_build_inter_predictors(
     int y, int w, int h, int mi_x, int mi_y, const InterpKernel *kernel,
     const struct scale_factors *sf, struct buf_2d *pre_buf,
     struct buf_2d *dst_buf, const MV *mv, RefCntBuffer *ref_frame_buf,
-    int is_scaled, int ref) {
+    int is_scaled, int ref, VP9Decoder *const pbi) {
   struct macroblockd_plane *const pd = &xd->plane[plane];
   uint8_t *const dst = dst_buf->buf + dst_buf->stride * y + x;
   MV32 scaled_mv;
@@ -651,6 +654,16 @@ static void dec_build_inter_predictors(
   x0_16 += scaled_mv.col;
   y0_16 += scaled_mv.row;
 
+  if (pbi->frame_parallel_decode) {
+    // Wait until the reference block, including the rows used by the
+    // interpolation filter, is reconstructed.
+    int y1 = ((y0_16 + (h - 1) * ys) >> SUBPEL_BITS) + 1;
+    if (subpel_y || (sf->y_step_q4 != SUBPEL_SHIFTS)) y1 += VP9_INTERP_EXTEND;
+    y1 = clamp(y1, 0, frame_height - 1);
+    vp9_frameworker_wait(ref_frame_buf, (y1 + 1) << pd->subsampling_y,
+                         vp9_dec_wait_time(pbi));
+  }
+
   // Get reference block pointer.
   buf_ptr = ref_frame + y0 * pre_buf->stride + x0;
   buf_stride = pre_buf->stride;
@@ -755,10 +768,10 @@ static void dec_build_inter_predictors_sb(TileWorkerData *twd,
         for (y = 0; y < num_4x4_h; ++y) {
           for (x = 0; x < num_4x4_w; ++x) {
             const MV mv = average_split_mvs(pd, mi, ref, i++);
-            dec_build_inter_predictors(twd, xd, plane, n4w_x4, n4h_x4, 4 * x,
-                                       4 * y, 4, 4, mi_x, mi_y, kernel, sf,
-                                       pre_buf, dst_buf, &mv, ref_frame_buf,
-                                       is_scaled, ref);
+            dec_build_inter_predictors(
+                twd, xd, plane, n4w_x4, n4h_x4, 4 * x, 4 * y, 4, 4, mi_x, mi_y,
+                kernel, sf, pre_buf, dst_buf, &mv, ref_frame_buf, is_scaled,
+                ref, pbi);
           }
         }
       }
@@ -772,9 +785,10 @@ static void dec_build_inter_predictors_sb(TileWorkerData *twd,
         const int n4w_x4 = 4 * num_4x4_w;
         const int n4h_x4 = 4 * num_4x4_h;
         struct buf_2d *const pre_buf = &pd->pre[ref];
-        dec_build_inter_predictors(twd, xd, plane, n4w_x4, n4h_x4, 0, 0, n4w_x4,
-                                   n4h_x4, mi_x, mi_y, kernel, sf, pre_buf,
-                                   dst_buf, &mv, ref_frame_buf, is_scaled, ref);
+        dec_build_inter_predictors(
+            twd, xd, plane, n4w_x4, n4h_x4, 0, 0, n4w_x4, n4h_x4, mi_x, mi_y,
+            kernel, sf, pre_buf, dst_buf, &mv, ref_frame_buf, is_scaled, ref,
+            pbi);
       }
     }
   }
@@ -1890,6 +1904,12 @@ static void parse_tile_row(TileWorkerData *tile_data, VP9Decoder *pbi,
   }
 }
 
+static vp9d_stage_t get_job_stage(JobType job_type) {
+  if (job_type == PARSE_JOB) return VP9D_STAGE_PARSE;
+  if (job_type == RECON_JOB) return VP9D_STAGE_RECON;
+  return VP9D_STAGE_LOOP_FILTER;
+}
+
 static int row_decode_worker_hook(void *arg1, void *arg2) {
   ThreadData *const thread_data = (ThreadData *)arg1;
   uint8_t **data_end = (uint8_t **)arg2;
@@ -1909,6 +1929,7 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
   while (!vp9_jobq_dequeue(&row_mt_worker_data->jobq, &job, sizeof(job), 1)) {
     int mi_col;
     const int mi_row = job.row_num;
+    volatile int64_t job_start = vp9_dec_stage_clock(pbi);
 
     if (job.job_type == LPF_JOB) {
       lf_data->start = mi_row;
@@ -2005,29 +2026,135 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
                        sizeof(parse_job));
       }
     }
+
+    if (pbi->stage_timing) {
+      thread_data->stage_time[get_job_stage(job.job_type)] +=
+          vpx_thread_cpu_time_usec() - job_start;
+    }
   }
 
   vpx_free(tile_data_recon);
   return !corrupted;
 }
 
+// Adapts the probabilities to the symbol counts of the frame and refreshes
+// the frame context.
+static void adapt_frame_contexts(VP9Decoder *pbi) {
+  VP9_COMMON *const cm = &pbi->common;
+  // The frame context was refreshed with the frame headers.
+  const int context_updated =
+      pbi->frame_parallel_decode && cm->frame_parallel_decoding_mode;
+
+  if (!pbi->mb.corrupted) {
+    if (!cm->error_resilient_mode && !cm->frame_parallel_decoding_mode) {
+      vp9_adapt_coef_probs(cm);
+
+      if (!frame_is_intra_only(cm)) {
+        vp9_adapt_mode_probs(cm);
+        vp9_adapt_mv_probs(cm, cm->allow_high_precision_mv);
+      }
+    }
+  } else {
+    vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
+                       "Decode failed. Frame data is corrupted.");
+  }
+
+  // Non frame parallel update frame context here.
+  if (cm->refresh_frame_context && !context_updated)
+    cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+}
+
+// Points the coefficient and partition buffers of 'tile_data' at the row based
+// buffers of superblock 'sb_num'.
+static INLINE void set_sb_buffers(TileWorkerData *tile_data,
+                                  RowMTWorkerData *row_mt_worker_data,
+                                  int sb_num) {
+  int plane;
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    tile_data->xd.plane[plane].eob =
+        row_mt_worker_data->eob[plane] + (sb_num << EOBS_PER_SB_LOG2);
+    tile_data->xd.plane[plane].dqcoeff =
+        row_mt_worker_data->dqcoeff[plane] + (sb_num << DQCOEFFS_PER_SB_LOG2);
+  }
+  tile_data->xd.partition =
+      row_mt_worker_data->partition + sb_num * PARTITIONS_PER_SB;
+}
+
+// Pipelined decode: parses all the tiles of the frame into the row based
+// buffers and adapts the frame contexts. The following frame only depends on
+// the parsed data, it is parsed while this frame is reconstructed.
+static void parse_tiles_pipelined(VP9Decoder *pbi) {
+  VP9_COMMON *const cm = &pbi->common;
+  RowMTWorkerData *const row_mt_worker_data = pbi->row_mt_worker_data;
+  const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  int tile_row, tile_col;
+  int mi_row, mi_col;
+
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    TileInfo tile;
+    vp9_tile_set_row(&tile, cm, tile_row);
+    for (mi_row = tile.mi_row_start; mi_row < tile.mi_row_end;
+         mi_row += MI_BLOCK_SIZE) {
+      const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+      if (cm->use_prev_frame_mvs) {
+        vp9_frameworker_wait_parsed(cm->prev_frame,
+                                    (mi_row + MI_BLOCK_SIZE) * MI_SIZE,
+                                    vp9_dec_wait_time(pbi));
+      }
+      for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+        const int col =
+            pbi->inv_tile_order ? tile_cols - tile_col - 1 : tile_col;
+        TileWorkerData *const tile_data =
+            pbi->tile_worker_data + tile_cols * tile_row + col;
+        vp9_tile_set_col(&tile, cm, col);
+        vp9_zero(tile_data->xd.left_context);
+        vp9_zero(tile_data->xd.left_seg_context);
+        for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
+             mi_col += MI_BLOCK_SIZE) {
+          set_sb_buffers(tile_data, row_mt_worker_data,
+                         sb_row * sb_cols + (mi_col >> MI_BLOCK_SIZE_LOG2));
+          process_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4,
+                            PARSE, parse_block);
+        }
+        pbi->mb.corrupted |= tile_data->xd.corrupted;
+        if (pbi->mb.corrupted)
+          vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
+                             "Failed to decode tile data");
+      }
+      vp9_frameworker_broadcast_parsed(pbi->cur_buf,
+                                       (mi_row + MI_BLOCK_SIZE) * MI_SIZE);
+    }
+  }
+
+  adapt_frame_contexts(pbi);
+  vp9_frameworker_broadcast_parsed(pbi->cur_buf, INT_MAX);
+}
+
 static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
                                    const uint8_t *data_end) {
   VP9_COMMON *const cm = &pbi->common;
   const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
   const int aligned_cols = mi_cols_aligned_to_sb(cm->mi_cols);
+  const int sb_cols = aligned_cols >> MI_BLOCK_SIZE_LOG2;
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
   TileBuffer tile_buffers[4][1 << 6];
   int tile_row, tile_col;
   int mi_row, mi_col;
   TileWorkerData *tile_data = NULL;
+  const int64_t start = vp9_dec_stage_clock(pbi);
+  int64_t lf_worker_start = 0, lf_worker_time = 0, lf_time = 0, parse_time = 0;
 
   if (cm->lf.filter_level && !cm->skip_loop_filter &&
       pbi->lf_worker.data1 == NULL) {
     CHECK_MEM_ERROR(cm, pbi->lf_worker.data1,
                     vpx_memalign(32, sizeof(LFWorkerData)));
     pbi->lf_worker.hook = vp9_loop_filter_worker;
+    if (pbi->max_threads > 1 && pbi->thread_pool != NULL) {
+      vpx_thread_pool_attach_worker(pbi->thread_pool, &pbi->lf_worker);
+    }
     if (pbi->max_threads > 1 && !winterface->reset(&pbi->lf_worker)) {
       vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
                          "Loop filter thread creation failed");
@@ -2040,6 +2167,8 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
     winterface->sync(&pbi->lf_worker);
     vp9_loop_filter_data_reset(lf_data, get_frame_new_buffer(cm), cm,
                                pbi->mb.plane);
+    pbi->lf_worker.timed = pbi->stage_timing;
+    lf_worker_start = pbi->lf_worker.cpu_time;
   }
 
   assert(tile_rows <= 4);
@@ -2075,11 +2204,25 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
     }
   }
 
+  if (pbi->pipeline_decode) {
+    const int64_t parse_start = vp9_dec_stage_clock(pbi);
+    parse_tiles_pipelined(pbi);
+    parse_time = vp9_dec_stage_clock(pbi) - parse_start;
+  }
+
   for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
     TileInfo tile;
     vp9_tile_set_row(&tile, cm, tile_row);
     for (mi_row = tile.mi_row_start; mi_row < tile.mi_row_end;
          mi_row += MI_BLOCK_SIZE) {
+      // The motion vectors of the previous frame are written while its
+      // blocks are parsed.
+      if (pbi->frame_parallel_decode && !pbi->pipeline_decode &&
+          cm->use_prev_frame_mvs) {
+        vp9_frameworker_wait_parsed(cm->prev_frame,
+                                    (mi_row + MI_BLOCK_SIZE) * MI_SIZE,
+                                    vp9_dec_wait_time(pbi));
+      }
       for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
         const int col =
             pbi->inv_tile_order ? tile_cols - tile_col - 1 : tile_col;
@@ -2089,7 +2232,13 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
         vp9_zero(tile_data->xd.left_seg_context);
         for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
              mi_col += MI_BLOCK_SIZE) {
-          if (pbi->row_mt == 1) {
+          if (pbi->pipeline_decode) {
+            const int sb_num = (mi_row >> MI_BLOCK_SIZE_LOG2) * sb_cols +
+                               (mi_col >> MI_BLOCK_SIZE_LOG2);
+            set_sb_buffers(tile_data, pbi->row_mt_worker_data, sb_num);
+            process_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4,
+                              RECON, recon_block);
+          } else if (pbi->row_mt == 1) {
             int plane;
             RowMTWorkerData *const row_mt_worker_data = pbi->row_mt_worker_data;
             for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
@@ -2135,8 +2284,17 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
         if (pbi->max_threads > 1) {
           winterface->launch(&pbi->lf_worker);
         } else {
+          const int64_t lf_start = vp9_dec_stage_clock(pbi);
           winterface->execute(&pbi->lf_worker);
+          lf_time += vp9_dec_stage_clock(pbi) - lf_start;
+          // Filtering the next row still modifies the bottom pixels of the
+          // filtered rows.
+          if (pbi->frame_parallel_decode)
+            vp9_frameworker_broadcast(pbi->cur_buf, (mi_row - 2) * MI_SIZE);
         }
+      } else if (pbi->frame_parallel_decode) {
+        vp9_frameworker_broadcast(pbi->cur_buf,
+                                  (mi_row + MI_BLOCK_SIZE) * MI_SIZE);
       }
     }
   }
@@ -2144,10 +2302,23 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
   // Loopfilter remaining rows in the frame.
   if (cm->lf.filter_level && !cm->skip_loop_filter) {
     LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
+    int64_t lf_start;
     winterface->sync(&pbi->lf_worker);
+    lf_start = vp9_dec_stage_clock(pbi);
     lf_data->start = lf_data->stop;
     lf_data->stop = cm->mi_rows;
     winterface->execute(&pbi->lf_worker);
+    lf_time += vp9_dec_stage_clock(pbi) - lf_start;
+    lf_worker_time = pbi->lf_worker.cpu_time - lf_worker_start;
+  }
+
+  if (pbi->stage_timing) {
+    const int64_t time =
+        vpx_thread_cpu_time_usec() - start - parse_time - lf_time;
+    pbi->stage_time[VP9D_STAGE_PARSE] += parse_time;
+    pbi->stage_time[pbi->pipeline_decode ? VP9D_STAGE_RECON
+                                         : VP9D_STAGE_TILES] += time;
+    pbi->stage_time[VP9D_STAGE_LOOP_FILTER] += lf_time + lf_worker_time;
   }
 
   // Get last tile data.
@@ -2262,7 +2433,9 @@ static int tile_worker_hook(void *arg1, void *arg2) {
 
   if (pbi->lpf_mt_opt && !tile_data->xd.corrupted && cm->lf.filter_level &&
       !cm->skip_loop_filter) {
+    const int64_t lf_start = vp9_dec_stage_clock(pbi);
     vp9_loopfilter_rows(lf_data, lf_sync);
+    tile_data->lf_time = vp9_dec_stage_clock(pbi) - lf_start;
   }
 
   tile_data->data_end = bit_reader_end;
@@ -2276,6 +2449,16 @@ static int compare_tile_buffers(const void *a, const void *b) {
   return (buf_a->size < buf_b->size) - (buf_a->size > buf_b->size);
 }
 
+// Returns the CPU time the tile workers spent on their own threads.
+static int64_t get_tile_workers_cpu_time(const VP9Decoder *pbi) {
+  int64_t cpu_time = 0;
+  int n;
+  for (n = 0; n < pbi->num_tile_workers; ++n) {
+    cpu_time += pbi->tile_workers[n].cpu_time;
+  }
+  return cpu_time;
+}
+
 static INLINE void init_mt(VP9Decoder *pbi) {
   int n;
   VP9_COMMON *const cm = &pbi->common;
@@ -2292,6 +2475,9 @@ static INLINE void init_mt(VP9Decoder *pbi) {
       ++pbi->num_tile_workers;
 
       winterface->init(worker);
+      if (n < num_threads - 1 && pbi->thread_pool != NULL) {
+        vpx_thread_pool_attach_worker(pbi->thread_pool, worker);
+      }
       if (n < num_threads - 1 && !winterface->reset(worker)) {
         vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
                            "Tile decoder thread creation failed");
@@ -2299,6 +2485,10 @@ static INLINE void init_mt(VP9Decoder *pbi) {
     }
   }
 
+  for (n = 0; n < pbi->num_tile_workers; ++n) {
+    pbi->tile_workers[n].timed = pbi->stage_timing;
+  }
+
   // Initialize LPF
   if ((pbi->lpf_mt_opt || pbi->row_mt) && cm->lf.filter_level &&
       !cm->skip_loop_filter) {
@@ -2357,6 +2547,7 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
     }
 
     thread_data->pbi = pbi;
+    vp9_zero(thread_data->stage_time);
 
     worker->hook = row_decode_worker_hook;
     worker->data1 = thread_data;
@@ -2417,6 +2608,16 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
 
   pbi->mb.corrupted = corrupted;
 
+  if (pbi->stage_timing) {
+    for (n = 0; n < num_workers; ++n) {
+      const ThreadData *const thread_data =
+          &pbi->row_mt_worker_data->thread_data[n];
+      for (i = 0; i < VP9D_STAGE_COUNT; ++i) {
+        pbi->stage_time[i] += thread_data->stage_time[i];
+      }
+    }
+  }
+
   {
     /* Set data end */
     TileWorkerData *const tile_data = &pbi->tile_worker_data[tile_cols - 1];
@@ -2444,6 +2645,8 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
   const int num_workers = VPXMIN(pbi->max_threads, tile_cols);
+  const int64_t start = vp9_dec_stage_clock(pbi);
+  int64_t workers_start;
   int n;
 
   assert(tile_cols <= (1 << 6));
@@ -2451,6 +2654,7 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
   (void)tile_rows;
 
   init_mt(pbi);
+  workers_start = get_tile_workers_cpu_time(pbi);
 
   // Reset tile decoding hook
   for (n = 0; n < num_workers; ++n) {
@@ -2469,6 +2673,7 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
     tile_data->xd = pbi->mb;
     tile_data->xd.counts =
         cm->frame_parallel_decoding_mode ? NULL : &tile_data->counts;
+    tile_data->lf_time = 0;
     worker->hook = tile_worker_hook;
     worker->data1 = tile_data;
     worker->data2 = pbi;
@@ -2551,6 +2756,17 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
     }
   }
 
+  if (pbi->stage_timing) {
+    int64_t lf_time = 0;
+    for (n = 0; n < num_workers; ++n) {
+      lf_time += ((TileWorkerData *)pbi->tile_workers[n].data1)->lf_time;
+    }
+    pbi->stage_time[VP9D_STAGE_TILES] +=
+        vpx_thread_cpu_time_usec() - start + get_tile_workers_cpu_time(pbi) -
+        workers_start - lf_time;
+    pbi->stage_time[VP9D_STAGE_LOOP_FILTER] += lf_time;
+  }
+
   // Accumulate thread frame counts.
   if (!cm->frame_parallel_decoding_mode) {
     for (n = 0; n < num_workers; ++n) {
@@ -2817,7 +3033,7 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
   setup_segmentation_dequant(cm);
 
   setup_tile_info(cm, rb);
-  if (pbi->row_mt == 1) {
+  if (pbi->row_mt == 1 || pbi->pipeline_decode) {
     int num_sbs = 1;
     const int aligned_rows = mi_cols_aligned_to_sb(cm->mi_rows);
     const int sb_rows = aligned_rows >> MI_BLOCK_SIZE_LOG2;
@@ -2831,7 +3047,8 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
 #endif
     }
 
-    if (pbi->max_threads > 1) {
+    // The pipelined decoder keeps the whole frame parsed.
+    if (pbi->max_threads > 1 || pbi->pipeline_decode) {
       const int aligned_cols = mi_cols_aligned_to_sb(cm->mi_cols);
       const int sb_cols = aligned_cols >> MI_BLOCK_SIZE_LOG2;
 
@@ -2844,7 +3061,7 @@ static size_t read_uncompressed_header(VP9Decoder *pbi,
       vp9_dec_alloc_row_mt_mem(pbi->row_mt_worker_data, cm, num_sbs,
                                pbi->max_threads, num_jobs);
     }
-    vp9_jobq_alloc(pbi);
+    if (pbi->row_mt == 1) vp9_jobq_alloc(pbi);
   }
   sz = vpx_rb_read_literal(rb, 16);
 
@@ -2944,12 +3161,13 @@ BITSTREAM_PROFILE vp9_read_profile(struct vpx_read_bit_buffer *rb) {
   return (BITSTREAM_PROFILE)profile;
 }
 
-void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
-                      const uint8_t *data_end, const uint8_t **p_data_end) {
+static const uint8_t *decode_frame_headers(VP9Decoder *pbi,
+                                          const uint8_t *data,
+                                          const uint8_t *data_end,
+                                          const uint8_t **p_data_end) {
   VP9_COMMON *const cm = &pbi->common;
   MACROBLOCKD *const xd = &pbi->mb;
   struct vpx_read_bit_buffer rb;
-  int context_updated = 0;
   uint8_t clear_data[MAX_VP9_HEADER_SIZE];
   const size_t first_partition_size = read_uncompressed_header(
       pbi, init_read_bit_buffer(pbi, &rb, data, data_end, clear_data));
@@ -2967,7 +3185,7 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
   if (!first_partition_size) {
     // showing a frame directly
     *p_data_end = data + (cm->profile <= PROFILE_2 ? 1 : 2);
-    return;
+    return NULL;
   }
 
   data += vpx_rb_bytes_read(&rb);
@@ -2993,6 +3211,13 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
     vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
                        "Decode failed. Frame data header is corrupted.");
 
+  // Without backward adaptation the frame context is final once the
+  // compressed header is read, so the next frame can be parsed right away.
+  if (pbi->frame_parallel_decode && cm->frame_parallel_decoding_mode &&
+      cm->refresh_frame_context) {
+    cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+  }
+
   if (cm->lf.filter_level && !cm->skip_loop_filter) {
     vp9_loop_filter_frame_init(cm, cm->lf.filter_level);
   }
@@ -3010,22 +3235,52 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
     pbi->total_tiles = tile_rows * tile_cols;
   }
 
+  return data + first_partition_size;
+}
+
+const uint8_t *vp9_decode_frame_headers(VP9Decoder *pbi, const uint8_t *data,
+                                        const uint8_t *data_end,
+                                        const uint8_t **p_data_end) {
+  const int64_t start = vp9_dec_stage_clock(pbi);
+  const uint8_t *const tile_data =
+      decode_frame_headers(pbi, data, data_end, p_data_end);
+  if (pbi->stage_timing) {
+    pbi->stage_time[VP9D_STAGE_HEADERS] += vpx_thread_cpu_time_usec() - start;
+  }
+  return tile_data;
+}
+
+void vp9_decode_frame_tiles(VP9Decoder *pbi, const uint8_t *data,
+                            const uint8_t *data_end,
+                            const uint8_t **p_data_end) {
+  VP9_COMMON *const cm = &pbi->common;
+  MACROBLOCKD *const xd = &pbi->mb;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  YV12_BUFFER_CONFIG *const new_fb = get_frame_new_buffer(cm);
+
   if (pbi->max_threads > 1 && tile_rows == 1 &&
       (tile_cols > 1 || pbi->row_mt == 1)) {
     if (pbi->row_mt == 1) {
-      *p_data_end =
-          decode_tiles_row_wise_mt(pbi, data + first_partition_size, data_end);
+      *p_data_end = decode_tiles_row_wise_mt(pbi, data, data_end);
     } else {
       // Multi-threaded tile decoder
-      *p_data_end = decode_tiles_mt(pbi, data + first_partition_size, data_end);
+      *p_data_end = decode_tiles_mt(pbi, data, data_end);
       if (!pbi->lpf_mt_opt) {
         if (!xd->corrupted) {
           if (!cm->skip_loop_filter) {
+            const int64_t start = vp9_dec_stage_clock(pbi);
+            const int64_t workers_start = get_tile_workers_cpu_time(pbi);
             // If multiple threads are used to decode tiles, then we use those
             // threads to do parallel loopfiltering.
             vp9_loop_filter_frame_mt(
                 new_fb, cm, pbi->mb.plane, cm->lf.filter_level, 0, 0,
                 pbi->tile_workers, pbi->num_tile_workers, &pbi->lf_row_sync);
+            if (pbi->stage_timing) {
+              pbi->stage_time[VP9D_STAGE_LOOP_FILTER] +=
+                  vpx_thread_cpu_time_usec() - start +
+                  get_tile_workers_cpu_time(pbi) - workers_start;
+            }
           }
         } else {
           vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
@@ -3034,24 +3289,20 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
       }
     }
   } else {
-    *p_data_end = decode_tiles(pbi, data + first_partition_size, data_end);
+    *p_data_end = decode_tiles(pbi, data, data_end);
   }
 
-  if (!xd->corrupted) {
-    if (!cm->error_resilient_mode && !cm->frame_parallel_decoding_mode) {
-      vp9_adapt_coef_probs(cm);
+  // The pipelined decoder adapts the frame contexts once the frame is parsed.
+  if (!pbi->pipeline_decode) adapt_frame_contexts(pbi);
+}
 
-      if (!frame_is_intra_only(cm)) {
-        vp9_adapt_mode_probs(cm);
-        vp9_adapt_mv_probs(cm, cm->allow_high_precision_mv);
-      }
-    }
-  } else {
-    vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
-                       "Decode failed. Frame data is corrupted.");
-  }
+void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
+                      const uint8_t *data_end, const uint8_t **p_data_end) {
+  const uint8_t *const tile_data =
+      vp9_decode_frame_headers(pbi, data, data_end, p_data_end);
 
-  // Non frame parallel update frame context here.
-  if (cm->refresh_frame_context && !context_updated)
-    cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+  // showing a frame directly
+  if (tile_data == NULL) return;
+
+  vp9_decode_frame_tiles(pbi, tile_data, data_end, p_data_end);
 }
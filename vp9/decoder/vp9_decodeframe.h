@@ -28,6 +28,17 @@ BITSTREAM_PROFILE vp9_read_profile(struct vpx_read_bit_buffer *rb);
 void vp9_decode_frame(struct VP9Decoder *pbi, const uint8_t *data,
                       const uint8_t *data_end, const uint8_t **p_data_end);
 
+// vp9_decode_frame() in two steps. vp9_decode_frame_headers() reads the frame
+// headers and returns the start of the tile data, or NULL if the frame shows
+// an existing frame. vp9_decode_frame_tiles() then decodes the tile data.
+const uint8_t *vp9_decode_frame_headers(struct VP9Decoder *pbi,
+                                        const uint8_t *data,
+                                        const uint8_t *data_end,
+                                        const uint8_t **p_data_end);
+void vp9_decode_frame_tiles(struct VP9Decoder *pbi, const uint8_t *data,
+                            const uint8_t *data_end,
+                            const uint8_t **p_data_end);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -35,6 +35,7 @@
 #include "vp9/decoder/vp9_decodeframe.h"
 #include "vp9/decoder/vp9_decoder.h"
 #include "vp9/decoder/vp9_detokenize.h"
+#include "vp9/decoder/vp9_dthread.h"
 
 static void initialize_dec(void) {
   static volatile int init_done = 0;
@@ -233,15 +234,16 @@ void vp9_decoder_remove(VP9Decoder *pbi) {
     vp9_loop_filter_dealloc(&pbi->lf_row_sync);
   }
 
-  if (pbi->row_mt == 1) {
+  // The pipelined decoder uses the row based buffers without the job queue.
+  if (pbi->row_mt_worker_data != NULL) {
     vp9_dec_free_row_mt_mem(pbi->row_mt_worker_data);
-    if (pbi->row_mt_worker_data != NULL) {
+    if (pbi->row_mt == 1) {
       vp9_jobq_deinit(&pbi->row_mt_worker_data->jobq);
       vpx_free(pbi->row_mt_worker_data->jobq_buf);
+    }
 #if CONFIG_MULTITHREAD
-      pthread_mutex_destroy(&pbi->row_mt_worker_data->recon_done_mutex);
+    pthread_mutex_destroy(&pbi->row_mt_worker_data->recon_done_mutex);
 #endif
-    }
     vpx_free(pbi->row_mt_worker_data);
   }
 
@@ -491,6 +493,89 @@ int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
   return retcode;
 }
 
+int vp9_receive_compressed_header(VP9Decoder *pbi, size_t size,
+                                  const uint8_t **psource) {
+  VP9_COMMON *volatile const cm = &pbi->common;
+  BufferPool *volatile const pool = cm->buffer_pool;
+  RefCntBuffer *volatile const frame_bufs = cm->buffer_pool->frame_bufs;
+  const uint8_t *source = *psource;
+  cm->error.error_code = VPX_CODEC_OK;
+  pbi->tile_data = NULL;
+
+  // Find a free frame buffer. Return error if can not find any.
+  cm->new_fb_idx = get_free_fb(cm);
+  if (cm->new_fb_idx == INVALID_IDX) {
+    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                       "Unable to find free frame buffer");
+    return cm->error.error_code;
+  }
+
+  // Assign a MV array to the frame buffer.
+  cm->cur_frame = &pool->frame_bufs[cm->new_fb_idx];
+
+  pbi->hold_ref_buf = 0;
+  pbi->cur_buf = &frame_bufs[cm->new_fb_idx];
+
+  // Frames decoded later wait on the rows of this frame.
+  pbi->cur_buf->frame_worker_owner = pbi->frame_worker_owner;
+  vpx_atomic_store_release(&pbi->cur_buf->row, -1);
+  vpx_atomic_store_release(&pbi->cur_buf->parsed_row, -1);
+
+  if (setjmp(cm->error.jmp)) {
+    cm->error.setjmp = 0;
+    release_fb_on_decoder_exit(pbi);
+    vpx_atomic_store_release(&pbi->cur_buf->row, INT_MAX);
+    // Release current frame.
+    decrease_ref_count(cm->new_fb_idx, frame_bufs, pool);
+    vpx_clear_system_state();
+    return -1;
+  }
+
+  cm->error.setjmp = 1;
+  pbi->tile_data =
+      vp9_decode_frame_headers(pbi, source, source + size, psource);
+
+  // The new frame buffer is unused when showing an existing frame.
+  if (pbi->tile_data == NULL)
+    vpx_atomic_store_release(&pbi->cur_buf->row, INT_MAX);
+
+  vpx_clear_system_state();
+  cm->error.setjmp = 0;
+  return 0;
+}
+
+int vp9_receive_compressed_tiles(VP9Decoder *pbi, const uint8_t *data_end) {
+  VP9_COMMON *volatile const cm = &pbi->common;
+  const uint8_t *p_data_end;
+
+  if (setjmp(cm->error.jmp)) {
+    cm->error.setjmp = 0;
+    vpx_get_worker_interface()->sync(&pbi->lf_worker);
+    pbi->cur_buf->buf.corrupted = 1;
+    // Unblock the frames referencing this one, they are dropped as well.
+    vp9_frameworker_broadcast_parsed(pbi->cur_buf, INT_MAX);
+    vp9_frameworker_broadcast(pbi->cur_buf, INT_MAX);
+    vpx_clear_system_state();
+    return -1;
+  }
+
+  cm->error.setjmp = 1;
+  vp9_decode_frame_tiles(pbi, pbi->tile_data, data_end, &p_data_end);
+  vp9_frameworker_broadcast(pbi->cur_buf, INT_MAX);
+
+  vpx_clear_system_state();
+  cm->error.setjmp = 0;
+  return 0;
+}
+
+void vp9_finish_compressed_data(VP9Decoder *pbi) {
+  VP9_COMMON *const cm = &pbi->common;
+
+  swap_frame_buffers(pbi);
+
+  if (cm->show_frame) cm->cur_show_frame_fb_idx = cm->new_fb_idx;
+}
+
 int vp9_get_raw_frame(VP9Decoder *pbi, YV12_BUFFER_CONFIG *sd,
                       vp9_ppflags_t *flags) {
   VP9_COMMON *const cm = &pbi->common;
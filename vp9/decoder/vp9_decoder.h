@@ -13,8 +13,10 @@
 
 #include "./vpx_config.h"
 
+#include "vpx/vp8dx.h"
 #include "vpx/vpx_codec.h"
 #include "vpx_dsp/bitreader.h"
+#include "vpx_ports/vpx_timer.h"
 #include "vpx_scale/yv12config.h"
 #include "vpx_util/vpx_thread.h"
 
@@ -37,6 +39,8 @@ typedef struct ThreadData {
   struct VP9Decoder *pbi;
   LFWorkerData *lf_data;
   VP9LfSync *lf_sync;
+  // CPU time of the jobs run by the thread, when the stage timings are on.
+  int64_t stage_time[VP9D_STAGE_COUNT];
 } ThreadData;
 
 typedef struct TileBuffer {
@@ -52,6 +56,7 @@ typedef struct TileWorkerData {
   FRAME_COUNTS counts;
   LFWorkerData *lf_data;
   VP9LfSync *lf_sync;
+  int64_t lf_time;  // CPU time of the loop filter run by tile_worker_hook().
   DECLARE_ALIGNED(16, MACROBLOCKD, xd);
   /* dqcoeff are shared by all the planes. So planes must be decoded serially */
   DECLARE_ALIGNED(16, tran_low_t, dqcoeff[32 * 32]);
@@ -124,11 +129,40 @@ typedef struct VP9Decoder {
   int row_mt;
   int lpf_mt_opt;
   RowMTWorkerData *row_mt_worker_data;
+
+  // When set, the tile and loop filter workers run on this application owned
+  // pool instead of dedicated threads.
+  VPxThreadPool *thread_pool;
+
+  int frame_parallel_decode;      // frame-based threading.
+  int pipeline_decode;            // parse frames ahead of reconstruction.
+  VPxWorker *frame_worker_owner;  // frame worker owning this decoder.
+  const uint8_t *tile_data;       // tile data of the parsed frame.
+
+  // See VP9D_SET_STAGE_TIMINGS. The stage times are added up over the frames
+  // decoded since they were last reset.
+  int stage_timing;
+  int64_t stage_time[VP9D_STAGE_COUNT];
 } VP9Decoder;
 
 int vp9_receive_compressed_data(struct VP9Decoder *pbi, size_t size,
                                 const uint8_t **psource);
 
+// Frame parallel decode splits vp9_receive_compressed_data() in three steps.
+// The frame headers are parsed on the calling thread, the tile data is then
+// decoded on the frame worker thread and the reference buffers are updated
+// once all the previous frames in decode order are finished.
+// With pipeline_decode the frame worker parses all the tile data before
+// reconstructing the frame, so that the headers of the next frame can be
+// parsed as soon as the frame contexts are adapted.
+int vp9_receive_compressed_header(struct VP9Decoder *pbi, size_t size,
+                                  const uint8_t **psource);
+
+int vp9_receive_compressed_tiles(struct VP9Decoder *pbi,
+                                 const uint8_t *data_end);
+
+void vp9_finish_compressed_data(struct VP9Decoder *pbi);
+
 int vp9_get_raw_frame(struct VP9Decoder *pbi, YV12_BUFFER_CONFIG *sd,
                       vp9_ppflags_t *flags);
 
@@ -166,6 +200,18 @@ void vp9_dec_alloc_row_mt_mem(RowMTWorkerData *row_mt_worker_data,
                               int num_jobs);
 void vp9_dec_free_row_mt_mem(RowMTWorkerData *row_mt_worker_data);
 
+// Returns the CPU time of the calling thread when the stage timings are on,
+// 0 otherwise.
+static INLINE int64_t vp9_dec_stage_clock(const struct VP9Decoder *pbi) {
+  return pbi->stage_timing ? vpx_thread_cpu_time_usec() : 0;
+}
+
+// Where the frame buffer waits add their time, NULL when the stage timings
+// are off.
+static INLINE int64_t *vp9_dec_wait_time(struct VP9Decoder *pbi) {
+  return pbi->stage_timing ? &pbi->stage_time[VP9D_STAGE_FRAME_WAIT] : NULL;
+}
+
 static INLINE void decrease_ref_count(int idx, RefCntBuffer *const frame_bufs,
                                       BufferPool *const pool) {
   if (idx >= 0 && frame_bufs[idx].ref_count > 0) {
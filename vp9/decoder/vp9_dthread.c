@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/vpx_timer.h"
+#include "vp9/common/vp9_onyxc_int.h"
+#include "vp9/decoder/vp9_decoder.h"
+#include "vp9/decoder/vp9_dthread.h"
+
+int vp9_frameworker_init(FrameWorkerData *const frame_worker_data,
+                         BufferPool *const pool) {
+  memset(frame_worker_data, 0, sizeof(*frame_worker_data));
+  frame_worker_data->pbi = vp9_decoder_create(pool);
+  if (frame_worker_data->pbi == NULL) return 0;
+  frame_worker_data->prev_fb_idx = INVALID_IDX;
+#if CONFIG_MULTITHREAD
+  if (pthread_mutex_init(&frame_worker_data->stats_mutex, NULL)) {
+    vp9_decoder_remove(frame_worker_data->pbi);
+    frame_worker_data->pbi = NULL;
+    return 0;
+  }
+  if (pthread_cond_init(&frame_worker_data->stats_cond, NULL)) {
+    pthread_mutex_destroy(&frame_worker_data->stats_mutex);
+    vp9_decoder_remove(frame_worker_data->pbi);
+    frame_worker_data->pbi = NULL;
+    return 0;
+  }
+#endif
+  return 1;
+}
+
+void vp9_frameworker_remove(FrameWorkerData *const frame_worker_data) {
+  if (frame_worker_data->pbi == NULL) return;
+  vp9_decoder_remove(frame_worker_data->pbi);
+  frame_worker_data->pbi = NULL;
+  vpx_free(frame_worker_data->scratch_buffer);
+  frame_worker_data->scratch_buffer = NULL;
+  frame_worker_data->scratch_buffer_size = 0;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_destroy(&frame_worker_data->stats_mutex);
+  pthread_cond_destroy(&frame_worker_data->stats_cond);
+#endif
+}
+
+void vp9_frameworker_wait(RefCntBuffer *const ref_buf, int row,
+                          int64_t *wait_time) {
+#if CONFIG_MULTITHREAD
+  FrameWorkerData *owner_data;
+  struct vpx_usec_timer timer;
+
+  if (vpx_atomic_load_acquire(&ref_buf->row) >= row) return;
+
+  if (wait_time != NULL) vpx_usec_timer_start(&timer);
+  owner_data = (FrameWorkerData *)ref_buf->frame_worker_owner->data1;
+  pthread_mutex_lock(&owner_data->stats_mutex);
+  while (vpx_atomic_load_acquire(&ref_buf->row) < row)
+    pthread_cond_wait(&owner_data->stats_cond, &owner_data->stats_mutex);
+  pthread_mutex_unlock(&owner_data->stats_mutex);
+  if (wait_time != NULL) {
+    vpx_usec_timer_mark(&timer);
+    *wait_time += vpx_usec_timer_elapsed(&timer);
+  }
+#else
+  (void)ref_buf;
+  (void)row;
+  (void)wait_time;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp9_frameworker_broadcast(RefCntBuffer *const buf, int row) {
+#if CONFIG_MULTITHREAD
+  FrameWorkerData *const owner_data =
+      (FrameWorkerData *)buf->frame_worker_owner->data1;
+
+  pthread_mutex_lock(&owner_data->stats_mutex);
+  vpx_atomic_store_release(&buf->row, row);
+  pthread_cond_broadcast(&owner_data->stats_cond);
+  pthread_mutex_unlock(&owner_data->stats_mutex);
+#else
+  vpx_atomic_store_release(&buf->row, row);
+#endif  // CONFIG_MULTITHREAD
+}
+
+static INLINE int get_parsed_row(RefCntBuffer *const buf) {
+  return VPXMAX(vpx_atomic_load_acquire(&buf->parsed_row),
+                vpx_atomic_load_acquire(&buf->row));
+}
+
+void vp9_frameworker_wait_parsed(RefCntBuffer *const buf, int row,
+                                 int64_t *wait_time) {
+#if CONFIG_MULTITHREAD
+  FrameWorkerData *owner_data;
+  struct vpx_usec_timer timer;
+
+  if (get_parsed_row(buf) >= row) return;
+
+  if (wait_time != NULL) vpx_usec_timer_start(&timer);
+  owner_data = (FrameWorkerData *)buf->frame_worker_owner->data1;
+  pthread_mutex_lock(&owner_data->stats_mutex);
+  while (get_parsed_row(buf) < row)
+    pthread_cond_wait(&owner_data->stats_cond, &owner_data->stats_mutex);
+  pthread_mutex_unlock(&owner_data->stats_mutex);
+  if (wait_time != NULL) {
+    vpx_usec_timer_mark(&timer);
+    *wait_time += vpx_usec_timer_elapsed(&timer);
+  }
+#else
+  (void)buf;
+  (void)row;
+  (void)wait_time;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp9_frameworker_broadcast_parsed(RefCntBuffer *const buf, int row) {
+#if CONFIG_MULTITHREAD
+  FrameWorkerData *const owner_data =
+      (FrameWorkerData *)buf->frame_worker_owner->data1;
+
+  pthread_mutex_lock(&owner_data->stats_mutex);
+  vpx_atomic_store_release(&buf->parsed_row, row);
+  pthread_cond_broadcast(&owner_data->stats_cond);
+  pthread_mutex_unlock(&owner_data->stats_mutex);
+#else
+  vpx_atomic_store_release(&buf->parsed_row, row);
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp9_frameworker_copy_context(VPxWorker *const dst_worker,
+                                  VPxWorker *const src_worker) {
+  VP9Decoder *const src_pbi = ((FrameWorkerData *)src_worker->data1)->pbi;
+  VP9Decoder *const dst_pbi = ((FrameWorkerData *)dst_worker->data1)->pbi;
+  const VP9_COMMON *const src_cm = &src_pbi->common;
+  VP9_COMMON *const dst_cm = &dst_pbi->common;
+
+  dst_pbi->need_resync = src_pbi->need_resync;
+
+  // A frame showing an existing frame leaves the reference map and the
+  // previous frame information untouched.
+  if (src_cm->show_existing_frame) {
+    memcpy(dst_cm->ref_frame_map, src_cm->ref_frame_map,
+           sizeof(src_cm->ref_frame_map));
+    dst_cm->last_show_frame = src_cm->last_show_frame;
+    dst_cm->prev_frame = src_cm->prev_frame;
+    dst_cm->last_width = src_cm->last_width;
+    dst_cm->last_height = src_cm->last_height;
+  } else {
+    memcpy(dst_cm->ref_frame_map, src_cm->next_ref_frame_map,
+           sizeof(src_cm->next_ref_frame_map));
+    dst_cm->last_show_frame = src_cm->show_frame;
+    dst_cm->prev_frame = src_cm->cur_frame;
+    dst_cm->last_width = src_cm->width;
+    dst_cm->last_height = src_cm->height;
+  }
+  dst_cm->current_video_frame =
+      src_cm->current_video_frame + (src_cm->show_frame ? 1 : 0);
+
+  dst_cm->frame_type = src_cm->frame_type;
+  dst_cm->intra_only = src_cm->intra_only;
+  dst_cm->profile = src_cm->profile;
+  dst_cm->bit_depth = src_cm->bit_depth;
+#if CONFIG_VP9_HIGHBITDEPTH
+  dst_cm->use_highbitdepth = src_cm->use_highbitdepth;
+#endif
+  dst_cm->subsampling_x = src_cm->subsampling_x;
+  dst_cm->subsampling_y = src_cm->subsampling_y;
+  dst_cm->color_space = src_cm->color_space;
+  dst_cm->color_range = src_cm->color_range;
+
+  memcpy(dst_cm->ref_frame_sign_bias, src_cm->ref_frame_sign_bias,
+         sizeof(src_cm->ref_frame_sign_bias));
+  memcpy(dst_cm->lf.ref_deltas, src_cm->lf.ref_deltas,
+         sizeof(src_cm->lf.ref_deltas));
+  memcpy(dst_cm->lf.mode_deltas, src_cm->lf.mode_deltas,
+         sizeof(src_cm->lf.mode_deltas));
+  dst_cm->seg = src_cm->seg;
+  memcpy(dst_cm->frame_contexts, src_cm->frame_contexts,
+         FRAME_CONTEXTS * sizeof(src_cm->frame_contexts[0]));
+}
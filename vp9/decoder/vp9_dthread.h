@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_DECODER_VP9_DTHREAD_H_
+#define VPX_VP9_DECODER_VP9_DTHREAD_H_
+
+#include "./vpx_config.h"
+#include "vpx_util/vpx_thread.h"
+#include "vp9/common/vp9_onyxc_int.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct VP9Decoder;
+
+// WorkerData for the frame parallel decode. Each frame worker owns a decoder
+// instance and decodes the tile data of one frame at a time.
+typedef struct FrameWorkerData {
+  struct VP9Decoder *pbi;
+  const uint8_t *data;
+  const uint8_t *data_end;
+  void *user_priv;
+  int result;
+  // Set when the tile data of the current frame is decoded by the worker
+  // thread. Frames that show an existing frame are finished on the calling
+  // thread.
+  int launched;
+  // Frame buffer holding the motion vectors of the previous frame. It is kept
+  // referenced until this frame has been decoded.
+  int prev_fb_idx;
+
+  // The compressed data of the frame is copied here so that the application
+  // can reuse its buffer once vpx_codec_decode() returns.
+  uint8_t *scratch_buffer;
+  size_t scratch_buffer_size;
+
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t stats_mutex;
+  pthread_cond_t stats_cond;
+#endif
+} FrameWorkerData;
+
+// Allocates the decoder and the synchronization objects of a frame worker.
+// Returns 0 on failure.
+int vp9_frameworker_init(FrameWorkerData *const frame_worker_data,
+                         BufferPool *const pool);
+
+void vp9_frameworker_remove(FrameWorkerData *const frame_worker_data);
+
+// Waits until the rows above 'row' of the reference frame are reconstructed.
+// 'row' is in luma pixels. If 'wait_time' is not NULL the time spent blocked
+// is added to it, in microseconds.
+void vp9_frameworker_wait(RefCntBuffer *const ref_buf, int row,
+                          int64_t *wait_time);
+
+// Signals the workers waiting on 'buf' that the rows above 'row' are
+// reconstructed. Use INT_MAX once the whole frame is done.
+void vp9_frameworker_broadcast(RefCntBuffer *const buf, int row);
+
+// Pipelined decode: waits until the mode info of the rows above 'row' of the
+// frame is parsed. Reconstructed rows are parsed as well. 'wait_time' is
+// updated as by vp9_frameworker_wait().
+void vp9_frameworker_wait_parsed(RefCntBuffer *const buf, int row,
+                                 int64_t *wait_time);
+
+// Signals the threads waiting on 'buf' that the mode info of the rows above
+// 'row' is parsed. Use INT_MAX once the frame contexts are adapted as well.
+void vp9_frameworker_broadcast_parsed(RefCntBuffer *const buf, int row);
+
+// Copies the decoder state that carries over from one frame to the next from
+// the worker holding the previous frame in decode order to the worker that is
+// about to parse the next frame.
+void vp9_frameworker_copy_context(VPxWorker *const dst_worker,
+                                  VPxWorker *const src_worker);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_DECODER_VP9_DTHREAD_H_
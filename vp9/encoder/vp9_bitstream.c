@@ -939,23 +939,62 @@ int vp9_get_refresh_mask(VP9_COMP *cpi) {
   }
 }
 
+// Tile rows are coded with the partition context left by the tile row above,
+// so each worker packs whole tile columns, from the top tile row down. The
+// tiles are written one after the other in the worker's buffer.
 static int encode_tile_worker(void *arg1, void *arg2) {
   VP9_COMP *cpi = (VP9_COMP *)arg1;
   VP9BitstreamWorkerData *data = (VP9BitstreamWorkerData *)arg2;
+  const VP9_COMMON *const cm = &cpi->common;
   MACROBLOCKD *const xd = &data->xd;
-  const int tile_row = 0;
-  vpx_start_encode(&data->bit_writer, data->dest);
-  write_modes(cpi, xd, &cpi->tile_data[data->tile_idx].tile_info,
-              &data->bit_writer, tile_row, data->tile_idx,
-              &data->max_mv_magnitude, data->interp_filter_selected);
-  vpx_stop_encode(&data->bit_writer);
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  uint8_t *dest = data->dest;
+  int tile_row, tile_col;
+
+  for (tile_col = data->tile_idx; tile_col < tile_cols;
+       tile_col += data->tile_col_step) {
+    for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+      const int tile_idx = tile_row * tile_cols + tile_col;
+      vpx_start_encode(&data->bit_writer, dest);
+      write_modes(cpi, xd, &cpi->tile_data[tile_idx].tile_info,
+                  &data->bit_writer, tile_row, tile_col,
+                  &data->max_mv_magnitude, data->interp_filter_selected);
+      vpx_stop_encode(&data->bit_writer);
+      data->tile_bufs[tile_idx] = dest;
+      data->tile_sizes[tile_idx] = data->bit_writer.pos;
+      dest += data->bit_writer.pos;
+    }
+  }
   return 1;
 }
 
+// A worker packs up to ceil(tile_cols / num_workers) whole tile columns. Its
+// buffer gets that share of the compressed frame bound, i.e. twice the raw
+// size of the pixels in its tiles, as the output buffer in vp9_cx_iface.c.
+static size_t get_tiles_buffer_size(const VP9_COMP *const cpi,
+                                    int num_workers) {
+  const VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
+  // The widest tile column, in superblocks.
+  const int tile_sb_cols = (sb_cols + tile_cols - 1) >> cm->log2_tile_cols;
+  const int worker_cols = (tile_cols + num_workers - 1) / num_workers;
+  const int width = worker_cols * tile_sb_cols * MI_BLOCK_SIZE * MI_SIZE;
+  const int height = mi_cols_aligned_to_sb(cm->mi_rows) * MI_SIZE;
+  const size_t luma_size = (size_t)width * height;
+  size_t size =
+      luma_size + 2 * (luma_size >> (cm->subsampling_x + cm->subsampling_y));
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (cm->use_highbitdepth) size *= 2;
+#endif
+  return size * 2;
+}
+
 void vp9_bitstream_encode_tiles_buffer_dealloc(VP9_COMP *const cpi) {
   if (cpi->vp9_bitstream_worker_data) {
     int i;
-    for (i = 1; i < cpi->num_workers; ++i) {
+    for (i = 0; i < cpi->num_workers; ++i) {
       vpx_free(cpi->vp9_bitstream_worker_data[i].dest);
     }
     vpx_free(cpi->vp9_bitstream_worker_data);
@@ -963,16 +1002,16 @@ void vp9_bitstream_encode_tiles_buffer_dealloc(VP9_COMP *const cpi) {
   }
 }
 
-static int encode_tiles_buffer_alloc(VP9_COMP *const cpi) {
+static int encode_tiles_buffer_alloc(VP9_COMP *const cpi, int num_workers) {
+  const size_t dest_size = get_tiles_buffer_size(cpi, num_workers);
   int i;
   const size_t worker_data_size =
       cpi->num_workers * sizeof(*cpi->vp9_bitstream_worker_data);
   cpi->vp9_bitstream_worker_data = vpx_memalign(16, worker_data_size);
-  memset(cpi->vp9_bitstream_worker_data, 0, worker_data_size);
   if (!cpi->vp9_bitstream_worker_data) return 1;
-  for (i = 1; i < cpi->num_workers; ++i) {
-    cpi->vp9_bitstream_worker_data[i].dest_size =
-        cpi->oxcf.width * cpi->oxcf.height;
+  memset(cpi->vp9_bitstream_worker_data, 0, worker_data_size);
+  for (i = 0; i < cpi->num_workers; ++i) {
+    cpi->vp9_bitstream_worker_data[i].dest_size = dest_size;
     cpi->vp9_bitstream_worker_data[i].dest =
         vpx_malloc(cpi->vp9_bitstream_worker_data[i].dest_size);
     if (!cpi->vp9_bitstream_worker_data[i].dest) return 1;
@@ -984,76 +1023,73 @@ static size_t encode_tiles_mt(VP9_COMP *cpi, uint8_t *data_ptr) {
   const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
   VP9_COMMON *const cm = &cpi->common;
   const int tile_cols = 1 << cm->log2_tile_cols;
-  const int num_workers = cpi->num_workers;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  const int num_tiles = tile_rows * tile_cols;
+  const int num_workers = VPXMIN(cpi->num_workers, tile_cols);
+  uint8_t *tile_bufs[MAX_NUM_TILE_ROWS * MAX_NUM_TILE_COLS];
+  unsigned int tile_sizes[MAX_NUM_TILE_ROWS * MAX_NUM_TILE_COLS];
   size_t total_size = 0;
-  int tile_col = 0;
+  int i, k, tile_idx;
 
   if (!cpi->vp9_bitstream_worker_data ||
-      cpi->vp9_bitstream_worker_data[1].dest_size >
-          (cpi->oxcf.width * cpi->oxcf.height)) {
+      cpi->vp9_bitstream_worker_data[0].dest_size !=
+          get_tiles_buffer_size(cpi, num_workers)) {
     vp9_bitstream_encode_tiles_buffer_dealloc(cpi);
-    if (encode_tiles_buffer_alloc(cpi)) return 0;
+    if (encode_tiles_buffer_alloc(cpi, num_workers)) return 0;
   }
 
-  while (tile_col < tile_cols) {
-    int i, j;
-    for (i = 0; i < num_workers && tile_col < tile_cols; ++i) {
-      VPxWorker *const worker = &cpi->workers[i];
-      VP9BitstreamWorkerData *const data = &cpi->vp9_bitstream_worker_data[i];
-
-      // Populate the worker data.
-      data->xd = cpi->td.mb.e_mbd;
-      data->tile_idx = tile_col;
-      data->max_mv_magnitude = cpi->max_mv_magnitude;
-      memset(data->interp_filter_selected, 0,
-             sizeof(data->interp_filter_selected[0][0]) * SWITCHABLE);
-
-      // First thread can directly write into the output buffer.
-      if (i == 0) {
-        // If this worker happens to be for the last tile, then do not offset it
-        // by 4 for the tile size.
-        data->dest =
-            data_ptr + total_size + (tile_col == tile_cols - 1 ? 0 : 4);
-      }
-      worker->data1 = cpi;
-      worker->data2 = data;
-      worker->hook = encode_tile_worker;
-      worker->had_error = 0;
-
-      if (i < num_workers - 1) {
-        winterface->launch(worker);
-      } else {
-        winterface->execute(worker);
-      }
-      ++tile_col;
+  // All the tile columns are handed out at once, so no worker waits for the
+  // others until the whole frame is packed.
+  for (i = 0; i < num_workers; ++i) {
+    VPxWorker *const worker = &cpi->workers[i];
+    VP9BitstreamWorkerData *const data = &cpi->vp9_bitstream_worker_data[i];
+
+    // Populate the worker data.
+    data->xd = cpi->td.mb.e_mbd;
+    data->tile_idx = i;
+    data->tile_col_step = num_workers;
+    data->tile_bufs = tile_bufs;
+    data->tile_sizes = tile_sizes;
+    data->max_mv_magnitude = cpi->max_mv_magnitude;
+    memset(data->interp_filter_selected, 0,
+           sizeof(data->interp_filter_selected[0][0]) * SWITCHABLE);
+
+    worker->data1 = cpi;
+    worker->data2 = data;
+    worker->hook = encode_tile_worker;
+    worker->had_error = 0;
+
+    if (i < num_workers - 1) {
+      winterface->launch(worker);
+    } else {
+      winterface->execute(worker);
     }
-    for (j = 0; j < i; ++j) {
-      VPxWorker *const worker = &cpi->workers[j];
-      VP9BitstreamWorkerData *const data =
-          (VP9BitstreamWorkerData *)worker->data2;
-      uint32_t tile_size;
-      int k;
-
-      if (!winterface->sync(worker)) return 0;
-      tile_size = data->bit_writer.pos;
-
-      // Aggregate per-thread bitstream stats.
-      cpi->max_mv_magnitude =
-          VPXMAX(cpi->max_mv_magnitude, data->max_mv_magnitude);
-      for (k = 0; k < SWITCHABLE; ++k) {
-        cpi->interp_filter_selected[0][k] += data->interp_filter_selected[0][k];
-      }
+  }
 
-      // Prefix the size of the tile on all but the last.
-      if (tile_col != tile_cols || j < i - 1) {
-        mem_put_be32(data_ptr + total_size, tile_size);
-        total_size += 4;
-      }
-      if (j > 0) {
-        memcpy(data_ptr + total_size, data->dest, tile_size);
-      }
-      total_size += tile_size;
+  for (i = 0; i < num_workers; ++i) {
+    VPxWorker *const worker = &cpi->workers[i];
+    VP9BitstreamWorkerData *const data =
+        (VP9BitstreamWorkerData *)worker->data2;
+
+    if (!winterface->sync(worker)) return 0;
+
+    // Aggregate per-thread bitstream stats.
+    cpi->max_mv_magnitude =
+        VPXMAX(cpi->max_mv_magnitude, data->max_mv_magnitude);
+    for (k = 0; k < SWITCHABLE; ++k) {
+      cpi->interp_filter_selected[0][k] += data->interp_filter_selected[0][k];
+    }
+  }
+
+  // Write the tiles in raster order.
+  for (tile_idx = 0; tile_idx < num_tiles; ++tile_idx) {
+    // Prefix the size of the tile on all but the last.
+    if (tile_idx < num_tiles - 1) {
+      mem_put_be32(data_ptr + total_size, tile_sizes[tile_idx]);
+      total_size += 4;
     }
+    memcpy(data_ptr + total_size, tile_bufs[tile_idx], tile_sizes[tile_idx]);
+    total_size += tile_sizes[tile_idx];
   }
   return total_size;
 }
@@ -1073,8 +1109,7 @@ static size_t encode_tiles(VP9_COMP *cpi, uint8_t *data_ptr) {
   // Encoding tiles in parallel is done only for realtime mode now. In other
   // modes the speed up is insignificant and requires further testing to ensure
   // that it does not make the overall process worse in any case.
-  if (cpi->oxcf.mode == REALTIME && cpi->num_workers > 1 && tile_rows == 1 &&
-      tile_cols > 1) {
+  if (cpi->oxcf.mode == REALTIME && cpi->num_workers > 1 && tile_cols > 1) {
     return encode_tiles_mt(cpi, data_ptr);
   }
 
@@ -1370,6 +1405,8 @@ void vp9_pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size) {
     return;
   }
 
+  vp9_stage_timing_start(cpi, VP9E_STAGE_PACK_BITSTREAM);
+
   saved_wb = wb;
   vpx_wb_write_literal(&wb, 0, 16);  // don't know in advance first part. size
 
@@ -1386,4 +1423,6 @@ void vp9_pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size) {
   data += encode_tiles(cpi, data);
 
   *size = data - dest;
+
+  vp9_stage_timing_end(cpi, VP9E_STAGE_PACK_BITSTREAM);
 }
@@ -19,9 +19,14 @@ extern "C" {
 
 typedef struct VP9BitstreamWorkerData {
   uint8_t *dest;
-  int dest_size;
+  size_t dest_size;
   vpx_writer bit_writer;
+  // The worker packs the tile columns tile_idx, tile_idx + tile_col_step, ...
+  // and records where each tile was written, indexed by tile.
   int tile_idx;
+  int tile_col_step;
+  uint8_t **tile_bufs;
+  unsigned int *tile_sizes;
   unsigned int max_mv_magnitude;
   // The size of interp_filter_selected in VP9_COMP is actually
   // MAX_REFERENCE_FRAMES x SWITCHABLE. But when encoding tiles, all we ever do
@@ -2524,7 +2524,8 @@ static void update_state_rt(VP9_COMP *cpi, ThreadData *td,
 
   if (cm->use_prev_frame_mvs || !cm->error_resilient_mode ||
       (cpi->svc.use_base_mv && cpi->svc.number_spatial_layers > 1 &&
-       cpi->svc.spatial_layer_id != cpi->svc.number_spatial_layers - 1)) {
+       cpi->svc.spatial_layer_id != cpi->svc.number_spatial_layers - 1) ||
+      cpi->oxcf.mr_info != NULL) {
     MV_REF *const frame_mvs =
         cm->cur_frame->mvs + mi_row * cm->mi_cols + mi_col;
     int w, h;
@@ -6186,6 +6187,8 @@ static void restore_encode_params(VP9_COMP *cpi) {
 void vp9_encode_frame(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
 
+  vp9_stage_timing_start(cpi, VP9E_STAGE_ENCODE_FRAME);
+
 #if CONFIG_RATE_CTRL
   if (cpi->oxcf.use_simple_encode_api) {
     restore_encode_params(cpi);
@@ -6340,6 +6343,8 @@ void vp9_encode_frame(VP9_COMP *cpi) {
       (cm->seg.update_map || cm->seg.update_data)) {
     cm->seg.aq_av_offset = compute_frame_aq_offset(cpi);
   }
+
+  vp9_stage_timing_end(cpi, VP9E_STAGE_ENCODE_FRAME);
 }
 
 static void sum_intra_stats(FRAME_COUNTS *counts, const MODE_INFO *mi) {
@@ -2805,6 +2805,7 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
   }
   vpx_free(cpi->tile_thr_data);
   vpx_free(cpi->workers);
+  if (!cpi->external_thread_pool) vpx_thread_pool_destroy(cpi->thread_pool);
   vp9_row_mt_mem_dealloc(cpi);
 
   if (cpi->num_workers > 1) {
@@ -5600,7 +5601,9 @@ static void encode_frame_to_data_rate(
   cm->frame_to_show->render_height = cm->render_height;
 
   // Pick the loop filter level for the frame.
+  vp9_stage_timing_start(cpi, VP9E_STAGE_LOOP_FILTER);
   loopfilter_frame(cpi, cm);
+  vp9_stage_timing_end(cpi, VP9E_STAGE_LOOP_FILTER);
 
   if (cpi->rc.use_post_encode_drop) save_coding_context(cpi);
 
@@ -5831,10 +5834,29 @@ static void Pass2Encode(VP9_COMP *cpi, size_t *size, uint8_t *dest,
 }
 #endif  // !CONFIG_REALTIME_ONLY
 
-int vp9_receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
-                          YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time) {
+static int check_raw_frame_format(VP9_COMP *cpi, int subsampling_x,
+                                  int subsampling_y) {
   VP9_COMMON *const cm = &cpi->common;
+  int res = 0;
+  if ((cm->profile == PROFILE_0 || cm->profile == PROFILE_2) &&
+      (subsampling_x != 1 || subsampling_y != 1)) {
+    vpx_internal_error(&cm->error, VPX_CODEC_INVALID_PARAM,
+                       "Non-4:2:0 color format requires profile 1 or 3");
+    res = -1;
+  }
+  if ((cm->profile == PROFILE_1 || cm->profile == PROFILE_3) &&
+      (subsampling_x == 1 && subsampling_y == 1)) {
+    vpx_internal_error(&cm->error, VPX_CODEC_INVALID_PARAM,
+                       "4:2:0 color format requires profile 0 or 2");
+    res = -1;
+  }
+  return res;
+}
+
+// Queues 'sd' in the lookahead, by reference when 'by_ref' is set.
+static int receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
+                             YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
+                             int64_t end_time, int by_ref, void *img_priv) {
   struct vpx_usec_timer timer;
   int res = 0;
   const int subsampling_x = sd->subsampling_x;
@@ -5852,30 +5874,47 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
 
   alloc_raw_frame_buffers(cpi);
 
-  vpx_usec_timer_start(&timer);
+  // A referenced frame must not be queued if an error follows.
+  if (by_ref) {
+    if (check_raw_frame_format(cpi, subsampling_x, subsampling_y)) return -1;
+    cpi->lookahead->release_cb = cpi->source_release_cb;
+  }
 
-  if (vp9_lookahead_push(cpi->lookahead, sd, time_stamp, end_time,
-                         use_highbitdepth, frame_flags))
+  vpx_usec_timer_start(&timer);
+  vp9_stage_timing_start(cpi, VP9E_STAGE_LOOKAHEAD);
+
+  if (by_ref) {
+    if (vp9_lookahead_push_ref(cpi->lookahead, sd, time_stamp, end_time,
+                               frame_flags, img_priv))
+      res = -1;
+  } else if (vp9_lookahead_push(cpi->lookahead, sd, time_stamp, end_time,
+                                use_highbitdepth, frame_flags)) {
     res = -1;
+  }
+  vp9_stage_timing_end(cpi, VP9E_STAGE_LOOKAHEAD);
   vpx_usec_timer_mark(&timer);
   cpi->time_receive_data += vpx_usec_timer_elapsed(&timer);
 
-  if ((cm->profile == PROFILE_0 || cm->profile == PROFILE_2) &&
-      (subsampling_x != 1 || subsampling_y != 1)) {
-    vpx_internal_error(&cm->error, VPX_CODEC_INVALID_PARAM,
-                       "Non-4:2:0 color format requires profile 1 or 3");
-    res = -1;
-  }
-  if ((cm->profile == PROFILE_1 || cm->profile == PROFILE_3) &&
-      (subsampling_x == 1 && subsampling_y == 1)) {
-    vpx_internal_error(&cm->error, VPX_CODEC_INVALID_PARAM,
-                       "4:2:0 color format requires profile 0 or 2");
+  if (!by_ref && check_raw_frame_format(cpi, subsampling_x, subsampling_y))
     res = -1;
-  }
 
   return res;
 }
 
+int vp9_receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
+                          YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
+                          int64_t end_time) {
+  return receive_raw_frame(cpi, frame_flags, sd, time_stamp, end_time, 0,
+                           NULL);
+}
+
+int vp9_receive_raw_frame_ref(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
+                              YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
+                              int64_t end_time, void *img_priv) {
+  return receive_raw_frame(cpi, frame_flags, sd, time_stamp, end_time, 1,
+                           img_priv);
+}
+
 static int frame_is_reference(const VP9_COMP *cpi) {
   const VP9_COMMON *cm = &cpi->common;
 
@@ -6686,7 +6725,7 @@ static void set_mv_limits(const VP9_COMMON *cm, MACROBLOCK *x, int mi_row,
       ((cm->mi_cols - 1 - mi_col) * MI_SIZE) + (17 - 2 * VP9_INTERP_EXTEND);
 }
 
-static void mode_estimation(VP9_COMP *cpi, MACROBLOCK *x, MACROBLOCKD *xd,
+static void mode_estimation(VP9_COMP *cpi, ThreadData *td,
                             struct scale_factors *sf, GF_PICTURE *gf_picture,
                             int frame_idx, TplDepFrame *tpl_frame,
                             int16_t *src_diff, tran_low_t *coeff,
@@ -6695,7 +6734,8 @@ static void mode_estimation(VP9_COMP *cpi, MACROBLOCK *x, MACROBLOCKD *xd,
                             YV12_BUFFER_CONFIG *ref_frame[], uint8_t *predictor,
                             int64_t *recon_error, int64_t *sse) {
   VP9_COMMON *cm = &cpi->common;
-  ThreadData *td = &cpi->td;
+  MACROBLOCK *x = &td->mb;
+  MACROBLOCKD *xd = &x->e_mbd;
 
   const int bw = 4 << b_width_log2_lookup[bsize];
   const int bh = 4 << b_height_log2_lookup[bsize];
@@ -7247,19 +7287,17 @@ static void build_motion_field(
 }
 #endif  // CONFIG_NON_GREEDY_MV
 
-static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
-                              int frame_idx, BLOCK_SIZE bsize) {
+void vp9_mc_flow_dispenser_row(VP9_COMP *cpi, ThreadData *td, int mi_row) {
+  TplFlowData *const flow_data = &cpi->tpl_flow_data;
+  const int frame_idx = flow_data->frame_idx;
+  const BLOCK_SIZE bsize = cpi->tpl_bsize;
   TplDepFrame *tpl_frame = &cpi->tpl_stats[frame_idx];
-  YV12_BUFFER_CONFIG *this_frame = gf_picture[frame_idx].frame;
-  YV12_BUFFER_CONFIG *ref_frame[MAX_INTER_REF_FRAMES] = { NULL, NULL, NULL };
-
   VP9_COMMON *cm = &cpi->common;
-  struct scale_factors sf;
-  int rdmult, idx;
-  ThreadData *td = &cpi->td;
-  MACROBLOCK *x = &td->mb;
-  MACROBLOCKD *xd = &x->e_mbd;
-  int mi_row, mi_col;
+  MACROBLOCKD *xd = &td->mb.e_mbd;
+  MODE_INFO **const mi_grid = xd->mi;
+  MODE_INFO mi;
+  MODE_INFO *mi_ptr = &mi;
+  int mi_col;
 
 #if CONFIG_VP9_HIGHBITDEPTH
   DECLARE_ALIGNED(16, uint16_t, predictor16[32 * 32 * 3]);
@@ -7274,28 +7312,77 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   DECLARE_ALIGNED(16, tran_low_t, dqcoeff[32 * 32]);
 
   const TX_SIZE tx_size = max_txsize_lookup[bsize];
-  const int mi_height = num_8x8_blocks_high_lookup[bsize];
   const int mi_width = num_8x8_blocks_wide_lookup[bsize];
   int64_t recon_error, sse;
+
+  // The mode info is written for every block, so each thread uses its own.
+  vp9_zero(mi);
+  xd->mi = &mi_ptr;
+  xd->cur_buf = flow_data->this_frame;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH)
+    predictor = CONVERT_TO_BYTEPTR(predictor16);
+  else
+    predictor = predictor8;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+  for (mi_col = 0; mi_col < cm->mi_cols; mi_col += mi_width) {
+    mode_estimation(cpi, td, &flow_data->sf, flow_data->gf_picture, frame_idx,
+                    tpl_frame, src_diff, coeff, qcoeff, dqcoeff, mi_row, mi_col,
+                    bsize, tx_size, flow_data->ref_frame, predictor,
+                    &recon_error, &sse);
+    tpl_model_store(tpl_frame->tpl_stats_ptr, mi_row, mi_col, bsize,
+                    tpl_frame->stride);
+  }
+
+  xd->mi = mi_grid;
+}
+
+void vp9_tpl_model_update_row(VP9_COMP *cpi, int mi_row) {
+  TplDepFrame *tpl_frame = &cpi->tpl_stats[cpi->tpl_flow_data.frame_idx];
+  const int mi_width = num_8x8_blocks_wide_lookup[cpi->tpl_bsize];
+  int mi_col;
+
+  // Motion flow dependency dispenser.
+  for (mi_col = 0; mi_col < cpi->common.mi_cols; mi_col += mi_width) {
+    tpl_model_update(cpi->tpl_stats, tpl_frame->tpl_stats_ptr, mi_row, mi_col,
+                     cpi->tpl_bsize);
+  }
+}
+
+static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
+                              int frame_idx, BLOCK_SIZE bsize) {
+  TplDepFrame *tpl_frame = &cpi->tpl_stats[frame_idx];
+  TplFlowData *const flow_data = &cpi->tpl_flow_data;
+  YV12_BUFFER_CONFIG *this_frame = gf_picture[frame_idx].frame;
+
+  VP9_COMMON *cm = &cpi->common;
+  int rdmult, idx;
+  ThreadData *td = &cpi->td;
+  MACROBLOCK *x = &td->mb;
+  MACROBLOCKD *xd = &x->e_mbd;
+  int mi_row;
+  const int mi_height = num_8x8_blocks_high_lookup[bsize];
 #if CONFIG_NON_GREEDY_MV
   int square_block_idx;
   int rf_idx;
 #endif
 
+  assert(bsize == cpi->tpl_bsize);
+  flow_data->gf_picture = gf_picture;
+  flow_data->frame_idx = frame_idx;
+  flow_data->this_frame = this_frame;
+
   // Setup scaling factor
 #if CONFIG_VP9_HIGHBITDEPTH
   vp9_setup_scale_factors_for_frame(
-      &sf, this_frame->y_crop_width, this_frame->y_crop_height,
+      &flow_data->sf, this_frame->y_crop_width, this_frame->y_crop_height,
       this_frame->y_crop_width, this_frame->y_crop_height,
       cpi->common.use_highbitdepth);
-
-  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH)
-    predictor = CONVERT_TO_BYTEPTR(predictor16);
-  else
-    predictor = predictor8;
 #else
   vp9_setup_scale_factors_for_frame(
-      &sf, this_frame->y_crop_width, this_frame->y_crop_height,
+      &flow_data->sf, this_frame->y_crop_width, this_frame->y_crop_height,
       this_frame->y_crop_width, this_frame->y_crop_height);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
@@ -7303,7 +7390,7 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   // unavailable, the pointer will be set to Null.
   for (idx = 0; idx < MAX_INTER_REF_FRAMES; ++idx) {
     int rf_idx = gf_picture[frame_idx].ref_frame[idx];
-    if (rf_idx != -1) ref_frame[idx] = gf_picture[rf_idx].frame;
+    flow_data->ref_frame[idx] = rf_idx != -1 ? gf_picture[rf_idx].frame : NULL;
   }
 
   xd->mi = cm->mi_grid_visible;
@@ -7324,7 +7411,7 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   for (square_block_idx = 0; square_block_idx < SQUARE_BLOCK_SIZES;
        ++square_block_idx) {
     BLOCK_SIZE square_bsize = square_block_idx_to_bsize(square_block_idx);
-    build_motion_field(cpi, frame_idx, ref_frame, square_bsize);
+    build_motion_field(cpi, frame_idx, flow_data->ref_frame, square_bsize);
   }
   for (rf_idx = 0; rf_idx < MAX_INTER_REF_FRAMES; ++rf_idx) {
     int ref_frame_idx = gf_picture[frame_idx].ref_frame[rf_idx];
@@ -7337,17 +7424,12 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   }
 #endif
 
-  for (mi_row = 0; mi_row < cm->mi_rows; mi_row += mi_height) {
-    for (mi_col = 0; mi_col < cm->mi_cols; mi_col += mi_width) {
-      mode_estimation(cpi, x, xd, &sf, gf_picture, frame_idx, tpl_frame,
-                      src_diff, coeff, qcoeff, dqcoeff, mi_row, mi_col, bsize,
-                      tx_size, ref_frame, predictor, &recon_error, &sse);
-      // Motion flow dependency dispenser.
-      tpl_model_store(tpl_frame->tpl_stats_ptr, mi_row, mi_col, bsize,
-                      tpl_frame->stride);
-
-      tpl_model_update(cpi->tpl_stats, tpl_frame->tpl_stats_ptr, mi_row, mi_col,
-                       bsize);
+  if (cpi->row_mt) {
+    vp9_tpl_row_mt(cpi);
+  } else {
+    for (mi_row = 0; mi_row < cm->mi_rows; mi_row += mi_height) {
+      vp9_mc_flow_dispenser_row(cpi, td, mi_row);
+      vp9_tpl_model_update_row(cpi, mi_row);
     }
   }
 }
@@ -7702,8 +7784,10 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
         not_last_frame |= ALT_REF_AQ_APPLY_TO_LAST_FRAME;
 
         // Produce the filtered ARF frame.
+        vp9_stage_timing_start(cpi, VP9E_STAGE_TEMPORAL_FILTER);
         vp9_temporal_filter(cpi, arf_src_index);
         vpx_extend_frame_borders(&cpi->alt_ref_buffer);
+        vp9_stage_timing_end(cpi, VP9E_STAGE_TEMPORAL_FILTER);
 
         // for small bitrates segmentation overhead usually
         // eats all bitrate gain from enabling delta quantizers
@@ -7860,9 +7944,11 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   if (gf_group_index == 1 &&
       cpi->twopass.gf_group.update_type[gf_group_index] == ARF_UPDATE &&
       cpi->sf.enable_tpl_model) {
+    vp9_stage_timing_start(cpi, VP9E_STAGE_TPL);
     init_tpl_buffer(cpi);
     vp9_estimate_qp_gop(cpi);
     setup_tpl_stats(cpi);
+    vp9_stage_timing_end(cpi, VP9E_STAGE_TPL);
   }
 
 #if CONFIG_BITSTREAM_DEBUG
@@ -7924,6 +8010,8 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
     cpi->droppable = !frame_is_reference(cpi);
   }
 
+  if (oxcf->mr_info != NULL) vp9_mr_store_frame_info(cpi, *size > 0);
+
   // Save layer specific state.
   if (is_one_pass_cbr_svc(cpi) || ((cpi->svc.number_temporal_layers > 1 ||
                                     cpi->svc.number_spatial_layers > 1) &&
@@ -8209,6 +8297,42 @@ void vp9_set_svc(VP9_COMP *cpi, int use_svc) {
 
 int vp9_get_quantizer(const VP9_COMP *cpi) { return cpi->common.base_qindex; }
 
+// Turns on the timing of the workers, which may have been created since the
+// last stage, and returns the CPU time they have spent in jobs.
+static int64_t get_worker_cpu_time(VP9_COMP *cpi) {
+  int64_t cpu_time = 0;
+  int i;
+  for (i = 0; i < cpi->num_workers; ++i) {
+    cpi->workers[i].timed = 1;
+    cpu_time += cpi->workers[i].cpu_time;
+  }
+  return cpu_time;
+}
+
+void vp9_stage_timing_start(VP9_COMP *cpi, vp9e_stage_t stage) {
+  if (!cpi->stage_timing) return;
+  cpi->stage_worker_cpu_start[stage] = get_worker_cpu_time(cpi);
+  cpi->stage_cpu_start[stage] = vpx_thread_cpu_time_usec();
+  vpx_usec_timer_start(&cpi->stage_timer[stage]);
+}
+
+void vp9_stage_timing_end(VP9_COMP *cpi, vp9e_stage_t stage) {
+  vpx_stage_timings_t *const timings = &cpi->stage_timings;
+  const int num_threads = VPXMAX(cpi->num_workers - 1, 0);
+  int64_t wall_time, worker_cpu_time;
+  if (!cpi->stage_timing) return;
+  vpx_usec_timer_mark(&cpi->stage_timer[stage]);
+  wall_time = vpx_usec_timer_elapsed(&cpi->stage_timer[stage]);
+  worker_cpu_time =
+      get_worker_cpu_time(cpi) - cpi->stage_worker_cpu_start[stage];
+  timings->wall_time[stage] += wall_time;
+  timings->cpu_time[stage] += vpx_thread_cpu_time_usec() -
+                              cpi->stage_cpu_start[stage] + worker_cpu_time;
+  // The calling thread runs a share of the jobs itself and is never idle.
+  timings->idle_time[stage] +=
+      VPXMAX(wall_time * num_threads - worker_cpu_time, 0);
+}
+
 void vp9_apply_encoding_flags(VP9_COMP *cpi, vpx_enc_frame_flags_t flags) {
   if (flags &
       (VP8_EFLAG_NO_REF_LAST | VP8_EFLAG_NO_REF_GF | VP8_EFLAG_NO_REF_ARF)) {
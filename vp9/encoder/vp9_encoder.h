@@ -23,7 +23,9 @@
 #include "vpx_dsp/variance.h"
 #include "vpx_dsp/psnr.h"
 #include "vpx_ports/system_state.h"
+#include "vpx_ports/vpx_timer.h"
 #include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
 #include "vpx_util/vpx_timestamp.h"
 
 #include "vp9/common/vp9_alloccommon.h"
@@ -45,6 +47,7 @@
 #include "vp9/encoder/vp9_lookahead.h"
 #include "vp9/encoder/vp9_mbgraph.h"
 #include "vp9/encoder/vp9_mcomp.h"
+#include "vp9/encoder/vp9_multi_res.h"
 #include "vp9/encoder/vp9_noise_estimate.h"
 #include "vp9/encoder/vp9_quantize.h"
 #include "vp9/encoder/vp9_ratectrl.h"
@@ -288,6 +291,12 @@ typedef struct VP9EncoderConfig {
   unsigned int motion_vector_unit_test;
   int delta_q_uv;
   int use_simple_encode_api;  // Use SimpleEncode APIs or not
+
+  // Multi-resolution encoding. Encoder 0 codes the lowest resolution and
+  // 'mr_info' is NULL outside of a multi-resolution encode.
+  unsigned int mr_total_resolutions;
+  unsigned int mr_encoder_id;
+  LOWER_RES_INFO *mr_info;
 } VP9EncoderConfig;
 
 static INLINE int is_lossless_requested(const VP9EncoderConfig *cfg) {
@@ -330,6 +339,18 @@ typedef struct TplDepFrame {
 #endif
 } TplDepFrame;
 
+struct GF_PICTURE;
+
+// The TPL model frame being built. Its rows are shared out among the threads
+// by vp9_tpl_row_mt().
+typedef struct TplFlowData {
+  struct GF_PICTURE *gf_picture;
+  int frame_idx;
+  YV12_BUFFER_CONFIG *this_frame;
+  YV12_BUFFER_CONFIG *ref_frame[MAX_INTER_REF_FRAMES];
+  struct scale_factors sf;
+} TplFlowData;
+
 #define TPL_DEP_COST_SCALE_LOG2 4
 
 // TODO(jingning) All spatially adaptive variables should go to TileDataEnc.
@@ -670,6 +691,9 @@ typedef struct VP9_COMP {
   VP9EncoderConfig oxcf;
   struct lookahead_ctx *lookahead;
   struct lookahead_entry *alt_ref_source;
+  // Releases source frames queued by vp9_receive_raw_frame_ref(), see
+  // VP9E_SET_SOURCE_RELEASE_CB.
+  vpx_source_release_cb_t source_release_cb;
 
   YV12_BUFFER_CONFIG *Source;
   YV12_BUFFER_CONFIG *Last_Source;  // NULL for first frame and alt_ref frames
@@ -685,6 +709,7 @@ typedef struct VP9_COMP {
 
   BLOCK_SIZE tpl_bsize;
   TplDepFrame tpl_stats[MAX_ARF_GOP_SIZE];
+  TplFlowData tpl_flow_data;
   YV12_BUFFER_CONFIG *tpl_recon_frames[REF_FRAMES];
   EncFrameBuf enc_frame_buf[REF_FRAMES];
 #if CONFIG_MULTITHREAD
@@ -916,10 +941,23 @@ typedef struct VP9_COMP {
   // Multi-threading
   int num_workers;
   VPxWorker *workers;
+  // Threads shared by all of the encoder's workers; NULL if they use
+  // dedicated threads. Owned by the application if external_thread_pool is
+  // set, see VP9E_SET_THREAD_POOL.
+  VPxThreadPool *thread_pool;
+  int external_thread_pool;
   struct EncWorkerData *tile_thr_data;
   VP9LfSync lf_row_sync;
   struct VP9BitstreamWorkerData *vp9_bitstream_worker_data;
 
+  // Per-stage timings of the current vpx_codec_encode() call, collected when
+  // stage_timing is set, see VP9E_SET_STAGE_TIMINGS.
+  int stage_timing;
+  vpx_stage_timings_t stage_timings;
+  struct vpx_usec_timer stage_timer[VP9E_STAGE_COUNT];
+  int64_t stage_cpu_start[VP9E_STAGE_COUNT];
+  int64_t stage_worker_cpu_start[VP9E_STAGE_COUNT];
+
   int keep_level_stats;
   Vp9LevelInfo level_info;
   MultiThreadHandle multi_thread_ctxt;
@@ -1126,6 +1164,13 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
                           YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
                           int64_t end_time);
 
+// Like vp9_receive_raw_frame(), but the frame is referenced rather than
+// copied; see vp9_lookahead_push_ref(). Returns 0 once the lookahead holds
+// the frame.
+int vp9_receive_raw_frame_ref(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
+                              YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
+                              int64_t end_time, void *img_priv);
+
 int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
                             size_t *size, uint8_t *dest, int64_t *time_stamp,
                             int64_t *time_end, int flush,
@@ -1191,6 +1236,11 @@ static INLINE void stack_init(int *stack, int length) {
 
 int vp9_get_quantizer(const VP9_COMP *cpi);
 
+// Times one run of an encoder stage, when stage timings are on. The time of
+// all the runs in a vpx_codec_encode() call adds up.
+void vp9_stage_timing_start(VP9_COMP *cpi, vp9e_stage_t stage);
+void vp9_stage_timing_end(VP9_COMP *cpi, vp9e_stage_t stage);
+
 static INLINE int frame_is_kf_gf_arf(const VP9_COMP *cpi) {
   return frame_is_intra_only(&cpi->common) || cpi->refresh_alt_ref_frame ||
          (cpi->refresh_golden_frame && !cpi->rc.is_src_frame_alt_ref);
@@ -1287,6 +1337,15 @@ void vp9_get_ref_frame_info(FRAME_UPDATE_TYPE update_type, int ref_frame_flags,
 
 void vp9_set_high_precision_mv(VP9_COMP *cpi, int allow_high_precision_mv);
 
+// Estimates the costs of the row of TPL blocks at 'mi_row' in the frame
+// described by cpi->tpl_flow_data. Rows are independent of each other.
+void vp9_mc_flow_dispenser_row(VP9_COMP *cpi, ThreadData *td, int mi_row);
+
+// Propagates the costs of the row of TPL blocks at 'mi_row' to the reference
+// frames. Rows may update the same reference blocks, so they are propagated
+// one at a time, in order.
+void vp9_tpl_model_update_row(VP9_COMP *cpi, int mi_row);
+
 YV12_BUFFER_CONFIG *vp9_svc_twostage_scale(
     VP9_COMMON *cm, YV12_BUFFER_CONFIG *unscaled, YV12_BUFFER_CONFIG *scaled,
     YV12_BUFFER_CONFIG *scaled_temp, INTERP_FILTER filter_type,
@@ -98,15 +98,32 @@ static void create_enc_workers(VP9_COMP *cpi, int num_workers) {
     CHECK_MEM_ERROR(cm, cpi->tile_thr_data,
                     vpx_calloc(allocated_workers, sizeof(*cpi->tile_thr_data)));
 
+#if CONFIG_MULTITHREAD
+    // The main thread runs the last worker's job itself, so the pool needs
+    // one thread fewer than there are workers. Every stage that launches
+    // these workers (tile and row based encoding, first pass, temporal
+    // filter, loop filter and bitstream packing) then runs on the same
+    // threads, and the main thread picks up queued jobs while it syncs.
+    // An application owned pool set with VP9E_SET_THREAD_POOL is used as is.
+    if (allocated_workers > 1 && cpi->thread_pool == NULL) {
+      CHECK_MEM_ERROR(cm, cpi->thread_pool,
+                      vpx_thread_pool_create(allocated_workers - 1));
+    }
+#endif
+
     for (i = 0; i < allocated_workers; i++) {
       VPxWorker *const worker = &cpi->workers[i];
       EncWorkerData *thread_data = &cpi->tile_thr_data[i];
 
       ++cpi->num_workers;
       winterface->init(worker);
+      worker->timed = cpi->stage_timing;
 
       if (i < allocated_workers - 1) {
         thread_data->cpi = cpi;
+        if (cpi->thread_pool != NULL) {
+          vpx_thread_pool_attach_worker(cpi->thread_pool, worker);
+        }
 
         // Allocate thread data.
         CHECK_MEM_ERROR(cm, thread_data->td,
@@ -665,3 +682,81 @@ void vp9_encode_tiles_row_mt(VP9_COMP *cpi) {
     }
   }
 }
+
+static int tpl_worker_hook(void *arg1, void *arg2) {
+  EncWorkerData *const thread_data = (EncWorkerData *)arg1;
+  MultiThreadHandle *multi_thread_ctxt = (MultiThreadHandle *)arg2;
+  VP9_COMP *const cpi = thread_data->cpi;
+  VP9RowMTSync *const row_mt_sync = &cpi->tile_data[0].row_mt_sync;
+  const int mi_height = num_8x8_blocks_high_lookup[cpi->tpl_bsize];
+  int end_of_frame;
+  int thread_id = thread_data->thread_id;
+  int cur_tile_id = multi_thread_ctxt->thread_id_to_tile_id[thread_id];
+  JobNode *proc_job = NULL;
+  int row;
+
+  end_of_frame = 0;
+  while (0 == end_of_frame) {
+    // Get the next job in the queue
+    proc_job =
+        (JobNode *)vp9_enc_grp_get_next_job(multi_thread_ctxt, cur_tile_id);
+    if (NULL == proc_job) {
+      end_of_frame = vp9_get_tiles_proc_status(
+          multi_thread_ctxt, thread_data->tile_completion_status, &cur_tile_id,
+          1);
+    } else {
+      row = proc_job->vert_unit_row_num;
+
+      vp9_mc_flow_dispenser_row(cpi, thread_data->td, row * mi_height);
+
+      // Wait for the previous row to be propagated. The rows are taken from
+      // the queue in order, so the previous row is always being processed.
+      vp9_row_mt_sync_read(row_mt_sync, row, 0);
+      vp9_tpl_model_update_row(cpi, row * mi_height);
+      vp9_row_mt_sync_write(row_mt_sync, row, 0, 1);
+    }
+  }
+  return 0;
+}
+
+void vp9_tpl_row_mt(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  MultiThreadHandle *multi_thread_ctxt = &cpi->multi_thread_ctxt;
+  int num_workers = cpi->num_workers ? cpi->num_workers : 1;
+  int i;
+
+  if (multi_thread_ctxt->allocated_tile_cols < tile_cols ||
+      multi_thread_ctxt->allocated_tile_rows < tile_rows ||
+      multi_thread_ctxt->allocated_vert_unit_rows < cm->mb_rows) {
+    vp9_row_mt_mem_dealloc(cpi);
+    vp9_init_tile_data(cpi);
+    vp9_row_mt_mem_alloc(cpi);
+  } else {
+    vp9_init_tile_data(cpi);
+  }
+
+  create_enc_workers(cpi, num_workers);
+
+  vp9_assign_tile_to_thread(multi_thread_ctxt, 1, cpi->num_workers);
+
+  vp9_prepare_job_queue(cpi, TPL_JOB);
+
+  // The row sync of the first tile orders the propagation of the rows.
+  memset(cpi->tile_data[0].row_mt_sync.cur_col, -1,
+         sizeof(*cpi->tile_data[0].row_mt_sync.cur_col) *
+             multi_thread_ctxt->jobs_per_tile_col);
+
+  for (i = 0; i < num_workers; i++) {
+    EncWorkerData *thread_data;
+    thread_data = &cpi->tile_thr_data[i];
+
+    // Before building the frame, copy the thread data from cpi.
+    if (thread_data->td != &cpi->td) {
+      thread_data->td->mb = cpi->td.mb;
+    }
+  }
+
+  launch_enc_workers(cpi, tpl_worker_hook, multi_thread_ctxt, num_workers);
+}
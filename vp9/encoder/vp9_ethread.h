@@ -65,6 +65,8 @@ void vp9_row_mt_sync_mem_dealloc(VP9RowMTSync *row_mt_sync);
 
 void vp9_temporal_filter_row_mt(struct VP9_COMP *cpi);
 
+void vp9_tpl_row_mt(struct VP9_COMP *cpi);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
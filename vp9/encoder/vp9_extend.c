@@ -15,29 +15,44 @@
 #include "vp9/common/vp9_common.h"
 #include "vp9/encoder/vp9_extend.h"
 
+// Copies the top and bottom lines of the extended plane into each line of
+// the respective borders.
+static void extend_plane_top_bottom(uint8_t *dst, int dst_pitch, int w, int h,
+                                    int extend_top, int extend_left,
+                                    int extend_bottom, int extend_right) {
+  int i;
+  const uint8_t *src_ptr1 = dst - extend_left;
+  const uint8_t *src_ptr2 = dst + dst_pitch * (h - 1) - extend_left;
+  uint8_t *dst_ptr1 = dst + dst_pitch * (-extend_top) - extend_left;
+  uint8_t *dst_ptr2 = dst + dst_pitch * (h)-extend_left;
+  const int linesize = extend_left + extend_right + w;
+
+  for (i = 0; i < extend_top; i++) {
+    memcpy(dst_ptr1, src_ptr1, linesize);
+    dst_ptr1 += dst_pitch;
+  }
+
+  for (i = 0; i < extend_bottom; i++) {
+    memcpy(dst_ptr2, src_ptr2, linesize);
+    dst_ptr2 += dst_pitch;
+  }
+}
+
 static void copy_and_extend_plane(const uint8_t *src, int src_pitch,
                                   uint8_t *dst, int dst_pitch, int w, int h,
                                   int extend_top, int extend_left,
-                                  int extend_bottom, int extend_right,
-                                  int interleave_step) {
-  int i, j, linesize;
-  const int step = interleave_step < 1 ? 1 : interleave_step;
+                                  int extend_bottom, int extend_right) {
+  int i;
 
   // copy the left and right most columns out
   const uint8_t *src_ptr1 = src;
-  const uint8_t *src_ptr2 = src + (w - 1) * step;
+  const uint8_t *src_ptr2 = src + w - 1;
   uint8_t *dst_ptr1 = dst - extend_left;
   uint8_t *dst_ptr2 = dst + w;
 
   for (i = 0; i < h; i++) {
     memset(dst_ptr1, src_ptr1[0], extend_left);
-    if (step == 1) {
-      memcpy(dst_ptr1 + extend_left, src_ptr1, w);
-    } else {
-      for (j = 0; j < w; j++) {
-        dst_ptr1[extend_left + j] = src_ptr1[step * j];
-      }
-    }
+    if (src != dst) memcpy(dst_ptr1 + extend_left, src_ptr1, w);
     memset(dst_ptr2, src_ptr2[0], extend_right);
     src_ptr1 += src_pitch;
     src_ptr2 += src_pitch;
@@ -45,23 +60,40 @@ static void copy_and_extend_plane(const uint8_t *src, int src_pitch,
     dst_ptr2 += dst_pitch;
   }
 
-  // Now copy the top and bottom lines into each line of the respective
-  // borders
-  src_ptr1 = dst - extend_left;
-  src_ptr2 = dst + dst_pitch * (h - 1) - extend_left;
-  dst_ptr1 = dst + dst_pitch * (-extend_top) - extend_left;
-  dst_ptr2 = dst + dst_pitch * (h)-extend_left;
-  linesize = extend_left + extend_right + w;
+  extend_plane_top_bottom(dst, dst_pitch, w, h, extend_top, extend_left,
+                          extend_bottom, extend_right);
+}
 
-  for (i = 0; i < extend_top; i++) {
-    memcpy(dst_ptr1, src_ptr1, linesize);
-    dst_ptr1 += dst_pitch;
-  }
+// Splits the interleaved chroma of NV12 into the u and v planes of 'dst' and
+// extends both, reading each source line once.
+static void copy_and_extend_interleaved_uv(const uint8_t *src, int src_pitch,
+                                           uint8_t *dst_u, uint8_t *dst_v,
+                                           int dst_pitch, int w, int h,
+                                           int extend_top, int extend_left,
+                                           int extend_bottom,
+                                           int extend_right) {
+  int i, j;
+  uint8_t *u = dst_u;
+  uint8_t *v = dst_v;
 
-  for (i = 0; i < extend_bottom; i++) {
-    memcpy(dst_ptr2, src_ptr2, linesize);
-    dst_ptr2 += dst_pitch;
+  for (i = 0; i < h; i++) {
+    for (j = 0; j < w; j++) {
+      u[j] = src[2 * j];
+      v[j] = src[2 * j + 1];
+    }
+    memset(u - extend_left, u[0], extend_left);
+    memset(v - extend_left, v[0], extend_left);
+    memset(u + w, u[w - 1], extend_right);
+    memset(v + w, v[w - 1], extend_right);
+    src += src_pitch;
+    u += dst_pitch;
+    v += dst_pitch;
   }
+
+  extend_plane_top_bottom(dst_u, dst_pitch, w, h, extend_top, extend_left,
+                          extend_bottom, extend_right);
+  extend_plane_top_bottom(dst_v, dst_pitch, w, h, extend_top, extend_left,
+                          extend_bottom, extend_right);
 }
 
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -81,7 +113,9 @@ static void highbd_copy_and_extend_plane(const uint8_t *src8, int src_pitch,
 
   for (i = 0; i < h; i++) {
     vpx_memset16(dst_ptr1, src_ptr1[0], extend_left);
-    memcpy(dst_ptr1 + extend_left, src_ptr1, w * sizeof(src_ptr1[0]));
+    if (src != dst) {
+      memcpy(dst_ptr1 + extend_left, src_ptr1, w * sizeof(src_ptr1[0]));
+    }
     vpx_memset16(dst_ptr2, src_ptr2[0], extend_right);
     src_ptr1 += src_pitch;
     src_ptr2 += src_pitch;
@@ -131,7 +165,7 @@ void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
   const int eb_uv = eb_y >> uv_height_subsampling;
   const int er_uv = er_y >> uv_width_subsampling;
   // detect nv12 colorspace
-  const int chroma_step = src->v_buffer - src->u_buffer == 1 ? 2 : 1;
+  const int is_nv12 = src->v_buffer - src->u_buffer == 1;
 
 #if CONFIG_VP9_HIGHBITDEPTH
   if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
@@ -152,15 +186,23 @@ void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
 
   copy_and_extend_plane(src->y_buffer, src->y_stride, dst->y_buffer,
                         dst->y_stride, src->y_crop_width, src->y_crop_height,
-                        et_y, el_y, eb_y, er_y, 1);
+                        et_y, el_y, eb_y, er_y);
+
+  if (is_nv12) {
+    copy_and_extend_interleaved_uv(
+        src->u_buffer, src->uv_stride, dst->u_buffer, dst->v_buffer,
+        dst->uv_stride, src->uv_crop_width, src->uv_crop_height, et_uv, el_uv,
+        eb_uv, er_uv);
+    return;
+  }
 
   copy_and_extend_plane(src->u_buffer, src->uv_stride, dst->u_buffer,
                         dst->uv_stride, src->uv_crop_width, src->uv_crop_height,
-                        et_uv, el_uv, eb_uv, er_uv, chroma_step);
+                        et_uv, el_uv, eb_uv, er_uv);
 
   copy_and_extend_plane(src->v_buffer, src->uv_stride, dst->v_buffer,
                         dst->uv_stride, src->uv_crop_width, src->uv_crop_height,
-                        et_uv, el_uv, eb_uv, er_uv, chroma_step);
+                        et_uv, el_uv, eb_uv, er_uv);
 }
 
 void vp9_copy_and_extend_frame_with_rect(const YV12_BUFFER_CONFIG *src,
@@ -182,22 +224,32 @@ void vp9_copy_and_extend_frame_with_rect(const YV12_BUFFER_CONFIG *src,
   const int el_uv = ROUND_POWER_OF_TWO(el_y, 1);
   const int eb_uv = ROUND_POWER_OF_TWO(eb_y, 1);
   const int er_uv = ROUND_POWER_OF_TWO(er_y, 1);
-  const int src_uv_offset = ((srcy * src->uv_stride) >> 1) + (srcx >> 1);
+  // detect nv12 colorspace
+  const int is_nv12 = src->v_buffer - src->u_buffer == 1;
+  // The chroma samples of NV12 are twice as far apart in the source.
+  const int src_uv_offset =
+      ((srcy * src->uv_stride) >> 1) + (srcx >> 1) * (is_nv12 ? 2 : 1);
   const int dst_uv_offset = ((srcy * dst->uv_stride) >> 1) + (srcx >> 1);
   const int srch_uv = ROUND_POWER_OF_TWO(srch, 1);
   const int srcw_uv = ROUND_POWER_OF_TWO(srcw, 1);
-  // detect nv12 colorspace
-  const int chroma_step = src->v_buffer - src->u_buffer == 1 ? 2 : 1;
 
   copy_and_extend_plane(src->y_buffer + src_y_offset, src->y_stride,
                         dst->y_buffer + dst_y_offset, dst->y_stride, srcw, srch,
-                        et_y, el_y, eb_y, er_y, 1);
+                        et_y, el_y, eb_y, er_y);
+
+  if (is_nv12) {
+    copy_and_extend_interleaved_uv(
+        src->u_buffer + src_uv_offset, src->uv_stride,
+        dst->u_buffer + dst_uv_offset, dst->v_buffer + dst_uv_offset,
+        dst->uv_stride, srcw_uv, srch_uv, et_uv, el_uv, eb_uv, er_uv);
+    return;
+  }
 
   copy_and_extend_plane(src->u_buffer + src_uv_offset, src->uv_stride,
                         dst->u_buffer + dst_uv_offset, dst->uv_stride, srcw_uv,
-                        srch_uv, et_uv, el_uv, eb_uv, er_uv, chroma_step);
+                        srch_uv, et_uv, el_uv, eb_uv, er_uv);
 
   copy_and_extend_plane(src->v_buffer + src_uv_offset, src->uv_stride,
                         dst->v_buffer + dst_uv_offset, dst->uv_stride, srcw_uv,
-                        srch_uv, et_uv, el_uv, eb_uv, er_uv, chroma_step);
+                        srch_uv, et_uv, el_uv, eb_uv, er_uv);
 }
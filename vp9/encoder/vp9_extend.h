@@ -18,6 +18,8 @@
 extern "C" {
 #endif
 
+// 'src' and 'dst' may share planes, which are then extended in place. The
+// interleaved chroma of NV12 is always split into distinct planes of 'dst'.
 void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
                                YV12_BUFFER_CONFIG *dst);
 
@@ -1377,6 +1377,8 @@ void vp9_first_pass(VP9_COMP *cpi, const struct lookahead_entry *source) {
   FIRSTPASS_DATA fp_temp_data;
   FIRSTPASS_DATA *fp_acc_data = &fp_temp_data;
 
+  vp9_stage_timing_start(cpi, VP9E_STAGE_FIRST_PASS);
+
   vpx_clear_system_state();
   vp9_zero(fp_temp_data);
   fp_acc_data->image_data_start_row = INVALID_ROW;
@@ -1495,6 +1497,8 @@ void vp9_first_pass(VP9_COMP *cpi, const struct lookahead_entry *source) {
   // In the first pass, every frame is considered as a show frame.
   update_frame_indexes(cm, /*show_frame=*/1);
   if (cpi->use_svc) vp9_inc_frame_in_layer(cpi);
+
+  vp9_stage_timing_end(cpi, VP9E_STAGE_FIRST_PASS);
 }
 
 static const double q_pow_term[(QINDEX_RANGE >> 5) + 1] = { 0.65, 0.70, 0.75,
@@ -29,12 +29,26 @@ static struct lookahead_entry *pop(struct lookahead_ctx *ctx, int *idx) {
   return buf;
 }
 
+// Hands a referenced frame back to the application and restores the
+// entry's internal buffer.
+static void release_ref(struct lookahead_ctx *ctx,
+                        struct lookahead_entry *buf) {
+  if (!buf->is_ref) return;
+  buf->img = buf->own_img;
+  memset(&buf->own_img, 0, sizeof(buf->own_img));
+  buf->is_ref = 0;
+  ctx->release_cb.release(ctx->release_cb.user_priv, buf->img_priv);
+}
+
 void vp9_lookahead_destroy(struct lookahead_ctx *ctx) {
   if (ctx) {
     if (ctx->buf) {
       int i;
 
-      for (i = 0; i < ctx->max_sz; i++) vpx_free_frame_buffer(&ctx->buf[i].img);
+      for (i = 0; i < ctx->max_sz; i++) {
+        release_ref(ctx, &ctx->buf[i]);
+        vpx_free_frame_buffer(&ctx->buf[i].img);
+      }
       free(ctx->buf);
     }
     free(ctx);
@@ -114,6 +128,7 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
   if (vp9_lookahead_full(ctx)) return 1;
   ctx->sz++;
   buf = pop(ctx, &ctx->write_idx);
+  release_ref(ctx, buf);
 
   new_dimensions = width != buf->img.y_crop_width ||
                    height != buf->img.y_crop_height ||
@@ -198,6 +213,60 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
   return 0;
 }
 
+int vp9_lookahead_push_ref(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
+                           int64_t ts_start, int64_t ts_end,
+                           vpx_enc_frame_flags_t flags, void *img_priv) {
+  struct lookahead_entry *buf;
+  const int aligned_width = (src->y_crop_width + 7) & ~7;
+  const int aligned_height = (src->y_crop_height + 7) & ~7;
+  // The interleaved chroma of NV12 is split into the entry's own chroma
+  // planes; only the luma plane is referenced.
+  const int is_nv12 = src->v_buffer - src->u_buffer == 1;
+
+  assert(ctx->release_cb.release != NULL);
+  assert(src->border >= VP9E_SOURCE_BORDER_IN_PIXELS);
+  if (vp9_lookahead_full(ctx)) return 1;
+  ctx->sz++;
+  buf = pop(ctx, &ctx->write_idx);
+  release_ref(ctx, buf);
+
+  // Keep the internal buffer's description and point it at 'src'.
+  buf->own_img = buf->img;
+  buf->img.y_buffer = src->y_buffer;
+  buf->img.y_stride = src->y_stride;
+  if (!is_nv12) {
+    buf->img.u_buffer = src->u_buffer;
+    buf->img.v_buffer = src->v_buffer;
+    buf->img.uv_stride = src->uv_stride;
+  }
+  buf->img.y_crop_width = src->y_crop_width;
+  buf->img.y_crop_height = src->y_crop_height;
+  buf->img.uv_crop_width = src->uv_crop_width;
+  buf->img.uv_crop_height = src->uv_crop_height;
+  buf->img.y_width = aligned_width;
+  buf->img.y_height = aligned_height;
+  buf->img.uv_width = aligned_width >> src->subsampling_x;
+  buf->img.uv_height = aligned_height >> src->subsampling_y;
+  buf->img.subsampling_x = src->subsampling_x;
+  buf->img.subsampling_y = src->subsampling_y;
+  buf->img.border = VP9E_SOURCE_BORDER_IN_PIXELS;
+  buf->img.buffer_alloc = NULL;
+  buf->img.buffer_alloc_sz = 0;
+  buf->is_ref = 1;
+  buf->img_priv = img_priv;
+
+  // Same extension as the copy in vp9_lookahead_push(), done in place for the
+  // planes shared with 'src'.
+  vp9_copy_and_extend_frame(src, &buf->img);
+
+  buf->ts_start = ts_start;
+  buf->ts_end = ts_end;
+  buf->flags = flags;
+  buf->show_idx = ctx->next_show_idx;
+  ++ctx->next_show_idx;
+  return 0;
+}
+
 struct lookahead_entry *vp9_lookahead_pop(struct lookahead_ctx *ctx,
                                           int drain) {
   struct lookahead_entry *buf = NULL;
@@ -12,6 +12,7 @@
 #define VPX_VP9_ENCODER_VP9_LOOKAHEAD_H_
 
 #include "vpx_scale/yv12config.h"
+#include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
 #include "vpx/vpx_integer.h"
 
@@ -27,6 +28,11 @@ struct lookahead_entry {
   int64_t ts_end;
   int show_idx; /*The show_idx of this frame*/
   vpx_enc_frame_flags_t flags;
+  // Set while 'img' references an application frame pushed with
+  // vp9_lookahead_push_ref(). 'own_img' then holds the internal buffer.
+  int is_ref;
+  void *img_priv;
+  YV12_BUFFER_CONFIG own_img;
 };
 
 // The max of past frames we want to keep in the queue.
@@ -40,6 +46,7 @@ struct lookahead_ctx {
   int next_show_idx; /* The show_idx that will be assigned to the next frame
                         being pushed in the queue*/
   struct lookahead_entry *buf; /* Buffer list */
+  vpx_source_release_cb_t release_cb; /* Releases referenced frames */
 };
 
 /**\brief Initializes the lookahead stage
@@ -92,6 +99,19 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
                        int64_t ts_start, int64_t ts_end, int use_highbitdepth,
                        vpx_enc_frame_flags_t flags);
 
+/**\brief Enqueue a source buffer by reference
+ *
+ * Same as vp9_lookahead_push(), but 'src' must have a border of
+ * VP9E_SOURCE_BORDER_IN_PIXELS, which is extended in place, and is then used
+ * without copying. For NV12 only the luma plane is used in place, the
+ * interleaved chroma is split into the entry's own planes. ctx->release_cb is
+ * invoked with 'img_priv' once the entry is reused or the lookahead is
+ * destroyed. The frame is only referenced if 0 is returned.
+ */
+int vp9_lookahead_push_ref(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
+                           int64_t ts_start, int64_t ts_end,
+                           vpx_enc_frame_flags_t flags, void *img_priv);
+
 /**\brief Get the next source buffer to encode
  *
  *
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "vpx_mem/vpx_mem.h"
+
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_multi_res.h"
+
+LOWER_RES_INFO *vp9_mr_alloc(int width, int height) {
+  const int mi_cols = (width + MI_SIZE - 1) >> MI_SIZE_LOG2;
+  const int mi_rows = (height + MI_SIZE - 1) >> MI_SIZE_LOG2;
+  LOWER_RES_INFO *const info = (LOWER_RES_INFO *)vpx_calloc(1, sizeof(*info));
+  if (info == NULL) return NULL;
+  info->mvs_size = mi_rows * mi_cols;
+  info->mvs = (MV_REF *)vpx_calloc(info->mvs_size, sizeof(*info->mvs));
+  if (info->mvs == NULL) {
+    vpx_free(info);
+    return NULL;
+  }
+  return info;
+}
+
+void vp9_mr_free(LOWER_RES_INFO *info) {
+  if (info == NULL) return;
+  vpx_free(info->mvs);
+  vpx_free(info);
+}
+
+int vp9_mr_lower_res_available(const VP9_COMP *cpi) {
+  const LOWER_RES_INFO *const info = cpi->oxcf.mr_info;
+  return info != NULL && cpi->oxcf.mr_encoder_id > 0 && info->frame_valid;
+}
+
+int vp9_mr_lower_res_is_key_frame(const VP9_COMP *cpi) {
+  return vp9_mr_lower_res_available(cpi) &&
+         cpi->oxcf.mr_info->frame_type == KEY_FRAME;
+}
+
+void vp9_mr_follow_gf_update(VP9_COMP *cpi) {
+  const LOWER_RES_INFO *const info = cpi->oxcf.mr_info;
+  RATE_CONTROL *const rc = &cpi->rc;
+
+  cpi->refresh_golden_frame = info->refresh_golden_frame;
+  rc->baseline_gf_interval = info->baseline_gf_interval;
+  rc->gfu_boost = info->gfu_boost;
+  // The stored count was already decremented for this frame, as this
+  // encoder's will be once the frame is coded.
+  rc->frames_till_gf_update_due = info->frames_till_gf_update_due + 1;
+}
+
+int vp9_mr_lower_res_mvs_available(const VP9_COMP *cpi) {
+  return vp9_mr_lower_res_available(cpi) && cpi->oxcf.mr_info->mvs_valid &&
+         !frame_is_intra_only(&cpi->common);
+}
+
+void vp9_mr_get_lower_res_mv(const VP9_COMP *cpi, int mi_row, int mi_col,
+                             int_mv *mv) {
+  const VP9_COMMON *const cm = &cpi->common;
+  const LOWER_RES_INFO *const info = cpi->oxcf.mr_info;
+  const int row =
+      VPXMIN(mi_row * info->height / cm->height, info->mi_rows - 1);
+  const int col = VPXMIN(mi_col * info->width / cm->width, info->mi_cols - 1);
+  const MV_REF *const ref = &info->mvs[row * info->mi_cols + col];
+
+  if (ref->ref_frame[0] == LAST_FRAME) {
+    const MV *const lr_mv = &ref->mv[0].as_mv;
+    mv->as_mv.row = (int16_t)(lr_mv->row * cm->height / info->height);
+    mv->as_mv.col = (int16_t)(lr_mv->col * cm->width / info->width);
+  } else {
+    mv->as_int = INVALID_MV;
+  }
+}
+
+void vp9_mr_store_frame_info(VP9_COMP *cpi, int coded) {
+  const VP9_COMMON *const cm = &cpi->common;
+  LOWER_RES_INFO *const info = cpi->oxcf.mr_info;
+
+  // Nothing is encoded after the highest resolution.
+  if (cpi->oxcf.mr_encoder_id + 1 >= cpi->oxcf.mr_total_resolutions) return;
+
+  info->frame_valid = 1;
+  info->frame_type = cm->frame_type;
+  info->refresh_golden_frame = cpi->refresh_golden_frame;
+  info->baseline_gf_interval = cpi->rc.baseline_gf_interval;
+  info->frames_till_gf_update_due = cpi->rc.frames_till_gf_update_due;
+  info->gfu_boost = cpi->rc.gfu_boost;
+  info->high_source_sad = cpi->rc.high_source_sad;
+  info->high_num_blocks_with_motion = cpi->rc.high_num_blocks_with_motion;
+  info->width = cm->width;
+  info->height = cm->height;
+  info->mi_rows = cm->mi_rows;
+  info->mi_cols = cm->mi_cols;
+  info->mvs_valid = coded && cm->cur_frame != NULL &&
+                    cm->mi_rows * cm->mi_cols <= info->mvs_size;
+  if (info->mvs_valid) {
+    memcpy(info->mvs, cm->cur_frame->mvs,
+           cm->mi_rows * cm->mi_cols * sizeof(*info->mvs));
+  }
+}
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_MULTI_RES_H_
+#define VPX_VP9_ENCODER_VP9_MULTI_RES_H_
+
+#include "vp9/common/vp9_blockd.h"
+#include "vp9/common/vp9_onyxc_int.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct VP9_COMP;
+
+// Multi-resolution encoding runs one encoder per resolution of the same
+// source, from the lowest resolution to the highest (see
+// vpx_codec_enc_init_multi()). Each encoder leaves the analysis of its last
+// frame here, and the encoder of the next higher resolution reuses it for the
+// same source frame instead of repeating it. The encoders code each frame as
+// soon as it arrives (one pass, no lag in frames), so there are no first-pass
+// stats or alt-ref frames to share; key frames and golden frame updates are
+// placed by the lowest resolution.
+typedef struct LOWER_RES_INFO {
+  // Set once the next lower resolution has processed the current frame.
+  int frame_valid;
+  FRAME_TYPE frame_type;
+  // Golden frame update of the frame, and the rate control state that places
+  // the next one, after the frame was coded.
+  int refresh_golden_frame;
+  int baseline_gf_interval;
+  int frames_till_gf_update_due;
+  int gfu_boost;
+  // Scene detection results for the frame.
+  int high_source_sad;
+  int high_num_blocks_with_motion;
+  // Dimensions of the next lower resolution.
+  int width;
+  int height;
+  int mi_rows;
+  int mi_cols;
+  // Motion field of the frame, valid when the frame was coded rather than
+  // dropped. Sized for the highest resolution.
+  int mvs_valid;
+  MV_REF *mvs;
+  int mvs_size;
+} LOWER_RES_INFO;
+
+// Allocates the state shared by the encoders of a multi-resolution encode
+// whose highest resolution is 'width' x 'height'.
+LOWER_RES_INFO *vp9_mr_alloc(int width, int height);
+void vp9_mr_free(LOWER_RES_INFO *info);
+
+// Returns 1 if 'cpi' is part of a multi-resolution encode and the next lower
+// resolution has processed the current frame.
+int vp9_mr_lower_res_available(const struct VP9_COMP *cpi);
+
+// Returns 1 if the next lower resolution coded the current frame as a key
+// frame.
+int vp9_mr_lower_res_is_key_frame(const struct VP9_COMP *cpi);
+
+// Makes the golden frame update of the current frame, and the interval to the
+// next one, follow the next lower resolution.
+void vp9_mr_follow_gf_update(struct VP9_COMP *cpi);
+
+// Returns 1 if the lower resolution motion field can be used for the current
+// frame.
+int vp9_mr_lower_res_mvs_available(const struct VP9_COMP *cpi);
+
+// Sets 'mv' to the LAST_FRAME motion vector of the lower resolution block that
+// covers (mi_row, mi_col), scaled to the current resolution, or to
+// INVALID_MV.
+void vp9_mr_get_lower_res_mv(const struct VP9_COMP *cpi, int mi_row,
+                             int mi_col, int_mv *mv);
+
+// Stores the analysis of the current frame for the next higher resolution.
+// 'coded' is 0 if the frame was dropped.
+void vp9_mr_store_frame_info(struct VP9_COMP *cpi, int coded);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_MULTI_RES_H_
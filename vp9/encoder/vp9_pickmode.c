@@ -1272,6 +1272,14 @@ static INLINE void find_predictors(
                      candidates, &frame_mv[NEWMV][ref_frame], mi_row, mi_col,
                      (int)(cpi->svc.use_base_mv && cpi->svc.spatial_layer_id));
     }
+    // In a multi-resolution encode, the lower resolution motion plays the role
+    // of the SVC base layer motion.
+    if (ref_frame == LAST_FRAME && vp9_mr_lower_res_mvs_available(cpi)) {
+      int_mv *const lower_res_mv = &frame_mv[NEWMV][ref_frame];
+      vp9_mr_get_lower_res_mv(cpi, mi_row, mi_col, lower_res_mv);
+      if (lower_res_mv->as_int != INVALID_MV)
+        clamp_mv_ref(&lower_res_mv->as_mv, xd);
+    }
     vp9_find_best_ref_mvs(xd, cm->allow_high_precision_mv, candidates,
                           &frame_mv[NEARESTMV][ref_frame],
                           &frame_mv[NEARMV][ref_frame]);
@@ -1573,6 +1581,9 @@ static int search_new_mv(VP9_COMP *cpi, MACROBLOCK *x,
   MACROBLOCKD *const xd = &x->e_mbd;
   MODE_INFO *const mi = xd->mi[0];
   SPEED_FEATURES *const sf = &cpi->sf;
+  const int use_base_mv =
+      (svc->use_base_mv && svc->spatial_layer_id) ||
+      (ref_frame == LAST_FRAME && vp9_mr_lower_res_mvs_available(cpi));
 
   if (ref_frame > LAST_FRAME && gf_temporal_ref &&
       cpi->oxcf.rc_mode == VPX_CBR) {
@@ -1604,7 +1615,7 @@ static int search_new_mv(VP9_COMP *cpi, MACROBLOCK *x,
         cpi->sf.mv.subpel_search_level, cond_cost_list(cpi, cost_list),
         x->nmvjointcost, x->mvcost, &dis, &x->pred_sse[ref_frame], NULL, 0, 0,
         cpi->sf.use_accurate_subpel_search);
-  } else if (svc->use_base_mv && svc->spatial_layer_id) {
+  } else if (use_base_mv) {
     if (frame_mv[NEWMV][ref_frame].as_int != INVALID_MV) {
       const int pre_stride = xd->plane[0].pre[0].stride;
       unsigned int base_mv_sse = UINT_MAX;
@@ -29,6 +29,7 @@
 #include "vp9/common/vp9_seg_common.h"
 
 #include "vp9/encoder/vp9_encodemv.h"
+#include "vp9/encoder/vp9_multi_res.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 
 // Max rate per frame for 1080P and below encodes if no level requirement given.
@@ -2116,6 +2117,7 @@ void vp9_rc_get_one_pass_vbr_params(VP9_COMP *cpi) {
     cm->frame_type = INTER_FRAME;
   }
   vp9_set_gf_update_one_pass_vbr(cpi);
+  if (vp9_mr_lower_res_available(cpi)) vp9_mr_follow_gf_update(cpi);
   if (cm->frame_type == KEY_FRAME)
     target = vp9_calc_iframe_target_size_one_pass_vbr(cpi);
   else
@@ -2461,6 +2463,7 @@ void vp9_rc_get_one_pass_cbr_params(VP9_COMP *cpi) {
     cpi->refresh_golden_frame = 1;
     rc->gfu_boost = DEFAULT_GF_BOOST;
   }
+  if (vp9_mr_lower_res_available(cpi)) vp9_mr_follow_gf_update(cpi);
 
   // Any update/change of global cyclic refresh parameters (amount/delta-qp)
   // should be done here, before the frame qp is selected.
@@ -3061,6 +3064,14 @@ void vp9_scene_detection_onepass(VP9_COMP *cpi) {
       for (frame = 1; frame < cpi->oxcf.lag_in_frames - 1; ++frame)
         rc->avg_source_sad[frame] = rc->avg_source_sad[frame + 1];
     }
+    if (vp9_mr_lower_res_available(cpi)) {
+      // The next lower resolution of a multi-resolution encode has already
+      // analyzed this source frame, only react to its result below.
+      const LOWER_RES_INFO *const mr_info = cpi->oxcf.mr_info;
+      rc->high_source_sad = mr_info->high_source_sad;
+      rc->high_num_blocks_with_motion = mr_info->high_num_blocks_with_motion;
+      frames_to_buffer = 0;
+    }
     for (frame = 0; frame < frames_to_buffer; ++frame) {
       if (cpi->oxcf.lag_in_frames == 0 ||
           (frames[frame] != NULL && frames[frame + 1] != NULL &&
@@ -3158,7 +3169,10 @@ void vp9_scene_detection_onepass(VP9_COMP *cpi) {
         }
     }
     // For VBR, under scene change/high content change, force golden refresh.
+    // Higher resolutions of a multi-resolution encode have already followed
+    // the golden refresh of the lower one.
     if (cpi->oxcf.rc_mode == VPX_VBR && cm->frame_type != KEY_FRAME &&
+        !vp9_mr_lower_res_available(cpi) &&
         rc->high_source_sad && rc->frames_to_key > 3 &&
         rc->count_last_scene_change > 4 &&
         cpi->ext_refresh_frame_flags_pending == 0) {
@@ -288,7 +288,7 @@ void vp9_apply_temporal_filter_c(
   for (i = 0; i < block_height; i++) {
     for (j = 0; j < block_width; j++) {
       const int16_t diff =
-          y_frame1[i * (int)y_stride + j] - y_pred[i * (int)block_width + j];
+          y_frame1[i * (int)y_stride + j] - y_pred[i * y_buf_stride + j];
       y_diff_sse[idx++] = diff * diff;
     }
   }
@@ -800,13 +800,39 @@ void vp9_temporal_filter_iterate_row_c(VP9_COMP *cpi, ThreadData *td,
       }
 
       if (blk_fw[0] | blk_fw[1] | blk_fw[2] | blk_fw[3]) {
-        // Construct the predictors
-        temporal_filter_predictors_mb_c(
-            mbd, frames[frame]->y_buffer + mb_y_offset,
-            frames[frame]->u_buffer + mb_uv_offset,
-            frames[frame]->v_buffer + mb_uv_offset, frames[frame]->y_stride,
-            mb_uv_width, mb_uv_height, ref_mv.row, ref_mv.col, predictor, scale,
-            mb_col * BW, mb_row * BH, blk_mvs, use_32x32);
+        // A 32x32 block with a full-pel motion vector in both luma and chroma,
+        // which always is the case for the ARNR frame itself, is its own
+        // predictor. It is filtered in place in the frame instead of being
+        // copied to the predictor first.
+        const int uv_mv_shift = mb_uv_width == (BW >> 1) ? 4 : 3;
+        const int in_place =
+            use_32x32 && !vp9_is_scaled(scale) &&
+            !((ref_mv.row | ref_mv.col) & ((1 << uv_mv_shift) - 1));
+        uint8_t *y_pred = predictor;
+        uint8_t *u_pred = predictor + BLK_PELS;
+        uint8_t *v_pred = predictor + (BLK_PELS << 1);
+        int y_pred_stride = BW;
+        int uv_pred_stride = mb_uv_width;
+
+        if (in_place) {
+          const int uv_offset =
+              (ref_mv.row >> uv_mv_shift) * frames[frame]->uv_stride +
+              (ref_mv.col >> uv_mv_shift);
+          y_pred_stride = frames[frame]->y_stride;
+          uv_pred_stride = frames[frame]->uv_stride;
+          y_pred = frames[frame]->y_buffer + mb_y_offset +
+                   (ref_mv.row >> 3) * y_pred_stride + (ref_mv.col >> 3);
+          u_pred = frames[frame]->u_buffer + mb_uv_offset + uv_offset;
+          v_pred = frames[frame]->v_buffer + mb_uv_offset + uv_offset;
+        } else {
+          // Construct the predictors
+          temporal_filter_predictors_mb_c(
+              mbd, frames[frame]->y_buffer + mb_y_offset,
+              frames[frame]->u_buffer + mb_uv_offset,
+              frames[frame]->v_buffer + mb_uv_offset, frames[frame]->y_stride,
+              mb_uv_width, mb_uv_height, ref_mv.row, ref_mv.col, predictor,
+              scale, mb_col * BW, mb_row * BH, blk_mvs, use_32x32);
+        }
 
 #if CONFIG_VP9_HIGHBITDEPTH
         if (mbd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
@@ -814,35 +840,34 @@ void vp9_temporal_filter_iterate_row_c(VP9_COMP *cpi, ThreadData *td,
           // Apply the filter (YUV)
           vp9_highbd_apply_temporal_filter(
               CONVERT_TO_SHORTPTR(f->y_buffer + mb_y_offset), f->y_stride,
-              CONVERT_TO_SHORTPTR(predictor), BW,
+              CONVERT_TO_SHORTPTR(y_pred), y_pred_stride,
               CONVERT_TO_SHORTPTR(f->u_buffer + mb_uv_offset),
               CONVERT_TO_SHORTPTR(f->v_buffer + mb_uv_offset), f->uv_stride,
-              CONVERT_TO_SHORTPTR(predictor + BLK_PELS),
-              CONVERT_TO_SHORTPTR(predictor + (BLK_PELS << 1)), mb_uv_width, BW,
-              BH, mbd->plane[1].subsampling_x, mbd->plane[1].subsampling_y,
-              adj_strength, blk_fw, use_32x32, accumulator, count,
-              accumulator + BLK_PELS, count + BLK_PELS,
+              CONVERT_TO_SHORTPTR(u_pred), CONVERT_TO_SHORTPTR(v_pred),
+              uv_pred_stride, BW, BH, mbd->plane[1].subsampling_x,
+              mbd->plane[1].subsampling_y, adj_strength, blk_fw, use_32x32,
+              accumulator, count, accumulator + BLK_PELS, count + BLK_PELS,
               accumulator + (BLK_PELS << 1), count + (BLK_PELS << 1));
         } else {
           // Apply the filter (YUV)
           vp9_apply_temporal_filter(
-              f->y_buffer + mb_y_offset, f->y_stride, predictor, BW,
+              f->y_buffer + mb_y_offset, f->y_stride, y_pred, y_pred_stride,
               f->u_buffer + mb_uv_offset, f->v_buffer + mb_uv_offset,
-              f->uv_stride, predictor + BLK_PELS, predictor + (BLK_PELS << 1),
-              mb_uv_width, BW, BH, mbd->plane[1].subsampling_x,
-              mbd->plane[1].subsampling_y, strength, blk_fw, use_32x32,
-              accumulator, count, accumulator + BLK_PELS, count + BLK_PELS,
+              f->uv_stride, u_pred, v_pred, uv_pred_stride, BW, BH,
+              mbd->plane[1].subsampling_x, mbd->plane[1].subsampling_y,
+              strength, blk_fw, use_32x32, accumulator, count,
+              accumulator + BLK_PELS, count + BLK_PELS,
               accumulator + (BLK_PELS << 1), count + (BLK_PELS << 1));
         }
 #else
         // Apply the filter (YUV)
         vp9_apply_temporal_filter(
-            f->y_buffer + mb_y_offset, f->y_stride, predictor, BW,
+            f->y_buffer + mb_y_offset, f->y_stride, y_pred, y_pred_stride,
             f->u_buffer + mb_uv_offset, f->v_buffer + mb_uv_offset,
-            f->uv_stride, predictor + BLK_PELS, predictor + (BLK_PELS << 1),
-            mb_uv_width, BW, BH, mbd->plane[1].subsampling_x,
-            mbd->plane[1].subsampling_y, strength, blk_fw, use_32x32,
-            accumulator, count, accumulator + BLK_PELS, count + BLK_PELS,
+            f->uv_stride, u_pred, v_pred, uv_pred_stride, BW, BH,
+            mbd->plane[1].subsampling_x, mbd->plane[1].subsampling_y,
+            strength, blk_fw, use_32x32, accumulator, count,
+            accumulator + BLK_PELS, count + BLK_PELS,
             accumulator + (BLK_PELS << 1), count + (BLK_PELS << 1));
 #endif  // CONFIG_VP9_HIGHBITDEPTH
       }
@@ -220,9 +220,6 @@ static void vp9_highbd_apply_temporal_filter_luma_8(
 
   assert(strength >= 4 && strength <= 14 &&
          "invalid adjusted temporal filter strength");
-  assert(block_width == 8);
-
-  (void)block_width;
 
   // First row
   mul_first = _mm_load_si128((const __m128i *)neighbors_first[0]);
@@ -258,8 +255,8 @@ static void vp9_highbd_apply_temporal_filter_luma_8(
 
   y_src += y_src_stride;
   y_pre += y_pre_stride;
-  y_count += y_pre_stride;
-  y_accum += y_pre_stride;
+  y_count += block_width;
+  y_accum += block_width;
   y_dist += DIST_STRIDE;
 
   u_src += uv_src_stride;
@@ -322,8 +319,8 @@ static void vp9_highbd_apply_temporal_filter_luma_8(
 
     y_src += y_src_stride;
     y_pre += y_pre_stride;
-    y_count += y_pre_stride;
-    y_accum += y_pre_stride;
+    y_count += block_width;
+    y_accum += block_width;
     y_dist += DIST_STRIDE;
   }
 
@@ -386,7 +383,7 @@ static void vp9_highbd_apply_temporal_filter_luma(
   vp9_highbd_apply_temporal_filter_luma_8(
       y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
       u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride, u_pre + uv_blk_col,
-      v_pre + uv_blk_col, uv_pre_stride, blk_col_step, block_height, ss_x, ss_y,
+      v_pre + uv_blk_col, uv_pre_stride, block_width, block_height, ss_x, ss_y,
       strength, use_whole_blk, y_accum + blk_col, y_count + blk_col,
       y_dist + blk_col, u_dist + uv_blk_col, v_dist + uv_blk_col,
       neighbors_first, neighbors_second, top_weight, bottom_weight);
@@ -401,7 +398,7 @@ static void vp9_highbd_apply_temporal_filter_luma(
     vp9_highbd_apply_temporal_filter_luma_8(
         y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
         u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride,
-        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, blk_col_step,
+        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, block_width,
         block_height, ss_x, ss_y, strength, use_whole_blk, y_accum + blk_col,
         y_count + blk_col, y_dist + blk_col, u_dist + uv_blk_col,
         v_dist + uv_blk_col, neighbors_first, neighbors_second, top_weight,
@@ -419,7 +416,7 @@ static void vp9_highbd_apply_temporal_filter_luma(
     vp9_highbd_apply_temporal_filter_luma_8(
         y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
         u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride,
-        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, blk_col_step,
+        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, block_width,
         block_height, ss_x, ss_y, strength, use_whole_blk, y_accum + blk_col,
         y_count + blk_col, y_dist + blk_col, u_dist + uv_blk_col,
         v_dist + uv_blk_col, neighbors_first, neighbors_second, top_weight,
@@ -431,7 +428,7 @@ static void vp9_highbd_apply_temporal_filter_luma(
   vp9_highbd_apply_temporal_filter_luma_8(
       y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
       u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride, u_pre + uv_blk_col,
-      v_pre + uv_blk_col, uv_pre_stride, blk_col_step, block_height, ss_x, ss_y,
+      v_pre + uv_blk_col, uv_pre_stride, block_width, block_height, ss_x, ss_y,
       strength, use_whole_blk, y_accum + blk_col, y_count + blk_col,
       y_dist + blk_col, u_dist + uv_blk_col, v_dist + uv_blk_col,
       neighbors_first, neighbors_second, top_weight, bottom_weight);
@@ -516,8 +513,6 @@ static void vp9_highbd_apply_temporal_filter_chroma_8(
   // Loop variable
   unsigned int h;
 
-  (void)uv_block_width;
-
   // First row
   mul_fst = _mm_load_si128((const __m128i *)neighbors_fst[0]);
   mul_snd = _mm_load_si128((const __m128i *)neighbors_snd[0]);
@@ -571,10 +566,10 @@ static void vp9_highbd_apply_temporal_filter_chroma_8(
   v_src += uv_src_stride;
   v_pre += uv_pre_stride;
   v_dist += DIST_STRIDE;
-  u_count += uv_pre_stride;
-  u_accum += uv_pre_stride;
-  v_count += uv_pre_stride;
-  v_accum += uv_pre_stride;
+  u_count += uv_block_width;
+  u_accum += uv_block_width;
+  v_count += uv_block_width;
+  v_accum += uv_block_width;
 
   y_src += y_src_stride * (1 + ss_y);
   y_pre += y_pre_stride * (1 + ss_y);
@@ -655,10 +650,10 @@ static void vp9_highbd_apply_temporal_filter_chroma_8(
     v_src += uv_src_stride;
     v_pre += uv_pre_stride;
     v_dist += DIST_STRIDE;
-    u_count += uv_pre_stride;
-    u_accum += uv_pre_stride;
-    v_count += uv_pre_stride;
-    v_accum += uv_pre_stride;
+    u_count += uv_block_width;
+    u_accum += uv_block_width;
+    v_count += uv_block_width;
+    v_accum += uv_block_width;
 
     y_src += y_src_stride * (1 + ss_y);
     y_pre += y_pre_stride * (1 + ss_y);
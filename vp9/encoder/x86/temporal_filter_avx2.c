@@ -0,0 +1,396 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_temporal_filter.h"
+#include "vp9/encoder/x86/temporal_filter_constants.h"
+
+// The distortion buffers have a row and a column of zeros on each side of the
+// block, so the 3x3 neighborhood sums need no special case at the edges.
+#define DIST_ROWS ((BH) + 2)
+
+// Multipliers indexed by the number of summed values. See
+// temporal_filter_constants.h.
+static const uint16_t index_mult[14] = {
+  0,
+  0,
+  0,
+  0,
+  (uint16_t)NEIGHBOR_CONSTANT_4,
+  (uint16_t)NEIGHBOR_CONSTANT_5,
+  (uint16_t)NEIGHBOR_CONSTANT_6,
+  (uint16_t)NEIGHBOR_CONSTANT_7,
+  (uint16_t)NEIGHBOR_CONSTANT_8,
+  (uint16_t)NEIGHBOR_CONSTANT_9,
+  (uint16_t)NEIGHBOR_CONSTANT_10,
+  (uint16_t)NEIGHBOR_CONSTANT_11,
+  0,
+  (uint16_t)NEIGHBOR_CONSTANT_13,
+};
+
+// Compute (a-b)**2 for 16 8-bit pixels and store them as 16-bit values.
+static INLINE void store_dist_16(const uint8_t *a, const uint8_t *b,
+                                 uint16_t *dst) {
+  const __m256i a_reg =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)a));
+  const __m256i b_reg =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)b));
+  const __m256i diff = _mm256_sub_epi16(a_reg, b_reg);
+
+  _mm256_storeu_si256((__m256i *)dst, _mm256_mullo_epi16(diff, diff));
+}
+
+static INLINE void store_dist_8(const uint8_t *a, const uint8_t *b,
+                                uint16_t *dst) {
+  const __m128i a_reg = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)a));
+  const __m128i b_reg = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)b));
+  const __m128i diff = _mm_sub_epi16(a_reg, b_reg);
+
+  _mm_storeu_si128((__m128i *)dst, _mm_mullo_epi16(diff, diff));
+}
+
+static INLINE __m256i load_dist_16(const uint16_t *dist) {
+  return _mm256_loadu_si256((const __m256i *)dist);
+}
+
+// Sum 16 horizontally adjacent triples of distortion, saturating at 65535
+// like the C code does.
+static INLINE __m256i get_sum_16(const uint16_t *dist) {
+  const __m256i sum =
+      _mm256_adds_epu16(load_dist_16(dist - 1), load_dist_16(dist));
+  return _mm256_adds_epu16(sum, load_dist_16(dist + 1));
+}
+
+// Duplicate each of 8 16-bit values to form 16.
+static INLINE __m256i upsample_8(const uint16_t *dist) {
+  const __m256i reg =
+      _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)dist));
+  return _mm256_or_si256(reg, _mm256_slli_epi32(reg, 16));
+}
+
+// Sum horizontal pairs of 32 16-bit values to form 16, saturating.
+static INLINE __m256i get_pair_sum_32(const uint16_t *dist) {
+  const __m256i mask = _mm256_set1_epi32(0xffff);
+  const __m256i a = load_dist_16(dist);
+  const __m256i b = load_dist_16(dist + 16);
+  const __m256i a_sum = _mm256_add_epi32(_mm256_and_si256(a, mask),
+                                         _mm256_srli_epi32(a, 16));
+  const __m256i b_sum = _mm256_add_epi32(_mm256_and_si256(b, mask),
+                                         _mm256_srli_epi32(b, 16));
+  return _mm256_permute4x64_epi64(_mm256_packus_epi32(a_sum, b_sum), 0xd8);
+}
+
+// Read the luma distortion that corresponds to 16 chroma pixels.
+static INLINE __m256i get_luma_dist_for_chroma_16(const uint16_t *y_dist,
+                                                  int ss_x, int ss_y) {
+  __m256i sum;
+  if (ss_x) {
+    sum = get_pair_sum_32(y_dist);
+    if (ss_y) {
+      sum = _mm256_adds_epu16(sum, get_pair_sum_32(y_dist + DIST_STRIDE));
+    }
+  } else {
+    sum = load_dist_16(y_dist);
+    if (ss_y) {
+      sum = _mm256_adds_epu16(sum, load_dist_16(y_dist + DIST_STRIDE));
+    }
+  }
+  return sum;
+}
+
+// Compute the filter modifier from the sum of distortion:
+// 16 - min(16, ((sum * 3 / count) + rounding) >> strength), times weight.
+static INLINE __m256i get_modifier_16(__m256i sum, __m256i mul,
+                                      __m256i rounding, __m128i strength,
+                                      __m256i weight) {
+  const __m256i sixteen = _mm256_set1_epi16(16);
+
+  sum = _mm256_mulhi_epu16(sum, mul);
+  sum = _mm256_adds_epu16(sum, rounding);
+  sum = _mm256_srl_epi16(sum, strength);
+  sum = _mm256_min_epu16(sum, sixteen);
+  sum = _mm256_sub_epi16(sixteen, sum);
+  return _mm256_mullo_epi16(sum, weight);
+}
+
+// Add the modifier to 16 counts, and the modifier times the predicted pixel
+// to 16 accumulators.
+static INLINE void accumulate_and_store_16(__m256i mod, __m128i pre,
+                                           uint16_t *count, uint32_t *accum) {
+  const __m256i pre_mod = _mm256_mullo_epi16(mod, _mm256_cvtepu8_epi16(pre));
+  const __m256i count_reg = _mm256_loadu_si256((const __m256i *)count);
+  __m256i accum_0 = _mm256_loadu_si256((const __m256i *)accum);
+  __m256i accum_1 = _mm256_loadu_si256((const __m256i *)(accum + 8));
+
+  accum_0 = _mm256_add_epi32(
+      accum_0, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(pre_mod)));
+  accum_1 = _mm256_add_epi32(
+      accum_1, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(pre_mod, 1)));
+
+  _mm256_storeu_si256((__m256i *)count, _mm256_add_epi16(count_reg, mod));
+  _mm256_storeu_si256((__m256i *)accum, accum_0);
+  _mm256_storeu_si256((__m256i *)(accum + 8), accum_1);
+}
+
+static INLINE void accumulate_and_store_8(__m256i mod, __m128i pre,
+                                          uint16_t *count, uint32_t *accum) {
+  const __m128i mod_8 = _mm256_castsi256_si128(mod);
+  const __m128i pre_mod = _mm_mullo_epi16(mod_8, _mm_cvtepu8_epi16(pre));
+  const __m128i count_reg = _mm_loadu_si128((const __m128i *)count);
+  const __m256i accum_reg = _mm256_loadu_si256((const __m256i *)accum);
+
+  _mm_storeu_si128((__m128i *)count, _mm_add_epi16(count_reg, mod_8));
+  _mm256_storeu_si256(
+      (__m256i *)accum,
+      _mm256_add_epi32(accum_reg, _mm256_cvtepu16_epi32(pre_mod)));
+}
+
+// Get the multipliers of 16 pixels starting at 'col' in a plane 'width'
+// pixels wide. 'rows' is the number of rows of the 3x3 neighborhood inside the
+// block and 'extra' the number of values summed from the other planes.
+static INLINE __m256i get_mult_16(unsigned int col, unsigned int width,
+                                  int rows, int extra) {
+  const __m256i index = _mm256_add_epi16(
+      _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+      _mm256_set1_epi16(col));
+  const __m256i edge = _mm256_or_si256(
+      _mm256_cmpeq_epi16(index, _mm256_setzero_si256()),
+      _mm256_cmpeq_epi16(index, _mm256_set1_epi16(width - 1)));
+  return _mm256_blendv_epi8(_mm256_set1_epi16(index_mult[rows * 3 + extra]),
+                            _mm256_set1_epi16(index_mult[rows * 2 + extra]),
+                            edge);
+}
+
+// Get the filter weights of 16 pixels starting at 'col' in a plane 'width'
+// pixels wide, given the weights of its left and right halves.
+static INLINE __m256i get_weight_16(unsigned int col, unsigned int width,
+                                    int left, int right) {
+  const __m256i index = _mm256_add_epi16(
+      _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+      _mm256_set1_epi16(col));
+  const __m256i is_right =
+      _mm256_cmpgt_epi16(index, _mm256_set1_epi16(width / 2 - 1));
+  return _mm256_blendv_epi8(_mm256_set1_epi16(left), _mm256_set1_epi16(right),
+                            is_right);
+}
+
+// Filter the luma plane 16 pixels at a time. The 3x3 sums of the rows above,
+// at and below the current row are kept in registers as the rows advance.
+static void apply_temporal_filter_luma(
+    const uint8_t *y_pre, int y_pre_stride, unsigned int block_width,
+    unsigned int block_height, int ss_x, int ss_y, int strength,
+    const int *blk_fw, int use_whole_blk, uint32_t *y_accum, uint16_t *y_count,
+    const uint16_t *y_dist, const uint16_t *u_dist, const uint16_t *v_dist) {
+  const __m256i rounding = _mm256_set1_epi16((1 << strength) >> 1);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const int *const bottom_fw = use_whole_blk ? blk_fw : blk_fw + 2;
+  const int right = !use_whole_blk;
+  unsigned int row, col;
+
+  for (col = 0; col < block_width; col += 16) {
+    const __m256i edge_mul = get_mult_16(col, block_width, 2, 2);
+    const __m256i inner_mul = get_mult_16(col, block_width, 3, 2);
+    const __m256i top_weight =
+        get_weight_16(col, block_width, blk_fw[0], blk_fw[right]);
+    const __m256i bottom_weight =
+        get_weight_16(col, block_width, bottom_fw[0], bottom_fw[right]);
+    const uint16_t *y_dist_ptr = y_dist + col;
+    __m256i sum_row_1 = get_sum_16(y_dist_ptr - DIST_STRIDE);
+    __m256i sum_row_2 = get_sum_16(y_dist_ptr);
+    __m256i sum_row_3;
+
+    for (row = 0; row < block_height; ++row) {
+      const int inner = row > 0 && row < block_height - 1;
+      const int bottom = row >= block_height / 2;
+      const int uv_offset = (row >> ss_y) * DIST_STRIDE + (col >> ss_x);
+      __m256i sum, u_reg, v_reg;
+
+      sum_row_3 = get_sum_16(y_dist_ptr + DIST_STRIDE);
+      sum = _mm256_adds_epu16(_mm256_adds_epu16(sum_row_1, sum_row_2),
+                              sum_row_3);
+
+      if (ss_x) {
+        u_reg = upsample_8(u_dist + uv_offset);
+        v_reg = upsample_8(v_dist + uv_offset);
+      } else {
+        u_reg = load_dist_16(u_dist + uv_offset);
+        v_reg = load_dist_16(v_dist + uv_offset);
+      }
+      sum = _mm256_adds_epu16(_mm256_adds_epu16(sum, u_reg), v_reg);
+
+      sum = get_modifier_16(sum, inner ? inner_mul : edge_mul, rounding, shift,
+                            bottom ? bottom_weight : top_weight);
+      accumulate_and_store_16(
+          sum,
+          _mm_loadu_si128((const __m128i *)(y_pre + row * y_pre_stride + col)),
+          y_count + row * block_width + col, y_accum + row * block_width + col);
+
+      sum_row_1 = sum_row_2;
+      sum_row_2 = sum_row_3;
+      y_dist_ptr += DIST_STRIDE;
+    }
+  }
+}
+
+// Filter both chroma planes 16 pixels at a time, or 8 when the plane is only 8
+// pixels wide.
+static void apply_temporal_filter_chroma(
+    const uint8_t *u_pre, const uint8_t *v_pre, int uv_pre_stride,
+    unsigned int uv_width, unsigned int uv_height, int ss_x, int ss_y,
+    int strength, const int *blk_fw, int use_whole_blk, uint32_t *u_accum,
+    uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count,
+    const uint16_t *y_dist, const uint16_t *u_dist, const uint16_t *v_dist) {
+  const __m256i rounding = _mm256_set1_epi16((1 << strength) >> 1);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const int luma_count = (1 + ss_x) * (1 + ss_y);
+  const int *const bottom_fw = use_whole_blk ? blk_fw : blk_fw + 2;
+  const int right = !use_whole_blk;
+  unsigned int row, col;
+
+  for (col = 0; col < uv_width; col += 16) {
+    const __m256i edge_mul = get_mult_16(col, uv_width, 2, luma_count);
+    const __m256i inner_mul = get_mult_16(col, uv_width, 3, luma_count);
+    const __m256i top_weight =
+        get_weight_16(col, uv_width, blk_fw[0], blk_fw[right]);
+    const __m256i bottom_weight =
+        get_weight_16(col, uv_width, bottom_fw[0], bottom_fw[right]);
+    const uint16_t *u_dist_ptr = u_dist + col;
+    const uint16_t *v_dist_ptr = v_dist + col;
+    const uint16_t *y_dist_ptr = y_dist + (col << ss_x);
+    __m256i u_sum_row_1 = get_sum_16(u_dist_ptr - DIST_STRIDE);
+    __m256i u_sum_row_2 = get_sum_16(u_dist_ptr);
+    __m256i v_sum_row_1 = get_sum_16(v_dist_ptr - DIST_STRIDE);
+    __m256i v_sum_row_2 = get_sum_16(v_dist_ptr);
+    __m256i u_sum_row_3, v_sum_row_3;
+
+    for (row = 0; row < uv_height; ++row) {
+      const int inner = row > 0 && row < uv_height - 1;
+      const int bottom = row >= uv_height / 2;
+      const __m256i mul = inner ? inner_mul : edge_mul;
+      const __m256i wgt = bottom ? bottom_weight : top_weight;
+      const __m256i y_reg = get_luma_dist_for_chroma_16(y_dist_ptr, ss_x, ss_y);
+      const int offset = row * uv_width + col;
+      const uint8_t *u_pre_ptr = u_pre + row * uv_pre_stride + col;
+      const uint8_t *v_pre_ptr = v_pre + row * uv_pre_stride + col;
+      __m256i u_sum, v_sum;
+
+      u_sum_row_3 = get_sum_16(u_dist_ptr + DIST_STRIDE);
+      v_sum_row_3 = get_sum_16(v_dist_ptr + DIST_STRIDE);
+      u_sum = _mm256_adds_epu16(_mm256_adds_epu16(u_sum_row_1, u_sum_row_2),
+                                u_sum_row_3);
+      v_sum = _mm256_adds_epu16(_mm256_adds_epu16(v_sum_row_1, v_sum_row_2),
+                                v_sum_row_3);
+      u_sum = _mm256_adds_epu16(u_sum, y_reg);
+      v_sum = _mm256_adds_epu16(v_sum, y_reg);
+
+      u_sum = get_modifier_16(u_sum, mul, rounding, shift, wgt);
+      v_sum = get_modifier_16(v_sum, mul, rounding, shift, wgt);
+
+      if (uv_width - col >= 16) {
+        accumulate_and_store_16(u_sum,
+                                _mm_loadu_si128((const __m128i *)u_pre_ptr),
+                                u_count + offset, u_accum + offset);
+        accumulate_and_store_16(v_sum,
+                                _mm_loadu_si128((const __m128i *)v_pre_ptr),
+                                v_count + offset, v_accum + offset);
+      } else {
+        accumulate_and_store_8(u_sum,
+                               _mm_loadl_epi64((const __m128i *)u_pre_ptr),
+                               u_count + offset, u_accum + offset);
+        accumulate_and_store_8(v_sum,
+                               _mm_loadl_epi64((const __m128i *)v_pre_ptr),
+                               v_count + offset, v_accum + offset);
+      }
+
+      u_sum_row_1 = u_sum_row_2;
+      u_sum_row_2 = u_sum_row_3;
+      v_sum_row_1 = v_sum_row_2;
+      v_sum_row_2 = v_sum_row_3;
+      u_dist_ptr += DIST_STRIDE;
+      v_dist_ptr += DIST_STRIDE;
+      y_dist_ptr += DIST_STRIDE << ss_y;
+    }
+  }
+}
+
+void vp9_apply_temporal_filter_avx2(
+    const uint8_t *y_src, int y_src_stride, const uint8_t *y_pre,
+    int y_pre_stride, const uint8_t *u_src, const uint8_t *v_src,
+    int uv_src_stride, const uint8_t *u_pre, const uint8_t *v_pre,
+    int uv_pre_stride, unsigned int block_width, unsigned int block_height,
+    int ss_x, int ss_y, int strength, const int *const blk_fw,
+    int use_whole_blk, uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum,
+    uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count) {
+  const unsigned int chroma_height = block_height >> ss_y,
+                     chroma_width = block_width >> ss_x;
+
+  DECLARE_ALIGNED(32, uint16_t, y_dist[DIST_ROWS * DIST_STRIDE]) = { 0 };
+  DECLARE_ALIGNED(32, uint16_t, u_dist[DIST_ROWS * DIST_STRIDE]) = { 0 };
+  DECLARE_ALIGNED(32, uint16_t, v_dist[DIST_ROWS * DIST_STRIDE]) = { 0 };
+
+  uint16_t *const y_dist_ptr = y_dist + DIST_STRIDE + 1;
+  uint16_t *const u_dist_ptr = u_dist + DIST_STRIDE + 1;
+  uint16_t *const v_dist_ptr = v_dist + DIST_STRIDE + 1;
+
+  // Loop variables
+  unsigned int row, blk_col;
+
+  assert(block_width <= BW && "block width too large");
+  assert(block_height <= BH && "block height too large");
+  assert(block_width % 16 == 0 && "block width must be multiple of 16");
+  assert(block_height % 2 == 0 && "block height must be even");
+  assert((ss_x == 0 || ss_x == 1) && (ss_y == 0 || ss_y == 1) &&
+         "invalid chroma subsampling");
+  assert(strength >= 0 && strength <= 6 && "invalid temporal filter strength");
+  assert(blk_fw[0] >= 0 && "filter weight must be positive");
+  assert(
+      (use_whole_blk || (blk_fw[1] >= 0 && blk_fw[2] >= 0 && blk_fw[3] >= 0)) &&
+      "subblock filter weight must be positive");
+  assert(blk_fw[0] <= 2 && "sublock filter weight must be less than 2");
+  assert(
+      (use_whole_blk || (blk_fw[1] <= 2 && blk_fw[2] <= 2 && blk_fw[3] <= 2)) &&
+      "subblock filter weight must be less than 2");
+
+  // Precompute the difference squared
+  for (row = 0; row < block_height; row++) {
+    for (blk_col = 0; blk_col < block_width; blk_col += 16) {
+      store_dist_16(y_src + row * y_src_stride + blk_col,
+                    y_pre + row * y_pre_stride + blk_col,
+                    y_dist_ptr + row * DIST_STRIDE + blk_col);
+    }
+  }
+
+  for (row = 0; row < chroma_height; row++) {
+    for (blk_col = 0; blk_col < chroma_width; blk_col += 8) {
+      store_dist_8(u_src + row * uv_src_stride + blk_col,
+                   u_pre + row * uv_pre_stride + blk_col,
+                   u_dist_ptr + row * DIST_STRIDE + blk_col);
+      store_dist_8(v_src + row * uv_src_stride + blk_col,
+                   v_pre + row * uv_pre_stride + blk_col,
+                   v_dist_ptr + row * DIST_STRIDE + blk_col);
+    }
+  }
+
+  apply_temporal_filter_luma(y_pre, y_pre_stride, block_width, block_height,
+                             ss_x, ss_y, strength, blk_fw, use_whole_blk,
+                             y_accum, y_count, y_dist_ptr, u_dist_ptr,
+                             v_dist_ptr);
+
+  apply_temporal_filter_chroma(u_pre, v_pre, uv_pre_stride, chroma_width,
+                               chroma_height, ss_x, ss_y, strength, blk_fw,
+                               use_whole_blk, u_accum, u_count, v_accum,
+                               v_count, y_dist_ptr, u_dist_ptr, v_dist_ptr);
+}
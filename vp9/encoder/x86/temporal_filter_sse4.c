@@ -266,7 +266,8 @@ static INLINE void add_luma_dist_to_8_chroma_mod(const uint16_t *y_dist,
 }
 
 // Apply temporal filter to the luma components. This performs temporal
-// filtering on a luma block of 16 X block_height. Use blk_fw as an array of
+// filtering on a luma block of 16 X block_height, in a block whose
+// accumulator and count stride is block_width. Use blk_fw as an array of
 // size 4 for the weights for each of the 4 subblocks if blk_fw is not NULL,
 // else use top_weight for top half, and bottom weight for bottom half.
 static void vp9_apply_temporal_filter_luma_16(
@@ -300,10 +301,6 @@ static void vp9_apply_temporal_filter_luma_16(
   assert(strength >= 0);
   assert(strength <= 6);
 
-  assert(block_width == 16);
-
-  (void)block_width;
-
   // Initialize the weights
   if (blk_fw) {
     weight_first = _mm_set1_epi16(blk_fw[0]);
@@ -344,8 +341,8 @@ static void vp9_apply_temporal_filter_luma_16(
 
   y_src += y_src_stride;
   y_pre += y_pre_stride;
-  y_count += y_pre_stride;
-  y_accum += y_pre_stride;
+  y_count += block_width;
+  y_accum += block_width;
   y_dist += DIST_STRIDE;
 
   u_src += uv_src_stride;
@@ -415,8 +412,8 @@ static void vp9_apply_temporal_filter_luma_16(
 
     y_src += y_src_stride;
     y_pre += y_pre_stride;
-    y_count += y_pre_stride;
-    y_accum += y_pre_stride;
+    y_count += block_width;
+    y_accum += block_width;
     y_dist += DIST_STRIDE;
   }
 
@@ -484,7 +481,7 @@ static void vp9_apply_temporal_filter_luma(
       vp9_apply_temporal_filter_luma_16(
           y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
           u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride,
-          u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, 16,
+          u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, block_width,
           block_height, ss_x, ss_y, strength, use_whole_blk, y_accum + blk_col,
           y_count + blk_col, y_dist + blk_col, u_dist + uv_blk_col,
           v_dist + uv_blk_col, neighbors_first, neighbors_second, top_weight,
@@ -493,7 +490,7 @@ static void vp9_apply_temporal_filter_luma(
       vp9_apply_temporal_filter_luma_16(
           y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
           u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride,
-          u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, 16,
+          u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, block_width,
           block_height, ss_x, ss_y, strength, use_whole_blk, y_accum + blk_col,
           y_count + blk_col, y_dist + blk_col, u_dist + uv_blk_col,
           v_dist + uv_blk_col, neighbors_first, neighbors_second, 0, 0, blk_fw);
@@ -508,10 +505,10 @@ static void vp9_apply_temporal_filter_luma(
   vp9_apply_temporal_filter_luma_16(
       y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
       u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride, u_pre + uv_blk_col,
-      v_pre + uv_blk_col, uv_pre_stride, 16, block_height, ss_x, ss_y, strength,
-      use_whole_blk, y_accum + blk_col, y_count + blk_col, y_dist + blk_col,
-      u_dist + uv_blk_col, v_dist + uv_blk_col, neighbors_first,
-      neighbors_second, top_weight, bottom_weight, NULL);
+      v_pre + uv_blk_col, uv_pre_stride, block_width, block_height, ss_x, ss_y,
+      strength, use_whole_blk, y_accum + blk_col, y_count + blk_col,
+      y_dist + blk_col, u_dist + uv_blk_col, v_dist + uv_blk_col,
+      neighbors_first, neighbors_second, top_weight, bottom_weight, NULL);
 
   blk_col += blk_col_step;
   uv_blk_col += uv_blk_col_step;
@@ -523,8 +520,8 @@ static void vp9_apply_temporal_filter_luma(
     vp9_apply_temporal_filter_luma_16(
         y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
         u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride,
-        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, 16, block_height,
-        ss_x, ss_y, strength, use_whole_blk, y_accum + blk_col,
+        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, block_width,
+        block_height, ss_x, ss_y, strength, use_whole_blk, y_accum + blk_col,
         y_count + blk_col, y_dist + blk_col, u_dist + uv_blk_col,
         v_dist + uv_blk_col, neighbors_first, neighbors_second, top_weight,
         bottom_weight, NULL);
@@ -541,8 +538,8 @@ static void vp9_apply_temporal_filter_luma(
     vp9_apply_temporal_filter_luma_16(
         y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
         u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride,
-        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, 16, block_height,
-        ss_x, ss_y, strength, use_whole_blk, y_accum + blk_col,
+        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, block_width,
+        block_height, ss_x, ss_y, strength, use_whole_blk, y_accum + blk_col,
         y_count + blk_col, y_dist + blk_col, u_dist + uv_blk_col,
         v_dist + uv_blk_col, neighbors_first, neighbors_second, top_weight,
         bottom_weight, NULL);
@@ -553,10 +550,10 @@ static void vp9_apply_temporal_filter_luma(
   vp9_apply_temporal_filter_luma_16(
       y_src + blk_col, y_src_stride, y_pre + blk_col, y_pre_stride,
       u_src + uv_blk_col, v_src + uv_blk_col, uv_src_stride, u_pre + uv_blk_col,
-      v_pre + uv_blk_col, uv_pre_stride, 16, block_height, ss_x, ss_y, strength,
-      use_whole_blk, y_accum + blk_col, y_count + blk_col, y_dist + blk_col,
-      u_dist + uv_blk_col, v_dist + uv_blk_col, neighbors_first,
-      neighbors_second, top_weight, bottom_weight, NULL);
+      v_pre + uv_blk_col, uv_pre_stride, block_width, block_height, ss_x, ss_y,
+      strength, use_whole_blk, y_accum + blk_col, y_count + blk_col,
+      y_dist + blk_col, u_dist + uv_blk_col, v_dist + uv_blk_col,
+      neighbors_first, neighbors_second, top_weight, bottom_weight, NULL);
 }
 
 // Apply temporal filter to the chroma components. This performs temporal
@@ -587,8 +584,6 @@ static void vp9_apply_temporal_filter_chroma_8(
   // Loop variable
   unsigned int h;
 
-  (void)uv_block_width;
-
   // Initilize weight
   if (blk_fw) {
     weight = _mm_setr_epi16(blk_fw[0], blk_fw[0], blk_fw[0], blk_fw[0],
@@ -627,10 +622,10 @@ static void vp9_apply_temporal_filter_chroma_8(
   v_src += uv_src_stride;
   v_pre += uv_pre_stride;
   v_dist += DIST_STRIDE;
-  u_count += uv_pre_stride;
-  u_accum += uv_pre_stride;
-  v_count += uv_pre_stride;
-  v_accum += uv_pre_stride;
+  u_count += uv_block_width;
+  u_accum += uv_block_width;
+  v_count += uv_block_width;
+  v_accum += uv_block_width;
 
   y_src += y_src_stride * (1 + ss_y);
   y_pre += y_pre_stride * (1 + ss_y);
@@ -682,10 +677,10 @@ static void vp9_apply_temporal_filter_chroma_8(
     v_src += uv_src_stride;
     v_pre += uv_pre_stride;
     v_dist += DIST_STRIDE;
-    u_count += uv_pre_stride;
-    u_accum += uv_pre_stride;
-    v_count += uv_pre_stride;
-    v_accum += uv_pre_stride;
+    u_count += uv_block_width;
+    u_accum += uv_block_width;
+    v_count += uv_block_width;
+    v_accum += uv_block_width;
 
     y_src += y_src_stride * (1 + ss_y);
     y_pre += y_pre_stride * (1 + ss_y);
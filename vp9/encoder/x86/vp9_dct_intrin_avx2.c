@@ -0,0 +1,438 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vp9/common/vp9_enums.h"
+#include "vpx_dsp/txfm_common.h"
+#include "vpx_dsp/x86/inv_txfm_avx2.h"
+
+// The 1-D transforms follow fdct8_sse2(), fadst8_sse2(), fdct16_8col() and
+// fadst16_8col() of vp9_dct_intrin_sse2.c, so the results are the same. A pass
+// transforms all columns of the block at once: the 8x8 transforms hold two
+// rows per register and the 16x16 transforms one. The ADST butterflies are
+// the same as those of the inverse transforms, which are shared through
+// iadst8_avx2() and iadst16_avx2().
+
+// Takes in[i] = [row 2 * i | row 2 * i + 1] and returns in[i] =
+// [o(i) | o(i + 4)], as iadst8_avx2() does.
+static void fdct8_avx2(__m256i *in) {
+  const __m256i k_out0_out4 =
+      pair_pair256_set_epi16(cospi_16_64, cospi_16_64, -cospi_16_64,
+                             cospi_16_64);
+  const __m256i k_out2_out6 =
+      pair_pair256_set_epi16(cospi_8_64, cospi_24_64, -cospi_8_64,
+                             cospi_24_64);
+  const __m256i k_t2_t3 = pair_pair256_set_epi16(cospi_16_64, -cospi_16_64,
+                                                 cospi_16_64, cospi_16_64);
+  const __m256i k_out1_out7 =
+      pair_pair256_set_epi16(cospi_28_64, cospi_4_64, cospi_28_64,
+                             -cospi_4_64);
+  const __m256i k_out5_out3 =
+      pair_pair256_set_epi16(cospi_12_64, cospi_20_64, cospi_12_64,
+                             -cospi_20_64);
+  const __m256i r54 = _mm256_permute4x64_epi64(in[2], 0x4e);
+  const __m256i r76 = _mm256_permute4x64_epi64(in[3], 0x4e);
+  __m256i s01, s23, s32, s54, s76, s65, s47, x01, x32, x03, x12, t23;
+  __m256i out17, out53;
+
+  // stage 1
+  s01 = _mm256_add_epi16(in[0], r76);
+  s23 = _mm256_add_epi16(in[1], r54);
+  s76 = _mm256_sub_epi16(in[0], r76);
+  s54 = _mm256_sub_epi16(in[1], r54);
+  s32 = _mm256_permute4x64_epi64(s23, 0x4e);
+  x01 = _mm256_add_epi16(s01, s32);
+  x32 = _mm256_sub_epi16(s01, s32);
+  in[0] = mult_round_shift_lanes_avx2(
+      x01, _mm256_permute4x64_epi64(x01, 0x4e), k_out0_out4);
+  in[2] = mult_round_shift_lanes_avx2(
+      x32, _mm256_permute4x64_epi64(x32, 0x4e), k_out2_out6);
+
+  // stage 2
+  s65 = _mm256_permute2x128_si256(s76, s54, 0x21);
+  t23 = mult_round_shift_lanes_avx2(s65, _mm256_permute4x64_epi64(s65, 0x4e),
+                                    k_t2_t3);
+
+  // stage 3
+  s47 = _mm256_permute2x128_si256(s54, s76, 0x21);
+  x03 = _mm256_add_epi16(s47, t23);
+  x12 = _mm256_sub_epi16(s47, t23);
+
+  // stage 4
+  out17 = mult_round_shift_lanes_avx2(
+      x03, _mm256_permute4x64_epi64(x03, 0x4e), k_out1_out7);
+  out53 = mult_round_shift_lanes_avx2(
+      x12, _mm256_permute4x64_epi64(x12, 0x4e), k_out5_out3);
+  in[1] = _mm256_permute2x128_si256(out17, out53, 0x20);
+  in[3] = _mm256_permute2x128_si256(out53, out17, 0x31);
+}
+
+static INLINE void fdct8(__m256i *in) {
+  fdct8_avx2(in);
+  transpose_16bit_8x8_avx2(in, in);
+}
+
+static INLINE void fadst8(__m256i *in) {
+  iadst8_avx2(in);
+  transpose_16bit_8x8_avx2(in, in);
+}
+
+// Returns fdct_round_shift(a * c0 + b * c1), packed to 16 bits with
+// saturation.
+static INLINE __m256i mult_round_shift(const __m256i a, const __m256i b,
+                                       const int c0, const int c1) {
+  const __m256i cst = pair256_set_epi16(c0, c1);
+  const __m256i lo = _mm256_unpacklo_epi16(a, b);
+  const __m256i hi = _mm256_unpackhi_epi16(a, b);
+  return idct_calc_wraplow_avx2(lo, hi, cst);
+}
+
+static void fdct16_avx2(__m256i *in) {
+  __m256i i[8], s[8], p[8], t[8], u[4];
+  int k;
+
+  // stage 1
+  for (k = 0; k < 8; ++k) {
+    i[k] = _mm256_add_epi16(in[k], in[15 - k]);
+    s[7 - k] = _mm256_sub_epi16(in[k], in[15 - k]);
+  }
+  for (k = 0; k < 4; ++k) {
+    p[k] = _mm256_add_epi16(i[k], i[7 - k]);
+    p[7 - k] = _mm256_sub_epi16(i[k], i[7 - k]);
+  }
+  u[0] = _mm256_add_epi16(p[0], p[3]);
+  u[1] = _mm256_add_epi16(p[1], p[2]);
+  u[2] = _mm256_sub_epi16(p[1], p[2]);
+  u[3] = _mm256_sub_epi16(p[0], p[3]);
+  in[0] = mult_round_shift(u[0], u[1], cospi_16_64, cospi_16_64);
+  in[8] = mult_round_shift(u[0], u[1], cospi_16_64, -cospi_16_64);
+  in[4] = mult_round_shift(u[2], u[3], cospi_24_64, cospi_8_64);
+  in[12] = mult_round_shift(u[2], u[3], -cospi_8_64, cospi_24_64);
+
+  u[0] = mult_round_shift(p[5], p[6], -cospi_16_64, cospi_16_64);
+  u[1] = mult_round_shift(p[5], p[6], cospi_16_64, cospi_16_64);
+  t[0] = _mm256_add_epi16(p[4], u[0]);
+  t[1] = _mm256_sub_epi16(p[4], u[0]);
+  t[2] = _mm256_sub_epi16(p[7], u[1]);
+  t[3] = _mm256_add_epi16(p[7], u[1]);
+  in[2] = mult_round_shift(t[0], t[3], cospi_28_64, cospi_4_64);
+  in[6] = mult_round_shift(t[1], t[2], -cospi_20_64, cospi_12_64);
+  in[10] = mult_round_shift(t[1], t[2], cospi_12_64, cospi_20_64);
+  in[14] = mult_round_shift(t[0], t[3], -cospi_4_64, cospi_28_64);
+
+  // stage 2
+  t[2] = mult_round_shift(s[2], s[5], -cospi_16_64, cospi_16_64);
+  t[3] = mult_round_shift(s[3], s[4], -cospi_16_64, cospi_16_64);
+  t[4] = mult_round_shift(s[3], s[4], cospi_16_64, cospi_16_64);
+  t[5] = mult_round_shift(s[2], s[5], cospi_16_64, cospi_16_64);
+
+  // stage 3
+  p[0] = _mm256_add_epi16(s[0], t[3]);
+  p[1] = _mm256_add_epi16(s[1], t[2]);
+  p[2] = _mm256_sub_epi16(s[1], t[2]);
+  p[3] = _mm256_sub_epi16(s[0], t[3]);
+  p[4] = _mm256_sub_epi16(s[7], t[4]);
+  p[5] = _mm256_sub_epi16(s[6], t[5]);
+  p[6] = _mm256_add_epi16(s[6], t[5]);
+  p[7] = _mm256_add_epi16(s[7], t[4]);
+
+  // stage 4
+  t[1] = mult_round_shift(p[1], p[6], -cospi_8_64, cospi_24_64);
+  t[2] = mult_round_shift(p[2], p[5], cospi_24_64, cospi_8_64);
+  t[5] = mult_round_shift(p[2], p[5], cospi_8_64, -cospi_24_64);
+  t[6] = mult_round_shift(p[1], p[6], cospi_24_64, cospi_8_64);
+
+  // stage 5
+  s[0] = _mm256_add_epi16(p[0], t[1]);
+  s[1] = _mm256_sub_epi16(p[0], t[1]);
+  s[2] = _mm256_add_epi16(p[3], t[2]);
+  s[3] = _mm256_sub_epi16(p[3], t[2]);
+  s[4] = _mm256_sub_epi16(p[4], t[5]);
+  s[5] = _mm256_add_epi16(p[4], t[5]);
+  s[6] = _mm256_sub_epi16(p[7], t[6]);
+  s[7] = _mm256_add_epi16(p[7], t[6]);
+
+  // stage 6
+  in[1] = mult_round_shift(s[0], s[7], cospi_30_64, cospi_2_64);
+  in[9] = mult_round_shift(s[1], s[6], cospi_14_64, cospi_18_64);
+  in[5] = mult_round_shift(s[2], s[5], cospi_22_64, cospi_10_64);
+  in[13] = mult_round_shift(s[3], s[4], cospi_6_64, cospi_26_64);
+  in[3] = mult_round_shift(s[3], s[4], -cospi_26_64, cospi_6_64);
+  in[11] = mult_round_shift(s[2], s[5], -cospi_10_64, cospi_22_64);
+  in[7] = mult_round_shift(s[1], s[6], -cospi_18_64, cospi_14_64);
+  in[15] = mult_round_shift(s[0], s[7], -cospi_2_64, cospi_30_64);
+}
+
+static INLINE void fdct16(__m256i *in) {
+  fdct16_avx2(in);
+  transpose_16bit_16x16_avx2(in, in);
+}
+
+static INLINE void fadst16(__m256i *in) {
+  iadst16_avx2(in);
+  transpose_16bit_16x16_avx2(in, in);
+}
+
+static INLINE void load_buffer_16x16(const int16_t *input, int stride,
+                                     __m256i *in) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    const __m256i r = _mm256_loadu_si256((const __m256i *)(input + i * stride));
+    in[i] = _mm256_slli_epi16(r, 2);
+  }
+}
+
+// Rounds the output of the column transform as in vp9_fht16x16_c():
+// (x + 1 + (x < 0)) >> 2.
+static INLINE void right_shift_16x16(__m256i *in) {
+  const __m256i one = _mm256_set1_epi16(1);
+  int i;
+  for (i = 0; i < 16; ++i) {
+    const __m256i sign = _mm256_srai_epi16(in[i], 15);
+    in[i] = _mm256_add_epi16(in[i], one);
+    in[i] = _mm256_srai_epi16(_mm256_sub_epi16(in[i], sign), 2);
+  }
+}
+
+// Stores 16 coefficients in order, widening them for high bit depth builds.
+static INLINE void store_output_16(const __m256i in, tran_low_t *output) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  _mm256_storeu_si256((__m256i *)output,
+                      _mm256_cvtepi16_epi32(_mm256_castsi256_si128(in)));
+  _mm256_storeu_si256((__m256i *)(output + 8),
+                      _mm256_cvtepi16_epi32(_mm256_extracti128_si256(in, 1)));
+#else
+  _mm256_storeu_si256((__m256i *)output, in);
+#endif
+}
+
+static INLINE void write_buffer_16x16(tran_low_t *output, const __m256i *in) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    store_output_16(in[i], output + i * 16);
+  }
+}
+
+void vp9_fht8x8_avx2(const int16_t *input, tran_low_t *output, int stride,
+                     int tx_type) {
+  __m256i in[4];
+  int i;
+
+  if (tx_type == DCT_DCT) {
+    vpx_fdct8x8_avx2(input, output, stride);
+    return;
+  }
+
+  for (i = 0; i < 4; ++i) {
+    const __m128i r0 =
+        _mm_loadu_si128((const __m128i *)(input + 2 * i * stride));
+    const __m128i r1 =
+        _mm_loadu_si128((const __m128i *)(input + (2 * i + 1) * stride));
+    in[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+    in[i] = _mm256_slli_epi16(in[i], 2);
+  }
+
+  switch (tx_type) {
+    case ADST_DCT:
+      fadst8(in);
+      fdct8(in);
+      break;
+    case DCT_ADST:
+      fdct8(in);
+      fadst8(in);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      fadst8(in);
+      fadst8(in);
+      break;
+  }
+
+  for (i = 0; i < 4; ++i) {
+    // output /= 2, rounding toward zero.
+    const __m256i sign = _mm256_srai_epi16(in[i], 15);
+    in[i] = _mm256_srai_epi16(_mm256_sub_epi16(in[i], sign), 1);
+    store_output_16(in[i], output + i * 16);
+  }
+}
+
+void vp9_fht16x16_avx2(const int16_t *input, tran_low_t *output, int stride,
+                       int tx_type) {
+  __m256i in[16];
+
+  if (tx_type == DCT_DCT) {
+    vpx_fdct16x16_avx2(input, output, stride);
+    return;
+  }
+
+  load_buffer_16x16(input, stride, in);
+  switch (tx_type) {
+    case ADST_DCT:
+      fadst16(in);
+      right_shift_16x16(in);
+      fdct16(in);
+      break;
+    case DCT_ADST:
+      fdct16(in);
+      right_shift_16x16(in);
+      fadst16(in);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      fadst16(in);
+      right_shift_16x16(in);
+      fadst16(in);
+      break;
+  }
+  write_buffer_16x16(output, in);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The high bit depth 16x16 transform runs fdct16_avx2() and iadst16_avx2() on
+// eight 32-bit columns per register, with the products and their sums formed
+// in 64 bits as vp9_fht16x16_c() does.
+static INLINE __m256i highbd_mult_round_shift(const __m256i a, const __m256i b,
+                                              const int c0, const int c1) {
+  return highbd_mult_round_shift_avx2(a, b, _mm256_set1_epi32(c0),
+                                      _mm256_set1_epi32(c1));
+}
+
+static void highbd_fdct16_avx2(__m256i *in) {
+  __m256i i[8], s[8], p[8], t[8], u[4];
+  int k;
+
+  // stage 1
+  for (k = 0; k < 8; ++k) {
+    i[k] = _mm256_add_epi32(in[k], in[15 - k]);
+    s[7 - k] = _mm256_sub_epi32(in[k], in[15 - k]);
+  }
+  for (k = 0; k < 4; ++k) {
+    p[k] = _mm256_add_epi32(i[k], i[7 - k]);
+    p[7 - k] = _mm256_sub_epi32(i[k], i[7 - k]);
+  }
+  u[0] = _mm256_add_epi32(p[0], p[3]);
+  u[1] = _mm256_add_epi32(p[1], p[2]);
+  u[2] = _mm256_sub_epi32(p[1], p[2]);
+  u[3] = _mm256_sub_epi32(p[0], p[3]);
+  in[0] = highbd_mult_round_shift(u[0], u[1], cospi_16_64, cospi_16_64);
+  in[8] = highbd_mult_round_shift(u[0], u[1], cospi_16_64, -cospi_16_64);
+  in[4] = highbd_mult_round_shift(u[2], u[3], cospi_24_64, cospi_8_64);
+  in[12] = highbd_mult_round_shift(u[2], u[3], -cospi_8_64, cospi_24_64);
+
+  u[0] = highbd_mult_round_shift(p[5], p[6], -cospi_16_64, cospi_16_64);
+  u[1] = highbd_mult_round_shift(p[5], p[6], cospi_16_64, cospi_16_64);
+  t[0] = _mm256_add_epi32(p[4], u[0]);
+  t[1] = _mm256_sub_epi32(p[4], u[0]);
+  t[2] = _mm256_sub_epi32(p[7], u[1]);
+  t[3] = _mm256_add_epi32(p[7], u[1]);
+  in[2] = highbd_mult_round_shift(t[0], t[3], cospi_28_64, cospi_4_64);
+  in[6] = highbd_mult_round_shift(t[1], t[2], -cospi_20_64, cospi_12_64);
+  in[10] = highbd_mult_round_shift(t[1], t[2], cospi_12_64, cospi_20_64);
+  in[14] = highbd_mult_round_shift(t[0], t[3], -cospi_4_64, cospi_28_64);
+
+  // stage 2
+  t[2] = highbd_mult_round_shift(s[2], s[5], -cospi_16_64, cospi_16_64);
+  t[3] = highbd_mult_round_shift(s[3], s[4], -cospi_16_64, cospi_16_64);
+  t[4] = highbd_mult_round_shift(s[3], s[4], cospi_16_64, cospi_16_64);
+  t[5] = highbd_mult_round_shift(s[2], s[5], cospi_16_64, cospi_16_64);
+
+  // stage 3
+  p[0] = _mm256_add_epi32(s[0], t[3]);
+  p[1] = _mm256_add_epi32(s[1], t[2]);
+  p[2] = _mm256_sub_epi32(s[1], t[2]);
+  p[3] = _mm256_sub_epi32(s[0], t[3]);
+  p[4] = _mm256_sub_epi32(s[7], t[4]);
+  p[5] = _mm256_sub_epi32(s[6], t[5]);
+  p[6] = _mm256_add_epi32(s[6], t[5]);
+  p[7] = _mm256_add_epi32(s[7], t[4]);
+
+  // stage 4
+  t[1] = highbd_mult_round_shift(p[1], p[6], -cospi_8_64, cospi_24_64);
+  t[2] = highbd_mult_round_shift(p[2], p[5], cospi_24_64, cospi_8_64);
+  t[5] = highbd_mult_round_shift(p[2], p[5], cospi_8_64, -cospi_24_64);
+  t[6] = highbd_mult_round_shift(p[1], p[6], cospi_24_64, cospi_8_64);
+
+  // stage 5
+  s[0] = _mm256_add_epi32(p[0], t[1]);
+  s[1] = _mm256_sub_epi32(p[0], t[1]);
+  s[2] = _mm256_add_epi32(p[3], t[2]);
+  s[3] = _mm256_sub_epi32(p[3], t[2]);
+  s[4] = _mm256_sub_epi32(p[4], t[5]);
+  s[5] = _mm256_add_epi32(p[4], t[5]);
+  s[6] = _mm256_sub_epi32(p[7], t[6]);
+  s[7] = _mm256_add_epi32(p[7], t[6]);
+
+  // stage 6
+  in[1] = highbd_mult_round_shift(s[0], s[7], cospi_30_64, cospi_2_64);
+  in[9] = highbd_mult_round_shift(s[1], s[6], cospi_14_64, cospi_18_64);
+  in[5] = highbd_mult_round_shift(s[2], s[5], cospi_22_64, cospi_10_64);
+  in[13] = highbd_mult_round_shift(s[3], s[4], cospi_6_64, cospi_26_64);
+  in[3] = highbd_mult_round_shift(s[3], s[4], -cospi_26_64, cospi_6_64);
+  in[11] = highbd_mult_round_shift(s[2], s[5], -cospi_10_64, cospi_22_64);
+  in[7] = highbd_mult_round_shift(s[1], s[6], -cospi_18_64, cospi_14_64);
+  in[15] = highbd_mult_round_shift(s[0], s[7], -cospi_2_64, cospi_30_64);
+}
+
+// One 1-D pass of the 32-bit transform. The 16x16 block is held as
+// in[2 * i + j] = row i, columns 8 * j to 8 * j + 7. Both halves are
+// transformed as eight columns and then the block is transposed.
+static void highbd_fht16_pass(__m256i *const in /*in[32]*/, const int adst) {
+  __m256i out[32], col[16];
+  int i, j;
+
+  for (j = 0; j < 2; ++j) {
+    for (i = 0; i < 16; ++i) col[i] = in[2 * i + j];
+    if (adst) {
+      highbd_iadst16_avx2(col);
+    } else {
+      highbd_fdct16_avx2(col);
+    }
+    for (i = 0; i < 16; ++i) out[2 * i + j] = col[i];
+  }
+  transpose_32bit_16x16_avx2(out, in);
+}
+
+void vp9_highbd_fht16x16_avx2(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  const __m256i one = _mm256_set1_epi32(1);
+  __m256i in[32];
+  int i;
+
+  if (tx_type == DCT_DCT) {
+    vpx_highbd_fdct16x16_avx2(input, output, stride);
+    return;
+  }
+
+  for (i = 0; i < 16; ++i) {
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)(input + i * stride));
+    const __m128i r1 =
+        _mm_loadu_si128((const __m128i *)(input + i * stride + 8));
+    in[2 * i] = _mm256_slli_epi32(_mm256_cvtepi16_epi32(r0), 2);
+    in[2 * i + 1] = _mm256_slli_epi32(_mm256_cvtepi16_epi32(r1), 2);
+  }
+
+  highbd_fht16_pass(in, tx_type == ADST_DCT || tx_type == ADST_ADST);
+  // (x + 1 + (x < 0)) >> 2, as right_shift_16x16() does.
+  for (i = 0; i < 32; ++i) {
+    const __m256i sign = _mm256_srai_epi32(in[i], 31);
+    in[i] = _mm256_add_epi32(in[i], one);
+    in[i] = _mm256_srai_epi32(_mm256_sub_epi32(in[i], sign), 2);
+  }
+  highbd_fht16_pass(in, tx_type == DCT_ADST || tx_type == ADST_ADST);
+
+  for (i = 0; i < 32; ++i) {
+    _mm256_storeu_si256((__m256i *)(output + 8 * i), in[i]);
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -137,3 +137,131 @@ void vp9_quantize_fp_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
 
   *eob_ptr = accumulate_eob(eob);
 }
+
+// Stores |qcoeff| * dequant / 2 with the sign of the coefficient. The product
+// of the unsigned |qcoeff| and dequant takes 32 bits, held in lo and hi.
+static INLINE void store_dqcoeff_32x32(const __m256i abs_qcoeff,
+                                       const __m256i sign,
+                                       const __m256i dequant,
+                                       tran_low_t *dqcoeff_ptr) {
+  const __m256i lo = _mm256_mullo_epi16(abs_qcoeff, dequant);
+  const __m256i hi = _mm256_mulhi_epu16(abs_qcoeff, dequant);
+  // Halving the magnitude rounds towards zero, as the C division does.
+  const __m256i dq_lo =
+      _mm256_or_si256(_mm256_srli_epi16(lo, 1), _mm256_slli_epi16(hi, 15));
+#if CONFIG_VP9_HIGHBITDEPTH
+  // Widen in the same order as store_tran_low().
+  const __m256i dq_hi = _mm256_srli_epi16(hi, 1);
+  const __m256i sign_0 = _mm256_unpacklo_epi16(sign, sign);
+  const __m256i sign_1 = _mm256_unpackhi_epi16(sign, sign);
+  __m256i dq_0 = _mm256_unpacklo_epi16(dq_lo, dq_hi);
+  __m256i dq_1 = _mm256_unpackhi_epi16(dq_lo, dq_hi);
+  dq_0 = _mm256_sub_epi32(_mm256_xor_si256(dq_0, sign_0), sign_0);
+  dq_1 = _mm256_sub_epi32(_mm256_xor_si256(dq_1, sign_1), sign_1);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, dq_0);
+  _mm256_storeu_si256((__m256i *)(dqcoeff_ptr + 8), dq_1);
+#else
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr,
+                      _mm256_sub_epi16(_mm256_xor_si256(dq_lo, sign), sign));
+#endif
+}
+
+// Quantizes 16 coefficients as vp9_quantize_fp_32x32_c() does. Coefficients
+// below thr quantize to 0. The absolute values are treated as unsigned so
+// that -32768 behaves like the clamped C value.
+static INLINE void quantize_fp_32x32_16(
+    const __m256i round, const __m256i quant, const __m256i dequant,
+    const __m256i thr, const tran_low_t *coeff_ptr, const int16_t *iscan_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, __m256i *eob) {
+  const __m256i coeff = load_tran_low(coeff_ptr);
+  const __m256i abs_coeff = _mm256_abs_epi16(coeff);
+  const __m256i mask =
+      _mm256_cmpeq_epi16(_mm256_max_epu16(abs_coeff, thr), abs_coeff);
+
+  if (_mm256_movemask_epi8(mask)) {
+    const __m256i sign = _mm256_srai_epi16(coeff, 15);
+    // tmp = (min(abs_coeff + round, INT16_MAX) * quant) >> 15
+    const __m256i tmp = _mm256_min_epu16(_mm256_adds_epu16(abs_coeff, round),
+                                         _mm256_set1_epi16(INT16_MAX));
+    const __m256i lo = _mm256_mullo_epi16(tmp, quant);
+    const __m256i hi = _mm256_mulhi_epu16(tmp, quant);
+    const __m256i abs_qcoeff = _mm256_and_si256(
+        _mm256_or_si256(_mm256_slli_epi16(hi, 1), _mm256_srli_epi16(lo, 15)),
+        mask);
+    __m256i qcoeff = _mm256_sub_epi16(_mm256_xor_si256(abs_qcoeff, sign), sign);
+
+    store_tran_low(qcoeff, qcoeff_ptr);
+    store_dqcoeff_32x32(abs_qcoeff, sign, dequant, dqcoeff_ptr);
+    *eob = _mm256_max_epi16(
+        *eob, scan_eob_256((const __m256i *)iscan_ptr, &qcoeff));
+  } else {
+    store_zero_tran_low(qcoeff_ptr);
+    store_zero_tran_low(dqcoeff_ptr);
+  }
+}
+
+void vp9_quantize_fp_32x32_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                                int skip_block, const int16_t *round_ptr,
+                                const int16_t *quant_ptr,
+                                tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                                const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                                const int16_t *scan, const int16_t *iscan) {
+  __m128i eob;
+  __m256i round256, quant256, dequant256, thr256;
+  __m256i eob256 = _mm256_setzero_si256();
+
+  (void)scan;
+  (void)skip_block;
+  assert(!skip_block);
+
+  coeff_ptr += n_coeffs;
+  iscan += n_coeffs;
+  qcoeff_ptr += n_coeffs;
+  dqcoeff_ptr += n_coeffs;
+  n_coeffs = -n_coeffs;
+
+  // Setup global values
+  {
+    const __m128i round = _mm_load_si128((const __m128i *)round_ptr);
+    const __m128i quant = _mm_load_si128((const __m128i *)quant_ptr);
+    const __m128i dequant = _mm_load_si128((const __m128i *)dequant_ptr);
+    round256 = _mm256_castsi128_si256(round);
+    round256 = _mm256_permute4x64_epi64(round256, 0x54);
+
+    quant256 = _mm256_castsi128_si256(quant);
+    quant256 = _mm256_permute4x64_epi64(quant256, 0x54);
+
+    dequant256 = _mm256_castsi128_si256(dequant);
+    dequant256 = _mm256_permute4x64_epi64(dequant256, 0x54);
+  }
+
+  // ROUND_POWER_OF_TWO(round_ptr[], 1)
+  round256 = _mm256_srai_epi16(
+      _mm256_add_epi16(round256, _mm256_set1_epi16(1)), 1);
+  thr256 = _mm256_srai_epi16(dequant256, 2);
+
+  quantize_fp_32x32_16(round256, quant256, dequant256, thr256,
+                       coeff_ptr + n_coeffs, iscan + n_coeffs,
+                       qcoeff_ptr + n_coeffs, dqcoeff_ptr + n_coeffs, &eob256);
+  n_coeffs += 8 * 2;
+
+  // remove dc constants
+  dequant256 = _mm256_permute2x128_si256(dequant256, dequant256, 0x31);
+  quant256 = _mm256_permute2x128_si256(quant256, quant256, 0x31);
+  round256 = _mm256_permute2x128_si256(round256, round256, 0x31);
+  thr256 = _mm256_permute2x128_si256(thr256, thr256, 0x31);
+
+  // AC only loop
+  while (n_coeffs < 0) {
+    quantize_fp_32x32_16(round256, quant256, dequant256, thr256,
+                         coeff_ptr + n_coeffs, iscan + n_coeffs,
+                         qcoeff_ptr + n_coeffs, dqcoeff_ptr + n_coeffs,
+                         &eob256);
+    n_coeffs += 8 * 2;
+  }
+
+  eob = _mm_max_epi16(_mm256_castsi256_si128(eob256),
+                      _mm256_extracti128_si256(eob256, 1));
+
+  *eob_ptr = accumulate_eob(eob);
+}
@@ -27,6 +27,7 @@
 #include "vp9/vp9_cx_iface.h"
 #include "vp9/encoder/vp9_firstpass.h"
 #include "vp9/encoder/vp9_lookahead.h"
+#include "vp9/encoder/vp9_multi_res.h"
 #include "vp9/vp9_cx_iface.h"
 #include "vp9/vp9_iface_common.h"
 
@@ -124,6 +125,8 @@ struct vpx_codec_alg_priv {
   vpx_codec_priv_output_cx_pkt_cb_pair_t output_cx_pkt_cb;
   // BufferPool that holds all reference frames.
   BufferPool *buffer_pool;
+  // Set once the image passed to encoder_encode() is held by the lookahead.
+  int source_queued;
 };
 
 static vpx_codec_err_t update_error_state(
@@ -222,6 +225,16 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
   RANGE_CHECK(cfg, ss_number_layers, 1, VPX_SS_MAX_LAYERS);
   RANGE_CHECK(cfg, ts_number_layers, 1, VPX_TS_MAX_LAYERS);
 
+  // The encoders of a multi-resolution encode share the analysis of each
+  // frame as soon as it is coded, so they cannot look ahead.
+  if (ctx->oxcf.mr_info != NULL &&
+      (cfg->g_pass != VPX_RC_ONE_PASS || cfg->g_lag_in_frames > 0 ||
+       cfg->ss_number_layers > 1)) {
+    ERROR(
+        "Multi-resolution encoding requires one pass, no lag in frames and "
+        "a single spatial layer");
+  }
+
   {
     unsigned int level = extra_cfg->target_level;
     if (level != LEVEL_1 && level != LEVEL_1_1 && level != LEVEL_2 &&
@@ -237,6 +250,13 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
     ERROR("ss_number_layers * ts_number_layers is out of range");
   if (cfg->ts_number_layers > 1) {
     unsigned int sl, tl;
+    // Every temporal layer needs a rate, given either in
+    // layer_target_bitrate or, as for VP8, in ts_target_bitrate.
+    for (tl = 0; tl < cfg->ts_number_layers; ++tl) {
+      if (cfg->layer_target_bitrate[tl] == 0 &&
+          cfg->ts_target_bitrate[tl] == 0 && cfg->rc_target_bitrate > 0)
+        ERROR("ts_target_bitrate entries must be greater than 0");
+    }
     for (sl = 1; sl < cfg->ss_number_layers; ++sl) {
       for (tl = 1; tl < cfg->ts_number_layers; ++tl) {
         const int layer = LAYER_IDS_TO_IDX(sl, tl, cfg->ts_number_layers);
@@ -566,6 +586,9 @@ static vpx_codec_err_t set_encoder_config(
 
   oxcf->auto_key =
       cfg->kf_mode == VPX_KF_AUTO && cfg->kf_min_dist != cfg->kf_max_dist;
+  // Higher resolutions of a multi-resolution encode follow the key frames of
+  // the lowest one.
+  if (oxcf->mr_encoder_id > 0) oxcf->auto_key = 0;
 
   oxcf->key_freq = cfg->kf_max_dist;
 
@@ -1076,7 +1099,6 @@ static vpx_codec_err_t ctrl_get_level(vpx_codec_alg_priv_t *ctx, va_list args) {
 static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
                                     vpx_codec_priv_enc_mr_cfg_t *data) {
   vpx_codec_err_t res = VPX_CODEC_OK;
-  (void)data;
 
   if (ctx->priv == NULL) {
     vpx_codec_alg_priv_t *const priv = vpx_calloc(1, sizeof(*priv));
@@ -1084,7 +1106,14 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
 
     ctx->priv = (vpx_codec_priv_t *)priv;
     ctx->priv->init_flags = ctx->init_flags;
-    ctx->priv->enc.total_encoders = 1;
+    if (data != NULL) {
+      ctx->priv->enc.total_encoders = data->mr_total_resolutions;
+      priv->oxcf.mr_total_resolutions = data->mr_total_resolutions;
+      priv->oxcf.mr_encoder_id = data->mr_encoder_id;
+      priv->oxcf.mr_info = (LOWER_RES_INFO *)data->mr_low_res_mode_info;
+    } else {
+      ctx->priv->enc.total_encoders = 1;
+    }
     priv->buffer_pool = (BufferPool *)vpx_calloc(1, sizeof(BufferPool));
     if (priv->buffer_pool == NULL) return VPX_CODEC_MEM_ERROR;
 
@@ -1119,7 +1148,24 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
   return res;
 }
 
+static vpx_codec_err_t encoder_mr_alloc_mem(const vpx_codec_enc_cfg_t *cfg,
+                                           void **mem_loc) {
+  LOWER_RES_INFO *const info = vp9_mr_alloc((int)cfg->g_w, (int)cfg->g_h);
+  if (info == NULL) return VPX_CODEC_MEM_ERROR;
+  *mem_loc = info;
+  return VPX_CODEC_OK;
+}
+
+static void encoder_mr_free_mem(void *mem_loc) {
+  vp9_mr_free((LOWER_RES_INFO *)mem_loc);
+}
+
 static vpx_codec_err_t encoder_destroy(vpx_codec_alg_priv_t *ctx) {
+  // The encoder of the highest resolution owns the shared state.
+  if (ctx->cpi != NULL && ctx->oxcf.mr_total_resolutions > 1 &&
+      ctx->oxcf.mr_encoder_id == ctx->oxcf.mr_total_resolutions - 1) {
+    vp9_mr_free(ctx->oxcf.mr_info);
+  }
   free(ctx->cx_data);
   vp9_remove_compressor(ctx->cpi);
   vpx_free(ctx->buffer_pool);
@@ -1269,12 +1315,36 @@ get_first_pass_stats_pkt(FIRSTPASS_STATS *stats) {
 #endif
 
 const size_t kMinCompressedSize = 8192;
-static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
-                                      const vpx_image_t *img,
-                                      vpx_codec_pts_t pts_val,
-                                      unsigned long duration,
-                                      vpx_enc_frame_flags_t enc_flags,
-                                      unsigned long deadline) {
+// Returns 1 if 'img' meets the requirements of VP9E_SET_SOURCE_RELEASE_CB to
+// be referenced by the lookahead instead of copied.
+static int can_reference_image(const vpx_codec_alg_priv_t *ctx,
+                               const vpx_image_t *img) {
+  const int bytes_per_sample = (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  // The layout of internally allocated frames: parts of the encoder assume
+  // the source has the same stride as the reconstructed frames.
+  const int y_stride =
+      ((((img->d_w + 7) & ~7) + 2 * VP9E_SOURCE_BORDER_IN_PIXELS) + 31) & ~31;
+  // Only the luma plane of NV12 is referenced, its chroma is split on push.
+  const int num_planes = img->fmt == VPX_IMG_FMT_NV12 ? 1 : 3;
+  int plane;
+
+  // The denoisers filter the source in place.
+  if (ctx->cpi->oxcf.noise_sensitivity > 0) return 0;
+  for (plane = 0; plane < num_planes; ++plane) {
+    const int align_mask = plane > 0 ? 15 : 31;
+    const int ss_x = plane > 0 ? img->x_chroma_shift : 0;
+    if ((uintptr_t)img->planes[plane] & align_mask) return 0;
+    if (img->stride[plane] != (y_stride >> ss_x) * bytes_per_sample) return 0;
+  }
+  return 1;
+}
+
+static vpx_codec_err_t encode_image(vpx_codec_alg_priv_t *ctx,
+                                    const vpx_image_t *img,
+                                    vpx_codec_pts_t pts_val,
+                                    unsigned long duration,
+                                    vpx_enc_frame_flags_t enc_flags,
+                                    unsigned long deadline) {
   volatile vpx_codec_err_t res = VPX_CODEC_OK;
   volatile vpx_enc_frame_flags_t flags = enc_flags;
   volatile vpx_codec_pts_t pts = pts_val;
@@ -1340,6 +1410,8 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
     }
   }
 
+  if (vp9_mr_lower_res_is_key_frame(cpi)) flags |= VPX_EFLAG_FORCE_KF;
+
   if (res == VPX_CODEC_OK) {
     unsigned int lib_flags = 0;
     YV12_BUFFER_CONFIG sd;
@@ -1360,8 +1432,18 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
 
       // Store the original flags in to the frame buffer. Will extract the
       // key frame flag when we actually encode this frame.
-      if (vp9_receive_raw_frame(cpi, flags | ctx->next_frame_flags, &sd,
-                                dst_time_stamp, dst_end_time_stamp)) {
+      if (cpi->source_release_cb.release != NULL &&
+          can_reference_image(ctx, img)) {
+        if (vp9_receive_raw_frame_ref(cpi, flags | ctx->next_frame_flags, &sd,
+                                      dst_time_stamp, dst_end_time_stamp,
+                                      img->user_priv)) {
+          res = update_error_state(ctx, &cpi->common.error);
+        } else {
+          ctx->source_queued = 1;
+        }
+      } else if (vp9_receive_raw_frame(cpi, flags | ctx->next_frame_flags,
+                                       &sd, dst_time_stamp,
+                                       dst_end_time_stamp)) {
         res = update_error_state(ctx, &cpi->common.error);
       }
       ctx->next_frame_flags = 0;
@@ -1527,6 +1609,35 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
   return res;
 }
 
+static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
+                                      const vpx_image_t *img,
+                                      vpx_codec_pts_t pts_val,
+                                      unsigned long duration,
+                                      vpx_enc_frame_flags_t enc_flags,
+                                      unsigned long deadline) {
+  VP9_COMP *const cpi = ctx->cpi;
+  struct vpx_usec_timer timer;
+  vpx_codec_err_t res;
+  if (cpi != NULL && cpi->stage_timing) {
+    vp9_zero(cpi->stage_timings);
+    vpx_usec_timer_start(&timer);
+  }
+  res = encode_image(ctx, img, pts_val, duration, enc_flags, deadline);
+  if (cpi != NULL && cpi->stage_timing) {
+    vpx_usec_timer_mark(&timer);
+    cpi->stage_timings.encode_wall_time = vpx_usec_timer_elapsed(&timer);
+    cpi->stage_timings.num_worker_threads = VPXMAX(cpi->num_workers - 1, 0);
+  }
+  // Images that were copied, or not queued at all, are released right away.
+  if (img != NULL && ctx->cpi != NULL &&
+      ctx->cpi->source_release_cb.release != NULL && !ctx->source_queued) {
+    ctx->cpi->source_release_cb.release(ctx->cpi->source_release_cb.user_priv,
+                                        img->user_priv);
+  }
+  ctx->source_queued = 0;
+  return res;
+}
+
 static const vpx_codec_cx_pkt_t *encoder_get_cxdata(vpx_codec_alg_priv_t *ctx,
                                                     vpx_codec_iter_t *iter) {
   return vpx_codec_pkt_list_get(&ctx->pkt_list.head, iter);
@@ -1937,6 +2048,51 @@ static vpx_codec_err_t ctrl_set_external_rate_control(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_thread_pool(vpx_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  vpx_codec_thread_pool_t *const pool = CAST(VP9E_SET_THREAD_POOL, args);
+  VP9_COMP *const cpi = ctx->cpi;
+  // Workers are bound to their threads when they are created.
+  if (cpi->num_workers > 0) return VPX_CODEC_ERROR;
+  cpi->thread_pool = pool != NULL ? pool->pool : NULL;
+  cpi->external_thread_pool = pool != NULL;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_source_release_cb(vpx_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  vpx_source_release_cb_t *const cb = CAST(VP9E_SET_SOURCE_RELEASE_CB, args);
+  // Frames already queued were copied and are not released.
+  if (ctx->pts_offset_initialized) return VPX_CODEC_ERROR;
+  if (cb == NULL) {
+    memset(&ctx->cpi->source_release_cb, 0,
+           sizeof(ctx->cpi->source_release_cb));
+  } else {
+    ctx->cpi->source_release_cb = *cb;
+  }
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_stage_timings(vpx_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  VP9_COMP *const cpi = ctx->cpi;
+  int i;
+  cpi->stage_timing = CAST(VP9E_SET_STAGE_TIMINGS, args) != 0;
+  if (!cpi->stage_timing) {
+    for (i = 0; i < cpi->num_workers; ++i) cpi->workers[i].timed = 0;
+    vp9_zero(cpi->stage_timings);
+  }
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_get_stage_timings(vpx_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  vpx_stage_timings_t *const timings = va_arg(args, vpx_stage_timings_t *);
+  if (timings == NULL) return VPX_CODEC_INVALID_PARAM;
+  *timings = ctx->cpi->stage_timings;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { VP8_COPY_REFERENCE, ctrl_copy_reference },
 
@@ -1991,6 +2147,9 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { VP9E_SET_DISABLE_LOOPFILTER, ctrl_set_disable_loopfilter },
   { VP9E_SET_RTC_EXTERNAL_RATECTRL, ctrl_set_rtc_external_ratectrl },
   { VP9E_SET_EXTERNAL_RATE_CONTROL, ctrl_set_external_rate_control },
+  { VP9E_SET_THREAD_POOL, ctrl_set_thread_pool },
+  { VP9E_SET_SOURCE_RELEASE_CB, ctrl_set_source_release_cb },
+  { VP9E_SET_STAGE_TIMINGS, ctrl_set_stage_timings },
 
   // Getters
   { VP8E_GET_LAST_QUANTIZER, ctrl_get_quantizer },
@@ -2002,6 +2161,7 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { VP9E_GET_ACTIVEMAP, ctrl_get_active_map },
   { VP9E_GET_LEVEL, ctrl_get_level },
   { VP9E_GET_SVC_REF_FRAME_CONFIG, ctrl_get_svc_ref_frame_config },
+  { VP9E_GET_STAGE_TIMINGS, ctrl_get_stage_timings },
 
   { -1, NULL },
 };
@@ -2116,7 +2276,8 @@ CODEC_INTERFACE(vpx_codec_vp9_cx) = {
       encoder_set_config,     // vpx_codec_enc_config_set_fn_t
       NULL,                   // vpx_codec_get_global_headers_fn_t
       encoder_get_preview,    // vpx_codec_get_preview_frame_fn_t
-      NULL                    // vpx_codec_enc_mr_get_mem_loc_fn_t
+      encoder_mr_alloc_mem,   // vpx_codec_enc_mr_get_mem_loc_fn_t
+      encoder_mr_free_mem     // vpx_codec_enc_mr_free_mem_fn_t
   }
 };
 
@@ -2181,6 +2342,7 @@ VP9EncoderConfig vp9_get_encoder_config(int frame_width, int frame_height,
   vp9_extracfg extra_cfg = get_extra_cfg();
   vpx_codec_enc_cfg_t enc_cfg = get_enc_cfg(
       frame_width, frame_height, frame_rate, target_bitrate, enc_pass);
+  vp9_zero(oxcf);
   set_encoder_config(&oxcf, &enc_cfg, &extra_cfg);
 
   // These settings are made to match the settings of the vpxenc command.
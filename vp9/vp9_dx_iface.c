@@ -19,17 +19,21 @@
 #include "vpx/vpx_decoder.h"
 #include "vpx_dsp/bitreader_buffer.h"
 #include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/vpx_timer.h"
 #include "vpx_util/vpx_thread.h"
 
 #include "vp9/common/vp9_alloccommon.h"
 #include "vp9/common/vp9_frame_buffers.h"
 
 #include "vp9/decoder/vp9_decodeframe.h"
+#include "vp9/decoder/vp9_dthread.h"
 
 #include "vp9/vp9_dx_iface.h"
 #include "vp9/vp9_iface_common.h"
 
 #define VP9_CAP_POSTPROC (CONFIG_VP9_POSTPROC ? VPX_CODEC_CAP_POSTPROC : 0)
+#define VP9_CAP_FRAME_THREADING \
+  (CONFIG_MULTITHREAD ? VPX_CODEC_CAP_FRAME_THREADING : 0)
 
 static vpx_codec_err_t decoder_init(vpx_codec_ctx_t *ctx,
                                     vpx_codec_priv_enc_mr_cfg_t *data) {
@@ -57,7 +61,22 @@ static vpx_codec_err_t decoder_init(vpx_codec_ctx_t *ctx,
 }
 
 static vpx_codec_err_t decoder_destroy(vpx_codec_alg_priv_t *ctx) {
-  if (ctx->pbi != NULL) {
+  if (ctx->frame_workers != NULL) {
+    const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+    int i;
+    // Stop all the threads first, a worker may still wait on the frame
+    // decoded by another one.
+    for (i = 0; i < ctx->num_frame_workers; ++i)
+      winterface->end(&ctx->frame_workers[i]);
+    for (i = 0; i < ctx->num_frame_workers; ++i) {
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)ctx->frame_workers[i].data1;
+      if (frame_worker_data != NULL) vp9_frameworker_remove(frame_worker_data);
+      vpx_free(frame_worker_data);
+    }
+    vpx_free(ctx->frame_workers);
+    vpx_free(ctx->seg_map_copy);
+  } else if (ctx->pbi != NULL) {
     vp9_decoder_remove(ctx->pbi);
   }
 
@@ -201,13 +220,28 @@ static vpx_codec_err_t update_error_state(
   return error->error_code;
 }
 
+// In frame parallel mode every frame worker owns a decoder instance, they all
+// share the same buffer pool.
+static int get_num_decoders(const vpx_codec_alg_priv_t *ctx) {
+  return ctx->frame_parallel_decode ? ctx->num_frame_workers : 1;
+}
+
+static VP9Decoder *get_decoder(const vpx_codec_alg_priv_t *ctx, int i) {
+  if (!ctx->frame_parallel_decode) return ctx->pbi;
+  return ((FrameWorkerData *)ctx->frame_workers[i].data1)->pbi;
+}
+
 static void init_buffer_callbacks(vpx_codec_alg_priv_t *ctx) {
   VP9_COMMON *const cm = &ctx->pbi->common;
   BufferPool *const pool = cm->buffer_pool;
+  int i;
 
-  cm->new_fb_idx = INVALID_IDX;
-  cm->byte_alignment = ctx->byte_alignment;
-  cm->skip_loop_filter = ctx->skip_loop_filter;
+  for (i = 0; i < get_num_decoders(ctx); ++i) {
+    VP9_COMMON *const dec_cm = &get_decoder(ctx, i)->common;
+    dec_cm->new_fb_idx = INVALID_IDX;
+    dec_cm->byte_alignment = ctx->byte_alignment;
+    dec_cm->skip_loop_filter = ctx->skip_loop_filter;
+  }
 
   if (ctx->get_ext_fb_cb != NULL && ctx->release_ext_fb_cb != NULL) {
     pool->get_fb_cb = ctx->get_ext_fb_cb;
@@ -251,6 +285,77 @@ static void set_ppflags(const vpx_codec_alg_priv_t *ctx, vp9_ppflags_t *flags) {
       ERROR(#memb " out of range [" #lo ".." #hi "]");                   \
   } while (0)
 
+static int frame_worker_hook(void *arg1, void *arg2) {
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)arg1;
+  (void)arg2;
+
+  frame_worker_data->result = vp9_receive_compressed_tiles(
+      frame_worker_data->pbi, frame_worker_data->data_end);
+  return !frame_worker_data->result;
+}
+
+static vpx_codec_err_t init_frame_workers(vpx_codec_alg_priv_t *ctx) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  RefCntBuffer *const frame_bufs = ctx->buffer_pool->frame_bufs;
+  int i;
+
+  ctx->num_frame_workers = VPXMIN((int)ctx->cfg.threads, MAX_DECODE_THREADS);
+  ctx->next_submit_worker_id = 0;
+  ctx->last_submit_worker_id = -1;
+  ctx->next_output_worker_id = 0;
+  ctx->frames_in_flight = 0;
+  ctx->seg_map = NULL;
+  ctx->seg_map_worker_id = -1;
+
+  RANGE_CHECK(ctx, pipeline_decode, 0, 1);
+
+  // Buffers that are not being decoded are complete.
+  for (i = 0; i < FRAME_BUFFERS; ++i) {
+    vpx_atomic_init(&frame_bufs[i].row, INT_MAX);
+    vpx_atomic_init(&frame_bufs[i].parsed_row, INT_MAX);
+  }
+
+  ctx->frame_workers = (VPxWorker *)vpx_calloc(ctx->num_frame_workers,
+                                               sizeof(*ctx->frame_workers));
+  if (ctx->frame_workers == NULL) {
+    ctx->num_frame_workers = 0;
+    set_error_detail(ctx, "Failed to allocate frame workers");
+    return VPX_CODEC_MEM_ERROR;
+  }
+
+  for (i = 0; i < ctx->num_frame_workers; ++i) {
+    VPxWorker *const worker = &ctx->frame_workers[i];
+    FrameWorkerData *frame_worker_data;
+    VP9Decoder *pbi;
+
+    winterface->init(worker);
+    worker->data1 = vpx_calloc(1, sizeof(FrameWorkerData));
+    frame_worker_data = (FrameWorkerData *)worker->data1;
+    if (frame_worker_data == NULL ||
+        !vp9_frameworker_init(frame_worker_data, ctx->buffer_pool)) {
+      set_error_detail(ctx, "Failed to allocate decoder");
+      return VPX_CODEC_MEM_ERROR;
+    }
+
+    // Each frame is decoded by a single thread.
+    pbi = frame_worker_data->pbi;
+    pbi->max_threads = 1;
+    pbi->inv_tile_order = ctx->invert_tile_order;
+    pbi->frame_parallel_decode = 1;
+    pbi->pipeline_decode = ctx->pipeline_decode;
+    pbi->frame_worker_owner = worker;
+
+    worker->hook = frame_worker_hook;
+    if (!winterface->reset(worker)) {
+      set_error_detail(ctx, "Frame worker thread creation failed");
+      return VPX_CODEC_MEM_ERROR;
+    }
+  }
+
+  ctx->pbi = get_decoder(ctx, 0);
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
   ctx->last_show_frame = -1;
   ctx->need_resync = 1;
@@ -259,6 +364,21 @@ static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
   ctx->buffer_pool = (BufferPool *)vpx_calloc(1, sizeof(BufferPool));
   if (ctx->buffer_pool == NULL) return VPX_CODEC_MEM_ERROR;
 
+#if CONFIG_MULTITHREAD
+  // Post-processing is applied to the last decoded frame, it is only
+  // supported by the serial decoder.
+  ctx->frame_parallel_decode =
+      (ctx->base.init_flags & VPX_CODEC_USE_FRAME_THREADING) &&
+      !(ctx->base.init_flags & VPX_CODEC_USE_POSTPROC) && ctx->cfg.threads > 1;
+#endif
+
+  if (ctx->frame_parallel_decode) {
+    const vpx_codec_err_t res = init_frame_workers(ctx);
+    if (res != VPX_CODEC_OK) return res;
+    init_buffer_callbacks(ctx);
+    return VPX_CODEC_OK;
+  }
+
   ctx->pbi = vp9_decoder_create(ctx->buffer_pool);
   if (ctx->pbi == NULL) {
     set_error_detail(ctx, "Failed to allocate decoder");
@@ -271,7 +391,10 @@ static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
   ctx->pbi->row_mt = ctx->row_mt;
 
   RANGE_CHECK(ctx, lpf_opt, 0, 1);
-  ctx->pbi->lpf_mt_opt = ctx->lpf_opt;
+  // The loop filter optimization has the tile workers wait on each other,
+  // which may deadlock when they are queued on a pool with fewer threads.
+  ctx->pbi->lpf_mt_opt = ctx->thread_pool != NULL ? 0 : ctx->lpf_opt;
+  ctx->pbi->thread_pool = ctx->thread_pool;
 
   // If postprocessing was enabled by the application and a
   // configuration has not been provided, default it.
@@ -291,6 +414,336 @@ static INLINE void check_resync(vpx_codec_alg_priv_t *const ctx,
     ctx->need_resync = 0;
 }
 
+static void release_output_frames(vpx_codec_alg_priv_t *ctx) {
+  BufferPool *const pool = ctx->buffer_pool;
+  int i;
+
+  for (i = 0; i < ctx->num_output_frames; ++i)
+    decrease_ref_count(ctx->output_fb_idx[i], pool->frame_bufs, pool);
+  ctx->num_output_frames = 0;
+}
+
+static void release_cache_frames(vpx_codec_alg_priv_t *ctx) {
+  BufferPool *const pool = ctx->buffer_pool;
+
+  while (ctx->num_cache_frames > 0) {
+    decrease_ref_count(ctx->frame_cache[ctx->frame_cache_read].fb_idx,
+                       pool->frame_bufs, pool);
+    ctx->frame_cache_read = (ctx->frame_cache_read + 1) % FRAME_CACHE_SIZE;
+    --ctx->num_cache_frames;
+  }
+}
+
+static void cache_decoded_frame(vpx_codec_alg_priv_t *ctx, int fb_idx,
+                                void *user_priv) {
+  RefCntBuffer *const frame_bufs = ctx->buffer_pool->frame_bufs;
+  cache_frame *frame;
+
+  // The application is not reading the frames, drop the oldest one.
+  if (ctx->num_cache_frames == FRAME_CACHE_SIZE) {
+    decrease_ref_count(ctx->frame_cache[ctx->frame_cache_read].fb_idx,
+                       frame_bufs, ctx->buffer_pool);
+    ctx->frame_cache_read = (ctx->frame_cache_read + 1) % FRAME_CACHE_SIZE;
+    --ctx->num_cache_frames;
+  }
+
+  frame = &ctx->frame_cache[(ctx->frame_cache_read + ctx->num_cache_frames) %
+                            FRAME_CACHE_SIZE];
+  ++ctx->num_cache_frames;
+  ++frame_bufs[fb_idx].ref_count;
+  frame->fb_idx = fb_idx;
+  yuvconfig2image(&frame->img, &frame_bufs[fb_idx].buf, user_priv);
+  frame->img.fb_priv = frame_bufs[fb_idx].raw_frame_buffer.priv;
+}
+
+// Finishes the oldest frame in flight: updates the reference buffers and
+// queues the frame for output. Frames following a frame that failed to decode
+// are dropped.
+// Moves the stage times of a decoder to the timings of the decode call.
+static void add_stage_times(vpx_codec_alg_priv_t *ctx, VP9Decoder *pbi) {
+  int i;
+  for (i = 0; i < VP9D_STAGE_COUNT; ++i) {
+    ctx->stage_timings.stage_time[i] += pbi->stage_time[i];
+  }
+  vp9_zero(pbi->stage_time);
+}
+
+// Moves the CPU time of worker thread 'i' to the timings of the decode call.
+// The worker must not be running.
+static void add_worker_time(vpx_codec_alg_priv_t *ctx, int i,
+                            VPxWorker *worker) {
+  if (i < VP9D_MAX_TIMED_WORKERS) {
+    ctx->stage_timings.worker_busy_time[i] += worker->cpu_time;
+  }
+  worker->cpu_time = 0;
+}
+
+static vpx_codec_err_t retire_frame(vpx_codec_alg_priv_t *ctx, int output) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  VPxWorker *const worker = &ctx->frame_workers[ctx->next_output_worker_id];
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+  VP9Decoder *const pbi = frame_worker_data->pbi;
+  VP9_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+  RefCntBuffer *const frame_bufs = pool->frame_bufs;
+  vpx_codec_err_t res = VPX_CODEC_OK;
+
+  assert(ctx->frames_in_flight > 0);
+  if (frame_worker_data->launched) {
+    winterface->sync(worker);
+    frame_worker_data->launched = 0;
+  }
+  ctx->next_output_worker_id =
+      (ctx->next_output_worker_id + 1) % ctx->num_frame_workers;
+  --ctx->frames_in_flight;
+
+  vp9_finish_compressed_data(pbi);
+  decrease_ref_count(frame_worker_data->prev_fb_idx, frame_bufs, pool);
+  frame_worker_data->prev_fb_idx = INVALID_IDX;
+  ctx->pbi = pbi;
+
+  if (pbi->stage_timing) {
+    add_stage_times(ctx, pbi);
+    add_worker_time(ctx, (int)(worker - ctx->frame_workers), worker);
+  }
+
+  if (output) {
+    if (frame_worker_data->result != 0) {
+      res = update_error_state(ctx, &cm->error);
+      ctx->need_resync = 1;
+      while (ctx->frames_in_flight > 0) retire_frame(ctx, 0);
+      get_decoder(ctx, ctx->last_submit_worker_id)->need_resync = 1;
+    } else {
+      check_resync(ctx, pbi);
+      if (cm->show_frame && !ctx->need_resync)
+        cache_decoded_frame(ctx, cm->new_fb_idx,
+                            frame_worker_data->user_priv);
+    }
+  }
+
+  // Release the frame if nothing references it.
+  if (frame_bufs[cm->new_fb_idx].ref_count == 0 &&
+      !frame_bufs[cm->new_fb_idx].released) {
+    pool->release_fb_cb(pool->cb_priv,
+                        &frame_bufs[cm->new_fb_idx].raw_frame_buffer);
+    frame_bufs[cm->new_fb_idx].released = 1;
+  }
+
+  return res;
+}
+
+static vpx_codec_err_t drain_frames(vpx_codec_alg_priv_t *ctx) {
+  vpx_codec_err_t res = VPX_CODEC_OK;
+
+  while (ctx->frames_in_flight > 0) {
+    const vpx_codec_err_t err = retire_frame(ctx, 1);
+    if (res == VPX_CODEC_OK) res = err;
+  }
+  return res;
+}
+
+static int has_free_fb(const BufferPool *pool) {
+  int i;
+  for (i = 0; i < FRAME_BUFFERS; ++i)
+    if (pool->frame_bufs[i].ref_count == 0) return 1;
+  return 0;
+}
+
+// Keeps a copy of the segmentation map decoded by the worker about to be
+// reused.
+static void save_seg_map(vpx_codec_alg_priv_t *ctx, const VP9_COMMON *cm) {
+  const int size = cm->mi_rows * cm->mi_cols;
+
+  if (ctx->seg_map_copy_size < size) {
+    vpx_free(ctx->seg_map_copy);
+    ctx->seg_map_copy = (uint8_t *)vpx_malloc(size);
+    ctx->seg_map_copy_size = ctx->seg_map_copy != NULL ? size : 0;
+  }
+  if (ctx->seg_map_copy != NULL) {
+    memcpy(ctx->seg_map_copy, ctx->seg_map, size);
+    ctx->seg_map = ctx->seg_map_copy;
+  } else {
+    ctx->seg_map = NULL;
+  }
+  ctx->seg_map_worker_id = -1;
+}
+
+// Waits until the frame held by 'worker_id' is parsed and its frame contexts
+// are adapted. The pipelined decoder signals it before reconstructing the
+// frame.
+static void wait_for_parse(vpx_codec_alg_priv_t *ctx, int worker_id) {
+  // The wait is counted for the frame being submitted.
+  VP9Decoder *const pbi = get_decoder(ctx, ctx->next_submit_worker_id);
+  if (ctx->pipeline_decode) {
+    vp9_frameworker_wait_parsed(get_decoder(ctx, worker_id)->cur_buf, INT_MAX,
+                                vp9_dec_wait_time(pbi));
+  } else {
+    struct vpx_usec_timer timer;
+    if (pbi->stage_timing) vpx_usec_timer_start(&timer);
+    vpx_get_worker_interface()->sync(&ctx->frame_workers[worker_id]);
+    if (pbi->stage_timing) {
+      vpx_usec_timer_mark(&timer);
+      pbi->stage_time[VP9D_STAGE_FRAME_WAIT] += vpx_usec_timer_elapsed(&timer);
+    }
+  }
+}
+
+// The segmentation map is the only state a frame reads from the previous
+// frames after its headers are parsed, besides the reference buffers. Set up
+// the map predicted by the frame parsed by 'worker_id'.
+static void setup_seg_map(vpx_codec_alg_priv_t *ctx, int worker_id) {
+  VP9_COMMON *const cm = &get_decoder(ctx, worker_id)->common;
+  const int reset = frame_is_intra_only(cm) || cm->error_resilient_mode ||
+                    cm->width != cm->last_width ||
+                    cm->height != cm->last_height;
+
+  if (cm->seg.enabled && (!cm->seg.update_map || cm->seg.temporal_update)) {
+    const int size = cm->mi_rows * cm->mi_cols;
+    if (reset || ctx->seg_map == NULL) {
+      memset(cm->last_frame_seg_map, 0, size);
+    } else {
+      if (ctx->seg_map_worker_id >= 0)
+        wait_for_parse(ctx, ctx->seg_map_worker_id);
+      memcpy(cm->last_frame_seg_map, ctx->seg_map, size);
+    }
+  }
+
+  if (cm->seg.enabled) {
+    ctx->seg_map = cm->current_frame_seg_map;
+    ctx->seg_map_worker_id = worker_id;
+  } else if (reset) {
+    ctx->seg_map = NULL;
+    ctx->seg_map_worker_id = -1;
+  }
+}
+
+// Parses the headers of a frame and hands its tile data to a frame worker.
+// The frame is output once all the previous frames are finished.
+static vpx_codec_err_t submit_frame(vpx_codec_alg_priv_t *ctx,
+                                    const uint8_t **data, unsigned int data_sz,
+                                    void *user_priv) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  const int worker_id = ctx->next_submit_worker_id;
+  VPxWorker *const worker = &ctx->frame_workers[worker_id];
+  FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+  VP9Decoder *const pbi = frame_worker_data->pbi;
+  VP9_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+  RefCntBuffer *const frame_bufs = pool->frame_bufs;
+  const uint8_t *source;
+  vpx_codec_err_t res = VPX_CODEC_OK;
+
+  // Wait for the worker to finish its previous frame.
+  if (ctx->frames_in_flight == ctx->num_frame_workers)
+    res = retire_frame(ctx, 1);
+
+  pbi->stage_timing = ctx->stage_timing;
+  worker->timed = ctx->stage_timing;
+
+  if (ctx->seg_map_worker_id == worker_id) save_seg_map(ctx, cm);
+
+  if (ctx->last_submit_worker_id >= 0) {
+    VPxWorker *const src_worker =
+        &ctx->frame_workers[ctx->last_submit_worker_id];
+    FrameWorkerData *const src_data = (FrameWorkerData *)src_worker->data1;
+    const VP9_COMMON *const src_cm = &src_data->pbi->common;
+
+    // With backward adaptation the frame contexts are only known once the
+    // previous frame is decoded.
+    if (src_data->launched && src_cm->refresh_frame_context &&
+        !src_cm->frame_parallel_decoding_mode)
+      wait_for_parse(ctx, ctx->last_submit_worker_id);
+
+    // A key frame resynchronizing the decoder releases all the buffers.
+    if (src_data->pbi->need_resync) {
+      const vpx_codec_err_t err = drain_frames(ctx);
+      if (res == VPX_CODEC_OK) res = err;
+      release_cache_frames(ctx);
+    }
+
+    vp9_frameworker_copy_context(worker, src_worker);
+  }
+
+  // Keep the motion vectors of the previous frame until this one is decoded.
+  if (cm->prev_frame != NULL) {
+    frame_worker_data->prev_fb_idx = (int)(cm->prev_frame - frame_bufs);
+    ++cm->prev_frame->ref_count;
+  }
+
+  while (!has_free_fb(pool) && ctx->frames_in_flight > 0) {
+    const vpx_codec_err_t err = retire_frame(ctx, 1);
+    if (res == VPX_CODEC_OK) res = err;
+  }
+
+  // The application is not reading the decoded frames fast enough, drop the
+  // oldest ones rather than failing to decode.
+  while (!has_free_fb(pool) && ctx->num_cache_frames > 0) {
+    decrease_ref_count(ctx->frame_cache[ctx->frame_cache_read].fb_idx,
+                       frame_bufs, pool);
+    ctx->frame_cache_read = (ctx->frame_cache_read + 1) % FRAME_CACHE_SIZE;
+    --ctx->num_cache_frames;
+  }
+
+  // The application may reuse its buffer once the decode call returns.
+  if (frame_worker_data->scratch_buffer_size < data_sz) {
+    vpx_free(frame_worker_data->scratch_buffer);
+    frame_worker_data->scratch_buffer = (uint8_t *)vpx_malloc(data_sz);
+    if (frame_worker_data->scratch_buffer == NULL) {
+      frame_worker_data->scratch_buffer_size = 0;
+      decrease_ref_count(frame_worker_data->prev_fb_idx, frame_bufs, pool);
+      frame_worker_data->prev_fb_idx = INVALID_IDX;
+      set_error_detail(ctx, "Failed to allocate frame data");
+      return VPX_CODEC_MEM_ERROR;
+    }
+    frame_worker_data->scratch_buffer_size = data_sz;
+  }
+  if (ctx->decrypt_cb) {
+    ctx->decrypt_cb(ctx->decrypt_state, *data,
+                    frame_worker_data->scratch_buffer, (int)data_sz);
+  } else {
+    memcpy(frame_worker_data->scratch_buffer, *data, data_sz);
+  }
+  pbi->decrypt_cb = NULL;
+  pbi->decrypt_state = NULL;
+  frame_worker_data->data = frame_worker_data->scratch_buffer;
+  frame_worker_data->data_end = frame_worker_data->data + data_sz;
+  frame_worker_data->user_priv = user_priv;
+  frame_worker_data->result = 0;
+
+  source = frame_worker_data->data;
+  if (vp9_receive_compressed_header(pbi, data_sz, &source)) {
+    drain_frames(ctx);
+    decrease_ref_count(frame_worker_data->prev_fb_idx, frame_bufs, pool);
+    frame_worker_data->prev_fb_idx = INVALID_IDX;
+    pbi->cur_buf->buf.corrupted = 1;
+    pbi->need_resync = 1;
+    ctx->need_resync = 1;
+    if (ctx->last_submit_worker_id >= 0)
+      get_decoder(ctx, ctx->last_submit_worker_id)->need_resync = 1;
+    return update_error_state(ctx, &cm->error);
+  }
+
+  if (pbi->tile_data == NULL || !cm->use_prev_frame_mvs) {
+    decrease_ref_count(frame_worker_data->prev_fb_idx, frame_bufs, pool);
+    frame_worker_data->prev_fb_idx = INVALID_IDX;
+  }
+
+  if (pbi->tile_data != NULL) {
+    setup_seg_map(ctx, worker_id);
+    frame_worker_data->launched = 1;
+    winterface->launch(worker);
+  }
+
+  ctx->last_submit_worker_id = worker_id;
+  ctx->next_submit_worker_id = (worker_id + 1) % ctx->num_frame_workers;
+  ++ctx->frames_in_flight;
+
+  // The frame size is only known once the tile data is decoded, the whole
+  // buffer is used by the frame.
+  *data += data_sz;
+  return res;
+}
+
 static vpx_codec_err_t decode_one(vpx_codec_alg_priv_t *ctx,
                                   const uint8_t **data, unsigned int data_sz,
                                   void *user_priv, int64_t deadline) {
@@ -309,6 +762,9 @@ static vpx_codec_err_t decode_one(vpx_codec_alg_priv_t *ctx,
     if (!ctx->si.is_kf && !is_intra_only) return VPX_CODEC_ERROR;
   }
 
+  if (ctx->frame_parallel_decode)
+    return submit_frame(ctx, data, data_sz, user_priv);
+
   ctx->user_priv = user_priv;
 
   // Set these even if already initialized.  The caller may have changed the
@@ -328,9 +784,9 @@ static vpx_codec_err_t decode_one(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
-static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
-                                      const uint8_t *data, unsigned int data_sz,
-                                      void *user_priv, long deadline) {
+static vpx_codec_err_t decode_data(vpx_codec_alg_priv_t *ctx,
+                                   const uint8_t *data, unsigned int data_sz,
+                                   void *user_priv, long deadline) {
   const uint8_t *data_start = data;
   const uint8_t *const data_end = data + data_sz;
   vpx_codec_err_t res;
@@ -339,6 +795,10 @@ static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
 
   if (data == NULL && data_sz == 0) {
     ctx->flushed = 1;
+    if (ctx->frame_parallel_decode) {
+      release_output_frames(ctx);
+      return drain_frames(ctx);
+    }
     return VPX_CODEC_OK;
   }
 
@@ -350,6 +810,11 @@ static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
     const vpx_codec_err_t res = init_decoder(ctx);
     if (res != VPX_CODEC_OK) return res;
   }
+  if (!ctx->frame_parallel_decode) ctx->pbi->stage_timing = ctx->stage_timing;
+
+  // Frames returned by the previous call are no longer used by the
+  // application.
+  if (ctx->frame_parallel_decode) release_output_frames(ctx);
 
   res = vp9_parse_superframe_index(data, data_sz, frame_sizes, &frame_count,
                                    ctx->decrypt_cb, ctx->decrypt_state);
@@ -396,6 +861,54 @@ static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
   return res;
 }
 
+// Moves the CPU time of the tile and loop filter worker threads of the serial
+// decoder to the timings of the decode call. Returns the number of threads.
+static int add_worker_times(vpx_codec_alg_priv_t *ctx) {
+  VP9Decoder *const pbi = ctx->pbi;
+  int num_threads = 0;
+  int i;
+  // The last tile worker runs on the calling thread.
+  for (i = 0; i < pbi->num_tile_workers - 1; ++i) {
+    add_worker_time(ctx, num_threads++, &pbi->tile_workers[i]);
+  }
+  if (pbi->max_threads > 1 && pbi->lf_worker.data1 != NULL) {
+    add_worker_time(ctx, num_threads++, &pbi->lf_worker);
+  }
+  return num_threads;
+}
+
+static vpx_codec_err_t decoder_decode(vpx_codec_alg_priv_t *ctx,
+                                      const uint8_t *data, unsigned int data_sz,
+                                      void *user_priv, long deadline) {
+  struct vpx_usec_timer timer;
+  const int timed = ctx->stage_timing;
+  vpx_codec_err_t res;
+  int i;
+
+  if (timed) {
+    vp9_zero(ctx->stage_timings);
+    vpx_usec_timer_start(&timer);
+  }
+  res = decode_data(ctx, data, data_sz, user_priv, deadline);
+  if (timed && ctx->pbi != NULL) {
+    vpx_dec_stage_timings_t *const timings = &ctx->stage_timings;
+    vpx_usec_timer_mark(&timer);
+    timings->decode_wall_time = vpx_usec_timer_elapsed(&timer);
+    if (ctx->frame_parallel_decode) {
+      timings->num_worker_threads = ctx->num_frame_workers;
+    } else {
+      add_stage_times(ctx, ctx->pbi);
+      timings->num_worker_threads = add_worker_times(ctx);
+    }
+    for (i = 0; i < VPXMIN(timings->num_worker_threads, VP9D_MAX_TIMED_WORKERS);
+         ++i) {
+      timings->worker_idle_time[i] = VPXMAX(
+          timings->decode_wall_time - timings->worker_busy_time[i], 0);
+    }
+  }
+  return res;
+}
+
 static vpx_image_t *decoder_get_frame(vpx_codec_alg_priv_t *ctx,
                                       vpx_codec_iter_t *iter) {
   vpx_image_t *img = NULL;
@@ -404,6 +917,19 @@ static vpx_image_t *decoder_get_frame(vpx_codec_alg_priv_t *ctx,
   // always return only 1 frame per decode call.
   (void)iter;
 
+  // The frame parallel decoder may output several frames after a decode
+  // call, they are returned in order until the cache is empty.
+  if (ctx->frame_parallel_decode) {
+    cache_frame *frame;
+    if (ctx->num_cache_frames == 0) return NULL;
+    frame = &ctx->frame_cache[ctx->frame_cache_read];
+    ctx->frame_cache_read = (ctx->frame_cache_read + 1) % FRAME_CACHE_SIZE;
+    --ctx->num_cache_frames;
+    ctx->output_fb_idx[ctx->num_output_frames++] = frame->fb_idx;
+    ctx->last_show_frame = frame->fb_idx;
+    return &frame->img;
+  }
+
   if (ctx->pbi != NULL) {
     YV12_BUFFER_CONFIG sd;
     vp9_ppflags_t flags = { 0, 0, 0 };
@@ -446,6 +972,7 @@ static vpx_codec_err_t ctrl_set_reference(vpx_codec_alg_priv_t *ctx,
   if (data) {
     vpx_ref_frame_t *const frame = (vpx_ref_frame_t *)data;
     YV12_BUFFER_CONFIG sd;
+    if (ctx->frame_parallel_decode) drain_frames(ctx);
     image2yuvconfig(&frame->img, &sd);
     return vp9_set_reference_dec(
         &ctx->pbi->common, ref_frame_to_vp9_reframe(frame->frame_type), &sd);
@@ -461,6 +988,7 @@ static vpx_codec_err_t ctrl_copy_reference(vpx_codec_alg_priv_t *ctx,
   if (data) {
     vpx_ref_frame_t *frame = (vpx_ref_frame_t *)data;
     YV12_BUFFER_CONFIG sd;
+    if (ctx->frame_parallel_decode) drain_frames(ctx);
     image2yuvconfig(&frame->img, &sd);
     return vp9_copy_reference_dec(ctx->pbi, (VP9_REFFRAME)frame->frame_type,
                                   &sd);
@@ -475,8 +1003,11 @@ static vpx_codec_err_t ctrl_get_reference(vpx_codec_alg_priv_t *ctx,
 
   if (data) {
     if (ctx->pbi) {
-      const int fb_idx = ctx->pbi->common.cur_show_frame_fb_idx;
-      YV12_BUFFER_CONFIG *fb = get_buf_frame(&ctx->pbi->common, fb_idx);
+      int fb_idx;
+      YV12_BUFFER_CONFIG *fb;
+      if (ctx->frame_parallel_decode) drain_frames(ctx);
+      fb_idx = ctx->pbi->common.cur_show_frame_fb_idx;
+      fb = get_buf_frame(&ctx->pbi->common, fb_idx);
       if (fb == NULL) return VPX_CODEC_ERROR;
       yuvconfig2image(&data->img, fb, NULL);
       return VPX_CODEC_OK;
@@ -538,6 +1069,14 @@ static vpx_codec_err_t ctrl_get_frame_corrupted(vpx_codec_alg_priv_t *ctx,
   if (corrupted) {
     if (ctx->pbi != NULL) {
       RefCntBuffer *const frame_bufs = ctx->pbi->common.buffer_pool->frame_bufs;
+      // Frames are output with a delay in frame parallel mode, there may be
+      // none yet.
+      if (ctx->frame_parallel_decode) {
+        *corrupted = ctx->last_show_frame >= 0
+                         ? frame_bufs[ctx->last_show_frame].buf.corrupted
+                         : 0;
+        return VPX_CODEC_OK;
+      }
       if (ctx->pbi->common.frame_to_show == NULL) return VPX_CODEC_ERROR;
       if (ctx->last_show_frame >= 0)
         *corrupted = frame_bufs[ctx->last_show_frame].buf.corrupted;
@@ -632,7 +1171,10 @@ static vpx_codec_err_t ctrl_set_byte_alignment(vpx_codec_alg_priv_t *ctx,
 
   ctx->byte_alignment = byte_alignment;
   if (ctx->pbi != NULL) {
-    ctx->pbi->common.byte_alignment = byte_alignment;
+    int i;
+    if (ctx->frame_parallel_decode) drain_frames(ctx);
+    for (i = 0; i < get_num_decoders(ctx); ++i)
+      get_decoder(ctx, i)->common.byte_alignment = byte_alignment;
   }
   return VPX_CODEC_OK;
 }
@@ -642,7 +1184,10 @@ static vpx_codec_err_t ctrl_set_skip_loop_filter(vpx_codec_alg_priv_t *ctx,
   ctx->skip_loop_filter = va_arg(args, int);
 
   if (ctx->pbi != NULL) {
-    ctx->pbi->common.skip_loop_filter = ctx->skip_loop_filter;
+    int i;
+    if (ctx->frame_parallel_decode) drain_frames(ctx);
+    for (i = 0; i < get_num_decoders(ctx); ++i)
+      get_decoder(ctx, i)->common.skip_loop_filter = ctx->skip_loop_filter;
   }
 
   return VPX_CODEC_OK;
@@ -672,6 +1217,45 @@ static vpx_codec_err_t ctrl_enable_lpf_opt(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_pipeline_decode(vpx_codec_alg_priv_t *ctx,
+                                                va_list args) {
+  // The decoder threads are created on the first frame.
+  if (ctx->pbi != NULL || ctx->frame_workers != NULL) return VPX_CODEC_ERROR;
+  ctx->pipeline_decode = va_arg(args, int);
+
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_thread_pool(vpx_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  vpx_codec_thread_pool_t *const pool = va_arg(args, vpx_codec_thread_pool_t *);
+
+  // The pool is handed to the decoder when it is created on the first frame.
+  if (ctx->pbi != NULL || ctx->frame_workers != NULL) return VPX_CODEC_ERROR;
+  ctx->thread_pool = pool != NULL ? pool->pool : NULL;
+
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_stage_timings(vpx_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  // The decoders and their workers pick the setting up on the next frame.
+  ctx->stage_timing = va_arg(args, unsigned int) != 0;
+  vp9_zero(ctx->stage_timings);
+
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_get_stage_timings(vpx_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  vpx_dec_stage_timings_t *const timings =
+      va_arg(args, vpx_dec_stage_timings_t *);
+  if (timings == NULL) return VPX_CODEC_INVALID_PARAM;
+  *timings = ctx->stage_timings;
+
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VP8_COPY_REFERENCE, ctrl_copy_reference },
 
@@ -685,6 +1269,9 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VP9_DECODE_SVC_SPATIAL_LAYER, ctrl_set_spatial_layer_svc },
   { VP9D_SET_ROW_MT, ctrl_set_row_mt },
   { VP9D_SET_LOOP_FILTER_OPT, ctrl_enable_lpf_opt },
+  { VP9D_SET_THREAD_POOL, ctrl_set_thread_pool },
+  { VP9D_SET_PIPELINE_DECODE, ctrl_set_pipeline_decode },
+  { VP9D_SET_STAGE_TIMINGS, ctrl_set_stage_timings },
 
   // Getters
   { VPXD_GET_LAST_QUANTIZER, ctrl_get_quantizer },
@@ -694,6 +1281,7 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VP9D_GET_DISPLAY_SIZE, ctrl_get_render_size },
   { VP9D_GET_BIT_DEPTH, ctrl_get_bit_depth },
   { VP9D_GET_FRAME_SIZE, ctrl_get_frame_size },
+  { VP9D_GET_STAGE_TIMINGS, ctrl_get_stage_timings },
 
   { -1, NULL },
 };
@@ -707,7 +1295,7 @@ CODEC_INTERFACE(vpx_codec_vp9_dx) = {
 #if CONFIG_VP9_HIGHBITDEPTH
   VPX_CODEC_CAP_HIGHBITDEPTH |
 #endif
-      VPX_CODEC_CAP_DECODER | VP9_CAP_POSTPROC |
+      VPX_CODEC_CAP_DECODER | VP9_CAP_POSTPROC | VP9_CAP_FRAME_THREADING |
       VPX_CODEC_CAP_EXTERNAL_FRAME_BUFFER,  // vpx_codec_caps_t
   decoder_init,                             // vpx_codec_init_fn_t
   decoder_destroy,                          // vpx_codec_destroy_fn_t
@@ -729,6 +1317,7 @@ CODEC_INTERFACE(vpx_codec_vp9_dx) = {
       NULL,  // vpx_codec_enc_config_set_fn_t
       NULL,  // vpx_codec_get_global_headers_fn_t
       NULL,  // vpx_codec_get_preview_frame_fn_t
-      NULL   // vpx_codec_enc_mr_get_mem_loc_fn_t
+      NULL,  // vpx_codec_enc_mr_get_mem_loc_fn_t
+      NULL   // vpx_codec_enc_mr_free_mem_fn_t
   }
 };
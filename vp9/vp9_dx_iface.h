@@ -15,6 +15,15 @@
 
 typedef vpx_codec_stream_info_t vp9_stream_info_t;
 
+#define FRAME_CACHE_SIZE FRAME_BUFFERS
+
+// Frame decoded by the frame parallel decoder that has not been returned by
+// vpx_codec_get_frame() yet. The frame buffer is referenced until then.
+typedef struct cache_frame {
+  int fb_idx;
+  vpx_image_t img;
+} cache_frame;
+
 struct vpx_codec_alg_priv {
   vpx_codec_priv_t base;
   vpx_codec_dec_cfg_t cfg;
@@ -47,6 +56,41 @@ struct vpx_codec_alg_priv {
   int svc_spatial_layer;
   int row_mt;
   int lpf_opt;
+  VPxThreadPool *thread_pool;  // Application owned, see VP9D_SET_THREAD_POOL.
+
+  // Frame parallel decode: each frame worker decodes one frame while the
+  // headers of the following frames are parsed on the calling thread.
+  int frame_parallel_decode;
+  int pipeline_decode;  // See VP9D_SET_PIPELINE_DECODE.
+  VPxWorker *frame_workers;
+  int num_frame_workers;
+  int next_submit_worker_id;  // Worker receiving the next frame.
+  int last_submit_worker_id;  // Worker holding the last frame in decode order.
+  int next_output_worker_id;  // Worker holding the oldest frame in flight.
+  int frames_in_flight;
+
+  // Decoded frames waiting to be output, in display order.
+  cache_frame frame_cache[FRAME_CACHE_SIZE];
+  int frame_cache_read;
+  int num_cache_frames;
+
+  // Frames output since the last decode call. Their buffers are released on
+  // the next call to decoder_decode().
+  int output_fb_idx[FRAME_CACHE_SIZE];
+  int num_output_frames;
+
+  // Segmentation map predicted by the next frame. It is written by the frame
+  // worker 'seg_map_worker_id' or, when that is -1, is final. NULL means all
+  // segment ids are 0.
+  const uint8_t *seg_map;
+  int seg_map_worker_id;
+  uint8_t *seg_map_copy;
+  int seg_map_copy_size;
+
+  // See VP9D_SET_STAGE_TIMINGS. The timings of the frames finished during
+  // the last decode call.
+  int stage_timing;
+  vpx_dec_stage_timings_t stage_timings;
 };
 
 #endif  // VPX_VP9_VP9_DX_IFACE_H_
@@ -267,6 +267,7 @@ typedef vpx_image_t *(*vpx_codec_get_preview_frame_fn_t)(
 
 typedef vpx_codec_err_t (*vpx_codec_enc_mr_get_mem_loc_fn_t)(
     const vpx_codec_enc_cfg_t *cfg, void **mem_loc);
+typedef void (*vpx_codec_enc_mr_free_mem_fn_t)(void *mem_loc);
 
 /*!\brief usage configuration mapping
  *
@@ -317,6 +318,8 @@ struct vpx_codec_iface {
         get_preview; /**< \copydoc ::vpx_codec_get_preview_frame_fn_t */
     vpx_codec_enc_mr_get_mem_loc_fn_t
         mr_get_mem_loc; /**< \copydoc ::vpx_codec_enc_mr_get_mem_loc_fn_t */
+    vpx_codec_enc_mr_free_mem_fn_t
+        mr_free_mem; /**< \copydoc ::vpx_codec_enc_mr_free_mem_fn_t */
   } enc;
 };
 
@@ -353,6 +356,20 @@ struct vpx_codec_priv {
   } enc;
 };
 
+/*
+ * Application owned thread pool, see vpx_codec_thread_pool_create()
+ */
+struct vpx_codec_thread_pool {
+  struct VPxThreadPool *pool;
+};
+
+/*
+ * Application owned memory pool, see vpx_codec_mem_pool_create()
+ */
+struct vpx_codec_mem_pool {
+  struct VpxMemPool *pool;
+};
+
 /*
  * Multi-resolution encoding internal configuration
  */
@@ -16,6 +16,9 @@
 #include <stdlib.h>
 #include "vpx/vpx_integer.h"
 #include "vpx/internal/vpx_codec_internal.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_mem/vpx_mem_pool.h"
+#include "vpx_util/vpx_thread_pool.h"
 #include "vpx_version.h"
 
 #define SAVE_STATUS(ctx, var) (ctx ? (ctx->err = var) : var)
@@ -85,6 +88,95 @@ vpx_codec_caps_t vpx_codec_get_caps(vpx_codec_iface_t *iface) {
   return (iface) ? iface->caps : 0;
 }
 
+vpx_codec_thread_pool_t *vpx_codec_thread_pool_create(int num_threads) {
+  vpx_codec_thread_pool_t *pool;
+
+  if (num_threads <= 0) return NULL;
+  pool = (vpx_codec_thread_pool_t *)vpx_calloc(1, sizeof(*pool));
+  if (!pool) return NULL;
+  pool->pool = vpx_thread_pool_create(num_threads);
+  if (!pool->pool) {
+    vpx_free(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+void vpx_codec_thread_pool_destroy(vpx_codec_thread_pool_t *pool) {
+  if (pool) {
+    vpx_thread_pool_destroy(pool->pool);
+    vpx_free(pool);
+  }
+}
+
+vpx_codec_err_t vpx_codec_set_mem_allocator(
+    const vpx_codec_mem_allocator_t *allocator) {
+  vpx_mem_allocator mem_allocator;
+
+  if (!allocator) {
+    vpx_mem_set_allocator(NULL);
+    return VPX_CODEC_OK;
+  }
+  mem_allocator.alloc = allocator->alloc;
+  mem_allocator.release = allocator->release;
+  mem_allocator.priv = allocator->priv;
+  return vpx_mem_set_allocator(&mem_allocator) ? VPX_CODEC_INVALID_PARAM
+                                               : VPX_CODEC_OK;
+}
+
+vpx_codec_mem_pool_t *vpx_codec_mem_pool_create(void) {
+  // Not vpx_calloc(): the handle must not come from whichever pool is
+  // currently registered, which may be destroyed before this one.
+  vpx_codec_mem_pool_t *const pool =
+      (vpx_codec_mem_pool_t *)calloc(1, sizeof(*pool));
+
+  if (!pool) return NULL;
+  pool->pool = vpx_mem_pool_create();
+  if (!pool->pool) {
+    free(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+void vpx_codec_mem_pool_destroy(vpx_codec_mem_pool_t *pool) {
+  if (pool) {
+    vpx_mem_pool_destroy(pool->pool);
+    free(pool);
+  }
+}
+
+vpx_codec_err_t vpx_codec_mem_pool_get_allocator(
+    vpx_codec_mem_pool_t *pool, vpx_codec_mem_allocator_t *allocator) {
+  vpx_mem_allocator mem_allocator;
+
+  if (!pool || !allocator) return VPX_CODEC_INVALID_PARAM;
+  vpx_mem_pool_get_allocator(pool->pool, &mem_allocator);
+  allocator->alloc = mem_allocator.alloc;
+  allocator->release = mem_allocator.release;
+  allocator->priv = mem_allocator.priv;
+  return VPX_CODEC_OK;
+}
+
+vpx_codec_err_t vpx_codec_mem_pool_get_stats(
+    vpx_codec_mem_pool_t *pool, vpx_codec_mem_pool_stats_t *stats) {
+  VpxMemPoolStats pool_stats;
+
+  if (!pool || !stats) return VPX_CODEC_INVALID_PARAM;
+  vpx_mem_pool_get_stats(pool->pool, &pool_stats);
+  stats->bytes_in_use = pool_stats.bytes_in_use;
+  stats->bytes_held = pool_stats.bytes_held;
+  stats->peak_bytes_in_use = pool_stats.peak_bytes_in_use;
+  stats->peak_bytes_held = pool_stats.peak_bytes_held;
+  stats->num_allocs = pool_stats.num_allocs;
+  stats->num_heap_allocs = pool_stats.num_heap_allocs;
+  return VPX_CODEC_OK;
+}
+
+void vpx_codec_mem_pool_trim(vpx_codec_mem_pool_t *pool) {
+  if (pool) vpx_mem_pool_trim(pool->pool);
+}
+
 vpx_codec_err_t vpx_codec_control_(vpx_codec_ctx_t *ctx, int ctrl_id, ...) {
   vpx_codec_err_t res;
 
@@ -12,8 +12,12 @@
  * \brief Provides the high level interface to wrap decoder algorithms.
  *
  */
+#include <stdlib.h>
 #include <string.h>
 #include "vpx/internal/vpx_codec_internal.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
 
 #define SAVE_STATUS(ctx, var) (ctx ? (ctx->err = var) : var)
 
@@ -131,6 +135,137 @@ vpx_image_t *vpx_codec_get_frame(vpx_codec_ctx_t *ctx, vpx_codec_iter_t *iter) {
   return img;
 }
 
+typedef struct {
+  vpx_codec_dec_batch_item_t *items;
+  // Index of the next item decoded by the same instance, or -1.
+  const int *next;
+  vpx_codec_batch_frame_cb_fn_t frame_cb;
+  void *cb_priv;
+} DecodeBatch;
+
+// Decodes the items of one instance.
+typedef struct {
+  const DecodeBatch *batch;
+  int first;
+} DecodeBatchJob;
+
+static int decode_batch_hook(void *arg1, void *arg2) {
+  const DecodeBatchJob *const job = (const DecodeBatchJob *)arg1;
+  const DecodeBatch *const batch = job->batch;
+  int i;
+  (void)arg2;
+
+  for (i = job->first; i >= 0; i = batch->next[i]) {
+    vpx_codec_dec_batch_item_t *const item = &batch->items[i];
+    item->res = vpx_codec_decode(item->ctx, item->data, item->data_sz,
+                                 item->user_priv, 0);
+    if (batch->frame_cb != NULL) {
+      vpx_codec_iter_t iter = NULL;
+      const vpx_image_t *img;
+      while ((img = vpx_codec_get_frame(item->ctx, &iter)) != NULL)
+        batch->frame_cb(batch->cb_priv, item, img);
+    }
+  }
+  return 1;
+}
+
+typedef struct {
+  const vpx_codec_ctx_t *ctx;
+  int index;
+} DecodeBatchOrder;
+
+// Orders the items by instance, then by position in the batch.
+static int compare_batch_items(const void *a, const void *b) {
+  const DecodeBatchOrder *const oa = (const DecodeBatchOrder *)a;
+  const DecodeBatchOrder *const ob = (const DecodeBatchOrder *)b;
+  if (oa->ctx != ob->ctx)
+    return (uintptr_t)oa->ctx < (uintptr_t)ob->ctx ? -1 : 1;
+  return oa->index - ob->index;
+}
+
+vpx_codec_err_t vpx_codec_decode_batch(vpx_codec_dec_batch_item_t *items,
+                                       int num_items,
+                                       vpx_codec_thread_pool_t *pool,
+                                       vpx_codec_batch_frame_cb_fn_t frame_cb,
+                                       void *cb_priv) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  DecodeBatch batch;
+  DecodeBatchJob *jobs;
+  VPxWorker *workers;
+  DecodeBatchOrder *order;
+  int *next;
+  int i, num_jobs = 0;
+  vpx_codec_err_t res = VPX_CODEC_OK;
+
+  if (num_items < 0 || (!items && num_items)) return VPX_CODEC_INVALID_PARAM;
+  for (i = 0; i < num_items; ++i) {
+    const vpx_codec_dec_batch_item_t *const item = &items[i];
+    if (!item->ctx || (!item->data && item->data_sz) ||
+        (item->data && !item->data_sz))
+      return VPX_CODEC_INVALID_PARAM;
+  }
+  if (num_items == 0) return VPX_CODEC_OK;
+
+  order = (DecodeBatchOrder *)vpx_malloc(num_items * sizeof(*order));
+  next = (int *)vpx_malloc(num_items * sizeof(*next));
+  jobs = (DecodeBatchJob *)vpx_malloc(num_items * sizeof(*jobs));
+  workers = (VPxWorker *)vpx_calloc(num_items, sizeof(*workers));
+  if (!order || !next || !jobs || !workers) {
+    res = VPX_CODEC_MEM_ERROR;
+    goto done;
+  }
+
+  batch.items = items;
+  batch.next = next;
+  batch.frame_cb = frame_cb;
+  batch.cb_priv = cb_priv;
+
+  // Chain the items of each instance in batch order, one job per instance.
+  for (i = 0; i < num_items; ++i) {
+    order[i].ctx = items[i].ctx;
+    order[i].index = i;
+  }
+  qsort(order, num_items, sizeof(*order), compare_batch_items);
+  for (i = 0; i < num_items; ++i) {
+    const int cur = order[i].index;
+    if (i == 0 || order[i - 1].ctx != order[i].ctx) {
+      jobs[num_jobs].batch = &batch;
+      jobs[num_jobs].first = cur;
+      ++num_jobs;
+    }
+    next[cur] = i + 1 < num_items && order[i + 1].ctx == order[i].ctx
+                    ? order[i + 1].index
+                    : -1;
+  }
+
+  for (i = 0; i < num_jobs; ++i) {
+    VPxWorker *const worker = &workers[i];
+    winterface->init(worker);
+    worker->hook = decode_batch_hook;
+    worker->data1 = &jobs[i];
+    if (pool != NULL) {
+      vpx_thread_pool_attach_worker(pool->pool, worker);
+      winterface->reset(worker);
+      winterface->launch(worker);
+    } else {
+      winterface->execute(worker);
+    }
+  }
+  for (i = 0; i < num_jobs; ++i) {
+    winterface->sync(&workers[i]);
+    winterface->end(&workers[i]);
+  }
+
+  for (i = 0; i < num_items && res == VPX_CODEC_OK; ++i) res = items[i].res;
+
+done:
+  vpx_free(order);
+  vpx_free(next);
+  vpx_free(jobs);
+  vpx_free(workers);
+  return res;
+}
+
 vpx_codec_err_t vpx_codec_register_put_frame_cb(vpx_codec_ctx_t *ctx,
                                                 vpx_codec_put_frame_cb_fn_t cb,
                                                 void *user_priv) {
@@ -16,7 +16,6 @@
 #include <limits.h>
 #include <stdlib.h>
 #include <string.h>
-#include "vp8/common/blockd.h"
 #include "vpx_config.h"
 #include "vpx/internal/vpx_codec_internal.h"
 
@@ -82,9 +81,7 @@ vpx_codec_err_t vpx_codec_enc_init_multi_ver(
     res = VPX_CODEC_INCAPABLE;
   else {
     int i;
-#if CONFIG_MULTI_RES_ENCODING
     int mem_loc_owned = 0;
-#endif
     void *mem_loc = NULL;
 
     if (iface->enc.mr_get_mem_loc == NULL) return VPX_CODEC_INCAPABLE;
@@ -125,18 +122,11 @@ vpx_codec_err_t vpx_codec_enc_init_multi_ver(
             vpx_codec_destroy(ctx);
             i--;
           }
-#if CONFIG_MULTI_RES_ENCODING
-          if (!mem_loc_owned) {
-            assert(mem_loc);
-            free(((LOWER_RES_FRAME_INFO *)mem_loc)->mb_info);
-            free(mem_loc);
-          }
-#endif
+          if (!mem_loc_owned && iface->enc.mr_free_mem != NULL)
+            iface->enc.mr_free_mem(mem_loc);
           return SAVE_STATUS(ctx, res);
         }
-#if CONFIG_MULTI_RES_ENCODING
         mem_loc_owned = 1;
-#endif
         ctx++;
         cfg++;
         dsf++;
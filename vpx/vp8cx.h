@@ -753,6 +753,70 @@ enum vp8e_enc_control_id {
    * Supported in codecs: VP8
    */
   VP8E_SET_RTC_EXTERNAL_RATECTRL,
+
+  /*!\brief Codec control function to run the encoder's threads on an
+   * application owned thread pool.
+   *
+   * The encoder then starts no threads of its own. Its worker count is still
+   * set by #vpx_codec_enc_cfg::g_threads, but the work is queued on the pool
+   * and shared with every other instance attached to it. The pool must
+   * outlive the encoder. Must be called before the first frame is encoded.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_THREAD_POOL,
+
+  /*!\brief Codec control function to have the encoder reference source
+   * images instead of copying them.
+   *
+   * Once set, each image passed to vpx_codec_encode() may be kept in the
+   * lookahead queue as is. The release callback of the
+   * #vpx_source_release_cb_t is invoked exactly once for every image passed
+   * in, with the image's user_priv, as soon as the encoder no longer needs
+   * its pixels. Until then the application must not modify or free the image
+   * data. Images that can not be referenced are copied as usual and released
+   * before vpx_codec_encode() returns. Must be called before the first frame
+   * is encoded.
+   *
+   * To be referenced an image must:
+   * - have #VP9E_SOURCE_BORDER_IN_PIXELS bytes (or samples, for high bit
+   *   depth) of writable memory on all four sides of each plane, scaled down
+   *   by the chroma subsampling for the chroma planes; the encoder extends
+   *   the picture into this border,
+   * - have the luma plane aligned to 32 bytes and the chroma planes aligned
+   *   to 16 bytes,
+   * - have the stride of internally allocated frames: the display width
+   *   rounded up to a multiple of 8, plus twice the border, rounded up to a
+   *   multiple of 32 for luma, and that value shifted by the horizontal
+   *   chroma subsampling for chroma (in samples),
+   * - be encoded with #VP9E_SET_NOISE_SENSITIVITY set to 0.
+   *
+   * For NV12 images the layout requirements apply to the luma plane only:
+   * the luma plane is referenced, and the interleaved chroma is read once to
+   * split it into planar chroma as the image is queued.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_SOURCE_RELEASE_CB,
+
+  /*!\brief Codec control function to turn the collection of per-stage
+   * encoder timings on (1) or off (0, default).
+   *
+   * When off, the timings cost a branch per stage and per worker job.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_STAGE_TIMINGS,
+
+  /*!\brief Codec control function to get the per-stage timings of the last
+   * call to vpx_codec_encode(), see #vpx_stage_timings_t.
+   *
+   * With a lookahead a call may encode no frame, or more than one. The
+   * timings are all zero unless #VP9E_SET_STAGE_TIMINGS is on.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_GET_STAGE_TIMINGS,
 };
 
 /*!\brief vpx 1-D scaling mode
@@ -944,6 +1008,58 @@ typedef struct vpx_svc_spatial_layer_sync {
   int base_layer_intra_only; /**< Flag for setting Intra-only frame on base */
 } vpx_svc_spatial_layer_sync_t;
 
+/*!\brief Border, in pixels, around source images passed by reference.
+ *
+ * \sa #VP9E_SET_SOURCE_RELEASE_CB
+ */
+#define VP9E_SOURCE_BORDER_IN_PIXELS 160
+
+/*!\brief Source image release callback prototype
+ *
+ * Invoked by the encoder once it no longer references a source image.
+ * 'user_priv' is the value given in #vpx_source_release_cb_t and 'img_priv'
+ * is the user_priv field of the released image.
+ */
+typedef void (*vpx_source_release_cb_fn_t)(void *user_priv, void *img_priv);
+
+/*!\brief vp9 source image release callback
+ *
+ * \sa #VP9E_SET_SOURCE_RELEASE_CB
+ */
+typedef struct vpx_source_release_cb {
+  vpx_source_release_cb_fn_t release; /**< Release callback */
+  void *user_priv; /**< Passed as the first argument of release */
+} vpx_source_release_cb_t;
+
+/*!\brief Encoder stages timed by #VP9E_GET_STAGE_TIMINGS */
+typedef enum vp9e_stage {
+  VP9E_STAGE_LOOKAHEAD,       /**< Copying the source to the lookahead */
+  VP9E_STAGE_FIRST_PASS,      /**< First pass analysis */
+  VP9E_STAGE_TEMPORAL_FILTER, /**< Alt-ref temporal filtering */
+  VP9E_STAGE_TPL,             /**< Temporal dependency model */
+  VP9E_STAGE_ENCODE_FRAME,    /**< Partition and mode search */
+  VP9E_STAGE_LOOP_FILTER,     /**< Loop filter level picking and filtering */
+  VP9E_STAGE_PACK_BITSTREAM,  /**< Bitstream packing */
+  VP9E_STAGE_COUNT            /**< Number of stages */
+} vp9e_stage_t;
+
+/*!\brief vp9 per-stage encoder timings
+ *
+ * All times are in microseconds. The CPU time of a stage adds up the calling
+ * thread and the encoder's worker threads. The idle time is how long the
+ * worker threads were not running the stage's jobs while it ran, whether
+ * they waited for work or for other threads.
+ *
+ * \sa #VP9E_GET_STAGE_TIMINGS
+ */
+typedef struct vpx_stage_timings {
+  int64_t wall_time[VP9E_STAGE_COUNT]; /**< Wall clock time of each stage */
+  int64_t cpu_time[VP9E_STAGE_COUNT];  /**< CPU time of each stage */
+  int64_t idle_time[VP9E_STAGE_COUNT]; /**< Worker thread idle time */
+  int64_t encode_wall_time; /**< Wall clock time of vpx_codec_encode() */
+  int num_worker_threads;   /**< Worker threads besides the calling one */
+} vpx_stage_timings_t;
+
 /*!\cond */
 /*!\brief VP8 encoder control function parameter type
  *
@@ -1124,6 +1240,18 @@ VPX_CTRL_USE_TYPE(VP8E_SET_RTC_EXTERNAL_RATECTRL, int)
 VPX_CTRL_USE_TYPE(VP9E_SET_EXTERNAL_RATE_CONTROL, vpx_rc_funcs_t *)
 #define VPX_CTRL_VP9E_SET_EXTERNAL_RATE_CONTROL
 
+VPX_CTRL_USE_TYPE(VP9E_SET_THREAD_POOL, vpx_codec_thread_pool_t *)
+#define VPX_CTRL_VP9E_SET_THREAD_POOL
+
+VPX_CTRL_USE_TYPE(VP9E_SET_SOURCE_RELEASE_CB, vpx_source_release_cb_t *)
+#define VPX_CTRL_VP9E_SET_SOURCE_RELEASE_CB
+
+VPX_CTRL_USE_TYPE(VP9E_SET_STAGE_TIMINGS, unsigned int)
+#define VPX_CTRL_VP9E_SET_STAGE_TIMINGS
+
+VPX_CTRL_USE_TYPE(VP9E_GET_STAGE_TIMINGS, vpx_stage_timings_t *)
+#define VPX_CTRL_VP9E_GET_STAGE_TIMINGS
+
 /*!\endcond */
 /*! @} - end defgroup vp8_encoder */
 #ifdef __cplusplus
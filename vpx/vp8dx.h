@@ -142,6 +142,57 @@ enum vp8_dec_control_id {
    */
   VP9D_SET_LOOP_FILTER_OPT,
 
+  /*!\brief Codec control function to run the decoder's threads on an
+   * application owned thread pool.
+   *
+   * The decoder then starts no tile or loop filter threads of its own. Its
+   * worker count is still set by #vpx_codec_dec_cfg::threads, but the work
+   * is queued on the pool and shared with every other instance attached to
+   * it. #VP9D_SET_LOOP_FILTER_OPT is ignored while a pool is attached, and
+   * frame parallel decoding keeps one dedicated thread per frame. The pool
+   * must outlive the decoder. Must be called before the first frame is
+   * decoded.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_SET_THREAD_POOL,
+
+  /*!\brief Codec control function to pipeline frame parallel decoding.
+   *
+   * 0 : off, 1 : on
+   *
+   * Each frame is fully parsed before it is reconstructed and loop filtered,
+   * so that the next frame can be parsed, on another thread, while the
+   * reconstruction of the current one finishes. This lowers the latency of
+   * streams using backward adaptation, whose frames otherwise wait for the
+   * previous frame to be fully decoded. Only applies when the decoder is
+   * initialized with #VPX_CODEC_USE_FRAME_THREADING and more than one
+   * thread. Must be called before the first frame is decoded.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_SET_PIPELINE_DECODE,
+
+  /*!\brief Codec control function to turn the collection of per-stage
+   * decoder timings on (1) or off (0, default).
+   *
+   * When off, the timings cost a branch per stage and per worker job.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_SET_STAGE_TIMINGS,
+
+  /*!\brief Codec control function to get the per-stage timings of the frames
+   * whose decoding finished during the last call to vpx_codec_decode(), see
+   * #vpx_dec_stage_timings_t.
+   *
+   * With frame parallel decoding a call may finish no frame, or more than
+   * one. The timings are all zero unless #VP9D_SET_STAGE_TIMINGS is on.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_GET_STAGE_TIMINGS,
+
   VP8_DECODER_CTRL_ID_MAX
 };
 
@@ -163,6 +214,51 @@ typedef struct vpx_decrypt_init {
   void *decrypt_state;
 } vpx_decrypt_init;
 
+/*!\brief Decoder stages timed by #VP9D_GET_STAGE_TIMINGS
+ *
+ * Parsing and reconstruction are only timed apart when they run as separate
+ * passes, with #VP9D_SET_ROW_MT or #VP9D_SET_PIPELINE_DECODE. Otherwise they
+ * are interleaved block by block and reported together as
+ * #VP9D_STAGE_TILES.
+ */
+typedef enum vp9d_stage {
+  VP9D_STAGE_HEADERS,     /**< Uncompressed and compressed headers */
+  VP9D_STAGE_TILES,       /**< Interleaved parsing and reconstruction */
+  VP9D_STAGE_PARSE,       /**< Mode info and coefficient token parsing */
+  VP9D_STAGE_RECON,       /**< Prediction and inverse transforms */
+  VP9D_STAGE_LOOP_FILTER, /**< Loop filtering */
+  VP9D_STAGE_FRAME_WAIT,  /**< Waits for the progress of other frames */
+  VP9D_STAGE_COUNT        /**< Number of stages */
+} vp9d_stage_t;
+
+/*!\brief Maximum number of worker threads reported by
+ * #VP9D_GET_STAGE_TIMINGS */
+#define VP9D_MAX_TIMED_WORKERS 64
+
+/*!\brief vp9 per-stage decoder timings
+ *
+ * All times are in microseconds. The time of a stage is the CPU time spent in
+ * it, added up over the calling thread and the decoder's worker threads. The
+ * frame waits are wall clock time: frame parallel decoding blocks until the
+ * reference frames, or the previous frame, have progressed far enough.
+ *
+ * The worker threads are the tile, row and loop filter workers, or the frame
+ * workers with frame parallel decoding. The busy time of a worker is the CPU
+ * time it spent running the decoder's jobs on its own thread during the
+ * call, its idle time is the rest of #decode_wall_time.
+ *
+ * \sa #VP9D_GET_STAGE_TIMINGS
+ */
+typedef struct vpx_dec_stage_timings {
+  int64_t stage_time[VP9D_STAGE_COUNT]; /**< Time spent in each stage */
+  int64_t decode_wall_time; /**< Wall clock time of vpx_codec_decode() */
+  int num_worker_threads;   /**< Worker threads besides the calling one */
+  /*! Busy time of the first #VP9D_MAX_TIMED_WORKERS worker threads */
+  int64_t worker_busy_time[VP9D_MAX_TIMED_WORKERS];
+  /*! Idle time of the first #VP9D_MAX_TIMED_WORKERS worker threads */
+  int64_t worker_idle_time[VP9D_MAX_TIMED_WORKERS];
+} vpx_dec_stage_timings_t;
+
 /*!\cond */
 /*!\brief VP8 decoder control function parameter type
  *
@@ -199,6 +295,14 @@ VPX_CTRL_USE_TYPE(VP9_SET_SKIP_LOOP_FILTER, int)
 VPX_CTRL_USE_TYPE(VP9D_SET_ROW_MT, int)
 #define VPX_CTRL_VP9_SET_LOOP_FILTER_OPT
 VPX_CTRL_USE_TYPE(VP9D_SET_LOOP_FILTER_OPT, int)
+#define VPX_CTRL_VP9D_SET_THREAD_POOL
+VPX_CTRL_USE_TYPE(VP9D_SET_THREAD_POOL, vpx_codec_thread_pool_t *)
+#define VPX_CTRL_VP9D_SET_PIPELINE_DECODE
+VPX_CTRL_USE_TYPE(VP9D_SET_PIPELINE_DECODE, int)
+#define VPX_CTRL_VP9D_SET_STAGE_TIMINGS
+VPX_CTRL_USE_TYPE(VP9D_SET_STAGE_TIMINGS, unsigned int)
+#define VPX_CTRL_VP9D_GET_STAGE_TIMINGS
+VPX_CTRL_USE_TYPE(VP9D_GET_STAGE_TIMINGS, vpx_dec_stage_timings_t *)
 
 /*!\endcond */
 /*! @} - end defgroup vp8_decoder */
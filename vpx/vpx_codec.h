@@ -360,6 +360,149 @@ vpx_codec_err_t vpx_codec_destroy(vpx_codec_ctx_t *ctx);
  */
 vpx_codec_caps_t vpx_codec_get_caps(vpx_codec_iface_t *iface);
 
+/*!\brief Thread pool handle
+ *
+ * A set of worker threads owned by the application. Any number of codec
+ * instances can be attached to the same pool, see #VP9E_SET_THREAD_POOL and
+ * #VP9D_SET_THREAD_POOL. Attached instances queue their multi-threaded work
+ * on the pool instead of starting threads of their own, which bounds the
+ * number of threads in a process running many instances.
+ */
+typedef struct vpx_codec_thread_pool vpx_codec_thread_pool_t;
+
+/*!\brief Create a thread pool
+ *
+ * The threads are started immediately and run until the pool is destroyed.
+ *
+ * \param[in] num_threads  Number of threads, must be greater than 0
+ *
+ * \return The new pool, or NULL if num_threads is out of range, the threads
+ *         could not be created, or the library was built without
+ *         multi-threading support.
+ */
+vpx_codec_thread_pool_t *vpx_codec_thread_pool_create(int num_threads);
+
+/*!\brief Destroy a thread pool
+ *
+ * All codec instances attached to the pool must be destroyed first.
+ *
+ * \param[in] pool  Pool returned by vpx_codec_thread_pool_create(), or NULL
+ */
+void vpx_codec_thread_pool_destroy(vpx_codec_thread_pool_t *pool);
+
+/*!\brief Memory allocator
+ *
+ * Backing store for the library's internal allocations, used in place of
+ * malloc() and free(), see vpx_codec_set_mem_allocator().
+ */
+typedef struct vpx_codec_mem_allocator {
+  /*!\brief Returns at least \p size bytes with malloc() alignment, or NULL.
+   *
+   * May be called from any thread, including the codecs' worker threads.
+   */
+  void *(*alloc)(void *priv, size_t size);
+
+  /*!\brief Releases a block returned by \p alloc. */
+  void (*release)(void *priv, void *ptr);
+
+  /*!\brief Opaque context passed to \p alloc and \p release. */
+  void *priv;
+} vpx_codec_mem_allocator_t;
+
+/*!\brief Set the memory allocator
+ *
+ * Routes all subsequent allocations made by the library, by every codec
+ * instance in the process, through \p allocator. The structure is copied.
+ *
+ * This function may be called at any time and from any thread: each
+ * allocation uses either the previous or the new allocator in full. Every
+ * block is released through the allocator that produced it, so an allocator
+ * and its \p priv must remain usable until all of its blocks have been
+ * released, which for blocks owned by a codec instance is when that instance
+ * is destroyed. Registering the allocator before the first instance is
+ * created and restoring the default after the last one is destroyed is
+ * therefore always safe.
+ *
+ * \param[in] allocator  Allocator to use, or NULL to restore malloc() and
+ *                       free()
+ *
+ * \retval #VPX_CODEC_OK
+ *     The allocator was registered.
+ * \retval #VPX_CODEC_INVALID_PARAM
+ *     \p alloc or \p release is NULL. The registration is unchanged.
+ */
+vpx_codec_err_t vpx_codec_set_mem_allocator(
+    const vpx_codec_mem_allocator_t *allocator);
+
+/*!\brief Memory pool handle
+ *
+ * A size-class allocator that keeps released blocks for reuse. Codec
+ * instances that are created, reconfigured or resized repeatedly are then
+ * served from memory the pool already holds instead of from the heap. The
+ * pool is thread safe.
+ */
+typedef struct vpx_codec_mem_pool vpx_codec_mem_pool_t;
+
+/*!\brief Memory pool statistics */
+typedef struct vpx_codec_mem_pool_stats {
+  size_t bytes_in_use;       /**< Bytes handed out and not yet released */
+  size_t bytes_held;         /**< Bytes in use plus bytes cached for reuse */
+  size_t peak_bytes_in_use;  /**< Largest value of bytes_in_use */
+  size_t peak_bytes_held;    /**< Largest value of bytes_held */
+  uint64_t num_allocs;       /**< Number of allocation requests */
+  uint64_t num_heap_allocs;  /**< Requests that had to allocate from the heap */
+} vpx_codec_mem_pool_stats_t;
+
+/*!\brief Create a memory pool
+ *
+ * \return The new pool, or NULL on allocation failure.
+ */
+vpx_codec_mem_pool_t *vpx_codec_mem_pool_create(void);
+
+/*!\brief Destroy a memory pool
+ *
+ * Every block allocated from the pool must have been released first.
+ *
+ * \param[in] pool  Pool returned by vpx_codec_mem_pool_create(), or NULL
+ */
+void vpx_codec_mem_pool_destroy(vpx_codec_mem_pool_t *pool);
+
+/*!\brief Get an allocator backed by a memory pool
+ *
+ * The result is suitable for vpx_codec_set_mem_allocator().
+ *
+ * \param[in]  pool       Memory pool
+ * \param[out] allocator  Allocator that draws from \p pool
+ *
+ * \retval #VPX_CODEC_OK
+ *     \p allocator was filled in.
+ * \retval #VPX_CODEC_INVALID_PARAM
+ *     \p pool or \p allocator is NULL.
+ */
+vpx_codec_err_t vpx_codec_mem_pool_get_allocator(
+    vpx_codec_mem_pool_t *pool, vpx_codec_mem_allocator_t *allocator);
+
+/*!\brief Get memory pool statistics
+ *
+ * \param[in]  pool   Memory pool
+ * \param[out] stats  Current statistics of \p pool
+ *
+ * \retval #VPX_CODEC_OK
+ *     \p stats was filled in.
+ * \retval #VPX_CODEC_INVALID_PARAM
+ *     \p pool or \p stats is NULL.
+ */
+vpx_codec_err_t vpx_codec_mem_pool_get_stats(vpx_codec_mem_pool_t *pool,
+                                             vpx_codec_mem_pool_stats_t *stats);
+
+/*!\brief Return the blocks cached by a memory pool to the system
+ *
+ * Blocks still in use are not affected.
+ *
+ * \param[in] pool  Memory pool, or NULL
+ */
+void vpx_codec_mem_pool_trim(vpx_codec_mem_pool_t *pool);
+
 /*!\brief Control algorithm
  *
  * This function is used to exchange algorithm specific data with the codec
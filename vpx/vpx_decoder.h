@@ -233,6 +233,69 @@ vpx_codec_err_t vpx_codec_decode(vpx_codec_ctx_t *ctx, const uint8_t *data,
  */
 vpx_image_t *vpx_codec_get_frame(vpx_codec_ctx_t *ctx, vpx_codec_iter_t *iter);
 
+/*!\brief Batched decode entry
+ *
+ * One buffer of coded data passed to vpx_codec_decode_batch().
+ */
+typedef struct vpx_codec_dec_batch_item {
+  vpx_codec_ctx_t *ctx; /**< Decoder instance decoding the buffer */
+  const uint8_t *data;  /**< Coded data, as for vpx_codec_decode() */
+  unsigned int data_sz; /**< Size of the coded data, in bytes */
+  void *user_priv;      /**< Application specific data of the frame */
+  vpx_codec_err_t res;  /**< Set to the result of decoding the buffer */
+} vpx_codec_dec_batch_item_t;
+
+/*!\brief Batched decode frame callback prototype
+ *
+ * Invoked by vpx_codec_decode_batch() for each frame made available by the
+ * decode of 'item', in the order vpx_codec_get_frame() returns them. The
+ * image is only valid for the duration of the call.
+ */
+typedef void (*vpx_codec_batch_frame_cb_fn_t)(
+    void *cb_priv, const vpx_codec_dec_batch_item_t *item,
+    const vpx_image_t *img);
+
+/*!\brief Decode a batch of buffers
+ *
+ * Decodes the buffers of many decoder instances at once, typically many short
+ * streams decoded with one thread each. Every decoder instance is decoded by
+ * one thread at a time, the instances are spread over the threads of 'pool'.
+ * The calling thread takes part in the decoding and the function returns
+ * once all the buffers are decoded.
+ *
+ * Several items may use the same instance, its buffers are then decoded in
+ * the order of the items, as by successive calls to vpx_codec_decode(). The
+ * buffers of different instances are decoded in no particular order.
+ *
+ * The frame callback is invoked as soon as the frames of an item are
+ * decoded, from the thread that decoded them. Calls for the same instance
+ * are serialized, calls for different instances may be concurrent. Without a
+ * callback the frames of the last item of each instance are available with
+ * vpx_codec_get_frame() once the function returns.
+ *
+ * \param[in,out] items     Buffers to decode. The result of each decode is
+ *                          written back to the item.
+ * \param[in]     num_items Number of items.
+ * \param[in]     pool      Pool returned by vpx_codec_thread_pool_create(),
+ *                          or NULL to decode the items on the calling thread.
+ * \param[in]     frame_cb  Frame callback, may be NULL.
+ * \param[in]     cb_priv   Private data passed to the callback.
+ *
+ * \retval #VPX_CODEC_OK
+ *     All the buffers were decoded.
+ * \retval #VPX_CODEC_INVALID_PARAM
+ *     An item has no instance or inconsistent data, nothing was decoded.
+ * \retval #VPX_CODEC_MEM_ERROR
+ *     Nothing was decoded.
+ * \return Otherwise the error of the first item, in array order, that failed
+ *         to decode.
+ */
+vpx_codec_err_t vpx_codec_decode_batch(vpx_codec_dec_batch_item_t *items,
+                                       int num_items,
+                                       vpx_codec_thread_pool_t *pool,
+                                       vpx_codec_batch_frame_cb_fn_t frame_cb,
+                                       void *cb_priv);
+
 /*!\defgroup cap_put_frame Frame-Based Decoding Functions
  *
  * The following function is required to be implemented for all decoders
@@ -896,6 +896,15 @@ vpx_codec_err_t vpx_codec_enc_init_ver(vpx_codec_ctx_t *ctx,
  * instead of this function directly, to ensure that the ABI version number
  * parameter is properly initialized.
  *
+ * ctx[0] and cfg[0] describe the highest resolution. The encoders share
+ * their analysis from the lowest resolution up, and vpx_codec_encode()
+ * takes an array of num_enc images of the same source, one per resolution.
+ * VP9 supports this in one pass mode without lag in frames: the higher
+ * resolutions then follow the key frames and golden frame updates of the
+ * lowest one and reuse its scene detection and motion vectors. As each frame
+ * is coded on arrival, there are no first-pass stats or alt-ref frames to
+ * share.
+ *
  * \param[in]    ctx     Pointer to this instance's context.
  * \param[in]    iface   Pointer to the algorithm interface to use.
  * \param[in]    cfg     Configuration to use, if known. May be NULL.
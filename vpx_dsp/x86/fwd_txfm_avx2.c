@@ -8,19 +8,1090 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <immintrin.h>  // AVX2
+
 #include "./vpx_config.h"
 #include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/txfm_common.h"
+#include "vpx_dsp/x86/inv_txfm_avx2.h"
+#include "vpx_dsp/x86/txfm_common_avx2.h"
+
+// The transforms below follow vpx_fdct8x8_c() and vpx_fdct16x16_c() step for
+// step, so the results are bit-exact with the C code. Each 1-D pass works on
+// whole rows: the column transform runs across the rows of the block, the
+// block is transposed and the same code then transforms the rows.
+//
+// The 8-bit transforms keep the data in 16 bits, as the SSE2 versions do, and
+// form the products with _mm256_madd_epi16(). The high bit depth transforms
+// keep the data in 32 bits and form the products and sums in 64 bits, so they
+// are exact for any input the C code handles and do not need to fall back to
+// C for large residuals.
+
+// Returns fdct_round_shift(a * k0 + b * k1) for each 16-bit lane, where the
+// constants (k0, k1) are interleaved in |k|.
+static INLINE __m256i mult_round_shift(__m256i a, __m256i b, __m256i k) {
+  const __m256i rounding = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), k);
+  __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), k);
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, rounding), DCT_CONST_BITS);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, rounding), DCT_CONST_BITS);
+  return _mm256_packs_epi32(lo, hi);
+}
+
+// Swaps the 128-bit halves of |a|.
+static INLINE __m256i swap_halves(__m256i a) {
+  return _mm256_permute4x64_epi64(a, 0x4e);
+}
+
+static INLINE __m256i load_rows_8x2(const int16_t *a, const int16_t *b) {
+  const __m128i lo = _mm_loadu_si128((const __m128i *)a);
+  const __m128i hi = _mm_loadu_si128((const __m128i *)b);
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+// Stores 16 coefficients in order, widening them for high bit depth builds.
+static INLINE void store_coeffs_16(__m256i a, tran_low_t *b) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  _mm256_storeu_si256((__m256i *)b,
+                      _mm256_cvtepi16_epi32(_mm256_castsi256_si128(a)));
+  _mm256_storeu_si256((__m256i *)(b + 8),
+                      _mm256_cvtepi16_epi32(_mm256_extracti128_si256(a, 1)));
+#else
+  _mm256_storeu_si256((__m256i *)b, a);
+#endif
+}
+
+// Transposes the two 8x8 blocks held in the low and high halves of in[0..7].
+static INLINE void transpose_16bit_8x8x2(const __m256i *in, __m256i *out) {
+  const __m256i a0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i a1 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i a2 = _mm256_unpacklo_epi16(in[4], in[5]);
+  const __m256i a3 = _mm256_unpacklo_epi16(in[6], in[7]);
+  const __m256i a4 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i a5 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i a6 = _mm256_unpackhi_epi16(in[4], in[5]);
+  const __m256i a7 = _mm256_unpackhi_epi16(in[6], in[7]);
+
+  const __m256i b0 = _mm256_unpacklo_epi32(a0, a1);
+  const __m256i b1 = _mm256_unpacklo_epi32(a2, a3);
+  const __m256i b2 = _mm256_unpackhi_epi32(a0, a1);
+  const __m256i b3 = _mm256_unpackhi_epi32(a2, a3);
+  const __m256i b4 = _mm256_unpacklo_epi32(a4, a5);
+  const __m256i b5 = _mm256_unpacklo_epi32(a6, a7);
+  const __m256i b6 = _mm256_unpackhi_epi32(a4, a5);
+  const __m256i b7 = _mm256_unpackhi_epi32(a6, a7);
+
+  out[0] = _mm256_unpacklo_epi64(b0, b1);
+  out[1] = _mm256_unpackhi_epi64(b0, b1);
+  out[2] = _mm256_unpacklo_epi64(b2, b3);
+  out[3] = _mm256_unpackhi_epi64(b2, b3);
+  out[4] = _mm256_unpacklo_epi64(b4, b5);
+  out[5] = _mm256_unpackhi_epi64(b4, b5);
+  out[6] = _mm256_unpacklo_epi64(b6, b7);
+  out[7] = _mm256_unpackhi_epi64(b6, b7);
+}
+
+// One pass of vpx_fdct8x8_c() with two rows per register. The input is
+// in[] = { [r0 | r1], [r2 | r3], [r5 | r4], [r7 | r6] } and the output is
+// out[i] = [o(i) | o(i + 4)], ready for transpose_16bit_8x8_avx2().
+static INLINE void fdct8_avx2(const __m256i *in, __m256i *out) {
+  const __m256i k_out0_out4 =
+      pair_pair256_set_epi16(cospi_16_64, cospi_16_64, -cospi_16_64,
+                             cospi_16_64);
+  const __m256i k_out2_out6 =
+      pair_pair256_set_epi16(cospi_8_64, cospi_24_64, -cospi_8_64,
+                             cospi_24_64);
+  const __m256i k_t2_t3 = pair_pair256_set_epi16(cospi_16_64, -cospi_16_64,
+                                                 cospi_16_64, cospi_16_64);
+  const __m256i k_out1_out7 =
+      pair_pair256_set_epi16(cospi_28_64, cospi_4_64, cospi_28_64,
+                             -cospi_4_64);
+  const __m256i k_out5_out3 =
+      pair_pair256_set_epi16(cospi_12_64, cospi_20_64, cospi_12_64,
+                             -cospi_20_64);
+  // stage 1
+  const __m256i s01 = _mm256_add_epi16(in[0], in[3]);
+  const __m256i s23 = _mm256_add_epi16(in[1], in[2]);
+  const __m256i s76 = _mm256_sub_epi16(in[0], in[3]);
+  const __m256i s54 = _mm256_sub_epi16(in[1], in[2]);
+  // fdct4(step, step);
+  const __m256i s32 = swap_halves(s23);
+  const __m256i x01 = _mm256_add_epi16(s01, s32);
+  const __m256i x32 = _mm256_sub_epi16(s01, s32);
+  const __m256i out04 = mult_round_shift(x01, swap_halves(x01), k_out0_out4);
+  const __m256i out26 = mult_round_shift(x32, swap_halves(x32), k_out2_out6);
+  // Stage 2
+  const __m256i s65 = _mm256_permute2x128_si256(s76, s54, 0x21);
+  const __m256i t23 = mult_round_shift(s65, swap_halves(s65), k_t2_t3);
+  // Stage 3
+  const __m256i s47 = _mm256_permute2x128_si256(s54, s76, 0x21);
+  const __m256i x03 = _mm256_add_epi16(s47, t23);
+  const __m256i x12 = _mm256_sub_epi16(s47, t23);
+  // Stage 4
+  const __m256i out17 = mult_round_shift(x03, swap_halves(x03), k_out1_out7);
+  const __m256i out53 = mult_round_shift(x12, swap_halves(x12), k_out5_out3);
+
+  out[0] = out04;
+  out[1] = _mm256_permute2x128_si256(out17, out53, 0x20);
+  out[2] = out26;
+  out[3] = _mm256_permute2x128_si256(out53, out17, 0x31);
+}
+
+void vpx_fdct8x8_avx2(const int16_t *input, tran_low_t *output, int stride) {
+  __m256i in[4], out[4], rows[4];
+  int i;
+
+  in[0] = _mm256_slli_epi16(load_rows_8x2(input, input + stride), 2);
+  in[1] = _mm256_slli_epi16(
+      load_rows_8x2(input + 2 * stride, input + 3 * stride), 2);
+  in[2] = _mm256_slli_epi16(
+      load_rows_8x2(input + 5 * stride, input + 4 * stride), 2);
+  in[3] = _mm256_slli_epi16(
+      load_rows_8x2(input + 7 * stride, input + 6 * stride), 2);
+
+  // Transform columns
+  fdct8_avx2(in, out);
+  transpose_16bit_8x8_avx2(out, rows);
+
+  // Transform rows
+  in[0] = rows[0];
+  in[1] = rows[1];
+  in[2] = swap_halves(rows[2]);
+  in[3] = swap_halves(rows[3]);
+  fdct8_avx2(in, out);
+  transpose_16bit_8x8_avx2(out, rows);
+
+  for (i = 0; i < 4; ++i) {
+    // output /= 2, rounding toward zero.
+    const __m256i sign = _mm256_srai_epi16(rows[i], 15);
+    rows[i] = _mm256_srai_epi16(_mm256_sub_epi16(rows[i], sign), 1);
+    store_coeffs_16(rows[i], output + 16 * i);
+  }
+}
+
+// One pass of vpx_fdct16x16_c() over 16 columns. |in_high| and |step1| are
+// the sums and differences of mirrored rows and out[i] is output row i.
+static INLINE void fdct16_avx2(const __m256i *in_high, __m256i *step1,
+                               __m256i *out) {
+  const __m256i k__cospi_p16_p16 = pair256_set_epi16(cospi_16_64, cospi_16_64);
+  const __m256i k__cospi_p16_m16 = pair256_set_epi16(cospi_16_64, -cospi_16_64);
+  const __m256i k__cospi_p24_p08 = pair256_set_epi16(cospi_24_64, cospi_8_64);
+  const __m256i k__cospi_m08_p24 = pair256_set_epi16(-cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p08_m24 = pair256_set_epi16(cospi_8_64, -cospi_24_64);
+  const __m256i k__cospi_p28_p04 = pair256_set_epi16(cospi_28_64, cospi_4_64);
+  const __m256i k__cospi_m04_p28 = pair256_set_epi16(-cospi_4_64, cospi_28_64);
+  const __m256i k__cospi_p12_p20 = pair256_set_epi16(cospi_12_64, cospi_20_64);
+  const __m256i k__cospi_m20_p12 = pair256_set_epi16(-cospi_20_64, cospi_12_64);
+  const __m256i k__cospi_p30_p02 = pair256_set_epi16(cospi_30_64, cospi_2_64);
+  const __m256i k__cospi_m02_p30 = pair256_set_epi16(-cospi_2_64, cospi_30_64);
+  const __m256i k__cospi_p14_p18 = pair256_set_epi16(cospi_14_64, cospi_18_64);
+  const __m256i k__cospi_m18_p14 = pair256_set_epi16(-cospi_18_64, cospi_14_64);
+  const __m256i k__cospi_p22_p10 = pair256_set_epi16(cospi_22_64, cospi_10_64);
+  const __m256i k__cospi_m10_p22 = pair256_set_epi16(-cospi_10_64, cospi_22_64);
+  const __m256i k__cospi_p06_p26 = pair256_set_epi16(cospi_6_64, cospi_26_64);
+  const __m256i k__cospi_m26_p06 = pair256_set_epi16(-cospi_26_64, cospi_6_64);
+  __m256i step2[8], step3[8];
+
+  // Work on the first eight values; fdct8(input, even_results);
+  {
+    __m256i s0, s1, s2, s3, s4, s5, s6, s7;
+    __m256i t2, t3;
+    __m256i x0, x1, x2, x3;
+
+    // stage 1
+    s0 = _mm256_add_epi16(in_high[0], in_high[7]);
+    s1 = _mm256_add_epi16(in_high[1], in_high[6]);
+    s2 = _mm256_add_epi16(in_high[2], in_high[5]);
+    s3 = _mm256_add_epi16(in_high[3], in_high[4]);
+    s4 = _mm256_sub_epi16(in_high[3], in_high[4]);
+    s5 = _mm256_sub_epi16(in_high[2], in_high[5]);
+    s6 = _mm256_sub_epi16(in_high[1], in_high[6]);
+    s7 = _mm256_sub_epi16(in_high[0], in_high[7]);
+
+    // fdct4(step, step);
+    x0 = _mm256_add_epi16(s0, s3);
+    x1 = _mm256_add_epi16(s1, s2);
+    x2 = _mm256_sub_epi16(s1, s2);
+    x3 = _mm256_sub_epi16(s0, s3);
+    out[0] = mult_round_shift(x0, x1, k__cospi_p16_p16);
+    out[8] = mult_round_shift(x0, x1, k__cospi_p16_m16);
+    out[4] = mult_round_shift(x2, x3, k__cospi_p24_p08);
+    out[12] = mult_round_shift(x2, x3, k__cospi_m08_p24);
+
+    // Stage 2
+    t2 = mult_round_shift(s6, s5, k__cospi_p16_m16);
+    t3 = mult_round_shift(s6, s5, k__cospi_p16_p16);
+
+    // Stage 3
+    x0 = _mm256_add_epi16(s4, t2);
+    x1 = _mm256_sub_epi16(s4, t2);
+    x2 = _mm256_sub_epi16(s7, t3);
+    x3 = _mm256_add_epi16(s7, t3);
+
+    // Stage 4
+    out[2] = mult_round_shift(x0, x3, k__cospi_p28_p04);
+    out[14] = mult_round_shift(x0, x3, k__cospi_m04_p28);
+    out[10] = mult_round_shift(x1, x2, k__cospi_p12_p20);
+    out[6] = mult_round_shift(x1, x2, k__cospi_m20_p12);
+  }
+  // Work on the next eight values; step1 -> odd_results
+  {
+    // step 2
+    step2[2] = mult_round_shift(step1[5], step1[2], k__cospi_p16_m16);
+    step2[3] = mult_round_shift(step1[4], step1[3], k__cospi_p16_m16);
+    step2[4] = mult_round_shift(step1[4], step1[3], k__cospi_p16_p16);
+    step2[5] = mult_round_shift(step1[5], step1[2], k__cospi_p16_p16);
+    // step 3
+    step3[0] = _mm256_add_epi16(step1[0], step2[3]);
+    step3[1] = _mm256_add_epi16(step1[1], step2[2]);
+    step3[2] = _mm256_sub_epi16(step1[1], step2[2]);
+    step3[3] = _mm256_sub_epi16(step1[0], step2[3]);
+    step3[4] = _mm256_sub_epi16(step1[7], step2[4]);
+    step3[5] = _mm256_sub_epi16(step1[6], step2[5]);
+    step3[6] = _mm256_add_epi16(step1[6], step2[5]);
+    step3[7] = _mm256_add_epi16(step1[7], step2[4]);
+    // step 4
+    step2[1] = mult_round_shift(step3[1], step3[6], k__cospi_m08_p24);
+    step2[2] = mult_round_shift(step3[2], step3[5], k__cospi_p24_p08);
+    step2[5] = mult_round_shift(step3[2], step3[5], k__cospi_p08_m24);
+    step2[6] = mult_round_shift(step3[1], step3[6], k__cospi_p24_p08);
+    // step 5
+    step1[0] = _mm256_add_epi16(step3[0], step2[1]);
+    step1[1] = _mm256_sub_epi16(step3[0], step2[1]);
+    step1[2] = _mm256_add_epi16(step3[3], step2[2]);
+    step1[3] = _mm256_sub_epi16(step3[3], step2[2]);
+    step1[4] = _mm256_sub_epi16(step3[4], step2[5]);
+    step1[5] = _mm256_add_epi16(step3[4], step2[5]);
+    step1[6] = _mm256_sub_epi16(step3[7], step2[6]);
+    step1[7] = _mm256_add_epi16(step3[7], step2[6]);
+    // step 6
+    out[1] = mult_round_shift(step1[0], step1[7], k__cospi_p30_p02);
+    out[9] = mult_round_shift(step1[1], step1[6], k__cospi_p14_p18);
+    out[5] = mult_round_shift(step1[2], step1[5], k__cospi_p22_p10);
+    out[13] = mult_round_shift(step1[3], step1[4], k__cospi_p06_p26);
+    out[3] = mult_round_shift(step1[3], step1[4], k__cospi_m26_p06);
+    out[11] = mult_round_shift(step1[2], step1[5], k__cospi_m10_p22);
+    out[7] = mult_round_shift(step1[1], step1[6], k__cospi_m18_p14);
+    out[15] = mult_round_shift(step1[0], step1[7], k__cospi_m02_p30);
+  }
+}
+
+static INLINE void transpose_16bit_16x16(const __m256i *in, __m256i *out) {
+  __m256i t[8], u[8];
+  int i;
+  transpose_16bit_8x8x2(in, t);
+  transpose_16bit_8x8x2(in + 8, u);
+  for (i = 0; i < 8; ++i) {
+    out[i] = _mm256_permute2x128_si256(t[i], u[i], 0x20);
+    out[i + 8] = _mm256_permute2x128_si256(t[i], u[i], 0x31);
+  }
+}
+
+void vpx_fdct16x16_avx2(const int16_t *input, tran_low_t *output,
+                        int stride) {
+  const __m256i kOne = _mm256_set1_epi16(1);
+  __m256i in[16], in_high[8], step1[8], out[16];
+  int i;
+
+  for (i = 0; i < 16; ++i) {
+    in[i] = _mm256_loadu_si256((const __m256i *)(input + i * stride));
+  }
+
+  // Transform columns
+  for (i = 0; i < 8; ++i) {
+    in_high[i] = _mm256_slli_epi16(_mm256_add_epi16(in[i], in[15 - i]), 2);
+    step1[i] = _mm256_slli_epi16(_mm256_sub_epi16(in[7 - i], in[8 + i]), 2);
+  }
+  fdct16_avx2(in_high, step1, out);
+  transpose_16bit_16x16(out, in);
+
+  // Transform rows
+  for (i = 0; i < 16; ++i) {
+    in[i] = _mm256_srai_epi16(_mm256_add_epi16(in[i], kOne), 2);
+  }
+  for (i = 0; i < 8; ++i) {
+    in_high[i] = _mm256_add_epi16(in[i], in[15 - i]);
+    step1[i] = _mm256_sub_epi16(in[7 - i], in[8 + i]);
+  }
+  fdct16_avx2(in_high, step1, out);
+  transpose_16bit_16x16(out, in);
+
+  for (i = 0; i < 16; ++i) store_coeffs_16(in[i], output + 16 * i);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static INLINE __m256i highbd_mult_round_shift_c(__m256i a, __m256i b, int c0,
+                                                int c1) {
+  return highbd_mult_round_shift_avx2(a, b, _mm256_set1_epi32(c0),
+                                      _mm256_set1_epi32(c1));
+}
+
+// Returns 1 if every residual in the |size|x|size| block fits in 8 bits plus
+// sign. Those blocks keep every intermediate value of vpx_fdct8x8(),
+// vpx_fdct16x16() and vpx_fdct32x32() within 16 bits, so the faster 8-bit
+// transforms give the same result.
+static INLINE int is_8bit_residual(const int16_t *input, int stride,
+                                   int size) {
+  const __m256i kMask = _mm256_set1_epi16((int16_t)0xff00);
+  __m256i acc = _mm256_setzero_si256();
+  int i;
+  for (i = 0; i < size; i += 2) {
+    const int16_t *const a = input + i * stride;
+    const int16_t *const b = a + stride;
+    if (size == 8) {
+      acc = _mm256_or_si256(acc, _mm256_abs_epi16(load_rows_8x2(a, b)));
+    } else {
+      int j;
+      for (j = 0; j < size; j += 16) {
+        const __m256i ra = _mm256_loadu_si256((const __m256i *)(a + j));
+        const __m256i rb = _mm256_loadu_si256((const __m256i *)(b + j));
+        acc = _mm256_or_si256(acc, _mm256_abs_epi16(ra));
+        acc = _mm256_or_si256(acc, _mm256_abs_epi16(rb));
+      }
+    }
+  }
+  return _mm256_testz_si256(acc, kMask);
+}
+
+static INLINE __m256i load_coeffs_8(const int16_t *a) {
+  return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)a));
+}
+
+static INLINE __m256i load_coeffs_4x2(const int16_t *a, const int16_t *b) {
+  const __m128i lo = _mm_loadl_epi64((const __m128i *)a);
+  const __m128i hi = _mm_loadl_epi64((const __m128i *)b);
+  return _mm256_cvtepi16_epi32(_mm_unpacklo_epi64(lo, hi));
+}
+
+// One pass of vpx_fdct4x4_c() with two rows per register. The input is
+// in[] = { [r0 | r1], [r3 | r2] } and the output is
+// out[] = { [o0 | o2], [o1 | o3] }.
+static INLINE void highbd_fdct4_avx2(const __m256i *in, __m256i *out) {
+  const __m256i k__cospi_out0_out2_a = _mm256_setr_epi32(
+      cospi_16_64, cospi_16_64, cospi_16_64, cospi_16_64, -cospi_16_64,
+      -cospi_16_64, -cospi_16_64, -cospi_16_64);
+  const __m256i k__cospi_out0_out2_b = _mm256_set1_epi32(cospi_16_64);
+  const __m256i k__cospi_out1_out3_a =
+      _mm256_setr_epi32(cospi_8_64, cospi_8_64, cospi_8_64, cospi_8_64,
+                        -cospi_8_64, -cospi_8_64, -cospi_8_64, -cospi_8_64);
+  const __m256i k__cospi_out1_out3_b = _mm256_set1_epi32(cospi_24_64);
+  // [step0 | step1] and [step3 | step2]
+  const __m256i step01 = _mm256_add_epi32(in[0], in[1]);
+  const __m256i step32 = _mm256_sub_epi32(in[0], in[1]);
+  out[0] =
+      highbd_mult_round_shift_avx2(step01, swap_halves(step01),
+                                   k__cospi_out0_out2_a, k__cospi_out0_out2_b);
+  out[1] =
+      highbd_mult_round_shift_avx2(step32, swap_halves(step32),
+                                   k__cospi_out1_out3_a, k__cospi_out1_out3_b);
+}
+
+// Transposes the 4x4 block { [o0 | o2], [o1 | o3] } to
+// { [c0 | c1], [c2 | c3] }.
+static INLINE void transpose_32bit_4x4(const __m256i *in, __m256i *out) {
+  const __m256i a0 = _mm256_unpacklo_epi32(in[0], in[1]);
+  const __m256i a1 = _mm256_unpackhi_epi32(in[0], in[1]);
+  out[0] = _mm256_permute4x64_epi64(a0, 0xd8);
+  out[1] = _mm256_permute4x64_epi64(a1, 0xd8);
+}
+
+void vpx_highbd_fdct4x4_avx2(const int16_t *input, tran_low_t *output,
+                             int stride) {
+  const __m256i kOne = _mm256_set1_epi32(1);
+  // Adds 1 to the upper left input if it is non-zero.
+  const __m256i k__nonzero_bias = _mm256_setr_epi32(1, 0, 0, 0, 0, 0, 0, 0);
+  __m256i in[2], out[2], rows[2];
+
+  in[0] = _mm256_slli_epi32(load_coeffs_4x2(input, input + stride), 4);
+  in[1] = _mm256_slli_epi32(
+      load_coeffs_4x2(input + 3 * stride, input + 2 * stride), 4);
+  in[0] = _mm256_add_epi32(
+      in[0], _mm256_andnot_si256(
+                 _mm256_cmpeq_epi32(in[0], _mm256_setzero_si256()),
+                 k__nonzero_bias));
+
+  // Transform columns
+  highbd_fdct4_avx2(in, out);
+  transpose_32bit_4x4(out, rows);
+
+  // Transform rows
+  in[0] = rows[0];
+  in[1] = swap_halves(rows[1]);
+  highbd_fdct4_avx2(in, out);
+  transpose_32bit_4x4(out, rows);
+
+  rows[0] = _mm256_srai_epi32(_mm256_add_epi32(rows[0], kOne), 2);
+  rows[1] = _mm256_srai_epi32(_mm256_add_epi32(rows[1], kOne), 2);
+  _mm256_storeu_si256((__m256i *)output, rows[0]);
+  _mm256_storeu_si256((__m256i *)(output + 8), rows[1]);
+}
+
+// One pass of vpx_fdct8x8_c() over 8 columns.
+static INLINE void highbd_fdct8_avx2(const __m256i *in, __m256i *out) {
+  __m256i s0, s1, s2, s3, s4, s5, s6, s7;
+  __m256i t2, t3;
+  __m256i x0, x1, x2, x3;
+
+  // stage 1
+  s0 = _mm256_add_epi32(in[0], in[7]);
+  s1 = _mm256_add_epi32(in[1], in[6]);
+  s2 = _mm256_add_epi32(in[2], in[5]);
+  s3 = _mm256_add_epi32(in[3], in[4]);
+  s4 = _mm256_sub_epi32(in[3], in[4]);
+  s5 = _mm256_sub_epi32(in[2], in[5]);
+  s6 = _mm256_sub_epi32(in[1], in[6]);
+  s7 = _mm256_sub_epi32(in[0], in[7]);
+
+  // fdct4(step, step);
+  x0 = _mm256_add_epi32(s0, s3);
+  x1 = _mm256_add_epi32(s1, s2);
+  x2 = _mm256_sub_epi32(s1, s2);
+  x3 = _mm256_sub_epi32(s0, s3);
+  out[0] = highbd_mult_round_shift_c(x0, x1, cospi_16_64, cospi_16_64);
+  out[4] = highbd_mult_round_shift_c(x0, x1, cospi_16_64, -cospi_16_64);
+  out[2] = highbd_mult_round_shift_c(x2, x3, cospi_24_64, cospi_8_64);
+  out[6] = highbd_mult_round_shift_c(x2, x3, -cospi_8_64, cospi_24_64);
+
+  // Stage 2
+  t2 = highbd_mult_round_shift_c(s6, s5, cospi_16_64, -cospi_16_64);
+  t3 = highbd_mult_round_shift_c(s6, s5, cospi_16_64, cospi_16_64);
+
+  // Stage 3
+  x0 = _mm256_add_epi32(s4, t2);
+  x1 = _mm256_sub_epi32(s4, t2);
+  x2 = _mm256_sub_epi32(s7, t3);
+  x3 = _mm256_add_epi32(s7, t3);
+
+  // Stage 4
+  out[1] = highbd_mult_round_shift_c(x0, x3, cospi_28_64, cospi_4_64);
+  out[3] = highbd_mult_round_shift_c(x1, x2, -cospi_20_64, cospi_12_64);
+  out[5] = highbd_mult_round_shift_c(x1, x2, cospi_12_64, cospi_20_64);
+  out[7] = highbd_mult_round_shift_c(x0, x3, -cospi_4_64, cospi_28_64);
+}
+
+void vpx_highbd_fdct8x8_avx2(const int16_t *input, tran_low_t *output,
+                             int stride) {
+  __m256i in[8], out[8];
+  int i;
+
+  if (is_8bit_residual(input, stride, 8)) {
+    vpx_fdct8x8_avx2(input, output, stride);
+    return;
+  }
+
+  for (i = 0; i < 8; ++i) {
+    in[i] = _mm256_slli_epi32(load_coeffs_8(input + i * stride), 2);
+  }
 
-#if !CONFIG_VP9_HIGHBITDEPTH
-#define FDCT32x32_2D_AVX2 vpx_fdct32x32_rd_avx2
+  // Transform columns
+  highbd_fdct8_avx2(in, out);
+  transpose_32bit_8x8_avx2(out, in);
+
+  // Transform rows
+  highbd_fdct8_avx2(in, out);
+  transpose_32bit_8x8_avx2(out, in);
+
+  for (i = 0; i < 8; ++i) {
+    // output /= 2, rounding toward zero.
+    const __m256i sign = _mm256_srai_epi32(in[i], 31);
+    in[i] = _mm256_srai_epi32(_mm256_sub_epi32(in[i], sign), 1);
+    _mm256_storeu_si256((__m256i *)(output + 8 * i), in[i]);
+  }
+}
+
+// One pass of vpx_fdct16x16_c() over 8 columns. |in_high| and |step1| are
+// the sums and differences of mirrored rows and out[i] is output row i.
+static INLINE void highbd_fdct16_avx2(const __m256i *in_high, __m256i *step1,
+                                      __m256i *out) {
+  __m256i step2[8], step3[8];
+
+  // Work on the first eight values; fdct8(input, even_results);
+  {
+    __m256i s0, s1, s2, s3, s4, s5, s6, s7;
+    __m256i t2, t3;
+    __m256i x0, x1, x2, x3;
+
+    // stage 1
+    s0 = _mm256_add_epi32(in_high[0], in_high[7]);
+    s1 = _mm256_add_epi32(in_high[1], in_high[6]);
+    s2 = _mm256_add_epi32(in_high[2], in_high[5]);
+    s3 = _mm256_add_epi32(in_high[3], in_high[4]);
+    s4 = _mm256_sub_epi32(in_high[3], in_high[4]);
+    s5 = _mm256_sub_epi32(in_high[2], in_high[5]);
+    s6 = _mm256_sub_epi32(in_high[1], in_high[6]);
+    s7 = _mm256_sub_epi32(in_high[0], in_high[7]);
+
+    // fdct4(step, step);
+    x0 = _mm256_add_epi32(s0, s3);
+    x1 = _mm256_add_epi32(s1, s2);
+    x2 = _mm256_sub_epi32(s1, s2);
+    x3 = _mm256_sub_epi32(s0, s3);
+    out[0] = highbd_mult_round_shift_c(x0, x1, cospi_16_64, cospi_16_64);
+    out[8] = highbd_mult_round_shift_c(x0, x1, cospi_16_64, -cospi_16_64);
+    out[4] = highbd_mult_round_shift_c(x2, x3, cospi_24_64, cospi_8_64);
+    out[12] = highbd_mult_round_shift_c(x2, x3, -cospi_8_64, cospi_24_64);
+
+    // Stage 2
+    t2 = highbd_mult_round_shift_c(s6, s5, cospi_16_64, -cospi_16_64);
+    t3 = highbd_mult_round_shift_c(s6, s5, cospi_16_64, cospi_16_64);
+
+    // Stage 3
+    x0 = _mm256_add_epi32(s4, t2);
+    x1 = _mm256_sub_epi32(s4, t2);
+    x2 = _mm256_sub_epi32(s7, t3);
+    x3 = _mm256_add_epi32(s7, t3);
+
+    // Stage 4
+    out[2] = highbd_mult_round_shift_c(x0, x3, cospi_28_64, cospi_4_64);
+    out[14] = highbd_mult_round_shift_c(x0, x3, -cospi_4_64, cospi_28_64);
+    out[10] = highbd_mult_round_shift_c(x1, x2, cospi_12_64, cospi_20_64);
+    out[6] = highbd_mult_round_shift_c(x1, x2, -cospi_20_64, cospi_12_64);
+  }
+  // Work on the next eight values; step1 -> odd_results
+  {
+    // step 2
+    step2[2] = highbd_mult_round_shift_c(step1[5], step1[2], cospi_16_64,
+                                         -cospi_16_64);
+    step2[3] = highbd_mult_round_shift_c(step1[4], step1[3], cospi_16_64,
+                                         -cospi_16_64);
+    step2[4] =
+        highbd_mult_round_shift_c(step1[4], step1[3], cospi_16_64, cospi_16_64);
+    step2[5] =
+        highbd_mult_round_shift_c(step1[5], step1[2], cospi_16_64, cospi_16_64);
+    // step 3
+    step3[0] = _mm256_add_epi32(step1[0], step2[3]);
+    step3[1] = _mm256_add_epi32(step1[1], step2[2]);
+    step3[2] = _mm256_sub_epi32(step1[1], step2[2]);
+    step3[3] = _mm256_sub_epi32(step1[0], step2[3]);
+    step3[4] = _mm256_sub_epi32(step1[7], step2[4]);
+    step3[5] = _mm256_sub_epi32(step1[6], step2[5]);
+    step3[6] = _mm256_add_epi32(step1[6], step2[5]);
+    step3[7] = _mm256_add_epi32(step1[7], step2[4]);
+    // step 4
+    step2[1] =
+        highbd_mult_round_shift_c(step3[1], step3[6], -cospi_8_64, cospi_24_64);
+    step2[2] =
+        highbd_mult_round_shift_c(step3[2], step3[5], cospi_24_64, cospi_8_64);
+    step2[5] =
+        highbd_mult_round_shift_c(step3[2], step3[5], cospi_8_64, -cospi_24_64);
+    step2[6] =
+        highbd_mult_round_shift_c(step3[1], step3[6], cospi_24_64, cospi_8_64);
+    // step 5
+    step1[0] = _mm256_add_epi32(step3[0], step2[1]);
+    step1[1] = _mm256_sub_epi32(step3[0], step2[1]);
+    step1[2] = _mm256_add_epi32(step3[3], step2[2]);
+    step1[3] = _mm256_sub_epi32(step3[3], step2[2]);
+    step1[4] = _mm256_sub_epi32(step3[4], step2[5]);
+    step1[5] = _mm256_add_epi32(step3[4], step2[5]);
+    step1[6] = _mm256_sub_epi32(step3[7], step2[6]);
+    step1[7] = _mm256_add_epi32(step3[7], step2[6]);
+    // step 6
+    out[1] =
+        highbd_mult_round_shift_c(step1[0], step1[7], cospi_30_64, cospi_2_64);
+    out[9] =
+        highbd_mult_round_shift_c(step1[1], step1[6], cospi_14_64, cospi_18_64);
+    out[5] =
+        highbd_mult_round_shift_c(step1[2], step1[5], cospi_22_64, cospi_10_64);
+    out[13] =
+        highbd_mult_round_shift_c(step1[3], step1[4], cospi_6_64, cospi_26_64);
+    out[3] =
+        highbd_mult_round_shift_c(step1[3], step1[4], -cospi_26_64, cospi_6_64);
+    out[11] = highbd_mult_round_shift_c(step1[2], step1[5], -cospi_10_64,
+                                        cospi_22_64);
+    out[7] = highbd_mult_round_shift_c(step1[1], step1[6], -cospi_18_64,
+                                       cospi_14_64);
+    out[15] =
+        highbd_mult_round_shift_c(step1[0], step1[7], -cospi_2_64, cospi_30_64);
+  }
+}
+
+// Runs highbd_fdct16_avx2() on the left and right halves of a 16x16 block
+// held as in transpose_32bit_16x16_avx2(). The rows are first scaled by 4 in
+// the column pass, or rounded by (x + 1) >> 2 in the row pass.
+static INLINE void highbd_fdct16x16_pass(const __m256i *in, __m256i *out,
+                                         int pass) {
+  const __m256i kOne = _mm256_set1_epi32(1);
+  __m256i rows[16], in_high[8], step1[8], res[16];
+  int i, j;
+  for (j = 0; j < 2; ++j) {
+    for (i = 0; i < 16; ++i) {
+      if (pass == 0) {
+        rows[i] = _mm256_slli_epi32(in[2 * i + j], 2);
+      } else {
+        rows[i] = _mm256_srai_epi32(_mm256_add_epi32(in[2 * i + j], kOne), 2);
+      }
+    }
+    for (i = 0; i < 8; ++i) {
+      in_high[i] = _mm256_add_epi32(rows[i], rows[15 - i]);
+      step1[i] = _mm256_sub_epi32(rows[7 - i], rows[8 + i]);
+    }
+    highbd_fdct16_avx2(in_high, step1, res);
+    for (i = 0; i < 16; ++i) out[2 * i + j] = res[i];
+  }
+}
+
+void vpx_highbd_fdct16x16_avx2(const int16_t *input, tran_low_t *output,
+                               int stride) {
+  __m256i in[32], out[32];
+  int i;
+
+  if (is_8bit_residual(input, stride, 16)) {
+    vpx_fdct16x16_avx2(input, output, stride);
+    return;
+  }
+
+  for (i = 0; i < 16; ++i) {
+    in[2 * i] = load_coeffs_8(input + i * stride);
+    in[2 * i + 1] = load_coeffs_8(input + i * stride + 8);
+  }
+
+  // Transform columns
+  highbd_fdct16x16_pass(in, out, 0);
+  transpose_32bit_16x16_avx2(out, in);
+
+  // Transform rows
+  highbd_fdct16x16_pass(in, out, 1);
+  transpose_32bit_16x16_avx2(out, in);
+
+  for (i = 0; i < 32; ++i) {
+    _mm256_storeu_si256((__m256i *)(output + 8 * i), in[i]);
+  }
+}
+
+// Returns (x + 1 + (x > 0)) >> 2 for each 32-bit lane.
+static INLINE __m256i half_round_shift_pos(__m256i x) {
+  const __m256i kOne = _mm256_set1_epi32(1);
+  const __m256i pos = _mm256_cmpgt_epi32(x, _mm256_setzero_si256());
+  return _mm256_srai_epi32(
+      _mm256_sub_epi32(_mm256_add_epi32(x, kOne), pos), 2);
+}
+
+// Returns (x + 1 + (x < 0)) >> 2 for each 32-bit lane.
+static INLINE __m256i half_round_shift_neg(__m256i x) {
+  const __m256i kOne = _mm256_set1_epi32(1);
+  const __m256i sign = _mm256_srai_epi32(x, 31);
+  return _mm256_srai_epi32(
+      _mm256_sub_epi32(_mm256_add_epi32(x, kOne), sign), 2);
+}
+
+// One pass of vpx_fdct32() over 8 columns. |round| applies the
+// half_round_shift() of vpx_fdct32x32_rd_c() after stage 2.
+static void highbd_fdct32_avx2(const __m256i *in, __m256i *out, int round) {
+  __m256i step[32];
+  int i;
+
+  // Stage 1
+  for (i = 0; i < 16; ++i) {
+    step[i] = _mm256_add_epi32(in[i], in[31 - i]);
+    step[31 - i] = _mm256_sub_epi32(in[i], in[31 - i]);
+  }
+
+  // Stage 2
+  for (i = 0; i < 8; ++i) {
+    out[i] = _mm256_add_epi32(step[i], step[15 - i]);
+    out[15 - i] = _mm256_sub_epi32(step[i], step[15 - i]);
+  }
+
+  out[16] = step[16];
+  out[17] = step[17];
+  out[18] = step[18];
+  out[19] = step[19];
+
+  out[20] = highbd_mult_round_shift_c(step[27], step[20], cospi_16_64,
+                                      -cospi_16_64);
+  out[21] = highbd_mult_round_shift_c(step[26], step[21], cospi_16_64,
+                                      -cospi_16_64);
+  out[22] = highbd_mult_round_shift_c(step[25], step[22], cospi_16_64,
+                                      -cospi_16_64);
+  out[23] = highbd_mult_round_shift_c(step[24], step[23], cospi_16_64,
+                                      -cospi_16_64);
+
+  out[24] =
+      highbd_mult_round_shift_c(step[24], step[23], cospi_16_64, cospi_16_64);
+  out[25] =
+      highbd_mult_round_shift_c(step[25], step[22], cospi_16_64, cospi_16_64);
+  out[26] =
+      highbd_mult_round_shift_c(step[26], step[21], cospi_16_64, cospi_16_64);
+  out[27] =
+      highbd_mult_round_shift_c(step[27], step[20], cospi_16_64, cospi_16_64);
+
+  out[28] = step[28];
+  out[29] = step[29];
+  out[30] = step[30];
+  out[31] = step[31];
+
+  if (round) {
+    for (i = 0; i < 32; ++i) out[i] = half_round_shift_neg(out[i]);
+  }
+
+  // Stage 3
+  step[0] = _mm256_add_epi32(out[0], out[7]);
+  step[1] = _mm256_add_epi32(out[1], out[6]);
+  step[2] = _mm256_add_epi32(out[2], out[5]);
+  step[3] = _mm256_add_epi32(out[3], out[4]);
+  step[4] = _mm256_sub_epi32(out[3], out[4]);
+  step[5] = _mm256_sub_epi32(out[2], out[5]);
+  step[6] = _mm256_sub_epi32(out[1], out[6]);
+  step[7] = _mm256_sub_epi32(out[0], out[7]);
+  step[8] = out[8];
+  step[9] = out[9];
+  step[10] =
+      highbd_mult_round_shift_c(out[13], out[10], cospi_16_64, -cospi_16_64);
+  step[11] =
+      highbd_mult_round_shift_c(out[12], out[11], cospi_16_64, -cospi_16_64);
+  step[12] =
+      highbd_mult_round_shift_c(out[12], out[11], cospi_16_64, cospi_16_64);
+  step[13] =
+      highbd_mult_round_shift_c(out[13], out[10], cospi_16_64, cospi_16_64);
+  step[14] = out[14];
+  step[15] = out[15];
+
+  step[16] = _mm256_add_epi32(out[16], out[23]);
+  step[17] = _mm256_add_epi32(out[17], out[22]);
+  step[18] = _mm256_add_epi32(out[18], out[21]);
+  step[19] = _mm256_add_epi32(out[19], out[20]);
+  step[20] = _mm256_sub_epi32(out[19], out[20]);
+  step[21] = _mm256_sub_epi32(out[18], out[21]);
+  step[22] = _mm256_sub_epi32(out[17], out[22]);
+  step[23] = _mm256_sub_epi32(out[16], out[23]);
+  step[24] = _mm256_sub_epi32(out[31], out[24]);
+  step[25] = _mm256_sub_epi32(out[30], out[25]);
+  step[26] = _mm256_sub_epi32(out[29], out[26]);
+  step[27] = _mm256_sub_epi32(out[28], out[27]);
+  step[28] = _mm256_add_epi32(out[28], out[27]);
+  step[29] = _mm256_add_epi32(out[29], out[26]);
+  step[30] = _mm256_add_epi32(out[30], out[25]);
+  step[31] = _mm256_add_epi32(out[31], out[24]);
+
+  // Stage 4
+  out[0] = _mm256_add_epi32(step[0], step[3]);
+  out[1] = _mm256_add_epi32(step[1], step[2]);
+  out[2] = _mm256_sub_epi32(step[1], step[2]);
+  out[3] = _mm256_sub_epi32(step[0], step[3]);
+  out[4] = step[4];
+  out[5] =
+      highbd_mult_round_shift_c(step[6], step[5], cospi_16_64, -cospi_16_64);
+  out[6] =
+      highbd_mult_round_shift_c(step[6], step[5], cospi_16_64, cospi_16_64);
+  out[7] = step[7];
+  out[8] = _mm256_add_epi32(step[8], step[11]);
+  out[9] = _mm256_add_epi32(step[9], step[10]);
+  out[10] = _mm256_sub_epi32(step[9], step[10]);
+  out[11] = _mm256_sub_epi32(step[8], step[11]);
+  out[12] = _mm256_sub_epi32(step[15], step[12]);
+  out[13] = _mm256_sub_epi32(step[14], step[13]);
+  out[14] = _mm256_add_epi32(step[14], step[13]);
+  out[15] = _mm256_add_epi32(step[15], step[12]);
+
+  out[16] = step[16];
+  out[17] = step[17];
+  out[18] =
+      highbd_mult_round_shift_c(step[18], step[29], -cospi_8_64, cospi_24_64);
+  out[19] =
+      highbd_mult_round_shift_c(step[19], step[28], -cospi_8_64, cospi_24_64);
+  out[20] =
+      highbd_mult_round_shift_c(step[20], step[27], -cospi_24_64, -cospi_8_64);
+  out[21] =
+      highbd_mult_round_shift_c(step[21], step[26], -cospi_24_64, -cospi_8_64);
+  out[22] = step[22];
+  out[23] = step[23];
+  out[24] = step[24];
+  out[25] = step[25];
+  out[26] =
+      highbd_mult_round_shift_c(step[26], step[21], cospi_24_64, -cospi_8_64);
+  out[27] =
+      highbd_mult_round_shift_c(step[27], step[20], cospi_24_64, -cospi_8_64);
+  out[28] =
+      highbd_mult_round_shift_c(step[28], step[19], cospi_8_64, cospi_24_64);
+  out[29] =
+      highbd_mult_round_shift_c(step[29], step[18], cospi_8_64, cospi_24_64);
+  out[30] = step[30];
+  out[31] = step[31];
+
+  // Stage 5
+  step[0] = highbd_mult_round_shift_c(out[0], out[1], cospi_16_64, cospi_16_64);
+  step[1] =
+      highbd_mult_round_shift_c(out[0], out[1], cospi_16_64, -cospi_16_64);
+  step[2] = highbd_mult_round_shift_c(out[2], out[3], cospi_24_64, cospi_8_64);
+  step[3] = highbd_mult_round_shift_c(out[3], out[2], cospi_24_64, -cospi_8_64);
+  step[4] = _mm256_add_epi32(out[4], out[5]);
+  step[5] = _mm256_sub_epi32(out[4], out[5]);
+  step[6] = _mm256_sub_epi32(out[7], out[6]);
+  step[7] = _mm256_add_epi32(out[7], out[6]);
+  step[8] = out[8];
+  step[9] =
+      highbd_mult_round_shift_c(out[9], out[14], -cospi_8_64, cospi_24_64);
+  step[10] =
+      highbd_mult_round_shift_c(out[10], out[13], -cospi_24_64, -cospi_8_64);
+  step[11] = out[11];
+  step[12] = out[12];
+  step[13] =
+      highbd_mult_round_shift_c(out[13], out[10], cospi_24_64, -cospi_8_64);
+  step[14] =
+      highbd_mult_round_shift_c(out[14], out[9], cospi_8_64, cospi_24_64);
+  step[15] = out[15];
+
+  step[16] = _mm256_add_epi32(out[16], out[19]);
+  step[17] = _mm256_add_epi32(out[17], out[18]);
+  step[18] = _mm256_sub_epi32(out[17], out[18]);
+  step[19] = _mm256_sub_epi32(out[16], out[19]);
+  step[20] = _mm256_sub_epi32(out[23], out[20]);
+  step[21] = _mm256_sub_epi32(out[22], out[21]);
+  step[22] = _mm256_add_epi32(out[22], out[21]);
+  step[23] = _mm256_add_epi32(out[23], out[20]);
+  step[24] = _mm256_add_epi32(out[24], out[27]);
+  step[25] = _mm256_add_epi32(out[25], out[26]);
+  step[26] = _mm256_sub_epi32(out[25], out[26]);
+  step[27] = _mm256_sub_epi32(out[24], out[27]);
+  step[28] = _mm256_sub_epi32(out[31], out[28]);
+  step[29] = _mm256_sub_epi32(out[30], out[29]);
+  step[30] = _mm256_add_epi32(out[30], out[29]);
+  step[31] = _mm256_add_epi32(out[31], out[28]);
+
+  // Stage 6
+  out[0] = step[0];
+  out[1] = step[1];
+  out[2] = step[2];
+  out[3] = step[3];
+  out[4] = highbd_mult_round_shift_c(step[4], step[7], cospi_28_64, cospi_4_64);
+  out[5] =
+      highbd_mult_round_shift_c(step[5], step[6], cospi_12_64, cospi_20_64);
+  out[6] =
+      highbd_mult_round_shift_c(step[6], step[5], cospi_12_64, -cospi_20_64);
+  out[7] =
+      highbd_mult_round_shift_c(step[7], step[4], cospi_28_64, -cospi_4_64);
+  out[8] = _mm256_add_epi32(step[8], step[9]);
+  out[9] = _mm256_sub_epi32(step[8], step[9]);
+  out[10] = _mm256_sub_epi32(step[11], step[10]);
+  out[11] = _mm256_add_epi32(step[11], step[10]);
+  out[12] = _mm256_add_epi32(step[12], step[13]);
+  out[13] = _mm256_sub_epi32(step[12], step[13]);
+  out[14] = _mm256_sub_epi32(step[15], step[14]);
+  out[15] = _mm256_add_epi32(step[15], step[14]);
+
+  out[16] = step[16];
+  out[17] =
+      highbd_mult_round_shift_c(step[17], step[30], -cospi_4_64, cospi_28_64);
+  out[18] =
+      highbd_mult_round_shift_c(step[18], step[29], -cospi_28_64, -cospi_4_64);
+  out[19] = step[19];
+  out[20] = step[20];
+  out[21] =
+      highbd_mult_round_shift_c(step[21], step[26], -cospi_20_64, cospi_12_64);
+  out[22] =
+      highbd_mult_round_shift_c(step[22], step[25], -cospi_12_64, -cospi_20_64);
+  out[23] = step[23];
+  out[24] = step[24];
+  out[25] =
+      highbd_mult_round_shift_c(step[25], step[22], cospi_12_64, -cospi_20_64);
+  out[26] =
+      highbd_mult_round_shift_c(step[26], step[21], cospi_20_64, cospi_12_64);
+  out[27] = step[27];
+  out[28] = step[28];
+  out[29] =
+      highbd_mult_round_shift_c(step[29], step[18], cospi_28_64, -cospi_4_64);
+  out[30] =
+      highbd_mult_round_shift_c(step[30], step[17], cospi_4_64, cospi_28_64);
+  out[31] = step[31];
+
+  // Stage 7
+  step[0] = out[0];
+  step[1] = out[1];
+  step[2] = out[2];
+  step[3] = out[3];
+  step[4] = out[4];
+  step[5] = out[5];
+  step[6] = out[6];
+  step[7] = out[7];
+  step[8] = highbd_mult_round_shift_c(out[8], out[15], cospi_30_64, cospi_2_64);
+  step[9] =
+      highbd_mult_round_shift_c(out[9], out[14], cospi_14_64, cospi_18_64);
+  step[10] =
+      highbd_mult_round_shift_c(out[10], out[13], cospi_22_64, cospi_10_64);
+  step[11] =
+      highbd_mult_round_shift_c(out[11], out[12], cospi_6_64, cospi_26_64);
+  step[12] =
+      highbd_mult_round_shift_c(out[12], out[11], cospi_6_64, -cospi_26_64);
+  step[13] =
+      highbd_mult_round_shift_c(out[13], out[10], cospi_22_64, -cospi_10_64);
+  step[14] =
+      highbd_mult_round_shift_c(out[14], out[9], cospi_14_64, -cospi_18_64);
+  step[15] =
+      highbd_mult_round_shift_c(out[15], out[8], cospi_30_64, -cospi_2_64);
+
+  step[16] = _mm256_add_epi32(out[16], out[17]);
+  step[17] = _mm256_sub_epi32(out[16], out[17]);
+  step[18] = _mm256_sub_epi32(out[19], out[18]);
+  step[19] = _mm256_add_epi32(out[19], out[18]);
+  step[20] = _mm256_add_epi32(out[20], out[21]);
+  step[21] = _mm256_sub_epi32(out[20], out[21]);
+  step[22] = _mm256_sub_epi32(out[23], out[22]);
+  step[23] = _mm256_add_epi32(out[23], out[22]);
+  step[24] = _mm256_add_epi32(out[24], out[25]);
+  step[25] = _mm256_sub_epi32(out[24], out[25]);
+  step[26] = _mm256_sub_epi32(out[27], out[26]);
+  step[27] = _mm256_add_epi32(out[27], out[26]);
+  step[28] = _mm256_add_epi32(out[28], out[29]);
+  step[29] = _mm256_sub_epi32(out[28], out[29]);
+  step[30] = _mm256_sub_epi32(out[31], out[30]);
+  step[31] = _mm256_add_epi32(out[31], out[30]);
+
+  // Final stage --- outputs indices are bit-reversed.
+  out[0] = step[0];
+  out[16] = step[1];
+  out[8] = step[2];
+  out[24] = step[3];
+  out[4] = step[4];
+  out[20] = step[5];
+  out[12] = step[6];
+  out[28] = step[7];
+  out[2] = step[8];
+  out[18] = step[9];
+  out[10] = step[10];
+  out[26] = step[11];
+  out[6] = step[12];
+  out[22] = step[13];
+  out[14] = step[14];
+  out[30] = step[15];
+
+  out[1] =
+      highbd_mult_round_shift_c(step[16], step[31], cospi_31_64, cospi_1_64);
+  out[17] =
+      highbd_mult_round_shift_c(step[17], step[30], cospi_15_64, cospi_17_64);
+  out[9] =
+      highbd_mult_round_shift_c(step[18], step[29], cospi_23_64, cospi_9_64);
+  out[25] =
+      highbd_mult_round_shift_c(step[19], step[28], cospi_7_64, cospi_25_64);
+  out[5] =
+      highbd_mult_round_shift_c(step[20], step[27], cospi_27_64, cospi_5_64);
+  out[21] =
+      highbd_mult_round_shift_c(step[21], step[26], cospi_11_64, cospi_21_64);
+  out[13] =
+      highbd_mult_round_shift_c(step[22], step[25], cospi_19_64, cospi_13_64);
+  out[29] =
+      highbd_mult_round_shift_c(step[23], step[24], cospi_3_64, cospi_29_64);
+  out[3] =
+      highbd_mult_round_shift_c(step[24], step[23], cospi_3_64, -cospi_29_64);
+  out[19] =
+      highbd_mult_round_shift_c(step[25], step[22], cospi_19_64, -cospi_13_64);
+  out[11] =
+      highbd_mult_round_shift_c(step[26], step[21], cospi_11_64, -cospi_21_64);
+  out[27] =
+      highbd_mult_round_shift_c(step[27], step[20], cospi_27_64, -cospi_5_64);
+  out[7] =
+      highbd_mult_round_shift_c(step[28], step[19], cospi_7_64, -cospi_25_64);
+  out[23] =
+      highbd_mult_round_shift_c(step[29], step[18], cospi_23_64, -cospi_9_64);
+  out[15] =
+      highbd_mult_round_shift_c(step[30], step[17], cospi_15_64, -cospi_17_64);
+  out[31] =
+      highbd_mult_round_shift_c(step[31], step[16], cospi_31_64, -cospi_1_64);
+
+}
+
+// vpx_fdct32x32_c(), or vpx_fdct32x32_rd_c() when |rd| is set, in 32 bits.
+// buf[32 * i + j] holds row j of the 8 columns 8 * i to 8 * i + 7.
+static void highbd_fdct32x32(const int16_t *input, tran_low_t *output,
+                             int stride, int rd) {
+  __m256i buf[4 * 32], rows[4 * 32], in[32], out[32];
+  int i, j;
+
+  // Transform columns
+  for (i = 0; i < 4; ++i) {
+    for (j = 0; j < 32; ++j) {
+      in[j] = _mm256_slli_epi32(load_coeffs_8(input + j * stride + 8 * i), 2);
+    }
+    highbd_fdct32_avx2(in, out, 0);
+    for (j = 0; j < 32; ++j) buf[32 * i + j] = half_round_shift_pos(out[j]);
+  }
+  for (i = 0; i < 4; ++i) {
+    for (j = 0; j < 4; ++j) {
+      transpose_32bit_8x8_avx2(&buf[32 * j + 8 * i], &rows[32 * i + 8 * j]);
+    }
+  }
+
+  // Transform rows
+  for (i = 0; i < 4; ++i) {
+    highbd_fdct32_avx2(&rows[32 * i], out, rd);
+    for (j = 0; j < 32; ++j) {
+      buf[32 * i + j] = rd ? out[j] : half_round_shift_neg(out[j]);
+    }
+  }
+  for (i = 0; i < 4; ++i) {
+    for (j = 0; j < 4; ++j) {
+      int k;
+      transpose_32bit_8x8_avx2(&buf[32 * i + 8 * j], out);
+      for (k = 0; k < 8; ++k) {
+        _mm256_storeu_si256((__m256i *)(output + (8 * i + k) * 32 + 8 * j),
+                            out[k]);
+      }
+    }
+  }
+}
+
+void vpx_highbd_fdct32x32_avx2(const int16_t *input, tran_low_t *output,
+                               int stride) {
+  if (is_8bit_residual(input, stride, 32)) {
+    vpx_fdct32x32_avx2(input, output, stride);
+    return;
+  }
+  highbd_fdct32x32(input, output, stride, 0);
+}
+
+void vpx_highbd_fdct32x32_rd_avx2(const int16_t *input, tran_low_t *output,
+                                  int stride) {
+  if (is_8bit_residual(input, stride, 32)) {
+    vpx_fdct32x32_rd_avx2(input, output, stride);
+    return;
+  }
+  highbd_fdct32x32(input, output, stride, 1);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The kernels in fwd_dct32x32_impl_avx2.h write 16-bit coefficients. High bit
+// depth builds keep them internal and widen their output.
+static void fdct32x32_rd_16bit_avx2(const int16_t *input, int16_t *output_org,
+                                    int stride);
+static void fdct32x32_16bit_avx2(const int16_t *input, int16_t *output_org,
+                                 int stride);
+#define FDCT32x32_RD_AVX2 fdct32x32_rd_16bit_avx2
+#define FDCT32x32_AVX2 fdct32x32_16bit_avx2
+#else
+#define FDCT32x32_RD_AVX2 vpx_fdct32x32_rd_avx2
+#define FDCT32x32_AVX2 vpx_fdct32x32_avx2
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+#define FDCT32x32_2D_AVX2 FDCT32x32_RD_AVX2
 #define FDCT32x32_HIGH_PRECISION 0
 #include "vpx_dsp/x86/fwd_dct32x32_impl_avx2.h"
 #undef FDCT32x32_2D_AVX2
 #undef FDCT32x32_HIGH_PRECISION
 
-#define FDCT32x32_2D_AVX2 vpx_fdct32x32_avx2
+#define FDCT32x32_2D_AVX2 FDCT32x32_AVX2
 #define FDCT32x32_HIGH_PRECISION 1
 #include "vpx_dsp/x86/fwd_dct32x32_impl_avx2.h"  // NOLINT
 #undef FDCT32x32_2D_AVX2
 #undef FDCT32x32_HIGH_PRECISION
-#endif  // !CONFIG_VP9_HIGHBITDEPTH
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static INLINE void store_coeffs_32x32(const int16_t *in, tran_low_t *output) {
+  int i;
+  for (i = 0; i < 32 * 32; i += 16) {
+    store_coeffs_16(_mm256_load_si256((const __m256i *)(in + i)), output + i);
+  }
+}
+
+void vpx_fdct32x32_rd_avx2(const int16_t *input, tran_low_t *output,
+                           int stride) {
+  DECLARE_ALIGNED(32, int16_t, out[32 * 32]);
+  fdct32x32_rd_16bit_avx2(input, out, stride);
+  store_coeffs_32x32(out, output);
+}
+
+void vpx_fdct32x32_avx2(const int16_t *input, tran_low_t *output, int stride) {
+  DECLARE_ALIGNED(32, int16_t, out[32 * 32]);
+  fdct32x32_16bit_avx2(input, out, stride);
+  store_coeffs_32x32(out, output);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
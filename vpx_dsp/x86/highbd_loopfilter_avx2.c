@@ -0,0 +1,950 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_ports/mem.h"
+
+// The functions in this file are 16 pixel wide versions of the ones in
+// highbd_loopfilter_sse2.c: each row of 16 uint16_t fills a 256-bit register.
+
+// Loads the limits of the two 8 pixel halves of a dual filter, widened to 16
+// bits and scaled to the bit depth.
+static INLINE __m256i highbd_load_dual_limit(const uint8_t *limit0,
+                                             const uint8_t *limit1, int bd) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i l0 =
+      _mm_unpacklo_epi8(_mm_load_si128((const __m128i *)limit0), zero);
+  const __m128i l1 =
+      _mm_unpacklo_epi8(_mm_load_si128((const __m128i *)limit1), zero);
+  const __m256i l = _mm256_inserti128_si256(_mm256_castsi128_si256(l0), l1, 1);
+  return _mm256_sll_epi16(l, _mm_cvtsi32_si128(bd - 8));
+}
+
+static INLINE __m256i signed_char_clamp_bd_avx2(__m256i value, int bd) {
+  const int16_t t80 = (int16_t)(0x80 << (bd - 8));
+  const __m256i max = _mm256_set1_epi16(t80 - 1);
+  const __m256i min = _mm256_set1_epi16(-t80);
+  return _mm256_max_epi16(_mm256_min_epi16(value, max), min);
+}
+
+void vpx_highbd_lpf_horizontal_16_dual_avx2(uint16_t *s, int pitch,
+                                            const uint8_t *blimit,
+                                            const uint8_t *limit,
+                                            const uint8_t *thresh, int bd) {
+  const __m256i zero = _mm256_set1_epi16(0);
+  const __m256i one = _mm256_set1_epi16(1);
+  const __m256i blimit_v = highbd_load_dual_limit(blimit, blimit, bd);
+  const __m256i limit_v = highbd_load_dual_limit(limit, limit, bd);
+  const __m256i thresh_v = highbd_load_dual_limit(thresh, thresh, bd);
+  __m256i q7, p7, q6, p6, q5, p5, q4, p4, q3, p3, q2, p2, q1, p1, q0, p0;
+  __m256i mask, hev, flat, flat2, abs_p1p0, abs_q1q0;
+  __m256i ps1, qs1, ps0, qs0;
+  __m256i abs_p0q0, abs_p1q1, ffff, work;
+  __m256i filt, work_a, filter1, filter2;
+  __m256i flat2_q6, flat2_p6, flat2_q5, flat2_p5, flat2_q4, flat2_p4;
+  __m256i flat2_q3, flat2_p3, flat2_q2, flat2_p2, flat2_q1, flat2_p1;
+  __m256i flat2_q0, flat2_p0;
+  __m256i flat_q2, flat_p2, flat_q1, flat_p1, flat_q0, flat_p0;
+  __m256i pixelFilter_p, pixelFilter_q;
+  __m256i pixetFilter_p2p1p0, pixetFilter_q2q1q0;
+  __m256i sum_p7, sum_q7, sum_p3, sum_q3;
+  __m256i t4, t3, t80, t1;
+  __m256i eight, four;
+
+
+  q4 = _mm256_loadu_si256((__m256i *)(s + 4 * pitch));
+  p4 = _mm256_loadu_si256((__m256i *)(s - 5 * pitch));
+  q3 = _mm256_loadu_si256((__m256i *)(s + 3 * pitch));
+  p3 = _mm256_loadu_si256((__m256i *)(s - 4 * pitch));
+  q2 = _mm256_loadu_si256((__m256i *)(s + 2 * pitch));
+  p2 = _mm256_loadu_si256((__m256i *)(s - 3 * pitch));
+  q1 = _mm256_loadu_si256((__m256i *)(s + 1 * pitch));
+  p1 = _mm256_loadu_si256((__m256i *)(s - 2 * pitch));
+  q0 = _mm256_loadu_si256((__m256i *)(s + 0 * pitch));
+  p0 = _mm256_loadu_si256((__m256i *)(s - 1 * pitch));
+
+  //  highbd_filter_mask
+  abs_p1p0 =
+      _mm256_or_si256(_mm256_subs_epu16(p1, p0), _mm256_subs_epu16(p0, p1));
+  abs_q1q0 =
+      _mm256_or_si256(_mm256_subs_epu16(q1, q0), _mm256_subs_epu16(q0, q1));
+
+  ffff = _mm256_cmpeq_epi16(abs_p1p0, abs_p1p0);
+
+  abs_p0q0 =
+      _mm256_or_si256(_mm256_subs_epu16(p0, q0), _mm256_subs_epu16(q0, p0));
+  abs_p1q1 =
+      _mm256_or_si256(_mm256_subs_epu16(p1, q1), _mm256_subs_epu16(q1, p1));
+
+  //  highbd_hev_mask (in C code this is actually called from highbd_filter4)
+  flat = _mm256_max_epi16(abs_p1p0, abs_q1q0);
+  hev = _mm256_subs_epu16(flat, thresh_v);
+  hev = _mm256_xor_si256(_mm256_cmpeq_epi16(hev, zero), ffff);
+
+  abs_p0q0 = _mm256_adds_epu16(abs_p0q0, abs_p0q0);  // abs(p0 - q0) * 2
+  abs_p1q1 = _mm256_srli_epi16(abs_p1q1, 1);         // abs(p1 - q1) / 2
+  mask = _mm256_subs_epu16(_mm256_adds_epu16(abs_p0q0, abs_p1q1), blimit_v);
+  mask = _mm256_xor_si256(_mm256_cmpeq_epi16(mask, zero), ffff);
+  mask = _mm256_and_si256(mask, _mm256_adds_epu16(limit_v, one));
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p1, p0), _mm256_subs_epu16(p0, p1)),
+      _mm256_or_si256(_mm256_subs_epu16(q1, q0), _mm256_subs_epu16(q0, q1)));
+  mask = _mm256_max_epi16(work, mask);
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p2, p1), _mm256_subs_epu16(p1, p2)),
+      _mm256_or_si256(_mm256_subs_epu16(q2, q1), _mm256_subs_epu16(q1, q2)));
+  mask = _mm256_max_epi16(work, mask);
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p3, p2), _mm256_subs_epu16(p2, p3)),
+      _mm256_or_si256(_mm256_subs_epu16(q3, q2), _mm256_subs_epu16(q2, q3)));
+  mask = _mm256_max_epi16(work, mask);
+
+  mask = _mm256_subs_epu16(mask, limit_v);
+  mask = _mm256_cmpeq_epi16(mask, zero);  // return ~mask
+
+  // lp filter
+  // highbd_filter4
+  t4 = _mm256_set1_epi16(4);
+  t3 = _mm256_set1_epi16(3);
+  if (bd == 8)
+    t80 = _mm256_set1_epi16(0x80);
+  else if (bd == 10)
+    t80 = _mm256_set1_epi16(0x200);
+  else  // bd == 12
+    t80 = _mm256_set1_epi16(0x800);
+
+  t1 = _mm256_set1_epi16(0x1);
+
+  ps1 = _mm256_subs_epi16(p1, t80);
+  qs1 = _mm256_subs_epi16(q1, t80);
+  ps0 = _mm256_subs_epi16(p0, t80);
+  qs0 = _mm256_subs_epi16(q0, t80);
+
+  filt = _mm256_and_si256(
+      signed_char_clamp_bd_avx2(_mm256_subs_epi16(ps1, qs1), bd), hev);
+  work_a = _mm256_subs_epi16(qs0, ps0);
+  filt = _mm256_adds_epi16(filt, work_a);
+  filt = _mm256_adds_epi16(filt, work_a);
+  filt = signed_char_clamp_bd_avx2(_mm256_adds_epi16(filt, work_a), bd);
+  filt = _mm256_and_si256(filt, mask);
+  filter1 = signed_char_clamp_bd_avx2(_mm256_adds_epi16(filt, t4), bd);
+  filter2 = signed_char_clamp_bd_avx2(_mm256_adds_epi16(filt, t3), bd);
+
+  // Filter1 >> 3
+  filter1 = _mm256_srai_epi16(filter1, 0x3);
+  filter2 = _mm256_srai_epi16(filter2, 0x3);
+
+  qs0 = _mm256_adds_epi16(
+      signed_char_clamp_bd_avx2(_mm256_subs_epi16(qs0, filter1), bd), t80);
+  ps0 = _mm256_adds_epi16(
+      signed_char_clamp_bd_avx2(_mm256_adds_epi16(ps0, filter2), bd), t80);
+  filt = _mm256_adds_epi16(filter1, t1);
+  filt = _mm256_srai_epi16(filt, 1);
+  filt = _mm256_andnot_si256(hev, filt);
+  qs1 = _mm256_adds_epi16(
+      signed_char_clamp_bd_avx2(_mm256_subs_epi16(qs1, filt), bd), t80);
+  ps1 = _mm256_adds_epi16(
+      signed_char_clamp_bd_avx2(_mm256_adds_epi16(ps1, filt), bd), t80);
+
+  // end highbd_filter4
+  // loopfilter done
+
+  // highbd_flat_mask4
+  flat = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p2, p0), _mm256_subs_epu16(p0, p2)),
+      _mm256_or_si256(_mm256_subs_epu16(p3, p0), _mm256_subs_epu16(p0, p3)));
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(q2, q0), _mm256_subs_epu16(q0, q2)),
+      _mm256_or_si256(_mm256_subs_epu16(q3, q0), _mm256_subs_epu16(q0, q3)));
+  flat = _mm256_max_epi16(work, flat);
+  work = _mm256_max_epi16(abs_p1p0, abs_q1q0);
+  flat = _mm256_max_epi16(work, flat);
+
+  if (bd == 8)
+    flat = _mm256_subs_epu16(flat, one);
+  else if (bd == 10)
+    flat = _mm256_subs_epu16(flat, _mm256_slli_epi16(one, 2));
+  else  // bd == 12
+    flat = _mm256_subs_epu16(flat, _mm256_slli_epi16(one, 4));
+
+  flat = _mm256_cmpeq_epi16(flat, zero);
+  // end flat_mask4
+
+  // flat & mask = flat && mask (as used in filter8)
+  // (because, in both vars, each block of 16 either all 1s or all 0s)
+  flat = _mm256_and_si256(flat, mask);
+
+  p5 = _mm256_loadu_si256((__m256i *)(s - 6 * pitch));
+  q5 = _mm256_loadu_si256((__m256i *)(s + 5 * pitch));
+  p6 = _mm256_loadu_si256((__m256i *)(s - 7 * pitch));
+  q6 = _mm256_loadu_si256((__m256i *)(s + 6 * pitch));
+  p7 = _mm256_loadu_si256((__m256i *)(s - 8 * pitch));
+  q7 = _mm256_loadu_si256((__m256i *)(s + 7 * pitch));
+
+  // highbd_flat_mask5 (arguments passed in are p0, q0, p4-p7, q4-q7
+  // but referred to as p0-p4 & q0-q4 in fn)
+  flat2 = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p4, p0), _mm256_subs_epu16(p0, p4)),
+      _mm256_or_si256(_mm256_subs_epu16(q4, q0), _mm256_subs_epu16(q0, q4)));
+
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p5, p0), _mm256_subs_epu16(p0, p5)),
+      _mm256_or_si256(_mm256_subs_epu16(q5, q0), _mm256_subs_epu16(q0, q5)));
+  flat2 = _mm256_max_epi16(work, flat2);
+
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p6, p0), _mm256_subs_epu16(p0, p6)),
+      _mm256_or_si256(_mm256_subs_epu16(q6, q0), _mm256_subs_epu16(q0, q6)));
+  flat2 = _mm256_max_epi16(work, flat2);
+
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p7, p0), _mm256_subs_epu16(p0, p7)),
+      _mm256_or_si256(_mm256_subs_epu16(q7, q0), _mm256_subs_epu16(q0, q7)));
+  flat2 = _mm256_max_epi16(work, flat2);
+
+  if (bd == 8)
+    flat2 = _mm256_subs_epu16(flat2, one);
+  else if (bd == 10)
+    flat2 = _mm256_subs_epu16(flat2, _mm256_slli_epi16(one, 2));
+  else  // bd == 12
+    flat2 = _mm256_subs_epu16(flat2, _mm256_slli_epi16(one, 4));
+
+  flat2 = _mm256_cmpeq_epi16(flat2, zero);
+  flat2 = _mm256_and_si256(flat2, flat);  // flat2 & flat & mask
+  // end highbd_flat_mask5
+
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // flat and wide flat calculations
+  eight = _mm256_set1_epi16(8);
+  four = _mm256_set1_epi16(4);
+
+  pixelFilter_p =
+      _mm256_add_epi16(_mm256_add_epi16(p6, p5), _mm256_add_epi16(p4, p3));
+  pixelFilter_q =
+      _mm256_add_epi16(_mm256_add_epi16(q6, q5), _mm256_add_epi16(q4, q3));
+
+  pixetFilter_p2p1p0 = _mm256_add_epi16(p0, _mm256_add_epi16(p2, p1));
+  pixelFilter_p = _mm256_add_epi16(pixelFilter_p, pixetFilter_p2p1p0);
+
+  pixetFilter_q2q1q0 = _mm256_add_epi16(q0, _mm256_add_epi16(q2, q1));
+  pixelFilter_q = _mm256_add_epi16(pixelFilter_q, pixetFilter_q2q1q0);
+  pixelFilter_p =
+      _mm256_add_epi16(eight, _mm256_add_epi16(pixelFilter_p, pixelFilter_q));
+  pixetFilter_p2p1p0 = _mm256_add_epi16(
+      four, _mm256_add_epi16(pixetFilter_p2p1p0, pixetFilter_q2q1q0));
+  flat2_p0 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_p, _mm256_add_epi16(p7, p0)), 4);
+  flat2_q0 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_p, _mm256_add_epi16(q7, q0)), 4);
+  flat_p0 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixetFilter_p2p1p0, _mm256_add_epi16(p3, p0)), 3);
+  flat_q0 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixetFilter_p2p1p0, _mm256_add_epi16(q3, q0)), 3);
+
+  sum_p7 = _mm256_add_epi16(p7, p7);
+  sum_q7 = _mm256_add_epi16(q7, q7);
+  sum_p3 = _mm256_add_epi16(p3, p3);
+  sum_q3 = _mm256_add_epi16(q3, q3);
+
+  pixelFilter_q = _mm256_sub_epi16(pixelFilter_p, p6);
+  pixelFilter_p = _mm256_sub_epi16(pixelFilter_p, q6);
+  flat2_p1 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_p, _mm256_add_epi16(sum_p7, p1)), 4);
+  flat2_q1 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_q, _mm256_add_epi16(sum_q7, q1)), 4);
+
+  pixetFilter_q2q1q0 = _mm256_sub_epi16(pixetFilter_p2p1p0, p2);
+  pixetFilter_p2p1p0 = _mm256_sub_epi16(pixetFilter_p2p1p0, q2);
+  flat_p1 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixetFilter_p2p1p0, _mm256_add_epi16(sum_p3, p1)), 3);
+  flat_q1 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixetFilter_q2q1q0, _mm256_add_epi16(sum_q3, q1)), 3);
+
+  sum_p7 = _mm256_add_epi16(sum_p7, p7);
+  sum_q7 = _mm256_add_epi16(sum_q7, q7);
+  sum_p3 = _mm256_add_epi16(sum_p3, p3);
+  sum_q3 = _mm256_add_epi16(sum_q3, q3);
+
+  pixelFilter_p = _mm256_sub_epi16(pixelFilter_p, q5);
+  pixelFilter_q = _mm256_sub_epi16(pixelFilter_q, p5);
+  flat2_p2 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_p, _mm256_add_epi16(sum_p7, p2)), 4);
+  flat2_q2 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_q, _mm256_add_epi16(sum_q7, q2)), 4);
+
+  pixetFilter_p2p1p0 = _mm256_sub_epi16(pixetFilter_p2p1p0, q1);
+  pixetFilter_q2q1q0 = _mm256_sub_epi16(pixetFilter_q2q1q0, p1);
+  flat_p2 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixetFilter_p2p1p0, _mm256_add_epi16(sum_p3, p2)), 3);
+  flat_q2 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixetFilter_q2q1q0, _mm256_add_epi16(sum_q3, q2)), 3);
+
+  sum_p7 = _mm256_add_epi16(sum_p7, p7);
+  sum_q7 = _mm256_add_epi16(sum_q7, q7);
+  pixelFilter_p = _mm256_sub_epi16(pixelFilter_p, q4);
+  pixelFilter_q = _mm256_sub_epi16(pixelFilter_q, p4);
+  flat2_p3 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_p, _mm256_add_epi16(sum_p7, p3)), 4);
+  flat2_q3 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_q, _mm256_add_epi16(sum_q7, q3)), 4);
+
+  sum_p7 = _mm256_add_epi16(sum_p7, p7);
+  sum_q7 = _mm256_add_epi16(sum_q7, q7);
+  pixelFilter_p = _mm256_sub_epi16(pixelFilter_p, q3);
+  pixelFilter_q = _mm256_sub_epi16(pixelFilter_q, p3);
+  flat2_p4 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_p, _mm256_add_epi16(sum_p7, p4)), 4);
+  flat2_q4 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_q, _mm256_add_epi16(sum_q7, q4)), 4);
+
+  sum_p7 = _mm256_add_epi16(sum_p7, p7);
+  sum_q7 = _mm256_add_epi16(sum_q7, q7);
+  pixelFilter_p = _mm256_sub_epi16(pixelFilter_p, q2);
+  pixelFilter_q = _mm256_sub_epi16(pixelFilter_q, p2);
+  flat2_p5 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_p, _mm256_add_epi16(sum_p7, p5)), 4);
+  flat2_q5 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_q, _mm256_add_epi16(sum_q7, q5)), 4);
+
+  sum_p7 = _mm256_add_epi16(sum_p7, p7);
+  sum_q7 = _mm256_add_epi16(sum_q7, q7);
+  pixelFilter_p = _mm256_sub_epi16(pixelFilter_p, q1);
+  pixelFilter_q = _mm256_sub_epi16(pixelFilter_q, p1);
+  flat2_p6 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_p, _mm256_add_epi16(sum_p7, p6)), 4);
+  flat2_q6 = _mm256_srli_epi16(
+      _mm256_add_epi16(pixelFilter_q, _mm256_add_epi16(sum_q7, q6)), 4);
+
+  //  wide flat
+  //  ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+  //  highbd_filter8
+  p2 = _mm256_andnot_si256(flat, p2);
+  //  p2 remains unchanged if !(flat && mask)
+  flat_p2 = _mm256_and_si256(flat, flat_p2);
+  //  when (flat && mask)
+  p2 = _mm256_or_si256(p2, flat_p2);  // full list of p2 values
+  q2 = _mm256_andnot_si256(flat, q2);
+  flat_q2 = _mm256_and_si256(flat, flat_q2);
+  q2 = _mm256_or_si256(q2, flat_q2);  // full list of q2 values
+
+  ps1 = _mm256_andnot_si256(flat, ps1);
+  //  p1 takes the value assigned to in in filter4 if !(flat && mask)
+  flat_p1 = _mm256_and_si256(flat, flat_p1);
+  //  when (flat && mask)
+  p1 = _mm256_or_si256(ps1, flat_p1);  // full list of p1 values
+  qs1 = _mm256_andnot_si256(flat, qs1);
+  flat_q1 = _mm256_and_si256(flat, flat_q1);
+  q1 = _mm256_or_si256(qs1, flat_q1);  // full list of q1 values
+
+  ps0 = _mm256_andnot_si256(flat, ps0);
+  //  p0 takes the value assigned to in in filter4 if !(flat && mask)
+  flat_p0 = _mm256_and_si256(flat, flat_p0);
+  //  when (flat && mask)
+  p0 = _mm256_or_si256(ps0, flat_p0);  // full list of p0 values
+  qs0 = _mm256_andnot_si256(flat, qs0);
+  flat_q0 = _mm256_and_si256(flat, flat_q0);
+  q0 = _mm256_or_si256(qs0, flat_q0);  // full list of q0 values
+  // end highbd_filter8
+
+  // highbd_filter16
+  p6 = _mm256_andnot_si256(flat2, p6);
+  //  p6 remains unchanged if !(flat2 && flat && mask)
+  flat2_p6 = _mm256_and_si256(flat2, flat2_p6);
+  //  get values for when (flat2 && flat && mask)
+  p6 = _mm256_or_si256(p6, flat2_p6);  // full list of p6 values
+  q6 = _mm256_andnot_si256(flat2, q6);
+  //  q6 remains unchanged if !(flat2 && flat && mask)
+  flat2_q6 = _mm256_and_si256(flat2, flat2_q6);
+  //  get values for when (flat2 && flat && mask)
+  q6 = _mm256_or_si256(q6, flat2_q6);  // full list of q6 values
+  _mm256_storeu_si256((__m256i *)(s - 7 * pitch), p6);
+  _mm256_storeu_si256((__m256i *)(s + 6 * pitch), q6);
+
+  p5 = _mm256_andnot_si256(flat2, p5);
+  //  p5 remains unchanged if !(flat2 && flat && mask)
+  flat2_p5 = _mm256_and_si256(flat2, flat2_p5);
+  //  get values for when (flat2 && flat && mask)
+  p5 = _mm256_or_si256(p5, flat2_p5);
+  //  full list of p5 values
+  q5 = _mm256_andnot_si256(flat2, q5);
+  //  q5 remains unchanged if !(flat2 && flat && mask)
+  flat2_q5 = _mm256_and_si256(flat2, flat2_q5);
+  //  get values for when (flat2 && flat && mask)
+  q5 = _mm256_or_si256(q5, flat2_q5);
+  //  full list of q5 values
+  _mm256_storeu_si256((__m256i *)(s - 6 * pitch), p5);
+  _mm256_storeu_si256((__m256i *)(s + 5 * pitch), q5);
+
+  p4 = _mm256_andnot_si256(flat2, p4);
+  //  p4 remains unchanged if !(flat2 && flat && mask)
+  flat2_p4 = _mm256_and_si256(flat2, flat2_p4);
+  //  get values for when (flat2 && flat && mask)
+  p4 = _mm256_or_si256(p4, flat2_p4);  // full list of p4 values
+  q4 = _mm256_andnot_si256(flat2, q4);
+  //  q4 remains unchanged if !(flat2 && flat && mask)
+  flat2_q4 = _mm256_and_si256(flat2, flat2_q4);
+  //  get values for when (flat2 && flat && mask)
+  q4 = _mm256_or_si256(q4, flat2_q4);  // full list of q4 values
+  _mm256_storeu_si256((__m256i *)(s - 5 * pitch), p4);
+  _mm256_storeu_si256((__m256i *)(s + 4 * pitch), q4);
+
+  p3 = _mm256_andnot_si256(flat2, p3);
+  //  p3 takes value from highbd_filter8 if !(flat2 && flat && mask)
+  flat2_p3 = _mm256_and_si256(flat2, flat2_p3);
+  //  get values for when (flat2 && flat && mask)
+  p3 = _mm256_or_si256(p3, flat2_p3);  // full list of p3 values
+  q3 = _mm256_andnot_si256(flat2, q3);
+  //  q3 takes value from highbd_filter8 if !(flat2 && flat && mask)
+  flat2_q3 = _mm256_and_si256(flat2, flat2_q3);
+  //  get values for when (flat2 && flat && mask)
+  q3 = _mm256_or_si256(q3, flat2_q3);  // full list of q3 values
+  _mm256_storeu_si256((__m256i *)(s - 4 * pitch), p3);
+  _mm256_storeu_si256((__m256i *)(s + 3 * pitch), q3);
+
+  p2 = _mm256_andnot_si256(flat2, p2);
+  //  p2 takes value from highbd_filter8 if !(flat2 && flat && mask)
+  flat2_p2 = _mm256_and_si256(flat2, flat2_p2);
+  //  get values for when (flat2 && flat && mask)
+  p2 = _mm256_or_si256(p2, flat2_p2);
+  //  full list of p2 values
+  q2 = _mm256_andnot_si256(flat2, q2);
+  //  q2 takes value from highbd_filter8 if !(flat2 && flat && mask)
+  flat2_q2 = _mm256_and_si256(flat2, flat2_q2);
+  //  get values for when (flat2 && flat && mask)
+  q2 = _mm256_or_si256(q2, flat2_q2);  // full list of q2 values
+  _mm256_storeu_si256((__m256i *)(s - 3 * pitch), p2);
+  _mm256_storeu_si256((__m256i *)(s + 2 * pitch), q2);
+
+  p1 = _mm256_andnot_si256(flat2, p1);
+  //  p1 takes value from highbd_filter8 if !(flat2 && flat && mask)
+  flat2_p1 = _mm256_and_si256(flat2, flat2_p1);
+  //  get values for when (flat2 && flat && mask)
+  p1 = _mm256_or_si256(p1, flat2_p1);  // full list of p1 values
+  q1 = _mm256_andnot_si256(flat2, q1);
+  //  q1 takes value from highbd_filter8 if !(flat2 && flat && mask)
+  flat2_q1 = _mm256_and_si256(flat2, flat2_q1);
+  //  get values for when (flat2 && flat && mask)
+  q1 = _mm256_or_si256(q1, flat2_q1);  // full list of q1 values
+  _mm256_storeu_si256((__m256i *)(s - 2 * pitch), p1);
+  _mm256_storeu_si256((__m256i *)(s + 1 * pitch), q1);
+
+  p0 = _mm256_andnot_si256(flat2, p0);
+  //  p0 takes value from highbd_filter8 if !(flat2 && flat && mask)
+  flat2_p0 = _mm256_and_si256(flat2, flat2_p0);
+  //  get values for when (flat2 && flat && mask)
+  p0 = _mm256_or_si256(p0, flat2_p0);  // full list of p0 values
+  q0 = _mm256_andnot_si256(flat2, q0);
+  //  q0 takes value from highbd_filter8 if !(flat2 && flat && mask)
+  flat2_q0 = _mm256_and_si256(flat2, flat2_q0);
+  //  get values for when (flat2 && flat && mask)
+  q0 = _mm256_or_si256(q0, flat2_q0);  // full list of q0 values
+  _mm256_storeu_si256((__m256i *)(s - 1 * pitch), p0);
+  _mm256_storeu_si256((__m256i *)(s - 0 * pitch), q0);
+}
+
+void vpx_highbd_lpf_horizontal_8_dual_avx2(
+    uint16_t *s, int pitch, const uint8_t *blimit0, const uint8_t *limit0,
+    const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
+    const uint8_t *thresh1, int bd) {
+  DECLARE_ALIGNED(32, uint16_t, flat_op2[16]);
+  DECLARE_ALIGNED(32, uint16_t, flat_op1[16]);
+  DECLARE_ALIGNED(32, uint16_t, flat_op0[16]);
+  DECLARE_ALIGNED(32, uint16_t, flat_oq2[16]);
+  DECLARE_ALIGNED(32, uint16_t, flat_oq1[16]);
+  DECLARE_ALIGNED(32, uint16_t, flat_oq0[16]);
+  const __m256i zero = _mm256_set1_epi16(0);
+  const __m256i blimit_v = highbd_load_dual_limit(blimit0, blimit1, bd);
+  const __m256i limit_v = highbd_load_dual_limit(limit0, limit1, bd);
+  const __m256i thresh_v = highbd_load_dual_limit(thresh0, thresh1, bd);
+  __m256i mask, hev, flat;
+  __m256i p3 = _mm256_loadu_si256((__m256i *)(s - 4 * pitch));
+  __m256i q3 = _mm256_loadu_si256((__m256i *)(s + 3 * pitch));
+  __m256i p2 = _mm256_loadu_si256((__m256i *)(s - 3 * pitch));
+  __m256i q2 = _mm256_loadu_si256((__m256i *)(s + 2 * pitch));
+  __m256i p1 = _mm256_loadu_si256((__m256i *)(s - 2 * pitch));
+  __m256i q1 = _mm256_loadu_si256((__m256i *)(s + 1 * pitch));
+  __m256i p0 = _mm256_loadu_si256((__m256i *)(s - 1 * pitch));
+  __m256i q0 = _mm256_loadu_si256((__m256i *)(s + 0 * pitch));
+  const __m256i one = _mm256_set1_epi16(1);
+  const __m256i ffff = _mm256_cmpeq_epi16(one, one);
+  __m256i abs_p1q1, abs_p0q0, abs_q1q0, abs_p1p0, work;
+  const __m256i four = _mm256_set1_epi16(4);
+  __m256i workp_a, workp_b, workp_shft;
+
+  const __m256i t4 = _mm256_set1_epi16(4);
+  const __m256i t3 = _mm256_set1_epi16(3);
+  __m256i t80;
+  const __m256i t1 = _mm256_set1_epi16(0x1);
+  __m256i ps1, ps0, qs0, qs1;
+  __m256i filt;
+  __m256i work_a;
+  __m256i filter1, filter2;
+
+  if (bd == 8) {
+    t80 = _mm256_set1_epi16(0x80);
+  } else if (bd == 10) {
+    t80 = _mm256_set1_epi16(0x200);
+  } else {  // bd == 12
+    t80 = _mm256_set1_epi16(0x800);
+  }
+
+  ps1 = _mm256_subs_epi16(p1, t80);
+  ps0 = _mm256_subs_epi16(p0, t80);
+  qs0 = _mm256_subs_epi16(q0, t80);
+  qs1 = _mm256_subs_epi16(q1, t80);
+
+  // filter_mask and hev_mask
+  abs_p1p0 =
+      _mm256_or_si256(_mm256_subs_epu16(p1, p0), _mm256_subs_epu16(p0, p1));
+  abs_q1q0 =
+      _mm256_or_si256(_mm256_subs_epu16(q1, q0), _mm256_subs_epu16(q0, q1));
+
+  abs_p0q0 =
+      _mm256_or_si256(_mm256_subs_epu16(p0, q0), _mm256_subs_epu16(q0, p0));
+  abs_p1q1 =
+      _mm256_or_si256(_mm256_subs_epu16(p1, q1), _mm256_subs_epu16(q1, p1));
+  flat = _mm256_max_epi16(abs_p1p0, abs_q1q0);
+  hev = _mm256_subs_epu16(flat, thresh_v);
+  hev = _mm256_xor_si256(_mm256_cmpeq_epi16(hev, zero), ffff);
+
+  abs_p0q0 = _mm256_adds_epu16(abs_p0q0, abs_p0q0);
+  abs_p1q1 = _mm256_srli_epi16(abs_p1q1, 1);
+  mask = _mm256_subs_epu16(_mm256_adds_epu16(abs_p0q0, abs_p1q1), blimit_v);
+  mask = _mm256_xor_si256(_mm256_cmpeq_epi16(mask, zero), ffff);
+  // mask |= (abs(p0 - q0) * 2 + abs(p1 - q1) / 2  > blimit) * -1;
+  // So taking maximums continues to work:
+  mask = _mm256_and_si256(mask, _mm256_adds_epu16(limit_v, one));
+  mask = _mm256_max_epi16(abs_p1p0, mask);
+  // mask |= (abs(p1 - p0) > limit) * -1;
+  mask = _mm256_max_epi16(abs_q1q0, mask);
+  // mask |= (abs(q1 - q0) > limit) * -1;
+
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p2, p1), _mm256_subs_epu16(p1, p2)),
+      _mm256_or_si256(_mm256_subs_epu16(q2, q1), _mm256_subs_epu16(q1, q2)));
+  mask = _mm256_max_epi16(work, mask);
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p3, p2), _mm256_subs_epu16(p2, p3)),
+      _mm256_or_si256(_mm256_subs_epu16(q3, q2), _mm256_subs_epu16(q2, q3)));
+  mask = _mm256_max_epi16(work, mask);
+  mask = _mm256_subs_epu16(mask, limit_v);
+  mask = _mm256_cmpeq_epi16(mask, zero);
+
+  // flat_mask4
+  flat = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p2, p0), _mm256_subs_epu16(p0, p2)),
+      _mm256_or_si256(_mm256_subs_epu16(q2, q0), _mm256_subs_epu16(q0, q2)));
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p3, p0), _mm256_subs_epu16(p0, p3)),
+      _mm256_or_si256(_mm256_subs_epu16(q3, q0), _mm256_subs_epu16(q0, q3)));
+  flat = _mm256_max_epi16(work, flat);
+  flat = _mm256_max_epi16(abs_p1p0, flat);
+  flat = _mm256_max_epi16(abs_q1q0, flat);
+
+  if (bd == 8)
+    flat = _mm256_subs_epu16(flat, one);
+  else if (bd == 10)
+    flat = _mm256_subs_epu16(flat, _mm256_slli_epi16(one, 2));
+  else  // bd == 12
+    flat = _mm256_subs_epu16(flat, _mm256_slli_epi16(one, 4));
+
+  flat = _mm256_cmpeq_epi16(flat, zero);
+  flat = _mm256_and_si256(flat, mask);  // flat & mask
+
+  // Added before shift for rounding part of ROUND_POWER_OF_TWO
+
+  workp_a =
+      _mm256_add_epi16(_mm256_add_epi16(p3, p3), _mm256_add_epi16(p2, p1));
+  workp_a = _mm256_add_epi16(_mm256_add_epi16(workp_a, four), p0);
+  workp_b = _mm256_add_epi16(_mm256_add_epi16(q0, p2), p3);
+  workp_shft = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+  _mm256_store_si256((__m256i *)&flat_op2[0], workp_shft);
+
+  workp_b = _mm256_add_epi16(_mm256_add_epi16(q0, q1), p1);
+  workp_shft = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+  _mm256_store_si256((__m256i *)&flat_op1[0], workp_shft);
+
+  workp_a = _mm256_add_epi16(_mm256_sub_epi16(workp_a, p3), q2);
+  workp_b = _mm256_add_epi16(_mm256_sub_epi16(workp_b, p1), p0);
+  workp_shft = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+  _mm256_store_si256((__m256i *)&flat_op0[0], workp_shft);
+
+  workp_a = _mm256_add_epi16(_mm256_sub_epi16(workp_a, p3), q3);
+  workp_b = _mm256_add_epi16(_mm256_sub_epi16(workp_b, p0), q0);
+  workp_shft = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+  _mm256_store_si256((__m256i *)&flat_oq0[0], workp_shft);
+
+  workp_a = _mm256_add_epi16(_mm256_sub_epi16(workp_a, p2), q3);
+  workp_b = _mm256_add_epi16(_mm256_sub_epi16(workp_b, q0), q1);
+  workp_shft = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+  _mm256_store_si256((__m256i *)&flat_oq1[0], workp_shft);
+
+  workp_a = _mm256_add_epi16(_mm256_sub_epi16(workp_a, p1), q3);
+  workp_b = _mm256_add_epi16(_mm256_sub_epi16(workp_b, q1), q2);
+  workp_shft = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+  _mm256_store_si256((__m256i *)&flat_oq2[0], workp_shft);
+
+  // lp filter
+  filt = signed_char_clamp_bd_avx2(_mm256_subs_epi16(ps1, qs1), bd);
+  filt = _mm256_and_si256(filt, hev);
+  work_a = _mm256_subs_epi16(qs0, ps0);
+  filt = _mm256_adds_epi16(filt, work_a);
+  filt = _mm256_adds_epi16(filt, work_a);
+  filt = _mm256_adds_epi16(filt, work_a);
+  // (vpx_filter + 3 * (qs0 - ps0)) & mask
+  filt = signed_char_clamp_bd_avx2(filt, bd);
+  filt = _mm256_and_si256(filt, mask);
+
+  filter1 = _mm256_adds_epi16(filt, t4);
+  filter2 = _mm256_adds_epi16(filt, t3);
+
+  // Filter1 >> 3
+  filter1 = signed_char_clamp_bd_avx2(filter1, bd);
+  filter1 = _mm256_srai_epi16(filter1, 3);
+
+  // Filter2 >> 3
+  filter2 = signed_char_clamp_bd_avx2(filter2, bd);
+  filter2 = _mm256_srai_epi16(filter2, 3);
+
+  // filt >> 1
+  filt = _mm256_adds_epi16(filter1, t1);
+  filt = _mm256_srai_epi16(filt, 1);
+  // filter = ROUND_POWER_OF_TWO(filter1, 1) & ~hev;
+  filt = _mm256_andnot_si256(hev, filt);
+
+  work_a = signed_char_clamp_bd_avx2(_mm256_subs_epi16(qs0, filter1), bd);
+  work_a = _mm256_adds_epi16(work_a, t80);
+  q0 = _mm256_load_si256((__m256i *)flat_oq0);
+  work_a = _mm256_andnot_si256(flat, work_a);
+  q0 = _mm256_and_si256(flat, q0);
+  q0 = _mm256_or_si256(work_a, q0);
+
+  work_a = signed_char_clamp_bd_avx2(_mm256_subs_epi16(qs1, filt), bd);
+  work_a = _mm256_adds_epi16(work_a, t80);
+  q1 = _mm256_load_si256((__m256i *)flat_oq1);
+  work_a = _mm256_andnot_si256(flat, work_a);
+  q1 = _mm256_and_si256(flat, q1);
+  q1 = _mm256_or_si256(work_a, q1);
+
+  work_a = _mm256_loadu_si256((__m256i *)(s + 2 * pitch));
+  q2 = _mm256_load_si256((__m256i *)flat_oq2);
+  work_a = _mm256_andnot_si256(flat, work_a);
+  q2 = _mm256_and_si256(flat, q2);
+  q2 = _mm256_or_si256(work_a, q2);
+
+  work_a = signed_char_clamp_bd_avx2(_mm256_adds_epi16(ps0, filter2), bd);
+  work_a = _mm256_adds_epi16(work_a, t80);
+  p0 = _mm256_load_si256((__m256i *)flat_op0);
+  work_a = _mm256_andnot_si256(flat, work_a);
+  p0 = _mm256_and_si256(flat, p0);
+  p0 = _mm256_or_si256(work_a, p0);
+
+  work_a = signed_char_clamp_bd_avx2(_mm256_adds_epi16(ps1, filt), bd);
+  work_a = _mm256_adds_epi16(work_a, t80);
+  p1 = _mm256_load_si256((__m256i *)flat_op1);
+  work_a = _mm256_andnot_si256(flat, work_a);
+  p1 = _mm256_and_si256(flat, p1);
+  p1 = _mm256_or_si256(work_a, p1);
+
+  work_a = _mm256_loadu_si256((__m256i *)(s - 3 * pitch));
+  p2 = _mm256_load_si256((__m256i *)flat_op2);
+  work_a = _mm256_andnot_si256(flat, work_a);
+  p2 = _mm256_and_si256(flat, p2);
+  p2 = _mm256_or_si256(work_a, p2);
+
+  _mm256_storeu_si256((__m256i *)(s - 3 * pitch), p2);
+  _mm256_storeu_si256((__m256i *)(s - 2 * pitch), p1);
+  _mm256_storeu_si256((__m256i *)(s - 1 * pitch), p0);
+  _mm256_storeu_si256((__m256i *)(s + 0 * pitch), q0);
+  _mm256_storeu_si256((__m256i *)(s + 1 * pitch), q1);
+  _mm256_storeu_si256((__m256i *)(s + 2 * pitch), q2);
+}
+
+void vpx_highbd_lpf_horizontal_4_dual_avx2(
+    uint16_t *s, int pitch, const uint8_t *blimit0, const uint8_t *limit0,
+    const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
+    const uint8_t *thresh1, int bd) {
+  const __m256i zero = _mm256_set1_epi16(0);
+  const __m256i blimit_v = highbd_load_dual_limit(blimit0, blimit1, bd);
+  const __m256i limit_v = highbd_load_dual_limit(limit0, limit1, bd);
+  const __m256i thresh_v = highbd_load_dual_limit(thresh0, thresh1, bd);
+  __m256i mask, hev, flat;
+  __m256i p3 = _mm256_loadu_si256((__m256i *)(s - 4 * pitch));
+  __m256i p2 = _mm256_loadu_si256((__m256i *)(s - 3 * pitch));
+  __m256i p1 = _mm256_loadu_si256((__m256i *)(s - 2 * pitch));
+  __m256i p0 = _mm256_loadu_si256((__m256i *)(s - 1 * pitch));
+  __m256i q0 = _mm256_loadu_si256((__m256i *)(s - 0 * pitch));
+  __m256i q1 = _mm256_loadu_si256((__m256i *)(s + 1 * pitch));
+  __m256i q2 = _mm256_loadu_si256((__m256i *)(s + 2 * pitch));
+  __m256i q3 = _mm256_loadu_si256((__m256i *)(s + 3 * pitch));
+  const __m256i abs_p1p0 =
+      _mm256_or_si256(_mm256_subs_epu16(p1, p0), _mm256_subs_epu16(p0, p1));
+  const __m256i abs_q1q0 =
+      _mm256_or_si256(_mm256_subs_epu16(q1, q0), _mm256_subs_epu16(q0, q1));
+  const __m256i ffff = _mm256_cmpeq_epi16(abs_p1p0, abs_p1p0);
+  const __m256i one = _mm256_set1_epi16(1);
+  __m256i abs_p0q0 =
+      _mm256_or_si256(_mm256_subs_epu16(p0, q0), _mm256_subs_epu16(q0, p0));
+  __m256i abs_p1q1 =
+      _mm256_or_si256(_mm256_subs_epu16(p1, q1), _mm256_subs_epu16(q1, p1));
+  __m256i work;
+  const __m256i t4 = _mm256_set1_epi16(4);
+  const __m256i t3 = _mm256_set1_epi16(3);
+  __m256i t80;
+  __m256i tff80;
+  __m256i tffe0;
+  __m256i t1f;
+  // equivalent to shifting 0x1f left by bitdepth - 8
+  // and setting new bits to 1
+  const __m256i t1 = _mm256_set1_epi16(0x1);
+  __m256i t7f;
+  // equivalent to shifting 0x7f left by bitdepth - 8
+  // and setting new bits to 1
+  __m256i ps1, ps0, qs0, qs1;
+  __m256i filt;
+  __m256i work_a;
+  __m256i filter1, filter2;
+
+  if (bd == 8) {
+    t80 = _mm256_set1_epi16(0x80);
+    tff80 = _mm256_set1_epi16((int16_t)0xff80);
+    tffe0 = _mm256_set1_epi16((int16_t)0xffe0);
+    t1f = _mm256_srli_epi16(_mm256_set1_epi16(0x1fff), 8);
+    t7f = _mm256_srli_epi16(_mm256_set1_epi16(0x7fff), 8);
+  } else if (bd == 10) {
+    t80 = _mm256_slli_epi16(_mm256_set1_epi16(0x80), 2);
+    tff80 = _mm256_slli_epi16(_mm256_set1_epi16((int16_t)0xff80), 2);
+    tffe0 = _mm256_slli_epi16(_mm256_set1_epi16((int16_t)0xffe0), 2);
+    t1f = _mm256_srli_epi16(_mm256_set1_epi16(0x1fff), 6);
+    t7f = _mm256_srli_epi16(_mm256_set1_epi16(0x7fff), 6);
+  } else {  // bd == 12
+    t80 = _mm256_slli_epi16(_mm256_set1_epi16(0x80), 4);
+    tff80 = _mm256_slli_epi16(_mm256_set1_epi16((int16_t)0xff80), 4);
+    tffe0 = _mm256_slli_epi16(_mm256_set1_epi16((int16_t)0xffe0), 4);
+    t1f = _mm256_srli_epi16(_mm256_set1_epi16(0x1fff), 4);
+    t7f = _mm256_srli_epi16(_mm256_set1_epi16(0x7fff), 4);
+  }
+
+  ps1 = _mm256_subs_epi16(_mm256_loadu_si256((__m256i *)(s - 2 * pitch)), t80);
+  ps0 = _mm256_subs_epi16(_mm256_loadu_si256((__m256i *)(s - 1 * pitch)), t80);
+  qs0 = _mm256_subs_epi16(_mm256_loadu_si256((__m256i *)(s + 0 * pitch)), t80);
+  qs1 = _mm256_subs_epi16(_mm256_loadu_si256((__m256i *)(s + 1 * pitch)), t80);
+
+  // filter_mask and hev_mask
+  flat = _mm256_max_epi16(abs_p1p0, abs_q1q0);
+  hev = _mm256_subs_epu16(flat, thresh_v);
+  hev = _mm256_xor_si256(_mm256_cmpeq_epi16(hev, zero), ffff);
+
+  abs_p0q0 = _mm256_adds_epu16(abs_p0q0, abs_p0q0);
+  abs_p1q1 = _mm256_srli_epi16(abs_p1q1, 1);
+  mask = _mm256_subs_epu16(_mm256_adds_epu16(abs_p0q0, abs_p1q1), blimit_v);
+  mask = _mm256_xor_si256(_mm256_cmpeq_epi16(mask, zero), ffff);
+  // mask |= (abs(p0 - q0) * 2 + abs(p1 - q1) / 2  > blimit) * -1;
+  // So taking maximums continues to work:
+  mask = _mm256_and_si256(mask, _mm256_adds_epu16(limit_v, one));
+  mask = _mm256_max_epi16(flat, mask);
+  // mask |= (abs(p1 - p0) > limit) * -1;
+  // mask |= (abs(q1 - q0) > limit) * -1;
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(p2, p1), _mm256_subs_epu16(p1, p2)),
+      _mm256_or_si256(_mm256_subs_epu16(p3, p2), _mm256_subs_epu16(p2, p3)));
+  mask = _mm256_max_epi16(work, mask);
+  work = _mm256_max_epi16(
+      _mm256_or_si256(_mm256_subs_epu16(q2, q1), _mm256_subs_epu16(q1, q2)),
+      _mm256_or_si256(_mm256_subs_epu16(q3, q2), _mm256_subs_epu16(q2, q3)));
+  mask = _mm256_max_epi16(work, mask);
+  mask = _mm256_subs_epu16(mask, limit_v);
+  mask = _mm256_cmpeq_epi16(mask, zero);
+
+  // filter4
+  filt = signed_char_clamp_bd_avx2(_mm256_subs_epi16(ps1, qs1), bd);
+  filt = _mm256_and_si256(filt, hev);
+  work_a = _mm256_subs_epi16(qs0, ps0);
+  filt = _mm256_adds_epi16(filt, work_a);
+  filt = _mm256_adds_epi16(filt, work_a);
+  filt = signed_char_clamp_bd_avx2(_mm256_adds_epi16(filt, work_a), bd);
+
+  // (vpx_filter + 3 * (qs0 - ps0)) & mask
+  filt = _mm256_and_si256(filt, mask);
+
+  filter1 = signed_char_clamp_bd_avx2(_mm256_adds_epi16(filt, t4), bd);
+  filter2 = signed_char_clamp_bd_avx2(_mm256_adds_epi16(filt, t3), bd);
+
+  // Filter1 >> 3
+  work_a = _mm256_cmpgt_epi16(zero, filter1);  // get the values that are <0
+  filter1 = _mm256_srli_epi16(filter1, 3);
+  work_a = _mm256_and_si256(work_a, tffe0);    // sign bits for the values < 0
+  filter1 = _mm256_and_si256(filter1, t1f);    // clamp the range
+  filter1 = _mm256_or_si256(filter1, work_a);  // reinsert the sign bits
+
+  // Filter2 >> 3
+  work_a = _mm256_cmpgt_epi16(zero, filter2);
+  filter2 = _mm256_srli_epi16(filter2, 3);
+  work_a = _mm256_and_si256(work_a, tffe0);
+  filter2 = _mm256_and_si256(filter2, t1f);
+  filter2 = _mm256_or_si256(filter2, work_a);
+
+  // filt >> 1
+  filt = _mm256_adds_epi16(filter1, t1);
+  work_a = _mm256_cmpgt_epi16(zero, filt);
+  filt = _mm256_srli_epi16(filt, 1);
+  work_a = _mm256_and_si256(work_a, tff80);
+  filt = _mm256_and_si256(filt, t7f);
+  filt = _mm256_or_si256(filt, work_a);
+
+  filt = _mm256_andnot_si256(hev, filt);
+
+  q0 = _mm256_adds_epi16(
+      signed_char_clamp_bd_avx2(_mm256_subs_epi16(qs0, filter1), bd), t80);
+  q1 = _mm256_adds_epi16(
+      signed_char_clamp_bd_avx2(_mm256_subs_epi16(qs1, filt), bd), t80);
+  p0 = _mm256_adds_epi16(
+      signed_char_clamp_bd_avx2(_mm256_adds_epi16(ps0, filter2), bd), t80);
+  p1 = _mm256_adds_epi16(
+      signed_char_clamp_bd_avx2(_mm256_adds_epi16(ps1, filt), bd), t80);
+
+  _mm256_storeu_si256((__m256i *)(s - 2 * pitch), p1);
+  _mm256_storeu_si256((__m256i *)(s - 1 * pitch), p0);
+  _mm256_storeu_si256((__m256i *)(s + 0 * pitch), q0);
+  _mm256_storeu_si256((__m256i *)(s + 1 * pitch), q1);
+}
+// Transposes the two 8x8 blocks of uint16_t held in the 128-bit lanes of x[]
+// in place.
+static INLINE void highbd_transpose_8x8x2(__m256i *const x) {
+  __m256i a[8], b[8];
+  int i;
+
+  // 00 10 01 11 02 12 03 13
+  a[0] = _mm256_unpacklo_epi16(x[0], x[1]);
+  a[1] = _mm256_unpacklo_epi16(x[2], x[3]);
+  a[2] = _mm256_unpacklo_epi16(x[4], x[5]);
+  a[3] = _mm256_unpacklo_epi16(x[6], x[7]);
+  // 04 14 05 15 06 16 07 17
+  a[4] = _mm256_unpackhi_epi16(x[0], x[1]);
+  a[5] = _mm256_unpackhi_epi16(x[2], x[3]);
+  a[6] = _mm256_unpackhi_epi16(x[4], x[5]);
+  a[7] = _mm256_unpackhi_epi16(x[6], x[7]);
+
+  // 00 10 20 30 01 11 21 31
+  b[0] = _mm256_unpacklo_epi32(a[0], a[1]);
+  b[1] = _mm256_unpacklo_epi32(a[2], a[3]);
+  b[2] = _mm256_unpackhi_epi32(a[0], a[1]);
+  b[3] = _mm256_unpackhi_epi32(a[2], a[3]);
+  b[4] = _mm256_unpacklo_epi32(a[4], a[5]);
+  b[5] = _mm256_unpacklo_epi32(a[6], a[7]);
+  b[6] = _mm256_unpackhi_epi32(a[4], a[5]);
+  b[7] = _mm256_unpackhi_epi32(a[6], a[7]);
+
+  // 00 10 20 30 40 50 60 70
+  for (i = 0; i < 4; ++i) {
+    x[2 * i + 0] = _mm256_unpacklo_epi64(b[2 * i], b[2 * i + 1]);
+    x[2 * i + 1] = _mm256_unpackhi_epi64(b[2 * i], b[2 * i + 1]);
+  }
+}
+
+// Transposes the 8x8 blocks at in0 and in1 into 8 rows of 16 values, with the
+// block at in0 on the left. Whole rows are written so that the loads in the
+// horizontal filters can be forwarded from these stores.
+static INLINE void highbd_transpose_8x16_avx2(const uint16_t *in0,
+                                              const uint16_t *in1, int in_p,
+                                              uint16_t *out, int out_p) {
+  __m256i x[8];
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)(in0 + i * in_p));
+    const __m128i r1 = _mm_loadu_si128((const __m128i *)(in1 + i * in_p));
+    x[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+  }
+
+  highbd_transpose_8x8x2(x);
+
+  for (i = 0; i < 8; ++i) {
+    _mm256_storeu_si256((__m256i *)(out + i * out_p), x[i]);
+  }
+}
+
+// The inverse of highbd_transpose_8x16_avx2(): transposes 8 rows of 16
+// values, writing the left 8x8 block to out0 and the right one to out1.
+static INLINE void highbd_transpose_16x8_avx2(const uint16_t *in, int in_p,
+                                              uint16_t *out0, uint16_t *out1,
+                                              int out_p) {
+  __m256i x[8];
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    x[i] = _mm256_loadu_si256((const __m256i *)(in + i * in_p));
+  }
+
+  highbd_transpose_8x8x2(x);
+
+  for (i = 0; i < 8; ++i) {
+    _mm_storeu_si128((__m128i *)(out0 + i * out_p),
+                     _mm256_castsi256_si128(x[i]));
+    _mm_storeu_si128((__m128i *)(out1 + i * out_p),
+                     _mm256_extracti128_si256(x[i], 1));
+  }
+}
+
+void vpx_highbd_lpf_vertical_4_dual_avx2(
+    uint16_t *s, int pitch, const uint8_t *blimit0, const uint8_t *limit0,
+    const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
+    const uint8_t *thresh1, int bd) {
+  DECLARE_ALIGNED(32, uint16_t, t_dst[16 * 8]);
+
+  // Transpose 8x16
+  highbd_transpose_8x16_avx2(s - 4, s - 4 + 8 * pitch, pitch, t_dst, 16);
+
+  // Loop filtering
+  vpx_highbd_lpf_horizontal_4_dual_avx2(t_dst + 4 * 16, 16, blimit0, limit0,
+                                        thresh0, blimit1, limit1, thresh1, bd);
+
+  // Transpose back
+  highbd_transpose_16x8_avx2(t_dst, 16, s - 4, s - 4 + 8 * pitch, pitch);
+}
+
+void vpx_highbd_lpf_vertical_8_dual_avx2(
+    uint16_t *s, int pitch, const uint8_t *blimit0, const uint8_t *limit0,
+    const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
+    const uint8_t *thresh1, int bd) {
+  DECLARE_ALIGNED(32, uint16_t, t_dst[16 * 8]);
+
+  // Transpose 8x16
+  highbd_transpose_8x16_avx2(s - 4, s - 4 + 8 * pitch, pitch, t_dst, 16);
+
+  // Loop filtering
+  vpx_highbd_lpf_horizontal_8_dual_avx2(t_dst + 4 * 16, 16, blimit0, limit0,
+                                        thresh0, blimit1, limit1, thresh1, bd);
+
+  // Transpose back
+  highbd_transpose_16x8_avx2(t_dst, 16, s - 4, s - 4 + 8 * pitch, pitch);
+}
+
+void vpx_highbd_lpf_vertical_16_dual_avx2(uint16_t *s, int pitch,
+                                          const uint8_t *blimit,
+                                          const uint8_t *limit,
+                                          const uint8_t *thresh, int bd) {
+  DECLARE_ALIGNED(32, uint16_t, t_dst[256]);
+
+  // Transpose 16x16
+  highbd_transpose_8x16_avx2(s - 8, s - 8 + 8 * pitch, pitch, t_dst, 16);
+  highbd_transpose_8x16_avx2(s, s + 8 * pitch, pitch, t_dst + 8 * 16, 16);
+
+  // Loop filtering
+  vpx_highbd_lpf_horizontal_16_dual_avx2(t_dst + 8 * 16, 16, blimit, limit,
+                                         thresh, bd);
+
+  // Transpose back
+  highbd_transpose_16x8_avx2(t_dst, 16, s - 8, s - 8 + 8 * pitch, pitch);
+  highbd_transpose_16x8_avx2(t_dst + 8 * 16, 16, s, s + 8 * pitch, pitch);
+}
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/mem_avx2.h"
+#include "vpx_ports/mem.h"
+
+// The absolute difference of two 12-bit pixels is at most 4095, so 8 of them
+// fit in a signed 16-bit lane before they need to be widened.
+#define SAD_VECTORS_PER_FLUSH 8
+
+static INLINE __m256i abs_diff_epu16(const __m256i a, const __m256i b) {
+  return _mm256_or_si256(_mm256_subs_epu16(a, b), _mm256_subs_epu16(b, a));
+}
+
+static INLINE unsigned int hsum_epi32(const __m256i v) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  return (unsigned int)_mm_cvtsi128_si32(sum);
+}
+
+// Blocks narrower than 16 pixels are processed 16 pixels, i.e. several rows,
+// at a time. 'second_pred', when not NULL, is averaged with 'ref' first.
+static INLINE unsigned int highbd_sad_avx2(const uint8_t *src8, int src_stride,
+                                           const uint8_t *ref8, int ref_stride,
+                                           const uint8_t *second_pred8,
+                                           int width, int height) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref = CONVERT_TO_SHORTPTR(ref8);
+  const uint16_t *pred = CONVERT_TO_SHORTPTR(second_pred8);
+  const int rows = width >= 16 ? 1 : 16 / width;
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i sad16 = _mm256_setzero_si256();
+  __m256i sad32 = _mm256_setzero_si256();
+  int i, j, n = 0;
+
+  for (i = 0; i < height; i += rows) {
+    for (j = 0; j < width; j += 16) {
+      const __m256i s = load_highbd_16_pixels(src + j, src_stride, width);
+      __m256i r = load_highbd_16_pixels(ref + j, ref_stride, width);
+      if (second_pred8 != NULL) {
+        r = _mm256_avg_epu16(r, _mm256_loadu_si256((const __m256i *)pred));
+        pred += 16;
+      }
+      sad16 = _mm256_add_epi16(sad16, abs_diff_epu16(s, r));
+      if (++n == SAD_VECTORS_PER_FLUSH) {
+        sad32 = _mm256_add_epi32(sad32, _mm256_madd_epi16(sad16, ones));
+        sad16 = _mm256_setzero_si256();
+        n = 0;
+      }
+    }
+    src += rows * src_stride;
+    ref += rows * ref_stride;
+  }
+  sad32 = _mm256_add_epi32(sad32, _mm256_madd_epi16(sad16, ones));
+  return hsum_epi32(sad32);
+}
+
+static INLINE void highbd_sad_x4d_avx2(const uint8_t *src8, int src_stride,
+                                       const uint8_t *const ref_array[],
+                                       int ref_stride, uint32_t *sad_array,
+                                       int width, int height) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref[4];
+  const int rows = width >= 16 ? 1 : 16 / width;
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i sad16[4], sad32[4], sums;
+  __m128i sums128;
+  int i, j, k, n = 0;
+
+  for (k = 0; k < 4; ++k) {
+    ref[k] = CONVERT_TO_SHORTPTR(ref_array[k]);
+    sad16[k] = _mm256_setzero_si256();
+    sad32[k] = _mm256_setzero_si256();
+  }
+
+  for (i = 0; i < height; i += rows) {
+    for (j = 0; j < width; j += 16) {
+      const __m256i s = load_highbd_16_pixels(src + j, src_stride, width);
+      for (k = 0; k < 4; ++k) {
+        const __m256i r = load_highbd_16_pixels(ref[k] + j, ref_stride, width);
+        sad16[k] = _mm256_add_epi16(sad16[k], abs_diff_epu16(s, r));
+      }
+      if (++n == SAD_VECTORS_PER_FLUSH) {
+        for (k = 0; k < 4; ++k) {
+          sad32[k] =
+              _mm256_add_epi32(sad32[k], _mm256_madd_epi16(sad16[k], ones));
+          sad16[k] = _mm256_setzero_si256();
+        }
+        n = 0;
+      }
+    }
+    src += rows * src_stride;
+    for (k = 0; k < 4; ++k) ref[k] += rows * ref_stride;
+  }
+  for (k = 0; k < 4; ++k) {
+    sad32[k] = _mm256_add_epi32(sad32[k], _mm256_madd_epi16(sad16[k], ones));
+  }
+
+  // Lane k of each 128-bit half ends up holding a partial sum of sad32[k].
+  sums = _mm256_hadd_epi32(_mm256_hadd_epi32(sad32[0], sad32[1]),
+                           _mm256_hadd_epi32(sad32[2], sad32[3]));
+  sums128 = _mm_add_epi32(_mm256_castsi256_si128(sums),
+                          _mm256_extracti128_si256(sums, 1));
+  _mm_storeu_si128((__m128i *)sad_array, sums128);
+}
+
+#define HIGHBD_SADMXN(m, n)                                                   \
+  unsigned int vpx_highbd_sad##m##x##n##_avx2(                                \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride) {                                                       \
+    return highbd_sad_avx2(src_ptr, src_stride, ref_ptr, ref_stride, NULL, m, \
+                           n);                                                \
+  }                                                                           \
+                                                                              \
+  unsigned int vpx_highbd_sad##m##x##n##_avg_avx2(                            \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, const uint8_t *second_pred) {                           \
+    return highbd_sad_avx2(src_ptr, src_stride, ref_ptr, ref_stride,          \
+                           second_pred, m, n);                                \
+  }                                                                           \
+                                                                              \
+  void vpx_highbd_sad##m##x##n##x4d_avx2(                                     \
+      const uint8_t *src_ptr, int src_stride,                                 \
+      const uint8_t *const ref_array[], int ref_stride, uint32_t *sad_array) { \
+    highbd_sad_x4d_avx2(src_ptr, src_stride, ref_array, ref_stride,           \
+                        sad_array, m, n);                                     \
+  }
+
+HIGHBD_SADMXN(64, 64)
+HIGHBD_SADMXN(64, 32)
+HIGHBD_SADMXN(32, 64)
+HIGHBD_SADMXN(32, 32)
+HIGHBD_SADMXN(32, 16)
+HIGHBD_SADMXN(16, 32)
+HIGHBD_SADMXN(16, 16)
+HIGHBD_SADMXN(16, 8)
+HIGHBD_SADMXN(8, 16)
+HIGHBD_SADMXN(8, 8)
+HIGHBD_SADMXN(8, 4)
+HIGHBD_SADMXN(4, 8)
+HIGHBD_SADMXN(4, 4)
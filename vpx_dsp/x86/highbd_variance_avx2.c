@@ -0,0 +1,343 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_dsp/vpx_filter.h"
+#include "vpx_dsp/x86/mem_avx2.h"
+#include "vpx_ports/mem.h"
+
+// Each 32-bit lane of _mm256_madd_epi16(diff, diff) is at most
+// 2 * 4095 * 4095 for 12-bit input, so 64 of them can be accumulated before
+// they are widened to 64 bits.
+#define VAR_VECTORS_PER_FLUSH 64
+
+static INLINE __m256i add_epu32_to_epi64(const __m256i sum64,
+                                         const __m256i v32) {
+  const __m256i zero = _mm256_setzero_si256();
+  return _mm256_add_epi64(sum64,
+                          _mm256_add_epi64(_mm256_unpacklo_epi32(v32, zero),
+                                           _mm256_unpackhi_epi32(v32, zero)));
+}
+
+// Accumulates the sum and sum of squares of the differences between 'src'
+// and 'ref'. Blocks narrower than 16 pixels are processed 16 pixels, i.e.
+// several rows, at a time.
+static INLINE void highbd_variance64_avx2(const uint16_t *src, int src_stride,
+                                          const uint16_t *ref, int ref_stride,
+                                          int width, int height, uint64_t *sse,
+                                          int64_t *sum) {
+  const int rows = width >= 16 ? 1 : 16 / width;
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i sum32 = _mm256_setzero_si256();
+  __m256i sse32 = _mm256_setzero_si256();
+  __m256i sse64 = _mm256_setzero_si256();
+  __m128i sum128, sse128;
+  int i, j, n = 0;
+
+  for (i = 0; i < height; i += rows) {
+    for (j = 0; j < width; j += 16) {
+      const __m256i s = load_highbd_16_pixels(src + j, src_stride, width);
+      const __m256i r = load_highbd_16_pixels(ref + j, ref_stride, width);
+      const __m256i diff = _mm256_sub_epi16(s, r);
+      sum32 = _mm256_add_epi32(sum32, _mm256_madd_epi16(diff, ones));
+      sse32 = _mm256_add_epi32(sse32, _mm256_madd_epi16(diff, diff));
+      if (++n == VAR_VECTORS_PER_FLUSH) {
+        sse64 = add_epu32_to_epi64(sse64, sse32);
+        sse32 = _mm256_setzero_si256();
+        n = 0;
+      }
+    }
+    src += rows * src_stride;
+    ref += rows * ref_stride;
+  }
+  sse64 = add_epu32_to_epi64(sse64, sse32);
+
+  sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum32),
+                         _mm256_extracti128_si256(sum32, 1));
+  sum128 = _mm_add_epi32(sum128, _mm_srli_si128(sum128, 8));
+  sum128 = _mm_add_epi32(sum128, _mm_srli_si128(sum128, 4));
+  *sum = _mm_cvtsi128_si32(sum128);
+
+  sse128 = _mm_add_epi64(_mm256_castsi256_si128(sse64),
+                         _mm256_extracti128_si256(sse64, 1));
+  sse128 = _mm_add_epi64(sse128, _mm_srli_si128(sse128, 8));
+#if VPX_ARCH_X86_64
+  *sse = (uint64_t)_mm_cvtsi128_si64(sse128);
+#else
+  _mm_storel_epi64((__m128i *)sse, sse128);
+#endif
+}
+
+static INLINE void highbd_8_variance_avx2(const uint16_t *src, int src_stride,
+                                          const uint16_t *ref, int ref_stride,
+                                          int w, int h, uint32_t *sse,
+                                          int *sum) {
+  uint64_t sse_long;
+  int64_t sum_long;
+  highbd_variance64_avx2(src, src_stride, ref, ref_stride, w, h, &sse_long,
+                         &sum_long);
+  *sse = (uint32_t)sse_long;
+  *sum = (int)sum_long;
+}
+
+static INLINE void highbd_10_variance_avx2(const uint16_t *src, int src_stride,
+                                           const uint16_t *ref, int ref_stride,
+                                           int w, int h, uint32_t *sse,
+                                           int *sum) {
+  uint64_t sse_long;
+  int64_t sum_long;
+  highbd_variance64_avx2(src, src_stride, ref, ref_stride, w, h, &sse_long,
+                         &sum_long);
+  *sse = (uint32_t)ROUND_POWER_OF_TWO(sse_long, 4);
+  *sum = (int)ROUND_POWER_OF_TWO(sum_long, 2);
+}
+
+static INLINE void highbd_12_variance_avx2(const uint16_t *src, int src_stride,
+                                           const uint16_t *ref, int ref_stride,
+                                           int w, int h, uint32_t *sse,
+                                           int *sum) {
+  uint64_t sse_long;
+  int64_t sum_long;
+  highbd_variance64_avx2(src, src_stride, ref, ref_stride, w, h, &sse_long,
+                         &sum_long);
+  *sse = (uint32_t)ROUND_POWER_OF_TWO(sse_long, 8);
+  *sum = (int)ROUND_POWER_OF_TWO(sum_long, 4);
+}
+
+static INLINE uint32_t highbd_8_var(uint32_t sse, int sum, int w, int h) {
+  return sse - (uint32_t)(((int64_t)sum * sum) / (w * h));
+}
+
+// Rounding the sse and sum separately can make the variance negative.
+static INLINE uint32_t highbd_var_clamped(uint32_t sse, int sum, int w,
+                                          int h) {
+  const int64_t var = (int64_t)sse - (((int64_t)sum * sum) / (w * h));
+  return (var >= 0) ? (uint32_t)var : 0;
+}
+
+#define HIGHBD_VAR(W, H)                                                      \
+  uint32_t vpx_highbd_8_variance##W##x##H##_avx2(                             \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse) {                                        \
+    int sum;                                                                  \
+    highbd_8_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,          \
+                           CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, W, H,    \
+                           sse, &sum);                                        \
+    return highbd_8_var(*sse, sum, W, H);                                     \
+  }                                                                           \
+                                                                              \
+  uint32_t vpx_highbd_10_variance##W##x##H##_avx2(                            \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse) {                                        \
+    int sum;                                                                  \
+    highbd_10_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,         \
+                            CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, W, H,   \
+                            sse, &sum);                                       \
+    return highbd_var_clamped(*sse, sum, W, H);                               \
+  }                                                                           \
+                                                                              \
+  uint32_t vpx_highbd_12_variance##W##x##H##_avx2(                            \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse) {                                        \
+    int sum;                                                                  \
+    highbd_12_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,         \
+                            CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, W, H,   \
+                            sse, &sum);                                       \
+    return highbd_var_clamped(*sse, sum, W, H);                               \
+  }
+
+#define HIGHBD_GET_VAR(S)                                                     \
+  void vpx_highbd_8_get##S##x##S##var_avx2(                                   \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse, int *sum) {                              \
+    highbd_8_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,          \
+                           CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, S, S,    \
+                           sse, sum);                                         \
+  }                                                                           \
+                                                                              \
+  void vpx_highbd_10_get##S##x##S##var_avx2(                                  \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse, int *sum) {                              \
+    highbd_10_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,         \
+                            CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, S, S,   \
+                            sse, sum);                                        \
+  }                                                                           \
+                                                                              \
+  void vpx_highbd_12_get##S##x##S##var_avx2(                                  \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse, int *sum) {                              \
+    highbd_12_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,         \
+                            CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, S, S,   \
+                            sse, sum);                                        \
+  }
+
+#define HIGHBD_MSE(W, H)                                                      \
+  uint32_t vpx_highbd_8_mse##W##x##H##_avx2(                                  \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse) {                                        \
+    int sum;                                                                  \
+    highbd_8_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,          \
+                           CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, W, H,    \
+                           sse, &sum);                                        \
+    return *sse;                                                              \
+  }                                                                           \
+                                                                              \
+  uint32_t vpx_highbd_10_mse##W##x##H##_avx2(                                 \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse) {                                        \
+    int sum;                                                                  \
+    highbd_10_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,         \
+                            CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, W, H,   \
+                            sse, &sum);                                       \
+    return *sse;                                                              \
+  }                                                                           \
+                                                                              \
+  uint32_t vpx_highbd_12_mse##W##x##H##_avx2(                                 \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,         \
+      int ref_stride, uint32_t *sse) {                                        \
+    int sum;                                                                  \
+    highbd_12_variance_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride,         \
+                            CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, W, H,   \
+                            sse, &sum);                                       \
+    return *sse;                                                              \
+  }
+
+// Applies the 2-tap bilinear filter for 'offset' (in 1/8 pel) to the pixel
+// pairs (a, b): (a * (128 - 16 * offset) + b * 16 * offset + 64) >> 7.
+static INLINE __m256i bilinear_filter_16(const __m256i a, const __m256i b,
+                                         int offset) {
+  if (offset == 0) return a;
+  if (offset == 4) return _mm256_avg_epu16(a, b);
+  {
+    const int tap1 = offset << (FILTER_BITS - 3);
+    const int tap0 = (1 << FILTER_BITS) - tap1;
+    const __m256i taps = _mm256_set1_epi32((tap1 << 16) | tap0);
+    const __m256i round = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+    __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), taps);
+    __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), taps);
+    lo = _mm256_srai_epi32(_mm256_add_epi32(lo, round), FILTER_BITS);
+    hi = _mm256_srai_epi32(_mm256_add_epi32(hi, round), FILTER_BITS);
+    return _mm256_packus_epi32(lo, hi);
+  }
+}
+
+// Filters 'height' rows of 'src' horizontally into the contiguous 'dst'.
+static INLINE void highbd_filter_horiz_avx2(const uint16_t *src,
+                                            int src_stride, uint16_t *dst,
+                                            int width, int height,
+                                            int offset) {
+  const int rows = width >= 16 ? 1 : 16 / width;
+  const int tap1 = offset << (FILTER_BITS - 3);
+  const int tap0 = (1 << FILTER_BITS) - tap1;
+  int i, j;
+
+  for (i = 0; i + rows <= height; i += rows) {
+    for (j = 0; j < width; j += 16) {
+      const __m256i a = load_highbd_16_pixels(src + j, src_stride, width);
+      const __m256i b = load_highbd_16_pixels(src + j + 1, src_stride, width);
+      _mm256_storeu_si256((__m256i *)dst, bilinear_filter_16(a, b, offset));
+      dst += 16;
+    }
+    src += rows * src_stride;
+  }
+  // The odd row below narrow blocks.
+  for (; i < height; ++i) {
+    for (j = 0; j < width; ++j) {
+      dst[j] = ROUND_POWER_OF_TWO(src[j] * tap0 + src[j + 1] * tap1,
+                                  FILTER_BITS);
+    }
+    src += src_stride;
+    dst += width;
+  }
+}
+
+// Filters the contiguous 'src' vertically; 'size' is a multiple of 16.
+static INLINE void highbd_filter_vert_avx2(const uint16_t *src, uint16_t *dst,
+                                           int width, int size, int offset) {
+  int i;
+  for (i = 0; i < size; i += 16) {
+    const __m256i a = _mm256_loadu_si256((const __m256i *)(src + i));
+    const __m256i b = _mm256_loadu_si256((const __m256i *)(src + i + width));
+    _mm256_storeu_si256((__m256i *)(dst + i), bilinear_filter_16(a, b, offset));
+  }
+}
+
+static INLINE void highbd_comp_avg_avx2(uint16_t *comp_pred,
+                                        const uint16_t *pred, int size) {
+  int i;
+  for (i = 0; i < size; i += 16) {
+    const __m256i p = _mm256_loadu_si256((const __m256i *)(pred + i));
+    const __m256i c = _mm256_loadu_si256((const __m256i *)(comp_pred + i));
+    _mm256_storeu_si256((__m256i *)(comp_pred + i), _mm256_avg_epu16(c, p));
+  }
+}
+
+#define HIGHBD_SUBPIX_VAR(W, H, bd)                                           \
+  uint32_t vpx_highbd_##bd##_sub_pixel_variance##W##x##H##_avx2(              \
+      const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,     \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse) {                \
+    DECLARE_ALIGNED(32, uint16_t, fdata[(H + 1) * W]);                        \
+    DECLARE_ALIGNED(32, uint16_t, temp[H * W]);                               \
+                                                                              \
+    highbd_filter_horiz_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride, fdata, \
+                             W, H + 1, x_offset);                             \
+    highbd_filter_vert_avx2(fdata, temp, W, H * W, y_offset);                 \
+    return vpx_highbd_##bd##_variance##W##x##H##_avx2(                        \
+        CONVERT_TO_BYTEPTR(temp), W, ref_ptr, ref_stride, sse);               \
+  }                                                                           \
+                                                                              \
+  uint32_t vpx_highbd_##bd##_sub_pixel_avg_variance##W##x##H##_avx2(          \
+      const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,     \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse,                  \
+      const uint8_t *second_pred) {                                           \
+    DECLARE_ALIGNED(32, uint16_t, fdata[(H + 1) * W]);                        \
+    DECLARE_ALIGNED(32, uint16_t, temp[H * W]);                               \
+                                                                              \
+    highbd_filter_horiz_avx2(CONVERT_TO_SHORTPTR(src_ptr), src_stride, fdata, \
+                             W, H + 1, x_offset);                             \
+    highbd_filter_vert_avx2(fdata, temp, W, H * W, y_offset);                 \
+    highbd_comp_avg_avx2(temp, CONVERT_TO_SHORTPTR(second_pred), H * W);      \
+    return vpx_highbd_##bd##_variance##W##x##H##_avx2(                        \
+        CONVERT_TO_BYTEPTR(temp), W, ref_ptr, ref_stride, sse);               \
+  }
+
+/* All three forms of the variance are available in the same sizes. */
+#define HIGHBD_VARIANCES(W, H) \
+  HIGHBD_VAR(W, H)             \
+  HIGHBD_SUBPIX_VAR(W, H, 8)   \
+  HIGHBD_SUBPIX_VAR(W, H, 10)  \
+  HIGHBD_SUBPIX_VAR(W, H, 12)
+
+HIGHBD_VARIANCES(64, 64)
+HIGHBD_VARIANCES(64, 32)
+HIGHBD_VARIANCES(32, 64)
+HIGHBD_VARIANCES(32, 32)
+HIGHBD_VARIANCES(32, 16)
+HIGHBD_VARIANCES(16, 32)
+HIGHBD_VARIANCES(16, 16)
+HIGHBD_VARIANCES(16, 8)
+HIGHBD_VARIANCES(8, 16)
+HIGHBD_VARIANCES(8, 8)
+HIGHBD_VARIANCES(8, 4)
+HIGHBD_VARIANCES(4, 8)
+HIGHBD_VARIANCES(4, 4)
+
+HIGHBD_GET_VAR(8)
+HIGHBD_GET_VAR(16)
+
+HIGHBD_MSE(16, 16)
+HIGHBD_MSE(16, 8)
+HIGHBD_MSE(8, 16)
+HIGHBD_MSE(8, 8)
@@ -0,0 +1,376 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// Every row of a directional prediction is a 32 pixel window into a short
+// sequence of filtered edge pixels. The sequence is computed once and kept in
+// registers; each row is then extracted with a single _mm256_alignr_epi8()
+// from the sequence and a copy of it offset by one 128-bit lane.
+
+// (x + 2 * y + z + 2) >> 2, see avg3_epu8() in intrapred_intrin_ssse3.c.
+static INLINE __m256i avg3_epu8(const __m256i x, const __m256i y,
+                                const __m256i z) {
+  const __m256i one = _mm256_set1_epi8(1);
+  const __m256i a = _mm256_avg_epu8(x, z);
+  const __m256i b =
+      _mm256_subs_epu8(a, _mm256_and_si256(_mm256_xor_si256(x, z), one));
+  return _mm256_avg_epu8(b, y);
+}
+
+// Returns pixels 16 to 47 of the 64 pixel sequence in lo:hi.
+static INLINE __m256i mid_lane(const __m256i lo, const __m256i hi) {
+  return _mm256_permute2x128_si256(lo, hi, 0x21);
+}
+
+// Returns pixels n to n + 31 of the 64 pixel sequence in lo:hi, where mid is
+// mid_lane(lo, hi). n must be a constant from 0 to 31.
+#define WINDOW(lo, mid, hi, n)                    \
+  ((n) < 16 ? _mm256_alignr_epi8(mid, lo, (n)&15) \
+            : _mm256_alignr_epi8(hi, mid, (n)&15))
+
+static INLINE void store_row(uint8_t **dst, const ptrdiff_t stride,
+                             const __m256i row) {
+  _mm256_storeu_si256((__m256i *)*dst, row);
+  *dst += stride;
+}
+
+// Replaces the last pixel of v with the corresponding one of fill.
+static INLINE __m256i set_last(const __m256i v, const __m256i fill) {
+  const __m256i last = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                        0, 0, 0, 0, 0, -1);
+  return _mm256_blendv_epi8(v, fill, last);
+}
+
+// Smooths the edge running from the bottom of the left column, through the
+// corner, to the end of the above row, as d135_predictor() does. border[0]
+// holds pixels 0 to 31 and border[1] pixels 32 to 62 of the result.
+static INLINE void d135_border_32(const uint8_t *above, const uint8_t *left,
+                                  __m256i *border) {
+  const __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4,
+                                       3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                       7, 6, 5, 4, 3, 2, 1, 0);
+  const __m256i L = _mm256_loadu_si256((const __m256i *)left);
+  const __m256i E0 =
+      _mm256_permute4x64_epi64(_mm256_shuffle_epi8(L, rev), 0x4e);
+  const __m256i E1 = _mm256_loadu_si256((const __m256i *)(above - 1));
+  const __m256i E2 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i E3 = _mm256_loadu_si256((const __m256i *)(above + 1));
+  const __m256i E01 = mid_lane(E0, E1);
+  border[0] = avg3_epu8(E0, _mm256_alignr_epi8(E01, E0, 1),
+                        _mm256_alignr_epi8(E01, E0, 2));
+  border[1] = avg3_epu8(E1, E2, E3);
+}
+
+void vpx_d45_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m256i A0 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i A1 = _mm256_loadu_si256((const __m256i *)(above + 1));
+  const __m256i A2 = _mm256_loadu_si256((const __m256i *)(above + 2));
+  const __m256i AR = _mm256_set1_epi8((char)above[31]);
+  const __m256i avg3 = set_last(avg3_epu8(A0, A1, A2), AR);
+  const __m256i mid = mid_lane(avg3, AR);
+  (void)left;
+
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 0));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 1));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 2));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 3));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 4));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 5));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 6));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 7));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 8));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 9));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 10));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 11));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 12));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 13));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 14));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 15));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 16));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 17));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 18));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 19));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 20));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 21));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 22));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 23));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 24));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 25));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 26));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 27));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 28));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 29));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 30));
+  store_row(&dst, stride, WINDOW(avg3, mid, AR, 31));
+}
+
+void vpx_d63_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m256i A0 = _mm256_loadu_si256((const __m256i *)above);
+  const __m256i A1 = _mm256_loadu_si256((const __m256i *)(above + 1));
+  const __m256i A2 = _mm256_loadu_si256((const __m256i *)(above + 2));
+  const __m256i AR = _mm256_set1_epi8((char)above[31]);
+  const __m256i avg2 = _mm256_avg_epu8(A0, A1);
+  const __m256i avg3 = avg3_epu8(A0, A1, A2);
+  // Rows 2 and below continue the ones two above them shifted left by one,
+  // filling with the above right pixel from the second to last column.
+  const __m256i avg2_ = set_last(avg2, AR);
+  const __m256i avg3_ = set_last(avg3, AR);
+  const __m256i mid2 = mid_lane(avg2_, AR);
+  const __m256i mid3 = mid_lane(avg3_, AR);
+  (void)left;
+
+  store_row(&dst, stride, avg2);
+  store_row(&dst, stride, avg3);
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 1));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 1));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 2));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 2));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 3));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 3));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 4));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 4));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 5));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 5));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 6));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 6));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 7));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 7));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 8));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 8));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 9));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 9));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 10));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 10));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 11));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 11));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 12));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 12));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 13));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 13));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 14));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 14));
+  store_row(&dst, stride, WINDOW(avg2_, mid2, AR, 15));
+  store_row(&dst, stride, WINDOW(avg3_, mid3, AR, 15));
+}
+
+void vpx_d117_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  // Moves the even pixels of each lane to its low half and the odd ones to
+  // its high half.
+  const __m256i deinterleave = _mm256_setr_epi8(
+      0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15, 0, 2, 4, 6, 8, 10,
+      12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+  const __m256i avg2 =
+      _mm256_avg_epu8(_mm256_loadu_si256((const __m256i *)(above - 1)),
+                      _mm256_loadu_si256((const __m256i *)above));
+  __m256i border[2], left_col, even, odd;
+
+  // The first column below row 1 alternates between the even and odd rows,
+  // which continue the rows two above them shifted right by one. Row 0 is
+  // preceded by the even pixels of the smoothed left column and row 1 by the
+  // odd ones.
+  d135_border_32(above, left, border);
+  left_col = _mm256_permute4x64_epi64(
+      _mm256_shuffle_epi8(border[0], deinterleave), 0xd8);
+  even = _mm256_permute2x128_si256(left_col, avg2, 0x20);
+  odd = _mm256_permute2x128_si256(left_col, border[1], 0x21);
+
+  store_row(&dst, stride, avg2);
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 15));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 15));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 14));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 14));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 13));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 13));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 12));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 12));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 11));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 11));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 10));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 10));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 9));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 9));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 8));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 8));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 7));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 7));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 6));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 6));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 5));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 5));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 4));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 4));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 3));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 3));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 2));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 2));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 1));
+  store_row(&dst, stride, _mm256_alignr_epi8(avg2, even, 1));
+  store_row(&dst, stride, _mm256_alignr_epi8(border[1], odd, 0));
+}
+
+void vpx_d135_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  __m256i border[2], mid;
+
+  d135_border_32(above, left, border);
+  mid = mid_lane(border[0], border[1]);
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 31));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 30));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 29));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 28));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 27));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 26));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 25));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 24));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 23));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 22));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 21));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 20));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 19));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 18));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 17));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 16));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 15));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 14));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 13));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 12));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 11));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 10));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 9));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 8));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 7));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 6));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 5));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 4));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 3));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 2));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 1));
+  store_row(&dst, stride, WINDOW(border[0], mid, border[1], 0));
+}
+
+void vpx_d153_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4,
+                                       3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                       7, 6, 5, 4, 3, 2, 1, 0);
+  const __m256i L = _mm256_loadu_si256((const __m256i *)left);
+  const __m256i E0 =
+      _mm256_permute4x64_epi64(_mm256_shuffle_epi8(L, rev), 0x4e);
+  const __m256i E1 = _mm256_loadu_si256((const __m256i *)(above - 1));
+  const __m256i avg2 =
+      _mm256_avg_epu8(E0, _mm256_alignr_epi8(mid_lane(E0, E1), E0, 1));
+  __m256i avg3[2], lo, hi, il0, il1, mid0, mid1;
+
+  // The first two columns interleave the AVG2 and AVG3 filtered left column
+  // from the bottom up, and each row continues the one above it shifted right
+  // by two.
+  d135_border_32(above, left, avg3);
+  lo = _mm256_unpacklo_epi8(avg2, avg3[0]);
+  hi = _mm256_unpackhi_epi8(avg2, avg3[0]);
+  il0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+  il1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+  mid0 = mid_lane(il0, il1);
+  mid1 = mid_lane(il1, avg3[1]);
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 30));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 28));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 26));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 24));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 22));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 20));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 18));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 16));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 14));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 12));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 10));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 8));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 6));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 4));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 2));
+  store_row(&dst, stride, WINDOW(il1, mid1, avg3[1], 0));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 30));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 28));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 26));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 24));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 22));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 20));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 18));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 16));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 14));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 12));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 10));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 8));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 6));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 4));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 2));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 0));
+}
+
+void vpx_d207_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m256i L0 = _mm256_loadu_si256((const __m256i *)left);
+  const __m256i fill = _mm256_set1_epi8((char)left[31]);
+  const __m256i mid = mid_lane(L0, fill);
+  const __m256i L1 = _mm256_alignr_epi8(mid, L0, 1);
+  const __m256i L2 = _mm256_alignr_epi8(mid, L0, 2);
+  const __m256i avg2 = _mm256_avg_epu8(L0, L1);
+  const __m256i avg3 = avg3_epu8(L0, L1, L2);
+  const __m256i lo = _mm256_unpacklo_epi8(avg2, avg3);
+  const __m256i hi = _mm256_unpackhi_epi8(avg2, avg3);
+  // The first two columns interleave the AVG2 and AVG3 filtered left column,
+  // and each row continues the one below it shifted left by two.
+  const __m256i il0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+  const __m256i il1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+  const __m256i mid0 = mid_lane(il0, il1);
+  const __m256i mid1 = mid_lane(il1, fill);
+  (void)above;
+
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 0));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 2));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 4));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 6));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 8));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 10));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 12));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 14));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 16));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 18));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 20));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 22));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 24));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 26));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 28));
+  store_row(&dst, stride, WINDOW(il0, mid0, il1, 30));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 0));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 2));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 4));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 6));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 8));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 10));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 12));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 14));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 16));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 18));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 20));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 22));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 24));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 26));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 28));
+  store_row(&dst, stride, WINDOW(il1, mid1, fill, 30));
+}
@@ -0,0 +1,265 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <tmmintrin.h>
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/mem_sse2.h"
+#include "vpx_ports/mem.h"
+
+// -----------------------------------------------------------------------------
+/*
+; ------------------------------------------
+; input: x, y, z, result
+;
+; trick from pascal
+; (x+2y+z+2)>>2 can be calculated as:
+; result = avg(x,z)
+; result -= xor(x,z) & 1
+; result = avg(result,y)
+; ------------------------------------------
+*/
+static INLINE __m128i avg3_epu8(const __m128i *x, const __m128i *y,
+                                const __m128i *z) {
+  const __m128i one = _mm_set1_epi8(1);
+  const __m128i a = _mm_avg_epu8(*x, *z);
+  const __m128i b = _mm_subs_epu8(a, _mm_and_si128(_mm_xor_si128(*x, *z), one));
+  return _mm_avg_epu8(b, *y);
+}
+
+DECLARE_ALIGNED(16, static const uint8_t,
+                rotate_right_epu8[16]) = { 1,  2,  3,  4,  5,  6,  7,  8,
+                                           9, 10, 11, 12, 13, 14, 15, 0 };
+
+DECLARE_ALIGNED(16, static const uint8_t,
+                reverse_epu8[16]) = { 15, 14, 13, 12, 11, 10, 9, 8,
+                                      7,  6,  5,  4,  3,  2,  1, 0 };
+
+static INLINE __m128i rotr_epu8(__m128i *a, const __m128i *rotrb) {
+  *a = _mm_shuffle_epi8(*a, *rotrb);
+  return *a;
+}
+
+// The 4x4 predictors gather the edge as LKJIXABCD, i.e., the left column from
+// bottom to top followed by the above row, and compute the whole block from
+// its smoothed version with a single shuffle.
+static INLINE __m128i load_edge_4x4(const uint8_t *above, const uint8_t *left) {
+  const __m128i gather = _mm_setr_epi8(3, 2, 1, 0, 8, 9, 10, 11, 12, -1, -1,
+                                       -1, -1, -1, -1, -1);
+  const __m128i IJKL = load_unaligned_u32(left);
+  const __m128i XABCDEFG = _mm_loadl_epi64((const __m128i *)(above - 1));
+  return _mm_shuffle_epi8(_mm_unpacklo_epi64(IJKL, XABCDEFG), gather);
+}
+
+void vpx_d117_predictor_4x4_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  // Rows 0 to 3 taken from avg3 (bytes 0 to 6) and avg2 (bytes 8 to 11).
+  const __m128i rows =
+      _mm_setr_epi8(8, 9, 10, 11, 3, 4, 5, 6, 2, 8, 9, 10, 1, 3, 4, 5);
+  const __m128i LKJIXABCD = load_edge_4x4(above, left);
+  const __m128i KJIXABCD0 = _mm_srli_si128(LKJIXABCD, 1);
+  const __m128i JIXABCD00 = _mm_srli_si128(LKJIXABCD, 2);
+  const __m128i avg3 = avg3_epu8(&LKJIXABCD, &KJIXABCD0, &JIXABCD00);
+  const __m128i avg2 = _mm_avg_epu8(KJIXABCD0, JIXABCD00);
+  const __m128i avg = _mm_unpacklo_epi64(avg3, _mm_srli_si128(avg2, 3));
+  store_8bit_4x4_sse2(_mm_shuffle_epi8(avg, rows), dst, stride);
+}
+
+void vpx_d117_predictor_8x8_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i rotrb = _mm_load_si128((const __m128i *)rotate_right_epu8);
+  const __m128i XABCDEFG = _mm_loadl_epi64((const __m128i *)(above - 1));
+  const __m128i ABCDEFGH = _mm_loadl_epi64((const __m128i *)above);
+  const __m128i IJKLMNOP = _mm_loadl_epi64((const __m128i *)left);
+  const __m128i IXABCDEF =
+      _mm_alignr_epi8(XABCDEFG, _mm_slli_si128(IJKLMNOP, 15), 15);
+  const __m128i avg3 = avg3_epu8(&ABCDEFGH, &XABCDEFG, &IXABCDEF);
+  const __m128i avg2 = _mm_avg_epu8(ABCDEFGH, XABCDEFG);
+  const __m128i XIJKLMNO =
+      _mm_alignr_epi8(IJKLMNOP, _mm_slli_si128(XABCDEFG, 15), 15);
+  const __m128i JKLMNOP0 = _mm_srli_si128(IJKLMNOP, 1);
+  __m128i avg3_left = avg3_epu8(&XIJKLMNO, &IJKLMNOP, &JKLMNOP0);
+  __m128i rowa = avg2;
+  __m128i rowb = avg3;
+  int i;
+  for (i = 0; i < 8; i += 2) {
+    _mm_storel_epi64((__m128i *)dst, rowa);
+    dst += stride;
+    _mm_storel_epi64((__m128i *)dst, rowb);
+    dst += stride;
+    rowa = _mm_alignr_epi8(rowa, rotr_epu8(&avg3_left, &rotrb), 15);
+    rowb = _mm_alignr_epi8(rowb, rotr_epu8(&avg3_left, &rotrb), 15);
+  }
+}
+
+void vpx_d117_predictor_16x16_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above, const uint8_t *left) {
+  const __m128i rotrb = _mm_load_si128((const __m128i *)rotate_right_epu8);
+  const __m128i A = _mm_load_si128((const __m128i *)above);
+  const __m128i B = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i L = _mm_load_si128((const __m128i *)left);
+  const __m128i C = _mm_alignr_epi8(B, _mm_slli_si128(L, 15), 15);
+  const __m128i avg3 = avg3_epu8(&A, &B, &C);
+  const __m128i avg2 = _mm_avg_epu8(A, B);
+  const __m128i XL = _mm_alignr_epi8(L, _mm_slli_si128(B, 15), 15);
+  const __m128i L_ = _mm_srli_si128(L, 1);
+  __m128i avg3_left = avg3_epu8(&XL, &L, &L_);
+  __m128i rowa = avg2;
+  __m128i rowb = avg3;
+  int i;
+  for (i = 0; i < 16; i += 2) {
+    _mm_store_si128((__m128i *)dst, rowa);
+    dst += stride;
+    _mm_store_si128((__m128i *)dst, rowb);
+    dst += stride;
+    rowa = _mm_alignr_epi8(rowa, rotr_epu8(&avg3_left, &rotrb), 15);
+    rowb = _mm_alignr_epi8(rowb, rotr_epu8(&avg3_left, &rotrb), 15);
+  }
+}
+
+void vpx_d117_predictor_32x32_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above, const uint8_t *left) {
+  const __m128i rotrb = _mm_load_si128((const __m128i *)rotate_right_epu8);
+  const __m128i A0 = _mm_load_si128((const __m128i *)above);
+  const __m128i A1 = _mm_load_si128((const __m128i *)(above + 16));
+  const __m128i B0 = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i B1 = _mm_loadu_si128((const __m128i *)(above + 15));
+  const __m128i L0 = _mm_load_si128((const __m128i *)left);
+  const __m128i L1 = _mm_load_si128((const __m128i *)(left + 16));
+  const __m128i C0 = _mm_alignr_epi8(B0, _mm_slli_si128(L0, 15), 15);
+  const __m128i C1 = _mm_alignr_epi8(B1, B0, 15);
+  const __m128i XL0 = _mm_alignr_epi8(L0, _mm_slli_si128(B0, 15), 15);
+  const __m128i XL1 = _mm_alignr_epi8(L1, L0, 15);
+  const __m128i L0_ = _mm_alignr_epi8(L1, L0, 1);
+  const __m128i L1_ = _mm_srli_si128(L1, 1);
+  __m128i rowa_0 = _mm_avg_epu8(A0, B0);
+  __m128i rowa_1 = _mm_avg_epu8(A1, B1);
+  __m128i rowb_0 = avg3_epu8(&A0, &B0, &C0);
+  __m128i rowb_1 = avg3_epu8(&A1, &B1, &C1);
+  __m128i avg3_left[2];
+  int i, j;
+  avg3_left[0] = avg3_epu8(&XL0, &L0, &L0_);
+  avg3_left[1] = avg3_epu8(&XL1, &L1, &L1_);
+  for (i = 0; i < 2; ++i) {
+    __m128i avg_left = avg3_left[i];
+    for (j = 0; j < 16; j += 2) {
+      _mm_store_si128((__m128i *)dst, rowa_0);
+      _mm_store_si128((__m128i *)(dst + 16), rowa_1);
+      dst += stride;
+      _mm_store_si128((__m128i *)dst, rowb_0);
+      _mm_store_si128((__m128i *)(dst + 16), rowb_1);
+      dst += stride;
+      rowa_1 = _mm_alignr_epi8(rowa_1, rowa_0, 15);
+      rowa_0 = _mm_alignr_epi8(rowa_0, rotr_epu8(&avg_left, &rotrb), 15);
+      rowb_1 = _mm_alignr_epi8(rowb_1, rowb_0, 15);
+      rowb_0 = _mm_alignr_epi8(rowb_0, rotr_epu8(&avg_left, &rotrb), 15);
+    }
+  }
+}
+
+// The d135 predictors smooth the edge running from the bottom of the left
+// column, through the corner, to the end of the above row. The bottom row is
+// the start of that border and each row above it starts one pixel later, so the
+// block is written from the bottom up.
+void vpx_d135_predictor_4x4_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i rows =
+      _mm_setr_epi8(3, 4, 5, 6, 2, 3, 4, 5, 1, 2, 3, 4, 0, 1, 2, 3);
+  const __m128i LKJIXABCD = load_edge_4x4(above, left);
+  const __m128i KJIXABCD0 = _mm_srli_si128(LKJIXABCD, 1);
+  const __m128i JIXABCD00 = _mm_srli_si128(LKJIXABCD, 2);
+  const __m128i avg3 = avg3_epu8(&LKJIXABCD, &KJIXABCD0, &JIXABCD00);
+  store_8bit_4x4_sse2(_mm_shuffle_epi8(avg3, rows), dst, stride);
+}
+
+void vpx_d135_predictor_8x8_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_epu8);
+  const __m128i XA = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i L =
+      _mm_shuffle_epi8(_mm_loadl_epi64((const __m128i *)left), rev);
+  const __m128i E0 = _mm_alignr_epi8(XA, L, 8);
+  const __m128i E1 = _mm_srli_si128(XA, 8);
+  const __m128i E0_1 = _mm_alignr_epi8(E1, E0, 1);
+  const __m128i E0_2 = _mm_alignr_epi8(E1, E0, 2);
+  __m128i border = avg3_epu8(&E0, &E0_1, &E0_2);
+  int i;
+  dst += 7 * stride;
+  for (i = 0; i < 8; ++i) {
+    _mm_storel_epi64((__m128i *)dst, border);
+    dst -= stride;
+    border = _mm_srli_si128(border, 1);
+  }
+}
+
+void vpx_d135_predictor_16x16_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above, const uint8_t *left) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_epu8);
+  const __m128i E0 =
+      _mm_shuffle_epi8(_mm_load_si128((const __m128i *)left), rev);
+  const __m128i E1 = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i E2 =
+      _mm_srli_si128(_mm_load_si128((const __m128i *)above), 15);
+  const __m128i E0_1 = _mm_alignr_epi8(E1, E0, 1);
+  const __m128i E0_2 = _mm_alignr_epi8(E1, E0, 2);
+  const __m128i E1_1 = _mm_alignr_epi8(E2, E1, 1);
+  const __m128i E1_2 = _mm_alignr_epi8(E2, E1, 2);
+  __m128i border_0 = avg3_epu8(&E0, &E0_1, &E0_2);
+  __m128i border_1 = avg3_epu8(&E1, &E1_1, &E1_2);
+  int i;
+  dst += 15 * stride;
+  for (i = 0; i < 16; ++i) {
+    _mm_store_si128((__m128i *)dst, border_0);
+    dst -= stride;
+    border_0 = _mm_alignr_epi8(border_1, border_0, 1);
+    border_1 = _mm_srli_si128(border_1, 1);
+  }
+}
+
+void vpx_d135_predictor_32x32_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above, const uint8_t *left) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_epu8);
+  const __m128i E0 =
+      _mm_shuffle_epi8(_mm_load_si128((const __m128i *)(left + 16)), rev);
+  const __m128i E1 =
+      _mm_shuffle_epi8(_mm_load_si128((const __m128i *)left), rev);
+  const __m128i E2 = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i E3 = _mm_loadu_si128((const __m128i *)(above + 15));
+  const __m128i E4 =
+      _mm_srli_si128(_mm_load_si128((const __m128i *)(above + 16)), 15);
+  const __m128i E0_1 = _mm_alignr_epi8(E1, E0, 1);
+  const __m128i E0_2 = _mm_alignr_epi8(E1, E0, 2);
+  const __m128i E1_1 = _mm_alignr_epi8(E2, E1, 1);
+  const __m128i E1_2 = _mm_alignr_epi8(E2, E1, 2);
+  const __m128i E2_1 = _mm_alignr_epi8(E3, E2, 1);
+  const __m128i E2_2 = _mm_alignr_epi8(E3, E2, 2);
+  const __m128i E3_1 = _mm_alignr_epi8(E4, E3, 1);
+  const __m128i E3_2 = _mm_alignr_epi8(E4, E3, 2);
+  __m128i border_0 = avg3_epu8(&E0, &E0_1, &E0_2);
+  __m128i border_1 = avg3_epu8(&E1, &E1_1, &E1_2);
+  __m128i border_2 = avg3_epu8(&E2, &E2_1, &E2_2);
+  __m128i border_3 = avg3_epu8(&E3, &E3_1, &E3_2);
+  int i;
+  // Rows i and i + 16 share their border pixels 16 to 31.
+  dst += 31 * stride;
+  for (i = 0; i < 16; ++i) {
+    _mm_store_si128((__m128i *)dst, border_0);
+    _mm_store_si128((__m128i *)(dst + 16), border_1);
+    _mm_store_si128((__m128i *)(dst - 16 * stride), border_1);
+    _mm_store_si128((__m128i *)(dst - 16 * stride + 16), border_2);
+    dst -= stride;
+    border_0 = _mm_alignr_epi8(border_1, border_0, 1);
+    border_1 = _mm_alignr_epi8(border_2, border_1, 1);
+    border_2 = _mm_alignr_epi8(border_3, border_2, 1);
+    border_3 = _mm_srli_si128(border_3, 1);
+  }
+}
@@ -0,0 +1,1162 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/x86/inv_txfm_avx2.h"
+
+// Each __m256i holds one 16-bit coefficient from 16 different rows (or
+// columns), so a single pass of the 1-D kernels below transforms a 16-wide
+// strip. This halves the number of kernel invocations compared to the SSE2
+// versions, which work on 8-wide strips.
+
+static INLINE __m256i butterfly_cospi16_avx2(const __m256i in) {
+  const __m256i cst = pair256_set_epi16(cospi_16_64, cospi_16_64);
+  const __m256i lo = _mm256_unpacklo_epi16(in, _mm256_setzero_si256());
+  const __m256i hi = _mm256_unpackhi_epi16(in, _mm256_setzero_si256());
+  return idct_calc_wraplow_avx2(lo, hi, cst);
+}
+
+// Only do addition and subtraction butterfly, size = 16, 32
+static INLINE void add_sub_butterfly_avx2(const __m256i *in, __m256i *out,
+                                          int size) {
+  int i = 0;
+  const int num = size >> 1;
+  const int bound = size - 1;
+  while (i < num) {
+    out[i] = _mm256_add_epi16(in[i], in[bound - i]);
+    out[bound - i] = _mm256_sub_epi16(in[i], in[bound - i]);
+    i++;
+  }
+}
+
+static INLINE void load_buffer_16x16(const tran_low_t *const input,
+                                     const int stride, const int rows,
+                                     __m256i *const in) {
+  int i;
+  for (i = 0; i < rows; ++i) {
+    in[i] = load_input_data16_avx2(input + i * stride);
+  }
+  for (; i < 16; ++i) {
+    in[i] = _mm256_setzero_si256();
+  }
+}
+
+static INLINE void dc_only_recon_avx2(const tran_low_t *input, uint8_t *dest,
+                                      int stride, const int size) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i dc_value;
+  int i, j;
+  tran_high_t a1;
+  tran_low_t out =
+      WRAPLOW(dct_const_round_shift((int16_t)input[0] * cospi_16_64));
+
+  out = WRAPLOW(dct_const_round_shift(out * cospi_16_64));
+  a1 = ROUND_POWER_OF_TWO(out, 6);
+  dc_value = _mm256_set1_epi16((int16_t)a1);
+
+  for (i = 0; i < size; ++i) {
+    for (j = 0; j < size; j += 32) {
+      // For 16-wide blocks the upper 128 bits are don't-care.
+      const __m256i d = (size == 16)
+                            ? _mm256_castsi128_si256(
+                                  _mm_loadu_si128((const __m128i *)(dest + j)))
+                            : _mm256_loadu_si256((const __m256i *)(dest + j));
+      const __m256i d0 = _mm256_add_epi16(_mm256_unpacklo_epi8(d, zero),
+                                          dc_value);
+      const __m256i d1 = _mm256_add_epi16(_mm256_unpackhi_epi8(d, zero),
+                                          dc_value);
+      const __m256i r = _mm256_packus_epi16(d0, d1);
+      if (size == 16) {
+        _mm_storeu_si128((__m128i *)(dest + j), _mm256_castsi256_si128(r));
+      } else {
+        _mm256_storeu_si256((__m256i *)(dest + j), r);
+      }
+    }
+    dest += stride;
+  }
+}
+
+// The 8-point kernels hold two rows per register. Both halves of a register
+// go through the same multiplies with different constants, so one call
+// computes two outputs of a butterfly.
+void idct8_avx2(__m256i *const in /*in[4]*/) {
+  const __m256i k_step1_4_7 =
+      pair_pair256_set_epi16(cospi_28_64, -cospi_4_64, cospi_4_64,
+                             cospi_28_64);
+  const __m256i k_step1_5_6 =
+      pair_pair256_set_epi16(cospi_12_64, -cospi_20_64, cospi_20_64,
+                             cospi_12_64);
+  const __m256i k_step2_0_1 = pair_pair256_set_epi16(
+      cospi_16_64, cospi_16_64, cospi_16_64, -cospi_16_64);
+  const __m256i k_step2_3_2 =
+      pair_pair256_set_epi16(cospi_8_64, cospi_24_64, cospi_24_64,
+                             -cospi_8_64);
+  const __m256i k_step1_6_5 = pair_pair256_set_epi16(
+      cospi_16_64, cospi_16_64, -cospi_16_64, cospi_16_64);
+  // Copy each input row to both halves.
+  const __m256i in0 = _mm256_permute4x64_epi64(in[0], 0x44);
+  const __m256i in1 = _mm256_permute4x64_epi64(in[0], 0xee);
+  const __m256i in2 = _mm256_permute4x64_epi64(in[1], 0x44);
+  const __m256i in3 = _mm256_permute4x64_epi64(in[1], 0xee);
+  const __m256i in4 = _mm256_permute4x64_epi64(in[2], 0x44);
+  const __m256i in5 = _mm256_permute4x64_epi64(in[2], 0xee);
+  const __m256i in6 = _mm256_permute4x64_epi64(in[3], 0x44);
+  const __m256i in7 = _mm256_permute4x64_epi64(in[3], 0xee);
+  __m256i step1[4], step2[4], sum[2], diff[2];
+
+  // stage 1
+  step1[0] = mult_round_shift_lanes_avx2(in1, in7, k_step1_4_7);  // 4 | 7
+  step1[1] = mult_round_shift_lanes_avx2(in5, in3, k_step1_5_6);  // 5 | 6
+
+  // stage 2
+  step2[0] = mult_round_shift_lanes_avx2(in0, in4, k_step2_0_1);  // 0 | 1
+  step2[1] = mult_round_shift_lanes_avx2(in2, in6, k_step2_3_2);  // 3 | 2
+  step2[2] = _mm256_add_epi16(step1[0], step1[1]);                // 4 | 7
+  step2[3] = _mm256_sub_epi16(step1[0], step1[1]);                // 5 | 6
+
+  // stage 3
+  step1[0] = _mm256_add_epi16(step2[0], step2[1]);  // 0 | 1
+  step1[1] = _mm256_sub_epi16(step2[0], step2[1]);  // 3 | 2
+  step1[2] = mult_round_shift_lanes_avx2(
+      _mm256_permute4x64_epi64(step2[3], 0x4e), step2[3], k_step1_6_5);
+  step1[3] = _mm256_permute2x128_si256(step1[0], step1[1], 0x20);  // 0 | 3
+  step1[0] = _mm256_permute2x128_si256(step1[0], step1[1], 0x31);  // 1 | 2
+  step2[2] = _mm256_permute4x64_epi64(step2[2], 0x4e);             // 7 | 4
+
+  // stage 4
+  sum[0] = _mm256_add_epi16(step1[3], step2[2]);   // 0 | 3
+  diff[0] = _mm256_sub_epi16(step1[3], step2[2]);  // 7 | 4
+  sum[1] = _mm256_add_epi16(step1[0], step1[2]);   // 1 | 2
+  diff[1] = _mm256_sub_epi16(step1[0], step1[2]);  // 6 | 5
+  in[0] = _mm256_blend_epi32(sum[0], diff[0], 0xf0);
+  in[1] = _mm256_blend_epi32(sum[1], diff[1], 0xf0);
+  in[2] = _mm256_permute2x128_si256(sum[1], diff[1], 0x21);
+  in[3] = _mm256_permute2x128_si256(sum[0], diff[0], 0x21);
+}
+
+void idct16_avx2(__m256i *const in /*in[16]*/) {
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  butterfly_avx2(in[1], in[15], cospi_30_64, cospi_2_64, &step2[8], &step2[15]);
+  butterfly_avx2(in[9], in[7], cospi_14_64, cospi_18_64, &step2[9], &step2[14]);
+  butterfly_avx2(in[5], in[11], cospi_22_64, cospi_10_64, &step2[10],
+                 &step2[13]);
+  butterfly_avx2(in[13], in[3], cospi_6_64, cospi_26_64, &step2[11],
+                 &step2[12]);
+
+  // stage 3
+  butterfly_avx2(in[2], in[14], cospi_28_64, cospi_4_64, &step1[4], &step1[7]);
+  butterfly_avx2(in[10], in[6], cospi_12_64, cospi_20_64, &step1[5], &step1[6]);
+  step1[8] = _mm256_add_epi16(step2[8], step2[9]);
+  step1[9] = _mm256_sub_epi16(step2[8], step2[9]);
+  step1[10] = _mm256_sub_epi16(step2[11], step2[10]);
+  step1[11] = _mm256_add_epi16(step2[10], step2[11]);
+  step1[12] = _mm256_add_epi16(step2[12], step2[13]);
+  step1[13] = _mm256_sub_epi16(step2[12], step2[13]);
+  step1[14] = _mm256_sub_epi16(step2[15], step2[14]);
+  step1[15] = _mm256_add_epi16(step2[14], step2[15]);
+
+  // stage 4
+  butterfly_avx2(in[0], in[8], cospi_16_64, cospi_16_64, &step2[1], &step2[0]);
+  butterfly_avx2(in[4], in[12], cospi_24_64, cospi_8_64, &step2[2], &step2[3]);
+  butterfly_avx2(step1[14], step1[9], cospi_24_64, cospi_8_64, &step2[9],
+                 &step2[14]);
+  butterfly_avx2(step1[10], step1[13], -cospi_8_64, -cospi_24_64, &step2[13],
+                 &step2[10]);
+  step2[5] = _mm256_sub_epi16(step1[4], step1[5]);
+  step1[4] = _mm256_add_epi16(step1[4], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[7], step1[6]);
+  step1[7] = _mm256_add_epi16(step1[6], step1[7]);
+  step2[8] = step1[8];
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+  step2[15] = step1[15];
+
+  // stage 5
+  step1[0] = _mm256_add_epi16(step2[0], step2[3]);
+  step1[1] = _mm256_add_epi16(step2[1], step2[2]);
+  step1[2] = _mm256_sub_epi16(step2[1], step2[2]);
+  step1[3] = _mm256_sub_epi16(step2[0], step2[3]);
+  butterfly_avx2(step2[6], step2[5], cospi_16_64, cospi_16_64, &step1[5],
+                 &step1[6]);
+  step1[8] = _mm256_add_epi16(step2[8], step2[11]);
+  step1[9] = _mm256_add_epi16(step2[9], step2[10]);
+  step1[10] = _mm256_sub_epi16(step2[9], step2[10]);
+  step1[11] = _mm256_sub_epi16(step2[8], step2[11]);
+  step1[12] = _mm256_sub_epi16(step2[15], step2[12]);
+  step1[13] = _mm256_sub_epi16(step2[14], step2[13]);
+  step1[14] = _mm256_add_epi16(step2[14], step2[13]);
+  step1[15] = _mm256_add_epi16(step2[15], step2[12]);
+
+  // stage 6
+  step2[0] = _mm256_add_epi16(step1[0], step1[7]);
+  step2[1] = _mm256_add_epi16(step1[1], step1[6]);
+  step2[2] = _mm256_add_epi16(step1[2], step1[5]);
+  step2[3] = _mm256_add_epi16(step1[3], step1[4]);
+  step2[4] = _mm256_sub_epi16(step1[3], step1[4]);
+  step2[5] = _mm256_sub_epi16(step1[2], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[1], step1[6]);
+  step2[7] = _mm256_sub_epi16(step1[0], step1[7]);
+  butterfly_avx2(step1[13], step1[10], cospi_16_64, cospi_16_64, &step2[10],
+                 &step2[13]);
+  butterfly_avx2(step1[12], step1[11], cospi_16_64, cospi_16_64, &step2[11],
+                 &step2[12]);
+
+  // stage 7
+  in[0] = _mm256_add_epi16(step2[0], step1[15]);
+  in[1] = _mm256_add_epi16(step2[1], step1[14]);
+  in[2] = _mm256_add_epi16(step2[2], step2[13]);
+  in[3] = _mm256_add_epi16(step2[3], step2[12]);
+  in[4] = _mm256_add_epi16(step2[4], step2[11]);
+  in[5] = _mm256_add_epi16(step2[5], step2[10]);
+  in[6] = _mm256_add_epi16(step2[6], step1[9]);
+  in[7] = _mm256_add_epi16(step2[7], step1[8]);
+  in[8] = _mm256_sub_epi16(step2[7], step1[8]);
+  in[9] = _mm256_sub_epi16(step2[6], step1[9]);
+  in[10] = _mm256_sub_epi16(step2[5], step2[10]);
+  in[11] = _mm256_sub_epi16(step2[4], step2[11]);
+  in[12] = _mm256_sub_epi16(step2[3], step2[12]);
+  in[13] = _mm256_sub_epi16(step2[2], step2[13]);
+  in[14] = _mm256_sub_epi16(step2[1], step1[14]);
+  in[15] = _mm256_sub_epi16(step2[0], step1[15]);
+}
+
+// Returns the products a * k0 + b * k1 in 32 bits, for the low and high
+// halves of each 128-bit lane in out[0] and out[1]. The constant pairs
+// (k0, k1) are interleaved in |k|.
+static INLINE void madd_pair_lanes_avx2(const __m256i a, const __m256i b,
+                                        const __m256i k,
+                                        __m256i *const out /*out[2]*/) {
+  out[0] = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), k);
+  out[1] = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), k);
+}
+
+static INLINE void madd_pair_avx2(const __m256i a, const __m256i b,
+                                  const int c0, const int c1,
+                                  __m256i *const out /*out[2]*/) {
+  madd_pair_lanes_avx2(a, b, pair256_set_epi16(c0, c1), out);
+}
+
+// Returns the rounded sum (or difference) of two madd_pair_avx2() results,
+// packed back to 16 bits with saturation.
+static INLINE __m256i add_round_shift_avx2(const __m256i *const a,
+                                           const __m256i *const b) {
+  const __m256i lo = dct_const_round_shift_avx2(_mm256_add_epi32(a[0], b[0]));
+  const __m256i hi = dct_const_round_shift_avx2(_mm256_add_epi32(a[1], b[1]));
+  return _mm256_packs_epi32(lo, hi);
+}
+
+static INLINE __m256i sub_round_shift_avx2(const __m256i *const a,
+                                           const __m256i *const b) {
+  const __m256i lo = dct_const_round_shift_avx2(_mm256_sub_epi32(a[0], b[0]));
+  const __m256i hi = dct_const_round_shift_avx2(_mm256_sub_epi32(a[1], b[1]));
+  return _mm256_packs_epi32(lo, hi);
+}
+
+// Returns the rounded a * c0 + b * c1, packed back to 16 bits with saturation.
+static INLINE __m256i mult_round_shift_avx2(const __m256i a, const __m256i b,
+                                            const int c0, const int c1) {
+  __m256i p[2];
+  madd_pair_avx2(a, b, c0, c1, p);
+  return _mm256_packs_epi32(dct_const_round_shift_avx2(p[0]),
+                            dct_const_round_shift_avx2(p[1]));
+}
+
+// The operations match iadst8_sse2(), so the results are the same. The forward
+// ADST of vp9_fht8x8() uses the same butterflies.
+void iadst8_avx2(__m256i *const in /*in[4]*/) {
+  const __m256i k_s0_s2 = pair_pair256_set_epi16(cospi_2_64, cospi_30_64,
+                                                 cospi_10_64, cospi_22_64);
+  const __m256i k_s1_s3 = pair_pair256_set_epi16(cospi_30_64, -cospi_2_64,
+                                                 cospi_22_64, -cospi_10_64);
+  const __m256i k_s4_s6 = pair_pair256_set_epi16(cospi_18_64, cospi_14_64,
+                                                 cospi_26_64, cospi_6_64);
+  const __m256i k_s5_s7 = pair_pair256_set_epi16(cospi_14_64, -cospi_18_64,
+                                                 cospi_6_64, -cospi_26_64);
+  const __m256i k_s4_s6_2 = pair_pair256_set_epi16(cospi_8_64, cospi_24_64,
+                                                   -cospi_24_64, cospi_8_64);
+  const __m256i k_s5_s7_2 = pair_pair256_set_epi16(cospi_24_64, -cospi_8_64,
+                                                   cospi_8_64, cospi_24_64);
+  const __m256i k_s2_s3 = pair_pair256_set_epi16(cospi_16_64, cospi_16_64,
+                                                 -cospi_16_64, cospi_16_64);
+  const __m256i kZero = _mm256_setzero_si256();
+  __m256i x[6], p[4][2], q[2][2];
+  int i;
+
+  // properly aligned for butterfly input
+  x[0] = _mm256_permute2x128_si256(in[3], in[2], 0x31);  // in7 | in5
+  x[1] = _mm256_permute2x128_si256(in[0], in[1], 0x20);  // in0 | in2
+  x[2] = _mm256_permute2x128_si256(in[1], in[0], 0x31);  // in3 | in1
+  x[3] = _mm256_permute2x128_si256(in[2], in[3], 0x20);  // in4 | in6
+
+  // stage 1
+  madd_pair_lanes_avx2(x[0], x[1], k_s0_s2, p[0]);
+  madd_pair_lanes_avx2(x[0], x[1], k_s1_s3, p[1]);
+  madd_pair_lanes_avx2(x[2], x[3], k_s4_s6, p[2]);
+  madd_pair_lanes_avx2(x[2], x[3], k_s5_s7, p[3]);
+  x[0] = add_round_shift_avx2(p[0], p[2]);  // 0 | 2
+  x[1] = add_round_shift_avx2(p[1], p[3]);  // 1 | 3
+  x[2] = sub_round_shift_avx2(p[0], p[2]);  // 4 | 6
+  x[3] = sub_round_shift_avx2(p[1], p[3]);  // 5 | 7
+
+  // stage 2
+  x[4] = _mm256_permute2x128_si256(x[0], x[1], 0x20);  // 0 | 1
+  x[5] = _mm256_permute2x128_si256(x[0], x[1], 0x31);  // 2 | 3
+  x[0] = _mm256_add_epi16(x[4], x[5]);                 // 0 | 1
+  x[1] = _mm256_sub_epi16(x[4], x[5]);                 // 2 | 3
+  madd_pair_lanes_avx2(x[2], x[3], k_s4_s6_2, p[0]);
+  madd_pair_lanes_avx2(x[2], x[3], k_s5_s7_2, p[1]);
+  for (i = 0; i < 2; ++i) {
+    q[0][i] = _mm256_permute2x128_si256(p[0][i], p[1][i], 0x20);  // 4 | 5
+    q[1][i] = _mm256_permute2x128_si256(p[0][i], p[1][i], 0x31);  // 6 | 7
+  }
+  x[2] = add_round_shift_avx2(q[0], q[1]);  // 4 | 5
+  x[3] = sub_round_shift_avx2(q[0], q[1]);  // 6 | 7
+
+  // stage 3
+  x[1] = mult_round_shift_lanes_avx2(
+      x[1], _mm256_permute4x64_epi64(x[1], 0x4e), k_s2_s3);  // 2 | 3
+  x[3] = mult_round_shift_lanes_avx2(
+      x[3], _mm256_permute4x64_epi64(x[3], 0x4e), k_s2_s3);  // 6 | 7
+
+  in[0] = _mm256_blend_epi32(x[0], x[1], 0xf0);
+  in[1] = _mm256_sub_epi16(kZero, _mm256_blend_epi32(x[2], x[3], 0xf0));
+  in[2] = _mm256_blend_epi32(x[3], x[2], 0xf0);
+  in[3] = _mm256_sub_epi16(kZero, _mm256_blend_epi32(x[1], x[0], 0xf0));
+}
+
+// The operations match vpx_iadst16_8col_sse2() one for one, so the results are
+// the same. The forward ADST of vp9_fht16x16() uses the same butterflies.
+void iadst16_avx2(__m256i *const in /*in[16]*/) {
+  __m256i s[16], x[16], p[16][2];
+  int i;
+
+  // stage 1
+  madd_pair_avx2(in[15], in[0], cospi_1_64, cospi_31_64, p[0]);
+  madd_pair_avx2(in[15], in[0], cospi_31_64, -cospi_1_64, p[1]);
+  madd_pair_avx2(in[13], in[2], cospi_5_64, cospi_27_64, p[2]);
+  madd_pair_avx2(in[13], in[2], cospi_27_64, -cospi_5_64, p[3]);
+  madd_pair_avx2(in[11], in[4], cospi_9_64, cospi_23_64, p[4]);
+  madd_pair_avx2(in[11], in[4], cospi_23_64, -cospi_9_64, p[5]);
+  madd_pair_avx2(in[9], in[6], cospi_13_64, cospi_19_64, p[6]);
+  madd_pair_avx2(in[9], in[6], cospi_19_64, -cospi_13_64, p[7]);
+  madd_pair_avx2(in[7], in[8], cospi_17_64, cospi_15_64, p[8]);
+  madd_pair_avx2(in[7], in[8], cospi_15_64, -cospi_17_64, p[9]);
+  madd_pair_avx2(in[5], in[10], cospi_21_64, cospi_11_64, p[10]);
+  madd_pair_avx2(in[5], in[10], cospi_11_64, -cospi_21_64, p[11]);
+  madd_pair_avx2(in[3], in[12], cospi_25_64, cospi_7_64, p[12]);
+  madd_pair_avx2(in[3], in[12], cospi_7_64, -cospi_25_64, p[13]);
+  madd_pair_avx2(in[1], in[14], cospi_29_64, cospi_3_64, p[14]);
+  madd_pair_avx2(in[1], in[14], cospi_3_64, -cospi_29_64, p[15]);
+
+  for (i = 0; i < 8; ++i) {
+    s[i] = add_round_shift_avx2(p[i], p[i + 8]);
+    s[i + 8] = sub_round_shift_avx2(p[i], p[i + 8]);
+  }
+
+  // stage 2
+  madd_pair_avx2(s[8], s[9], cospi_4_64, cospi_28_64, p[0]);
+  madd_pair_avx2(s[8], s[9], cospi_28_64, -cospi_4_64, p[1]);
+  madd_pair_avx2(s[10], s[11], cospi_20_64, cospi_12_64, p[2]);
+  madd_pair_avx2(s[10], s[11], cospi_12_64, -cospi_20_64, p[3]);
+  madd_pair_avx2(s[12], s[13], -cospi_28_64, cospi_4_64, p[4]);
+  madd_pair_avx2(s[12], s[13], cospi_4_64, cospi_28_64, p[5]);
+  madd_pair_avx2(s[14], s[15], -cospi_12_64, cospi_20_64, p[6]);
+  madd_pair_avx2(s[14], s[15], cospi_20_64, cospi_12_64, p[7]);
+
+  for (i = 0; i < 4; ++i) {
+    x[i] = _mm256_add_epi16(s[i], s[i + 4]);
+    x[i + 4] = _mm256_sub_epi16(s[i], s[i + 4]);
+    x[i + 8] = add_round_shift_avx2(p[i], p[i + 4]);
+    x[i + 12] = sub_round_shift_avx2(p[i], p[i + 4]);
+  }
+
+  // stage 3
+  madd_pair_avx2(x[4], x[5], cospi_8_64, cospi_24_64, p[0]);
+  madd_pair_avx2(x[4], x[5], cospi_24_64, -cospi_8_64, p[1]);
+  madd_pair_avx2(x[6], x[7], -cospi_24_64, cospi_8_64, p[2]);
+  madd_pair_avx2(x[6], x[7], cospi_8_64, cospi_24_64, p[3]);
+  madd_pair_avx2(x[12], x[13], cospi_8_64, cospi_24_64, p[4]);
+  madd_pair_avx2(x[12], x[13], cospi_24_64, -cospi_8_64, p[5]);
+  madd_pair_avx2(x[14], x[15], -cospi_24_64, cospi_8_64, p[6]);
+  madd_pair_avx2(x[14], x[15], cospi_8_64, cospi_24_64, p[7]);
+
+  for (i = 0; i < 2; ++i) {
+    s[i] = _mm256_add_epi16(x[i], x[i + 2]);
+    s[i + 2] = _mm256_sub_epi16(x[i], x[i + 2]);
+    s[i + 4] = add_round_shift_avx2(p[i], p[i + 2]);
+    s[i + 6] = sub_round_shift_avx2(p[i], p[i + 2]);
+    s[i + 8] = _mm256_add_epi16(x[i + 8], x[i + 10]);
+    s[i + 10] = _mm256_sub_epi16(x[i + 8], x[i + 10]);
+    s[i + 12] = add_round_shift_avx2(p[i + 4], p[i + 6]);
+    s[i + 14] = sub_round_shift_avx2(p[i + 4], p[i + 6]);
+  }
+
+  // stage 4
+  in[7] = mult_round_shift_avx2(s[2], s[3], -cospi_16_64, -cospi_16_64);
+  in[8] = mult_round_shift_avx2(s[2], s[3], cospi_16_64, -cospi_16_64);
+  in[4] = mult_round_shift_avx2(s[6], s[7], cospi_16_64, cospi_16_64);
+  in[11] = mult_round_shift_avx2(s[6], s[7], -cospi_16_64, cospi_16_64);
+  in[6] = mult_round_shift_avx2(s[10], s[11], cospi_16_64, cospi_16_64);
+  in[9] = mult_round_shift_avx2(s[10], s[11], -cospi_16_64, cospi_16_64);
+  in[5] = mult_round_shift_avx2(s[14], s[15], -cospi_16_64, -cospi_16_64);
+  in[10] = mult_round_shift_avx2(s[14], s[15], cospi_16_64, -cospi_16_64);
+
+  in[0] = s[0];
+  in[1] = _mm256_sub_epi16(_mm256_setzero_si256(), s[8]);
+  in[2] = s[12];
+  in[3] = _mm256_sub_epi16(_mm256_setzero_si256(), s[4]);
+  in[12] = s[5];
+  in[13] = _mm256_sub_epi16(_mm256_setzero_si256(), s[13]);
+  in[14] = s[9];
+  in[15] = _mm256_sub_epi16(_mm256_setzero_si256(), s[1]);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The high bit depth 16-point transforms below repeat idct16_avx2() and
+// iadst16_avx2() on eight 32-bit columns per register, with the products and
+// their sums formed in 64 bits as vpx_highbd_idct16_c() and
+// vpx_highbd_iadst16_c() do.
+
+static INLINE void highbd_madd_pair_avx2(const __m256i a, const __m256i b,
+                                         const int c0, const int c1,
+                                         __m256i *const out /*out[2]*/) {
+  highbd_madd_epi32_avx2(a, b, _mm256_set1_epi32(c0), _mm256_set1_epi32(c1),
+                         out);
+}
+
+static INLINE __m256i highbd_add_round_shift_avx2(const __m256i *const a,
+                                                  const __m256i *const b) {
+  __m256i sum[2];
+  sum[0] = _mm256_add_epi64(a[0], b[0]);
+  sum[1] = _mm256_add_epi64(a[1], b[1]);
+  return highbd_round_shift_avx2(sum);
+}
+
+static INLINE __m256i highbd_sub_round_shift_avx2(const __m256i *const a,
+                                                  const __m256i *const b) {
+  __m256i diff[2];
+  diff[0] = _mm256_sub_epi64(a[0], b[0]);
+  diff[1] = _mm256_sub_epi64(a[1], b[1]);
+  return highbd_round_shift_avx2(diff);
+}
+
+static INLINE __m256i highbd_madd_round_shift_avx2(const __m256i a,
+                                                   const __m256i b,
+                                                   const int c0,
+                                                   const int c1) {
+  __m256i p[2];
+  highbd_madd_pair_avx2(a, b, c0, c1, p);
+  return highbd_round_shift_avx2(p);
+}
+
+static INLINE void highbd_butterfly_avx2(const __m256i in0, const __m256i in1,
+                                         const int c0, const int c1,
+                                         __m256i *const out0,
+                                         __m256i *const out1) {
+  *out0 = highbd_madd_round_shift_avx2(in0, in1, c0, -c1);
+  *out1 = highbd_madd_round_shift_avx2(in0, in1, c1, c0);
+}
+
+void highbd_idct16_avx2(__m256i *const in /*in[16]*/) {
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  highbd_butterfly_avx2(in[1], in[15], cospi_30_64, cospi_2_64, &step2[8],
+                        &step2[15]);
+  highbd_butterfly_avx2(in[9], in[7], cospi_14_64, cospi_18_64, &step2[9],
+                        &step2[14]);
+  highbd_butterfly_avx2(in[5], in[11], cospi_22_64, cospi_10_64, &step2[10],
+                        &step2[13]);
+  highbd_butterfly_avx2(in[13], in[3], cospi_6_64, cospi_26_64, &step2[11],
+                        &step2[12]);
+
+  // stage 3
+  highbd_butterfly_avx2(in[2], in[14], cospi_28_64, cospi_4_64, &step1[4],
+                        &step1[7]);
+  highbd_butterfly_avx2(in[10], in[6], cospi_12_64, cospi_20_64, &step1[5],
+                        &step1[6]);
+  step1[8] = _mm256_add_epi32(step2[8], step2[9]);
+  step1[9] = _mm256_sub_epi32(step2[8], step2[9]);
+  step1[10] = _mm256_sub_epi32(step2[11], step2[10]);
+  step1[11] = _mm256_add_epi32(step2[10], step2[11]);
+  step1[12] = _mm256_add_epi32(step2[12], step2[13]);
+  step1[13] = _mm256_sub_epi32(step2[12], step2[13]);
+  step1[14] = _mm256_sub_epi32(step2[15], step2[14]);
+  step1[15] = _mm256_add_epi32(step2[14], step2[15]);
+
+  // stage 4
+  highbd_butterfly_avx2(in[0], in[8], cospi_16_64, cospi_16_64, &step2[1],
+                        &step2[0]);
+  highbd_butterfly_avx2(in[4], in[12], cospi_24_64, cospi_8_64, &step2[2],
+                        &step2[3]);
+  highbd_butterfly_avx2(step1[14], step1[9], cospi_24_64, cospi_8_64, &step2[9],
+                        &step2[14]);
+  highbd_butterfly_avx2(step1[10], step1[13], -cospi_8_64, -cospi_24_64,
+                        &step2[13], &step2[10]);
+  step2[5] = _mm256_sub_epi32(step1[4], step1[5]);
+  step1[4] = _mm256_add_epi32(step1[4], step1[5]);
+  step2[6] = _mm256_sub_epi32(step1[7], step1[6]);
+  step1[7] = _mm256_add_epi32(step1[6], step1[7]);
+  step2[8] = step1[8];
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+  step2[15] = step1[15];
+
+  // stage 5
+  step1[0] = _mm256_add_epi32(step2[0], step2[3]);
+  step1[1] = _mm256_add_epi32(step2[1], step2[2]);
+  step1[2] = _mm256_sub_epi32(step2[1], step2[2]);
+  step1[3] = _mm256_sub_epi32(step2[0], step2[3]);
+  highbd_butterfly_avx2(step2[6], step2[5], cospi_16_64, cospi_16_64, &step1[5],
+                        &step1[6]);
+  step1[8] = _mm256_add_epi32(step2[8], step2[11]);
+  step1[9] = _mm256_add_epi32(step2[9], step2[10]);
+  step1[10] = _mm256_sub_epi32(step2[9], step2[10]);
+  step1[11] = _mm256_sub_epi32(step2[8], step2[11]);
+  step1[12] = _mm256_sub_epi32(step2[15], step2[12]);
+  step1[13] = _mm256_sub_epi32(step2[14], step2[13]);
+  step1[14] = _mm256_add_epi32(step2[14], step2[13]);
+  step1[15] = _mm256_add_epi32(step2[15], step2[12]);
+
+  // stage 6
+  step2[0] = _mm256_add_epi32(step1[0], step1[7]);
+  step2[1] = _mm256_add_epi32(step1[1], step1[6]);
+  step2[2] = _mm256_add_epi32(step1[2], step1[5]);
+  step2[3] = _mm256_add_epi32(step1[3], step1[4]);
+  step2[4] = _mm256_sub_epi32(step1[3], step1[4]);
+  step2[5] = _mm256_sub_epi32(step1[2], step1[5]);
+  step2[6] = _mm256_sub_epi32(step1[1], step1[6]);
+  step2[7] = _mm256_sub_epi32(step1[0], step1[7]);
+  highbd_butterfly_avx2(step1[13], step1[10], cospi_16_64, cospi_16_64,
+                        &step2[10], &step2[13]);
+  highbd_butterfly_avx2(step1[12], step1[11], cospi_16_64, cospi_16_64,
+                        &step2[11], &step2[12]);
+
+  // stage 7
+  in[0] = _mm256_add_epi32(step2[0], step1[15]);
+  in[1] = _mm256_add_epi32(step2[1], step1[14]);
+  in[2] = _mm256_add_epi32(step2[2], step2[13]);
+  in[3] = _mm256_add_epi32(step2[3], step2[12]);
+  in[4] = _mm256_add_epi32(step2[4], step2[11]);
+  in[5] = _mm256_add_epi32(step2[5], step2[10]);
+  in[6] = _mm256_add_epi32(step2[6], step1[9]);
+  in[7] = _mm256_add_epi32(step2[7], step1[8]);
+  in[8] = _mm256_sub_epi32(step2[7], step1[8]);
+  in[9] = _mm256_sub_epi32(step2[6], step1[9]);
+  in[10] = _mm256_sub_epi32(step2[5], step2[10]);
+  in[11] = _mm256_sub_epi32(step2[4], step2[11]);
+  in[12] = _mm256_sub_epi32(step2[3], step2[12]);
+  in[13] = _mm256_sub_epi32(step2[2], step2[13]);
+  in[14] = _mm256_sub_epi32(step2[1], step1[14]);
+  in[15] = _mm256_sub_epi32(step2[0], step1[15]);
+}
+
+void highbd_iadst16_avx2(__m256i *const in /*in[16]*/) {
+  __m256i s[16], x[16], p[16][2];
+  int i;
+
+  // stage 1
+  highbd_madd_pair_avx2(in[15], in[0], cospi_1_64, cospi_31_64, p[0]);
+  highbd_madd_pair_avx2(in[15], in[0], cospi_31_64, -cospi_1_64, p[1]);
+  highbd_madd_pair_avx2(in[13], in[2], cospi_5_64, cospi_27_64, p[2]);
+  highbd_madd_pair_avx2(in[13], in[2], cospi_27_64, -cospi_5_64, p[3]);
+  highbd_madd_pair_avx2(in[11], in[4], cospi_9_64, cospi_23_64, p[4]);
+  highbd_madd_pair_avx2(in[11], in[4], cospi_23_64, -cospi_9_64, p[5]);
+  highbd_madd_pair_avx2(in[9], in[6], cospi_13_64, cospi_19_64, p[6]);
+  highbd_madd_pair_avx2(in[9], in[6], cospi_19_64, -cospi_13_64, p[7]);
+  highbd_madd_pair_avx2(in[7], in[8], cospi_17_64, cospi_15_64, p[8]);
+  highbd_madd_pair_avx2(in[7], in[8], cospi_15_64, -cospi_17_64, p[9]);
+  highbd_madd_pair_avx2(in[5], in[10], cospi_21_64, cospi_11_64, p[10]);
+  highbd_madd_pair_avx2(in[5], in[10], cospi_11_64, -cospi_21_64, p[11]);
+  highbd_madd_pair_avx2(in[3], in[12], cospi_25_64, cospi_7_64, p[12]);
+  highbd_madd_pair_avx2(in[3], in[12], cospi_7_64, -cospi_25_64, p[13]);
+  highbd_madd_pair_avx2(in[1], in[14], cospi_29_64, cospi_3_64, p[14]);
+  highbd_madd_pair_avx2(in[1], in[14], cospi_3_64, -cospi_29_64, p[15]);
+
+  for (i = 0; i < 8; ++i) {
+    s[i] = highbd_add_round_shift_avx2(p[i], p[i + 8]);
+    s[i + 8] = highbd_sub_round_shift_avx2(p[i], p[i + 8]);
+  }
+
+  // stage 2
+  highbd_madd_pair_avx2(s[8], s[9], cospi_4_64, cospi_28_64, p[0]);
+  highbd_madd_pair_avx2(s[8], s[9], cospi_28_64, -cospi_4_64, p[1]);
+  highbd_madd_pair_avx2(s[10], s[11], cospi_20_64, cospi_12_64, p[2]);
+  highbd_madd_pair_avx2(s[10], s[11], cospi_12_64, -cospi_20_64, p[3]);
+  highbd_madd_pair_avx2(s[12], s[13], -cospi_28_64, cospi_4_64, p[4]);
+  highbd_madd_pair_avx2(s[12], s[13], cospi_4_64, cospi_28_64, p[5]);
+  highbd_madd_pair_avx2(s[14], s[15], -cospi_12_64, cospi_20_64, p[6]);
+  highbd_madd_pair_avx2(s[14], s[15], cospi_20_64, cospi_12_64, p[7]);
+
+  for (i = 0; i < 4; ++i) {
+    x[i] = _mm256_add_epi32(s[i], s[i + 4]);
+    x[i + 4] = _mm256_sub_epi32(s[i], s[i + 4]);
+    x[i + 8] = highbd_add_round_shift_avx2(p[i], p[i + 4]);
+    x[i + 12] = highbd_sub_round_shift_avx2(p[i], p[i + 4]);
+  }
+
+  // stage 3
+  highbd_madd_pair_avx2(x[4], x[5], cospi_8_64, cospi_24_64, p[0]);
+  highbd_madd_pair_avx2(x[4], x[5], cospi_24_64, -cospi_8_64, p[1]);
+  highbd_madd_pair_avx2(x[6], x[7], -cospi_24_64, cospi_8_64, p[2]);
+  highbd_madd_pair_avx2(x[6], x[7], cospi_8_64, cospi_24_64, p[3]);
+  highbd_madd_pair_avx2(x[12], x[13], cospi_8_64, cospi_24_64, p[4]);
+  highbd_madd_pair_avx2(x[12], x[13], cospi_24_64, -cospi_8_64, p[5]);
+  highbd_madd_pair_avx2(x[14], x[15], -cospi_24_64, cospi_8_64, p[6]);
+  highbd_madd_pair_avx2(x[14], x[15], cospi_8_64, cospi_24_64, p[7]);
+
+  for (i = 0; i < 2; ++i) {
+    s[i] = _mm256_add_epi32(x[i], x[i + 2]);
+    s[i + 2] = _mm256_sub_epi32(x[i], x[i + 2]);
+    s[i + 4] = highbd_add_round_shift_avx2(p[i], p[i + 2]);
+    s[i + 6] = highbd_sub_round_shift_avx2(p[i], p[i + 2]);
+    s[i + 8] = _mm256_add_epi32(x[i + 8], x[i + 10]);
+    s[i + 10] = _mm256_sub_epi32(x[i + 8], x[i + 10]);
+    s[i + 12] = highbd_add_round_shift_avx2(p[i + 4], p[i + 6]);
+    s[i + 14] = highbd_sub_round_shift_avx2(p[i + 4], p[i + 6]);
+  }
+
+  // stage 4
+  in[7] = highbd_madd_round_shift_avx2(s[2], s[3], -cospi_16_64, -cospi_16_64);
+  in[8] = highbd_madd_round_shift_avx2(s[2], s[3], cospi_16_64, -cospi_16_64);
+  in[4] = highbd_madd_round_shift_avx2(s[6], s[7], cospi_16_64, cospi_16_64);
+  in[11] = highbd_madd_round_shift_avx2(s[6], s[7], -cospi_16_64, cospi_16_64);
+  in[6] = highbd_madd_round_shift_avx2(s[10], s[11], cospi_16_64, cospi_16_64);
+  in[9] = highbd_madd_round_shift_avx2(s[10], s[11], -cospi_16_64, cospi_16_64);
+  in[5] =
+      highbd_madd_round_shift_avx2(s[14], s[15], -cospi_16_64, -cospi_16_64);
+  in[10] =
+      highbd_madd_round_shift_avx2(s[14], s[15], cospi_16_64, -cospi_16_64);
+
+  in[0] = s[0];
+  in[1] = _mm256_sub_epi32(_mm256_setzero_si256(), s[8]);
+  in[2] = s[12];
+  in[3] = _mm256_sub_epi32(_mm256_setzero_si256(), s[4]);
+  in[12] = s[5];
+  in[13] = _mm256_sub_epi32(_mm256_setzero_si256(), s[13]);
+  in[14] = s[9];
+  in[15] = _mm256_sub_epi32(_mm256_setzero_si256(), s[1]);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+static INLINE void write_buffer_16x16(__m256i *const in, uint8_t *dest,
+                                      int stride) {
+  int j;
+  for (j = 0; j < 16; ++j) {
+    write_buffer_16x1_avx2(dest + j * stride, in[j]);
+  }
+}
+
+void vpx_idct16x16_256_add_avx2(const tran_low_t *input, uint8_t *dest,
+                                int stride) {
+  __m256i in[16];
+
+  load_buffer_16x16(input, 16, 16, in);
+  transpose_16bit_16x16_avx2(in, in);
+  idct16_avx2(in);
+  transpose_16bit_16x16_avx2(in, in);
+  idct16_avx2(in);
+  write_buffer_16x16(in, dest, stride);
+}
+
+// Only upper-left 8x8 has non-zero coeff
+void vpx_idct16x16_38_add_avx2(const tran_low_t *input, uint8_t *dest,
+                               int stride) {
+  __m256i in[16];
+
+  load_buffer_16x16(input, 16, 8, in);
+  transpose_16bit_16x16_avx2(in, in);
+  idct16_avx2(in);
+  transpose_16bit_16x16_avx2(in, in);
+  idct16_avx2(in);
+  write_buffer_16x16(in, dest, stride);
+}
+
+void vpx_idct16x16_1_add_avx2(const tran_low_t *input, uint8_t *dest,
+                              int stride) {
+  dc_only_recon_avx2(input, dest, stride, 16);
+}
+
+// Group the coefficient calculation into smaller functions to prevent stack
+// spillover in 32x32 idct optimizations:
+// quarter_1: 0-7
+// quarter_2: 8-15
+// quarter_3_4: 16-23, 24-31
+
+static INLINE void idct32_16x32_quarter_2_stage_4_to_6(
+    __m256i *const step1 /*step1[16]*/, __m256i *const out /*out[16]*/) {
+  __m256i step2[32];
+
+  // stage 4
+  step2[8] = step1[8];
+  step2[15] = step1[15];
+  butterfly_avx2(step1[14], step1[9], cospi_24_64, cospi_8_64, &step2[9],
+                 &step2[14]);
+  butterfly_avx2(step1[13], step1[10], -cospi_8_64, cospi_24_64, &step2[10],
+                 &step2[13]);
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+
+  // stage 5
+  step1[8] = _mm256_add_epi16(step2[8], step2[11]);
+  step1[9] = _mm256_add_epi16(step2[9], step2[10]);
+  step1[10] = _mm256_sub_epi16(step2[9], step2[10]);
+  step1[11] = _mm256_sub_epi16(step2[8], step2[11]);
+  step1[12] = _mm256_sub_epi16(step2[15], step2[12]);
+  step1[13] = _mm256_sub_epi16(step2[14], step2[13]);
+  step1[14] = _mm256_add_epi16(step2[14], step2[13]);
+  step1[15] = _mm256_add_epi16(step2[15], step2[12]);
+
+  // stage 6
+  out[8] = step1[8];
+  out[9] = step1[9];
+  butterfly_avx2(step1[13], step1[10], cospi_16_64, cospi_16_64, &out[10],
+                 &out[13]);
+  butterfly_avx2(step1[12], step1[11], cospi_16_64, cospi_16_64, &out[11],
+                 &out[12]);
+  out[14] = step1[14];
+  out[15] = step1[15];
+}
+
+static INLINE void idct32_16x32_quarter_3_4_stage_4_to_7(
+    __m256i *const step1 /*step1[32]*/, __m256i *const out /*out[32]*/) {
+  __m256i step2[32];
+
+  // stage 4
+  step2[16] = _mm256_add_epi16(step1[16], step1[19]);
+  step2[17] = _mm256_add_epi16(step1[17], step1[18]);
+  step2[18] = _mm256_sub_epi16(step1[17], step1[18]);
+  step2[19] = _mm256_sub_epi16(step1[16], step1[19]);
+  step2[20] = _mm256_sub_epi16(step1[23], step1[20]);
+  step2[21] = _mm256_sub_epi16(step1[22], step1[21]);
+  step2[22] = _mm256_add_epi16(step1[22], step1[21]);
+  step2[23] = _mm256_add_epi16(step1[23], step1[20]);
+
+  step2[24] = _mm256_add_epi16(step1[24], step1[27]);
+  step2[25] = _mm256_add_epi16(step1[25], step1[26]);
+  step2[26] = _mm256_sub_epi16(step1[25], step1[26]);
+  step2[27] = _mm256_sub_epi16(step1[24], step1[27]);
+  step2[28] = _mm256_sub_epi16(step1[31], step1[28]);
+  step2[29] = _mm256_sub_epi16(step1[30], step1[29]);
+  step2[30] = _mm256_add_epi16(step1[29], step1[30]);
+  step2[31] = _mm256_add_epi16(step1[28], step1[31]);
+
+  // stage 5
+  step1[16] = step2[16];
+  step1[17] = step2[17];
+  butterfly_avx2(step2[29], step2[18], cospi_24_64, cospi_8_64, &step1[18],
+                 &step1[29]);
+  butterfly_avx2(step2[28], step2[19], cospi_24_64, cospi_8_64, &step1[19],
+                 &step1[28]);
+  butterfly_avx2(step2[27], step2[20], -cospi_8_64, cospi_24_64, &step1[20],
+                 &step1[27]);
+  butterfly_avx2(step2[26], step2[21], -cospi_8_64, cospi_24_64, &step1[21],
+                 &step1[26]);
+  step1[22] = step2[22];
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[25] = step2[25];
+  step1[30] = step2[30];
+  step1[31] = step2[31];
+
+  // stage 6
+  out[16] = _mm256_add_epi16(step1[16], step1[23]);
+  out[17] = _mm256_add_epi16(step1[17], step1[22]);
+  out[18] = _mm256_add_epi16(step1[18], step1[21]);
+  out[19] = _mm256_add_epi16(step1[19], step1[20]);
+  step2[20] = _mm256_sub_epi16(step1[19], step1[20]);
+  step2[21] = _mm256_sub_epi16(step1[18], step1[21]);
+  step2[22] = _mm256_sub_epi16(step1[17], step1[22]);
+  step2[23] = _mm256_sub_epi16(step1[16], step1[23]);
+
+  step2[24] = _mm256_sub_epi16(step1[31], step1[24]);
+  step2[25] = _mm256_sub_epi16(step1[30], step1[25]);
+  step2[26] = _mm256_sub_epi16(step1[29], step1[26]);
+  step2[27] = _mm256_sub_epi16(step1[28], step1[27]);
+  out[28] = _mm256_add_epi16(step1[27], step1[28]);
+  out[29] = _mm256_add_epi16(step1[26], step1[29]);
+  out[30] = _mm256_add_epi16(step1[25], step1[30]);
+  out[31] = _mm256_add_epi16(step1[24], step1[31]);
+
+  // stage 7
+  butterfly_avx2(step2[27], step2[20], cospi_16_64, cospi_16_64, &out[20],
+                 &out[27]);
+  butterfly_avx2(step2[26], step2[21], cospi_16_64, cospi_16_64, &out[21],
+                 &out[26]);
+  butterfly_avx2(step2[25], step2[22], cospi_16_64, cospi_16_64, &out[22],
+                 &out[25]);
+  butterfly_avx2(step2[24], step2[23], cospi_16_64, cospi_16_64, &out[23],
+                 &out[24]);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with index, 0, 4
+// output pixels: 0-7 in __m256i out[32]
+static INLINE void idct32_34_16x32_quarter_1(const __m256i *const in /*in[32]*/,
+                                             __m256i *const out /*out[8]*/) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step1[8], step2[8];
+
+  // stage 3
+  butterfly_avx2(in[4], zero, cospi_28_64, cospi_4_64, &step1[4], &step1[7]);
+
+  // stage 4
+  step2[0] = butterfly_cospi16_avx2(in[0]);
+  step2[4] = step1[4];
+  step2[5] = step1[4];
+  step2[6] = step1[7];
+  step2[7] = step1[7];
+
+  // stage 5
+  step1[0] = step2[0];
+  step1[1] = step2[0];
+  step1[2] = step2[0];
+  step1[3] = step2[0];
+  step1[4] = step2[4];
+  butterfly_avx2(step2[6], step2[5], cospi_16_64, cospi_16_64, &step1[5],
+                 &step1[6]);
+  step1[7] = step2[7];
+
+  // stage 6
+  out[0] = _mm256_add_epi16(step1[0], step1[7]);
+  out[1] = _mm256_add_epi16(step1[1], step1[6]);
+  out[2] = _mm256_add_epi16(step1[2], step1[5]);
+  out[3] = _mm256_add_epi16(step1[3], step1[4]);
+  out[4] = _mm256_sub_epi16(step1[3], step1[4]);
+  out[5] = _mm256_sub_epi16(step1[2], step1[5]);
+  out[6] = _mm256_sub_epi16(step1[1], step1[6]);
+  out[7] = _mm256_sub_epi16(step1[0], step1[7]);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with index, 2, 6
+// output pixels: 8-15 in __m256i out[32]
+static INLINE void idct32_34_16x32_quarter_2(const __m256i *const in /*in[32]*/,
+                                             __m256i *const out /*out[16]*/) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  butterfly_avx2(in[2], zero, cospi_30_64, cospi_2_64, &step2[8], &step2[15]);
+  butterfly_avx2(zero, in[6], cospi_6_64, cospi_26_64, &step2[11], &step2[12]);
+
+  // stage 3
+  step1[8] = step2[8];
+  step1[9] = step2[8];
+  step1[14] = step2[15];
+  step1[15] = step2[15];
+  step1[10] = step2[11];
+  step1[11] = step2[11];
+  step1[12] = step2[12];
+  step1[13] = step2[12];
+
+  idct32_16x32_quarter_2_stage_4_to_6(step1, out);
+}
+
+static INLINE void idct32_34_16x32_quarter_1_2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[32]*/) {
+  __m256i temp[16];
+  idct32_34_16x32_quarter_1(in, temp);
+  idct32_34_16x32_quarter_2(in, temp);
+  // stage 7
+  add_sub_butterfly_avx2(temp, out, 16);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with odd index, 1, 3, 5, 7
+// output pixels: 16-23, 24-31 in __m256i out[32]
+static INLINE void idct32_34_16x32_quarter_3_4(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[32]*/) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i step1[32];
+
+  // stage 1
+  butterfly_avx2(in[1], zero, cospi_31_64, cospi_1_64, &step1[16], &step1[31]);
+  butterfly_avx2(zero, in[7], cospi_7_64, cospi_25_64, &step1[19], &step1[28]);
+  butterfly_avx2(in[5], zero, cospi_27_64, cospi_5_64, &step1[20], &step1[27]);
+  butterfly_avx2(zero, in[3], cospi_3_64, cospi_29_64, &step1[23], &step1[24]);
+
+  // stage 3
+  butterfly_avx2(step1[31], step1[16], cospi_28_64, cospi_4_64, &step1[17],
+                 &step1[30]);
+  butterfly_avx2(step1[28], step1[19], -cospi_4_64, cospi_28_64, &step1[18],
+                 &step1[29]);
+  butterfly_avx2(step1[27], step1[20], cospi_12_64, cospi_20_64, &step1[21],
+                 &step1[26]);
+  butterfly_avx2(step1[24], step1[23], -cospi_20_64, cospi_12_64, &step1[22],
+                 &step1[25]);
+
+  idct32_16x32_quarter_3_4_stage_4_to_7(step1, out);
+}
+
+static void idct32_34_16x32_avx2(const __m256i *const in /*in[32]*/,
+                                 __m256i *const out /*out[32]*/) {
+  __m256i temp[32];
+
+  idct32_34_16x32_quarter_1_2(in, temp);
+  idct32_34_16x32_quarter_3_4(in, temp);
+  // final stage
+  add_sub_butterfly_avx2(temp, out, 32);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with index, 0, 4, 8, 12, 16, 20, 24, 28
+// output pixels: 0-7 in __m256i out[32]
+static INLINE void idct32_1024_16x32_quarter_1(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[8]*/) {
+  __m256i step1[8], step2[8];
+
+  // stage 3
+  butterfly_avx2(in[4], in[28], cospi_28_64, cospi_4_64, &step1[4], &step1[7]);
+  butterfly_avx2(in[20], in[12], cospi_12_64, cospi_20_64, &step1[5],
+                 &step1[6]);
+
+  // stage 4
+  butterfly_avx2(in[0], in[16], cospi_16_64, cospi_16_64, &step2[1], &step2[0]);
+  butterfly_avx2(in[8], in[24], cospi_24_64, cospi_8_64, &step2[2], &step2[3]);
+  step2[4] = _mm256_add_epi16(step1[4], step1[5]);
+  step2[5] = _mm256_sub_epi16(step1[4], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[7], step1[6]);
+  step2[7] = _mm256_add_epi16(step1[7], step1[6]);
+
+  // stage 5
+  step1[0] = _mm256_add_epi16(step2[0], step2[3]);
+  step1[1] = _mm256_add_epi16(step2[1], step2[2]);
+  step1[2] = _mm256_sub_epi16(step2[1], step2[2]);
+  step1[3] = _mm256_sub_epi16(step2[0], step2[3]);
+  step1[4] = step2[4];
+  butterfly_avx2(step2[6], step2[5], cospi_16_64, cospi_16_64, &step1[5],
+                 &step1[6]);
+  step1[7] = step2[7];
+
+  // stage 6
+  out[0] = _mm256_add_epi16(step1[0], step1[7]);
+  out[1] = _mm256_add_epi16(step1[1], step1[6]);
+  out[2] = _mm256_add_epi16(step1[2], step1[5]);
+  out[3] = _mm256_add_epi16(step1[3], step1[4]);
+  out[4] = _mm256_sub_epi16(step1[3], step1[4]);
+  out[5] = _mm256_sub_epi16(step1[2], step1[5]);
+  out[6] = _mm256_sub_epi16(step1[1], step1[6]);
+  out[7] = _mm256_sub_epi16(step1[0], step1[7]);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with index, 2, 6, 10, 14, 18, 22, 26, 30
+// output pixels: 8-15 in __m256i out[32]
+static INLINE void idct32_1024_16x32_quarter_2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[16]*/) {
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  butterfly_avx2(in[2], in[30], cospi_30_64, cospi_2_64, &step2[8],
+                 &step2[15]);
+  butterfly_avx2(in[18], in[14], cospi_14_64, cospi_18_64, &step2[9],
+                 &step2[14]);
+  butterfly_avx2(in[10], in[22], cospi_22_64, cospi_10_64, &step2[10],
+                 &step2[13]);
+  butterfly_avx2(in[26], in[6], cospi_6_64, cospi_26_64, &step2[11],
+                 &step2[12]);
+
+  // stage 3
+  step1[8] = _mm256_add_epi16(step2[8], step2[9]);
+  step1[9] = _mm256_sub_epi16(step2[8], step2[9]);
+  step1[10] = _mm256_sub_epi16(step2[11], step2[10]);
+  step1[11] = _mm256_add_epi16(step2[11], step2[10]);
+  step1[12] = _mm256_add_epi16(step2[12], step2[13]);
+  step1[13] = _mm256_sub_epi16(step2[12], step2[13]);
+  step1[14] = _mm256_sub_epi16(step2[15], step2[14]);
+  step1[15] = _mm256_add_epi16(step2[15], step2[14]);
+
+  idct32_16x32_quarter_2_stage_4_to_6(step1, out);
+}
+
+static INLINE void idct32_1024_16x32_quarter_1_2(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[32]*/) {
+  __m256i temp[16];
+  idct32_1024_16x32_quarter_1(in, temp);
+  idct32_1024_16x32_quarter_2(in, temp);
+  // stage 7
+  add_sub_butterfly_avx2(temp, out, 16);
+}
+
+// For each 16x32 block __m256i in[32],
+// Input with odd index,
+// 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31
+// output pixels: 16-23, 24-31 in __m256i out[32]
+static INLINE void idct32_1024_16x32_quarter_3_4(
+    const __m256i *const in /*in[32]*/, __m256i *const out /*out[32]*/) {
+  __m256i step1[32], step2[32];
+
+  // stage 1
+  butterfly_avx2(in[1], in[31], cospi_31_64, cospi_1_64, &step1[16],
+                 &step1[31]);
+  butterfly_avx2(in[17], in[15], cospi_15_64, cospi_17_64, &step1[17],
+                 &step1[30]);
+  butterfly_avx2(in[9], in[23], cospi_23_64, cospi_9_64, &step1[18],
+                 &step1[29]);
+  butterfly_avx2(in[25], in[7], cospi_7_64, cospi_25_64, &step1[19],
+                 &step1[28]);
+
+  butterfly_avx2(in[5], in[27], cospi_27_64, cospi_5_64, &step1[20],
+                 &step1[27]);
+  butterfly_avx2(in[21], in[11], cospi_11_64, cospi_21_64, &step1[21],
+                 &step1[26]);
+
+  butterfly_avx2(in[13], in[19], cospi_19_64, cospi_13_64, &step1[22],
+                 &step1[25]);
+  butterfly_avx2(in[29], in[3], cospi_3_64, cospi_29_64, &step1[23],
+                 &step1[24]);
+
+  // stage 2
+  step2[16] = _mm256_add_epi16(step1[16], step1[17]);
+  step2[17] = _mm256_sub_epi16(step1[16], step1[17]);
+  step2[18] = _mm256_sub_epi16(step1[19], step1[18]);
+  step2[19] = _mm256_add_epi16(step1[19], step1[18]);
+  step2[20] = _mm256_add_epi16(step1[20], step1[21]);
+  step2[21] = _mm256_sub_epi16(step1[20], step1[21]);
+  step2[22] = _mm256_sub_epi16(step1[23], step1[22]);
+  step2[23] = _mm256_add_epi16(step1[23], step1[22]);
+
+  step2[24] = _mm256_add_epi16(step1[24], step1[25]);
+  step2[25] = _mm256_sub_epi16(step1[24], step1[25]);
+  step2[26] = _mm256_sub_epi16(step1[27], step1[26]);
+  step2[27] = _mm256_add_epi16(step1[27], step1[26]);
+  step2[28] = _mm256_add_epi16(step1[28], step1[29]);
+  step2[29] = _mm256_sub_epi16(step1[28], step1[29]);
+  step2[30] = _mm256_sub_epi16(step1[31], step1[30]);
+  step2[31] = _mm256_add_epi16(step1[31], step1[30]);
+
+  // stage 3
+  step1[16] = step2[16];
+  step1[31] = step2[31];
+  butterfly_avx2(step2[30], step2[17], cospi_28_64, cospi_4_64, &step1[17],
+                 &step1[30]);
+  butterfly_avx2(step2[29], step2[18], -cospi_4_64, cospi_28_64, &step1[18],
+                 &step1[29]);
+  step1[19] = step2[19];
+  step1[20] = step2[20];
+  butterfly_avx2(step2[26], step2[21], cospi_12_64, cospi_20_64, &step1[21],
+                 &step1[26]);
+  butterfly_avx2(step2[25], step2[22], -cospi_20_64, cospi_12_64, &step1[22],
+                 &step1[25]);
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[27] = step2[27];
+  step1[28] = step2[28];
+
+  idct32_16x32_quarter_3_4_stage_4_to_7(step1, out);
+}
+
+static void idct32_1024_16x32_avx2(const __m256i *const in /*in[32]*/,
+                                   __m256i *const out /*out[32]*/) {
+  __m256i temp[32];
+
+  idct32_1024_16x32_quarter_1_2(in, temp);
+  idct32_1024_16x32_quarter_3_4(in, temp);
+  // final stage
+  add_sub_butterfly_avx2(temp, out, 32);
+}
+
+// Load 16 rows of a 32x32 block, each restricted to the 16 columns starting
+// at input, and transpose them so that out[k] holds coefficient k of each row.
+static INLINE void load_transpose_16bit_16x16(const tran_low_t *const input,
+                                              const int rows,
+                                              __m256i *const out) {
+  load_buffer_16x16(input, 32, rows, out);
+  transpose_16bit_16x16_avx2(out, out);
+}
+
+static INLINE void store_buffer_16x32(__m256i *const in, uint8_t *dest,
+                                      int stride) {
+  int j;
+  for (j = 0; j < 32; ++j) {
+    write_buffer_16x1_avx2(dest + j * stride, in[j]);
+  }
+}
+
+void vpx_idct32x32_1024_add_avx2(const tran_low_t *input, uint8_t *dest,
+                                 int stride) {
+  __m256i col[2][32], io[32];
+  int i;
+
+  // rows
+  for (i = 0; i < 2; i++) {
+    load_transpose_16bit_16x16(&input[0], 16, &io[0]);
+    load_transpose_16bit_16x16(&input[16], 16, &io[16]);
+    idct32_1024_16x32_avx2(io, col[i]);
+    input += 32 << 4;
+  }
+
+  // columns
+  for (i = 0; i < 32; i += 16) {
+    // Transpose 32x16 block to 16x32 block
+    transpose_16bit_16x16_avx2(col[0] + i, io);
+    transpose_16bit_16x16_avx2(col[1] + i, io + 16);
+
+    idct32_1024_16x32_avx2(io, io);
+    store_buffer_16x32(io, dest, stride);
+    dest += 16;
+  }
+}
+
+// Only upper-left 16x16 has non-zero coeff
+void vpx_idct32x32_135_add_avx2(const tran_low_t *input, uint8_t *dest,
+                                int stride) {
+  __m256i col[32], io[32];
+  int i;
+
+  for (i = 16; i < 32; i++) {
+    io[i] = _mm256_setzero_si256();
+  }
+
+  // rows
+  load_transpose_16bit_16x16(input, 16, io);
+  idct32_1024_16x32_avx2(io, col);
+
+  // columns
+  for (i = 0; i < 32; i += 16) {
+    int j;
+    transpose_16bit_16x16_avx2(col + i, io);
+    for (j = 16; j < 32; j++) {
+      io[j] = _mm256_setzero_si256();
+    }
+    idct32_1024_16x32_avx2(io, io);
+    store_buffer_16x32(io, dest, stride);
+    dest += 16;
+  }
+}
+
+// Only upper-left 8x8 has non-zero coeff
+void vpx_idct32x32_34_add_avx2(const tran_low_t *input, uint8_t *dest,
+                               int stride) {
+  __m256i col[32], io[32];
+  int i;
+
+  // rows
+  load_transpose_16bit_16x16(input, 8, io);
+  idct32_34_16x32_avx2(io, col);
+
+  // columns
+  for (i = 0; i < 32; i += 16) {
+    transpose_16bit_16x16_avx2(col + i, io);
+    idct32_34_16x32_avx2(io, io);
+    store_buffer_16x32(io, dest, stride);
+    dest += 16;
+  }
+}
+
+void vpx_idct32x32_1_add_avx2(const tran_low_t *input, uint8_t *dest,
+                              int stride) {
+  dc_only_recon_avx2(input, dest, stride, 32);
+}
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_DSP_X86_INV_TXFM_AVX2_H_
+#define VPX_VPX_DSP_X86_INV_TXFM_AVX2_H_
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/inv_txfm.h"
+#include "vpx_dsp/x86/txfm_common_avx2.h"
+
+static INLINE __m256i dct_const_round_shift_avx2(const __m256i in) {
+  const __m256i t =
+      _mm256_add_epi32(in, _mm256_set1_epi32(DCT_CONST_ROUNDING));
+  return _mm256_srai_epi32(t, DCT_CONST_BITS);
+}
+
+static INLINE __m256i idct_madd_round_shift_avx2(const __m256i in,
+                                                 const __m256i cospi) {
+  const __m256i t = _mm256_madd_epi16(in, cospi);
+  return dct_const_round_shift_avx2(t);
+}
+
+// Calculate the dot product between in0/1 and x and wrap to short.
+static INLINE __m256i idct_calc_wraplow_avx2(const __m256i in0,
+                                             const __m256i in1,
+                                             const __m256i x) {
+  const __m256i t0 = idct_madd_round_shift_avx2(in0, x);
+  const __m256i t1 = idct_madd_round_shift_avx2(in1, x);
+  return _mm256_packs_epi32(t0, t1);
+}
+
+// Multiply elements by constants and add them together. The unpack and pack
+// instructions work within 128-bit lanes, so the element order is preserved.
+static INLINE void butterfly_avx2(const __m256i in0, const __m256i in1,
+                                  const int c0, const int c1,
+                                  __m256i *const out0, __m256i *const out1) {
+  const __m256i cst0 = pair256_set_epi16(c0, -c1);
+  const __m256i cst1 = pair256_set_epi16(c1, c0);
+  const __m256i lo = _mm256_unpacklo_epi16(in0, in1);
+  const __m256i hi = _mm256_unpackhi_epi16(in0, in1);
+  *out0 = idct_calc_wraplow_avx2(lo, hi, cst0);
+  *out1 = idct_calc_wraplow_avx2(lo, hi, cst1);
+}
+
+// Returns the rounded a * k0 + b * k1, packed back to 16 bits with
+// saturation. The constant pairs (k0, k1) are interleaved in |k| and may differ
+// between the two 128-bit lanes, so one call can compute two different outputs.
+static INLINE __m256i mult_round_shift_lanes_avx2(const __m256i a,
+                                                  const __m256i b,
+                                                  const __m256i k) {
+  const __m256i lo = _mm256_unpacklo_epi16(a, b);
+  const __m256i hi = _mm256_unpackhi_epi16(a, b);
+  return idct_calc_wraplow_avx2(lo, hi, k);
+}
+
+// Load 16 coefficients in order. If the source is 32 bits then pack down with
+// saturation.
+static INLINE __m256i load_input_data16_avx2(const tran_low_t *data) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  const __m256i in0 = _mm256_loadu_si256((const __m256i *)data);
+  const __m256i in1 = _mm256_loadu_si256((const __m256i *)(data + 8));
+  // 0 1 2 3  8 9 10 11  4 5 6 7  12 13 14 15
+  const __m256i t = _mm256_packs_epi32(in0, in1);
+  return _mm256_permute4x64_epi64(t, 0xd8);
+#else
+  return _mm256_loadu_si256((const __m256i *)data);
+#endif
+}
+
+// Transposes an 8x8 block held as in[i] = [row i | row i + 4] and returns it
+// as out[i] = [row 2 * i | row 2 * i + 1].
+static INLINE void transpose_16bit_8x8_avx2(const __m256i *const in,
+                                            __m256i *const out) {
+  const __m256i a0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i a1 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i a2 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i a3 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i b0 = _mm256_unpacklo_epi32(a0, a2);
+  const __m256i b1 = _mm256_unpackhi_epi32(a0, a2);
+  const __m256i b2 = _mm256_unpacklo_epi32(a1, a3);
+  const __m256i b3 = _mm256_unpackhi_epi32(a1, a3);
+  out[0] = _mm256_permute4x64_epi64(b0, 0xd8);
+  out[1] = _mm256_permute4x64_epi64(b1, 0xd8);
+  out[2] = _mm256_permute4x64_epi64(b2, 0xd8);
+  out[3] = _mm256_permute4x64_epi64(b3, 0xd8);
+}
+
+static INLINE void transpose_16bit_16x16_avx2(const __m256i *const in,
+                                              __m256i *const out) {
+  __m256i t[16];
+  int i;
+
+  // Transpose the 8x8 blocks held in each 128-bit lane. For rows 0-7, goes
+  // from:
+  // in[0]: 00 01 .. 07  08 09 .. 0f
+  // ...
+  // in[7]: 70 71 .. 77  78 79 .. 7f
+  // to:
+  // t[0]: 00 10 .. 70  08 18 .. 78
+  // ...
+  // t[7]: 07 17 .. 77  0f 1f .. 7f
+  for (i = 0; i < 16; i += 8) {
+    const __m256i a0 = _mm256_unpacklo_epi16(in[i + 0], in[i + 1]);
+    const __m256i a1 = _mm256_unpacklo_epi16(in[i + 2], in[i + 3]);
+    const __m256i a2 = _mm256_unpacklo_epi16(in[i + 4], in[i + 5]);
+    const __m256i a3 = _mm256_unpacklo_epi16(in[i + 6], in[i + 7]);
+    const __m256i a4 = _mm256_unpackhi_epi16(in[i + 0], in[i + 1]);
+    const __m256i a5 = _mm256_unpackhi_epi16(in[i + 2], in[i + 3]);
+    const __m256i a6 = _mm256_unpackhi_epi16(in[i + 4], in[i + 5]);
+    const __m256i a7 = _mm256_unpackhi_epi16(in[i + 6], in[i + 7]);
+
+    const __m256i b0 = _mm256_unpacklo_epi32(a0, a1);
+    const __m256i b1 = _mm256_unpacklo_epi32(a2, a3);
+    const __m256i b2 = _mm256_unpackhi_epi32(a0, a1);
+    const __m256i b3 = _mm256_unpackhi_epi32(a2, a3);
+    const __m256i b4 = _mm256_unpacklo_epi32(a4, a5);
+    const __m256i b5 = _mm256_unpacklo_epi32(a6, a7);
+    const __m256i b6 = _mm256_unpackhi_epi32(a4, a5);
+    const __m256i b7 = _mm256_unpackhi_epi32(a6, a7);
+
+    t[i + 0] = _mm256_unpacklo_epi64(b0, b1);
+    t[i + 1] = _mm256_unpackhi_epi64(b0, b1);
+    t[i + 2] = _mm256_unpacklo_epi64(b2, b3);
+    t[i + 3] = _mm256_unpackhi_epi64(b2, b3);
+    t[i + 4] = _mm256_unpacklo_epi64(b4, b5);
+    t[i + 5] = _mm256_unpackhi_epi64(b4, b5);
+    t[i + 6] = _mm256_unpacklo_epi64(b6, b7);
+    t[i + 7] = _mm256_unpackhi_epi64(b6, b7);
+  }
+
+  // Swap the off-diagonal 8x8 blocks:
+  // out[0]: 00 10 .. 70  80 90 .. f0
+  // ...
+  // out[15]: 0f 1f .. 7f  8f 9f .. ff
+  for (i = 0; i < 8; ++i) {
+    out[i] = _mm256_permute2x128_si256(t[i], t[i + 8], 0x20);
+    out[i + 8] = _mm256_permute2x128_si256(t[i], t[i + 8], 0x31);
+  }
+}
+
+static INLINE void recon_and_store_16_avx2(uint8_t *const dest,
+                                           const __m256i in_x) {
+  const __m128i d0 = _mm_loadu_si128((const __m128i *)dest);
+  __m256i d = _mm256_cvtepu8_epi16(d0);
+  d = _mm256_add_epi16(in_x, d);
+  d = _mm256_packus_epi16(d, d);
+  d = _mm256_permute4x64_epi64(d, 0xd8);
+  _mm_storeu_si128((__m128i *)dest, _mm256_castsi256_si128(d));
+}
+
+static INLINE void write_buffer_16x1_avx2(uint8_t *const dest,
+                                          const __m256i in) {
+  const __m256i final_rounding = _mm256_set1_epi16(1 << 5);
+  __m256i out;
+  out = _mm256_adds_epi16(in, final_rounding);
+  out = _mm256_srai_epi16(out, 6);
+  recon_and_store_16_avx2(dest, out);
+}
+
+// The 8-point kernels take in[i] = [row 2 * i | row 2 * i + 1] and return
+// in[i] = [row i | row i + 4], ready for transpose_16bit_8x8_avx2().
+void idct8_avx2(__m256i *const in);
+void iadst8_avx2(__m256i *const in);
+void idct16_avx2(__m256i *const in);
+void iadst16_avx2(__m256i *const in);
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The high bit depth 16-point kernels transform eight 32-bit columns per
+// register.
+void highbd_idct16_avx2(__m256i *const in);
+void highbd_iadst16_avx2(__m256i *const in);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+#endif  // VPX_VPX_DSP_X86_INV_TXFM_AVX2_H_
@@ -911,3 +911,283 @@ void vpx_lpf_horizontal_16_dual_avx2(unsigned char *s, int pitch,
     _mm_storeu_si128((__m128i *)(s + 6 * pitch), q6);
   }
 }
+
+// vpx_lpf_horizontal_8_dual_avx2() holds 16 pixels of a p row in the low
+// 128-bit lane and the matching q row in the high lane, so that most of the
+// mask and filter arithmetic handles both sides of the edge at once.
+static INLINE __m256i load_qp(const uint8_t *p, const uint8_t *q) {
+  const __m128i p_v = _mm_loadu_si128((const __m128i *)p);
+  const __m128i q_v = _mm_loadu_si128((const __m128i *)q);
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(p_v), q_v, 1);
+}
+
+static INLINE void store_qp(uint8_t *p, uint8_t *q, const __m256i qp) {
+  _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(qp));
+  _mm_storeu_si128((__m128i *)q, _mm256_extracti128_si256(qp, 1));
+}
+
+static INLINE __m256i abs_diff_avx2(const __m256i a, const __m256i b) {
+  return _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+}
+
+static INLINE __m128i max_lanes_epu8(const __m256i a) {
+  return _mm_max_epu8(_mm256_castsi256_si128(a),
+                      _mm256_extracti128_si256(a, 1));
+}
+
+static INLINE __m128i load_dual_limit(const uint8_t *limit0,
+                                      const uint8_t *limit1) {
+  return _mm_unpacklo_epi64(_mm_load_si128((const __m128i *)limit0),
+                            _mm_load_si128((const __m128i *)limit1));
+}
+
+// Computes filter_mask and hev_mask. Also returns max(|p1 - p0|, |q1 - q0|),
+// which is the starting point of flat_mask4.
+static INLINE void filter_hev_mask_dual(const __m256i qp3, const __m256i qp2,
+                                        const __m256i qp1, const __m256i qp0,
+                                        const __m128i blimit,
+                                        const __m128i limit,
+                                        const __m128i thresh, __m128i *mask,
+                                        __m128i *hev, __m128i *flat) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ff = _mm_cmpeq_epi8(zero, zero);
+  const __m128i fe = _mm_set1_epi8((int8_t)0xfe);
+  const __m128i p1 = _mm256_castsi256_si128(qp1);
+  const __m128i q1 = _mm256_extracti128_si256(qp1, 1);
+  const __m128i p0 = _mm256_castsi256_si128(qp0);
+  const __m128i q0 = _mm256_extracti128_si256(qp0, 1);
+  const __m256i abs_qp1qp0 = abs_diff_avx2(qp1, qp0);
+  const __m256i work = _mm256_max_epu8(abs_diff_avx2(qp2, qp1),
+                                       abs_diff_avx2(qp3, qp2));
+  __m128i abs_p0q0 = _mm_or_si128(_mm_subs_epu8(p0, q0), _mm_subs_epu8(q0, p0));
+  __m128i abs_p1q1 = _mm_or_si128(_mm_subs_epu8(p1, q1), _mm_subs_epu8(q1, p1));
+
+  *flat = max_lanes_epu8(abs_qp1qp0);
+  *hev = _mm_subs_epu8(*flat, thresh);
+  *hev = _mm_xor_si128(_mm_cmpeq_epi8(*hev, zero), ff);
+
+  abs_p0q0 = _mm_adds_epu8(abs_p0q0, abs_p0q0);
+  abs_p1q1 = _mm_srli_epi16(_mm_and_si128(abs_p1q1, fe), 1);
+  *mask = _mm_subs_epu8(_mm_adds_epu8(abs_p0q0, abs_p1q1), blimit);
+  *mask = _mm_xor_si128(_mm_cmpeq_epi8(*mask, zero), ff);
+  // mask |= (abs(p0 - q0) * 2 + abs(p1 - q1) / 2  > blimit) * -1;
+  *mask = _mm_max_epu8(*flat, *mask);
+  // mask |= (abs(p1 - p0) > limit) * -1;
+  // mask |= (abs(q1 - q0) > limit) * -1;
+  *mask = _mm_max_epu8(max_lanes_epu8(work), *mask);
+  *mask = _mm_subs_epu8(*mask, limit);
+  *mask = _mm_cmpeq_epi8(*mask, zero);
+}
+
+// Arithmetic right shift by 3 of signed bytes.
+static INLINE __m256i srai_epi8_3(const __m256i a) {
+  const __m256i te0 = _mm256_set1_epi8((int8_t)0xe0);
+  const __m256i t1f = _mm256_set1_epi8(0x1f);
+  const __m256i sign = _mm256_cmpgt_epi8(_mm256_setzero_si256(), a);
+  const __m256i shifted = _mm256_and_si256(_mm256_srli_epi16(a, 3), t1f);
+  return _mm256_or_si256(shifted, _mm256_and_si256(sign, te0));
+}
+
+// filter4 on both sides of the edge. The p side adds the filter values and
+// the q side subtracts them, which is done by negating the high lane with
+// _mm256_sign_epi8(). All negated values are in [-16, 16], so the saturating
+// add gives the same result as the saturating subtract.
+static INLINE void filter4_dual(const __m128i mask, const __m128i hev,
+                                __m256i *qp1, __m256i *qp0) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m256i t80 = _mm256_set1_epi8((int8_t)0x80);
+  const __m256i t3t4 = _mm256_setr_epi64x(
+      0x0303030303030303LL, 0x0303030303030303LL, 0x0404040404040404LL,
+      0x0404040404040404LL);
+  const __m256i pos_neg = _mm256_setr_epi64x(
+      0x0101010101010101LL, 0x0101010101010101LL, -1LL, -1LL);
+  const __m128i t1 = _mm_set1_epi8(0x1);
+  const __m128i t80_128 = _mm256_castsi256_si128(t80);
+  const __m128i t7f = _mm_set1_epi8(0x7f);
+  const __m256i qps1 = _mm256_xor_si256(*qp1, t80);
+  const __m256i qps0 = _mm256_xor_si256(*qp0, t80);
+  const __m128i ps1 = _mm256_castsi256_si128(qps1);
+  const __m128i qs1 = _mm256_extracti128_si256(qps1, 1);
+  const __m128i ps0 = _mm256_castsi256_si128(qps0);
+  const __m128i qs0 = _mm256_extracti128_si256(qps0, 1);
+  __m128i filt, work_a, filter1;
+  __m256i filter21;
+
+  filt = _mm_and_si128(_mm_subs_epi8(ps1, qs1), hev);
+  work_a = _mm_subs_epi8(qs0, ps0);
+  filt = _mm_adds_epi8(filt, work_a);
+  filt = _mm_adds_epi8(filt, work_a);
+  filt = _mm_adds_epi8(filt, work_a);
+  // (vpx_filter + 3 * (qs0 - ps0)) & mask
+  filt = _mm_and_si128(filt, mask);
+
+  // Filter2 >> 3 in the low lane, Filter1 >> 3 in the high lane.
+  filter21 = _mm256_adds_epi8(_mm256_broadcastsi128_si256(filt), t3t4);
+  filter21 = srai_epi8_3(filter21);
+  filter1 = _mm256_extracti128_si256(filter21, 1);
+
+  // filt >> 1
+  filt = _mm_adds_epi8(filter1, t1);
+  work_a = _mm_cmpgt_epi8(zero, filt);
+  filt = _mm_srli_epi16(filt, 1);
+  work_a = _mm_and_si128(work_a, t80_128);
+  filt = _mm_and_si128(filt, t7f);
+  filt = _mm_or_si128(filt, work_a);
+  filt = _mm_andnot_si128(hev, filt);
+
+  *qp0 = _mm256_xor_si256(
+      _mm256_adds_epi8(qps0, _mm256_sign_epi8(filter21, pos_neg)), t80);
+  *qp1 = _mm256_xor_si256(
+      _mm256_adds_epi8(
+          qps1, _mm256_sign_epi8(_mm256_broadcastsi128_si256(filt), pos_neg)),
+      t80);
+}
+
+// Packs two vectors of 16-bit values to bytes, keeping the element order:
+// a in the low lane, b in the high lane.
+static INLINE __m256i pack_qp(const __m256i a, const __m256i b) {
+  return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8);
+}
+
+void vpx_lpf_horizontal_8_dual_avx2(uint8_t *s, int pitch,
+                                    const uint8_t *blimit0,
+                                    const uint8_t *limit0,
+                                    const uint8_t *thresh0,
+                                    const uint8_t *blimit1,
+                                    const uint8_t *limit1,
+                                    const uint8_t *thresh1) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one = _mm_set1_epi8(1);
+  const __m128i blimit = load_dual_limit(blimit0, blimit1);
+  const __m128i limit = load_dual_limit(limit0, limit1);
+  const __m128i thresh = load_dual_limit(thresh0, thresh1);
+  const __m256i qp3 = load_qp(s - 4 * pitch, s + 3 * pitch);
+  __m256i qp2 = load_qp(s - 3 * pitch, s + 2 * pitch);
+  const __m256i qp1_in = load_qp(s - 2 * pitch, s + 1 * pitch);
+  const __m256i qp0_in = load_qp(s - 1 * pitch, s + 0 * pitch);
+  __m256i qp1 = qp1_in;
+  __m256i qp0 = qp0_in;
+  __m128i mask, hev, flat;
+
+  filter_hev_mask_dual(qp3, qp2, qp1, qp0, blimit, limit, thresh, &mask, &hev,
+                       &flat);
+
+  // flat_mask4
+  flat = _mm_max_epu8(
+      max_lanes_epu8(_mm256_max_epu8(abs_diff_avx2(qp2, qp0),
+                                     abs_diff_avx2(qp3, qp0))),
+      flat);
+  flat = _mm_subs_epu8(flat, one);
+  flat = _mm_cmpeq_epi8(flat, zero);
+  flat = _mm_and_si128(flat, mask);
+
+  filter4_dual(mask, hev, &qp1, &qp0);
+
+  if (_mm_movemask_epi8(flat)) {
+    const __m256i four = _mm256_set1_epi16(4);
+    const __m256i p3 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(qp3));
+    const __m256i p2 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(qp2));
+    const __m256i p1 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(qp1_in));
+    const __m256i p0 = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(qp0_in));
+    const __m256i q0 =
+        _mm256_cvtepu8_epi16(_mm256_extracti128_si256(qp0_in, 1));
+    const __m256i q1 =
+        _mm256_cvtepu8_epi16(_mm256_extracti128_si256(qp1_in, 1));
+    const __m256i q2 = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(qp2, 1));
+    const __m256i q3 = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(qp3, 1));
+    const __m256i flat_qp = _mm256_broadcastsi128_si256(flat);
+    __m256i workp_a, workp_b, op2, op1, op0, oq0, oq1, oq2;
+
+    workp_a =
+        _mm256_add_epi16(_mm256_add_epi16(p3, p3), _mm256_add_epi16(p2, p1));
+    workp_a = _mm256_add_epi16(_mm256_add_epi16(workp_a, four), p0);
+    workp_b = _mm256_add_epi16(_mm256_add_epi16(q0, p2), p3);
+    op2 = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+
+    workp_b = _mm256_add_epi16(_mm256_add_epi16(q0, q1), p1);
+    op1 = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+
+    workp_a = _mm256_add_epi16(_mm256_sub_epi16(workp_a, p3), q2);
+    workp_b = _mm256_add_epi16(_mm256_sub_epi16(workp_b, p1), p0);
+    op0 = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+
+    workp_a = _mm256_add_epi16(_mm256_sub_epi16(workp_a, p3), q3);
+    workp_b = _mm256_add_epi16(_mm256_sub_epi16(workp_b, p0), q0);
+    oq0 = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+
+    workp_a = _mm256_add_epi16(_mm256_sub_epi16(workp_a, p2), q3);
+    workp_b = _mm256_add_epi16(_mm256_sub_epi16(workp_b, q0), q1);
+    oq1 = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+
+    workp_a = _mm256_add_epi16(_mm256_sub_epi16(workp_a, p1), q3);
+    workp_b = _mm256_add_epi16(_mm256_sub_epi16(workp_b, q1), q2);
+    oq2 = _mm256_srli_epi16(_mm256_add_epi16(workp_a, workp_b), 3);
+
+    qp2 = _mm256_blendv_epi8(qp2, pack_qp(op2, oq2), flat_qp);
+    qp1 = _mm256_blendv_epi8(qp1, pack_qp(op1, oq1), flat_qp);
+    qp0 = _mm256_blendv_epi8(qp0, pack_qp(op0, oq0), flat_qp);
+    store_qp(s - 3 * pitch, s + 2 * pitch, qp2);
+  }
+
+  store_qp(s - 2 * pitch, s + 1 * pitch, qp1);
+  store_qp(s - 1 * pitch, s + 0 * pitch, qp0);
+}
+
+// Transposes a 16x16 block of bytes. Rows i and i + 8 share a register so
+// that each 128-bit lane is an independent 8x16 transpose.
+static INLINE void transpose_16x16_avx2(const uint8_t *in, int in_p,
+                                        uint8_t *out, int out_p) {
+  __m256i x[8], a[8], b[8];
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)(in + i * in_p));
+    const __m128i r1 = _mm_loadu_si128((const __m128i *)(in + (i + 8) * in_p));
+    x[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+  }
+
+  // 00 10 01 11 .. 07 17
+  for (i = 0; i < 4; ++i) {
+    a[i] = _mm256_unpacklo_epi8(x[2 * i], x[2 * i + 1]);
+    a[i + 4] = _mm256_unpackhi_epi8(x[2 * i], x[2 * i + 1]);
+  }
+  // 00 10 20 30 01 11 21 31 .. 03 13 23 33
+  for (i = 0; i < 8; i += 4) {
+    b[i + 0] = _mm256_unpacklo_epi16(a[i + 0], a[i + 1]);
+    b[i + 1] = _mm256_unpackhi_epi16(a[i + 0], a[i + 1]);
+    b[i + 2] = _mm256_unpacklo_epi16(a[i + 2], a[i + 3]);
+    b[i + 3] = _mm256_unpackhi_epi16(a[i + 2], a[i + 3]);
+  }
+  // 00 10 20 30 40 50 60 70 01 11 21 31 41 51 61 71
+  for (i = 0; i < 8; i += 4) {
+    a[i + 0] = _mm256_unpacklo_epi32(b[i + 0], b[i + 2]);
+    a[i + 1] = _mm256_unpackhi_epi32(b[i + 0], b[i + 2]);
+    a[i + 2] = _mm256_unpacklo_epi32(b[i + 1], b[i + 3]);
+    a[i + 3] = _mm256_unpackhi_epi32(b[i + 1], b[i + 3]);
+  }
+
+  // Join the two halves of each column: a[i] holds columns 2 * i and
+  // 2 * i + 1.
+  for (i = 0; i < 8; ++i) {
+    const __m256i cols = _mm256_permute4x64_epi64(a[i], 0xd8);
+    _mm_storeu_si128((__m128i *)(out + (2 * i + 0) * out_p),
+                     _mm256_castsi256_si128(cols));
+    _mm_storeu_si128((__m128i *)(out + (2 * i + 1) * out_p),
+                     _mm256_extracti128_si256(cols, 1));
+  }
+}
+
+void vpx_lpf_vertical_16_dual_avx2(uint8_t *s, int pitch,
+                                   const uint8_t *blimit, const uint8_t *limit,
+                                   const uint8_t *thresh) {
+  DECLARE_ALIGNED(16, uint8_t, t_dst[256]);
+
+  // Transpose 16x16
+  transpose_16x16_avx2(s - 8, pitch, t_dst, 16);
+
+  // Loop filtering
+  vpx_lpf_horizontal_16_dual_avx2(t_dst + 8 * 16, 16, blimit, limit, thresh);
+
+  // Transpose back
+  transpose_16x16_avx2(t_dst, 16, s - 8, pitch);
+}
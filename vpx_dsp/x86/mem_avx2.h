@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_DSP_X86_MEM_AVX2_H_
+#define VPX_VPX_DSP_X86_MEM_AVX2_H_
+
+#include <immintrin.h>  // AVX2
+#include <stddef.h>
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+
+// Loads 16 pixels of a high bit depth block that is 'width' pixels wide: one
+// row for widths of 16 or more, otherwise 2 rows of 8 or 4 rows of 4. The
+// rows are in the same order as in a contiguous block with a stride of
+// 'width', such as a second prediction.
+static INLINE __m256i load_highbd_16_pixels(const uint16_t *p,
+                                            ptrdiff_t stride, int width) {
+  if (width >= 16) return _mm256_loadu_si256((const __m256i *)p);
+  if (width == 8) {
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)p);
+    const __m128i r1 = _mm_loadu_si128((const __m128i *)(p + stride));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+  } else {
+    const __m128i r01 =
+        _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                           _mm_loadl_epi64((const __m128i *)(p + stride)));
+    const __m128i r23 = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)(p + 2 * stride)),
+        _mm_loadl_epi64((const __m128i *)(p + 3 * stride)));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(r01), r23, 1);
+  }
+}
+
+#endif  // VPX_VPX_DSP_X86_MEM_AVX2_H_
@@ -185,3 +185,116 @@ void vpx_sad64x64x4d_avx2(const uint8_t *src_ptr, int src_stride,
 
   calc_final_4(sums, sad_array);
 }
+
+static INLINE __m256i load_2x16(const uint8_t *a, const uint8_t *b) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)a)),
+      _mm_loadu_si128((const __m128i *)b), 1);
+}
+
+// Two rows of 16 pixels are compared per iteration, one in each 128-bit lane.
+static INLINE void sad16xhx4d_avx2(const uint8_t *src_ptr, int src_stride,
+                                   const uint8_t *const ref_array[],
+                                   int ref_stride, uint32_t *sad_array,
+                                   int height) {
+  int i;
+  const uint8_t *refs[4];
+  __m256i sums[4];
+
+  refs[0] = ref_array[0];
+  refs[1] = ref_array[1];
+  refs[2] = ref_array[2];
+  refs[3] = ref_array[3];
+  sums[0] = _mm256_setzero_si256();
+  sums[1] = _mm256_setzero_si256();
+  sums[2] = _mm256_setzero_si256();
+  sums[3] = _mm256_setzero_si256();
+
+  for (i = 0; i < height; i += 2) {
+    __m256i r[4];
+
+    // load 2 rows of src and all ref[]
+    const __m256i s = load_2x16(src_ptr, src_ptr + src_stride);
+    r[0] = load_2x16(refs[0], refs[0] + ref_stride);
+    r[1] = load_2x16(refs[1], refs[1] + ref_stride);
+    r[2] = load_2x16(refs[2], refs[2] + ref_stride);
+    r[3] = load_2x16(refs[3], refs[3] + ref_stride);
+
+    // sum of the absolute differences between every ref[] to src
+    r[0] = _mm256_sad_epu8(r[0], s);
+    r[1] = _mm256_sad_epu8(r[1], s);
+    r[2] = _mm256_sad_epu8(r[2], s);
+    r[3] = _mm256_sad_epu8(r[3], s);
+
+    // sum every ref[]
+    sums[0] = _mm256_add_epi32(sums[0], r[0]);
+    sums[1] = _mm256_add_epi32(sums[1], r[1]);
+    sums[2] = _mm256_add_epi32(sums[2], r[2]);
+    sums[3] = _mm256_add_epi32(sums[3], r[3]);
+
+    src_ptr += 2 * src_stride;
+    refs[0] += 2 * ref_stride;
+    refs[1] += 2 * ref_stride;
+    refs[2] += 2 * ref_stride;
+    refs[3] += 2 * ref_stride;
+  }
+
+  calc_final_4(sums, sad_array);
+}
+
+void vpx_sad16x16x4d_avx2(const uint8_t *src_ptr, int src_stride,
+                          const uint8_t *const ref_array[], int ref_stride,
+                          uint32_t *sad_array) {
+  sad16xhx4d_avx2(src_ptr, src_stride, ref_array, ref_stride, sad_array, 16);
+}
+
+void vpx_sad16x8x4d_avx2(const uint8_t *src_ptr, int src_stride,
+                         const uint8_t *const ref_array[], int ref_stride,
+                         uint32_t *sad_array) {
+  sad16xhx4d_avx2(src_ptr, src_stride, ref_array, ref_stride, sad_array, 8);
+}
+
+// _mm256_mpsadbw_epu8() returns the SADs of one 4 pixel group of src against
+// 8 consecutive offsets of ref, separately in each 128-bit lane. With ref
+// pixels 0-15 in the low lane and 8-23 in the high lane, the two calls below
+// cover src groups 0 and 1 in the low lane and 2 and 3 in the high lane, so
+// the sum of the lanes is the SAD of the 16 pixel row at offsets 0-7.
+static INLINE void sad16xhx8_avx2(const uint8_t *src_ptr, int src_stride,
+                                  const uint8_t *ref_ptr, int ref_stride,
+                                  uint32_t *sad_array, int height) {
+  int i;
+  __m256i sums = _mm256_setzero_si256();
+  __m128i sum;
+
+  for (i = 0; i < height; i++) {
+    const __m256i s = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)src_ptr));
+    const __m256i r = load_2x16(ref_ptr, ref_ptr + 8);
+    // Groups 0 and 2 at ref offset 0, then groups 1 and 3 at ref offset 4.
+    sums = _mm256_add_epi16(sums, _mm256_mpsadbw_epu8(r, s, 0x10));
+    sums = _mm256_add_epi16(sums, _mm256_mpsadbw_epu8(r, s, 0x3d));
+
+    src_ptr += src_stride;
+    ref_ptr += ref_stride;
+  }
+
+  // A 16x16 SAD is at most 65280 so the 16 bit sums cannot overflow.
+  sum = _mm_add_epi16(_mm256_castsi256_si128(sums),
+                      _mm256_extracti128_si256(sums, 1));
+  _mm_storeu_si128((__m128i *)sad_array,
+                   _mm_unpacklo_epi16(sum, _mm_setzero_si128()));
+  _mm_storeu_si128((__m128i *)(sad_array + 4),
+                   _mm_unpackhi_epi16(sum, _mm_setzero_si128()));
+}
+
+void vpx_sad16x16x8_avx2(const uint8_t *src_ptr, int src_stride,
+                         const uint8_t *ref_ptr, int ref_stride,
+                         uint32_t *sad_array) {
+  sad16xhx8_avx2(src_ptr, src_stride, ref_ptr, ref_stride, sad_array, 16);
+}
+
+void vpx_sad16x8x8_avx2(const uint8_t *src_ptr, int src_stride,
+                        const uint8_t *ref_ptr, int ref_stride,
+                        uint32_t *sad_array) {
+  sad16xhx8_avx2(src_ptr, src_stride, ref_ptr, ref_stride, sad_array, 8);
+}
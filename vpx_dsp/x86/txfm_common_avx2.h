@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_DSP_X86_TXFM_COMMON_AVX2_H_
+#define VPX_VPX_DSP_X86_TXFM_COMMON_AVX2_H_
+
+#include <immintrin.h>
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/txfm_common.h"
+
+#define pair256_set_epi16(a, b)                                            \
+  _mm256_set_epi16((int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a))
+
+#define pair256_set_epi32(a, b)                                                \
+  _mm256_set_epi32((int)(b), (int)(a), (int)(b), (int)(a), (int)(b), (int)(a), \
+                   (int)(b), (int)(a))
+
+// Returns the constant pair (a, b) in the low 128 bits and (c, d) in the high
+// 128 bits, for multiplies that compute a different output in each half.
+static INLINE __m256i pair_pair256_set_epi16(int a, int b, int c, int d) {
+  return _mm256_setr_epi16(
+      (int16_t)a, (int16_t)b, (int16_t)a, (int16_t)b, (int16_t)a, (int16_t)b,
+      (int16_t)a, (int16_t)b, (int16_t)c, (int16_t)d, (int16_t)c, (int16_t)d,
+      (int16_t)c, (int16_t)d, (int16_t)c, (int16_t)d);
+}
+
+// Forms a * k0 + b * k1 in 64 bits, for the even 32-bit lanes in out[0] and
+// the odd lanes in out[1].
+static INLINE void highbd_madd_epi32_avx2(const __m256i a, const __m256i b,
+                                          const __m256i k0, const __m256i k1,
+                                          __m256i *const out /*out[2]*/) {
+  out[0] = _mm256_add_epi64(_mm256_mul_epi32(a, k0), _mm256_mul_epi32(b, k1));
+  out[1] = _mm256_add_epi64(
+      _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(k0, 32)),
+      _mm256_mul_epi32(_mm256_srli_epi64(b, 32), _mm256_srli_epi64(k1, 32)));
+}
+
+// Rounds and shifts the 64-bit sums of highbd_madd_epi32_avx2() by
+// DCT_CONST_BITS and returns them in 32-bit lanes. Only the low 32 bits of
+// each result are kept, as with HIGHBD_WRAPLOW(), so a logical shift is
+// enough.
+static INLINE __m256i highbd_round_shift_avx2(const __m256i *const in) {
+  const __m256i rounding = _mm256_set1_epi64x(DCT_CONST_ROUNDING);
+  const __m256i even =
+      _mm256_srli_epi64(_mm256_add_epi64(in[0], rounding), DCT_CONST_BITS);
+  const __m256i odd =
+      _mm256_srli_epi64(_mm256_add_epi64(in[1], rounding), DCT_CONST_BITS);
+  return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+}
+
+// Returns dct_const_round_shift(a * k0 + b * k1) for each 32-bit lane, with
+// the products and their sum formed in 64 bits.
+static INLINE __m256i highbd_mult_round_shift_avx2(const __m256i a,
+                                                   const __m256i b,
+                                                   const __m256i k0,
+                                                   const __m256i k1) {
+  __m256i s[2];
+  highbd_madd_epi32_avx2(a, b, k0, k1, s);
+  return highbd_round_shift_avx2(s);
+}
+
+static INLINE void transpose_32bit_8x8_avx2(const __m256i *const in,
+                                            __m256i *const out) {
+  const __m256i a0 = _mm256_unpacklo_epi32(in[0], in[1]);
+  const __m256i a1 = _mm256_unpackhi_epi32(in[0], in[1]);
+  const __m256i a2 = _mm256_unpacklo_epi32(in[2], in[3]);
+  const __m256i a3 = _mm256_unpackhi_epi32(in[2], in[3]);
+  const __m256i a4 = _mm256_unpacklo_epi32(in[4], in[5]);
+  const __m256i a5 = _mm256_unpackhi_epi32(in[4], in[5]);
+  const __m256i a6 = _mm256_unpacklo_epi32(in[6], in[7]);
+  const __m256i a7 = _mm256_unpackhi_epi32(in[6], in[7]);
+
+  const __m256i b0 = _mm256_unpacklo_epi64(a0, a2);
+  const __m256i b1 = _mm256_unpackhi_epi64(a0, a2);
+  const __m256i b2 = _mm256_unpacklo_epi64(a1, a3);
+  const __m256i b3 = _mm256_unpackhi_epi64(a1, a3);
+  const __m256i b4 = _mm256_unpacklo_epi64(a4, a6);
+  const __m256i b5 = _mm256_unpackhi_epi64(a4, a6);
+  const __m256i b6 = _mm256_unpacklo_epi64(a5, a7);
+  const __m256i b7 = _mm256_unpackhi_epi64(a5, a7);
+
+  out[0] = _mm256_permute2x128_si256(b0, b4, 0x20);
+  out[1] = _mm256_permute2x128_si256(b1, b5, 0x20);
+  out[2] = _mm256_permute2x128_si256(b2, b6, 0x20);
+  out[3] = _mm256_permute2x128_si256(b3, b7, 0x20);
+  out[4] = _mm256_permute2x128_si256(b0, b4, 0x31);
+  out[5] = _mm256_permute2x128_si256(b1, b5, 0x31);
+  out[6] = _mm256_permute2x128_si256(b2, b6, 0x31);
+  out[7] = _mm256_permute2x128_si256(b3, b7, 0x31);
+}
+
+// Transposes a 16x16 block held as in[2 * i + j] = row i, columns 8 * j to
+// 8 * j + 7, into the same layout. |in| and |out| must not overlap.
+static INLINE void transpose_32bit_16x16_avx2(const __m256i *const in,
+                                              __m256i *const out) {
+  __m256i a[8], b[8];
+  int i, j, k;
+  for (i = 0; i < 2; ++i) {
+    for (j = 0; j < 2; ++j) {
+      for (k = 0; k < 8; ++k) a[k] = in[2 * (8 * i + k) + j];
+      transpose_32bit_8x8_avx2(a, b);
+      for (k = 0; k < 8; ++k) out[2 * (8 * j + k) + i] = b[k];
+    }
+  }
+}
+
+#endif  // VPX_VPX_DSP_X86_TXFM_COMMON_AVX2_H_
@@ -12,7 +12,8 @@
 #define VPX_VPX_MEM_INCLUDE_VPX_MEM_INTRNL_H_
 #include "./vpx_config.h"
 
-#define ADDRESS_STORAGE_SIZE sizeof(size_t)
+/*space reserved in front of each block for the allocation bookkeeping*/
+#define ADDRESS_STORAGE_SIZE (3 * sizeof(void *)) /* NOLINT */
 
 #ifndef DEFAULT_ALIGNMENT
 #if defined(VXWORKS)
@@ -15,6 +15,10 @@
 #include <string.h>
 #include "include/vpx_mem_intrnl.h"
 #include "vpx/vpx_integer.h"
+#if CONFIG_MULTITHREAD
+#include "vpx_ports/vpx_once.h"
+#include "vpx_util/vpx_thread.h"
+#endif
 
 #if !defined(VPX_MAX_ALLOCABLE_MEMORY)
 #if SIZE_MAX > (1ULL << 40)
@@ -35,34 +39,87 @@ static int check_size_argument_overflow(uint64_t nmemb, uint64_t size) {
   return 1;
 }
 
-static size_t *get_malloc_address_location(void *const mem) {
-  return ((size_t *)mem) - 1;
+// Stored immediately before every block returned by vpx_memalign().
+typedef struct {
+  // Releases 'addr'; NULL when the block came from malloc().
+  void (*release)(void *priv, void *ptr);
+  void *priv;
+  void *addr;  // start of the underlying allocation
+} BlockHeader;
+
+static vpx_mem_allocator g_allocator = { NULL, NULL, NULL };
+
+#if CONFIG_MULTITHREAD
+// Serializes vpx_mem_set_allocator() against the copy made by every
+// allocation, so that a block never pairs one allocator's 'alloc' with
+// another's 'release' or 'priv'.
+static pthread_mutex_t g_allocator_mutex;
+
+static void init_allocator_mutex(void) {
+  pthread_mutex_init(&g_allocator_mutex, NULL);
+}
+#endif
+
+static void lock_allocator(void) {
+#if CONFIG_MULTITHREAD
+  once(init_allocator_mutex);
+  pthread_mutex_lock(&g_allocator_mutex);
+#endif
 }
 
-static uint64_t get_aligned_malloc_size(size_t size, size_t align) {
-  return (uint64_t)size + align - 1 + ADDRESS_STORAGE_SIZE;
+static void unlock_allocator(void) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&g_allocator_mutex);
+#endif
+}
+
+int vpx_mem_set_allocator(const vpx_mem_allocator *allocator) {
+  if (allocator != NULL &&
+      (allocator->alloc == NULL || allocator->release == NULL)) {
+    return -1;
+  }
+  lock_allocator();
+  if (allocator != NULL) {
+    g_allocator = *allocator;
+  } else {
+    memset(&g_allocator, 0, sizeof(g_allocator));
+  }
+  unlock_allocator();
+  return 0;
 }
 
-static void set_actual_malloc_address(void *const mem,
-                                      const void *const malloc_addr) {
-  size_t *const malloc_addr_location = get_malloc_address_location(mem);
-  *malloc_addr_location = (size_t)malloc_addr;
+static void get_allocator(vpx_mem_allocator *const allocator) {
+  lock_allocator();
+  *allocator = g_allocator;
+  unlock_allocator();
 }
 
-static void *get_actual_malloc_address(void *const mem) {
-  size_t *const malloc_addr_location = get_malloc_address_location(mem);
-  return (void *)(*malloc_addr_location);
+static BlockHeader *get_block_header(void *const mem) {
+  return ((BlockHeader *)mem) - 1;
+}
+
+static uint64_t get_aligned_malloc_size(size_t size, size_t align) {
+  return (uint64_t)size + align - 1 + ADDRESS_STORAGE_SIZE;
 }
 
 void *vpx_memalign(size_t align, size_t size) {
   void *x = NULL, *addr;
+  vpx_mem_allocator allocator;
   const uint64_t aligned_size = get_aligned_malloc_size(size, align);
   if (!check_size_argument_overflow(1, aligned_size)) return NULL;
 
-  addr = malloc((size_t)aligned_size);
+  get_allocator(&allocator);
+
+  addr = allocator.alloc != NULL
+             ? allocator.alloc(allocator.priv, (size_t)aligned_size)
+             : malloc((size_t)aligned_size);
   if (addr) {
+    BlockHeader *header;
     x = align_addr((unsigned char *)addr + ADDRESS_STORAGE_SIZE, align);
-    set_actual_malloc_address(x, addr);
+    header = get_block_header(x);
+    header->release = allocator.alloc != NULL ? allocator.release : NULL;
+    header->priv = allocator.priv;
+    header->addr = addr;
   }
   return x;
 }
@@ -80,7 +137,11 @@ void *vpx_calloc(size_t num, size_t size) {
 
 void vpx_free(void *memblk) {
   if (memblk) {
-    void *addr = get_actual_malloc_address(memblk);
-    free(addr);
+    const BlockHeader *const header = get_block_header(memblk);
+    if (header->release != NULL) {
+      header->release(header->priv, header->addr);
+    } else {
+      free(header->addr);
+    }
   }
 }
@@ -30,6 +30,25 @@ void *vpx_malloc(size_t size);
 void *vpx_calloc(size_t num, size_t size);
 void vpx_free(void *memblk);
 
+// Backing store used by vpx_memalign() and friends in place of malloc() and
+// free(). 'alloc' returns at least 'size' bytes with malloc() alignment or
+// NULL; 'release' is given the pointer returned by 'alloc'.
+typedef struct vpx_mem_allocator {
+  void *(*alloc)(void *priv, size_t size);
+  void (*release)(void *priv, void *ptr);
+  void *priv;
+} vpx_mem_allocator;
+
+// Routes subsequent allocations through 'allocator', or back to malloc() when
+// it is NULL. Returns -1, leaving the registration unchanged, if either hook
+// is missing. The allocator is process wide and may be replaced at any time,
+// from any thread: each allocation uses either the old or the new allocator
+// in full. Each block records the allocator that produced it, so blocks
+// allocated before a switch are still released correctly, provided that
+// allocator outlives them. Applications reach this through
+// vpx_codec_set_mem_allocator().
+int vpx_mem_set_allocator(const vpx_mem_allocator *allocator);
+
 #if CONFIG_VP9_HIGHBITDEPTH
 static INLINE void *vpx_memset16(void *dest, int val, size_t length) {
   size_t i;
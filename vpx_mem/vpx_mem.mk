@@ -2,3 +2,5 @@ MEM_SRCS-yes += vpx_mem.mk
 MEM_SRCS-yes += vpx_mem.c
 MEM_SRCS-yes += vpx_mem.h
 MEM_SRCS-yes += include/vpx_mem_intrnl.h
+MEM_SRCS-yes += vpx_mem_pool.c
+MEM_SRCS-yes += vpx_mem_pool.h
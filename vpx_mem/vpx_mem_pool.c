@@ -0,0 +1,182 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "vpx_mem/vpx_mem_pool.h"
+#include "vpx_util/vpx_thread.h"
+
+// Blocks up to 1 << MIN_CLASS_BITS bytes share the smallest class.
+#define MIN_CLASS_BITS 6
+#define NUM_CLASSES (1 + 4 * (8 * (int)sizeof(size_t) - MIN_CLASS_BITS))
+// Larger requests would overflow the class size computation.
+#define MAX_REQUEST_SIZE (SIZE_MAX >> 2)
+// Holds the class index of a block in use, or the free list link of a cached
+// block. Twice the pointer size keeps the malloc() alignment of the payload.
+#define BLOCK_HEADER_SIZE (2 * sizeof(void *)) /* NOLINT */
+
+struct VpxMemPool {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex;
+#endif
+  void *free_list[NUM_CLASSES];
+  VpxMemPoolStats stats;
+};
+
+static int get_highest_bit(size_t n) {
+  int bit = 0;
+  while (n >>= 1) ++bit;
+  return bit;
+}
+
+// Returns the smallest class that holds 'size' bytes.
+static int get_size_class(size_t size) {
+  size_t m;
+  int bits;
+  if (size <= ((size_t)1 << MIN_CLASS_BITS)) return 0;
+  m = size - 1;
+  bits = get_highest_bit(m);
+  return 1 + 4 * (bits - MIN_CLASS_BITS) + (int)((m >> (bits - 2)) & 3);
+}
+
+// Class 0 is 1 << MIN_CLASS_BITS bytes; after that each power of two is split
+// into quarters: 80, 96, 112, 128, 160, ...
+static size_t get_class_size(int size_class) {
+  const int bits = (size_class - 1) / 4 + MIN_CLASS_BITS;
+  if (size_class == 0) return (size_t)1 << MIN_CLASS_BITS;
+  return (size_t)(5 + (size_class - 1) % 4) << (bits - 2);
+}
+
+static void lock_pool(VpxMemPool *const pool) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&pool->mutex);
+#else
+  (void)pool;
+#endif
+}
+
+static void unlock_pool(VpxMemPool *const pool) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&pool->mutex);
+#else
+  (void)pool;
+#endif
+}
+
+static void *pool_alloc(void *priv, size_t size) {
+  VpxMemPool *const pool = (VpxMemPool *)priv;
+  VpxMemPoolStats *const stats = &pool->stats;
+  unsigned char *block;
+  size_t class_size;
+  int size_class;
+
+  if (size > MAX_REQUEST_SIZE - BLOCK_HEADER_SIZE) return NULL;
+  size_class = get_size_class(size + BLOCK_HEADER_SIZE);
+  class_size = get_class_size(size_class);
+  assert(size_class < NUM_CLASSES && class_size >= size + BLOCK_HEADER_SIZE);
+
+  lock_pool(pool);
+  ++stats->num_allocs;
+  block = (unsigned char *)pool->free_list[size_class];
+  if (block != NULL) {
+    memcpy(&pool->free_list[size_class], block, sizeof(void *));
+  } else {
+    unlock_pool(pool);
+    block = (unsigned char *)malloc(class_size);
+    if (block == NULL) return NULL;
+    lock_pool(pool);
+    ++stats->num_heap_allocs;
+    stats->bytes_held += class_size;
+    if (stats->bytes_held > stats->peak_bytes_held) {
+      stats->peak_bytes_held = stats->bytes_held;
+    }
+  }
+  stats->bytes_in_use += class_size;
+  if (stats->bytes_in_use > stats->peak_bytes_in_use) {
+    stats->peak_bytes_in_use = stats->bytes_in_use;
+  }
+  unlock_pool(pool);
+
+  memcpy(block, &size_class, sizeof(size_class));
+  return block + BLOCK_HEADER_SIZE;
+}
+
+static void pool_release(void *priv, void *ptr) {
+  VpxMemPool *const pool = (VpxMemPool *)priv;
+  unsigned char *const block = (unsigned char *)ptr - BLOCK_HEADER_SIZE;
+  size_t class_size;
+  int size_class;
+
+  memcpy(&size_class, block, sizeof(size_class));
+  assert(size_class >= 0 && size_class < NUM_CLASSES);
+  class_size = get_class_size(size_class);
+  lock_pool(pool);
+  memcpy(block, &pool->free_list[size_class], sizeof(void *));
+  pool->free_list[size_class] = block;
+  assert(pool->stats.bytes_in_use >= class_size);
+  pool->stats.bytes_in_use -= class_size;
+  unlock_pool(pool);
+}
+
+VpxMemPool *vpx_mem_pool_create(void) {
+  VpxMemPool *const pool = (VpxMemPool *)calloc(1, sizeof(*pool));
+  if (pool == NULL) return NULL;
+#if CONFIG_MULTITHREAD
+  if (pthread_mutex_init(&pool->mutex, NULL)) {
+    free(pool);
+    return NULL;
+  }
+#endif
+  return pool;
+}
+
+void vpx_mem_pool_destroy(VpxMemPool *pool) {
+  if (pool == NULL) return;
+  assert(pool->stats.bytes_in_use == 0);
+  vpx_mem_pool_trim(pool);
+#if CONFIG_MULTITHREAD
+  pthread_mutex_destroy(&pool->mutex);
+#endif
+  free(pool);
+}
+
+void vpx_mem_pool_get_allocator(VpxMemPool *pool,
+                                vpx_mem_allocator *allocator) {
+  allocator->alloc = pool_alloc;
+  allocator->release = pool_release;
+  allocator->priv = pool;
+}
+
+void vpx_mem_pool_get_stats(VpxMemPool *pool, VpxMemPoolStats *stats) {
+  lock_pool(pool);
+  *stats = pool->stats;
+  unlock_pool(pool);
+}
+
+void vpx_mem_pool_trim(VpxMemPool *pool) {
+  int i;
+  lock_pool(pool);
+  for (i = 0; i < NUM_CLASSES; ++i) {
+    void *block = pool->free_list[i];
+    while (block != NULL) {
+      void *next;
+      memcpy(&next, block, sizeof(next));
+      free(block);
+      block = next;
+    }
+    pool->free_list[i] = NULL;
+  }
+  pool->stats.bytes_held = pool->stats.bytes_in_use;
+  unlock_pool(pool);
+}
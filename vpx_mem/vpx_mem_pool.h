@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_MEM_VPX_MEM_POOL_H_
+#define VPX_VPX_MEM_VPX_MEM_POOL_H_
+
+#include <stddef.h>
+
+#include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// A size-class allocator that keeps freed blocks for reuse. Requests are
+// rounded up to one of four classes per power of two (at most 25% slack) and
+// served from that class's free list when possible. Once a codec has seen
+// its largest frame, reallocations of scratch buffers are then satisfied
+// without touching the heap. Cached blocks are returned to the system only
+// by vpx_mem_pool_trim() and vpx_mem_pool_destroy(). The pool is thread
+// safe.
+typedef struct VpxMemPool VpxMemPool;
+
+typedef struct VpxMemPoolStats {
+  size_t bytes_in_use;  // handed out and not yet released
+  size_t bytes_held;    // in use plus cached in the free lists
+  size_t peak_bytes_in_use;
+  size_t peak_bytes_held;
+  uint64_t num_allocs;       // all requests
+  uint64_t num_heap_allocs;  // requests that had to call malloc()
+} VpxMemPoolStats;
+
+VpxMemPool *vpx_mem_pool_create(void);
+
+// Every block allocated from 'pool' must have been released.
+void vpx_mem_pool_destroy(VpxMemPool *pool);
+
+// Fills in an allocator suitable for vpx_mem_set_allocator().
+void vpx_mem_pool_get_allocator(VpxMemPool *pool,
+                                vpx_mem_allocator *allocator);
+
+void vpx_mem_pool_get_stats(VpxMemPool *pool, VpxMemPoolStats *stats);
+
+// Returns all cached blocks to the system.
+void vpx_mem_pool_trim(VpxMemPool *pool);
+
+#if defined(__cplusplus)
+}  // extern "C"
+#endif
+
+#endif  // VPX_VPX_MEM_VPX_MEM_POOL_H_
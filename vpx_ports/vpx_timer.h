@@ -32,6 +32,7 @@
  * POSIX specific includes
  */
 #include <sys/time.h>
+#include <time.h>
 
 /* timersub is not provided by msys at this time. */
 #ifndef timersub
@@ -87,6 +88,51 @@ static INLINE int64_t vpx_usec_timer_elapsed(struct vpx_usec_timer *t) {
 #endif
 }
 
+/* Returns the CPU time used so far by the calling thread, in microseconds,
+ * or 0 where it is not available.
+ */
+static INLINE int64_t vpx_thread_cpu_time_usec(void) {
+#if defined(_WIN32)
+  FILETIME creation, exit, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+    return 0;
+  }
+  /* FILETIME counts 100 ns intervals. */
+  return ((((int64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime) +
+          (((int64_t)user.dwHighDateTime << 32) | user.dwLowDateTime)) /
+         10;
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts)) return 0;
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+  return 0;
+#endif
+}
+
+/* Returns the CPU time used so far by all threads of the process, in
+ * microseconds, or 0 where it is not available.
+ */
+static INLINE int64_t vpx_process_cpu_time_usec(void) {
+#if defined(_WIN32)
+  FILETIME creation, exit, kernel, user;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel,
+                       &user)) {
+    return 0;
+  }
+  /* FILETIME counts 100 ns intervals. */
+  return ((((int64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime) +
+          (((int64_t)user.dwHighDateTime << 32) | user.dwLowDateTime)) /
+         10;
+#elif defined(CLOCK_PROCESS_CPUTIME_ID)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts)) return 0;
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+  return 0;
+#endif
+}
+
 #else /* CONFIG_OS_SUPPORT = 0*/
 
 /* Empty timer functions if CONFIG_OS_SUPPORT = 0 */
@@ -104,6 +150,10 @@ static INLINE void vpx_usec_timer_mark(struct vpx_usec_timer *t) {}
 
 static INLINE int vpx_usec_timer_elapsed(struct vpx_usec_timer *t) { return 0; }
 
+static INLINE int64_t vpx_thread_cpu_time_usec(void) { return 0; }
+
+static INLINE int64_t vpx_process_cpu_time_usec(void) { return 0; }
+
 #endif /* CONFIG_OS_SUPPORT */
 
 #endif  // VPX_VPX_PORTS_VPX_TIMER_H_
@@ -16,6 +16,8 @@
 #include <string.h>  // for memset()
 #include "./vpx_thread.h"
 #include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/vpx_timer.h"
+#include "vpx_util/vpx_thread_pool.h"
 
 #if CONFIG_MULTITHREAD
 
@@ -27,8 +29,6 @@ struct VPxWorkerImpl {
 
 //------------------------------------------------------------------------------
 
-static void execute(VPxWorker *const worker);  // Forward declaration.
-
 static THREADFN thread_loop(void *ptr) {
   VPxWorker *const worker = (VPxWorker *)ptr;
   int done = 0;
@@ -38,7 +38,7 @@ static THREADFN thread_loop(void *ptr) {
       pthread_cond_wait(&worker->impl_->condition_, &worker->impl_->mutex_);
     }
     if (worker->status_ == WORK) {
-      execute(worker);
+      worker->had_error |= !vpx_worker_run_hook(worker);
       worker->status_ = OK;
     } else if (worker->status_ == NOT_OK) {  // finish the worker
       done = 1;
@@ -83,7 +83,11 @@ static void init(VPxWorker *const worker) {
 
 static int sync(VPxWorker *const worker) {
 #if CONFIG_MULTITHREAD
-  change_state(worker, OK);
+  if (worker->pool_ != NULL) {
+    vpx_thread_pool_sync(worker);
+  } else {
+    change_state(worker, OK);
+  }
 #endif
   assert(worker->status_ <= OK);
   return !worker->had_error;
@@ -94,6 +98,11 @@ static int reset(VPxWorker *const worker) {
   worker->had_error = 0;
   if (worker->status_ < OK) {
 #if CONFIG_MULTITHREAD
+    if (worker->pool_ != NULL) {
+      // Pooled workers share the pool threads and never spawn their own.
+      worker->status_ = OK;
+      return ok;
+    }
     worker->impl_ = (VPxWorkerImpl *)vpx_calloc(1, sizeof(*worker->impl_));
     if (worker->impl_ == NULL) {
       return 0;
@@ -127,6 +136,17 @@ static int reset(VPxWorker *const worker) {
   return ok;
 }
 
+int vpx_worker_run_hook(VPxWorker *const worker) {
+  int64_t start;
+  int ok;
+  if (worker->hook == NULL) return 1;
+  if (!worker->timed) return worker->hook(worker->data1, worker->data2);
+  start = vpx_thread_cpu_time_usec();
+  ok = worker->hook(worker->data1, worker->data2);
+  worker->cpu_time += vpx_thread_cpu_time_usec() - start;
+  return ok;
+}
+
 static void execute(VPxWorker *const worker) {
   if (worker->hook != NULL) {
     worker->had_error |= !worker->hook(worker->data1, worker->data2);
@@ -135,6 +155,10 @@ static void execute(VPxWorker *const worker) {
 
 static void launch(VPxWorker *const worker) {
 #if CONFIG_MULTITHREAD
+  if (worker->pool_ != NULL) {
+    vpx_thread_pool_launch(worker);
+    return;
+  }
   change_state(worker, WORK);
 #else
   execute(worker);
@@ -143,7 +167,10 @@ static void launch(VPxWorker *const worker) {
 
 static void end(VPxWorker *const worker) {
 #if CONFIG_MULTITHREAD
-  if (worker->impl_ != NULL) {
+  if (worker->pool_ != NULL) {
+    vpx_thread_pool_sync(worker);
+    worker->status_ = NOT_OK;
+  } else if (worker->impl_ != NULL) {
     change_state(worker, NOT_OK);
     pthread_join(worker->impl_->thread_, NULL);
     pthread_mutex_destroy(&worker->impl_->mutex_);
@@ -16,6 +16,7 @@
 #define VPX_VPX_UTIL_VPX_THREAD_H_
 
 #include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -384,14 +385,23 @@ typedef int (*VPxWorkerHook)(void *, void *);
 // Platform-dependent implementation details for the worker.
 typedef struct VPxWorkerImpl VPxWorkerImpl;
 
+// Shared job scheduler, see vpx_thread_pool.h.
+typedef struct VPxThreadPool VPxThreadPool;
+
 // Synchronization object used to launch job in the worker thread
 typedef struct {
   VPxWorkerImpl *impl_;
+  VPxThreadPool *pool_;  // when set, jobs run on the pool instead of impl_
   VPxWorkerStatus status_;
   VPxWorkerHook hook;  // hook to call
   void *data1;         // first argument passed to 'hook'
   void *data2;         // second argument passed to 'hook'
   int had_error;       // return value of the last call to 'hook'
+  // When set, the thread CPU time of the calls to 'hook' made on a worker
+  // thread is added to 'cpu_time', in microseconds. Calls made by execute(),
+  // or by sync() while it waits, count towards the calling thread instead.
+  int timed;
+  int64_t cpu_time;
 } VPxWorker;
 
 // The interface for all thread-worker related functions. All these functions
@@ -419,6 +429,10 @@ typedef struct {
   void (*end)(VPxWorker *const worker);
 } VPxWorkerInterface;
 
+// Calls the hook of a worker from a worker thread, on behalf of launch().
+// Returns the value returned by the hook, or 1 if there is none.
+int vpx_worker_run_hook(VPxWorker *const worker);
+
 // Install a new set of threading functions, overriding the defaults. This
 // should be done before any workers are started, i.e., before any encoding or
 // decoding takes place. The contents of the interface struct are copied, it
@@ -0,0 +1,337 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_util/vpx_thread_pool.h"
+
+#if CONFIG_MULTITHREAD
+
+// Initial number of slots in each job deque. Deques grow on demand.
+#define INITIAL_DEQUE_SIZE 16
+
+typedef struct {
+  pthread_mutex_t mutex;
+  VPxWorker **jobs;  // ring buffer of 'size' entries
+  int size;
+  int head;   // oldest job, taken by thieves
+  int count;  // newest job is at (head + count - 1) % size
+} JobDeque;
+
+typedef struct {
+  VPxThreadPool *pool;
+  int index;
+} PoolThreadData;
+
+struct VPxThreadPool {
+  // Guards 'pending', 'shutdown', 'next_deque' and the status_ of attached
+  // workers that have been launched.
+  pthread_mutex_t mutex;
+  pthread_cond_t work_cond;  // signaled when a job is queued
+  pthread_cond_t done_cond;  // broadcast when a job completes or is queued
+  int pending;               // number of queued jobs not yet claimed
+  int shutdown;
+  int next_deque;  // deque that receives the next launched job
+
+  int num_threads;
+  int num_deques;  // one per thread, at least one
+  JobDeque *deques;
+  pthread_t *threads;
+  PoolThreadData *thread_data;
+};
+
+static int deque_push(JobDeque *const deque, VPxWorker *const job) {
+  int ok = 1;
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->count == deque->size) {
+    const int new_size = deque->size * 2;
+    VPxWorker **const jobs =
+        (VPxWorker **)vpx_malloc(new_size * sizeof(*jobs));
+    if (jobs == NULL) {
+      ok = 0;
+    } else {
+      int i;
+      for (i = 0; i < deque->count; ++i) {
+        jobs[i] = deque->jobs[(deque->head + i) % deque->size];
+      }
+      vpx_free(deque->jobs);
+      deque->jobs = jobs;
+      deque->size = new_size;
+      deque->head = 0;
+    }
+  }
+  if (ok) {
+    deque->jobs[(deque->head + deque->count) % deque->size] = job;
+    ++deque->count;
+  }
+  pthread_mutex_unlock(&deque->mutex);
+  return ok;
+}
+
+// Owners take the newest job, whose data is most likely still in cache.
+static VPxWorker *deque_pop_newest(JobDeque *const deque) {
+  VPxWorker *job = NULL;
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->count > 0) {
+    --deque->count;
+    job = deque->jobs[(deque->head + deque->count) % deque->size];
+  }
+  pthread_mutex_unlock(&deque->mutex);
+  return job;
+}
+
+// Thieves take the oldest job, leaving the owner's recent work alone.
+static VPxWorker *deque_pop_oldest(JobDeque *const deque) {
+  VPxWorker *job = NULL;
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->count > 0) {
+    job = deque->jobs[deque->head];
+    deque->head = (deque->head + 1) % deque->size;
+    --deque->count;
+  }
+  pthread_mutex_unlock(&deque->mutex);
+  return job;
+}
+
+// 'on_pool_thread' is 0 when the job runs on a thread that launches or syncs
+// workers, which then accounts for the time itself.
+static void run_job(VPxThreadPool *const pool, VPxWorker *const job,
+                    int on_pool_thread) {
+  int ok = 1;
+  if (on_pool_thread) {
+    ok = vpx_worker_run_hook(job);
+  } else if (job->hook != NULL) {
+    ok = job->hook(job->data1, job->data2);
+  }
+  pthread_mutex_lock(&pool->mutex);
+  job->had_error |= !ok;
+  job->status_ = OK;
+  pthread_cond_broadcast(&pool->done_cond);
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+// Runs one queued job, preferring the deque at 'own'. Returns 0 if every
+// deque was empty.
+static int run_one_job(VPxThreadPool *const pool, int own,
+                       int on_pool_thread) {
+  VPxWorker *job = deque_pop_newest(&pool->deques[own]);
+  int i;
+  for (i = 1; job == NULL && i < pool->num_deques; ++i) {
+    job = deque_pop_oldest(&pool->deques[(own + i) % pool->num_deques]);
+  }
+  if (job == NULL) return 0;
+
+  pthread_mutex_lock(&pool->mutex);
+  --pool->pending;
+  pthread_mutex_unlock(&pool->mutex);
+  run_job(pool, job, on_pool_thread);
+  return 1;
+}
+
+static THREADFN thread_loop(void *ptr) {
+  PoolThreadData *const thread_data = (PoolThreadData *)ptr;
+  VPxThreadPool *const pool = thread_data->pool;
+  int done = 0;
+  while (!done) {
+    if (run_one_job(pool, thread_data->index, 1)) continue;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pending == 0 && !pool->shutdown) {
+      pthread_cond_wait(&pool->work_cond, &pool->mutex);
+    }
+    done = pool->pending == 0 && pool->shutdown;
+    pthread_mutex_unlock(&pool->mutex);
+  }
+  return THREAD_RETURN(NULL);
+}
+
+VPxThreadPool *vpx_thread_pool_create(int num_threads) {
+  VPxThreadPool *pool;
+  int i;
+
+  if (num_threads < 0) return NULL;
+  pool = (VPxThreadPool *)vpx_calloc(1, sizeof(*pool));
+  if (pool == NULL) return NULL;
+
+  if (pthread_mutex_init(&pool->mutex, NULL)) goto Error;
+  if (pthread_cond_init(&pool->work_cond, NULL)) {
+    pthread_mutex_destroy(&pool->mutex);
+    goto Error;
+  }
+  if (pthread_cond_init(&pool->done_cond, NULL)) {
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->mutex);
+    goto Error;
+  }
+
+  pool->num_deques = num_threads > 0 ? num_threads : 1;
+  pool->deques =
+      (JobDeque *)vpx_calloc(pool->num_deques, sizeof(*pool->deques));
+  if (pool->deques == NULL) goto Cleanup;
+  for (i = 0; i < pool->num_deques; ++i) {
+    JobDeque *const deque = &pool->deques[i];
+    deque->jobs =
+        (VPxWorker **)vpx_malloc(INITIAL_DEQUE_SIZE * sizeof(*deque->jobs));
+    if (deque->jobs == NULL) goto Cleanup;
+    if (pthread_mutex_init(&deque->mutex, NULL)) {
+      vpx_free(deque->jobs);
+      deque->jobs = NULL;
+      goto Cleanup;
+    }
+    deque->size = INITIAL_DEQUE_SIZE;
+  }
+
+  if (num_threads > 0) {
+    pool->threads =
+        (pthread_t *)vpx_malloc(num_threads * sizeof(*pool->threads));
+    pool->thread_data = (PoolThreadData *)vpx_malloc(
+        num_threads * sizeof(*pool->thread_data));
+    if (pool->threads == NULL || pool->thread_data == NULL) goto Cleanup;
+    for (i = 0; i < num_threads; ++i) {
+      pool->thread_data[i].pool = pool;
+      pool->thread_data[i].index = i;
+      if (pthread_create(&pool->threads[i], NULL, thread_loop,
+                         &pool->thread_data[i])) {
+        goto Cleanup;
+      }
+      ++pool->num_threads;
+    }
+  }
+  return pool;
+
+Cleanup:
+  // Tears down whatever was set up; joins any threads already started.
+  vpx_thread_pool_destroy(pool);
+  return NULL;
+
+Error:
+  vpx_free(pool);
+  return NULL;
+}
+
+void vpx_thread_pool_destroy(VPxThreadPool *pool) {
+  int i;
+  if (pool == NULL) return;
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->shutdown = 1;
+  pthread_cond_broadcast(&pool->work_cond);
+  pthread_mutex_unlock(&pool->mutex);
+  for (i = 0; i < pool->num_threads; ++i) {
+    pthread_join(pool->threads[i], NULL);
+  }
+  assert(pool->pending == 0);
+
+  if (pool->deques != NULL) {
+    for (i = 0; i < pool->num_deques; ++i) {
+      JobDeque *const deque = &pool->deques[i];
+      if (deque->jobs == NULL) continue;
+      pthread_mutex_destroy(&deque->mutex);
+      vpx_free(deque->jobs);
+    }
+  }
+  vpx_free(pool->deques);
+  vpx_free(pool->threads);
+  vpx_free(pool->thread_data);
+  pthread_cond_destroy(&pool->done_cond);
+  pthread_cond_destroy(&pool->work_cond);
+  pthread_mutex_destroy(&pool->mutex);
+  vpx_free(pool);
+}
+
+int vpx_thread_pool_get_num_threads(const VPxThreadPool *pool) {
+  return pool != NULL ? pool->num_threads : 0;
+}
+
+void vpx_thread_pool_attach_worker(VPxThreadPool *pool, VPxWorker *worker) {
+  assert(worker->status_ == NOT_OK && worker->impl_ == NULL);
+  worker->pool_ = pool;
+}
+
+void vpx_thread_pool_launch(VPxWorker *worker) {
+  VPxThreadPool *const pool = worker->pool_;
+  JobDeque *deque;
+
+  // A previous job must have been synced before the worker is launched again.
+  assert(worker->status_ == OK);
+  pthread_mutex_lock(&pool->mutex);
+  worker->status_ = WORK;
+  ++pool->pending;
+  deque = &pool->deques[pool->next_deque];
+  pool->next_deque = (pool->next_deque + 1) % pool->num_deques;
+  pthread_mutex_unlock(&pool->mutex);
+
+  if (!deque_push(deque, worker)) {
+    // Out of memory for the deque; run the job on the calling thread.
+    pthread_mutex_lock(&pool->mutex);
+    --pool->pending;
+    pthread_mutex_unlock(&pool->mutex);
+    run_job(pool, worker, 0);
+    return;
+  }
+
+  // Threads blocked in sync() are woken as well so they can help.
+  pthread_mutex_lock(&pool->mutex);
+  pthread_cond_signal(&pool->work_cond);
+  pthread_cond_broadcast(&pool->done_cond);
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+void vpx_thread_pool_sync(VPxWorker *worker) {
+  VPxThreadPool *const pool = worker->pool_;
+  int own = 0;
+  for (;;) {
+    pthread_mutex_lock(&pool->mutex);
+    if (worker->status_ != WORK) {
+      pthread_mutex_unlock(&pool->mutex);
+      return;
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    // Help with queued jobs rather than sleeping. Jobs are taken round-robin
+    // so the caller does not always compete with the same pool thread.
+    if (run_one_job(pool, own, 0)) {
+      own = (own + 1) % pool->num_deques;
+      continue;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    while (worker->status_ == WORK && pool->pending == 0) {
+      pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+  }
+}
+
+#else  // !CONFIG_MULTITHREAD
+
+VPxThreadPool *vpx_thread_pool_create(int num_threads) {
+  (void)num_threads;
+  return NULL;
+}
+
+void vpx_thread_pool_destroy(VPxThreadPool *pool) { (void)pool; }
+
+int vpx_thread_pool_get_num_threads(const VPxThreadPool *pool) {
+  (void)pool;
+  return 0;
+}
+
+void vpx_thread_pool_attach_worker(VPxThreadPool *pool, VPxWorker *worker) {
+  (void)pool;
+  (void)worker;
+}
+
+void vpx_thread_pool_launch(VPxWorker *worker) { (void)worker; }
+
+void vpx_thread_pool_sync(VPxWorker *worker) { (void)worker; }
+
+#endif  // CONFIG_MULTITHREAD
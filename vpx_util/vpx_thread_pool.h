@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2021 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_UTIL_VPX_THREAD_POOL_H_
+#define VPX_VPX_UTIL_VPX_THREAD_POOL_H_
+
+#include "./vpx_config.h"
+#include "vpx_util/vpx_thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A persistent set of threads that run VPxWorker jobs. Each thread owns a job
+// deque; it takes its own jobs newest first and, once its deque is empty,
+// steals the oldest jobs from the other threads. A thread waiting in sync()
+// on a pooled worker runs queued jobs instead of sleeping.
+//
+// Workers are bound to a pool with vpx_thread_pool_attach_worker(). After
+// that the regular VPxWorkerInterface calls work unchanged: reset() does not
+// spawn a thread, launch() queues the hook on the pool and sync() waits for
+// it. Without CONFIG_MULTITHREAD no pool can be created and workers always
+// run their hooks on the calling thread.
+
+// Returns NULL on allocation or thread creation failure, or when built
+// without CONFIG_MULTITHREAD. 'num_threads' may be 0, in which case jobs are
+// only run by threads waiting in sync().
+VPxThreadPool *vpx_thread_pool_create(int num_threads);
+
+// Joins the pool threads. All attached workers must have been synced.
+void vpx_thread_pool_destroy(VPxThreadPool *pool);
+
+int vpx_thread_pool_get_num_threads(const VPxThreadPool *pool);
+
+// Must be called after init() and before the first reset() of 'worker'.
+void vpx_thread_pool_attach_worker(VPxThreadPool *pool, VPxWorker *worker);
+
+// Used by the default VPxWorkerInterface for workers with a pool attached.
+void vpx_thread_pool_launch(VPxWorker *worker);
+void vpx_thread_pool_sync(VPxWorker *worker);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VPX_UTIL_VPX_THREAD_POOL_H_
@@ -77,7 +77,10 @@ static const arg_def_t outputfile =
 static const arg_def_t threadsarg =
     ARG_DEF("t", "threads", 1, "Max threads to use");
 static const arg_def_t frameparallelarg =
-    ARG_DEF(NULL, "frame-parallel", 0, "Frame parallel decode (ignored)");
+    ARG_DEF(NULL, "frame-parallel", 0, "Frame parallel decode (VP9 only)");
+static const arg_def_t pipelinearg =
+    ARG_DEF(NULL, "pipeline-decode", 0,
+            "Parse frames ahead of reconstruction (with --frame-parallel)");
 static const arg_def_t verbosearg =
     ARG_DEF("v", "verbose", 0, "Show version string");
 static const arg_def_t error_concealment =
@@ -119,6 +122,7 @@ static const arg_def_t *all_args[] = { &help,
                                        &outputfile,
                                        &threadsarg,
                                        &frameparallelarg,
+                                       &pipelinearg,
                                        &verbosearg,
                                        &scalearg,
                                        &fb_arg,
@@ -527,6 +531,8 @@ static int main_loop(int argc, const char **argv_) {
   int stop_after = 0, postproc = 0, summary = 0, quiet = 1;
   int arg_skip = 0;
   int ec_enabled = 0;
+  int frame_parallel = 0;
+  int pipeline_decode = 0;
   int keep_going = 0;
   int enable_row_mt = 0;
   int enable_lpf_opt = 0;
@@ -626,9 +632,10 @@ static int main_loop(int argc, const char **argv_) {
     else if (arg_match(&arg, &threadsarg, argi))
       cfg.threads = arg_parse_uint(&arg);
 #if CONFIG_VP9_DECODER
-    else if (arg_match(&arg, &frameparallelarg, argi)) {
-      /* ignored for compatibility */
-    }
+    else if (arg_match(&arg, &frameparallelarg, argi))
+      frame_parallel = 1;
+    else if (arg_match(&arg, &pipelinearg, argi))
+      pipeline_decode = 1;
 #endif
     else if (arg_match(&arg, &verbosearg, argi))
       quiet = 0;
@@ -768,6 +775,8 @@ static int main_loop(int argc, const char **argv_) {
 
   dec_flags = (postproc ? VPX_CODEC_USE_POSTPROC : 0) |
               (ec_enabled ? VPX_CODEC_USE_ERROR_CONCEALMENT : 0);
+  if (frame_parallel && interface->fourcc == VP9_FOURCC)
+    dec_flags |= VPX_CODEC_USE_FRAME_THREADING;
   if (vpx_codec_dec_init(&decoder, interface->codec_interface(), &cfg,
                          dec_flags)) {
     fprintf(stderr, "Failed to initialize decoder: %s\n",
@@ -794,6 +803,12 @@ static int main_loop(int argc, const char **argv_) {
             vpx_codec_error(&decoder));
     goto fail;
   }
+  if (pipeline_decode && interface->fourcc == VP9_FOURCC &&
+      vpx_codec_control(&decoder, VP9D_SET_PIPELINE_DECODE, 1)) {
+    fprintf(stderr, "Failed to set decoder in pipelined mode: %s\n",
+            vpx_codec_error(&decoder));
+    goto fail;
+  }
   if (!quiet) fprintf(stderr, "%s\n", decoder.name);
 
 #if CONFIG_VP8_DECODER